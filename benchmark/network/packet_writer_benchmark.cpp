@@ -0,0 +1,84 @@
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "execution/sql/value.h"
+#include "network/network_io_utils.h"
+#include "network/postgres/postgres_packet_writer.h"
+#include "planner/plannodes/output_schema.h"
+
+namespace terrier {
+
+/**
+ * Measures how many result rows per second the PostgresPacketWriter can serialize into a WriteQueue. This is the
+ * path every SELECT result takes on its way from the execution engine's OutputBuffer to the client.
+ */
+class PacketWriterBenchmark : public benchmark::Fixture {
+ public:
+  void SetUp(const benchmark::State &state) final {
+    columns_.emplace_back("int_col", type::TypeId::INTEGER, nullptr);
+    columns_.emplace_back("bigint_col", type::TypeId::BIGINT, nullptr);
+    columns_.emplace_back("decimal_col", type::TypeId::DECIMAL, nullptr);
+    columns_.emplace_back("date_col", type::TypeId::DATE, nullptr);
+
+    tuple_size_ = 0;
+    for (const auto &col : columns_) tuple_size_ += execution::sql::ValUtil::GetSqlSize(col.GetType());
+
+    // Lay the rows out the same way exec::OutputBuffer does
+    tuples_.resize(NUM_ROWS * tuple_size_);
+    std::default_random_engine generator;
+    std::uniform_int_distribution<int64_t> int_dist(-1000000, 1000000);
+    std::uniform_real_distribution<double> real_dist(-1000.0, 1000.0);
+    for (uint32_t row = 0; row < NUM_ROWS; row++) {
+      byte *pos = tuples_.data() + row * tuple_size_;
+      new (pos) execution::sql::Integer(int_dist(generator));
+      pos += sizeof(execution::sql::Integer);
+      new (pos) execution::sql::Integer(int_dist(generator) * int_dist(generator));
+      pos += sizeof(execution::sql::Integer);
+      new (pos) execution::sql::Real(real_dist(generator));
+      pos += sizeof(execution::sql::Real);
+      new (pos) execution::sql::DateVal(execution::sql::Date::FromYMD(1992 + row % 7, 1 + row % 12, 1 + row % 28));
+    }
+  }
+
+  void TearDown(const benchmark::State &state) final {
+    columns_.clear();
+    tuples_.clear();
+  }
+
+  void WriteRows(benchmark::State *state, const network::FieldFormat format) {
+    network::WriteQueue queue;
+    const std::vector<network::FieldFormat> field_formats{format};
+    // NOLINTNEXTLINE
+    for (auto _ : *state) {
+      {
+        network::PostgresPacketWriter writer{common::ManagedPointer(&queue)};
+        writer.WriteDataRows(tuples_.data(), NUM_ROWS, tuple_size_, columns_, field_formats);
+      }
+      // Throw away the serialized rows rather than growing the queue for the whole run
+      queue.Reset();
+    }
+    state->SetItemsProcessed(state->iterations() * NUM_ROWS);
+  }
+
+  static constexpr uint32_t NUM_ROWS = 2048;
+  std::vector<planner::OutputSchema::Column> columns_;
+  std::vector<byte> tuples_;
+  uint32_t tuple_size_;
+};
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(PacketWriterBenchmark, TextRows)(benchmark::State &state) {
+  WriteRows(&state, network::FieldFormat::text);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(PacketWriterBenchmark, BinaryRows)(benchmark::State &state) {
+  WriteRows(&state, network::FieldFormat::binary);
+}
+
+BENCHMARK_REGISTER_F(PacketWriterBenchmark, TextRows)->Unit(benchmark::kMicrosecond);
+BENCHMARK_REGISTER_F(PacketWriterBenchmark, BinaryRows)->Unit(benchmark::kMicrosecond);
+
+}  // namespace terrier
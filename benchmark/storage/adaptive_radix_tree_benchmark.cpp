@@ -0,0 +1,174 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "benchmark_util/benchmark_config.h"
+#include "common/scoped_timer.h"
+#include "common/worker_pool.h"
+#include "portable_endian/portable_endian.h"
+#include "storage/index/adaptive_radix_tree.h"
+#include "test_util/multithread_test_util.h"
+
+namespace terrier {
+
+// Same workloads as bwtree_benchmark.cpp, so the two data structures can be compared side by side
+
+class AdaptiveRadixTreeBenchmark : public benchmark::Fixture {
+ public:
+  // 8-byte key whose bytes compare like the (non-negative) integer it holds, like a single-column CompactIntsKey<8>
+  class Key {
+   public:
+    explicit Key(const int64_t key) : data_(htobe64(static_cast<uint64_t>(key))) {}
+    const byte *KeyData() const { return reinterpret_cast<const byte *>(&data_); }
+
+   private:
+    uint64_t data_;
+  };
+
+  using TreeType = storage::index::AdaptiveRadixTree<Key>;
+
+  void SetUp(const benchmark::State &state) final {
+    key_permutation_.resize(num_keys_);
+    for (uint32_t i = 0; i < num_keys_; i++) {
+      key_permutation_[i] = i;
+    }
+    std::shuffle(key_permutation_.begin(), key_permutation_.end(), generator_);
+  }
+
+  void TearDown(const benchmark::State &state) final {}
+
+  // Inserts every key in random or sequential order, without timing it
+  void Populate(TreeType *const tree, const bool random) {
+    for (uint32_t i = 0; i < num_keys_; i++) {
+      tree->Insert(Key(random ? key_permutation_[i] : i), value_);
+    }
+  }
+
+  // Runs op on every key, with each thread taking a contiguous range of the random or sequential key order
+  template <typename Op>
+  uint64_t RunWorkload(common::WorkerPool *const thread_pool, const bool random, const Op &op) {
+    auto workload = [&](uint32_t id) {
+      uint32_t start_key = num_keys_ / BenchmarkConfig::num_threads * id;
+      uint32_t end_key = start_key + num_keys_ / BenchmarkConfig::num_threads;
+
+      for (uint32_t i = start_key; i < end_key; i++) {
+        op(Key(random ? key_permutation_[i] : i));
+      }
+    };
+
+    uint64_t elapsed_ms;
+    {
+      common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+      MultiThreadTestUtil::RunThreadsUntilFinish(thread_pool, BenchmarkConfig::num_threads, workload);
+    }
+    return elapsed_ms;
+  }
+
+  void InsertBenchmark(benchmark::State *const state, const bool random_insert) {
+    common::WorkerPool thread_pool(BenchmarkConfig::num_threads, {});
+    thread_pool.Startup();
+
+    // NOLINTNEXTLINE
+    for (auto _ : *state) {
+      auto *const tree = new TreeType();
+      const uint64_t elapsed_ms =
+          RunWorkload(&thread_pool, random_insert, [&](const Key &key) { tree->Insert(key, value_); });
+      delete tree;
+      state->SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+    }
+    state->SetItemsProcessed(state->iterations() * num_keys_);
+  }
+
+  void ReadBenchmark(benchmark::State *const state, const bool random_insert, const bool random_read) {
+    common::WorkerPool thread_pool(BenchmarkConfig::num_threads, {});
+    thread_pool.Startup();
+
+    auto *const tree = new TreeType();
+    Populate(tree, random_insert);
+
+    // NOLINTNEXTLINE
+    for (auto _ : *state) {
+      const uint64_t elapsed_ms = RunWorkload(&thread_pool, random_read, [&](const Key &key) {
+        std::vector<storage::TupleSlot> values;
+        values.reserve(1);
+        tree->GetValue(key, &values);
+      });
+      state->SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+    }
+
+    delete tree;
+    state->SetItemsProcessed(state->iterations() * num_keys_);
+  }
+
+  // Workload
+  const uint32_t num_keys_ = 10000000;
+  // Keys are distinct, so they can all share a value
+  const storage::TupleSlot value_{};
+
+  // Test infrastructure
+  std::default_random_engine generator_;
+  std::vector<int64_t> key_permutation_;
+};
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(AdaptiveRadixTreeBenchmark, RandomInsert)(benchmark::State &state) {
+  InsertBenchmark(&state, true);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(AdaptiveRadixTreeBenchmark, SequentialInsert)(benchmark::State &state) {
+  InsertBenchmark(&state, false);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(AdaptiveRadixTreeBenchmark, RandomInsertRandomRead)(benchmark::State &state) {
+  ReadBenchmark(&state, true, true);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(AdaptiveRadixTreeBenchmark, RandomInsertSequentialRead)(benchmark::State &state) {
+  ReadBenchmark(&state, true, false);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(AdaptiveRadixTreeBenchmark, SequentialInsertRandomRead)(benchmark::State &state) {
+  ReadBenchmark(&state, false, true);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(AdaptiveRadixTreeBenchmark, SequentialInsertSequentialRead)(benchmark::State &state) {
+  ReadBenchmark(&state, false, false);
+}
+
+// ----------------------------------------------------------------------------
+// BENCHMARK REGISTRATION
+// ----------------------------------------------------------------------------
+// clang-format off
+BENCHMARK_REGISTER_F(AdaptiveRadixTreeBenchmark, RandomInsert)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->MinTime(3);
+BENCHMARK_REGISTER_F(AdaptiveRadixTreeBenchmark, SequentialInsert)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->MinTime(3);
+BENCHMARK_REGISTER_F(AdaptiveRadixTreeBenchmark, RandomInsertRandomRead)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->MinTime(3);
+BENCHMARK_REGISTER_F(AdaptiveRadixTreeBenchmark, RandomInsertSequentialRead)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->MinTime(3);
+BENCHMARK_REGISTER_F(AdaptiveRadixTreeBenchmark, SequentialInsertRandomRead)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->MinTime(3);
+BENCHMARK_REGISTER_F(AdaptiveRadixTreeBenchmark, SequentialInsertSequentialRead)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->MinTime(3);
+// clang-format on
+
+}  // namespace terrier
@@ -81,6 +81,7 @@ BENCHMARKS_TO_RUN = {
     "tuple_access_strategy_benchmark":      15,
     "tpcc_benchmark":                       DEFAULT_FAILURE_THRESHOLD,
     "bwtree_benchmark":                     DEFAULT_FAILURE_THRESHOLD,
+    "adaptive_radix_tree_benchmark":        DEFAULT_FAILURE_THRESHOLD,
     "cuckoomap_benchmark":                  DEFAULT_FAILURE_THRESHOLD,
     "parser_benchmark":                     20,
     "slot_iterator_benchmark":              DEFAULT_FAILURE_THRESHOLD,
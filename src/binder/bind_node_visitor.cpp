@@ -71,16 +71,12 @@ void BindNodeVisitor::Visit(common::ManagedPointer<parser::CopyStatement> node)
   BinderContext context(nullptr);
   context_ = common::ManagedPointer(&context);
 
-  if (node->GetCopyTable() != nullptr) {
-    node->GetCopyTable()->Accept(common::ManagedPointer(this).CastManagedPointerTo<SqlNodeVisitor>());
-
-    // If the table is given, we're either writing or reading all columns
-    std::vector<common::ManagedPointer<parser::AbstractExpression>> new_select_list;
-    context_->GenerateAllColumnExpressions(sherpa_->GetParseResult(), common::ManagedPointer(&new_select_list));
-    auto col = node->GetSelectStatement()->GetSelectColumns();
-    col.insert(std::end(col), std::begin(new_select_list), std::end(new_select_list));
-  } else {
+  // Copying out is always done through a query, which for COPY table TO is the parser's SELECT * FROM table. Copying in
+  // reads all of the table's columns.
+  if (node->GetSelectStatement() != nullptr) {
     node->GetSelectStatement()->Accept(common::ManagedPointer(this).CastManagedPointerTo<SqlNodeVisitor>());
+  } else {
+    node->GetCopyTable()->Accept(common::ManagedPointer(this).CastManagedPointerTo<SqlNodeVisitor>());
   }
 
   context_ = nullptr;
@@ -32,6 +32,7 @@
 #include "planner/plannodes/plan_visitor.h"
 #include "planner/plannodes/projection_plan_node.h"
 #include "planner/plannodes/seq_scan_plan_node.h"
+#include "planner/plannodes/set_op_plan_node.h"
 #include "planner/plannodes/update_plan_node.h"
 #include "type/type_id.h"
 
@@ -480,6 +481,19 @@ void OperatingUnitRecorder::Visit(const planner::AggregatePlanNode *plan) {
   }
 }
 
+void OperatingUnitRecorder::Visit(const planner::SetOpPlanNode *plan) {
+  if (plan_feature_type_ == ExecutionOperatingUnitType::AGGREGATE_ITERATE) {
+    // SetOpTopTranslator handles any exprs/computations in the output
+    VisitAbstractPlanNode(plan);
+    RecordArithmeticFeatures(plan, 1);
+  }
+
+  // Both sides build with all of their columns, which are also the output columns
+  auto num_keys = plan->GetOutputSchema()->GetColumns().size();
+  auto key_size = ComputeKeySizeOutputSchema(plan);
+  AggregateFeatures(plan_feature_type_, key_size, num_keys, plan, 1);
+}
+
 ExecutionOperatingUnitFeatureVector OperatingUnitRecorder::RecordTranslators(
     const std::vector<std::unique_ptr<execution::compiler::OperatorTranslator>> &translators) {
   pipeline_features_ = {};
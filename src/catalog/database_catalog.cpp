@@ -491,6 +491,13 @@ bool DatabaseCatalog::DeleteNamespace(const common::ManagedPointer<transaction::
 
 namespace_oid_t DatabaseCatalog::GetNamespaceOid(const common::ManagedPointer<transaction::TransactionContext> txn,
                                                  const std::string &name) {
+  auto *const cache = GetCache(txn);
+  if (cache == nullptr) return ScanNamespaceOid(txn, name);
+  return cache->NamespaceOids().GetOrInsert(name, [&] { return ScanNamespaceOid(txn, name); });
+}
+
+namespace_oid_t DatabaseCatalog::ScanNamespaceOid(const common::ManagedPointer<transaction::TransactionContext> txn,
+                                                  const std::string &name) {
   // Step 1: Read the name index
   const auto name_pri = namespaces_name_index_->GetProjectedRowInitializer();
   // Buffer is large enough for all prs because it's meant to hold 1 VarlenEntry
@@ -852,6 +859,14 @@ bool DatabaseCatalog::DeleteTable(const common::ManagedPointer<transaction::Tran
 std::pair<uint32_t, postgres::ClassKind> DatabaseCatalog::GetClassOidKind(
     const common::ManagedPointer<transaction::TransactionContext> txn, const namespace_oid_t ns_oid,
     const std::string &name) {
+  auto *const cache = GetCache(txn);
+  if (cache == nullptr) return ScanClassOidKind(txn, ns_oid, name);
+  return cache->ClassOidKinds().GetOrInsert({ns_oid, name}, [&] { return ScanClassOidKind(txn, ns_oid, name); });
+}
+
+std::pair<uint32_t, postgres::ClassKind> DatabaseCatalog::ScanClassOidKind(
+    const common::ManagedPointer<transaction::TransactionContext> txn, const namespace_oid_t ns_oid,
+    const std::string &name) {
   const auto name_pri = classes_name_index_->GetProjectedRowInitializer();
 
   const auto name_varlen = storage::StorageUtil::CreateVarlen(name);
@@ -965,6 +980,13 @@ std::vector<constraint_oid_t> DatabaseCatalog::GetConstraints(
 
 std::vector<index_oid_t> DatabaseCatalog::GetIndexOids(
     const common::ManagedPointer<transaction::TransactionContext> txn, table_oid_t table) {
+  auto *const cache = GetCache(txn);
+  if (cache == nullptr) return ScanIndexOids(txn, table);
+  return cache->IndexOids().GetOrInsert(table, [&] { return ScanIndexOids(txn, table); });
+}
+
+std::vector<index_oid_t> DatabaseCatalog::ScanIndexOids(
+    const common::ManagedPointer<transaction::TransactionContext> txn, table_oid_t table) {
   // Initialize PR for index scan
   auto oid_pri = indexes_table_index_->GetProjectedRowInitializer();
 
@@ -1134,7 +1156,8 @@ bool DatabaseCatalog::DeleteIndex(const common::ManagedPointer<transaction::Tran
   // manager. See base function comment.
   txn->RegisterCommitAction(
       [=, garbage_collector{garbage_collector_}](transaction::DeferredActionManager *deferred_action_manager) {
-        if (index_ptr->Type() == storage::index::IndexType::BWTREE) {
+        if (index_ptr->Type() == storage::index::IndexType::BWTREE ||
+            index_ptr->Type() == storage::index::IndexType::ART) {
           garbage_collector->UnregisterIndexForGC(common::ManagedPointer(index_ptr));
         }
         // Unregistering from GC can happen immediately, but we have to double-defer freeing the actual objects
@@ -1205,14 +1228,15 @@ bool DatabaseCatalog::SetIndexPointer(const common::ManagedPointer<transaction::
   TERRIER_ASSERT(write_lock_.load() == txn->FinishTime(),
                  "Setting the object's pointer should only be done after successful DDL change request. i.e. this txn "
                  "should already have the lock.");
-  if (index_ptr->Type() == storage::index::IndexType::BWTREE) {
+  if (index_ptr->Type() == storage::index::IndexType::BWTREE || index_ptr->Type() == storage::index::IndexType::ART) {
     garbage_collector_->RegisterIndexForGC(common::ManagedPointer(index_ptr));
   }
   // This needs to be deferred because if any items were subsequently inserted into this index, they will have deferred
   // abort actions that will be above this action on the abort stack.  The defer ensures we execute after them.
   txn->RegisterAbortAction(
       [=, garbage_collector{garbage_collector_}](transaction::DeferredActionManager *deferred_action_manager) {
-        if (index_ptr->Type() == storage::index::IndexType::BWTREE) {
+        if (index_ptr->Type() == storage::index::IndexType::BWTREE ||
+            index_ptr->Type() == storage::index::IndexType::ART) {
           garbage_collector->UnregisterIndexForGC(common::ManagedPointer(index_ptr));
         }
         deferred_action_manager->RegisterDeferredAction([=]() { delete index_ptr; });
@@ -1250,6 +1274,20 @@ const IndexSchema &DatabaseCatalog::GetIndexSchema(const common::ManagedPointer<
 
 std::vector<std::pair<common::ManagedPointer<storage::index::Index>, const IndexSchema &>> DatabaseCatalog::GetIndexes(
     const common::ManagedPointer<transaction::TransactionContext> txn, table_oid_t table) {
+  // With a cache, every step below is a lookup of its own that's probably cached
+  if (GetCache(txn) != nullptr) {
+    std::vector<std::pair<common::ManagedPointer<storage::index::Index>, const IndexSchema &>> index_objects;
+    for (const auto index_oid : GetIndexOids(txn, table)) {
+      const auto ptr_pair = GetClassPtrKind(txn, static_cast<uint32_t>(index_oid));
+      auto *const index = reinterpret_cast<storage::index::Index *>(ptr_pair.first);
+      TERRIER_ASSERT(index != nullptr,
+                     "Catalog conventions say you should not find a nullptr for an object ptr in pg_class. Did you "
+                     "call SetIndexPointer?");
+      index_objects.emplace_back(common::ManagedPointer(index), GetIndexSchema(txn, index_oid));
+    }
+    return index_objects;
+  }
+
   // Step 1: Get all index oids on table
   // Initialize PR for index scan
   auto indexes_oid_pri = indexes_table_index_->GetProjectedRowInitializer();
@@ -1413,7 +1451,7 @@ void DatabaseCatalog::TearDown(const common::ManagedPointer<transaction::Transac
     for (auto table : tables) delete table;
 
     for (auto index : indexes) {
-      if (index->Type() == storage::index::IndexType::BWTREE) {
+      if (index->Type() == storage::index::IndexType::BWTREE || index->Type() == storage::index::IndexType::ART) {
         garbage_collector->UnregisterIndexForGC(common::ManagedPointer(index));
       }
       delete index;
@@ -2082,6 +2120,13 @@ std::vector<std::pair<uint32_t, postgres::ClassKind>> DatabaseCatalog::GetNamesp
 
 std::pair<void *, postgres::ClassKind> DatabaseCatalog::GetClassPtrKind(
     const common::ManagedPointer<transaction::TransactionContext> txn, uint32_t oid) {
+  auto *const cache = GetCache(txn);
+  if (cache == nullptr) return ScanClassPtrKind(txn, oid);
+  return cache->ClassPtrKinds().GetOrInsert(oid, [&] { return ScanClassPtrKind(txn, oid); });
+}
+
+std::pair<void *, postgres::ClassKind> DatabaseCatalog::ScanClassPtrKind(
+    const common::ManagedPointer<transaction::TransactionContext> txn, uint32_t oid) {
   std::vector<storage::TupleSlot> index_results;
 
   // Initialize both PR initializers, allocate buffer using size of largest one so we can reuse buffer
@@ -2121,6 +2166,13 @@ std::pair<void *, postgres::ClassKind> DatabaseCatalog::GetClassPtrKind(
 
 std::pair<void *, postgres::ClassKind> DatabaseCatalog::GetClassSchemaPtrKind(
     const common::ManagedPointer<transaction::TransactionContext> txn, uint32_t oid) {
+  auto *const cache = GetCache(txn);
+  if (cache == nullptr) return ScanClassSchemaPtrKind(txn, oid);
+  return cache->ClassSchemaPtrKinds().GetOrInsert(oid, [&] { return ScanClassSchemaPtrKind(txn, oid); });
+}
+
+std::pair<void *, postgres::ClassKind> DatabaseCatalog::ScanClassSchemaPtrKind(
+    const common::ManagedPointer<transaction::TransactionContext> txn, uint32_t oid) {
   std::vector<storage::TupleSlot> index_results;
 
   // Initialize both PR initializers, allocate buffer using size of largest one so we can reuse buffer
@@ -2203,7 +2255,14 @@ bool DatabaseCatalog::TryLock(const common::ManagedPointer<transaction::Transact
   if (write_lock_.compare_exchange_strong(current_val, txn_id)) {
     // acquired the lock
     auto *const write_lock = &write_lock_;
-    txn->RegisterCommitAction([=]() -> void { write_lock->store(txn->FinishTime()); });
+    auto *const cache = &cache_;
+    txn->RegisterCommitAction([=](transaction::DeferredActionManager *deferred_action_manager) -> void {
+      write_lock->store(txn->FinishTime());
+      // Everything cached describes the catalog before this change. Txns still running may be reading the old cache,
+      // so it lives until they're done.
+      auto *const stale_cache = cache->exchange(new CatalogCache(txn->FinishTime()));
+      deferred_action_manager->RegisterDeferredAction([=]() { delete stale_cache; });
+    });
     txn->RegisterAbortAction([=]() -> void { write_lock->store(current_val); });
     return true;
   }
@@ -2212,6 +2271,18 @@ bool DatabaseCatalog::TryLock(const common::ManagedPointer<transaction::Transact
   return false;
 }
 
+CatalogCache *DatabaseCatalog::GetCache(const common::ManagedPointer<transaction::TransactionContext> txn) {
+  const transaction::timestamp_t version = write_lock_.load();
+  // While a DDL change is in progress the lock holds the txn id of its txn, not a commit timestamp
+  if (!transaction::TransactionUtil::Committed(version) ||
+      !transaction::TransactionUtil::NewerThan(txn->StartTime(), version)) {
+    return nullptr;
+  }
+  // The DDL change that committed at version may not have replaced the cache yet
+  auto *const cache = cache_.load();
+  return cache->Version() == version ? cache : nullptr;
+}
+
 bool DatabaseCatalog::CreateLanguage(const common::ManagedPointer<transaction::TransactionContext> txn,
                                      const std::string &lanname, language_oid_t oid) {
   // Insert into table
@@ -200,6 +200,12 @@ ast::Expr *CodeGen::PCIFilter(ast::Identifier pci, parser::ExpressionType comp_t
     case parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO:
       builtin = ast::Builtin::FilterGe;
       break;
+    case parser::ExpressionType::COMPARE_LIKE:
+      builtin = ast::Builtin::FilterLike;
+      break;
+    case parser::ExpressionType::COMPARE_NOT_LIKE:
+      builtin = ast::Builtin::FilterNotLike;
+      break;
     default:
       UNREACHABLE("Impossible filter comparison!");
   }
@@ -211,6 +217,64 @@ ast::Expr *CodeGen::PCIFilter(ast::Identifier pci, parser::ExpressionType comp_t
   return Factory()->NewBuiltinCallExpr(fun, std::move(args));
 }
 
+ast::Expr *CodeGen::PCICompute(ast::Identifier pci, parser::ExpressionType op_type, uint32_t out_idx,
+                               uint32_t col_idx_1, type::TypeId type_1, uint32_t col_idx_2, type::TypeId type_2) {
+  // Call @pciComputeOp(pci, out_idx, col_idx_1, type_1, col_idx_2, type_2)
+  ast::Builtin builtin;
+  switch (op_type) {
+    case parser::ExpressionType::OPERATOR_PLUS:
+      builtin = ast::Builtin::PCIComputeAdd;
+      break;
+    case parser::ExpressionType::OPERATOR_MINUS:
+      builtin = ast::Builtin::PCIComputeSub;
+      break;
+    case parser::ExpressionType::OPERATOR_MULTIPLY:
+      builtin = ast::Builtin::PCIComputeMul;
+      break;
+    default:
+      UNREACHABLE("Impossible vectorized arithmetic!");
+  }
+  ast::Expr *fun = BuiltinFunction(builtin);
+  util::RegionVector<ast::Expr *> args{{MakeExpr(pci), IntLiteral(out_idx), IntLiteral(col_idx_1),
+                                        IntLiteral(static_cast<int8_t>(type_1)), IntLiteral(col_idx_2),
+                                        IntLiteral(static_cast<int8_t>(type_2))},
+                                       Region()};
+  return Factory()->NewBuiltinCallExpr(fun, std::move(args));
+}
+
+ast::Expr *CodeGen::PCIComputeVal(ast::Identifier pci, parser::ExpressionType op_type, uint32_t out_idx,
+                                  uint32_t col_idx, type::TypeId type, int64_t val, bool val_on_left) {
+  // Call @pciComputeOpVal(pci, out_idx, col_idx, type, val). Only subtraction depends on the order of its operands.
+  ast::Builtin builtin;
+  switch (op_type) {
+    case parser::ExpressionType::OPERATOR_PLUS:
+      builtin = ast::Builtin::PCIComputeAddVal;
+      break;
+    case parser::ExpressionType::OPERATOR_MINUS:
+      builtin = val_on_left ? ast::Builtin::PCIComputeValSub : ast::Builtin::PCIComputeSubVal;
+      break;
+    case parser::ExpressionType::OPERATOR_MULTIPLY:
+      builtin = ast::Builtin::PCIComputeMulVal;
+      break;
+    default:
+      UNREACHABLE("Impossible vectorized arithmetic!");
+  }
+  ast::Expr *fun = BuiltinFunction(builtin);
+  util::RegionVector<ast::Expr *> args{
+      {MakeExpr(pci), IntLiteral(out_idx), IntLiteral(col_idx), IntLiteral(static_cast<int8_t>(type)), IntLiteral(val)},
+      Region()};
+  return Factory()->NewBuiltinCallExpr(fun, std::move(args));
+}
+
+ast::Expr *CodeGen::PCIGetComputed(ast::Identifier pci, uint32_t idx) {
+  // Call @pciGetComputed(pci, idx)
+  ast::Expr *fun = BuiltinFunction(ast::Builtin::PCIGetComputed);
+  util::RegionVector<ast::Expr *> args{{MakeExpr(pci), IntLiteral(idx)}, Region()};
+  ast::Expr *ret = Factory()->NewBuiltinCallExpr(fun, std::move(args));
+  ret->SetType(ast::BuiltinType::Get(Context(), ast::BuiltinType::Integer));
+  return ret;
+}
+
 ast::Expr *CodeGen::ExecCtxGetMem() {
   return OneArgCall(ast::Builtin::ExecutionContextGetMemoryPool, exec_ctx_var_, false);
 }
@@ -232,9 +296,10 @@ ast::Expr *CodeGen::HTInitCall(ast::Builtin builtin, ast::Identifier object, ast
 }
 
 ast::Expr *CodeGen::IndexIteratorInit(ast::Identifier iter, uint32_t num_attrs, uint32_t table_oid, uint32_t index_oid,
-                                      ast::Identifier col_oids) {
+                                      ast::Identifier col_oids, bool covering) {
   // @indexIteratorInit(&iter, table_oid, index_oid, execCtx)
-  ast::Expr *fun = BuiltinFunction(ast::Builtin::IndexIteratorInit);
+  ast::Expr *fun =
+      BuiltinFunction(covering ? ast::Builtin::IndexIteratorInitCovering : ast::Builtin::IndexIteratorInit);
   ast::Expr *iter_ptr = PointerTo(iter);
   ast::Expr *exec_ctx_expr = MakeExpr(exec_ctx_var_);
   ast::Expr *num_attrs_expr = IntLiteral(static_cast<int32_t>(num_attrs));
@@ -246,7 +311,8 @@ ast::Expr *CodeGen::IndexIteratorInit(ast::Identifier iter, uint32_t num_attrs,
   return Factory()->NewBuiltinCallExpr(fun, std::move(args));
 }
 
-ast::Expr *CodeGen::IndexIteratorScan(ast::Identifier iter, planner::IndexScanType scan_type, uint32_t limit) {
+ast::Expr *CodeGen::IndexIteratorScan(ast::Identifier iter, planner::IndexScanType scan_type, uint32_t limit,
+                                      bool stream) {
   // @indexIteratorScanKey(&iter)
   ast::Builtin builtin;
   bool asc_scan = false;
@@ -262,7 +328,7 @@ ast::Expr *CodeGen::IndexIteratorScan(ast::Identifier iter, planner::IndexScanTy
     case planner::IndexScanType::AscendingOpenBoth:
       asc_scan = true;
       use_limit = true;
-      builtin = ast::Builtin::IndexIteratorScanAscending;
+      builtin = stream ? ast::Builtin::IndexIteratorStreamAscending : ast::Builtin::IndexIteratorScanAscending;
       if (scan_type == planner::IndexScanType::AscendingClosed)
         asc_type = storage::index::ScanType::Closed;
       else if (scan_type == planner::IndexScanType::AscendingOpenHigh)
@@ -594,9 +660,12 @@ ast::Expr *CodeGen::TimestampToSql(uint64_t julian_usec) {
 }
 
 ast::Expr *CodeGen::StringToSql(std::string_view str) {
+  return OneArgCall(ast::Builtin::StringToSql, StringLiteral(str));
+}
+
+ast::Expr *CodeGen::StringLiteral(std::string_view str) {
   ast::Identifier str_ident = Context()->GetIdentifier({str.data(), str.length()});
-  ast::Expr *str_lit = Factory()->NewStringLiteral(DUMMY_POS, str_ident);
-  return OneArgCall(ast::Builtin::StringToSql, str_lit);
+  return Factory()->NewStringLiteral(DUMMY_POS, str_ident);
 }
 
 ast::Expr *CodeGen::StorageInterfaceInit(ast::Identifier si, uint32_t table_oid, ast::Identifier col_oids,
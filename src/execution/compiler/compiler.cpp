@@ -8,6 +8,7 @@
 #include "execution/compiler/translator_factory.h"
 #include "execution/sema/sema.h"
 #include "loggers/execution_logger.h"
+#include "planner/plannodes/set_op_plan_node.h"
 
 namespace terrier::execution::compiler {
 
@@ -111,6 +112,34 @@ void Compiler::MakePipelines(const terrier::planner::AbstractPlanNode &op, Pipel
       curr_pipeline->Add(std::move(right_translator));
       return;
     }
+    case terrier::planner::PlanNodeType::SETOP: {
+      auto left_translator = TranslatorFactory::CreateLeftTranslator(&op, codegen_);
+      auto right_translator = TranslatorFactory::CreateRightTranslator(&op, left_translator.get(), codegen_);
+      if (static_cast<const planner::SetOpPlanNode &>(op).GetSetOp() == planner::SetOpType::UNION_ALL) {
+        // UNION ALL keeps every row, so both sides just feed the current pipeline, one after the other.
+        MakePipelines(*op.GetChild(0), curr_pipeline);
+        curr_pipeline->Add(std::move(left_translator));
+        MakePipelines(*op.GetChild(1), curr_pipeline);
+        curr_pipeline->Add(std::move(right_translator));
+        return;
+      }
+      // Other set operations count the rows of each side in a hash table (built by the left side), then iterate
+      // through it.
+      auto top_translator = TranslatorFactory::CreateTopTranslator(&op, left_translator.get(), codegen_);
+      // Both sides are pipeline breakers. The left side goes first, because only it creates entries for most
+      // set operations.
+      auto left_pipeline = std::make_unique<Pipeline>(codegen_);
+      MakePipelines(*op.GetChild(0), left_pipeline.get());
+      left_pipeline->Add(std::move(left_translator));
+      pipelines_.emplace_back(std::move(left_pipeline));
+      auto right_pipeline = std::make_unique<Pipeline>(codegen_);
+      MakePipelines(*op.GetChild(1), right_pipeline.get());
+      right_pipeline->Add(std::move(right_translator));
+      pipelines_.emplace_back(std::move(right_pipeline));
+      // The "iterate" side terminates the current pipeline.
+      curr_pipeline->Add(std::move(top_translator));
+      return;
+    }
     case terrier::planner::PlanNodeType::NESTLOOP: {
       // The two sides of the nested loop join belong to the same pipeline. They are just concatenated together.
       // These two translator glue the two sides together and ensure that expression evaluation is correctly done.
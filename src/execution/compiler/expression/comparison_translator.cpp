@@ -12,6 +12,14 @@ ast::Expr *ComparisonTranslator::DeriveExpr(ExpressionEvaluator *evaluator) {
   auto *left_expr = left_->DeriveExpr(evaluator);
   auto *right_expr = right_->DeriveExpr(evaluator);
   parsing::Token::Type op_token;
+  if (expression_->GetExpressionType() == terrier::parser::ExpressionType::COMPARE_LIKE ||
+      expression_->GetExpressionType() == terrier::parser::ExpressionType::COMPARE_NOT_LIKE) {
+    // @like(execCtx, str, pattern). NOT LIKE compares the result to false, which keeps NULL inputs NULL.
+    auto *exec_ctx = codegen_->MakeExpr(codegen_->GetExecCtxVar());
+    auto *like_call = codegen_->BuiltinCall(ast::Builtin::Like, {exec_ctx, left_expr, right_expr});
+    if (expression_->GetExpressionType() == terrier::parser::ExpressionType::COMPARE_LIKE) return like_call;
+    return codegen_->Compare(parsing::Token::Type::EQUAL_EQUAL, like_call, codegen_->BoolLiteral(false));
+  }
   switch (expression_->GetExpressionType()) {
     case terrier::parser::ExpressionType::COMPARE_EQUAL:
       op_token = parsing::Token::Type::EQUAL_EQUAL;
@@ -44,9 +44,23 @@ void IndexJoinTranslator::Abort(FunctionBuilder *builder) {
   child_translator_->Abort(builder);
 }
 
-void IndexJoinTranslator::Consume(FunctionBuilder *builder) {
-  // Fill the key with table data
+void IndexJoinTranslator::ConsumeVectorTuple(FunctionBuilder *builder) {
+  batched_lookup_ = true;
+  // Fill the key with table data, and add it to the batch
   FillKey(builder);
+  ast::Expr *add_key_call = codegen_->OneArgCall(ast::Builtin::IndexIteratorAddKey, index_iter_, true);
+  builder->Append(codegen_->MakeStmt(add_key_call));
+}
+
+void IndexJoinTranslator::FinishVector(FunctionBuilder *builder) {
+  // @indexIteratorScanKeys(&index_iter)
+  ast::Expr *scan_keys_call = codegen_->OneArgCall(ast::Builtin::IndexIteratorScanKeys, index_iter_, true);
+  builder->Append(codegen_->MakeStmt(scan_keys_call));
+}
+
+void IndexJoinTranslator::Consume(FunctionBuilder *builder) {
+  // Fill the key with table data, unless it was already looked up with the rest of its vector
+  if (!batched_lookup_) FillKey(builder);
   // Generate the loop
   GenForLoop(builder);
   // Get Table PR
@@ -138,8 +152,11 @@ void IndexJoinTranslator::FillKey(FunctionBuilder *builder) {
 
 void IndexJoinTranslator::GenForLoop(FunctionBuilder *builder) {
   // for (@indexIteratorScanKey(&index_iter); @indexIteratorAdvance(&index_iter);)
+  // or, when the keys were looked up in a batch, for (@indexIteratorScanNextKey(&index_iter); ...)
   // Loop Initialization
-  ast::Expr *scan_call = codegen_->IndexIteratorScan(index_iter_, planner::IndexScanType::Exact, 0);
+  ast::Expr *scan_call = batched_lookup_
+                             ? codegen_->OneArgCall(ast::Builtin::IndexIteratorScanNextKey, index_iter_, true)
+                             : codegen_->IndexIteratorScan(index_iter_, planner::IndexScanType::Exact, 0);
   ast::Stmt *loop_init = codegen_->MakeStmt(scan_call);
   // Loop condition
   ast::Expr *advance_call = codegen_->OneArgCall(ast::Builtin::IndexIteratorAdvance, index_iter_, true);
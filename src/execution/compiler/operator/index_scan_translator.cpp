@@ -23,7 +23,30 @@ IndexScanTranslator::IndexScanTranslator(const planner::IndexScanPlanNode *op, C
       hi_index_pr_(codegen->NewIdentifier("hi_index_pr")),
       table_pr_(codegen->NewIdentifier("table_pr")),
       pr_type_(codegen->Context()->GetIdentifier("ProjectedRow")),
-      slot_(codegen->NewIdentifier("slot")) {}
+      slot_(codegen->NewIdentifier("slot")) {
+  if (op_->IsCoveringScan()) {
+    for (const auto &key_col : index_schema_.GetColumns()) {
+      auto cve = key_col.StoredExpression().CastManagedPointerTo<const parser::ColumnValueExpression>();
+      auto col_oid = cve->GetColumnOid();
+      if (col_oid == catalog::INVALID_COLUMN_OID) col_oid = table_schema_.GetColumn(cve->GetColumnName()).Oid();
+      key_pm_.emplace(col_oid, index_pm_.at(key_col.Oid()));
+    }
+  }
+}
+
+bool IndexScanTranslator::CanStream() const {
+  // Updates and inserts add index entries that a streaming scan could come across again later in the range
+  if (parent_translator_ == nullptr) return true;
+  auto parent_type = parent_translator_->GetFeatureType();
+  return parent_type != brain::ExecutionOperatingUnitType::UPDATE &&
+         parent_type != brain::ExecutionOperatingUnitType::DELETE &&
+         parent_type != brain::ExecutionOperatingUnitType::INSERT;
+}
+
+bool IndexScanTranslator::IsCovering() const {
+  // Keys are only handed out by exact lookups and streaming ascending scans
+  return op_->IsCoveringScan() && (op_->GetScanType() == planner::IndexScanType::Exact || CanStream());
+}
 
 void IndexScanTranslator::Produce(FunctionBuilder *builder) {
   // Create the col_oid array
@@ -85,7 +108,8 @@ ast::Expr *IndexScanTranslator::GetChildOutput(uint32_t child_idx, uint32_t attr
 ast::Expr *IndexScanTranslator::GetTableColumn(const catalog::col_oid_t &col_oid) {
   auto type = table_schema_.GetColumn(col_oid).Type();
   auto nullable = table_schema_.GetColumn(col_oid).Nullable();
-  uint16_t attr_idx = table_pm_[col_oid];
+  // For covering scans, the row is the index key
+  uint16_t attr_idx = IsCovering() ? key_pm_.at(col_oid) : table_pm_[col_oid];
   return codegen_->PRGet(codegen_->MakeExpr(table_pr_), type, nullable, attr_idx);
 }
 
@@ -114,8 +138,8 @@ void IndexScanTranslator::DeclareIterator(FunctionBuilder *builder) {
     num_attrs = std::max(op_->GetLoIndexColumns().size(), op_->GetHiIndexColumns().size());
   }
 
-  ast::Expr *init_call =
-      codegen_->IndexIteratorInit(index_iter_, num_attrs, !op_->GetTableOid(), !op_->GetIndexOid(), col_oids_);
+  ast::Expr *init_call = codegen_->IndexIteratorInit(index_iter_, num_attrs, !op_->GetTableOid(), !op_->GetIndexOid(),
+                                                     col_oids_, IsCovering());
   builder->Append(codegen_->MakeStmt(init_call));
 }
 
@@ -159,7 +183,7 @@ void IndexScanTranslator::FillKey(
 void IndexScanTranslator::GenForLoop(FunctionBuilder *builder) {
   // for (@indexIteratorScanKey(&index_iter); @indexIteratorAdvance(&index_iter);)
   // Loop Initialization
-  ast::Expr *scan_call = codegen_->IndexIteratorScan(index_iter_, op_->GetScanType(), op_->ScanLimit());
+  ast::Expr *scan_call = codegen_->IndexIteratorScan(index_iter_, op_->GetScanType(), op_->ScanLimit(), CanStream());
 
   ast::Stmt *loop_init = codegen_->MakeStmt(scan_call);
   // Loop condition
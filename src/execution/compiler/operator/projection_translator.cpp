@@ -0,0 +1,142 @@
+#include "execution/compiler/operator/projection_translator.h"
+
+#include "execution/compiler/codegen.h"
+#include "execution/compiler/function_builder.h"
+#include "execution/sql/projected_columns_iterator.h"
+#include "parser/expression/constant_value_expression.h"
+#include "parser/expression/derived_value_expression.h"
+#include "type/transient_value_peeker.h"
+
+namespace terrier::execution::compiler {
+
+namespace {
+bool IsIntegerType(terrier::type::TypeId type) {
+  return type >= terrier::type::TypeId::TINYINT && type <= terrier::type::TypeId::BIGINT;
+}
+
+bool IsArithmeticOp(terrier::parser::ExpressionType type) {
+  // Divisions and modulos stay tuple at a time, since dividing by zero makes them NULL.
+  return type == terrier::parser::ExpressionType::OPERATOR_PLUS ||
+         type == terrier::parser::ExpressionType::OPERATOR_MINUS ||
+         type == terrier::parser::ExpressionType::OPERATOR_MULTIPLY;
+}
+
+bool IsIntegerConstant(const terrier::parser::AbstractExpression *expr) {
+  if (expr->GetExpressionType() != terrier::parser::ExpressionType::VALUE_CONSTANT) return false;
+  const auto &val = dynamic_cast<const terrier::parser::ConstantValueExpression *>(expr)->GetValue();
+  return IsIntegerType(val.Type()) && !val.Null();
+}
+
+int64_t GetIntegerConstant(const terrier::parser::AbstractExpression *expr) {
+  const auto &val = dynamic_cast<const terrier::parser::ConstantValueExpression *>(expr)->GetValue();
+  switch (val.Type()) {
+    case terrier::type::TypeId::TINYINT:
+      return terrier::type::TransientValuePeeker::PeekTinyInt(val);
+    case terrier::type::TypeId::SMALLINT:
+      return terrier::type::TransientValuePeeker::PeekSmallInt(val);
+    case terrier::type::TypeId::INTEGER:
+      return terrier::type::TransientValuePeeker::PeekInteger(val);
+    case terrier::type::TypeId::BIGINT:
+      return terrier::type::TransientValuePeeker::PeekBigInt(val);
+    default:
+      UNREACHABLE("Not an integer constant!");
+  }
+}
+}  // namespace
+
+void ProjectionTranslator::StartVector(FunctionBuilder *builder, ast::Identifier pci) {
+  pci_ = pci;
+  next_computed_col_ = sql::ProjectedColumnsIterator::COMPUTED_COL_START;
+  computed_outputs_.clear();
+  const auto &cols = op_->GetOutputSchema()->GetColumns();
+  for (uint32_t attr_idx = 0; attr_idx < cols.size(); attr_idx++) {
+    auto output_expr = cols[attr_idx].GetExpr().Get();
+    if (IsVectorArithmetic(output_expr)) {
+      computed_outputs_[attr_idx] = GenVectorArithmetic(builder, output_expr);
+    }
+  }
+  parent_translator_->StartVector(builder, pci);
+}
+
+bool ProjectionTranslator::GetVectorColumn(uint32_t attr_idx, uint32_t *col_idx, terrier::type::TypeId *type) {
+  auto computed = computed_outputs_.find(attr_idx);
+  if (computed != computed_outputs_.end()) {
+    *col_idx = computed->second;
+    *type = terrier::type::TypeId::BIGINT;
+    return true;
+  }
+  auto output_expr = op_->GetOutputSchema()->GetColumn(attr_idx).GetExpr();
+  if (output_expr->GetExpressionType() != terrier::parser::ExpressionType::VALUE_TUPLE) return false;
+  auto dve = dynamic_cast<const terrier::parser::DerivedValueExpression *>(output_expr.Get());
+  return child_translator_->GetVectorColumn(dve->GetValueIdx(), col_idx, type);
+}
+
+ast::Expr *ProjectionTranslator::GetOutput(uint32_t attr_idx) {
+  auto computed = computed_outputs_.find(attr_idx);
+  if (computed != computed_outputs_.end()) {
+    return codegen_->PCIGetComputed(pci_, computed->second);
+  }
+  auto output_expr = op_->GetOutputSchema()->GetColumn(attr_idx).GetExpr();
+  auto translator = TranslatorFactory::CreateExpressionTranslator(output_expr.Get(), codegen_);
+  return translator->DeriveExpr(this);
+}
+
+bool ProjectionTranslator::IsVectorArithmetic(const terrier::parser::AbstractExpression *expr) {
+  if (!IsArithmeticOp(expr->GetExpressionType())) return false;
+  auto left = expr->GetChild(0).Get();
+  auto right = expr->GetChild(1).Get();
+  if (!IsVectorOperand(left) || !IsVectorOperand(right)) return false;
+  return !IsIntegerConstant(left) || !IsIntegerConstant(right);
+}
+
+bool ProjectionTranslator::IsVectorOperand(const terrier::parser::AbstractExpression *expr) {
+  if (IsIntegerConstant(expr) || IsVectorArithmetic(expr)) return true;
+  if (expr->GetExpressionType() != terrier::parser::ExpressionType::VALUE_TUPLE) return false;
+  auto dve = dynamic_cast<const terrier::parser::DerivedValueExpression *>(expr);
+  uint32_t col_idx;
+  terrier::type::TypeId type;
+  return child_translator_->GetVectorColumn(dve->GetValueIdx(), &col_idx, &type) && IsIntegerType(type);
+}
+
+uint32_t ProjectionTranslator::GenVectorArithmetic(FunctionBuilder *builder,
+                                                   const terrier::parser::AbstractExpression *expr) {
+  auto left = expr->GetChild(0).Get();
+  auto right = expr->GetChild(1).Get();
+  uint32_t col_idx_1, col_idx_2;
+  terrier::type::TypeId type_1, type_2;
+  ast::Expr *compute_call;
+  if (IsIntegerConstant(left)) {
+    // @pciComputeValOp(pci, out_idx, right_col, right_type, left_val)
+    GenVectorOperand(builder, right, &col_idx_2, &type_2);
+    compute_call = codegen_->PCIComputeVal(pci_, expr->GetExpressionType(), next_computed_col_, col_idx_2, type_2,
+                                           GetIntegerConstant(left), true);
+  } else if (IsIntegerConstant(right)) {
+    // @pciComputeOpVal(pci, out_idx, left_col, left_type, right_val)
+    GenVectorOperand(builder, left, &col_idx_1, &type_1);
+    compute_call = codegen_->PCIComputeVal(pci_, expr->GetExpressionType(), next_computed_col_, col_idx_1, type_1,
+                                           GetIntegerConstant(right), false);
+  } else {
+    // @pciComputeOp(pci, out_idx, left_col, left_type, right_col, right_type)
+    GenVectorOperand(builder, left, &col_idx_1, &type_1);
+    GenVectorOperand(builder, right, &col_idx_2, &type_2);
+    compute_call = codegen_->PCICompute(pci_, expr->GetExpressionType(), next_computed_col_, col_idx_1, type_1,
+                                        col_idx_2, type_2);
+  }
+  // Operands were computed first, so the result goes into the next computed column.
+  builder->Append(codegen_->MakeStmt(compute_call));
+  return next_computed_col_++;
+}
+
+void ProjectionTranslator::GenVectorOperand(FunctionBuilder *builder, const terrier::parser::AbstractExpression *expr,
+                                            uint32_t *col_idx, terrier::type::TypeId *type) {
+  if (expr->GetExpressionType() == terrier::parser::ExpressionType::VALUE_TUPLE) {
+    auto dve = dynamic_cast<const terrier::parser::DerivedValueExpression *>(expr);
+    child_translator_->GetVectorColumn(dve->GetValueIdx(), col_idx, type);
+    return;
+  }
+  // Computed columns are BIGINT
+  *col_idx = GenVectorArithmetic(builder, expr);
+  *type = terrier::type::TypeId::BIGINT;
+}
+
+}  // namespace terrier::execution::compiler
@@ -6,6 +6,7 @@
 #include "execution/compiler/function_builder.h"
 #include "execution/compiler/pipeline.h"
 #include "execution/compiler/translator_factory.h"
+#include "parser/expression/column_value_expression.h"
 #include "parser/expression/constant_value_expression.h"
 #include "planner/plannodes/seq_scan_plan_node.h"
 
@@ -52,18 +53,20 @@ void SeqScanTranslator::DoTableScan(FunctionBuilder *builder) {
   // Start looping over the table
   GenTVILoop(builder);
   DeclarePCI(builder);
-  // The PCI loop depends on whether we vectorize or not.
-  bool has_if_stmt = false;
-  if (is_vectorizable_) {
-    if (has_predicate_) GenVectorizedPredicate(builder, op_->GetScanPredicate().Get());
-    GenPCILoop(builder);
-  } else {
-    GenPCILoop(builder);
-    if (has_predicate_) {
-      GenScanCondition(builder);
-      has_if_stmt = true;
-    }
+  // Vectorized predicates filter the whole PCI up front.
+  if (is_vectorizable_ && has_predicate_) GenVectorizedPredicate(builder, op_->GetScanPredicate().Get());
+  // Let the parent evaluate its expressions over the whole filtered vector.
+  parent_translator_->StartVector(builder, pci_);
+  // Let the parent go over the whole vector first, if it wants to.
+  if (parent_translator_->ConsumesVectors()) {
+    bool has_vector_if_stmt = GenTupleLoop(builder);
+    parent_translator_->ConsumeVectorTuple(builder);
+    if (has_vector_if_stmt) builder->FinishBlockStmt();
+    builder->FinishBlockStmt();
+    parent_translator_->FinishVector(builder);
+    GenPCIReset(builder);
   }
+  bool has_if_stmt = GenTupleLoop(builder);
   // Declare Slot.
   DeclareSlot(builder);
   // Let parent consume.
@@ -99,6 +102,15 @@ ast::Expr *SeqScanTranslator::GetTableColumn(const catalog::col_oid_t &col_oid)
   return codegen_->PCIGet(pci_, type, nullable, attr_idx);
 }
 
+bool SeqScanTranslator::GetVectorColumn(uint32_t attr_idx, uint32_t *col_idx, terrier::type::TypeId *type) {
+  auto output_expr = op_->GetOutputSchema()->GetColumn(attr_idx).GetExpr();
+  if (output_expr->GetExpressionType() != terrier::parser::ExpressionType::COLUMN_VALUE) return false;
+  auto col_oid = dynamic_cast<const terrier::parser::ColumnValueExpression *>(output_expr.Get())->GetColumnOid();
+  *col_idx = pm_[col_oid];
+  *type = schema_.GetColumn(col_oid).Type();
+  return true;
+}
+
 void SeqScanTranslator::DeclareTVI(FunctionBuilder *builder) {
   // var tvi: TableVectorIterator
   ast::Expr *iter_type = codegen_->BuiltinType(ast::BuiltinType::Kind::TableVectorIterator);
@@ -156,6 +168,24 @@ void SeqScanTranslator::GenPCILoop(FunctionBuilder *builder) {
   builder->StartForStmt(nullptr, has_next_call, loop_advance);
 }
 
+bool SeqScanTranslator::GenTupleLoop(FunctionBuilder *builder) {
+  GenPCILoop(builder);
+  // Predicates that are not vectorized are checked tuple at a time.
+  if (has_predicate_ && !is_vectorizable_) {
+    GenScanCondition(builder);
+    return true;
+  }
+  return false;
+}
+
+void SeqScanTranslator::GenPCIReset(FunctionBuilder *builder) {
+  // @pciReset(pci) or the Filtered version
+  ast::Builtin reset_fn =
+      (is_vectorizable_ && has_predicate_) ? ast::Builtin::PCIResetFiltered : ast::Builtin::PCIReset;
+  ast::Expr *reset_call = codegen_->OneArgCall(reset_fn, pci_, false);
+  builder->Append(codegen_->MakeStmt(reset_call));
+}
+
 void SeqScanTranslator::GenScanCondition(FunctionBuilder *builder) {
   // Generate tuple at a time scan condition
   auto predicate = op_->GetScanPredicate();
@@ -195,6 +225,21 @@ bool SeqScanTranslator::IsVectorizable(const terrier::parser::AbstractExpression
         (predicate->GetChild(1)->GetReturnValueType() >= terrier::type::TypeId::TINYINT &&
             predicate->GetChild(1)->GetReturnValueType() <= terrier::type::TypeId::BIGINT);
   }*/
+  // Only conjunctions of string column vs string constant comparisons (including LIKE) are vectorized for now.
+  if (predicate == nullptr) return false;
+  if (predicate->GetExpressionType() == terrier::parser::ExpressionType::CONJUNCTION_AND) {
+    return IsVectorizable(predicate->GetChild(0).Get()) && IsVectorizable(predicate->GetChild(1).Get());
+  }
+  if (TranslatorFactory::IsComparisonOp(predicate->GetExpressionType())) {
+    // left is TVE and right is a non-NULL constant string.
+    if (predicate->GetChild(0)->GetExpressionType() != terrier::parser::ExpressionType::COLUMN_VALUE ||
+        predicate->GetChild(1)->GetExpressionType() != terrier::parser::ExpressionType::VALUE_CONSTANT) {
+      return false;
+    }
+    auto const_val = dynamic_cast<const terrier::parser::ConstantValueExpression *>(predicate->GetChild(1).Get());
+    return predicate->GetChild(0)->GetReturnValueType() == terrier::type::TypeId::VARCHAR &&
+           const_val->GetValue().Type() == terrier::type::TypeId::VARCHAR && !const_val->GetValue().Null();
+  }
   return false;
 }
 
@@ -225,12 +270,16 @@ void SeqScanTranslator::GenVectorizedPredicate(FunctionBuilder *builder,
         filter_val =
             codegen_->IntLiteral(static_cast<int32_t>(terrier::type::TransientValuePeeker::PeekBigInt(trans_val)));
         break;
+      case terrier::type::TypeId::VARCHAR:
+        filter_val = codegen_->StringLiteral(terrier::type::TransientValuePeeker::PeekVarChar(trans_val));
+        break;
       default:
         UNREACHABLE("Impossible vectorized predicate!");
     }
     ast::Expr *filter_call = codegen_->PCIFilter(pci_, predicate->GetExpressionType(), col_idx, col_type, filter_val);
     builder->Append(codegen_->MakeStmt(filter_call));
+  } else {
+    UNREACHABLE("This function should not be called on non vectorized predicates!");
   }
-  UNREACHABLE("This function should not be called on non vectorized predicates!");
 }
 }  // namespace terrier::execution::compiler
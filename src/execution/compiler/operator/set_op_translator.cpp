@@ -0,0 +1,297 @@
+#include "execution/compiler/operator/set_op_translator.h"
+#include <utility>
+#include <vector>
+#include "execution/compiler/function_builder.h"
+#include "execution/compiler/translator_factory.h"
+
+namespace terrier::execution::compiler {
+
+SetOpLeftTranslator::SetOpLeftTranslator(const terrier::planner::SetOpPlanNode *op, CodeGen *codegen)
+    : OperatorTranslator(codegen, brain::ExecutionOperatingUnitType::AGGREGATE_BUILD),
+      op_(op),
+      ht_(codegen->NewIdentifier("set_op_ht")),
+      entry_struct_(codegen->NewIdentifier("SetOpEntry")),
+      values_struct_(codegen->NewIdentifier("SetOpValues")),
+      key_check_(codegen->NewIdentifier("setOpKeyCheckFn")),
+      entry_(codegen->NewIdentifier("set_op_entry")),
+      values_(codegen->NewIdentifier("set_op_values")),
+      hash_val_(codegen->NewIdentifier("set_op_hash_val")),
+      left_count_(codegen->NewIdentifier("left_count")),
+      right_count_(codegen->NewIdentifier("right_count")) {
+  TERRIER_ASSERT(op_->GetChildrenSize() == 2, "Set operations have two children");
+  for (uint32_t i = 0; i < op_->GetChild(0)->GetOutputSchema()->GetColumns().size(); i++) {
+    keys_.emplace_back(codegen->NewIdentifier("set_op_key"));
+  }
+}
+
+void SetOpLeftTranslator::InitializeStateFields(util::RegionVector<ast::FieldDecl *> *state_fields) {
+  ast::Expr *ht_type = codegen_->BuiltinType(ast::BuiltinType::Kind::AggregationHashTable);
+  state_fields->emplace_back(codegen_->MakeField(ht_, ht_type));
+}
+
+void SetOpLeftTranslator::InitializeStructs(util::RegionVector<ast::Decl *> *decls) {
+  const auto &cols = op_->GetChild(0)->GetOutputSchema()->GetColumns();
+  // The values struct contains the keys
+  util::RegionVector<ast::FieldDecl *> values_fields{codegen_->Region()};
+  for (uint32_t i = 0; i < cols.size(); i++) {
+    ast::Expr *type = codegen_->TplType(cols[i].GetExpr()->GetReturnValueType());
+    values_fields.emplace_back(codegen_->MakeField(keys_[i], type));
+  }
+  decls->emplace_back(codegen_->MakeStruct(values_struct_, std::move(values_fields)));
+
+  // The entry struct also contains the count of each side
+  util::RegionVector<ast::FieldDecl *> entry_fields{codegen_->Region()};
+  for (uint32_t i = 0; i < cols.size(); i++) {
+    ast::Expr *type = codegen_->TplType(cols[i].GetExpr()->GetReturnValueType());
+    entry_fields.emplace_back(codegen_->MakeField(keys_[i], type));
+  }
+  entry_fields.emplace_back(codegen_->MakeField(left_count_, codegen_->BuiltinType(ast::BuiltinType::Kind::Int64)));
+  entry_fields.emplace_back(codegen_->MakeField(right_count_, codegen_->BuiltinType(ast::BuiltinType::Kind::Int64)));
+  decls->emplace_back(codegen_->MakeStruct(entry_struct_, std::move(entry_fields)));
+}
+
+void SetOpLeftTranslator::InitializeHelperFunctions(util::RegionVector<ast::Decl *> *decls) {
+  // Create a function (entry: *SetOpEntry, values: *SetOpValues) -> bool
+  ast::FieldDecl *param1 = codegen_->MakeField(entry_, codegen_->PointerType(entry_struct_));
+  ast::FieldDecl *param2 = codegen_->MakeField(values_, codegen_->PointerType(values_struct_));
+  util::RegionVector<ast::FieldDecl *> params({param1, param2}, codegen_->Region());
+  ast::Expr *ret_type = codegen_->BuiltinType(ast::BuiltinType::Kind::Bool);
+  FunctionBuilder builder(codegen_, key_check_, std::move(params), ret_type);
+  // Unlike in comparisons, NULLs are equal to each other and different from everything else in set operations.
+  for (const auto &key : keys_) {
+    // if (@isValNull(entry.key)) { if (@isValNotNull(values.key)) { return false } }
+    builder.StartIfStmt(codegen_->IsSqlNull(codegen_->MemberExpr(entry_, key)));
+    builder.StartIfStmt(codegen_->IsSqlNotNull(codegen_->MemberExpr(values_, key)));
+    builder.Append(codegen_->ReturnStmt(codegen_->BoolLiteral(false)));
+    builder.FinishBlockStmt();
+    builder.FinishBlockStmt();
+    // if (@isValNull(values.key)) { if (@isValNotNull(entry.key)) { return false } }
+    builder.StartIfStmt(codegen_->IsSqlNull(codegen_->MemberExpr(values_, key)));
+    builder.StartIfStmt(codegen_->IsSqlNotNull(codegen_->MemberExpr(entry_, key)));
+    builder.Append(codegen_->ReturnStmt(codegen_->BoolLiteral(false)));
+    builder.FinishBlockStmt();
+    builder.FinishBlockStmt();
+    // Comparing two NULLs is not true, so this only looks at non NULL keys.
+    ast::Expr *lhs = codegen_->MemberExpr(entry_, key);
+    ast::Expr *rhs = codegen_->MemberExpr(values_, key);
+    builder.StartIfStmt(codegen_->Compare(parsing::Token::Type::BANG_EQUAL, lhs, rhs));
+    builder.Append(codegen_->ReturnStmt(codegen_->BoolLiteral(false)));
+    builder.FinishBlockStmt();
+  }
+  builder.Append(codegen_->ReturnStmt(codegen_->BoolLiteral(true)));
+  decls->emplace_back(builder.Finish());
+}
+
+void SetOpLeftTranslator::InitializeSetup(util::RegionVector<ast::Stmt *> *setup_stmts) {
+  ast::Expr *ht_init_call = codegen_->HTInitCall(ast::Builtin::AggHashTableInit, ht_, entry_struct_);
+  setup_stmts->emplace_back(codegen_->MakeStmt(ht_init_call));
+}
+
+void SetOpLeftTranslator::InitializeTeardown(util::RegionVector<ast::Stmt *> *teardown_stmts) {
+  ast::Expr *ht_free_call = codegen_->OneArgStateCall(ast::Builtin::AggHashTableFree, ht_);
+  teardown_stmts->emplace_back(codegen_->MakeStmt(ht_free_call));
+}
+
+void SetOpLeftTranslator::Produce(FunctionBuilder *builder) { child_translator_->Produce(builder); }
+
+void SetOpLeftTranslator::Abort(FunctionBuilder *builder) { child_translator_->Abort(builder); }
+
+void SetOpLeftTranslator::Consume(FunctionBuilder *builder) {
+  GenLookup(builder, child_translator_, true);
+  GenIncrement(builder, left_count_);
+}
+
+void SetOpLeftTranslator::GenLookup(FunctionBuilder *builder, OperatorTranslator *child, bool insert) {
+  // var values: SetOpValues
+  builder->Append(codegen_->DeclareVariable(values_, codegen_->MakeExpr(values_struct_), nullptr));
+  std::vector<ast::Expr *> hash_args{};
+  for (uint32_t i = 0; i < keys_.size(); i++) {
+    builder->Append(codegen_->Assign(codegen_->MemberExpr(values_, keys_[i]), child->GetOutput(i)));
+    hash_args.emplace_back(codegen_->MemberExpr(values_, keys_[i]));
+  }
+  // var hash_val = @hash(values.key...)
+  ast::Expr *hash_call = codegen_->BuiltinCall(ast::Builtin::Hash, std::move(hash_args));
+  builder->Append(codegen_->DeclareVariable(hash_val_, nullptr, hash_call));
+
+  // var entry = @ptrCast(*SetOpEntry, @aggHTLookup(&state.ht, hash_val, keyCheck, &values))
+  std::vector<ast::Expr *> lookup_args{codegen_->GetStateMemberPtr(ht_), codegen_->MakeExpr(hash_val_),
+                                       codegen_->MakeExpr(key_check_), codegen_->PointerTo(values_)};
+  ast::Expr *lookup_call = codegen_->BuiltinCall(ast::Builtin::AggHashTableLookup, std::move(lookup_args));
+  builder->Append(codegen_->DeclareVariable(entry_, nullptr, codegen_->PtrCast(entry_struct_, lookup_call)));
+  if (!insert) return;
+
+  // if (entry == nil) { entry = @ptrCast(*SetOpEntry, @aggHTInsert(&state.ht, hash_val)) ... }
+  builder->StartIfStmt(
+      codegen_->Compare(parsing::Token::Type::EQUAL_EQUAL, codegen_->NilLiteral(), codegen_->MakeExpr(entry_)));
+  std::vector<ast::Expr *> insert_args{codegen_->GetStateMemberPtr(ht_), codegen_->MakeExpr(hash_val_)};
+  ast::Expr *insert_call = codegen_->BuiltinCall(ast::Builtin::AggHashTableInsert, std::move(insert_args));
+  builder->Append(codegen_->Assign(codegen_->MakeExpr(entry_), codegen_->PtrCast(entry_struct_, insert_call)));
+  for (const auto &key : keys_) {
+    builder->Append(codegen_->Assign(codegen_->MemberExpr(entry_, key), codegen_->MemberExpr(values_, key)));
+  }
+  builder->Append(codegen_->Assign(codegen_->MemberExpr(entry_, left_count_), codegen_->IntLiteral(0)));
+  builder->Append(codegen_->Assign(codegen_->MemberExpr(entry_, right_count_), codegen_->IntLiteral(0)));
+  builder->FinishBlockStmt();
+}
+
+void SetOpLeftTranslator::GenIncrement(FunctionBuilder *builder, ast::Identifier count) {
+  ast::Expr *incremented =
+      codegen_->BinaryOp(parsing::Token::Type::PLUS, codegen_->MemberExpr(entry_, count), codegen_->IntLiteral(1));
+  builder->Append(codegen_->Assign(codegen_->MemberExpr(entry_, count), incremented));
+}
+
+///////////////////////////////////////////////
+///// Right Translator
+///////////////////////////////////////////////
+
+void SetOpRightTranslator::Consume(FunctionBuilder *builder) {
+  // Only a union keeps rows that are missing on the left side
+  const bool is_union = op_->GetSetOp() == planner::SetOpType::UNION;
+  left_->GenLookup(builder, child_translator_, is_union);
+  if (is_union) {
+    left_->GenIncrement(builder, left_->right_count_);
+    return;
+  }
+  // if (entry != nil) { entry.right_count = entry.right_count + 1 }
+  builder->StartIfStmt(codegen_->Compare(parsing::Token::Type::BANG_EQUAL, codegen_->NilLiteral(),
+                                         codegen_->MakeExpr(left_->entry_)));
+  left_->GenIncrement(builder, left_->right_count_);
+  builder->FinishBlockStmt();
+}
+
+///////////////////////////////////////////////
+///// Top Translator
+///////////////////////////////////////////////
+
+void SetOpTopTranslator::Produce(FunctionBuilder *builder) {
+  // var iter: AggregationHashTableIterator
+  ast::Expr *iter_type = codegen_->BuiltinType(ast::BuiltinType::AggregationHashTableIterator);
+  builder->Append(codegen_->DeclareVariable(iterator_, iter_type, nullptr));
+  // In case of nested loop joins, let the child produce
+  if (child_translator_ != nullptr) {
+    child_translator_->Produce(builder);
+  } else {
+    // Otherwise directly consume the hash table
+    Consume(builder);
+  }
+}
+
+void SetOpTopTranslator::Consume(FunctionBuilder *builder) {
+  GenHTLoop(builder);
+  DeclareEntry(builder);
+  bool has_block = GenCopies(builder);
+  parent_translator_->Consume(builder);
+
+  // Close the copies
+  if (has_block) {
+    builder->FinishBlockStmt();
+  }
+  // Close HT loop
+  builder->FinishBlockStmt();
+  CloseIterator(builder);
+}
+
+void SetOpTopTranslator::Abort(FunctionBuilder *builder) {
+  CloseIterator(builder);
+  if (child_translator_ != nullptr) child_translator_->Abort(builder);
+}
+
+ast::Expr *SetOpTopTranslator::GetOutput(uint32_t attr_idx) {
+  auto output_expr = op_->GetOutputSchema()->GetColumn(attr_idx).GetExpr();
+  auto translator = TranslatorFactory::CreateExpressionTranslator(output_expr.Get(), codegen_);
+  return translator->DeriveExpr(this);
+}
+
+ast::Expr *SetOpTopTranslator::GetChildOutput(uint32_t child_idx, uint32_t attr_idx, terrier::type::TypeId type) {
+  return codegen_->MemberExpr(left_->entry_, left_->keys_[attr_idx]);
+}
+
+void SetOpTopTranslator::GenHTLoop(FunctionBuilder *builder) {
+  std::vector<ast::Expr *> init_args{codegen_->PointerTo(iterator_), codegen_->GetStateMemberPtr(left_->ht_)};
+  ast::Expr *init_call = codegen_->BuiltinCall(ast::Builtin::AggHashTableIterInit, std::move(init_args));
+  ast::Expr *has_next_call = codegen_->OneArgCall(ast::Builtin::AggHashTableIterHasNext, iterator_, true);
+  ast::Expr *next_call = codegen_->OneArgCall(ast::Builtin::AggHashTableIterNext, iterator_, true);
+  builder->StartForStmt(codegen_->MakeStmt(init_call), has_next_call, codegen_->MakeStmt(next_call));
+}
+
+void SetOpTopTranslator::DeclareEntry(FunctionBuilder *builder) {
+  ast::Expr *get_row_call = codegen_->OneArgCall(ast::Builtin::AggHashTableIterGetRow, iterator_, true);
+  ast::Expr *cast_call = codegen_->PtrCast(left_->entry_struct_, get_row_call);
+  builder->Append(codegen_->DeclareVariable(left_->entry_, nullptr, cast_call));
+}
+
+bool SetOpTopTranslator::GenCopies(FunctionBuilder *builder) {
+  ast::Expr *left_count = codegen_->MemberExpr(left_->entry_, left_->left_count_);
+  ast::Expr *right_count = codegen_->MemberExpr(left_->entry_, left_->right_count_);
+  // Copy i of the row is output while i < copies, i.e. copies times
+  auto gen_copy_loop = [&](ast::Expr *cond) {
+    ast::Stmt *init = codegen_->DeclareVariable(copy_idx_, nullptr, codegen_->IntLiteral(0));
+    ast::Expr *incremented =
+        codegen_->BinaryOp(parsing::Token::Type::PLUS, codegen_->MakeExpr(copy_idx_), codegen_->IntLiteral(1));
+    builder->StartForStmt(init, cond, codegen_->Assign(codegen_->MakeExpr(copy_idx_), incremented));
+  };
+  switch (op_->GetSetOp()) {
+    case planner::SetOpType::UNION:
+      // Every distinct row of either side is output once
+      return false;
+    case planner::SetOpType::INTERSECT:
+      // Only rows of the left side are in the hash table, so this is enough to be on both sides
+      builder->StartIfStmt(codegen_->Compare(parsing::Token::Type::GREATER, right_count, codegen_->IntLiteral(0)));
+      return true;
+    case planner::SetOpType::INTERSECT_ALL: {
+      // for (var i = 0; i < entry.left_count and i < entry.right_count; i = i + 1)
+      ast::Expr *below_left = codegen_->Compare(parsing::Token::Type::LESS, codegen_->MakeExpr(copy_idx_), left_count);
+      ast::Expr *below_right =
+          codegen_->Compare(parsing::Token::Type::LESS, codegen_->MakeExpr(copy_idx_), right_count);
+      gen_copy_loop(codegen_->BinaryOp(parsing::Token::Type::AND, below_left, below_right));
+      return true;
+    }
+    case planner::SetOpType::EXCEPT:
+      builder->StartIfStmt(codegen_->Compare(parsing::Token::Type::EQUAL_EQUAL, right_count, codegen_->IntLiteral(0)));
+      return true;
+    case planner::SetOpType::EXCEPT_ALL:
+      // for (var i = 0; i < entry.left_count - entry.right_count; i = i + 1)
+      gen_copy_loop(codegen_->Compare(parsing::Token::Type::LESS, codegen_->MakeExpr(copy_idx_),
+                                      codegen_->BinaryOp(parsing::Token::Type::MINUS, left_count, right_count)));
+      return true;
+    default:
+      UNREACHABLE("Unsupported set operation");
+  }
+}
+
+void SetOpTopTranslator::CloseIterator(FunctionBuilder *builder) {
+  ast::Expr *close_call = codegen_->OneArgCall(ast::Builtin::AggHashTableIterClose, iterator_, true);
+  builder->Append(codegen_->MakeStmt(close_call));
+}
+
+///////////////////////////////////////////////
+///// UNION ALL Translators
+///////////////////////////////////////////////
+
+void UnionAllLeftTranslator::Produce(FunctionBuilder *builder) {
+  child_translator_->Produce(builder);
+  // The right side comes after the left side is done, rather than inside of its loop
+  parent_translator_->Consume(builder);
+}
+
+void UnionAllLeftTranslator::Consume(FunctionBuilder *builder) {
+  right_->consuming_left_ = true;
+  right_->Consume(builder);
+  right_->consuming_left_ = false;
+}
+
+ast::Expr *UnionAllRightTranslator::GetOutput(uint32_t attr_idx) {
+  auto output_expr = op_->GetOutputSchema()->GetColumn(attr_idx).GetExpr();
+  auto translator = TranslatorFactory::CreateExpressionTranslator(output_expr.Get(), codegen_);
+  return translator->DeriveExpr(this);
+}
+
+ast::Expr *UnionAllRightTranslator::GetChildOutput(uint32_t child_idx, uint32_t attr_idx,
+                                                   terrier::type::TypeId type) {
+  if (consuming_left_) {
+    return left_->child_translator_->GetOutput(attr_idx);
+  }
+  return child_translator_->GetOutput(attr_idx);
+}
+
+}  // namespace terrier::execution::compiler
@@ -4,9 +4,42 @@
 #include <vector>
 #include "execution/compiler/function_builder.h"
 #include "execution/compiler/translator_factory.h"
+#include "execution/sql/sorter.h"
 #include "planner/plannodes/order_by_plan_node.h"
 
 namespace terrier::execution::compiler {
+
+namespace {
+
+// How much of a sort key of the given type a normalized key word captures. A
+// word that two distinct keys can share can't order rows tied on it by the
+// keys after it, so it must be the last one.
+enum class KeyWordKind { None, Full, Last };
+
+KeyWordKind GetKeyWordKind(const type::TypeId type) {
+  switch (type) {
+    case type::TypeId::BOOLEAN:
+    case type::TypeId::TINYINT:
+    case type::TypeId::SMALLINT:
+    case type::TypeId::INTEGER:
+    case type::TypeId::DATE:
+      return KeyWordKind::Full;
+    // Values of these types use all 64 bits of the word, so the largest one
+    // shares its word with NULL
+    case type::TypeId::BIGINT:
+    case type::TypeId::DECIMAL:
+    case type::TypeId::TIMESTAMP:
+    // The word of a string only holds its prefix
+    case type::TypeId::VARCHAR:
+    case type::TypeId::VARBINARY:
+      return KeyWordKind::Last;
+    default:
+      return KeyWordKind::None;
+  }
+}
+
+}  // namespace
+
 SortBottomTranslator::SortBottomTranslator(const terrier::planner::OrderByPlanNode *op, CodeGen *codegen)
     : OperatorTranslator(codegen, brain::ExecutionOperatingUnitType::SORT_BUILD),
       op_(op),
@@ -15,7 +48,20 @@ SortBottomTranslator::SortBottomTranslator(const terrier::planner::OrderByPlanNo
       sorter_struct_(codegen_->NewIdentifier("SorterRow")),
       comp_fn_(codegen_->NewIdentifier("sorterCompFn")),
       comp_lhs_(codegen_->NewIdentifier("lhs")),
-      comp_rhs_(codegen_->NewIdentifier("rhs")) {}
+      comp_rhs_(codegen_->NewIdentifier("rhs")) {
+  // Every leading sort key gets a word, up to the first key whose word may tie
+  // distinct keys. Keys after it can't order rows tied on that word.
+  for (const auto &order : op_->GetSortKeys()) {
+    const KeyWordKind kind = GetKeyWordKind(order.first->GetReturnValueType());
+    if (kind == KeyWordKind::None || num_key_words_ == sql::Sorter::K_MAX_KEY_WORDS) {
+      break;
+    }
+    num_key_words_++;
+    if (kind == KeyWordKind::Last) {
+      break;
+    }
+  }
+}
 
 void SortBottomTranslator::Produce(FunctionBuilder *builder) {
   child_translator_->Produce(builder);
@@ -30,6 +76,7 @@ void SortBottomTranslator::Consume(FunctionBuilder *builder) {
   GenSorterInsert(builder);
   // Then fill in the values
   FillSorterRow(builder);
+  FillSorterKey(builder);
   // If this has a limit, call finish topK.
   if (op_->HasLimit()) {
     GenFinishTopK(builder);
@@ -70,6 +117,19 @@ void SortBottomTranslator::FillSorterRow(FunctionBuilder *builder) {
   }
 }
 
+void SortBottomTranslator::FillSorterKey(FunctionBuilder *builder) {
+  // sorter_row.sorter_key_i = @sorterKey(key_i, descending)
+  for (uint32_t word_idx = 0; word_idx < num_key_words_; word_idx++) {
+    const auto &order = op_->GetSortKeys()[word_idx];
+    std::unique_ptr<ExpressionTranslator> key_translator =
+        TranslatorFactory::CreateExpressionTranslator(order.first.Get(), codegen_);
+    ast::Expr *key = key_translator->DeriveExpr(this);
+    ast::Expr *descending = codegen_->BoolLiteral(order.second == optimizer::OrderByOrderingType::DESC);
+    ast::Expr *key_call = codegen_->BuiltinCall(ast::Builtin::SorterKey, {key, descending});
+    builder->Append(codegen_->Assign(GetKeyWord(sorter_row_, word_idx), key_call));
+  }
+}
+
 void SortBottomTranslator::GenSorterSort(FunctionBuilder *builder) {
   ast::Expr *sort_call = codegen_->OneArgStateCall(ast::Builtin::SorterSort, sorter_);
   builder->Append(codegen_->MakeStmt(sort_call));
@@ -84,6 +144,11 @@ void SortBottomTranslator::InitializeStateFields(
 
 void SortBottomTranslator::InitializeStructs(execution::util::RegionVector<execution::ast::Decl *> *decls) {
   util::RegionVector<execution::ast::FieldDecl *> fields{codegen_->Region()};
+  // The normalized key must come first
+  for (uint32_t word_idx = 0; word_idx < num_key_words_; word_idx++) {
+    ast::Identifier field_name = codegen_->Context()->GetIdentifier(SORTER_KEY_PREFIX + std::to_string(word_idx));
+    fields.emplace_back(codegen_->MakeField(field_name, codegen_->BuiltinType(ast::BuiltinType::Kind::Uint64)));
+  }
   GetChildOutputFields(&fields, SORTER_ATTR_PREFIX);
   decls->emplace_back(codegen_->MakeStruct(sorter_struct_, std::move(fields)));
 }
@@ -100,10 +165,14 @@ void SortBottomTranslator::InitializeHelperFunctions(execution::util::RegionVect
 }
 
 void SortBottomTranslator::InitializeSetup(execution::util::RegionVector<execution::ast::Stmt *> *setup_stmts) {
-  // @sorterInit(&state.sorter, @execCtxGetMem(execCtx), sorterCompare, @sizeOf(SorterStruct))
+  // @sorterInit(&state.sorter, @execCtxGetMem(execCtx), sorterCompare, @sizeOf(SorterStruct), num_key_words)
+  // The number of normalized key words is left out when there are none.
   ast::Expr *sizeof_call = codegen_->SizeOf(sorter_struct_);
   std::vector<ast::Expr *> init_args{codegen_->GetStateMemberPtr(sorter_), codegen_->ExecCtxGetMem(),
                                      codegen_->MakeExpr(comp_fn_), sizeof_call};
+  if (num_key_words_ > 0) {
+    init_args.emplace_back(codegen_->IntLiteral(num_key_words_));
+  }
   ast::Expr *init_call = codegen_->BuiltinCall(ast::Builtin::SorterInit, std::move(init_args));
 
   // Add it the setup statements
@@ -132,6 +201,11 @@ ast::Expr *SortBottomTranslator::GetAttribute(execution::ast::Identifier object,
   return codegen_->MemberExpr(object, member);
 }
 
+ast::Expr *SortBottomTranslator::GetKeyWord(execution::ast::Identifier object, uint32_t word_idx) {
+  ast::Identifier member = codegen_->Context()->GetIdentifier(SORTER_KEY_PREFIX + std::to_string(word_idx));
+  return codegen_->MemberExpr(object, member);
+}
+
 void SortBottomTranslator::GenComparisons(FunctionBuilder *builder) {
   // For each order by expr generate this (or its inverse depending on the ordering type):
   // if (lhs.col_i < rhs.col_i) {return -1}
@@ -24,6 +24,7 @@
 #include "execution/compiler/operator/nested_loop_translator.h"
 #include "execution/compiler/operator/projection_translator.h"
 #include "execution/compiler/operator/seq_scan_translator.h"
+#include "execution/compiler/operator/set_op_translator.h"
 #include "execution/compiler/operator/sort_translator.h"
 #include "execution/compiler/operator/static_aggregate_translator.h"
 #include "execution/compiler/operator/update_translator.h"
@@ -95,6 +96,8 @@ std::unique_ptr<OperatorTranslator> TranslatorFactory::CreateTopTranslator(const
     }
     case terrier::planner::PlanNodeType::ORDERBY:
       return std::make_unique<SortTopTranslator>(static_cast<const planner::OrderByPlanNode *>(op), codegen, bottom);
+    case terrier::planner::PlanNodeType::SETOP:
+      return std::make_unique<SetOpTopTranslator>(static_cast<const planner::SetOpPlanNode *>(op), codegen, bottom);
     default:
       UNREACHABLE("Not a pipeline boundary!");
   }
@@ -108,6 +111,13 @@ std::unique_ptr<OperatorTranslator> TranslatorFactory::CreateLeftTranslator(
     case terrier::planner::PlanNodeType::NESTLOOP:
       return std::make_unique<NestedLoopLeftTranslator>(static_cast<const planner::NestedLoopJoinPlanNode *>(op),
                                                         codegen);
+    case terrier::planner::PlanNodeType::SETOP: {
+      auto set_op = static_cast<const planner::SetOpPlanNode *>(op);
+      if (set_op->GetSetOp() == planner::SetOpType::UNION_ALL) {
+        return std::make_unique<UnionAllLeftTranslator>(set_op, codegen);
+      }
+      return std::make_unique<SetOpLeftTranslator>(set_op, codegen);
+    }
     default:
       UNREACHABLE("Not a pipeline boundary!");
   }
@@ -122,6 +132,13 @@ std::unique_ptr<OperatorTranslator> TranslatorFactory::CreateRightTranslator(
     case terrier::planner::PlanNodeType::NESTLOOP:
       return std::make_unique<NestedLoopRightTranslator>(static_cast<const planner::NestedLoopJoinPlanNode *>(op),
                                                          codegen, left);
+    case terrier::planner::PlanNodeType::SETOP: {
+      auto set_op = static_cast<const planner::SetOpPlanNode *>(op);
+      if (set_op->GetSetOp() == planner::SetOpType::UNION_ALL) {
+        return std::make_unique<UnionAllRightTranslator>(set_op, codegen, left);
+      }
+      return std::make_unique<SetOpRightTranslator>(set_op, codegen, left);
+    }
     default:
       UNREACHABLE("Not a pipeline boundary!");
   }
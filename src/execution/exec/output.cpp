@@ -1,12 +1,16 @@
 #include "execution/exec/output.h"
 
+#include <cstdio>
+#include <cstring>
+#include <string>
+
 #include "execution/sql/value.h"
 #include "loggers/execution_logger.h"
 #include "network/postgres/postgres_packet_writer.h"
 
 namespace terrier::execution::exec {
 
-OutputBuffer::~OutputBuffer() { memory_pool_->Deallocate(tuples_, BATCH_SIZE * tuple_size_); }
+OutputBuffer::~OutputBuffer() { memory_pool_->Deallocate(tuples_, batch_size_ * tuple_size_); }
 
 void OutputBuffer::Finalize() {
   if (num_tuples_ > 0) {
@@ -89,10 +93,90 @@ void OutputPrinter::operator()(byte *tuples, uint32_t num_tuples, uint32_t tuple
 
 void OutputWriter::operator()(byte *tuples, uint32_t num_tuples, uint32_t tuple_size) {
   // Write out the rows for this batch
+  out_->WriteDataRows(tuples, num_tuples, tuple_size, schema_->GetColumns(), field_formats_);
+  num_rows_ += num_tuples;
+}
+
+void CSVOutputWriter::operator()(byte *tuples, uint32_t num_tuples, uint32_t tuple_size) {
+  const auto &columns = schema_->GetColumns();
+  buffer_.clear();
   for (uint32_t row = 0; row < num_tuples; row++) {
-    const byte *const tuple = tuples + row * tuple_size;
-    out_->WriteDataRow(tuple, schema_->GetColumns(), field_formats_);
-    num_rows_++;
+    uint32_t curr_offset = 0;
+    for (uint16_t col = 0; col < columns.size(); col++) {
+      if (col != 0) buffer_.push_back(delimiter_);
+      const auto type = columns[col].GetType();
+      const auto *const val = reinterpret_cast<const sql::Val *>(tuples + row * tuple_size + curr_offset);
+      curr_offset += sql::ValUtil::GetSqlSize(type);
+      // NULL is an unquoted empty field
+      if (val->is_null_) continue;
+
+      switch (type) {
+        case type::TypeId::TINYINT:
+        case type::TypeId::SMALLINT:
+        case type::TypeId::INTEGER:
+        case type::TypeId::BIGINT: {
+          buffer_.append(std::to_string(reinterpret_cast<const sql::Integer *>(val)->val_));
+          break;
+        }
+        case type::TypeId::BOOLEAN: {
+          buffer_.push_back(reinterpret_cast<const sql::BoolVal *>(val)->val_ ? 't' : 'f');
+          break;
+        }
+        case type::TypeId::DECIMAL: {
+          // Enough digits for the value to be read back exactly
+          char buf[32];
+          const int len = std::snprintf(buf, sizeof(buf), "%.17g", reinterpret_cast<const sql::Real *>(val)->val_);
+          buffer_.append(buf, static_cast<size_t>(len));
+          break;
+        }
+        case type::TypeId::DATE: {
+          buffer_.append(reinterpret_cast<const sql::DateVal *>(val)->val_.ToString());
+          break;
+        }
+        case type::TypeId::TIMESTAMP: {
+          buffer_.append(reinterpret_cast<const sql::TimestampVal *>(val)->val_.ToString());
+          break;
+        }
+        case type::TypeId::VARCHAR:
+        case type::TypeId::VARBINARY: {
+          const auto *const string_val = reinterpret_cast<const sql::StringVal *>(val);
+          AppendField(string_val->Content(), string_val->len_);
+          break;
+        }
+        default:
+          UNREACHABLE("Cannot output unsupported type!!!");
+      }
+    }
+    buffer_.push_back('\n');
   }
+
+  if (file_ != nullptr) {
+    file_->write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+  } else {
+    out_->WriteCopyData(buffer_.data(), buffer_.size());
+  }
+  num_rows_ += num_tuples;
+}
+
+void CSVOutputWriter::AppendField(const char *const data, const size_t len) {
+  // Quote fields that would otherwise be read back differently: empty strings (which would become NULL) and fields
+  // containing special characters
+  bool needs_quotes = len == 0;
+  for (size_t i = 0; i < len && !needs_quotes; i++) {
+    const char c = data[i];
+    needs_quotes = c == delimiter_ || c == quote_ || c == escape_ || c == '\n' || c == '\r';
+  }
+  if (!needs_quotes) {
+    buffer_.append(data, len);
+    return;
+  }
+
+  buffer_.push_back(quote_);
+  for (size_t i = 0; i < len; i++) {
+    if (data[i] == quote_ || data[i] == escape_) buffer_.push_back(escape_);
+    buffer_.push_back(data[i]);
+  }
+  buffer_.push_back(quote_);
 }
+
 }  // namespace terrier::execution::exec
@@ -213,7 +213,7 @@ void Sema::CheckBuiltinSqlConversionCall(ast::CallExpr *call, ast::Builtin built
   }
 }
 
-void Sema::CheckBuiltinFilterCall(ast::CallExpr *call) {
+void Sema::CheckBuiltinFilterCall(ast::CallExpr *call, ast::Builtin builtin) {
   if (!CheckArgCount(call, 4)) {
     return;
   }
@@ -241,10 +241,46 @@ void Sema::CheckBuiltinFilterCall(ast::CallExpr *call) {
     return;
   }
 
+  // The fourth call argument is the filter value, a literal embedded in the bytecode. LIKE patterns must be strings;
+  // comparisons accept integers, or strings for string columns.
+  const bool is_like = builtin == ast::Builtin::FilterLike || builtin == ast::Builtin::FilterNotLike;
+  if (!args[3]->IsStringLiteral() && (is_like || !args[3]->IsIntegerLiteral())) {
+    ReportIncorrectCallArg(call, 3, ast::StringType::Get(GetContext()));
+    return;
+  }
+
   // Set return type
   call->SetType(GetBuiltinType(ast::BuiltinType::Int64));
 }
 
+void Sema::CheckBuiltinComputeCall(ast::CallExpr *call, ast::Builtin builtin) {
+  // Two columns, or a column and a constant value
+  const bool by_col = builtin == ast::Builtin::PCIComputeAdd || builtin == ast::Builtin::PCIComputeSub ||
+                      builtin == ast::Builtin::PCIComputeMul;
+  if (!CheckArgCount(call, by_col ? 6 : 5)) {
+    return;
+  }
+
+  const auto &args = call->Arguments();
+
+  // The first call argument must be a pointer to a ProjectedColumnsIterator
+  const auto pci_kind = ast::BuiltinType::ProjectedColumnsIterator;
+  if (!IsPointerToSpecificBuiltin(args[0]->GetType(), pci_kind)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(pci_kind)->PointerTo());
+    return;
+  }
+
+  // The other call arguments are the column indexes, their types and the constant value, all embedded in the bytecode
+  for (uint32_t arg_idx = 1; arg_idx < args.size(); arg_idx++) {
+    if (!args[arg_idx]->IsIntegerLiteral()) {
+      ReportIncorrectCallArg(call, arg_idx, GetBuiltinType(ast::BuiltinType::Int32));
+      return;
+    }
+  }
+
+  call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+}
+
 void Sema::CheckBuiltinDateFunctionCall(ast::CallExpr *call, ast::Builtin builtin) {
   if (!CheckArgCount(call, 1)) {
     return;
@@ -1199,7 +1235,8 @@ void Sema::CheckBuiltinPCICall(ast::CallExpr *call, ast::Builtin builtin) {
     case ast::Builtin::PCIGetInt:
     case ast::Builtin::PCIGetIntNull:
     case ast::Builtin::PCIGetBigInt:
-    case ast::Builtin::PCIGetBigIntNull: {
+    case ast::Builtin::PCIGetBigIntNull:
+    case ast::Builtin::PCIGetComputed: {
       call->SetType(GetBuiltinType(ast::BuiltinType::Integer));
       break;
     }
@@ -1401,7 +1438,8 @@ void Sema::CheckBuiltinPtrCastCall(ast::CallExpr *call) {
 }
 
 void Sema::CheckBuiltinSorterInit(ast::CallExpr *call) {
-  if (!CheckArgCount(call, 4)) {
+  // The number of normalized key words is optional
+  if (!CheckArgCountAtLeast(call, 4) || (call->NumArgs() > 4 && !CheckArgCount(call, 5))) {
     return;
   }
 
@@ -1430,17 +1468,48 @@ void Sema::CheckBuiltinSorterInit(ast::CallExpr *call) {
     return;
   }
 
-  // Third and last argument must be a 32-bit number representing the tuple size
+  // Third argument must be a 32-bit number representing the tuple size
   const auto uint_kind = ast::BuiltinType::Uint32;
   if (!args[3]->GetType()->IsSpecificBuiltin(uint_kind)) {
     ReportIncorrectCallArg(call, 3, GetBuiltinType(uint_kind));
     return;
   }
 
+  // Last, optional argument is the number of normalized key words at the start
+  // of each tuple
+  if (call->NumArgs() == 5 && !args[4]->IsIntegerLiteral()) {
+    ReportIncorrectCallArg(call, 4, GetBuiltinType(uint_kind));
+    return;
+  }
+
   // This call returns nothing
   call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
 }
 
+void Sema::CheckBuiltinSorterKey(ast::CallExpr *call) {
+  if (!CheckArgCount(call, 2)) {
+    return;
+  }
+
+  const auto &args = call->Arguments();
+
+  // First argument is the SQL value of the key
+  if (!args[0]->GetType()->IsSqlValueType() || args[0]->GetType()->IsSpecificBuiltin(ast::BuiltinType::Decimal)) {
+    GetErrorReporter()->Report(args[0]->Position(), ErrorMessages::kBadSorterKeyArg, args[0]->GetType());
+    return;
+  }
+
+  // Second argument is whether the key sorts in descending order
+  const auto bool_kind = ast::BuiltinType::Bool;
+  if (!args[1]->GetType()->IsSpecificBuiltin(bool_kind)) {
+    ReportIncorrectCallArg(call, 1, GetBuiltinType(bool_kind));
+    return;
+  }
+
+  // This call returns the normalized key word
+  call->SetType(GetBuiltinType(ast::BuiltinType::Uint64));
+}
+
 void Sema::CheckBuiltinSorterInsert(ast::CallExpr *call, ast::Builtin builtin) {
   if (!CheckArgCountAtLeast(call, 1)) {
     return;
@@ -1657,7 +1726,8 @@ void Sema::CheckBuiltinIndexIteratorInit(execution::ast::CallExpr *call, ast::Bu
     return;
   }
   switch (builtin) {
-    case ast::Builtin::IndexIteratorInit: {
+    case ast::Builtin::IndexIteratorInit:
+    case ast::Builtin::IndexIteratorInitCovering: {
       if (!CheckArgCount(call, 6)) {
         return;
       }
@@ -1752,11 +1822,15 @@ void Sema::CheckBuiltinIndexIteratorScan(execution::ast::CallExpr *call, ast::Bu
 
   switch (builtin) {
     case ast::Builtin::IndexIteratorScanKey:
+    case ast::Builtin::IndexIteratorAddKey:
+    case ast::Builtin::IndexIteratorScanKeys:
+    case ast::Builtin::IndexIteratorScanNextKey:
     case ast::Builtin::IndexIteratorScanDescending: {
       if (!CheckArgCount(call, 1)) return;
       break;
     }
-    case ast::Builtin::IndexIteratorScanAscending: {
+    case ast::Builtin::IndexIteratorScanAscending:
+    case ast::Builtin::IndexIteratorStreamAscending: {
       if (!CheckArgCount(call, 3)) return;
       break;
     }
@@ -2258,7 +2332,8 @@ void Sema::CheckBuiltinStringCall(ast::CallExpr *call, ast::Builtin builtin) {
       sql_type = ast::BuiltinType::StringVal;
       break;
     }
-    case ast::Builtin::Position: {
+    case ast::Builtin::Position:
+    case ast::Builtin::Like: {
       // check to make sure this function has three arguments
       if (!CheckArgCount(call, 3)) {
         return;
@@ -2291,8 +2366,8 @@ void Sema::CheckBuiltinStringCall(ast::CallExpr *call, ast::Builtin builtin) {
         return;
       }
 
-      // this function returns a string
-      sql_type = ast::BuiltinType::Integer;
+      // position() returns an integer, like() a boolean
+      sql_type = builtin == ast::Builtin::Position ? ast::BuiltinType::Integer : ast::BuiltinType::Boolean;
       break;
     }
     default:
@@ -2351,8 +2426,20 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
     case ast::Builtin::FilterGt:
     case ast::Builtin::FilterLt:
     case ast::Builtin::FilterNe:
-    case ast::Builtin::FilterLe: {
-      CheckBuiltinFilterCall(call);
+    case ast::Builtin::FilterLe:
+    case ast::Builtin::FilterLike:
+    case ast::Builtin::FilterNotLike: {
+      CheckBuiltinFilterCall(call, builtin);
+      break;
+    }
+    case ast::Builtin::PCIComputeAdd:
+    case ast::Builtin::PCIComputeSub:
+    case ast::Builtin::PCIComputeMul:
+    case ast::Builtin::PCIComputeAddVal:
+    case ast::Builtin::PCIComputeSubVal:
+    case ast::Builtin::PCIComputeMulVal:
+    case ast::Builtin::PCIComputeValSub: {
+      CheckBuiltinComputeCall(call, builtin);
       break;
     }
     case ast::Builtin::ExecutionContextGetMemoryPool:
@@ -2410,7 +2497,8 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
     case ast::Builtin::PCIGetTimestamp:
     case ast::Builtin::PCIGetTimestampNull:
     case ast::Builtin::PCIGetVarlen:
-    case ast::Builtin::PCIGetVarlenNull: {
+    case ast::Builtin::PCIGetVarlenNull:
+    case ast::Builtin::PCIGetComputed: {
       CheckBuiltinPCICall(call, builtin);
       break;
     }
@@ -2496,6 +2584,10 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
       CheckBuiltinSorterInit(call);
       break;
     }
+    case ast::Builtin::SorterKey: {
+      CheckBuiltinSorterKey(call);
+      break;
+    }
     case ast::Builtin::SorterInsert:
     case ast::Builtin::SorterInsertTopK:
     case ast::Builtin::SorterInsertTopKFinish: {
@@ -2533,12 +2625,17 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
       break;
     }
     case ast::Builtin::IndexIteratorInit:
-    case ast::Builtin::IndexIteratorInitBind: {
+    case ast::Builtin::IndexIteratorInitBind:
+    case ast::Builtin::IndexIteratorInitCovering: {
       CheckBuiltinIndexIteratorInit(call, builtin);
       break;
     }
     case ast::Builtin::IndexIteratorScanKey:
+    case ast::Builtin::IndexIteratorAddKey:
+    case ast::Builtin::IndexIteratorScanKeys:
+    case ast::Builtin::IndexIteratorScanNextKey:
     case ast::Builtin::IndexIteratorScanAscending:
+    case ast::Builtin::IndexIteratorStreamAscending:
     case ast::Builtin::IndexIteratorScanDescending:
     case ast::Builtin::IndexIteratorScanLimitDescending: {
       CheckBuiltinIndexIteratorScan(call, builtin);
@@ -2650,7 +2747,8 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
       CheckBuiltinStringCall(call, builtin);
       break;
     }
-    case ast::Builtin::Position: {
+    case ast::Builtin::Position:
+    case ast::Builtin::Like: {
       CheckBuiltinStringCall(call, builtin);
       break;
     }
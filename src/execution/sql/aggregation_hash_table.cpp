@@ -33,7 +33,11 @@ AggregationHashTable::AggregationHashTable(MemoryPool *memory, const std::size_t
       partition_tails_(nullptr),
       partition_estimates_(nullptr),
       partition_tables_(nullptr),
-      partition_shift_bits_(util::BitUtil::CountLeadingZeros(uint64_t(K_DEFAULT_NUM_PARTITIONS) - 1)) {
+      partition_shift_bits_(util::BitUtil::CountLeadingZeros(uint64_t(K_DEFAULT_NUM_PARTITIONS) - 1)),
+      num_flushed_entries_(0),
+      pre_agg_num_input_(0),
+      pre_agg_num_groups_(0),
+      pass_through_remaining_(0) {
   hash_table_.SetSize(initial_size);
   max_fill_ =
       static_cast<uint64_t>(std::llround(static_cast<float>(hash_table_.Capacity()) * hash_table_.LoadFactor()));
@@ -81,10 +85,12 @@ void AggregationHashTable::Grow() {
   max_fill_ =
       static_cast<uint64_t>(std::llround(static_cast<float>(hash_table_.Capacity()) * hash_table_.LoadFactor()));
 
-  // Insert elements again
-  for (byte *untyped_entry : entries_) {
-    auto *entry = reinterpret_cast<HashTableEntry *>(untyped_entry);
-    hash_table_.Insert<false>(entry, entry->hash_);
+  // Insert elements again. Flushed elements belong to the overflow partitions.
+  if (num_flushed_entries_ < entries_.size()) {
+    for (auto iter = entries_.begin() + static_cast<int64_t>(num_flushed_entries_); iter != entries_.end(); ++iter) {
+      auto *entry = reinterpret_cast<HashTableEntry *>(*iter);
+      hash_table_.Insert<false>(entry, entry->hash_);
+    }
   }
 
   // Update stats
@@ -123,20 +129,23 @@ void AggregationHashTable::FlushToOverflowPartitions() {
   }
 
   // Dump hash table into overflow partition
-  hash_table_.FlushEntries([this](HashTableEntry *entry) {
-    const uint64_t part_idx = (entry->hash_ >> partition_shift_bits_);
-    entry->next_ = partition_heads_[part_idx];
-    partition_heads_[part_idx] = entry;
-    if (UNLIKELY(partition_tails_[part_idx] == nullptr)) {
-      partition_tails_[part_idx] = entry;
-    }
-    partition_estimates_[part_idx]->Update(entry->hash_);
-  });
+  hash_table_.FlushEntries([this](HashTableEntry *entry) { AddToOverflowPartition(entry); });
+  num_flushed_entries_ = entries_.size();
 
   // Update stats
   stats_.num_flushes_++;
 }
 
+void AggregationHashTable::AddToOverflowPartition(HashTableEntry *const entry) {
+  const uint64_t part_idx = (entry->hash_ >> partition_shift_bits_);
+  entry->next_ = partition_heads_[part_idx];
+  partition_heads_[part_idx] = entry;
+  if (UNLIKELY(partition_tails_[part_idx] == nullptr)) {
+    partition_tails_[part_idx] = entry;
+  }
+  partition_estimates_[part_idx]->Update(entry->hash_);
+}
+
 void AggregationHashTable::AllocateOverflowPartitions() {
   TERRIER_ASSERT((partition_heads_ == nullptr) == (partition_tails_ == nullptr),
                  "Head and tail of overflow partitions list are not equally allocated");
@@ -154,32 +163,102 @@ void AggregationHashTable::AllocateOverflowPartitions() {
 
 void AggregationHashTable::ProcessBatch(ProjectedColumnsIterator *iters[], AggregationHashTable::HashFn hash_fn,
                                         KeyEqFn key_eq_fn, AggregationHashTable::InitAggFn init_agg_fn,
-                                        AggregationHashTable::AdvanceAggFn advance_agg_fn) {
+                                        AggregationHashTable::AdvanceAggFn advance_agg_fn, const bool partitioned) {
   TERRIER_ASSERT(iters != nullptr, "Null input iterators!");
   const uint32_t num_elems = iters[0]->NumSelected();
 
+  if (partitioned && pass_through_remaining_ > 0) {
+    if (iters[0]->IsFiltered()) {
+      PassThroughBatch<true>(iters, num_elems, hash_fn, init_agg_fn);
+    } else {
+      PassThroughBatch<false>(iters, num_elems, hash_fn, init_agg_fn);
+    }
+    pass_through_remaining_ -= std::min(pass_through_remaining_, static_cast<uint64_t>(num_elems));
+    return;
+  }
+
   // Temporary vector for the hash values and hash table entry pointers
   alignas(common::Constants::CACHELINE_SIZE) hash_t hashes[common::Constants::K_DEFAULT_VECTOR_SIZE];
   alignas(common::Constants::CACHELINE_SIZE) HashTableEntry *entries[common::Constants::K_DEFAULT_VECTOR_SIZE];
 
+  const uint64_t num_entries_before = entries_.size();
   if (iters[0]->IsFiltered()) {
-    ProcessBatchImpl<true>(iters, num_elems, hashes, entries, hash_fn, key_eq_fn, init_agg_fn, advance_agg_fn);
+    ProcessBatchImpl<true>(iters, num_elems, hashes, entries, hash_fn, key_eq_fn, init_agg_fn, advance_agg_fn,
+                           partitioned);
   } else {
-    ProcessBatchImpl<false>(iters, num_elems, hashes, entries, hash_fn, key_eq_fn, init_agg_fn, advance_agg_fn);
+    ProcessBatchImpl<false>(iters, num_elems, hashes, entries, hash_fn, key_eq_fn, init_agg_fn, advance_agg_fn,
+                            partitioned);
+  }
+
+  if (partitioned) {
+    MonitorPreAggregation(num_elems, entries_.size() - num_entries_before);
+  }
+}
+
+void AggregationHashTable::MonitorPreAggregation(const uint64_t num_input, const uint64_t num_new_groups) {
+  pre_agg_num_input_ += num_input;
+  pre_agg_num_groups_ += num_new_groups;
+
+  // Judge the reduction over about as much input as the table holds before
+  // flushing
+  if (pre_agg_num_input_ < flush_threshold_) {
+    return;
+  }
+
+  const float reduction = 1.0f - static_cast<float>(pre_agg_num_groups_) / static_cast<float>(pre_agg_num_input_);
+  if (reduction < K_MIN_PRE_AGGREGATION_REDUCTION) {
+    // Passed through entries are linked into the overflow partitions right
+    // away, so nothing appended before them may stay in the hash table.
+    FlushToOverflowPartitions();
+    pass_through_remaining_ = flush_threshold_ * K_PASS_THROUGH_INTERVALS;
   }
+
+  pre_agg_num_input_ = 0;
+  pre_agg_num_groups_ = 0;
+}
+
+template <bool PCIIsFiltered>
+void AggregationHashTable::PassThroughBatch(ProjectedColumnsIterator *iters[], const uint32_t num_elems,
+                                            const AggregationHashTable::HashFn hash_fn,
+                                            const AggregationHashTable::InitAggFn init_agg_fn) {
+  if (UNLIKELY(partition_heads_ == nullptr)) {
+    AllocateOverflowPartitions();
+  }
+
+  const auto pass_through = [&]() {
+    auto *entry = reinterpret_cast<HashTableEntry *>(entries_.Append());
+    entry->hash_ = hash_fn(iters);
+    init_agg_fn(entry->payload_, iters);
+    AddToOverflowPartition(entry);
+  };
+
+  if constexpr (PCIIsFiltered) {
+    for (; iters[0]->HasNextFiltered(); iters[0]->AdvanceFiltered()) {
+      pass_through();
+    }
+  } else {  // NOLINT
+    for (; iters[0]->HasNext(); iters[0]->Advance()) {
+      pass_through();
+    }
+  }
+  iters[0]->Reset();
+
+  num_flushed_entries_ = entries_.size();
+  stats_.num_pass_through_ += num_elems;
 }
 
 template <bool PCIIsFiltered>
 void AggregationHashTable::ProcessBatchImpl(ProjectedColumnsIterator *iters[], uint32_t num_elems, hash_t hashes[],
                                             HashTableEntry *entries[], AggregationHashTable::HashFn hash_fn,
                                             KeyEqFn key_eq_fn, AggregationHashTable::InitAggFn init_agg_fn,
-                                            AggregationHashTable::AdvanceAggFn advance_agg_fn) {
+                                            AggregationHashTable::AdvanceAggFn advance_agg_fn,
+                                            const bool partitioned) {
   // Lookup batch
   LookupBatch<PCIIsFiltered>(iters, num_elems, hashes, entries, hash_fn, key_eq_fn);
   iters[0]->Reset();
 
   // Create missing groups
-  CreateMissingGroups<PCIIsFiltered>(iters, num_elems, hashes, entries, key_eq_fn, init_agg_fn);
+  CreateMissingGroups<PCIIsFiltered>(iters, num_elems, hashes, entries, key_eq_fn, init_agg_fn, partitioned);
   iters[0]->Reset();
 
   // Update valid groups
@@ -290,7 +369,8 @@ template <bool PCIIsFiltered>
 void AggregationHashTable::CreateMissingGroups(ProjectedColumnsIterator *iters[], uint32_t num_elems,
                                                const hash_t hashes[], HashTableEntry *entries[],
                                                AggregationHashTable::KeyEqFn key_eq_fn,
-                                               AggregationHashTable::InitAggFn init_agg_fn) {
+                                               AggregationHashTable::InitAggFn init_agg_fn,
+                                               const bool partitioned) {
   // Vector storing all the missing group IDs
   alignas(common::Constants::CACHELINE_SIZE) uint32_t group_sel[common::Constants::K_DEFAULT_VECTOR_SIZE];
 
@@ -310,8 +390,9 @@ void AggregationHashTable::CreateMissingGroups(ProjectedColumnsIterator *iters[]
       continue;
     }
 
-    // Initialize
-    init_agg_fn(Insert(hash), iters);
+    // Initialize. A partitioned table flushes whenever it fills up, so that it
+    // stays cache-resident.
+    init_agg_fn(partitioned ? InsertPartitioned(hash) : Insert(hash), iters);
   }
 }
 
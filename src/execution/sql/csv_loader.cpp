@@ -0,0 +1,437 @@
+#include "execution/sql/csv_loader.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <tbb/parallel_for_each.h>
+#include <tbb/task_scheduler_init.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "catalog/catalog_accessor.h"
+#include "common/allocator.h"
+#include "common/exception.h"
+#include "execution/sql/runtime_types.h"
+#include "storage/index/index.h"
+#include "storage/sql_table.h"
+#include "storage/storage_util.h"
+#include "transaction/transaction_context.h"
+
+namespace terrier::execution::sql {
+
+namespace {
+
+// Integer parsing that works on a field in place, without copying it into a nul-terminated string first
+template <typename T>
+T ParseInteger(const char *data, size_t len) {
+  const char *pos = data, *const end = data + len;
+  while (pos != end && *pos == ' ') pos++;
+  const bool negative = pos != end && *pos == '-';
+  if (pos != end && (*pos == '-' || *pos == '+')) pos++;
+  if (pos == end) throw CONVERSION_EXCEPTION("invalid input syntax for integer");
+
+  // Accumulate the magnitude as unsigned so that the minimum value of T does not overflow
+  const uint64_t limit = negative ? static_cast<uint64_t>(std::numeric_limits<T>::max()) + 1
+                                  : static_cast<uint64_t>(std::numeric_limits<T>::max());
+  uint64_t magnitude = 0;
+  for (; pos != end && *pos >= '0' && *pos <= '9'; pos++) {
+    magnitude = magnitude * 10 + static_cast<uint64_t>(*pos - '0');
+    if (magnitude > limit) throw CONVERSION_EXCEPTION("integer value out of range");
+  }
+  while (pos != end && *pos == ' ') pos++;
+  if (pos != end) throw CONVERSION_EXCEPTION("invalid input syntax for integer");
+  return negative ? static_cast<T>(~magnitude + 1) : static_cast<T>(magnitude);
+}
+
+double ParseDouble(const char *data, size_t len) {
+  // strtod needs a nul-terminated string. Numbers fit in the stack buffer, anything longer goes through a std::string.
+  char buf[64];
+  std::string long_field;
+  const char *str = buf;
+  if (len < sizeof(buf)) {
+    std::memcpy(buf, data, len);
+    buf[len] = '\0';
+  } else {
+    long_field.assign(data, len);
+    str = long_field.c_str();
+  }
+  char *parsed_end;
+  const double val = std::strtod(str, &parsed_end);
+  while (*parsed_end == ' ') parsed_end++;
+  if (parsed_end == str || *parsed_end != '\0') throw CONVERSION_EXCEPTION("invalid input syntax for type double");
+  return val;
+}
+
+bool ParseBoolean(const char *data, size_t len) {
+  std::string val(data, len);
+  std::transform(val.begin(), val.end(), val.begin(), ::tolower);
+  if (val == "t" || val == "true" || val == "y" || val == "yes" || val == "on" || val == "1") return true;
+  if (val == "f" || val == "false" || val == "n" || val == "no" || val == "off" || val == "0") return false;
+  throw CONVERSION_EXCEPTION("invalid input syntax for type boolean");
+}
+
+}  // namespace
+
+CSVLoader::CSVLoader(const common::ManagedPointer<transaction::TransactionContext> txn,
+                     const common::ManagedPointer<catalog::CatalogAccessor> accessor, const catalog::db_oid_t db_oid,
+                     const catalog::table_oid_t table_oid, const char delimiter, const char quote, const char escape)
+    : txn_(txn),
+      accessor_(accessor),
+      db_oid_(db_oid),
+      table_oid_(table_oid),
+      delimiter_(delimiter),
+      quote_(quote),
+      escape_(escape),
+      table_(accessor->GetTable(table_oid)),
+      col_oids_(TableColumnOids(accessor, table_oid)),
+      row_initializer_(table_->InitializerForProjectedRow(col_oids_)),
+      row_stride_(storage::StorageUtil::PadUpToSize(sizeof(uint64_t), row_initializer_.ProjectedRowSize())) {
+  const auto &schema = accessor->GetSchema(table_oid);
+  const auto projection_map = table_->ProjectionMapForOids(col_oids_);
+  for (const auto &col : schema.GetColumns()) {
+    col_types_.emplace_back(col.Type());
+    col_nullable_.emplace_back(col.Nullable());
+    col_offsets_.emplace_back(projection_map.at(col.Oid()));
+  }
+}
+
+std::vector<catalog::col_oid_t> CSVLoader::TableColumnOids(
+    const common::ManagedPointer<catalog::CatalogAccessor> accessor, const catalog::table_oid_t table_oid) {
+  std::vector<catalog::col_oid_t> col_oids;
+  for (const auto &col : accessor->GetSchema(table_oid).GetColumns()) col_oids.emplace_back(col.Oid());
+  return col_oids;
+}
+
+uint64_t CSVLoader::Load(const std::string &file_path) {
+  const int fd = open(file_path.c_str(), O_RDONLY);
+  if (fd < 0) throw EXECUTION_EXCEPTION("could not open file for COPY");
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) < 0) {
+    close(fd);
+    throw EXECUTION_EXCEPTION("could not stat file for COPY");
+  }
+  const auto size = static_cast<uint64_t>(file_stat.st_size);
+  if (size == 0) {
+    close(fd);
+    return 0;
+  }
+
+  void *const mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapped == MAP_FAILED) throw EXECUTION_EXCEPTION("could not map file for COPY");
+  madvise(mapped, size, MADV_SEQUENTIAL);
+
+  uint64_t num_rows;
+  try {
+    num_rows = Load(reinterpret_cast<const char *>(mapped), size);
+  } catch (...) {
+    munmap(mapped, size);
+    throw;
+  }
+  munmap(mapped, size);
+  return num_rows;
+}
+
+uint64_t CSVLoader::Load(const char *const data, const uint64_t size) {
+  if (size != 0) {
+    const auto chunks = SplitIntoChunks(data, size);
+    tbb::task_scheduler_init sched;
+    // Exceptions thrown while parsing a chunk cancel the other tasks and are rethrown here
+    tbb::parallel_for_each(chunks.begin(), chunks.end(), [this](const Chunk &chunk) { LoadChunk(chunk); });
+  }
+
+  // Varlen values were copied out of the data while parsing, so the caller may free it once this returns
+  BuildIndexes();
+  return slots_.size();
+}
+
+std::vector<CSVLoader::Chunk> CSVLoader::SplitIntoChunks(const char *const data, const uint64_t size) const {
+  // Finding row boundaries in the middle of the file requires knowing whether a newline is inside a quoted field. With
+  // Postgres' default escaping (quotes are escaped by doubling them), that is simply whether an odd number of quotes
+  // precede it. A different escape character can escape a quote without another quote, so such files are parsed by a
+  // single task.
+  const uint64_t max_chunks = std::max<uint64_t>(1, size / MIN_CHUNK_SIZE);
+  const uint64_t num_chunks =
+      escape_ == quote_ ? std::min<uint64_t>(max_chunks, 4 * std::max(1u, std::thread::hardware_concurrency())) : 1;
+  if (num_chunks == 1) return {{data, data + size}};
+
+  // Count the quotes in each evenly sized piece of the file in parallel
+  std::vector<uint64_t> raw_starts(num_chunks);
+  for (uint64_t i = 0; i < num_chunks; i++) raw_starts[i] = i * size / num_chunks;
+  std::vector<uint64_t> quote_counts(num_chunks);
+  std::vector<uint64_t> piece_ids(num_chunks);
+  for (uint64_t i = 0; i < num_chunks; i++) piece_ids[i] = i;
+  tbb::task_scheduler_init sched;
+  tbb::parallel_for_each(piece_ids.begin(), piece_ids.end(), [&](const uint64_t i) {
+    const uint64_t piece_end = i + 1 < num_chunks ? raw_starts[i + 1] : size;
+    quote_counts[i] = static_cast<uint64_t>(std::count(data + raw_starts[i], data + piece_end, quote_));
+  });
+
+  // Move each piece's start forward to just after the first newline that is outside of quotes
+  std::vector<const char *> starts(num_chunks + 1);
+  starts[0] = data;
+  starts[num_chunks] = data + size;
+  bool in_quotes = false;
+  for (uint64_t i = 1; i < num_chunks; i++) {
+    in_quotes ^= (quote_counts[i - 1] & 1U) != 0;
+    bool scan_in_quotes = in_quotes;
+    const char *pos = data + raw_starts[i];
+    // A piece starting right after a newline already starts on a row boundary
+    if (!(data[raw_starts[i] - 1] == '\n' && !scan_in_quotes)) {
+      for (; pos != data + size; pos++) {
+        if (*pos == quote_) {
+          scan_in_quotes = !scan_in_quotes;
+        } else if (*pos == '\n' && !scan_in_quotes) {
+          pos++;
+          break;
+        }
+      }
+    }
+    starts[i] = std::max(pos, starts[i - 1]);
+  }
+
+  std::vector<Chunk> chunks;
+  for (uint64_t i = 0; i < num_chunks; i++) {
+    if (starts[i] != starts[i + 1]) chunks.push_back({starts[i], std::max(starts[i], starts[i + 1])});
+  }
+  return chunks;
+}
+
+void CSVLoader::LoadChunk(const Chunk &chunk) {
+  auto *const rows = common::AllocationUtil::AllocateAligned(row_stride_ * INSERT_BATCH_SIZE);
+  std::string scratch;
+  uint32_t num_rows = 0;
+  try {
+    for (const char *pos = chunk.begin_; pos != chunk.end_;) {
+      auto *const row = row_initializer_.InitializeRow(rows + num_rows * row_stride_);
+      num_rows++;
+      pos = ParseRow(pos, chunk.end_, row, &scratch);
+      if (num_rows == INSERT_BATCH_SIZE) {
+        InsertBatch(rows, num_rows);
+        num_rows = 0;
+      }
+    }
+    InsertBatch(rows, num_rows);
+  } catch (...) {
+    // Rows that did not make it into the table still own their varlen values
+    FreeVarlens(rows, num_rows);
+    delete[] rows;
+    throw;
+  }
+  delete[] rows;
+}
+
+const char *CSVLoader::ParseRow(const char *pos, const char *const end, storage::ProjectedRow *const row,
+                                std::string *const scratch) const {
+  const auto num_cols = static_cast<uint32_t>(col_types_.size());
+  for (uint32_t col_idx = 0; col_idx < num_cols; col_idx++) {
+    if (pos != end && *pos == quote_) {
+      // Quoted field. Only fields with escaped quotes need to be copied out of the file to unescape them.
+      const char *start = ++pos;
+      bool unescaped = false;
+      scratch->clear();
+      while (true) {
+        if (pos == end) throw CONVERSION_EXCEPTION("unterminated CSV quoted field");
+        if (*pos == escape_ && pos + 1 != end && (escape_ != quote_ || pos[1] == quote_)) {
+          scratch->append(start, pos);
+          scratch->push_back(pos[1]);
+          pos += 2;
+          start = pos;
+          unescaped = true;
+        } else if (*pos == quote_) {
+          break;
+        } else {
+          pos++;
+        }
+      }
+      if (unescaped) {
+        scratch->append(start, pos);
+        WriteColumn(row, col_idx, scratch->data(), scratch->size(), false);
+      } else {
+        WriteColumn(row, col_idx, start, static_cast<size_t>(pos - start), false);
+      }
+      // Skip the closing quote
+      pos++;
+    } else {
+      const char *const start = pos;
+      while (pos != end && *pos != delimiter_ && *pos != '\n' && *pos != '\r') pos++;
+      // An unquoted empty field is NULL
+      WriteColumn(row, col_idx, start, static_cast<size_t>(pos - start), pos == start);
+    }
+
+    if (col_idx + 1 < num_cols) {
+      if (pos == end || *pos != delimiter_) throw CONVERSION_EXCEPTION("missing data for column in COPY");
+      pos++;
+    }
+  }
+
+  // The row has to end here
+  if (pos != end && *pos == '\r') pos++;
+  if (pos != end) {
+    if (*pos != '\n') throw CONVERSION_EXCEPTION("extra data after last expected column in COPY");
+    pos++;
+  }
+  return pos;
+}
+
+void CSVLoader::WriteColumn(storage::ProjectedRow *const row, const uint32_t col_idx, const char *const data,
+                            const size_t len, const bool is_null) const {
+  const auto offset = col_offsets_[col_idx];
+  if (is_null) {
+    if (!col_nullable_[col_idx]) throw CONVERSION_EXCEPTION("null value in column violates not-null constraint");
+    row->SetNull(offset);
+    return;
+  }
+
+  byte *const dest = row->AccessForceNotNull(offset);
+  switch (col_types_[col_idx]) {
+    case type::TypeId::BOOLEAN: {
+      const auto val = static_cast<uint8_t>(ParseBoolean(data, len));
+      std::memcpy(dest, &val, sizeof(uint8_t));
+      break;
+    }
+    case type::TypeId::TINYINT: {
+      const auto val = ParseInteger<int8_t>(data, len);
+      std::memcpy(dest, &val, sizeof(int8_t));
+      break;
+    }
+    case type::TypeId::SMALLINT: {
+      const auto val = ParseInteger<int16_t>(data, len);
+      std::memcpy(dest, &val, sizeof(int16_t));
+      break;
+    }
+    case type::TypeId::INTEGER: {
+      const auto val = ParseInteger<int32_t>(data, len);
+      std::memcpy(dest, &val, sizeof(int32_t));
+      break;
+    }
+    case type::TypeId::BIGINT: {
+      const auto val = ParseInteger<int64_t>(data, len);
+      std::memcpy(dest, &val, sizeof(int64_t));
+      break;
+    }
+    case type::TypeId::DECIMAL: {
+      const auto val = ParseDouble(data, len);
+      std::memcpy(dest, &val, sizeof(double));
+      break;
+    }
+    case type::TypeId::DATE: {
+      const auto val = sql::Date::FromString(std::string(data, len));
+      std::memcpy(dest, &val, sizeof(uint32_t));
+      break;
+    }
+    case type::TypeId::TIMESTAMP: {
+      const auto val = sql::Timestamp::FromString(data, len);
+      std::memcpy(dest, &val, sizeof(uint64_t));
+      break;
+    }
+    case type::TypeId::VARCHAR:
+    case type::TypeId::VARBINARY: {
+      const auto size = static_cast<uint32_t>(len);
+      if (size <= storage::VarlenEntry::InlineThreshold()) {
+        *reinterpret_cast<storage::VarlenEntry *>(dest) =
+            storage::VarlenEntry::CreateInline(reinterpret_cast<const byte *>(data), size);
+      } else {
+        // The table takes ownership of the copy once the row is inserted
+        auto *const content = common::AllocationUtil::AllocateAligned(size);
+        std::memcpy(content, data, size);
+        *reinterpret_cast<storage::VarlenEntry *>(dest) = storage::VarlenEntry::Create(content, size, true);
+      }
+      break;
+    }
+    default:
+      throw EXECUTION_EXCEPTION("COPY does not support this column type");
+  }
+}
+
+void CSVLoader::InsertBatch(const byte *const rows, const uint32_t num_rows) {
+  const auto row_size = row_initializer_.ProjectedRowSize();
+  common::SpinLatch::ScopedSpinLatch guard(&insert_latch_);
+  for (uint32_t i = 0; i < num_rows; i++) {
+    auto *const redo = txn_->StageWrite(db_oid_, table_oid_, row_initializer_);
+    std::memcpy(reinterpret_cast<void *>(redo->Delta()), rows + i * row_stride_, row_size);
+    slots_.emplace_back(table_->Insert(txn_, redo));
+  }
+}
+
+void CSVLoader::FreeVarlens(byte *const rows, const uint32_t num_rows) const {
+  for (uint32_t i = 0; i < num_rows; i++) {
+    auto *const row = reinterpret_cast<storage::ProjectedRow *>(rows + i * row_stride_);
+    for (uint32_t col_idx = 0; col_idx < col_types_.size(); col_idx++) {
+      if (col_types_[col_idx] != type::TypeId::VARCHAR && col_types_[col_idx] != type::TypeId::VARBINARY) continue;
+      const auto *const varlen =
+          reinterpret_cast<const storage::VarlenEntry *>(row->AccessWithNullCheck(col_offsets_[col_idx]));
+      if (varlen != nullptr && varlen->NeedReclaim()) delete[] varlen->Content();
+    }
+  }
+}
+
+void CSVLoader::BuildIndexes() {
+  const auto index_oids = accessor_->GetIndexOids(table_oid_);
+  if (index_oids.empty() || slots_.empty()) return;
+
+  // Precompute, for every index, where each key column comes from in the table's row. Like recovery, this assumes
+  // index keys are plain columns rather than expressions.
+  struct KeyColumn {
+    uint16_t key_offset_;
+    uint16_t row_offset_;
+    uint16_t size_;
+  };
+  struct IndexInfo {
+    common::ManagedPointer<storage::index::Index> index_;
+    bool unique_;
+    std::vector<KeyColumn> key_cols_;
+  };
+  std::vector<IndexInfo> indexes;
+  uint32_t max_key_size = 0;
+  const auto projection_map = table_->ProjectionMapForOids(col_oids_);
+  for (const auto index_oid : index_oids) {
+    const auto index = accessor_->GetIndex(index_oid);
+    const auto &schema = accessor_->GetIndexSchema(index_oid);
+    const auto &indexed_oids = schema.GetIndexedColOids();
+    IndexInfo info{index, schema.Unique(), {}};
+    for (uint32_t i = 0; i < schema.GetColumns().size(); i++) {
+      const auto &key_col = schema.GetColumn(i);
+      info.key_cols_.push_back({index->GetKeyOidToOffsetMap().at(key_col.Oid()), projection_map.at(indexed_oids[i]),
+                                storage::AttrSizeBytes(key_col.AttrSize())});
+    }
+    max_key_size = std::max(max_key_size, index->GetProjectedRowInitializer().ProjectedRowSize());
+    indexes.emplace_back(std::move(info));
+  }
+
+  auto *const row_buffer = common::AllocationUtil::AllocateAligned(row_initializer_.ProjectedRowSize());
+  auto *const key_buffer = common::AllocationUtil::AllocateAligned(max_key_size);
+  auto *const row = row_initializer_.InitializeRow(row_buffer);
+  bool success = true;
+  // Read every loaded row once and insert its keys into all of the indexes
+  for (const auto slot : slots_) {
+    const bool UNUSED_ATTRIBUTE visible = table_->Select(txn_, slot, row);
+    TERRIER_ASSERT(visible, "The loading transaction should see its own inserts.");
+    for (const auto &info : indexes) {
+      auto *const key = info.index_->GetProjectedRowInitializer().InitializeRow(key_buffer);
+      for (const auto &key_col : info.key_cols_) {
+        const byte *const val = row->AccessWithNullCheck(key_col.row_offset_);
+        if (val == nullptr) {
+          key->SetNull(key_col.key_offset_);
+        } else {
+          std::memcpy(key->AccessForceNotNull(key_col.key_offset_), val, key_col.size_);
+        }
+      }
+      success = info.unique_ ? info.index_->InsertUnique(txn_, *key, slot) : info.index_->Insert(txn_, *key, slot);
+      if (!success) break;
+    }
+    if (!success) break;
+  }
+  delete[] key_buffer;
+  delete[] row_buffer;
+  if (!success) throw EXECUTION_EXCEPTION("duplicate key value violates unique constraint");
+}
+
+}  // namespace terrier::execution::sql
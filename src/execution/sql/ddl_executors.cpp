@@ -154,6 +154,7 @@ bool DDLExecutors::CreateIndex(const common::ManagedPointer<catalog::CatalogAcce
   auto *const index = index_builder.Build();
   bool result UNUSED_ATTRIBUTE = accessor->SetIndexPointer(index_oid, index);
   TERRIER_ASSERT(result, "CreateIndex succeeded, SetIndexPointer must also succeed.");
-  return true;
+  // Populate the index with the existing tuples. A unique index over duplicate keys fails, and the txn must abort.
+  return index_builder.BulkInsert(accessor->GetTxn(), accessor->GetTable(table), index);
 }
 }  // namespace terrier::execution::sql
@@ -3,6 +3,7 @@
 #include <algorithm>
 
 #include "execution/exec/execution_context.h"
+#include "execution/sql/like_pattern.h"
 #include "execution/util/bit_util.h"
 
 namespace terrier::execution::sql {
@@ -385,4 +386,23 @@ void StringFunctions::Position(exec::ExecutionContext *ctx, Integer *pos, const
     *pos = Integer(found + 1);
   }
 }
+
+void StringFunctions::Like(UNUSED_ATTRIBUTE exec::ExecutionContext *ctx, BoolVal *result, const StringVal &str,
+                           const StringVal &pattern) {
+  if (str.is_null_ || pattern.is_null_) {
+    *result = BoolVal::Null();
+    return;
+  }
+
+  *result = BoolVal(LikePattern(pattern.StringView()).Matches(str.Content(), str.len_));
+}
+
+void StringFunctions::Like(BoolVal *result, const StringVal &str, const LikePattern &pattern) {
+  if (str.is_null_) {
+    *result = BoolVal::Null();
+    return;
+  }
+
+  *result = BoolVal(pattern.Matches(str.Content(), str.len_));
+}
 }  // namespace terrier::execution::sql
@@ -1,5 +1,10 @@
 #include "execution/sql/index_iterator.h"
+
+#include <algorithm>
+#include <cstring>
+
 #include "execution/sql/value.h"
+#include "storage/storage_util.h"
 
 namespace terrier::execution::sql {
 
@@ -14,10 +19,24 @@ IndexIterator::IndexIterator(exec::ExecutionContext *exec_ctx, uint32_t num_attr
 void IndexIterator::Init() {
   // Initialize projected rows for the index and the table
   TERRIER_ASSERT(!col_oids_.empty(), "There must be at least one col oid!");
-  // Table's PR
-  auto table_pri = table_->InitializerForProjectedRow(col_oids_);
-  table_buffer_ = exec_ctx_->GetMemoryPool()->AllocateAligned(table_pri.ProjectedRowSize(), alignof(uint64_t), false);
-  table_pr_ = table_pri.InitializeRow(table_buffer_);
+  InitBuffers(table_->InitializerForProjectedRow(col_oids_));
+}
+
+void IndexIterator::InitCovering() {
+  // Rows are index keys, so they have the layout of the index's PRs
+  TERRIER_ASSERT(index_->SupportsKeyRetrieval(), "The index cannot hand out its keys!");
+  covering_ = true;
+  InitBuffers(index_->GetProjectedRowInitializer());
+}
+
+void IndexIterator::InitBuffers(const storage::ProjectedRowInitializer &row_initializer) {
+  // Rows, one per tuple of a batch, back to back in a single buffer
+  const uint32_t row_size = storage::StorageUtil::PadUpToSize(alignof(uint64_t), row_initializer.ProjectedRowSize());
+  table_buffer_size_ = row_size * BATCH_SIZE;
+  table_buffer_ = exec_ctx_->GetMemoryPool()->AllocateAligned(table_buffer_size_, alignof(uint64_t), false);
+  for (uint32_t i = 0; i < BATCH_SIZE; i++) {
+    table_prs_[i] = row_initializer.InitializeRow(reinterpret_cast<byte *>(table_buffer_) + i * row_size);
+  }
 
   // Index's PR
   auto &index_pri = index_->GetProjectedRowInitializer();
@@ -28,51 +47,133 @@ void IndexIterator::Init() {
   hi_index_pr_ = index_pri.InitializeRow(hi_index_buffer_);
 }
 
+void IndexIterator::ResetScan() {
+  tuples_.clear();
+  next_tuple_ = 0;
+  cursor_.reset();
+  num_rows_ = 0;
+  curr_row_ = 0;
+}
+
 void IndexIterator::ScanKey() {
   // Scan the index
-  tuples_.clear();
-  curr_index_ = 0;
+  ResetScan();
   index_->ScanKey(*exec_ctx_->GetTxn(), *index_pr_, &tuples_);
 }
 
+void IndexIterator::AddKey() {
+  TERRIER_ASSERT(!covering_, "Covering scans cannot batch lookups!");
+  TERRIER_ASSERT(num_keys_ < KEY_BATCH_SIZE, "Too many keys in a batched lookup!");
+  if (keys_buffer_ == nullptr) {
+    // Allocated on first use, since most iterators never batch lookups
+    const auto &index_pri = index_->GetProjectedRowInitializer();
+    const uint32_t key_size = storage::StorageUtil::PadUpToSize(alignof(uint64_t), index_pri.ProjectedRowSize());
+    keys_buffer_size_ = key_size * KEY_BATCH_SIZE;
+    keys_buffer_ = exec_ctx_->GetMemoryPool()->AllocateAligned(keys_buffer_size_, alignof(uint64_t), false);
+    keys_.resize(KEY_BATCH_SIZE);
+    for (uint32_t i = 0; i < KEY_BATCH_SIZE; i++) {
+      keys_[i] = index_pri.InitializeRow(reinterpret_cast<byte *>(keys_buffer_) + i * key_size);
+    }
+  }
+  std::memcpy(static_cast<void *>(keys_[num_keys_++]), index_pr_, index_pr_->Size());
+}
+
+void IndexIterator::ScanKeys() {
+  // Scan the index
+  ResetScan();
+  key_values_.clear();
+  key_ranges_.clear();
+  next_key_ = 0;
+  index_->ScanKeys(*exec_ctx_->GetTxn(), keys_.data(), num_keys_, &key_values_, &key_ranges_);
+  num_keys_ = 0;
+}
+
+void IndexIterator::ScanNextKey() {
+  TERRIER_ASSERT(next_key_ < key_ranges_.size(), "Scanned past the keys of the batched lookup!");
+  ResetScan();
+  const auto &range = key_ranges_[next_key_++];
+  tuples_.assign(key_values_.begin() + range.first, key_values_.begin() + range.second);
+}
+
 void IndexIterator::ScanAscending(storage::index::ScanType scan_type, uint32_t limit) {
+  TERRIER_ASSERT(!covering_, "Covering scans must stream ascending scans!");
   // Scan the index
-  tuples_.clear();
-  curr_index_ = 0;
+  ResetScan();
   index_->ScanAscending(*exec_ctx_->GetTxn(), scan_type, num_attrs_, index_pr_, hi_index_pr_, limit, &tuples_);
 }
 
+void IndexIterator::StreamAscending(storage::index::ScanType scan_type, uint32_t limit) {
+  // Only position the scan. Entries are read from the index as they are needed.
+  ResetScan();
+  cursor_ = index_->BeginScanAscending(*exec_ctx_->GetTxn(), scan_type, num_attrs_, index_pr_, hi_index_pr_, limit);
+}
+
 void IndexIterator::ScanDescending() {
+  TERRIER_ASSERT(!covering_, "Covering scans cannot scan descending!");
   // Scan the index
-  tuples_.clear();
-  curr_index_ = 0;
+  ResetScan();
   index_->ScanDescending(*exec_ctx_->GetTxn(), *index_pr_, *hi_index_pr_, &tuples_);
 }
 
 void IndexIterator::ScanLimitDescending(uint32_t limit) {
+  TERRIER_ASSERT(!covering_, "Covering scans cannot scan descending!");
   // Scan the index
-  tuples_.clear();
-  curr_index_ = 0;
+  ResetScan();
   index_->ScanLimitDescending(*exec_ctx_->GetTxn(), *index_pr_, *hi_index_pr_, &tuples_, limit);
 }
 
+bool IndexIterator::FetchBatch() {
+  if (covering_) return FetchKeyBatch();
+  num_rows_ = 0;
+  curr_row_ = 0;
+  // Tuples can stop being visible between the index scan and the table select, so a batch can come back empty
+  while (num_rows_ == 0) {
+    if (next_tuple_ == tuples_.size()) {
+      if (cursor_ == nullptr) return false;
+      tuples_.clear();
+      next_tuple_ = 0;
+      if (cursor_->Next(&tuples_, BATCH_SIZE) == 0) return false;
+    }
+    const auto num_slots = std::min(BATCH_SIZE, static_cast<uint32_t>(tuples_.size()) - next_tuple_);
+    num_rows_ = table_->SelectBatch(exec_ctx_->GetTxn(), tuples_.data() + next_tuple_, num_slots, table_prs_.data(),
+                                    row_slots_.data());
+    next_tuple_ += num_slots;
+  }
+  return true;
+}
+
+bool IndexIterator::FetchKeyBatch() {
+  // The index only hands out visible entries, so there is nothing left to check in the table
+  curr_row_ = 0;
+  if (cursor_ != nullptr) {
+    tuples_.clear();
+    num_rows_ = cursor_->NextWithKeys(&tuples_, table_prs_.data(), BATCH_SIZE);
+    std::copy(tuples_.begin(), tuples_.end(), row_slots_.begin());
+  } else {
+    // An exact lookup, where every entry has the key that was looked up
+    num_rows_ = std::min(BATCH_SIZE, static_cast<uint32_t>(tuples_.size()) - next_tuple_);
+    for (uint32_t i = 0; i < num_rows_; i++) {
+      std::memcpy(static_cast<void *>(table_prs_[i]), index_pr_, index_pr_->Size());
+      row_slots_[i] = tuples_[next_tuple_ + i];
+    }
+    next_tuple_ += num_rows_;
+  }
+  return num_rows_ != 0;
+}
+
 bool IndexIterator::Advance() {
-  if (curr_index_ < tuples_.size()) {
-    ++curr_index_;
+  if (curr_row_ < num_rows_ || FetchBatch()) {
+    ++curr_row_;
     return true;
   }
   return false;
 }
 
-storage::ProjectedRow *IndexIterator::TablePR() {
-  table_->Select(exec_ctx_->GetTxn(), tuples_[curr_index_ - 1], table_pr_);
-  return table_pr_;
-}
-
 IndexIterator::~IndexIterator() {
   // Free allocated buffers
-  exec_ctx_->GetMemoryPool()->Deallocate(table_buffer_, table_pr_->Size());
+  exec_ctx_->GetMemoryPool()->Deallocate(table_buffer_, table_buffer_size_);
   exec_ctx_->GetMemoryPool()->Deallocate(index_buffer_, index_pr_->Size());
   exec_ctx_->GetMemoryPool()->Deallocate(hi_index_buffer_, hi_index_pr_->Size());
+  if (keys_buffer_ != nullptr) exec_ctx_->GetMemoryPool()->Deallocate(keys_buffer_, keys_buffer_size_);
 }
 }  // namespace terrier::execution::sql
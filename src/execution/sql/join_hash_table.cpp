@@ -3,12 +3,16 @@
 #include <tbb/tbb.h>
 
 #include <algorithm>
+#include <cstring>
 #include <limits>
+#include <thread>  // NOLINT
 #include <utility>
 #include <vector>
 
+#include "common/math_util.h"
 #include "execution/sql/memory_pool.h"
 #include "execution/sql/thread_state_container.h"
+#include "execution/util/bit_util.h"
 #include "execution/util/cpu_info.h"
 #include "execution/util/memory.h"
 #include "execution/util/timer.h"
@@ -67,12 +71,122 @@ void JoinHashTable::BuildGenericHashTable() noexcept {
   // Dispatch to appropriate build code based on GHT size
   uint64_t l3_cache_size = CpuInfo::Instance()->GetCacheSize(CpuInfo::L3_CACHE);
   if (generic_hash_table_.GetTotalMemoryUsage() > l3_cache_size) {
-    BuildGenericHashTableInternal<true>();
+    if (const uint32_t num_partitions = NumRadixPartitions(); num_partitions > 1) {
+      // Split the buffered tuples evenly among the workers
+      const uint64_t num_workers = std::max(1u, std::thread::hardware_concurrency());
+      std::vector<EntryRange> ranges;
+      for (uint64_t worker = 0; worker < num_workers; worker++) {
+        ranges.push_back({this, NumElements() * worker / num_workers, NumElements() * (worker + 1) / num_workers});
+      }
+      BuildGenericHashTablePartitioned(ranges, num_partitions);
+    } else {
+      BuildGenericHashTableInternal<true>();
+    }
   } else {
     BuildGenericHashTableInternal<false>();
   }
 }
 
+// ---------------------------------------------------------
+// Radix-partitioned generic hash tables
+// ---------------------------------------------------------
+
+uint32_t JoinHashTable::NumRadixPartitions() const {
+  const uint64_t l2_size = CpuInfo::Instance()->GetCacheSize(CpuInfo::L2_CACHE);
+  const uint64_t num_partitions =
+      common::MathUtil::PowerOf2Ceil(std::max(uint64_t(1), generic_hash_table_.GetTotalMemoryUsage() / l2_size));
+  return static_cast<uint32_t>(
+      std::min({num_partitions, uint64_t(K_MAX_RADIX_PARTITIONS), generic_hash_table_.Capacity()}));
+}
+
+void JoinHashTable::ScatterToPartitions(const EntryRange &range, const uint32_t num_partitions,
+                                        const uint64_t radix_shift, uint64_t partition_offsets[],
+                                        HashTableEntry *partitioned[]) {
+  // Software write-combining: entries are staged in a cache line per
+  // partition, and only full lines are written out. This turns scattered
+  // single-pointer writes into whole-line copies, and keeps the number of
+  // lines being written to low enough for the cache and TLB.
+  constexpr uint32_t k_line_size = common::Constants::CACHELINE_SIZE / sizeof(HashTableEntry *);
+  struct alignas(common::Constants::CACHELINE_SIZE) Line {
+    HashTableEntry *entries_[k_line_size];
+  };
+  std::vector<Line> lines(num_partitions);
+  std::vector<uint32_t> line_sizes(num_partitions, 0);
+
+  const uint64_t mask = generic_hash_table_.Capacity() - 1;
+  for (uint64_t idx = range.begin_; idx < range.end_; idx++) {
+    HashTableEntry *const entry = range.table_->EntryAt(idx);
+    const uint64_t part_idx = (entry->hash_ & mask) >> radix_shift;
+    Line &line = lines[part_idx];
+    line.entries_[line_sizes[part_idx]++] = entry;
+    if (line_sizes[part_idx] == k_line_size) {
+      std::memcpy(partitioned + partition_offsets[part_idx], line.entries_, sizeof(Line));
+      partition_offsets[part_idx] += k_line_size;
+      line_sizes[part_idx] = 0;
+    }
+  }
+
+  // Write out what's left
+  for (uint32_t part_idx = 0; part_idx < num_partitions; part_idx++) {
+    std::memcpy(partitioned + partition_offsets[part_idx], lines[part_idx].entries_,
+                line_sizes[part_idx] * sizeof(HashTableEntry *));
+    partition_offsets[part_idx] += line_sizes[part_idx];
+  }
+}
+
+void JoinHashTable::BuildGenericHashTablePartitioned(const std::vector<EntryRange> &ranges,
+                                                     const uint32_t num_partitions) {
+  TERRIER_ASSERT(common::MathUtil::IsPowerOf2(num_partitions) && num_partitions <= generic_hash_table_.Capacity(),
+                 "Partitions must evenly split the directory");
+
+  // Bucket positions are the low bits of the hash value. The partition is the
+  // top bits of the position, so each partition covers a contiguous slice of
+  // the directory, and the slices of different partitions never overlap.
+  const uint64_t slice_size = generic_hash_table_.Capacity() / num_partitions;
+  const uint64_t radix_shift = 64 - util::BitUtil::CountLeadingZeros(slice_size) - 1;
+  const uint64_t mask = generic_hash_table_.Capacity() - 1;
+
+  // First, count the entries of each range in each partition
+  std::vector<std::vector<uint64_t>> offsets(ranges.size(), std::vector<uint64_t>(num_partitions, 0));
+  tbb::parallel_for(std::size_t(0), ranges.size(), [&](const std::size_t range_idx) {
+    const EntryRange &range = ranges[range_idx];
+    for (uint64_t idx = range.begin_; idx < range.end_; idx++) {
+      offsets[range_idx][(range.table_->EntryAt(idx)->hash_ & mask) >> radix_shift]++;
+    }
+  });
+
+  // Next, lay the partitions out one after another, each range writing to its
+  // own part of every partition
+  std::vector<uint64_t> partition_begin(num_partitions + 1);
+  uint64_t num_entries = 0;
+  for (uint32_t part_idx = 0; part_idx < num_partitions; part_idx++) {
+    partition_begin[part_idx] = num_entries;
+    for (auto &range_offsets : offsets) {
+      const uint64_t count = range_offsets[part_idx];
+      range_offsets[part_idx] = num_entries;
+      num_entries += count;
+    }
+  }
+  partition_begin[num_partitions] = num_entries;
+  if (num_entries == 0) {
+    return;
+  }
+
+  // Scatter the entries into their partitions
+  auto *partitioned = util::MallocHugeArray<HashTableEntry *>(num_entries);
+  tbb::parallel_for(std::size_t(0), ranges.size(), [&](const std::size_t range_idx) {
+    ScatterToPartitions(ranges[range_idx], num_partitions, radix_shift, offsets[range_idx].data(), partitioned);
+  });
+
+  // Finally, insert each partition into its slice of the directory
+  tbb::parallel_for(uint32_t(0), num_partitions, [&](const uint32_t part_idx) {
+    generic_hash_table_.InsertRun(partitioned + partition_begin[part_idx],
+                                  partition_begin[part_idx + 1] - partition_begin[part_idx]);
+  });
+
+  util::FreeHugeArray(partitioned, num_entries);
+}
+
 // ---------------------------------------------------------
 // Concise hash tables
 // ---------------------------------------------------------
@@ -686,6 +800,20 @@ void JoinHashTable::MergeIncomplete(JoinHashTable *source) {
   }
 }
 
+void JoinHashTable::MergePartitioned(const std::vector<JoinHashTable *> &sources, const uint32_t num_partitions) {
+  // Each source table is partitioned by one worker
+  std::vector<EntryRange> ranges;
+  for (auto *source : sources) {
+    ranges.push_back({source, 0, source->NumElements()});
+  }
+  BuildGenericHashTablePartitioned(ranges, num_partitions);
+
+  // Take ownership of the source tables' memory
+  for (auto *source : sources) {
+    owned_.emplace_back(std::move(source->entries_));
+  }
+}
+
 void JoinHashTable::MergeParallel(const ThreadStateContainer *thread_state_container, const uint32_t jht_offset) {
   // Collect thread-local hash tables
   std::vector<JoinHashTable *> tl_join_tables;
@@ -707,19 +835,24 @@ void JoinHashTable::MergeParallel(const ThreadStateContainer *thread_state_conta
   // owned entries vector
   owned_.reserve(tl_join_tables.size());
 
-  // Is the global hash table out of cache? If so, we'll prefetch during build.
+  // Is the global hash table out of cache? If so, we'll partition or prefetch
+  // during build.
   const uint64_t l3_size = CpuInfo::Instance()->GetCacheSize(CpuInfo::L3_CACHE);
   const bool out_of_cache = (generic_hash_table_.GetTotalMemoryUsage() > l3_size);
 
   // Merge all in parallel
   tbb::task_scheduler_init sched;
-  tbb::parallel_for_each(tl_join_tables.begin(), tl_join_tables.end(), [this, out_of_cache](JoinHashTable *source) {
-    if (out_of_cache) {
-      MergeIncomplete<true, true>(source);
-    } else {
-      MergeIncomplete<false, true>(source);
-    }
-  });
+  if (const uint32_t num_partitions = NumRadixPartitions(); out_of_cache && num_partitions > 1) {
+    MergePartitioned(tl_join_tables, num_partitions);
+  } else {
+    tbb::parallel_for_each(tl_join_tables.begin(), tl_join_tables.end(), [this, out_of_cache](JoinHashTable *source) {
+      if (out_of_cache) {
+        MergeIncomplete<true, true>(source);
+      } else {
+        MergeIncomplete<false, true>(source);
+      }
+    });
+  }
 }
 
 }  // namespace terrier::execution::sql
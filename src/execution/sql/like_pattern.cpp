@@ -0,0 +1,88 @@
+#include "execution/sql/like_pattern.h"
+
+#include <string>
+#include <utility>
+
+namespace terrier::execution::sql {
+
+LikePattern::LikePattern(std::string_view pattern, const char escape)
+    : pattern_(pattern), escape_(escape), kind_(Kind::GENERIC) {
+  // Split the pattern into an optional leading '%', an unescaped literal, and an optional trailing '%'. Any other
+  // wildcard makes the pattern generic.
+  std::size_t pos = 0;
+  bool leading_any = false;
+  while (pos < pattern.size() && pattern[pos] == '%') {
+    leading_any = true;
+    pos++;
+  }
+
+  std::string literal;
+  bool trailing_any = false;
+  for (; pos < pattern.size(); pos++) {
+    const char c = pattern[pos];
+    if (c == escape) {
+      // A trailing escape character matches nothing and is left to the generic matcher
+      if (++pos == pattern.size()) return;
+      literal.push_back(pattern[pos]);
+    } else if (c == '_') {
+      return;
+    } else if (c == '%') {
+      // Only a run of '%' ending the pattern is allowed
+      for (; pos < pattern.size(); pos++) {
+        if (pattern[pos] != '%') return;
+      }
+      trailing_any = true;
+    } else {
+      literal.push_back(c);
+    }
+  }
+
+  literal_ = std::move(literal);
+  if (leading_any && trailing_any) {
+    kind_ = Kind::CONTAINS;
+  } else if (leading_any) {
+    // '%' alone is an empty suffix, which matches any string
+    kind_ = Kind::SUFFIX;
+  } else if (trailing_any) {
+    kind_ = Kind::PREFIX;
+  } else {
+    kind_ = Kind::EXACT;
+  }
+}
+
+bool LikePattern::GenericMatch(const char *const str, const std::size_t str_len, const char *const pattern,
+                               const std::size_t pattern_len, const char escape) {
+  std::size_t s = 0, p = 0;
+  // Position after the most recent '%' in the pattern, and the string position it is currently matched up to. On a
+  // mismatch, the '%' absorbs one more character and matching resumes from there.
+  std::size_t star_p = std::string::npos, star_s = 0;
+  while (s < str_len) {
+    if (p < pattern_len && pattern[p] == '%') {
+      star_p = ++p;
+      star_s = s;
+      continue;
+    }
+    if (p < pattern_len) {
+      if (pattern[p] == '_') {
+        p++;
+        s++;
+        continue;
+      }
+      const bool escaped = pattern[p] == escape && p + 1 < pattern_len;
+      const char expected = escaped ? pattern[p + 1] : pattern[p];
+      if (expected == str[s]) {
+        p += escaped ? 2 : 1;
+        s++;
+        continue;
+      }
+    }
+    if (star_p == std::string::npos) return false;
+    p = star_p;
+    s = ++star_s;
+  }
+  // The string is consumed, so the rest of the pattern must only be '%'
+  while (p < pattern_len && pattern[p] == '%') p++;
+  return p == pattern_len;
+}
+
+}  // namespace terrier::execution::sql
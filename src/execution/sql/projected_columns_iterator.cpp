@@ -1,4 +1,10 @@
 #include "execution/sql/projected_columns_iterator.h"
+
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+
 #include "execution/util/vector_util.h"
 #include "storage/projected_columns.h"
 #include "type/type_id.h"
@@ -90,6 +96,65 @@ uint32_t ProjectedColumnsIterator::FilterColByVal(uint32_t col_idx, type::TypeId
   }
 }
 
+template <typename P>
+uint32_t ProjectedColumnsIterator::FilterVarlenColImpl(const uint32_t col_idx, const P &predicate) {
+  const auto *input =
+      reinterpret_cast<const storage::VarlenEntry *>(projected_column_->ColumnStart(static_cast<uint16_t>(col_idx)));
+  const auto *null_bitmap = projected_column_->ColumnNullBitmap(static_cast<uint16_t>(col_idx));
+
+  // Like the integer filters, write every candidate and only advance the output position for the ones that pass. The
+  // output position never passes the input position, so the selection vector can be filtered in place.
+  uint32_t out_pos = 0;
+  if (IsFiltered()) {
+    for (uint32_t in_pos = 0; in_pos < num_selected_; in_pos++) {
+      const uint32_t idx = selection_vector_[in_pos];
+      selection_vector_[out_pos] = idx;
+      out_pos += static_cast<uint32_t>(null_bitmap->Test(idx) && predicate(input[idx]));
+    }
+  } else {
+    for (uint32_t idx = 0; idx < num_selected_; idx++) {
+      selection_vector_[out_pos] = idx;
+      out_pos += static_cast<uint32_t>(null_bitmap->Test(idx) && predicate(input[idx]));
+    }
+  }
+  selection_vector_write_idx_ = out_pos;
+
+  ResetFiltered();
+  return NumSelected();
+}
+
+namespace {
+// Equality of two varlens that compares sizes and the inline prefixes before the (possibly out-of-line) contents
+bool VarlenEquals(const storage::VarlenEntry &left, const storage::VarlenEntry &right) {
+  if (left.Size() != right.Size()) return false;
+  const auto prefix_len = std::min(left.Size(), storage::VarlenEntry::PrefixSize());
+  if (std::memcmp(left.Prefix(), right.Prefix(), prefix_len) != 0) return false;
+  return std::memcmp(left.Content(), right.Content(), left.Size()) == 0;
+}
+}  // namespace
+
+template <template <typename> typename Op>
+uint32_t ProjectedColumnsIterator::FilterColByString(const uint32_t col_idx, const storage::VarlenEntry &val) {
+  if constexpr (std::is_same_v<Op<void>, std::equal_to<void>>) {
+    return FilterVarlenColImpl(col_idx, [&](const storage::VarlenEntry &entry) { return VarlenEquals(entry, val); });
+  } else if constexpr (std::is_same_v<Op<void>, std::not_equal_to<void>>) {  // NOLINT
+    return FilterVarlenColImpl(col_idx, [&](const storage::VarlenEntry &entry) { return !VarlenEquals(entry, val); });
+  } else {  // NOLINT
+    const auto val_view = val.StringView();
+    return FilterVarlenColImpl(col_idx, [&](const storage::VarlenEntry &entry) {
+      return Op<std::string_view>()(entry.StringView(), val_view);
+    });
+  }
+}
+
+uint32_t ProjectedColumnsIterator::FilterColByLike(const uint32_t col_idx, const LikePattern &pattern,
+                                                   const bool negated) {
+  if (negated) {
+    return FilterVarlenColImpl(col_idx, [&](const storage::VarlenEntry &entry) { return !pattern.Matches(entry); });
+  }
+  return FilterVarlenColImpl(col_idx, [&](const storage::VarlenEntry &entry) { return pattern.Matches(entry); });
+}
+
 template <template <typename> typename Op>
 uint32_t ProjectedColumnsIterator::FilterColByCol(const uint32_t col_idx_1, type::TypeId type_1,
                                                   const uint32_t col_idx_2, type::TypeId type_2) {
@@ -111,12 +176,136 @@ uint32_t ProjectedColumnsIterator::FilterColByCol(const uint32_t col_idx_1, type
   }
 }
 
+ProjectedColumnsIterator::ComputedColumn *ProjectedColumnsIterator::GetComputedColumnForWrite(const uint32_t out_idx) {
+  TERRIER_ASSERT(out_idx >= COMPUTED_COL_START, "Only computed columns can be written");
+  const uint32_t computed_idx = out_idx - COMPUTED_COL_START;
+  if (computed_idx >= computed_columns_.size()) computed_columns_.resize(computed_idx + 1);
+  if (computed_columns_[computed_idx] == nullptr) computed_columns_[computed_idx] = std::make_unique<ComputedColumn>();
+  return computed_columns_[computed_idx].get();
+}
+
+template <typename F>
+void ProjectedColumnsIterator::DispatchIntegerColumn(const uint32_t col_idx, const type::TypeId type,
+                                                     const F &fn) const {
+  if (col_idx >= COMPUTED_COL_START) {
+    TERRIER_ASSERT(type == type::TypeId::BIGINT, "Computed columns are BIGINT");
+    const int64_t *values = computed_columns_[col_idx - COMPUTED_COL_START]->values_;
+    fn(values);
+    return;
+  }
+  const auto *input = projected_column_->ColumnStart(static_cast<uint16_t>(col_idx));
+  switch (type) {
+    case type::TypeId::TINYINT: {
+      fn(reinterpret_cast<const int8_t *>(input));
+      break;
+    }
+    case type::TypeId::SMALLINT: {
+      fn(reinterpret_cast<const int16_t *>(input));
+      break;
+    }
+    case type::TypeId::INTEGER: {
+      fn(reinterpret_cast<const int32_t *>(input));
+      break;
+    }
+    case type::TypeId::BIGINT: {
+      fn(reinterpret_cast<const int64_t *>(input));
+      break;
+    }
+    default: {
+      throw std::runtime_error("Arithmetic not supported on type");
+    }
+  }
+}
+
+bool ProjectedColumnsIterator::IsNullAt(const uint32_t col_idx, const uint32_t idx) const {
+  if (col_idx >= COMPUTED_COL_START) return computed_columns_[col_idx - COMPUTED_COL_START]->nulls_[idx];
+  return !projected_column_->ColumnNullBitmap(static_cast<uint16_t>(col_idx))->Test(idx);
+}
+
+int64_t ProjectedColumnsIterator::IntegerAt(const uint32_t col_idx, const type::TypeId type, const uint32_t idx) const {
+  int64_t result = 0;
+  DispatchIntegerColumn(col_idx, type, [&](const auto *values) { result = static_cast<int64_t>(values[idx]); });
+  return result;
+}
+
+template <template <typename> typename Op>
+void ProjectedColumnsIterator::ComputeColByCol(const uint32_t out_idx, const uint32_t col_idx_1,
+                                               const type::TypeId type_1, const uint32_t col_idx_2,
+                                               const type::TypeId type_2, bool *const overflow) {
+  TERRIER_ASSERT(out_idx != col_idx_1 && out_idx != col_idx_2, "A computed column cannot be its own operand");
+  ComputedColumn *out = GetComputedColumnForWrite(out_idx);
+
+  // Use the existing selection vector if this PCI has been filtered
+  const uint32_t *sel_vec = (IsFiltered() ? selection_vector_ : nullptr);
+
+  // Compute! The values of NULL operands are garbage, but so are the results, which are NULL too.
+  bool any_overflow = false;
+  DispatchIntegerColumn(col_idx_1, type_1, [&](const auto *input_1) {
+    DispatchIntegerColumn(col_idx_2, type_2, [&](const auto *input_2) {
+      using T1 = std::remove_const_t<std::remove_pointer_t<decltype(input_1)>>;
+      using T2 = std::remove_const_t<std::remove_pointer_t<decltype(input_2)>>;
+      any_overflow = util::VectorUtil::ArithmeticVectorByVector<T1, T2, Op>(input_1, input_2, num_selected_,
+                                                                            out->values_, sel_vec);
+    });
+  });
+
+  *overflow = false;
+  for (uint32_t i = 0; i < num_selected_; i++) {
+    const uint32_t idx = (sel_vec == nullptr ? i : sel_vec[i]);
+    out->nulls_[idx] = IsNullAt(col_idx_1, idx) || IsNullAt(col_idx_2, idx);
+    // Garbage may overflow too, so an overflow only counts if the result isn't NULL
+    if (any_overflow && !out->nulls_[idx] && !*overflow) {
+      int64_t result;
+      *overflow = util::VectorUtil::CheckedArithmetic<Op>(IntegerAt(col_idx_1, type_1, idx),
+                                                          IntegerAt(col_idx_2, type_2, idx), &result);
+    }
+  }
+}
+
+template <template <typename> typename Op>
+void ProjectedColumnsIterator::ComputeColByVal(const uint32_t out_idx, const uint32_t col_idx, const type::TypeId type,
+                                               const int64_t val, const bool val_on_left, bool *const overflow) {
+  TERRIER_ASSERT(out_idx != col_idx, "A computed column cannot be its own operand");
+  ComputedColumn *out = GetComputedColumnForWrite(out_idx);
+
+  // Use the existing selection vector if this PCI has been filtered
+  const uint32_t *sel_vec = (IsFiltered() ? selection_vector_ : nullptr);
+
+  // Compute!
+  bool any_overflow = false;
+  DispatchIntegerColumn(col_idx, type, [&](const auto *input) {
+    using T = std::remove_const_t<std::remove_pointer_t<decltype(input)>>;
+    any_overflow =
+        util::VectorUtil::ArithmeticVectorByVal<T, Op>(input, num_selected_, val, val_on_left, out->values_, sel_vec);
+  });
+
+  *overflow = false;
+  for (uint32_t i = 0; i < num_selected_; i++) {
+    const uint32_t idx = (sel_vec == nullptr ? i : sel_vec[i]);
+    out->nulls_[idx] = IsNullAt(col_idx, idx);
+    if (any_overflow && !out->nulls_[idx] && !*overflow) {
+      const int64_t elem = IntegerAt(col_idx, type, idx);
+      int64_t result;
+      *overflow = val_on_left ? util::VectorUtil::CheckedArithmetic<Op>(val, elem, &result)
+                              : util::VectorUtil::CheckedArithmetic<Op>(elem, val, &result);
+    }
+  }
+}
+
 template uint32_t ProjectedColumnsIterator::FilterColByVal<std::equal_to>(uint32_t, type::TypeId, FilterVal);
 template uint32_t ProjectedColumnsIterator::FilterColByVal<std::greater>(uint32_t, type::TypeId, FilterVal);
 template uint32_t ProjectedColumnsIterator::FilterColByVal<std::greater_equal>(uint32_t, type::TypeId, FilterVal);
 template uint32_t ProjectedColumnsIterator::FilterColByVal<std::less>(uint32_t, type::TypeId, FilterVal);
 template uint32_t ProjectedColumnsIterator::FilterColByVal<std::less_equal>(uint32_t, type::TypeId, FilterVal);
 template uint32_t ProjectedColumnsIterator::FilterColByVal<std::not_equal_to>(uint32_t, type::TypeId, FilterVal);
+template uint32_t ProjectedColumnsIterator::FilterColByString<std::equal_to>(uint32_t, const storage::VarlenEntry &);
+template uint32_t ProjectedColumnsIterator::FilterColByString<std::greater>(uint32_t, const storage::VarlenEntry &);
+template uint32_t ProjectedColumnsIterator::FilterColByString<std::greater_equal>(uint32_t,
+                                                                                  const storage::VarlenEntry &);
+template uint32_t ProjectedColumnsIterator::FilterColByString<std::less>(uint32_t, const storage::VarlenEntry &);
+template uint32_t ProjectedColumnsIterator::FilterColByString<std::less_equal>(uint32_t, const storage::VarlenEntry &);
+template uint32_t ProjectedColumnsIterator::FilterColByString<std::not_equal_to>(uint32_t,
+                                                                                 const storage::VarlenEntry &);
 template uint32_t ProjectedColumnsIterator::FilterColByCol<std::equal_to>(uint32_t, type::TypeId, uint32_t,
                                                                           type::TypeId);
 template uint32_t ProjectedColumnsIterator::FilterColByCol<std::greater>(uint32_t, type::TypeId, uint32_t,
@@ -129,4 +318,17 @@ template uint32_t ProjectedColumnsIterator::FilterColByCol<std::less_equal>(uint
 template uint32_t ProjectedColumnsIterator::FilterColByCol<std::not_equal_to>(uint32_t, type::TypeId, uint32_t,
                                                                               type::TypeId);
 
+template void ProjectedColumnsIterator::ComputeColByCol<std::plus>(uint32_t, uint32_t, type::TypeId, uint32_t,
+                                                                   type::TypeId, bool *);
+template void ProjectedColumnsIterator::ComputeColByCol<std::minus>(uint32_t, uint32_t, type::TypeId, uint32_t,
+                                                                    type::TypeId, bool *);
+template void ProjectedColumnsIterator::ComputeColByCol<std::multiplies>(uint32_t, uint32_t, type::TypeId, uint32_t,
+                                                                         type::TypeId, bool *);
+template void ProjectedColumnsIterator::ComputeColByVal<std::plus>(uint32_t, uint32_t, type::TypeId, int64_t, bool,
+                                                                   bool *);
+template void ProjectedColumnsIterator::ComputeColByVal<std::minus>(uint32_t, uint32_t, type::TypeId, int64_t, bool,
+                                                                    bool *);
+template void ProjectedColumnsIterator::ComputeColByVal<std::multiplies>(uint32_t, uint32_t, type::TypeId, int64_t,
+                                                                         bool, bool *);
+
 }  // namespace terrier::execution::sql
@@ -0,0 +1,110 @@
+#include "execution/sql/sort_run.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#include "common/exception.h"
+
+namespace terrier::execution::sql {
+
+namespace {
+
+[[noreturn]] void ThrowRunIoError(const char *what) {
+  throw EXECUTION_EXCEPTION((std::string(what) + " sort run: " + std::strerror(errno)).c_str());
+}
+
+}  // namespace
+
+SortRun::SortRun(const uint32_t tuple_size, const common::ManagedPointer<MemoryTracker> tracker)
+    : tuple_size_(tuple_size), num_tuples_(0), file_(std::tmpfile()), tracker_(tracker) {
+  if (file_ == nullptr) {
+    ThrowRunIoError("Failed to create");
+  }
+  write_buffer_.reserve(std::max(uint64_t(tuple_size_), K_IO_SIZE));
+  if (tracker_ != nullptr) {
+    tracker_->Increment(write_buffer_.capacity());
+  }
+}
+
+SortRun::~SortRun() {
+  ReleaseWriteBuffer();
+  std::fclose(file_);
+}
+
+void SortRun::ReleaseWriteBuffer() {
+  if (tracker_ != nullptr) {
+    tracker_->Decrement(write_buffer_.capacity());
+  }
+  write_buffer_.clear();
+  write_buffer_.shrink_to_fit();
+}
+
+void SortRun::FlushWriteBuffer() {
+  const int fd = fileno(file_);
+  for (uint64_t written = 0; written < write_buffer_.size();) {
+    const ssize_t ret = ::write(fd, write_buffer_.data() + written, write_buffer_.size() - written);
+    if (ret < 0 && errno != EINTR) {
+      ThrowRunIoError("Failed to write");
+    }
+    written += std::max(ssize_t(0), ret);
+  }
+  write_buffer_.clear();
+}
+
+void SortRun::FinishWriting() {
+  FlushWriteBuffer();
+  ReleaseWriteBuffer();
+}
+
+void SortRun::Read(const uint64_t begin, const uint64_t num_tuples, byte *const tuples) const {
+  TERRIER_ASSERT(begin + num_tuples <= num_tuples_, "Read past the end of the run");
+  TERRIER_ASSERT(write_buffer_.empty(), "Run must be finished before being read");
+  const int fd = fileno(file_);
+  const uint64_t offset = begin * tuple_size_, size = num_tuples * tuple_size_;
+  for (uint64_t read = 0; read < size;) {
+    const ssize_t ret = ::pread(fd, tuples + read, size - read, offset + read);
+    if (ret == 0) {
+      errno = EIO;
+    }
+    if (ret == 0 || (ret < 0 && errno != EINTR)) {
+      ThrowRunIoError("Failed to read");
+    }
+    read += std::max(ssize_t(0), ret);
+  }
+}
+
+SortRunReader::SortRunReader(const SortRun *run, const uint64_t begin, const uint64_t end,
+                             const common::ManagedPointer<MemoryTracker> tracker, const uint64_t buffer_size)
+    : run_(run),
+      pos_(begin),
+      end_(end),
+      buffer_(std::max(uint64_t(1), buffer_size / run->TupleSize()) * run->TupleSize()),
+      buffer_begin_(begin),
+      buffer_tuples_(0),
+      tracker_(tracker) {
+  TERRIER_ASSERT(begin <= end && end <= run->NumTuples(), "Invalid range of run");
+  if (pos_ < end_) {
+    Fill();
+  }
+  if (tracker_ != nullptr) {
+    tracker_->Increment(buffer_.size());
+  }
+}
+
+SortRunReader::~SortRunReader() {
+  if (tracker_ != nullptr) {
+    tracker_->Decrement(buffer_.size());
+  }
+}
+
+void SortRunReader::Fill() {
+  buffer_begin_ = pos_;
+  buffer_tuples_ = std::min(end_ - pos_, buffer_.size() / run_->TupleSize());
+  run_->Read(buffer_begin_, buffer_tuples_, buffer_.data());
+}
+
+}  // namespace terrier::execution::sql
@@ -3,10 +3,15 @@
 #include <tbb/tbb.h>
 
 #include <algorithm>
+#include <iterator>
+#include <limits>
+#include <memory>
 #include <queue>
+#include <thread>  // NOLINT
 #include <utility>
 #include <vector>
 
+#include "execution/sql/memory_tracker.h"
 #include "execution/sql/thread_state_container.h"
 #include "execution/util/stage_timer.h"
 #include "ips4o/ips4o.hpp"
@@ -15,22 +20,41 @@
 
 namespace terrier::execution::sql {
 
-Sorter::Sorter(MemoryPool *memory, ComparisonFunction cmp_fn, uint32_t tuple_size)
-    : tuple_storage_(tuple_size, MemoryPoolAllocator<byte>(memory)),
+Sorter::Sorter(MemoryPool *memory, ComparisonFunction cmp_fn, uint32_t tuple_size, uint32_t num_key_words)
+    : memory_(memory),
+      tuple_size_(tuple_size),
+      tuple_storage_(tuple_size, MemoryPoolAllocator<byte>(memory)),
       owned_tuples_(memory),
       cmp_fn_(cmp_fn),
+      num_key_words_(num_key_words),
       tuples_(memory),
-      sorted_(false) {}
+      sorted_(false),
+      max_buffered_tuples_(std::numeric_limits<uint64_t>::max()),
+      num_spilled_tuples_(0),
+      runs_partitioned_(false) {
+  TERRIER_ASSERT(num_key_words <= K_MAX_KEY_WORDS, "Too many normalized key words");
+  TERRIER_ASSERT(num_key_words * sizeof(uint64_t) <= tuple_size, "Normalized key doesn't fit in tuple");
+
+  // Only this sorter's own tuples count towards its budget, so that memory used
+  // elsewhere in the query doesn't make it spill tiny runs
+  const auto tracker = memory->GetTracker();
+  if (tracker != nullptr && tracker->GetMemoryLimit() != std::numeric_limits<size_t>::max()) {
+    const uint64_t budget = std::max(uint64_t(tracker->GetMemoryLimit()), K_MIN_RUN_SIZE);
+    max_buffered_tuples_ = std::max(uint64_t(1), budget / (tuple_size + sizeof(const byte *)));
+  }
+}
 
 Sorter::~Sorter() = default;
 
 byte *Sorter::AllocInputTuple() {
-  byte *ret = tuple_storage_.Append();
-  tuples_.push_back(ret);
-  return ret;
+  if (tuples_.size() >= max_buffered_tuples_) {
+    SpillRun();
+  }
+  return AllocInputTupleInMemory();
 }
 
-byte *Sorter::AllocInputTupleTopK(UNUSED_ATTRIBUTE uint64_t top_k) { return AllocInputTuple(); }
+// The top-K heap is bounded, so it's never spilled
+byte *Sorter::AllocInputTupleTopK(UNUSED_ATTRIBUTE uint64_t top_k) { return AllocInputTupleInMemory(); }
 
 void Sorter::AllocInputTupleTopKFinish(const uint64_t top_k) {
   // If the number of buffered tuples is less than top_k, we're done
@@ -56,7 +80,7 @@ void Sorter::AllocInputTupleTopKFinish(const uint64_t top_k) {
 
   const byte *heap_top = tuples_.front();
 
-  if (cmp_fn_(last_insert, heap_top) <= 0) {
+  if (Compare(last_insert, heap_top) <= 0) {
     // The last inserted tuples belongs in the top-k. Swap it with the current
     // maximum and sift it down.
     tuples_.front() = last_insert;
@@ -65,7 +89,7 @@ void Sorter::AllocInputTupleTopKFinish(const uint64_t top_k) {
 }
 
 void Sorter::BuildHeap() {
-  const auto compare = [this](const byte *left, const byte *right) { return cmp_fn_(left, right) < 0; };
+  const auto compare = [this](const byte *left, const byte *right) { return Compare(left, right) < 0; };
   std::make_heap(tuples_.begin(), tuples_.end(), compare);
 }
 
@@ -82,11 +106,11 @@ void Sorter::HeapSiftDown() {
       break;
     }
 
-    if (child + 1 < size && cmp_fn_(tuples_[child], tuples_[child + 1]) < 0) {
+    if (child + 1 < size && Compare(tuples_[child], tuples_[child + 1]) < 0) {
       child++;
     }
 
-    if (cmp_fn_(top, tuples_[child]) >= 0) {
+    if (Compare(top, tuples_[child]) >= 0) {
       break;
     }
 
@@ -103,6 +127,17 @@ void Sorter::Sort() {
     return;
   }
 
+  // A spilled sorter spills what's left too. Iterators merge the runs.
+  if (!runs_.empty()) {
+    if (!tuples_.empty()) {
+      SpillRun();
+    }
+    ReduceRuns(&runs_);
+    run_levels_.clear();
+    sorted_ = true;
+    return;
+  }
+
   // Exit if there are no input tuples
   if (tuples_.empty()) {
     return;
@@ -113,8 +148,7 @@ void Sorter::Sort() {
   timer.Start();
 
   // Sort the sucker
-  const auto compare = [this](const byte *left, const byte *right) { return cmp_fn_(left, right) < 0; };
-  ips4o::sort(tuples_.begin(), tuples_.end(), compare);
+  SortInMemory();
 
   timer.Stop();
 
@@ -127,6 +161,337 @@ void Sorter::Sort() {
 
 namespace {
 
+// The first word of a tuple's normalized key, next to the tuple. Radix passes
+// over these never have to follow the tuple pointer.
+struct KeyedTuple {
+  uint64_t key_;
+  const byte *tuple_;
+};
+
+// Ranges at most this big are sorted by comparison instead of radix passes
+constexpr int64_t K_RADIX_SORT_CUTOFF = 64;
+
+// MSD radix sort the range on the byte of the key starting at bit 'shift' and
+// all less significant bytes. Each pass permutes the range in place, American
+// flag style.
+void RadixSort(KeyedTuple *const begin, KeyedTuple *const end, const uint32_t shift) {
+  if (end - begin <= K_RADIX_SORT_CUTOFF) {
+    std::sort(begin, end, [](const KeyedTuple &l, const KeyedTuple &r) { return l.key_ < r.key_; });
+    return;
+  }
+
+  // Histogram
+  uint64_t counts[256] = {0};
+  for (const KeyedTuple *iter = begin; iter != end; iter++) {
+    counts[(iter->key_ >> shift) & 0xFF]++;
+  }
+
+  // Bucket boundaries
+  KeyedTuple *bucket_begin[256], *bucket_next[256];
+  KeyedTuple *pos = begin;
+  for (uint32_t bucket = 0; bucket < 256; bucket++) {
+    bucket_begin[bucket] = bucket_next[bucket] = pos;
+    pos += counts[bucket];
+  }
+
+  // Swap each element into its bucket, cycle by cycle
+  for (uint32_t bucket = 0; bucket < 256; bucket++) {
+    KeyedTuple *const bucket_end = bucket_begin[bucket] + counts[bucket];
+    while (bucket_next[bucket] != bucket_end) {
+      KeyedTuple elem = *bucket_next[bucket];
+      for (uint32_t dest = (elem.key_ >> shift) & 0xFF; dest != bucket; dest = (elem.key_ >> shift) & 0xFF) {
+        std::swap(elem, *bucket_next[dest]++);
+      }
+      *bucket_next[bucket]++ = elem;
+    }
+  }
+
+  // Recurse on the next byte
+  if (shift == 0) {
+    return;
+  }
+  for (uint32_t bucket = 0; bucket < 256; bucket++) {
+    if (counts[bucket] > 1) {
+      RadixSort(bucket_begin[bucket], bucket_begin[bucket] + counts[bucket], shift - 8);
+    }
+  }
+}
+
+}  // namespace
+
+void Sorter::SortInMemory() {
+  if (num_key_words_ > 0) {
+    SortByNormalizedKey();
+  } else {
+    const auto compare = [this](const byte *left, const byte *right) { return cmp_fn_(left, right) < 0; };
+    ips4o::sort(tuples_.begin(), tuples_.end(), compare);
+  }
+}
+
+void Sorter::SortByNormalizedKey() {
+  const uint64_t num_tuples = tuples_.size();
+  std::vector<KeyedTuple> keyed(num_tuples);
+  for (uint64_t i = 0; i < num_tuples; i++) {
+    keyed[i] = {*reinterpret_cast<const uint64_t *>(tuples_[i]), tuples_[i]};
+  }
+
+  // Order by the first key word
+  RadixSort(keyed.data(), keyed.data() + num_tuples, 56);
+
+  // Order the runs of tuples tied on the first word by the rest of the key and
+  // the comparison function
+  const auto compare = [this](const KeyedTuple &l, const KeyedTuple &r) { return Compare(l.tuple_, r.tuple_) < 0; };
+  for (uint64_t run_begin = 0; run_begin < num_tuples;) {
+    uint64_t run_end = run_begin + 1;
+    while (run_end < num_tuples && keyed[run_end].key_ == keyed[run_begin].key_) {
+      run_end++;
+    }
+    if (run_end - run_begin > 1) {
+      ips4o::sort(keyed.begin() + run_begin, keyed.begin() + run_end, compare);
+    }
+    run_begin = run_end;
+  }
+
+  for (uint64_t i = 0; i < num_tuples; i++) {
+    tuples_[i] = keyed[i].tuple_;
+  }
+}
+
+// ---------------------------------------------------------
+// External sorting
+// ---------------------------------------------------------
+
+void Sorter::SpillRun() {
+  SortInMemory();
+
+  auto run = std::make_unique<SortRun>(tuple_size_, memory_->GetTracker());
+  for (const byte *tuple : tuples_) {
+    run->Append(tuple);
+  }
+  run->FinishWriting();
+
+  EXECUTION_LOG_DEBUG("Spilled sort run of {} tuples", tuples_.size());
+  num_spilled_tuples_ += tuples_.size();
+  runs_.emplace_back(std::move(run));
+  run_levels_.push_back(0);
+
+  // Give the memory of the spilled tuples back
+  tuples_.clear();
+  tuples_.shrink_to_fit();
+  tuple_storage_ = util::ChunkedVector<MemoryPoolAllocator<byte>>(tuple_size_, MemoryPoolAllocator<byte>(memory_));
+
+  // Merge the last K_MAX_MERGE_FAN_IN runs once they've all been merged the
+  // same number of times, carrying like the digits of a counter. This bounds
+  // the open runs to a few per level while merging every tuple only once per
+  // level.
+  while (runs_.size() >= K_MAX_MERGE_FAN_IN && run_levels_[runs_.size() - K_MAX_MERGE_FAN_IN] == run_levels_.back()) {
+    const uint32_t level = run_levels_.back() + 1;
+    std::vector<std::unique_ptr<SortRun>> inputs(std::make_move_iterator(runs_.end() - K_MAX_MERGE_FAN_IN),
+                                                 std::make_move_iterator(runs_.end()));
+    runs_.resize(runs_.size() - K_MAX_MERGE_FAN_IN);
+    run_levels_.resize(run_levels_.size() - K_MAX_MERGE_FAN_IN);
+    runs_.emplace_back(MergeRuns(std::move(inputs)));
+    run_levels_.push_back(level);
+  }
+}
+
+class Sorter::RunMerger {
+ public:
+  // Merge the given readers. If the readers are partitioned, each one holds a
+  // range of the output that follows the previous reader's, and they're read
+  // one after another.
+  RunMerger(const Sorter *sorter, std::vector<std::unique_ptr<SortRunReader>> readers, const bool partitioned)
+      : sorter_(sorter), readers_(std::move(readers)), partitioned_(partitioned) {
+    llvm::erase_if(readers_, [](const auto &reader) { return !reader->HasNext(); });
+    if (partitioned_) {
+      // The current reader is at the back
+      std::reverse(readers_.begin(), readers_.end());
+    } else {
+      std::make_heap(readers_.begin(), readers_.end(), HeapCompare());
+    }
+  }
+
+  bool HasNext() const { return !readers_.empty(); }
+
+  const byte *Current() const { return partitioned_ ? readers_.back()->Current() : readers_.front()->Current(); }
+
+  void Next() {
+    if (partitioned_) {
+      readers_.back()->Next();
+      if (!readers_.back()->HasNext()) {
+        readers_.pop_back();
+      }
+      return;
+    }
+    std::pop_heap(readers_.begin(), readers_.end(), HeapCompare());
+    readers_.back()->Next();
+    if (readers_.back()->HasNext()) {
+      std::push_heap(readers_.begin(), readers_.end(), HeapCompare());
+    } else {
+      readers_.pop_back();
+    }
+  }
+
+ private:
+  // Keeps the reader with the smallest current tuple on top of the heap
+  struct ReaderGreater {
+    const Sorter *sorter_;
+    bool operator()(const std::unique_ptr<SortRunReader> &l, const std::unique_ptr<SortRunReader> &r) const {
+      return sorter_->Compare(l->Current(), r->Current()) > 0;
+    }
+  };
+
+  ReaderGreater HeapCompare() const { return ReaderGreater{sorter_}; }
+
+  const Sorter *sorter_;
+  std::vector<std::unique_ptr<SortRunReader>> readers_;
+  const bool partitioned_;
+};
+
+std::unique_ptr<SortRun> Sorter::MergeRuns(std::vector<std::unique_ptr<SortRun>> runs) const {
+  TERRIER_ASSERT(runs.size() <= K_MAX_MERGE_FAN_IN, "Too many runs to merge at once");
+  std::vector<std::unique_ptr<SortRunReader>> readers;
+  for (const auto &run : runs) {
+    readers.emplace_back(std::make_unique<SortRunReader>(run.get(), 0, run->NumTuples(), memory_->GetTracker()));
+  }
+  auto merged_run = std::make_unique<SortRun>(tuple_size_, memory_->GetTracker());
+  for (RunMerger merger(this, std::move(readers), false); merger.HasNext(); merger.Next()) {
+    merged_run->Append(merger.Current());
+  }
+  merged_run->FinishWriting();
+  return merged_run;
+}
+
+void Sorter::ReduceRuns(std::vector<std::unique_ptr<SortRun>> *runs) const {
+  while (runs->size() > K_MAX_MERGE_FAN_IN) {
+    // Merge consecutive groups of runs in parallel, leaving one run per group
+    const uint64_t num_groups = (runs->size() + K_MAX_MERGE_FAN_IN - 1) / K_MAX_MERGE_FAN_IN;
+    std::vector<std::unique_ptr<SortRun>> merged_runs(num_groups);
+    tbb::parallel_for(uint64_t(0), num_groups, [&](const uint64_t group_idx) {
+      const uint64_t begin = group_idx * K_MAX_MERGE_FAN_IN;
+      const uint64_t end = std::min(begin + K_MAX_MERGE_FAN_IN, uint64_t(runs->size()));
+      if (end - begin == 1) {
+        merged_runs[group_idx] = std::move((*runs)[begin]);
+        return;
+      }
+      merged_runs[group_idx] = MergeRuns(std::vector<std::unique_ptr<SortRun>>(
+          std::make_move_iterator(runs->begin() + begin), std::make_move_iterator(runs->begin() + end)));
+    });
+    *runs = std::move(merged_runs);
+  }
+}
+
+void Sorter::MergeRunsParallel(std::vector<std::unique_ptr<SortRun>> runs) {
+  const auto comp = [this](const byte *left, const byte *right) { return Compare(left, right) < 0; };
+  const uint32_t num_partitions = std::max(1u, std::thread::hardware_concurrency());
+
+  util::StageTimer<std::milli> timer;
+
+  // -------------------------------------------------------
+  // 1. Compute splitters from evenly spaced samples of each run
+  // -------------------------------------------------------
+
+  timer.EnterStage("Compute Run Splitters");
+
+  std::vector<byte> samples(runs.size() * num_partitions * tuple_size_);
+  std::vector<const byte *> sorted_samples;
+  for (const auto &run : runs) {
+    for (uint32_t i = 1; i <= num_partitions; i++) {
+      byte *const sample = samples.data() + sorted_samples.size() * tuple_size_;
+      run->Read(run->NumTuples() * i / (num_partitions + 1), 1, sample);
+      sorted_samples.push_back(sample);
+    }
+  }
+  std::sort(sorted_samples.begin(), sorted_samples.end(), comp);
+
+  std::vector<const byte *> splitters;
+  for (uint32_t i = 1; i < num_partitions; i++) {
+    splitters.push_back(sorted_samples[sorted_samples.size() * i / num_partitions]);
+  }
+
+  timer.ExitStage();
+
+  // -------------------------------------------------------
+  // 2. Find the range of each run that falls between each pair of splitters
+  // -------------------------------------------------------
+
+  timer.EnterStage("Compute Run Ranges");
+
+  // bounds[i][j] is the index of the first tuple of the i-th run in the j-th
+  // range of the output
+  std::vector<std::vector<uint64_t>> bounds(runs.size());
+  tbb::parallel_for(std::size_t(0), runs.size(), [&](const std::size_t run_idx) {
+    const SortRun &run = *runs[run_idx];
+    std::vector<byte> tuple(tuple_size_);
+    auto &run_bounds = bounds[run_idx];
+    run_bounds.push_back(0);
+    for (const byte *splitter : splitters) {
+      // Binary search for the first tuple after the splitter
+      uint64_t low = run_bounds.back(), high = run.NumTuples();
+      while (low < high) {
+        const uint64_t mid = low + (high - low) / 2;
+        run.Read(mid, 1, tuple.data());
+        if (comp(splitter, tuple.data())) {
+          high = mid;
+        } else {
+          low = mid + 1;
+        }
+      }
+      run_bounds.push_back(low);
+    }
+    run_bounds.push_back(run.NumTuples());
+  });
+
+  timer.ExitStage();
+
+  // -------------------------------------------------------
+  // 3. Merge each range of the output into its own run, in parallel
+  // -------------------------------------------------------
+
+  timer.EnterStage("Parallel Merge Runs");
+
+  // Every partition reads every run, so they split the read buffer of each run
+  const uint64_t reader_buffer_size = SortRun::K_IO_SIZE / num_partitions;
+  std::vector<std::unique_ptr<SortRun>> merged_runs(num_partitions);
+  tbb::parallel_for(uint32_t(0), num_partitions, [&](const uint32_t part_idx) {
+    std::vector<std::unique_ptr<SortRunReader>> readers;
+    for (uint32_t run_idx = 0; run_idx < runs.size(); run_idx++) {
+      const uint64_t begin = bounds[run_idx][part_idx], end = bounds[run_idx][part_idx + 1];
+      if (begin != end) {
+        readers.emplace_back(std::make_unique<SortRunReader>(runs[run_idx].get(), begin, end, memory_->GetTracker(),
+                                                             reader_buffer_size));
+      }
+    }
+    if (readers.empty()) {
+      return;
+    }
+    auto merged_run = std::make_unique<SortRun>(tuple_size_, memory_->GetTracker());
+    for (RunMerger merger(this, std::move(readers), false); merger.HasNext(); merger.Next()) {
+      merged_run->Append(merger.Current());
+    }
+    merged_run->FinishWriting();
+    merged_runs[part_idx] = std::move(merged_run);
+  });
+
+  timer.ExitStage();
+
+  // The merged runs replace the input runs
+  runs_.clear();
+  for (auto &merged_run : merged_runs) {
+    if (merged_run != nullptr) {
+      runs_.emplace_back(std::move(merged_run));
+    }
+  }
+  runs_partitioned_ = true;
+
+  EXECUTION_LOG_DEBUG("Parallel Merge Runs:");
+  for (const auto &stage : timer.GetStages()) {
+    EXECUTION_LOG_DEBUG("  {}: {:.2f} ms", stage.Name(), stage.Time());
+  }
+}
+
+namespace {
+
 // Structure we use to track a package of merging work.
 template <typename IterType>
 struct MergeWork {
@@ -141,7 +506,7 @@ struct MergeWork {
 }  // namespace
 
 void Sorter::SortParallel(const ThreadStateContainer *thread_state_container, const uint32_t sorter_offset) {
-  const auto comp = [this](const byte *left, const byte *right) { return cmp_fn_(left, right) < 0; };
+  const auto comp = [this](const byte *left, const byte *right) { return Compare(left, right) < 0; };
 
   // -------------------------------------------------------
   // First, collect all non-empty thread-local sorters
@@ -157,6 +522,31 @@ void Sorter::SortParallel(const ThreadStateContainer *thread_state_container, co
     return;
   }
 
+  // If any thread-local sorter spilled, spill the rest too and merge the runs
+  // on disk instead
+  if (std::any_of(tl_sorters.begin(), tl_sorters.end(), [](Sorter *const sorter) { return sorter->NumRuns() > 0; })) {
+    tbb::task_scheduler_init sched;
+    tbb::parallel_for_each(tl_sorters.begin(), tl_sorters.end(), [](Sorter *const sorter) {
+      if (!sorter->tuples_.empty()) {
+        sorter->SpillRun();
+      }
+    });
+
+    std::vector<std::unique_ptr<SortRun>> runs;
+    for (auto *tl_sorter : tl_sorters) {
+      std::move(tl_sorter->runs_.begin(), tl_sorter->runs_.end(), std::back_inserter(runs));
+      tl_sorter->runs_.clear();
+      tl_sorter->run_levels_.clear();
+      num_spilled_tuples_ += tl_sorter->num_spilled_tuples_;
+      tl_sorter->num_spilled_tuples_ = 0;
+    }
+    ReduceRuns(&runs);
+    MergeRunsParallel(std::move(runs));
+
+    sorted_ = true;
+    return;
+  }
+
   // -------------------------------------------------------
   // 1. Make room in this sorter for all result tuples
   // -------------------------------------------------------
@@ -284,7 +674,7 @@ void Sorter::SortParallel(const ThreadStateContainer *thread_state_container, co
   timer.EnterStage("Parallel Merge");
 
   auto heap_cmp = [this](const MergeWorkType::Range &l, const MergeWorkType::Range &r) {
-    return cmp_fn_(*l.first, *r.first) >= 0;
+    return Compare(*l.first, *r.first) >= 0;
   };
 
   tbb::parallel_for_each(merge_work.begin(), merge_work.end(), [&heap_cmp](const MergeWork<SeqTypeIter> &work) {
@@ -325,7 +715,7 @@ void Sorter::SortParallel(const ThreadStateContainer *thread_state_container, co
 
   EXECUTION_LOG_DEBUG("Parallel Sort:");
   for (const auto &stage : timer.GetStages()) {
-    EXECUTION_LOG_DEBUG("  {}: {.2f} ms", stage.Name(), stage.Time());
+    EXECUTION_LOG_DEBUG("  {}: {:.2f} ms", stage.Name(), stage.Time());
   }
 }
 
@@ -338,4 +728,29 @@ void Sorter::SortTopKParallel(const ThreadStateContainer *thread_state_container
   tuples_.resize(top_k);
 }
 
+// ---------------------------------------------------------
+// Sorter Iterator
+// ---------------------------------------------------------
+
+SorterIterator::SorterIterator(Sorter *sorter)
+    : iter_(sorter->tuples_.begin()), end_(sorter->tuples_.end()), merged_row_(nullptr) {
+  if (sorter->NumRuns() > 0) {
+    TERRIER_ASSERT(sorter->IsSorted() && sorter->tuples_.empty(), "Spilled sorters must be sorted before iteration");
+    const auto tracker = sorter->memory_->GetTracker();
+    std::vector<std::unique_ptr<SortRunReader>> readers;
+    for (const auto &run : sorter->runs_) {
+      readers.emplace_back(std::make_unique<SortRunReader>(run.get(), 0, run->NumTuples(), tracker));
+    }
+    merger_ = std::make_unique<Sorter::RunMerger>(sorter, std::move(readers), sorter->runs_partitioned_);
+    merged_row_ = merger_->HasNext() ? merger_->Current() : nullptr;
+  }
+}
+
+SorterIterator::~SorterIterator() = default;
+
+void SorterIterator::NextMerged() {
+  merger_->Next();
+  merged_row_ = merger_->HasNext() ? merger_->Current() : nullptr;
+}
+
 }  // namespace terrier::execution::sql
@@ -278,6 +278,30 @@ void BytecodeEmitter::EmitPCIVectorFilter(Bytecode bytecode, LocalVar selected,
   EmitAll(bytecode, selected, pci, col_idx, type, val);
 }
 
+void BytecodeEmitter::EmitPCIStringFilter(Bytecode bytecode, LocalVar selected, LocalVar pci, uint32_t col_idx,
+                                          uint64_t length, uintptr_t data) {
+  EmitAll(bytecode, selected, pci, col_idx, length, data);
+}
+
+void BytecodeEmitter::EmitPCILikeFilter(Bytecode bytecode, LocalVar selected, LocalVar pci, uint32_t col_idx,
+                                        uintptr_t pattern) {
+  EmitAll(bytecode, selected, pci, col_idx, pattern);
+}
+
+void BytecodeEmitter::EmitLikeConstant(LocalVar result, LocalVar str, uintptr_t pattern) {
+  EmitAll(Bytecode::LikeConstant, result, str, pattern);
+}
+
+void BytecodeEmitter::EmitPCICompute(Bytecode bytecode, LocalVar pci, uint32_t out_idx, uint32_t col_idx_1,
+                                     int8_t type_1, uint32_t col_idx_2, int8_t type_2) {
+  EmitAll(bytecode, pci, out_idx, col_idx_1, type_1, col_idx_2, type_2);
+}
+
+void BytecodeEmitter::EmitPCIComputeVal(Bytecode bytecode, LocalVar pci, uint32_t out_idx, uint32_t col_idx,
+                                        int8_t type, int64_t val) {
+  EmitAll(bytecode, pci, out_idx, col_idx, type, val);
+}
+
 void BytecodeEmitter::EmitFilterManagerInsertFlavor(LocalVar fmb, FunctionId func) {
   EmitAll(Bytecode::FilterManagerInsertFlavor, fmb, func);
 }
@@ -289,8 +313,9 @@ void BytecodeEmitter::EmitAggHashTableLookup(LocalVar dest, LocalVar agg_ht, Loc
 
 void BytecodeEmitter::EmitAggHashTableProcessBatch(LocalVar agg_ht, LocalVar iters, FunctionId hash_fn,
                                                    FunctionId key_eq_fn, FunctionId init_agg_fn,
-                                                   FunctionId merge_agg_fn) {
-  EmitAll(Bytecode::AggregationHashTableProcessBatch, agg_ht, iters, hash_fn, key_eq_fn, init_agg_fn, merge_agg_fn);
+                                                   FunctionId merge_agg_fn, LocalVar partitioned) {
+  EmitAll(Bytecode::AggregationHashTableProcessBatch, agg_ht, iters, hash_fn, key_eq_fn, init_agg_fn, merge_agg_fn,
+          partitioned);
 }
 
 void BytecodeEmitter::EmitAggHashTableMovePartitions(LocalVar agg_ht, LocalVar tls, LocalVar aht_offset,
@@ -309,8 +334,8 @@ void BytecodeEmitter::EmitJoinHashTableIterHasNext(LocalVar has_more, LocalVar i
 }
 
 void BytecodeEmitter::EmitSorterInit(Bytecode bytecode, LocalVar sorter, LocalVar region, FunctionId cmp_fn,
-                                     LocalVar tuple_size) {
-  EmitAll(bytecode, sorter, region, cmp_fn, tuple_size);
+                                     LocalVar tuple_size, LocalVar num_key_words) {
+  EmitAll(bytecode, sorter, region, cmp_fn, tuple_size, num_key_words);
 }
 
 void BytecodeEmitter::EmitOutputAlloc(Bytecode bytecode, LocalVar exec_ctx, LocalVar dest) {
@@ -806,6 +806,12 @@ void BytecodeGenerator::VisitBuiltinPCICall(ast::CallExpr *call, ast::Builtin bu
       Emitter()->EmitPCIGet(Bytecode::PCIGetVarlenNull, val, pci, col_idx);
       break;
     }
+    case ast::Builtin::PCIGetComputed: {
+      LocalVar val = ExecutionResult()->GetOrCreateDestination(ast::BuiltinType::Get(ctx, ast::BuiltinType::Integer));
+      auto col_idx = static_cast<uint16_t>(call->Arguments()[1]->As<ast::LitExpr>()->Int64Val());
+      Emitter()->EmitPCIGet(Bytecode::PCIGetComputed, val, pci, col_idx);
+      break;
+    }
     default: {
       UNREACHABLE("Impossible table iteration call");
     }
@@ -905,6 +911,59 @@ void BytecodeGenerator::VisitBuiltinFilterCall(ast::CallExpr *call, ast::Builtin
   // Column index
   auto col_idx = static_cast<uint16_t>(call->Arguments()[1]->As<ast::LitExpr>()->Int64Val());
   auto col_type = static_cast<int8_t>(call->Arguments()[2]->As<ast::LitExpr>()->Int64Val());
+
+  // String literals (and LIKE patterns, which are always strings) are embedded in the bytecode like in InitString
+  if (call->Arguments()[3]->IsStringLiteral()) {
+    auto str = call->Arguments()[3]->As<ast::LitExpr>()->RawStringVal();
+    Bytecode bytecode;
+    switch (builtin) {
+      case ast::Builtin::FilterEq: {
+        bytecode = Bytecode::PCIFilterStringEqual;
+        break;
+      }
+      case ast::Builtin::FilterGt: {
+        bytecode = Bytecode::PCIFilterStringGreaterThan;
+        break;
+      }
+      case ast::Builtin::FilterGe: {
+        bytecode = Bytecode::PCIFilterStringGreaterThanEqual;
+        break;
+      }
+      case ast::Builtin::FilterLt: {
+        bytecode = Bytecode::PCIFilterStringLessThan;
+        break;
+      }
+      case ast::Builtin::FilterLe: {
+        bytecode = Bytecode::PCIFilterStringLessThanEqual;
+        break;
+      }
+      case ast::Builtin::FilterNe: {
+        bytecode = Bytecode::PCIFilterStringNotEqual;
+        break;
+      }
+      case ast::Builtin::FilterLike: {
+        bytecode = Bytecode::PCIFilterLike;
+        break;
+      }
+      case ast::Builtin::FilterNotLike: {
+        bytecode = Bytecode::PCIFilterNotLike;
+        break;
+      }
+      default: {
+        UNREACHABLE("Impossible bytecode");
+      }
+    }
+    if (bytecode == Bytecode::PCIFilterLike || bytecode == Bytecode::PCIFilterNotLike) {
+      // The pattern is compiled here rather than for every vector
+      const auto *pattern = CompileLikePattern(std::string_view(str.Data(), str.Length()));
+      Emitter()->EmitPCILikeFilter(bytecode, ret_val, pci, col_idx, reinterpret_cast<uintptr_t>(pattern));
+    } else {
+      Emitter()->EmitPCIStringFilter(bytecode, ret_val, pci, col_idx, str.Length(),
+                                     reinterpret_cast<uintptr_t>(str.Data()));
+    }
+    return;
+  }
+
   // Filter value
   int64_t val = call->Arguments()[3]->As<ast::LitExpr>()->Int64Val();
 
@@ -941,6 +1000,53 @@ void BytecodeGenerator::VisitBuiltinFilterCall(ast::CallExpr *call, ast::Builtin
   Emitter()->EmitPCIVectorFilter(bytecode, ret_val, pci, col_idx, col_type, val);
 }
 
+void BytecodeGenerator::VisitBuiltinComputeCall(ast::CallExpr *call, ast::Builtin builtin) {
+  const auto &args = call->Arguments();
+  LocalVar pci = VisitExpressionForRValue(args[0]);
+  // Column indexes, types and constant values are embedded in the bytecode
+  auto literal = [&](uint32_t arg_idx) { return args[arg_idx]->As<ast::LitExpr>()->Int64Val(); };
+  auto out_idx = static_cast<uint32_t>(literal(1));
+  auto col_idx = static_cast<uint32_t>(literal(2));
+  auto col_type = static_cast<int8_t>(literal(3));
+
+  switch (builtin) {
+    case ast::Builtin::PCIComputeAdd: {
+      Emitter()->EmitPCICompute(Bytecode::PCIComputeAdd, pci, out_idx, col_idx, col_type,
+                                static_cast<uint32_t>(literal(4)), static_cast<int8_t>(literal(5)));
+      break;
+    }
+    case ast::Builtin::PCIComputeSub: {
+      Emitter()->EmitPCICompute(Bytecode::PCIComputeSub, pci, out_idx, col_idx, col_type,
+                                static_cast<uint32_t>(literal(4)), static_cast<int8_t>(literal(5)));
+      break;
+    }
+    case ast::Builtin::PCIComputeMul: {
+      Emitter()->EmitPCICompute(Bytecode::PCIComputeMul, pci, out_idx, col_idx, col_type,
+                                static_cast<uint32_t>(literal(4)), static_cast<int8_t>(literal(5)));
+      break;
+    }
+    case ast::Builtin::PCIComputeAddVal: {
+      Emitter()->EmitPCIComputeVal(Bytecode::PCIComputeAddVal, pci, out_idx, col_idx, col_type, literal(4));
+      break;
+    }
+    case ast::Builtin::PCIComputeSubVal: {
+      Emitter()->EmitPCIComputeVal(Bytecode::PCIComputeSubVal, pci, out_idx, col_idx, col_type, literal(4));
+      break;
+    }
+    case ast::Builtin::PCIComputeMulVal: {
+      Emitter()->EmitPCIComputeVal(Bytecode::PCIComputeMulVal, pci, out_idx, col_idx, col_type, literal(4));
+      break;
+    }
+    case ast::Builtin::PCIComputeValSub: {
+      Emitter()->EmitPCIComputeVal(Bytecode::PCIComputeValSub, pci, out_idx, col_idx, col_type, literal(4));
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible compute call");
+    }
+  }
+}
+
 void BytecodeGenerator::VisitBuiltinAggHashTableCall(ast::CallExpr *call, ast::Builtin builtin) {
   switch (builtin) {
     case ast::Builtin::AggHashTableInit: {
@@ -973,7 +1079,9 @@ void BytecodeGenerator::VisitBuiltinAggHashTableCall(ast::CallExpr *call, ast::B
       auto key_eq_fn = LookupFuncIdByName(call->Arguments()[3]->As<ast::IdentifierExpr>()->Name().Data());
       auto init_agg_fn = LookupFuncIdByName(call->Arguments()[4]->As<ast::IdentifierExpr>()->Name().Data());
       auto merge_agg_fn = LookupFuncIdByName(call->Arguments()[5]->As<ast::IdentifierExpr>()->Name().Data());
-      Emitter()->EmitAggHashTableProcessBatch(agg_ht, iters, hash_fn, key_eq_fn, init_agg_fn, merge_agg_fn);
+      LocalVar partitioned = VisitExpressionForRValue(call->Arguments()[6]);
+      Emitter()->EmitAggHashTableProcessBatch(agg_ht, iters, hash_fn, key_eq_fn, init_agg_fn, merge_agg_fn,
+                                              partitioned);
       break;
     }
     case ast::Builtin::AggHashTableMovePartitions: {
@@ -1307,7 +1415,52 @@ void BytecodeGenerator::VisitBuiltinSorterCall(ast::CallExpr *call, ast::Builtin
       LocalVar memory = VisitExpressionForRValue(call->Arguments()[1]);
       const std::string cmp_func_name = call->Arguments()[2]->As<ast::IdentifierExpr>()->Name().Data();
       LocalVar entry_size = VisitExpressionForRValue(call->Arguments()[3]);
-      Emitter()->EmitSorterInit(Bytecode::SorterInit, sorter, memory, LookupFuncIdByName(cmp_func_name), entry_size);
+      LocalVar num_key_words;
+      if (call->NumArgs() > 4) {
+        num_key_words = VisitExpressionForRValue(call->Arguments()[4]);
+      } else {
+        ast::Context *ctx = call->GetType()->GetContext();
+        num_key_words = CurrentFunction()->NewLocal(ast::BuiltinType::Get(ctx, ast::BuiltinType::Uint32));
+        Emitter()->EmitAssignImm4(num_key_words, 0);
+      }
+      Emitter()->EmitSorterInit(Bytecode::SorterInit, sorter, memory, LookupFuncIdByName(cmp_func_name), entry_size,
+                                num_key_words);
+      break;
+    }
+    case ast::Builtin::SorterKey: {
+      LocalVar dest = ExecutionResult()->GetOrCreateDestination(call->GetType());
+      LocalVar input = VisitExpressionForLValue(call->Arguments()[0]);
+      LocalVar descending = VisitExpressionForRValue(call->Arguments()[1]);
+      switch (call->Arguments()[0]->GetType()->As<ast::BuiltinType>()->GetKind()) {
+        case ast::BuiltinType::Boolean: {
+          Emitter()->Emit(Bytecode::SorterKeyBool, dest, input, descending);
+          break;
+        }
+        case ast::BuiltinType::Integer: {
+          Emitter()->Emit(Bytecode::SorterKeyInt, dest, input, descending);
+          break;
+        }
+        case ast::BuiltinType::Real: {
+          Emitter()->Emit(Bytecode::SorterKeyReal, dest, input, descending);
+          break;
+        }
+        case ast::BuiltinType::Date: {
+          Emitter()->Emit(Bytecode::SorterKeyDate, dest, input, descending);
+          break;
+        }
+        case ast::BuiltinType::Timestamp: {
+          Emitter()->Emit(Bytecode::SorterKeyTimestamp, dest, input, descending);
+          break;
+        }
+        case ast::BuiltinType::StringVal: {
+          Emitter()->Emit(Bytecode::SorterKeyString, dest, input, descending);
+          break;
+        }
+        default: {
+          UNREACHABLE("Sort keys of this type aren't supported!");
+        }
+      }
+      ExecutionResult()->SetDestination(dest.ValueOf());
       break;
     }
     case ast::Builtin::SorterInsert: {
@@ -1566,7 +1719,8 @@ void BytecodeGenerator::VisitBuiltinIndexIteratorCall(ast::CallExpr *call, ast::
   ast::Context *ctx = call->GetType()->GetContext();
 
   switch (builtin) {
-    case ast::Builtin::IndexIteratorInit: {
+    case ast::Builtin::IndexIteratorInit:
+    case ast::Builtin::IndexIteratorInitCovering: {
       // Execution context
       LocalVar exec_ctx = VisitExpressionForRValue(call->Arguments()[1]);
       // Num attrs
@@ -1581,7 +1735,9 @@ void BytecodeGenerator::VisitBuiltinIndexIteratorCall(ast::CallExpr *call, ast::
       // Emit the initialization codes
       Emitter()->EmitIndexIteratorInit(Bytecode::IndexIteratorInit, iterator, exec_ctx, num_attrs, table_oid, index_oid,
                                        col_oids, static_cast<uint32_t>(arr_type->Length()));
-      Emitter()->Emit(Bytecode::IndexIteratorPerformInit, iterator);
+      Emitter()->Emit(builtin == ast::Builtin::IndexIteratorInitCovering ? Bytecode::IndexIteratorPerformInitCovering
+                                                                         : Bytecode::IndexIteratorPerformInit,
+                      iterator);
       break;
     }
     case ast::Builtin::IndexIteratorInitBind: {
@@ -1611,12 +1767,30 @@ void BytecodeGenerator::VisitBuiltinIndexIteratorCall(ast::CallExpr *call, ast::
       Emitter()->Emit(Bytecode::IndexIteratorScanKey, iterator);
       break;
     }
+    case ast::Builtin::IndexIteratorAddKey: {
+      Emitter()->Emit(Bytecode::IndexIteratorAddKey, iterator);
+      break;
+    }
+    case ast::Builtin::IndexIteratorScanKeys: {
+      Emitter()->Emit(Bytecode::IndexIteratorScanKeys, iterator);
+      break;
+    }
+    case ast::Builtin::IndexIteratorScanNextKey: {
+      Emitter()->Emit(Bytecode::IndexIteratorScanNextKey, iterator);
+      break;
+    }
     case ast::Builtin::IndexIteratorScanAscending: {
       auto asc_type = VisitExpressionForRValue(call->Arguments()[1]);
       auto limit = VisitExpressionForRValue(call->Arguments()[2]);
       Emitter()->Emit(Bytecode::IndexIteratorScanAscending, iterator, asc_type, limit);
       break;
     }
+    case ast::Builtin::IndexIteratorStreamAscending: {
+      auto asc_type = VisitExpressionForRValue(call->Arguments()[1]);
+      auto limit = VisitExpressionForRValue(call->Arguments()[2]);
+      Emitter()->Emit(Bytecode::IndexIteratorStreamAscending, iterator, asc_type, limit);
+      break;
+    }
     case ast::Builtin::IndexIteratorScanDescending: {
       Emitter()->Emit(Bytecode::IndexIteratorScanDescending, iterator);
       break;
@@ -2070,6 +2244,22 @@ void BytecodeGenerator::VisitBuiltinStringCall(ast::CallExpr *call, ast::Builtin
       Emitter()->Emit(Bytecode::Position, exec_ctx, ret, input_string, sub_string);
       break;
     }
+    case ast::Builtin::Like: {
+      // Constant patterns, i.e. @stringToSql() of a literal, are compiled here rather than for every row
+      ast::Builtin pattern_builtin;
+      auto *pattern_call = call->Arguments()[2]->SafeAs<ast::CallExpr>();
+      if (pattern_call != nullptr && pattern_call->GetCallKind() == ast::CallExpr::CallKind::Builtin &&
+          call->GetType()->GetContext()->IsBuiltinFunction(pattern_call->GetFuncName(), &pattern_builtin) &&
+          pattern_builtin == ast::Builtin::StringToSql) {
+        auto literal = pattern_call->Arguments()[0]->As<ast::LitExpr>()->RawStringVal();
+        const auto *pattern = CompileLikePattern(std::string_view(literal.Data(), literal.Length()));
+        Emitter()->EmitLikeConstant(ret, input_string, reinterpret_cast<uintptr_t>(pattern));
+        break;
+      }
+      LocalVar pattern = VisitExpressionForRValue(call->Arguments()[2]);
+      Emitter()->Emit(Bytecode::Like, exec_ctx, ret, input_string, pattern);
+      break;
+    }
     default:
       UNREACHABLE("Unimplemented string function!");
   }
@@ -2109,10 +2299,22 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     case ast::Builtin::FilterGe:
     case ast::Builtin::FilterLt:
     case ast::Builtin::FilterLe:
-    case ast::Builtin::FilterNe: {
+    case ast::Builtin::FilterNe:
+    case ast::Builtin::FilterLike:
+    case ast::Builtin::FilterNotLike: {
       VisitBuiltinFilterCall(call, builtin);
       break;
     }
+    case ast::Builtin::PCIComputeAdd:
+    case ast::Builtin::PCIComputeSub:
+    case ast::Builtin::PCIComputeMul:
+    case ast::Builtin::PCIComputeAddVal:
+    case ast::Builtin::PCIComputeSubVal:
+    case ast::Builtin::PCIComputeMulVal:
+    case ast::Builtin::PCIComputeValSub: {
+      VisitBuiltinComputeCall(call, builtin);
+      break;
+    }
     case ast::Builtin::ExecutionContextStartResourceTracker:
     case ast::Builtin::ExecutionContextEndResourceTracker:
     case ast::Builtin::ExecutionContextEndPipelineTracker:
@@ -2168,7 +2370,8 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     case ast::Builtin::PCIGetTimestamp:
     case ast::Builtin::PCIGetTimestampNull:
     case ast::Builtin::PCIGetVarlen:
-    case ast::Builtin::PCIGetVarlenNull: {
+    case ast::Builtin::PCIGetVarlenNull:
+    case ast::Builtin::PCIGetComputed: {
       VisitBuiltinPCICall(call, builtin);
       break;
     }
@@ -2230,6 +2433,7 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
       break;
     }
     case ast::Builtin::SorterInit:
+    case ast::Builtin::SorterKey:
     case ast::Builtin::SorterInsert:
     case ast::Builtin::SorterInsertTopK:
     case ast::Builtin::SorterInsertTopKFinish:
@@ -2280,8 +2484,13 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
       break;
     case ast::Builtin::IndexIteratorInit:
     case ast::Builtin::IndexIteratorInitBind:
+    case ast::Builtin::IndexIteratorInitCovering:
     case ast::Builtin::IndexIteratorScanKey:
+    case ast::Builtin::IndexIteratorAddKey:
+    case ast::Builtin::IndexIteratorScanKeys:
+    case ast::Builtin::IndexIteratorScanNextKey:
     case ast::Builtin::IndexIteratorScanAscending:
+    case ast::Builtin::IndexIteratorStreamAscending:
     case ast::Builtin::IndexIteratorScanDescending:
     case ast::Builtin::IndexIteratorScanLimitDescending:
     case ast::Builtin::IndexIteratorAdvance:
@@ -2369,7 +2578,8 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
       VisitBuiltinStringCall(call, builtin);
       break;
     }
-    case ast::Builtin::Position: {
+    case ast::Builtin::Position:
+    case ast::Builtin::Like: {
       VisitBuiltinStringCall(call, builtin);
       break;
     }
@@ -2947,6 +3157,11 @@ FunctionId BytecodeGenerator::LookupFuncIdByName(const std::string &name) const
   return iter->second;
 }
 
+const sql::LikePattern *BytecodeGenerator::CompileLikePattern(std::string_view pattern) {
+  like_patterns_.push_back(std::make_unique<sql::LikePattern>(pattern));
+  return like_patterns_.back().get();
+}
+
 LocalVar BytecodeGenerator::VisitExpressionForLValue(ast::Expr *expr) {
   LValueResultScope scope(this);
   Visit(expr);
@@ -3008,7 +3223,8 @@ std::unique_ptr<BytecodeModule> BytecodeGenerator::Compile(ast::AstNode *root, e
 
   // Create the bytecode module. Note that we move the bytecode and functions
   // array from the generator into the module.
-  return std::make_unique<BytecodeModule>(name, std::move(generator.bytecode_), std::move(generator.functions_));
+  return std::make_unique<BytecodeModule>(name, std::move(generator.bytecode_), std::move(generator.functions_),
+                                          std::move(generator.like_patterns_));
 }
 
 }  // namespace terrier::execution::vm
@@ -84,6 +84,106 @@ void OpPCIFilterNotEqual(uint64_t *size, terrier::execution::sql::ProjectedColum
   *size = iter->FilterColByVal<std::not_equal_to>(col_idx, sql_type, v);
 }
 
+namespace {
+// Wrap a string literal embedded in the bytecode in a varlen entry without copying it
+terrier::storage::VarlenEntry MakeStringFilterVal(uint64_t length, uintptr_t data) {
+  const auto *content = reinterpret_cast<const terrier::byte *>(data);
+  const auto size = static_cast<uint32_t>(length);
+  if (size <= terrier::storage::VarlenEntry::InlineThreshold()) {
+    return terrier::storage::VarlenEntry::CreateInline(content, size);
+  }
+  return terrier::storage::VarlenEntry::Create(content, size, false);
+}
+}  // namespace
+
+void OpPCIFilterStringEqual(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t col_idx,
+                            uint64_t length, uintptr_t data) {
+  *size = iter->FilterColByString<std::equal_to>(col_idx, MakeStringFilterVal(length, data));
+}
+
+void OpPCIFilterStringGreaterThan(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter,
+                                  uint32_t col_idx, uint64_t length, uintptr_t data) {
+  *size = iter->FilterColByString<std::greater>(col_idx, MakeStringFilterVal(length, data));
+}
+
+void OpPCIFilterStringGreaterThanEqual(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter,
+                                       uint32_t col_idx, uint64_t length, uintptr_t data) {
+  *size = iter->FilterColByString<std::greater_equal>(col_idx, MakeStringFilterVal(length, data));
+}
+
+void OpPCIFilterStringLessThan(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter,
+                               uint32_t col_idx, uint64_t length, uintptr_t data) {
+  *size = iter->FilterColByString<std::less>(col_idx, MakeStringFilterVal(length, data));
+}
+
+void OpPCIFilterStringLessThanEqual(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter,
+                                    uint32_t col_idx, uint64_t length, uintptr_t data) {
+  *size = iter->FilterColByString<std::less_equal>(col_idx, MakeStringFilterVal(length, data));
+}
+
+void OpPCIFilterStringNotEqual(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter,
+                               uint32_t col_idx, uint64_t length, uintptr_t data) {
+  *size = iter->FilterColByString<std::not_equal_to>(col_idx, MakeStringFilterVal(length, data));
+}
+
+void OpPCIFilterLike(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t col_idx,
+                     uintptr_t pattern) {
+  const auto &like_pattern = *reinterpret_cast<const terrier::execution::sql::LikePattern *>(pattern);
+  *size = iter->FilterColByLike(col_idx, like_pattern, false);
+}
+
+void OpPCIFilterNotLike(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t col_idx,
+                        uintptr_t pattern) {
+  const auto &like_pattern = *reinterpret_cast<const terrier::execution::sql::LikePattern *>(pattern);
+  *size = iter->FilterColByLike(col_idx, like_pattern, true);
+}
+
+void OpPCIComputeAdd(terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t out_idx, uint32_t col_idx_1,
+                     int8_t type_1, uint32_t col_idx_2, int8_t type_2) {
+  UNUSED_ATTRIBUTE bool overflow;
+  iter->ComputeColByCol<std::plus>(out_idx, col_idx_1, static_cast<terrier::type::TypeId>(type_1), col_idx_2,
+                                   static_cast<terrier::type::TypeId>(type_2), &overflow);
+}
+
+void OpPCIComputeSub(terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t out_idx, uint32_t col_idx_1,
+                     int8_t type_1, uint32_t col_idx_2, int8_t type_2) {
+  UNUSED_ATTRIBUTE bool overflow;
+  iter->ComputeColByCol<std::minus>(out_idx, col_idx_1, static_cast<terrier::type::TypeId>(type_1), col_idx_2,
+                                    static_cast<terrier::type::TypeId>(type_2), &overflow);
+}
+
+void OpPCIComputeMul(terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t out_idx, uint32_t col_idx_1,
+                     int8_t type_1, uint32_t col_idx_2, int8_t type_2) {
+  UNUSED_ATTRIBUTE bool overflow;
+  iter->ComputeColByCol<std::multiplies>(out_idx, col_idx_1, static_cast<terrier::type::TypeId>(type_1), col_idx_2,
+                                         static_cast<terrier::type::TypeId>(type_2), &overflow);
+}
+
+void OpPCIComputeAddVal(terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t out_idx, uint32_t col_idx,
+                        int8_t type, int64_t val) {
+  UNUSED_ATTRIBUTE bool overflow;
+  iter->ComputeColByVal<std::plus>(out_idx, col_idx, static_cast<terrier::type::TypeId>(type), val, false, &overflow);
+}
+
+void OpPCIComputeSubVal(terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t out_idx, uint32_t col_idx,
+                        int8_t type, int64_t val) {
+  UNUSED_ATTRIBUTE bool overflow;
+  iter->ComputeColByVal<std::minus>(out_idx, col_idx, static_cast<terrier::type::TypeId>(type), val, false, &overflow);
+}
+
+void OpPCIComputeMulVal(terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t out_idx, uint32_t col_idx,
+                        int8_t type, int64_t val) {
+  UNUSED_ATTRIBUTE bool overflow;
+  iter->ComputeColByVal<std::multiplies>(out_idx, col_idx, static_cast<terrier::type::TypeId>(type), val, false,
+                                         &overflow);
+}
+
+void OpPCIComputeValSub(terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t out_idx, uint32_t col_idx,
+                        int8_t type, int64_t val) {
+  UNUSED_ATTRIBUTE bool overflow;
+  iter->ComputeColByVal<std::minus>(out_idx, col_idx, static_cast<terrier::type::TypeId>(type), val, true, &overflow);
+}
+
 // ---------------------------------------------------------
 // Filter Manager
 // ---------------------------------------------------------
@@ -157,8 +257,9 @@ void OpAggregationHashTableIteratorFree(terrier::execution::sql::AggregationHash
 // ---------------------------------------------------------
 
 void OpSorterInit(terrier::execution::sql::Sorter *const sorter, terrier::execution::sql::MemoryPool *const memory,
-                  const terrier::execution::sql::Sorter::ComparisonFunction cmp_fn, const uint32_t tuple_size) {
-  new (sorter) terrier::execution::sql::Sorter(memory, cmp_fn, tuple_size);
+                  const terrier::execution::sql::Sorter::ComparisonFunction cmp_fn, const uint32_t tuple_size,
+                  const uint32_t num_key_words) {
+  new (sorter) terrier::execution::sql::Sorter(memory, cmp_fn, tuple_size, num_key_words);
 }
 
 void OpSorterSort(terrier::execution::sql::Sorter *sorter) { sorter->Sort(); }
@@ -256,6 +357,8 @@ void OpIndexIteratorInit(terrier::execution::sql::IndexIterator *iter,
 
 void OpIndexIteratorPerformInit(terrier::execution::sql::IndexIterator *iter) { iter->Init(); }
 
+void OpIndexIteratorPerformInitCovering(terrier::execution::sql::IndexIterator *iter) { iter->InitCovering(); }
+
 void OpIndexIteratorFree(terrier::execution::sql::IndexIterator *iter) { iter->~IndexIterator(); }
 
 }  //
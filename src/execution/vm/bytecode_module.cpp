@@ -11,8 +11,12 @@
 
 namespace terrier::execution::vm {
 
-BytecodeModule::BytecodeModule(std::string name, std::vector<uint8_t> &&code, std::vector<FunctionInfo> &&functions)
-    : name_(std::move(name)), code_(std::move(code)), functions_(std::move(functions)) {}
+BytecodeModule::BytecodeModule(std::string name, std::vector<uint8_t> &&code, std::vector<FunctionInfo> &&functions,
+                               std::vector<std::unique_ptr<sql::LikePattern>> &&like_patterns)
+    : name_(std::move(name)),
+      code_(std::move(code)),
+      functions_(std::move(functions)),
+      like_patterns_(std::move(like_patterns)) {}
 
 namespace {
 
@@ -1,5 +1,6 @@
 #include "execution/vm/llvm_engine.h"
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <string>
@@ -19,6 +20,7 @@
 #include "llvm/IR/Verifier.h"
 #include "llvm/MC/MCContext.h"
 #include "llvm/Support/DynamicLibrary.h"
+#include "llvm/Support/Host.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/SmallVectorMemoryBuffer.h"
 #include "llvm/Support/TargetRegistry.h"
@@ -30,8 +32,11 @@
 #include "llvm/Transforms/Scalar.h"
 
 #include "execution/ast/type.h"
+#include "execution/sql/like_pattern.h"
+#include "execution/util/hash.h"
 #include "execution/vm/bytecode_module.h"
 #include "execution/vm/bytecode_traits.h"
+#include "execution/vm/object_cache.h"
 #include "loggers/execution_logger.h"
 
 extern void *__dso_handle __attribute__((__visibility__("hidden")));  // NOLINT
@@ -50,6 +55,127 @@ bool FunctionHasDirectReturn(const ast::FunctionType *func_type) {
   return (!ret_type->IsNilType() && ret_type->Size() <= sizeof(int64_t));
 }
 
+template <typename T>
+void AppendBytes(std::string *fingerprint, const T &value) {
+  fingerprint->append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+void AppendString(std::string *fingerprint, const std::string &value) {
+  AppendBytes(fingerprint, value.size());
+  fingerprint->append(value);
+}
+
+// The name of the variable that the compiled code of a function counts its hotness in
+std::string HotnessCounterName(const std::string &func_name) { return func_name + ".hotness"; }
+
+// The name of the variable that compiled code loads the current implementation of a function from
+std::string FunctionSlotName(const std::string &func_name) { return func_name + ".slot"; }
+
+// Find the operand of a bytecode that points to data the bytecode module owns: a string literal, whose length is the
+// operand before it, or a compiled LIKE pattern. Returns false if the bytecode has no such operand.
+bool GetDataOperand(Bytecode bytecode, uint32_t *operand_index) {
+  switch (bytecode) {
+    case Bytecode::InitString:
+    case Bytecode::LikeConstant: {
+      *operand_index = 2;
+      return true;
+    }
+    case Bytecode::PCIFilterLike:
+    case Bytecode::PCIFilterNotLike: {
+      *operand_index = 3;
+      return true;
+    }
+    case Bytecode::PCIFilterStringEqual:
+    case Bytecode::PCIFilterStringGreaterThan:
+    case Bytecode::PCIFilterStringGreaterThanEqual:
+    case Bytecode::PCIFilterStringLessThan:
+    case Bytecode::PCIFilterStringLessThanEqual:
+    case Bytecode::PCIFilterStringNotEqual: {
+      *operand_index = 4;
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+// The address of the data that a bytecode points to. It differs between compilations of the same query, so the
+// compiled code refers to it through a symbol that is linked when the code is loaded, instead of an immediate.
+void *GetDataAddress(const BytecodeIterator &iter, uint32_t operand_index) {
+  return reinterpret_cast<void *>(static_cast<uintptr_t>(iter.GetImmediateOperand(operand_index)));
+}
+
+// The name of the symbol through which the compiled code of a function refers to the data of one of its bytecodes
+std::string DataSymbolName(const std::string &func_name, std::size_t position) {
+  return func_name + ".data." + std::to_string(position);
+}
+
+// Append the data that a bytecode points to, rather than its address
+void AppendData(std::string *fingerprint, const BytecodeIterator &iter, uint32_t operand_index) {
+  const void *data = GetDataAddress(iter, operand_index);
+  AppendBytes(fingerprint, data != nullptr);
+  if (data == nullptr) return;
+  switch (iter.CurrentBytecode()) {
+    case Bytecode::LikeConstant:
+    case Bytecode::PCIFilterLike:
+    case Bytecode::PCIFilterNotLike: {
+      const auto *pattern = static_cast<const sql::LikePattern *>(data);
+      AppendString(fingerprint, pattern->Pattern());
+      AppendBytes(fingerprint, pattern->Escape());
+      break;
+    }
+    default: {
+      const auto length = static_cast<std::size_t>(iter.GetImmediateOperand(operand_index - 1));
+      fingerprint->append(static_cast<const char *>(data), length);
+      break;
+    }
+  }
+}
+
+// The symbols compiled code uses without defining them. They aren't part of the code, so they don't change it.
+std::unordered_map<std::string, void *> LinkedSymbols(const BytecodeModule &module,
+                                                      const LLVMEngine::CompilerOptions &options) {
+  std::unordered_map<std::string, void *> symbols;
+  for (const auto &[func_name, slot] : options.GetFunctionSlots()) {
+    symbols[FunctionSlotName(func_name)] = slot;
+  }
+  for (const auto &[func_name, counter] : options.GetHotnessCounters()) {
+    symbols[HotnessCounterName(func_name)] = counter;
+  }
+  for (const auto &func_info : module.Functions()) {
+    for (auto iter = module.BytecodeForFunction(func_info); !iter.Done(); iter.Advance()) {
+      uint32_t operand_index;
+      if (GetDataOperand(iter.CurrentBytecode(), &operand_index) && GetDataAddress(iter, operand_index) != nullptr) {
+        symbols[DataSymbolName(func_info.Name(), iter.GetPosition())] = GetDataAddress(iter, operand_index);
+      }
+    }
+  }
+  return symbols;
+}
+
+// The target machine is created for the host CPU, with all of its features
+std::string HostTarget() {
+  llvm::StringMap<bool> feature_map;
+  llvm::sys::getHostCPUFeatures(feature_map);
+  llvm::SubtargetFeatures target_features;
+  for (const auto &entry : feature_map) {
+    target_features.AddFeature(entry.getKey(), entry.getValue());
+  }
+  return llvm::sys::getProcessTriple() + " " + llvm::sys::getHostCPUName().str() + " " + target_features.getString();
+}
+
+// The handlers are inlined into the machine code, so it changes with them
+std::string HandlersVersion(const std::string &bc_path) {
+  auto memory_buffer = llvm::MemoryBuffer::getFile(bc_path);
+  if (memory_buffer.getError()) return "";
+  auto contents = memory_buffer.get()->getBuffer();
+  std::string version;
+  AppendBytes(&version, contents.size());
+  AppendBytes(&version, util::Hasher::Hash<util::HashMethod::xxHash3>(
+                            reinterpret_cast<const uint8_t *>(contents.data()), contents.size()));
+  return version;
+}
+
 }  // namespace
 
 // ---------------------------------------------------------
@@ -81,6 +207,11 @@ class LLVMEngine::TPLMemoryManager : public llvm::SectionMemoryManager {
     return symbol;
   }
 
+  // Resolve the given symbol to the given address, rather than looking it up
+  void AddSymbol(const std::string &name, void *address) {
+    symbols_[name] = {reinterpret_cast<uint64_t>(address), llvm::JITSymbolFlags::Exported};
+  }
+
  private:
   std::unordered_map<std::string, llvm::JITEvaluatedSymbol> symbols_;
 };
@@ -399,6 +530,9 @@ class LLVMEngine::CompiledModuleBuilder {
   // Given a bytecode, lookup it's LLVM function handler in the module
   llvm::Function *LookupBytecodeHandler(Bytecode bytecode) const;
 
+  // Is the function linked to an existing implementation rather than compiled?
+  bool IsLinked(const FunctionInfo &func_info) const;
+
   // Generate an in-memory shared object from this LLVM module. It iss assumed
   // that all functions have been generated and verified.
   std::unique_ptr<llvm::MemoryBuffer> EmitObject();
@@ -479,11 +613,28 @@ LLVMEngine::CompiledModuleBuilder::CompiledModuleBuilder(const CompilerOptions &
 
     EXECUTION_LOG_TRACE("LLVM: Discovered CPU features: {}", target_features.getString());
 
-    // Both relocation=PIC or JIT=true work. Use the latter for now.
+    // Both relocation=PIC or JIT=true work. Use the latter for now. Code generation optimizes as much as the IR
+    // passes do, so level 0 gets the fast instruction selector and no code generation optimizations at all.
     llvm::TargetOptions target_options;
     llvm::Optional<llvm::Reloc::Model> reloc;
-    target_machine_.reset(target->createTargetMachine(
-        target_triple, llvm::sys::getHostCPUName(), target_features.getString(), target_options, reloc, {}, {}, true));
+    llvm::CodeGenOpt::Level codegen_opt_level;
+    switch (options.GetOptLevel()) {
+      case 0:
+        codegen_opt_level = llvm::CodeGenOpt::None;
+        break;
+      case 1:
+        codegen_opt_level = llvm::CodeGenOpt::Less;
+        break;
+      case 2:
+        codegen_opt_level = llvm::CodeGenOpt::Default;
+        break;
+      default:
+        codegen_opt_level = llvm::CodeGenOpt::Aggressive;
+        break;
+    }
+    target_machine_.reset(target->createTargetMachine(target_triple, llvm::sys::getHostCPUName(),
+                                                      target_features.getString(), target_options, reloc, {},
+                                                      codegen_opt_level, true));
     TERRIER_ASSERT(target_machine_ != nullptr, "LLVM: Unable to find a suitable target machine!");
   }
 
@@ -517,6 +668,10 @@ LLVMEngine::CompiledModuleBuilder::CompiledModuleBuilder(const CompilerOptions &
   type_map_ = std::make_unique<TypeMap>(llvm_module_.get());
 }
 
+bool LLVMEngine::CompiledModuleBuilder::IsLinked(const FunctionInfo &func_info) const {
+  return Options().GetLinkedFunctions().count(func_info.Name()) != 0;
+}
+
 void LLVMEngine::CompiledModuleBuilder::DeclareFunctions() {
   for (const auto &func_info : tpl_module_.Functions()) {
     auto *func_type = llvm::cast<llvm::FunctionType>(GetTypeMap()->GetLLVMType(func_info.FuncType()));
@@ -644,12 +799,45 @@ void LLVMEngine::CompiledModuleBuilder::DefineFunction(const FunctionInfo &func_
 
   FunctionLocalsMap locals_map(func_info, func, GetTypeMap(), ir_builder);
 
+  //
+  // If the function's hotness is counted, the counter is an external variable
+  // that is incremented on entry and on every backward jump, i.e., loop
+  // iteration, just like the interpreter counts it.
+  //
+
+  llvm::GlobalVariable *hotness_counter = nullptr;
+  if (Options().GetHotnessCounters().count(func_info.Name()) != 0) {
+    hotness_counter = new llvm::GlobalVariable(*Module(), GetTypeMap()->Int64Type(), false,
+                                               llvm::GlobalValue::ExternalLinkage, nullptr,
+                                               HotnessCounterName(func_info.Name()));
+  }
+  const auto count_hotness = [&]() {
+    if (hotness_counter != nullptr) {
+      ir_builder->CreateAtomicRMW(llvm::AtomicRMWInst::Add, hotness_counter,
+                                  llvm::ConstantInt::get(GetTypeMap()->Int64Type(), 1),
+                                  llvm::AtomicOrdering::Monotonic);
+    }
+  };
+  count_hotness();
+
   for (auto iter = TplModule().BytecodeForFunction(func_info); !iter.Done(); iter.Advance()) {
     Bytecode bytecode = iter.CurrentBytecode();
 
+    // Data the bytecode points to is referred to through an external symbol, see LinkedSymbols()
+    uint32_t data_operand_index;
+    const bool has_data_operand = GetDataOperand(bytecode, &data_operand_index) &&
+                                  GetDataAddress(iter, data_operand_index) != nullptr;
+
     // Collect arguments
     llvm::SmallVector<llvm::Value *, 8> args;
     for (uint32_t i = 0; i < Bytecodes::NumOperands(bytecode); i++) {
+      if (has_data_operand && i == data_operand_index) {
+        args.push_back(new llvm::GlobalVariable(*Module(), GetTypeMap()->Int8Type(), true,
+                                                llvm::GlobalValue::ExternalLinkage, nullptr,
+                                                DataSymbolName(func_info.Name(), iter.GetPosition())));
+        continue;
+      }
+
       switch (Bytecodes::GetNthOperandType(bytecode, i)) {
         case OperandType::None: {
           break;
@@ -716,7 +904,8 @@ void LLVMEngine::CompiledModuleBuilder::DefineFunction(const FunctionInfo &func_
       }
     }
 
-    const auto issue_call = [&ir_builder](auto *func, auto &args) {
+    // Calls go to the given target instead of the function if there is one, see CompilerOptions::SetFunctionSlots()
+    const auto issue_call = [&ir_builder](auto *func, auto &args, llvm::Value *target = nullptr) {
       auto arg_iter = func->arg_begin();
       for (uint32_t i = 0; i < args.size(); ++i, ++arg_iter) {
         llvm::Type *expected_type = arg_iter->getType();
@@ -737,6 +926,7 @@ void LLVMEngine::CompiledModuleBuilder::DefineFunction(const FunctionInfo &func_
           args[i] = ir_builder->CreateBitCast(args[i], expected_type);
         }
       }
+      if (target != nullptr) return ir_builder->CreateCall(func->getFunctionType(), target, args);
       return ir_builder->CreateCall(func, args);
     };
 
@@ -759,13 +949,24 @@ void LLVMEngine::CompiledModuleBuilder::DefineFunction(const FunctionInfo &func_
         llvm::Function *callee = Module()->getFunction(callee_func_info->Name());
         args.erase(args.begin());
 
+        // A callee with a slot is called through whatever implementation the slot holds at the time of the call
+        llvm::Value *target = nullptr;
+        if (Options().GetFunctionSlots().count(callee_func_info->Name()) != 0) {
+          llvm::Constant *slot = Module()->getOrInsertGlobal(FunctionSlotName(callee_func_info->Name()),
+                                                             callee->getType());
+          llvm::LoadInst *impl = ir_builder->CreateAlignedLoad(callee->getType(), slot, sizeof(void *));
+          impl->setAtomic(llvm::AtomicOrdering::Acquire);
+          target = impl;
+        }
+        TERRIER_ASSERT(target != nullptr || !IsLinked(*callee_func_info), "Linked functions are called through slots.");
+
         if (FunctionHasDirectReturn(callee_func_info->FuncType())) {
           llvm::Value *dest = args[0];
           args.erase(args.begin());
-          llvm::Value *ret = issue_call(callee, args);
+          llvm::Value *ret = issue_call(callee, args, target);
           ir_builder->CreateStore(ret, dest);
         } else {
-          issue_call(callee, args);
+          issue_call(callee, args, target);
         }
 
         break;
@@ -783,6 +984,9 @@ void LLVMEngine::CompiledModuleBuilder::DefineFunction(const FunctionInfo &func_
         std::size_t branch_target_bb_pos =
             iter.GetPosition() + Bytecodes::GetNthOperandOffset(bytecode, 0) + iter.GetJumpOffsetOperand(0);
         TERRIER_ASSERT(blocks[branch_target_bb_pos] != nullptr, "Branch target does not point to valid basic block");
+        if (iter.GetJumpOffsetOperand(0) < 0) {
+          count_hotness();
+        }
         ir_builder->CreateBr(blocks[branch_target_bb_pos]);
         break;
       }
@@ -858,7 +1062,10 @@ void LLVMEngine::CompiledModuleBuilder::DefineFunctions() {
 
   llvm::IRBuilder<> ir_builder(GetContext());
   for (const auto &func_info : TplModule().Functions()) {
-    DefineFunction(func_info, &ir_builder);
+    // Linked functions are only declared
+    if (!IsLinked(func_info)) {
+      DefineFunction(func_info, &ir_builder);
+    }
   }
 }
 
@@ -893,6 +1100,7 @@ void LLVMEngine::CompiledModuleBuilder::Optimize() {
   //
 
   llvm::PassManagerBuilder pm_builder;
+  pm_builder.OptLevel = Options().GetOptLevel();
   pm_builder.Inliner = llvm::createFunctionInliningPass(3, 0, false);
 
   //
@@ -921,8 +1129,10 @@ void LLVMEngine::CompiledModuleBuilder::Optimize() {
 
   function_pm.doInitialization();
   for (const auto &func_info : TplModule().Functions()) {
-    auto *func = Module()->getFunction(func_info.Name());
-    function_pm.run(*func);
+    if (!IsLinked(func_info)) {
+      auto *func = Module()->getFunction(func_info.Name());
+      function_pm.run(*func);
+    }
   }
   function_pm.doFinalization();
 
@@ -940,7 +1150,7 @@ std::unique_ptr<LLVMEngine::CompiledModule> LLVMEngine::CompiledModuleBuilder::F
     PersistObjectToFile(*obj);
   }
 
-  return std::make_unique<CompiledModule>(std::move(obj));
+  return std::make_unique<CompiledModule>(std::move(obj), LinkedSymbols(TplModule(), Options()));
 }
 
 std::unique_ptr<llvm::MemoryBuffer> LLVMEngine::CompiledModuleBuilder::EmitObject() {
@@ -1007,10 +1217,15 @@ std::string LLVMEngine::CompiledModuleBuilder::DumpModuleAsm() {
 // Compiled Module
 // ---------------------------------------------------------
 
-LLVMEngine::CompiledModule::CompiledModule(std::unique_ptr<llvm::MemoryBuffer> object_code)
+LLVMEngine::CompiledModule::CompiledModule(std::unique_ptr<llvm::MemoryBuffer> object_code,
+                                           const std::unordered_map<std::string, void *> &linked_symbols)
     : loaded_(false),
       object_code_(std::move(object_code)),
-      memory_manager_(std::make_unique<LLVMEngine::TPLMemoryManager>()) {}
+      memory_manager_(std::make_unique<LLVMEngine::TPLMemoryManager>()) {
+  for (const auto &[name, address] : linked_symbols) {
+    memory_manager_->AddSymbol(name, address);
+  }
+}
 
 // This destructor is needed because we have a unique_ptr to a forward-declared
 // TPLMemoryManager class.
@@ -1083,6 +1298,7 @@ void LLVMEngine::CompiledModule::Load(const BytecodeModule &module) {
   //
 
   for (const auto &func : module.Functions()) {
+    // Functions that were linked rather than compiled have no symbol, and map to null
     auto symbol = loader.getSymbol(func.Name());
     if (symbol.getAddress() == 0) {
       // Needed for mac
@@ -1099,6 +1315,8 @@ void LLVMEngine::CompiledModule::Load(const BytecodeModule &module) {
 // LLVM Engine
 // ---------------------------------------------------------
 
+ObjectCache *LLVMEngine::object_cache_ = nullptr;
+
 void LLVMEngine::Initialize() {
   // Global LLVM initialization
   llvm::InitializeNativeTarget();
@@ -1111,8 +1329,76 @@ void LLVMEngine::Initialize() {
 
 void LLVMEngine::Shutdown() { llvm::llvm_shutdown(); }
 
+std::string LLVMEngine::Fingerprint(const BytecodeModule &module, const CompilerOptions &options) {
+  // Neither changes while the process runs
+  static const std::string host_target = HostTarget();
+  static const std::string handlers_version = HandlersVersion(options.GetBytecodeHandlersBcPath());
+
+  std::string fingerprint;
+  AppendString(&fingerprint, host_target);
+  AppendString(&fingerprint, handlers_version);
+  AppendBytes(&fingerprint, options.GetOptLevel());
+  AppendBytes(&fingerprint, module.NumFunctions());
+  for (const auto &func_info : module.Functions()) {
+    AppendString(&fingerprint, func_info.Name());
+    AppendBytes(&fingerprint, func_info.Id());
+    AppendBytes(&fingerprint, options.GetLinkedFunctions().count(func_info.Name()) != 0);
+    // Where slots are doesn't matter, since their loads are relocated when the code is loaded
+    AppendBytes(&fingerprint, options.GetFunctionSlots().count(func_info.Name()) != 0);
+    // The same goes for hotness counters, which are accessed through relocations too
+    AppendBytes(&fingerprint, options.GetHotnessCounters().count(func_info.Name()) != 0);
+    AppendString(&fingerprint, ast::Type::ToString(func_info.FuncType()));
+    AppendBytes(&fingerprint, func_info.FrameSize());
+    AppendBytes(&fingerprint, func_info.ParamsStartPos());
+    AppendBytes(&fingerprint, func_info.ParamsSize());
+    AppendBytes(&fingerprint, func_info.Locals().size());
+    for (const auto &local : func_info.Locals()) {
+      AppendString(&fingerprint, local.Name());
+      AppendString(&fingerprint, ast::Type::ToString(local.GetType()));
+      AppendBytes(&fingerprint, local.Offset());
+      AppendBytes(&fingerprint, local.Size());
+      AppendBytes(&fingerprint, local.IsParameter());
+    }
+    // NOLINTNEXTLINE
+    const auto [start, end] = func_info.BytecodeRange();
+    AppendBytes(&fingerprint, end - start);
+    // The addresses of the data that bytecodes point to are linked too, but the compiled code depends on the data
+    std::string bytecode(reinterpret_cast<const char *>(module.GetBytecodeForFunction(func_info)), end - start);
+    std::string data;
+    for (auto iter = module.BytecodeForFunction(func_info); !iter.Done(); iter.Advance()) {
+      uint32_t operand_index;
+      if (GetDataOperand(iter.CurrentBytecode(), &operand_index)) {
+        const auto offset = iter.GetPosition() + Bytecodes::GetNthOperandOffset(iter.CurrentBytecode(), operand_index);
+        std::fill_n(bytecode.begin() + offset, sizeof(uintptr_t), '\0');
+        AppendData(&data, iter, operand_index);
+      }
+    }
+    fingerprint.append(bytecode);
+    AppendString(&fingerprint, data);
+  }
+  return fingerprint;
+}
+
 std::unique_ptr<LLVMEngine::CompiledModule> LLVMEngine::Compile(const BytecodeModule &module,
                                                                 const CompilerOptions &options) {
+  //
+  // The same module may have been compiled before, by this or an earlier run of the system. If so, we load its
+  // machine code instead of generating it again.
+  //
+
+  ObjectCache *object_cache = GetObjectCache();
+  std::string fingerprint;
+  if (object_cache != nullptr) {
+    fingerprint = Fingerprint(module, options);
+    if (auto object_code = object_cache->Lookup(fingerprint)) {
+      auto compiled_module = std::make_unique<CompiledModule>(std::move(object_code), LinkedSymbols(module, options));
+      compiled_module->Load(module);
+      if (compiled_module->IsLoaded()) {
+        return compiled_module;
+      }
+    }
+  }
+
   CompiledModuleBuilder builder(options, module);
 
   builder.DeclareFunctions();
@@ -1123,10 +1409,16 @@ std::unique_ptr<LLVMEngine::CompiledModule> LLVMEngine::Compile(const BytecodeMo
 
   builder.Verify();
 
-  builder.Optimize();
+  if (options.GetOptLevel() > 0) {
+    builder.Optimize();
+  }
 
   auto compiled_module = builder.Finalize();
 
+  if (object_cache != nullptr) {
+    object_cache->Insert(fingerprint, compiled_module->GetModuleObjectCode());
+  }
+
   compiled_module->Load(module);
 
   return compiled_module;
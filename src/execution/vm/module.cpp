@@ -4,9 +4,13 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "common/constants.h"
+#include "loggers/execution_logger.h"
 
 #define XBYAK_NO_OP_NAMES
 #include "xbyak/xbyak.h"
@@ -20,19 +24,40 @@ namespace terrier::execution::vm {
 // This class encapsulates the ability to asynchronously JIT compile a module.
 class Module::AsyncCompileTask : public tbb::task {
  public:
-  // Construct an asynchronous compilation task to compile the the module
-  explicit AsyncCompileTask(Module *module) : module_(module) {}
+  // Construct an asynchronous compilation task to compile the the module. If
+  // only_hot_functions is set, the module is already compiled and only its hot
+  // functions get recompiled.
+  AsyncCompileTask(Module *module, bool only_hot_functions)
+      : module_(module), only_hot_functions_(only_hot_functions) {}
 
   // Execute
   tbb::task *execute() override {
-    // This simply invokes Module::CompileToMachineCode() asynchronously.
-    module_->CompileToMachineCode();
+    // Compilations that haven't started when the module is destroyed are
+    // cancelled
+    if (!module_->shutting_down_.load(std::memory_order_acquire)) {
+      Compile();
+    }
+    // The module may be destroyed as soon as it learns we're done
+    module_->FinishCompileTask();
     // Done. There's no next task, so return null.
     return nullptr;
   }
 
  private:
+  void Compile() {
+    // Functions may already be hot by the time the baseline is ready, unless
+    // another task is compiling them
+    if (!only_hot_functions_) {
+      module_->CompileBaseline();
+      if (module_->compiling_hot_functions_.exchange(true)) {
+        return;
+      }
+    }
+    module_->CompileHotFunctions();
+  }
+
   Module *module_;
+  bool only_hot_functions_;
 };
 
 // ---------------------------------------------------------
@@ -45,7 +70,9 @@ Module::Module(std::unique_ptr<BytecodeModule> bytecode_module, std::unique_ptr<
     : bytecode_module_(std::move(bytecode_module)),
       jit_module_(std::move(llvm_module)),
       functions_(std::make_unique<std::atomic<void *>[]>(bytecode_module_->NumFunctions())),
-      bytecode_trampolines_(std::make_unique<Trampoline[]>(bytecode_module_->NumFunctions())) {
+      bytecode_trampolines_(std::make_unique<Trampoline[]>(bytecode_module_->NumFunctions())),
+      tiers_(std::make_unique<std::atomic<Tier>[]>(bytecode_module_->NumFunctions())),
+      hotness_(std::make_unique<std::atomic<uint64_t>[]>(bytecode_module_->NumFunctions())) {
   // Create the trampolines for all bytecode functions
   for (const auto &func : bytecode_module_->Functions()) {
     CreateFunctionTrampoline(func.Id());
@@ -57,14 +84,27 @@ Module::Module(std::unique_ptr<BytecodeModule> bytecode_module, std::unique_ptr<
     const auto num_functions = bytecode_module_->NumFunctions();
     for (uint32_t idx = 0; idx < num_functions; idx++) {
       functions_[idx] = bytecode_trampolines_[idx].Code();
+      tiers_[idx] = Tier::Bytecode;
     }
   } else {
     const auto num_functions = bytecode_module_->NumFunctions();
     for (uint32_t idx = 0; idx < num_functions; idx++) {
       auto func_info = bytecode_module_->GetFuncInfoById(static_cast<uint16_t>(idx));
       functions_[idx] = jit_module_->GetFunctionPointer(func_info->Name());
+      tiers_[idx] = Tier::Optimized;
     }
   }
+
+  for (uint32_t idx = 0; idx < bytecode_module_->NumFunctions(); idx++) {
+    hotness_[idx] = 0;
+  }
+}
+
+Module::~Module() {
+  // Background compilations use the module, and install code into it
+  shutting_down_.store(true, std::memory_order_release);
+  std::unique_lock<std::mutex> lock(compile_tasks_mutex_);
+  compile_tasks_cv_.wait(lock, [this] { return num_compile_tasks_ == 0; });
 }
 
 namespace {
@@ -280,17 +320,140 @@ void Module::CompileToMachineCode() {
     jit_module_ = LLVMEngine::Compile(*bytecode_module_, options);
 
     // Setup function pointers
+    InstallFunctions(*jit_module_, Tier::Optimized);
+  });
+}
+
+void Module::CompileToMachineCodeAsync() { EnqueueCompileTask(false); }
+
+void Module::EnqueueCompileTask(const bool only_hot_functions) {
+  {
+    std::lock_guard<std::mutex> guard(compile_tasks_mutex_);
+    num_compile_tasks_++;
+  }
+  auto *compile_task = new (tbb::task::allocate_root()) AsyncCompileTask(this, only_hot_functions);
+  tbb::task::enqueue(*compile_task);
+}
+
+void Module::FinishCompileTask() {
+  // Notify while holding the lock, so the module outlives the notification
+  std::lock_guard<std::mutex> guard(compile_tasks_mutex_);
+  num_compile_tasks_--;
+  compile_tasks_cv_.notify_all();
+}
+
+// Machine code increments the hotness counters and loads the function slots like plain integers and pointers
+static_assert(std::atomic<uint64_t>::is_always_lock_free && sizeof(std::atomic<uint64_t>) == sizeof(uint64_t));
+static_assert(std::atomic<void *>::is_always_lock_free && sizeof(std::atomic<void *>) == sizeof(void *));
+
+void Module::CompileBaseline() {
+  std::call_once(baseline_flag_, [this]() {
+    // Compile as quickly as possible, the hot functions are optimized later.
+    // The machine code keeps counting how hot the functions are, and calls functions through their slots so that it
+    // picks up their optimized code once it is installed.
+    std::unordered_map<std::string, void *> function_slots;
+    std::unordered_map<std::string, void *> hotness_counters;
     for (const auto &func_info : bytecode_module_->Functions()) {
-      auto *jit_function = jit_module_->GetFunctionPointer(func_info.Name());
-      TERRIER_ASSERT(jit_function != nullptr, "Missing function in compiled module!");
-      functions_[func_info.Id()].store(jit_function, std::memory_order_relaxed);
+      function_slots[func_info.Name()] = &functions_[func_info.Id()];
+      hotness_counters[func_info.Name()] = &hotness_[func_info.Id()];
     }
+    LLVMEngine::CompilerOptions options;
+    options.SetOptLevel(0).SetFunctionSlots(std::move(function_slots)).SetHotnessCounters(std::move(hotness_counters));
+    baseline_module_ = LLVMEngine::Compile(*bytecode_module_, options);
+    InstallFunctions(*baseline_module_, Tier::Baseline);
+    baseline_ready_ = true;
   });
 }
 
-void Module::CompileToMachineCodeAsync() {
-  auto *compile_task = new (tbb::task::allocate_root()) AsyncCompileTask(this);
-  tbb::task::enqueue(*compile_task);
+void Module::CompileHotFunctions() {
+  const auto is_uncompiled_hot_function = [this](const FunctionId func_id) {
+    return GetHotness(func_id) >= K_HOT_THRESHOLD && tiers_[func_id] != Tier::Optimized;
+  };
+
+  while (true) {
+    // Stop between compilations when the module is being destroyed
+    if (shutting_down_.load(std::memory_order_acquire)) {
+      compiling_hot_functions_ = false;
+      return;
+    }
+
+    // Hot functions are compiled on their own and call each other directly, so that they can be inlined. Calls to
+    // the other functions go through their slots.
+    std::vector<FunctionId> hot_functions;
+    std::unordered_set<std::string> linked_functions;
+    std::unordered_map<std::string, void *> function_slots;
+    for (const auto &func_info : bytecode_module_->Functions()) {
+      if (is_uncompiled_hot_function(func_info.Id())) {
+        hot_functions.push_back(func_info.Id());
+      } else {
+        linked_functions.insert(func_info.Name());
+        function_slots[func_info.Name()] = &functions_[func_info.Id()];
+      }
+    }
+
+    if (hot_functions.empty()) {
+      compiling_hot_functions_ = false;
+      // A function may have turned hot since we looked, and left its compilation to us because we were still running
+      bool turned_hot = false;
+      for (const auto &func_info : bytecode_module_->Functions()) {
+        turned_hot = turned_hot || is_uncompiled_hot_function(func_info.Id());
+      }
+      if (!turned_hot || compiling_hot_functions_.exchange(true)) {
+        return;
+      }
+      continue;
+    }
+
+    EXECUTION_LOG_DEBUG("Optimizing {} hot functions of module '{}'", hot_functions.size(), bytecode_module_->Name());
+    LLVMEngine::CompilerOptions options;
+    options.SetOptLevel(3).SetLinkedFunctions(std::move(linked_functions)).SetFunctionSlots(std::move(function_slots));
+    auto hot_module = LLVMEngine::Compile(*bytecode_module_, options);
+    InstallFunctions(*hot_module, Tier::Optimized);
+    std::lock_guard<std::mutex> guard(install_mutex_);
+    hot_modules_.push_back(std::move(hot_module));
+  }
+}
+
+void Module::CompileHotFunctionsAsync() const {
+  if (compiling_hot_functions_.exchange(true)) return;
+  // Compiling doesn't change what the module computes, only how fast
+  const_cast<Module *>(this)->EnqueueCompileTask(true);  // NOLINT
+}
+
+void Module::CheckHotFunctions() const {
+  if (!baseline_ready_.load(std::memory_order_acquire) || compiling_hot_functions_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  for (const auto &func_info : bytecode_module_->Functions()) {
+    const FunctionId func_id = func_info.Id();
+    if (GetHotness(func_id) >= K_HOT_THRESHOLD && tiers_[func_id].load(std::memory_order_relaxed) != Tier::Optimized) {
+      CompileHotFunctionsAsync();
+      return;
+    }
+  }
+}
+
+void Module::RecordInvocation(const FunctionId func_id, const uint64_t loop_iterations) const {
+  const uint64_t heat = 1 + loop_iterations;
+  const uint64_t hotness = hotness_[func_id].fetch_add(heat, std::memory_order_relaxed) + heat;
+  // Hot functions are recompiled once the other functions have baseline machine code to link to
+  if (hotness >= K_HOT_THRESHOLD && baseline_ready_.load(std::memory_order_acquire) &&
+      tiers_[func_id].load(std::memory_order_relaxed) != Tier::Optimized &&
+      !compiling_hot_functions_.load(std::memory_order_relaxed)) {
+    CompileHotFunctionsAsync();
+  }
+}
+
+void Module::InstallFunctions(const LLVMEngine::CompiledModule &compiled_module, const Tier tier) {
+  std::lock_guard<std::mutex> guard(install_mutex_);
+  for (const auto &func_info : bytecode_module_->Functions()) {
+    // Linked functions aren't in the module
+    auto *jit_function = compiled_module.GetFunctionPointer(func_info.Name());
+    if (jit_function != nullptr && tiers_[func_info.Id()] < tier) {
+      functions_[func_info.Id()].store(jit_function, std::memory_order_release);
+      tiers_[func_info.Id()] = tier;
+    }
+  }
 }
 
 }  // namespace terrier::execution::vm
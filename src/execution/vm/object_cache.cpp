@@ -0,0 +1,218 @@
+#include "execution/vm/object_cache.h"
+
+#include <sys/time.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "execution/util/hash.h"
+#include "loggers/execution_logger.h"
+
+namespace terrier::execution::vm {
+
+namespace {
+
+// Every file starts with a header, followed by the fingerprint and then the object code at the given offset
+struct Header {
+  char magic_[8];
+  uint64_t fingerprint_size_;
+  uint64_t object_offset_;
+};
+
+constexpr char K_MAGIC[8] = {'T', 'P', 'L', 'O', 'B', 'J', '0', '1'};
+constexpr const char *K_EXTENSION = ".tpo";
+// Object files are parsed in place, so their start is aligned
+constexpr uint64_t K_OBJECT_ALIGNMENT = 16;
+
+hash_t HashFingerprint(const std::string &fingerprint) {
+  return util::Hasher::Hash<util::HashMethod::xxHash3>(fingerprint);
+}
+
+// Parse the hash out of the name of an entry, returning false if the file is not an entry
+bool ParseFileName(llvm::StringRef file_name, hash_t *hash) {
+  if (!file_name.endswith(K_EXTENSION)) return false;
+  file_name = file_name.drop_back(std::strlen(K_EXTENSION));
+  return file_name.size() == 2 * sizeof(hash_t) && !file_name.getAsInteger(16, *hash);
+}
+
+/**
+ * The object code of an entry, inside the buffer of the whole file
+ */
+class ObjectBuffer : public llvm::MemoryBuffer {
+ public:
+  ObjectBuffer(std::unique_ptr<llvm::MemoryBuffer> file, uint64_t offset) : file_(std::move(file)) {
+    init(file_->getBufferStart() + offset, file_->getBufferEnd(), false);
+  }
+
+  BufferKind getBufferKind() const override { return file_->getBufferKind(); }
+
+ private:
+  std::unique_ptr<llvm::MemoryBuffer> file_;
+};
+
+}  // namespace
+
+ObjectCache::ObjectCache(std::string directory, uint64_t capacity)
+    : directory_(std::move(directory)), capacity_(capacity) {
+  if (std::error_code error = llvm::sys::fs::create_directories(directory_)) {
+    EXECUTION_LOG_ERROR("ObjectCache: Error creating directory '{}': {}", directory_, error.message());
+    return;
+  }
+
+  // Pick up the entries of earlier runs, in the order they were last used
+  std::vector<std::pair<llvm::sys::TimePoint<>, hash_t>> found;
+  std::vector<uint64_t> sizes;
+  std::error_code error;
+  for (llvm::sys::fs::directory_iterator iter(directory_, error), end; iter != end && !error; iter.increment(error)) {
+    hash_t hash;
+    if (!ParseFileName(llvm::sys::path::filename(iter->path()), &hash)) continue;
+    llvm::sys::fs::file_status status;
+    if (llvm::sys::fs::status(iter->path(), status) || !llvm::sys::fs::is_regular_file(status)) continue;
+    found.emplace_back(status.getLastModificationTime(), hash);
+    sizes.push_back(status.getSize());
+  }
+  if (error) EXECUTION_LOG_ERROR("ObjectCache: Error reading directory '{}': {}", directory_, error.message());
+
+  std::vector<uint32_t> order(found.size());
+  for (uint32_t i = 0; i < order.size(); i++) order[i] = i;
+  std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return found[a].first < found[b].first; });
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  for (const auto i : order) Touch(found[i].second, sizes[i]);
+  while (size_ > capacity_) Erase(lru_.back());
+}
+
+std::unique_ptr<llvm::MemoryBuffer> ObjectCache::Lookup(const std::string &fingerprint) {
+  const hash_t hash = HashFingerprint(fingerprint);
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (entries_.find(hash) == entries_.end()) return nullptr;
+  }
+
+  // Large files are memory-mapped rather than read
+  const std::string path = PathFor(hash);
+  auto file = llvm::MemoryBuffer::getFile(path, -1, false);
+  if (std::error_code error = file.getError()) {
+    // Another process removed it
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (entries_.find(hash) != entries_.end()) Erase(hash);
+    return nullptr;
+  }
+
+  // Check that the entry is complete, and is for this fingerprint and not another one with the same hash
+  const auto &buffer = *file.get();
+  Header header;
+  bool valid = buffer.getBufferSize() >= sizeof(Header);
+  if (valid) {
+    std::memcpy(&header, buffer.getBufferStart(), sizeof(Header));
+    valid = std::memcmp(header.magic_, K_MAGIC, sizeof(K_MAGIC)) == 0 &&
+            header.fingerprint_size_ <= buffer.getBufferSize() - sizeof(Header) &&
+            header.object_offset_ >= sizeof(Header) + header.fingerprint_size_ &&
+            header.object_offset_ < buffer.getBufferSize();
+  }
+  if (!valid) {
+    EXECUTION_LOG_ERROR("ObjectCache: Removing corrupt entry '{}'", path);
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (entries_.find(hash) != entries_.end()) Erase(hash);
+    return nullptr;
+  }
+  if (llvm::StringRef(buffer.getBufferStart() + sizeof(Header), header.fingerprint_size_) != fingerprint) {
+    EXECUTION_LOG_DEBUG("ObjectCache: Hash collision on entry '{}'", path);
+    return nullptr;
+  }
+
+  // The modification time orders the entries by recency after a restart
+  ::utimes(path.c_str(), nullptr);
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (auto iter = entries_.find(hash); iter != entries_.end()) Touch(hash, iter->second.size_);
+  }
+  return std::make_unique<ObjectBuffer>(std::move(file.get()), header.object_offset_);
+}
+
+bool ObjectCache::Insert(const std::string &fingerprint, const llvm::MemoryBuffer &object_code) {
+  Header header;
+  std::memcpy(header.magic_, K_MAGIC, sizeof(K_MAGIC));
+  header.fingerprint_size_ = fingerprint.size();
+  header.object_offset_ = (sizeof(Header) + fingerprint.size() + K_OBJECT_ALIGNMENT - 1) & ~(K_OBJECT_ALIGNMENT - 1);
+  const uint64_t size = header.object_offset_ + object_code.getBufferSize();
+  if (size > capacity_) return false;
+
+  // Write to a temporary file first, so that nobody ever reads a partial entry
+  llvm::SmallString<128> model(directory_);
+  llvm::sys::path::append(model, "%%%%%%%%%%%%%%%%.tmp");
+  int fd;
+  llvm::SmallString<128> tmp_path;
+  if (std::error_code error = llvm::sys::fs::createUniqueFile(model, fd, tmp_path)) {
+    EXECUTION_LOG_ERROR("ObjectCache: Error creating file in '{}': {}", directory_, error.message());
+    return false;
+  }
+  {
+    llvm::raw_fd_ostream out(fd, true);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+    out << fingerprint;
+    out.write_zeros(header.object_offset_ - sizeof(Header) - fingerprint.size());
+    out << object_code.getBuffer();
+    out.close();
+    if (out.has_error()) {
+      EXECUTION_LOG_ERROR("ObjectCache: Error writing file '{}'", tmp_path.str().str());
+      out.clear_error();
+      llvm::sys::fs::remove(tmp_path);
+      return false;
+    }
+  }
+
+  const hash_t hash = HashFingerprint(fingerprint);
+  if (std::error_code error = llvm::sys::fs::rename(tmp_path, PathFor(hash))) {
+    EXECUTION_LOG_ERROR("ObjectCache: Error renaming file '{}': {}", tmp_path.str().str(), error.message());
+    llvm::sys::fs::remove(tmp_path);
+    return false;
+  }
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  Touch(hash, size);
+  // The new entry fits on its own, so it is never evicted here
+  while (size_ > capacity_) Erase(lru_.back());
+  return true;
+}
+
+std::string ObjectCache::PathFor(const hash_t hash) const {
+  // Pad the hash so that every name has the same length
+  char name[2 * sizeof(hash_t) + 1];
+  std::snprintf(name, sizeof(name), "%016" PRIx64, static_cast<uint64_t>(hash));
+  llvm::SmallString<128> path(directory_);
+  llvm::sys::path::append(path, llvm::Twine(name) + K_EXTENSION);
+  return path.str().str();
+}
+
+void ObjectCache::Touch(const hash_t hash, const uint64_t size) {
+  if (auto iter = entries_.find(hash); iter != entries_.end()) {
+    size_ -= iter->second.size_;
+    lru_.erase(iter->second.lru_pos_);
+  }
+  lru_.push_front(hash);
+  entries_[hash] = Entry{size, lru_.begin()};
+  size_ += size;
+}
+
+void ObjectCache::Erase(const hash_t hash) {
+  auto iter = entries_.find(hash);
+  TERRIER_ASSERT(iter != entries_.end(), "Erasing an entry that isn't cached");
+  llvm::sys::fs::remove(PathFor(hash));
+  size_ -= iter->second.size_;
+  lru_.erase(iter->second.lru_pos_);
+  entries_.erase(iter);
+}
+
+}  // namespace terrier::execution::vm
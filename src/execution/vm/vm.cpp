@@ -123,6 +123,7 @@ void VM::InvokeFunction(const Module *module, const FunctionId func_id, const ui
   TERRIER_ASSERT(bytecode != nullptr, "Bytecode cannot be null");
   Frame frame(raw_frame, frame_size);
   vm.Interpret(bytecode, &frame);
+  module->RecordInvocation(func_id, vm.loop_iterations_);
 
   // Cleanup
   if (used_heap) {
@@ -335,6 +336,8 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
   OP(Jump) : {
     auto skip = PEEK_JMP_OFFSET();
     if (LIKELY(OpJump())) {
+      // Loops jump back to their condition
+      loop_iterations_ += static_cast<uint64_t>(skip < 0);
       ip += skip;
     }
     DISPATCH_NEXT();
@@ -683,6 +686,14 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
   GEN_PCI_ACCESS(Varlen, sql::StringVal)
 #undef GEN_PCI_ACCESS
 
+  OP(PCIGetComputed) : {
+    auto *result = frame->LocalAt<sql::Integer *>(READ_LOCAL_ID());
+    auto *pci = frame->LocalAt<sql::ProjectedColumnsIterator *>(READ_LOCAL_ID());
+    auto col_idx = READ_UIMM2();
+    OpPCIGetComputed(result, pci, col_idx);
+    DISPATCH_NEXT();
+  }
+
 #define GEN_PCI_FILTER(Op)                                                         \
   OP(PCIFilter##Op) : {                                                            \
     auto *size = frame->LocalAt<uint64_t *>(READ_LOCAL_ID());                      \
@@ -701,6 +712,69 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
   GEN_PCI_FILTER(NotEqual)
 #undef GEN_PCI_FILTER
 
+#define GEN_PCI_STRING_FILTER(Op)                                                  \
+  OP(PCIFilter##Op) : {                                                            \
+    auto *size = frame->LocalAt<uint64_t *>(READ_LOCAL_ID());                      \
+    auto *iter = frame->LocalAt<sql::ProjectedColumnsIterator *>(READ_LOCAL_ID()); \
+    auto col_idx = READ_UIMM4();                                                   \
+    auto length = static_cast<uint64_t>(READ_IMM8());                              \
+    auto data = static_cast<uintptr_t>(READ_IMM8());                               \
+    OpPCIFilter##Op(size, iter, col_idx, length, data);                            \
+    DISPATCH_NEXT();                                                               \
+  }
+  GEN_PCI_STRING_FILTER(StringEqual)
+  GEN_PCI_STRING_FILTER(StringGreaterThan)
+  GEN_PCI_STRING_FILTER(StringGreaterThanEqual)
+  GEN_PCI_STRING_FILTER(StringLessThan)
+  GEN_PCI_STRING_FILTER(StringLessThanEqual)
+  GEN_PCI_STRING_FILTER(StringNotEqual)
+#undef GEN_PCI_STRING_FILTER
+
+#define GEN_PCI_LIKE_FILTER(Op)                                                    \
+  OP(PCIFilter##Op) : {                                                            \
+    auto *size = frame->LocalAt<uint64_t *>(READ_LOCAL_ID());                      \
+    auto *iter = frame->LocalAt<sql::ProjectedColumnsIterator *>(READ_LOCAL_ID()); \
+    auto col_idx = READ_UIMM4();                                                   \
+    auto pattern = static_cast<uintptr_t>(READ_IMM8());                            \
+    OpPCIFilter##Op(size, iter, col_idx, pattern);                                 \
+    DISPATCH_NEXT();                                                               \
+  }
+  GEN_PCI_LIKE_FILTER(Like)
+  GEN_PCI_LIKE_FILTER(NotLike)
+#undef GEN_PCI_LIKE_FILTER
+
+#define GEN_PCI_COMPUTE(Op)                                                        \
+  OP(PCICompute##Op) : {                                                           \
+    auto *iter = frame->LocalAt<sql::ProjectedColumnsIterator *>(READ_LOCAL_ID()); \
+    auto out_idx = READ_UIMM4();                                                   \
+    auto col_idx_1 = READ_UIMM4();                                                 \
+    auto type_1 = READ_IMM1();                                                     \
+    auto col_idx_2 = READ_UIMM4();                                                 \
+    auto type_2 = READ_IMM1();                                                     \
+    OpPCICompute##Op(iter, out_idx, col_idx_1, type_1, col_idx_2, type_2);         \
+    DISPATCH_NEXT();                                                               \
+  }
+  GEN_PCI_COMPUTE(Add)
+  GEN_PCI_COMPUTE(Sub)
+  GEN_PCI_COMPUTE(Mul)
+#undef GEN_PCI_COMPUTE
+
+#define GEN_PCI_COMPUTE_VAL(Op)                                                    \
+  OP(PCICompute##Op) : {                                                           \
+    auto *iter = frame->LocalAt<sql::ProjectedColumnsIterator *>(READ_LOCAL_ID()); \
+    auto out_idx = READ_UIMM4();                                                   \
+    auto col_idx = READ_UIMM4();                                                   \
+    auto type = READ_IMM1();                                                       \
+    auto val = READ_IMM8();                                                        \
+    OpPCICompute##Op(iter, out_idx, col_idx, type, val);                           \
+    DISPATCH_NEXT();                                                               \
+  }
+  GEN_PCI_COMPUTE_VAL(AddVal)
+  GEN_PCI_COMPUTE_VAL(SubVal)
+  GEN_PCI_COMPUTE_VAL(MulVal)
+  GEN_PCI_COMPUTE_VAL(ValSub)
+#undef GEN_PCI_COMPUTE_VAL
+
   // ------------------------------------------------------
   // Hashing
   // ------------------------------------------------------
@@ -1022,6 +1096,7 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
     auto key_eq_fn_id = READ_FUNC_ID();
     auto init_agg_fn_id = READ_FUNC_ID();
     auto merge_agg_fn_id = READ_FUNC_ID();
+    auto partitioned = frame->LocalAt<bool>(READ_LOCAL_ID());
 
     auto hash_fn = reinterpret_cast<sql::AggregationHashTable::HashFn>(module_->GetRawFunctionImpl(hash_fn_id));
     auto key_eq_fn = reinterpret_cast<sql::AggregationHashTable::KeyEqFn>(module_->GetRawFunctionImpl(key_eq_fn_id));
@@ -1029,7 +1104,8 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
         reinterpret_cast<sql::AggregationHashTable::InitAggFn>(module_->GetRawFunctionImpl(init_agg_fn_id));
     auto advance_agg_fn =
         reinterpret_cast<sql::AggregationHashTable::AdvanceAggFn>(module_->GetRawFunctionImpl(merge_agg_fn_id));
-    OpAggregationHashTableProcessBatch(agg_hash_table, iters, hash_fn, key_eq_fn, init_agg_fn, advance_agg_fn);
+    OpAggregationHashTableProcessBatch(agg_hash_table, iters, hash_fn, key_eq_fn, init_agg_fn, advance_agg_fn,
+                                       partitioned);
     DISPATCH_NEXT();
   }
 
@@ -1373,12 +1449,29 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
     auto *memory = frame->LocalAt<execution::sql::MemoryPool *>(READ_LOCAL_ID());
     auto cmp_func_id = READ_FUNC_ID();
     auto tuple_size = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    auto num_key_words = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
 
     auto cmp_fn = reinterpret_cast<sql::Sorter::ComparisonFunction>(module_->GetRawFunctionImpl(cmp_func_id));
-    OpSorterInit(sorter, memory, cmp_fn, tuple_size);
+    OpSorterInit(sorter, memory, cmp_fn, tuple_size, num_key_words);
     DISPATCH_NEXT();
   }
 
+#define GEN_SORTER_KEY(Name, SqlType)                                    \
+  OP(SorterKey##Name) : {                                                \
+    auto *key = frame->LocalAt<uint64_t *>(READ_LOCAL_ID());             \
+    auto *input = frame->LocalAt<const sql::SqlType *>(READ_LOCAL_ID()); \
+    auto descending = frame->LocalAt<bool>(READ_LOCAL_ID());             \
+    OpSorterKey##Name(key, input, descending);                           \
+    DISPATCH_NEXT();                                                     \
+  }
+  GEN_SORTER_KEY(Bool, BoolVal)
+  GEN_SORTER_KEY(Int, Integer)
+  GEN_SORTER_KEY(Real, Real)
+  GEN_SORTER_KEY(Date, DateVal)
+  GEN_SORTER_KEY(Timestamp, TimestampVal)
+  GEN_SORTER_KEY(String, StringVal)
+#undef GEN_SORTER_KEY
+
   OP(SorterAllocTuple) : {
     auto *result = frame->LocalAt<byte **>(READ_LOCAL_ID());
     auto *sorter = frame->LocalAt<sql::Sorter *>(READ_LOCAL_ID());
@@ -1500,12 +1593,36 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
     DISPATCH_NEXT();
   }
 
+  OP(IndexIteratorPerformInitCovering) : {
+    auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
+    OpIndexIteratorPerformInitCovering(iter);
+    DISPATCH_NEXT();
+  }
+
   OP(IndexIteratorScanKey) : {
     auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
     OpIndexIteratorScanKey(iter);
     DISPATCH_NEXT();
   }
 
+  OP(IndexIteratorAddKey) : {
+    auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
+    OpIndexIteratorAddKey(iter);
+    DISPATCH_NEXT();
+  }
+
+  OP(IndexIteratorScanKeys) : {
+    auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
+    OpIndexIteratorScanKeys(iter);
+    DISPATCH_NEXT();
+  }
+
+  OP(IndexIteratorScanNextKey) : {
+    auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
+    OpIndexIteratorScanNextKey(iter);
+    DISPATCH_NEXT();
+  }
+
   OP(IndexIteratorScanAscending) : {
     auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
     auto scan_type = frame->LocalAt<storage::index::ScanType>(READ_LOCAL_ID());
@@ -1514,6 +1631,14 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
     DISPATCH_NEXT();
   }
 
+  OP(IndexIteratorStreamAscending) : {
+    auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
+    auto scan_type = frame->LocalAt<storage::index::ScanType>(READ_LOCAL_ID());
+    auto limit = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    OpIndexIteratorStreamAscending(iter, scan_type, limit);
+    DISPATCH_NEXT();
+  }
+
   OP(IndexIteratorScanDescending) : {
     auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
     OpIndexIteratorScanDescending(iter);
@@ -1873,6 +1998,23 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {
     DISPATCH_NEXT();
   }
 
+  OP(Like) : {
+    auto *exec_ctx = frame->LocalAt<exec::ExecutionContext *>(READ_LOCAL_ID());
+    auto *result = frame->LocalAt<sql::BoolVal *>(READ_LOCAL_ID());
+    auto *str = frame->LocalAt<const sql::StringVal *>(READ_LOCAL_ID());
+    auto *pattern = frame->LocalAt<const sql::StringVal *>(READ_LOCAL_ID());
+    OpLike(exec_ctx, result, str, pattern);
+    DISPATCH_NEXT();
+  }
+
+  OP(LikeConstant) : {
+    auto *result = frame->LocalAt<sql::BoolVal *>(READ_LOCAL_ID());
+    auto *str = frame->LocalAt<const sql::StringVal *>(READ_LOCAL_ID());
+    auto pattern = static_cast<uintptr_t>(READ_IMM8());
+    OpLikeConstant(result, str, pattern);
+    DISPATCH_NEXT();
+  }
+
   OP(LPad) : {
     auto *exec_ctx = frame->LocalAt<exec::ExecutionContext *>(READ_LOCAL_ID());
     auto *result = frame->LocalAt<sql::StringVal *>(READ_LOCAL_ID());
@@ -2014,7 +2156,12 @@ const uint8_t *VM::ExecuteCall(const uint8_t *ip, VM::Frame *caller) {
   const uint8_t *bytecode = module_->GetBytecodeModule()->GetBytecodeForFunction(*func_info);
   TERRIER_ASSERT(bytecode != nullptr, "Bytecode cannot be null");
   VM::Frame callee(raw_frame, func_info->FrameSize());
+  // Loop iterations are counted for the innermost function only
+  const uint64_t caller_loop_iterations = loop_iterations_;
+  loop_iterations_ = 0;
   Interpret(bytecode, &callee);
+  module_->RecordInvocation(func_id, loop_iterations_);
+  loop_iterations_ = caller_loop_iterations;
 
   if (used_heap) {
     std::free(raw_frame);
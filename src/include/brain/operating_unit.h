@@ -24,6 +24,7 @@ class CompilerTest_MultiWayHashJoinTest_Test;
 class CompilerTest_SimpleNestedLoopJoinTest_Test;
 class CompilerTest_SimpleIndexNestedLoopJoinTest_Test;
 class CompilerTest_SimpleIndexNestedLoopJoinMultiColumnTest_Test;
+class CompilerTest_SimpleSetOpTest_Test;
 class CompilerTest_SimpleDeleteTest_Test;
 class CompilerTest_SimpleUpdateTest_Test;
 class CompilerTest_SimpleInsertTest_Test;
@@ -142,6 +143,7 @@ class PipelineOperatingUnits {
   friend class terrier::execution::compiler::test::CompilerTest_SimpleNestedLoopJoinTest_Test;
   friend class terrier::execution::compiler::test::CompilerTest_SimpleIndexNestedLoopJoinTest_Test;
   friend class terrier::execution::compiler::test::CompilerTest_SimpleIndexNestedLoopJoinMultiColumnTest_Test;
+  friend class terrier::execution::compiler::test::CompilerTest_SimpleSetOpTest_Test;
   friend class terrier::execution::compiler::test::CompilerTest_SimpleDeleteTest_Test;
   friend class terrier::execution::compiler::test::CompilerTest_SimpleUpdateTest_Test;
   friend class terrier::execution::compiler::test::CompilerTest_SimpleInsertTest_Test;
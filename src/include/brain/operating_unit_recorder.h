@@ -64,6 +64,7 @@ class OperatingUnitRecorder : planner::PlanVisitor {
   void Visit(const planner::OrderByPlanNode *plan) override;
   void Visit(const planner::ProjectionPlanNode *plan) override;
   void Visit(const planner::AggregatePlanNode *plan) override;
+  void Visit(const planner::SetOpPlanNode *plan) override;
 
   /**
    * Accumulate Feature Information
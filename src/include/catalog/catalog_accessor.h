@@ -360,6 +360,11 @@ class CatalogAccessor {
    */
   common::ManagedPointer<storage::BlockStore> GetBlockStore() const;
 
+  /**
+   * @return the transaction context for this accessor
+   */
+  common::ManagedPointer<transaction::TransactionContext> GetTxn() const { return txn_; }
+
   /**
    * Instantiates a new accessor into the catalog for the given database.
    * @param catalog pointer to the catalog being accessed
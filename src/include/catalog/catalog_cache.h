@@ -0,0 +1,121 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog_defs.h"
+#include "catalog/postgres/pg_class.h"
+#include "common/container/concurrent_map.h"
+#include "common/hash_util.h"
+#include "common/macros.h"
+#include "transaction/transaction_defs.h"
+
+namespace terrier::catalog {
+
+/**
+ * The results of lookups into a DatabaseCatalog as of one version of the catalog, which is the state left behind by the
+ * DDL change that committed at a given timestamp. Every transaction that sees exactly that version gets the same
+ * results, so the first one to do a lookup caches it for the rest. A later DDL change never updates the entries, it
+ * retires the whole cache for a new, empty one instead.
+ *
+ * Lookups and inserts are thread-safe and take no locks.
+ */
+class CatalogCache {
+ public:
+  /**
+   * Cached results of one kind of lookup
+   * @tparam K key of the lookup
+   * @tparam V result of the lookup
+   * @tparam Hasher hasher of the key
+   */
+  template <typename K, typename V, typename Hasher = std::hash<K>>
+  class Entries {
+   public:
+    /**
+     * Finds the result of the lookup of the given key, doing the lookup and caching its result if it isn't cached yet
+     * @tparam F type of the lookup
+     * @param key key to find
+     * @param lookup produces the result for the key on a miss
+     * @return result for the key
+     */
+    template <typename F>
+    V GetOrInsert(const K &key, F lookup) {
+      const auto it = map_.Find(key);
+      if (it != map_.end()) return it->second;
+      // Racing misses compute the same result, so it doesn't matter whose insert wins
+      V value = lookup();
+      map_.Insert(key, value);
+      return value;
+    }
+
+   private:
+    common::ConcurrentMap<K, V, Hasher> map_;
+  };
+
+  /**
+   * Hasher for the names of objects within a namespace
+   */
+  struct NameHasher {
+    /**
+     * @param key namespace and name of an object
+     * @return hash of the key
+     */
+    size_t operator()(const std::pair<namespace_oid_t, std::string> &key) const {
+      return common::HashUtil::CombineHashes(common::HashUtil::Hash(key.first), common::HashUtil::Hash(key.second));
+    }
+  };
+
+  /**
+   * Creates an empty cache
+   * @param version commit timestamp of the DDL change that produced the cached version of the catalog
+   */
+  explicit CatalogCache(const transaction::timestamp_t version) : version_(version) {}
+
+  DISALLOW_COPY_AND_MOVE(CatalogCache);
+
+  /**
+   * @return commit timestamp of the DDL change that produced the cached version of the catalog
+   */
+  transaction::timestamp_t Version() const { return version_; }
+
+  /**
+   * @return namespace oids, by name
+   */
+  Entries<std::string, namespace_oid_t> &NamespaceOids() { return namespace_oids_; }
+
+  /**
+   * @return oids and kinds of pg_class entries, by namespace and name
+   */
+  Entries<std::pair<namespace_oid_t, std::string>, std::pair<uint32_t, postgres::ClassKind>, NameHasher>
+      &ClassOidKinds() {
+    return class_oid_kinds_;
+  }
+
+  /**
+   * @return object pointers and kinds of pg_class entries, by oid
+   */
+  Entries<uint32_t, std::pair<void *, postgres::ClassKind>> &ClassPtrKinds() { return class_ptr_kinds_; }
+
+  /**
+   * @return schema pointers and kinds of pg_class entries, by oid
+   */
+  Entries<uint32_t, std::pair<void *, postgres::ClassKind>> &ClassSchemaPtrKinds() { return class_schema_ptr_kinds_; }
+
+  /**
+   * @return oids of the indexes on each table
+   */
+  Entries<table_oid_t, std::vector<index_oid_t>> &IndexOids() { return index_oids_; }
+
+ private:
+  const transaction::timestamp_t version_;
+  Entries<std::string, namespace_oid_t> namespace_oids_;
+  Entries<std::pair<namespace_oid_t, std::string>, std::pair<uint32_t, postgres::ClassKind>, NameHasher>
+      class_oid_kinds_;
+  Entries<uint32_t, std::pair<void *, postgres::ClassKind>> class_ptr_kinds_;
+  Entries<uint32_t, std::pair<void *, postgres::ClassKind>> class_schema_ptr_kinds_;
+  Entries<table_oid_t, std::vector<index_oid_t>> index_oids_;
+};
+
+}  // namespace terrier::catalog
@@ -6,6 +6,7 @@
 #include <utility>
 #include <vector>
 
+#include "catalog/catalog_cache.h"
 #include "catalog/catalog_defs.h"
 #include "catalog/index_schema.h"
 #include "catalog/postgres/pg_class.h"
@@ -34,6 +35,8 @@ namespace terrier::catalog {
  */
 class DatabaseCatalog {
  public:
+  ~DatabaseCatalog() { delete cache_.load(); }
+
   /**
    * Adds the default/mandatory entries into the catalog that describe itself
    * @param txn for the operation
@@ -514,11 +517,17 @@ class DatabaseCatalog {
   std::atomic<uint32_t> next_oid_;
   std::atomic<transaction::timestamp_t> write_lock_;
 
+  // Lookups of the latest committed version of the catalog. Replaced by every DDL commit.
+  std::atomic<CatalogCache *> cache_;
+
   const db_oid_t db_oid_;
   const common::ManagedPointer<storage::GarbageCollector> garbage_collector_;
 
   DatabaseCatalog(const db_oid_t oid, const common::ManagedPointer<storage::GarbageCollector> garbage_collector)
-      : write_lock_(transaction::INITIAL_TXN_TIMESTAMP), db_oid_(oid), garbage_collector_(garbage_collector) {}
+      : write_lock_(transaction::INITIAL_TXN_TIMESTAMP),
+        cache_(new CatalogCache(transaction::INITIAL_TXN_TIMESTAMP)),
+        db_oid_(oid),
+        garbage_collector_(garbage_collector) {}
 
   void TearDown(common::ManagedPointer<transaction::TransactionContext> txn);
   bool CreateTableEntry(common::ManagedPointer<transaction::TransactionContext> txn, table_oid_t table_oid,
@@ -540,6 +549,15 @@ class DatabaseCatalog {
    */
   bool TryLock(common::ManagedPointer<transaction::TransactionContext> txn);
 
+  /**
+   * Lookups can be served from the cache only if the txn sees the latest committed DDL change and no DDL change is in
+   * progress, which in particular excludes a txn that must see its own DDL changes.
+   * @param txn txn doing a lookup
+   * @return the cached lookups of the version of the catalog that txn sees, or nullptr if txn must read the catalog
+   * tables
+   */
+  CatalogCache *GetCache(common::ManagedPointer<transaction::TransactionContext> txn);
+
   /**
    * Atomically updates the next oid counter to the max of the current count and the provided next oid
    * @param oid next oid to move oid counter to
@@ -644,6 +662,12 @@ class DatabaseCatalog {
   std::pair<uint32_t, postgres::ClassKind> GetClassOidKind(common::ManagedPointer<transaction::TransactionContext> txn,
                                                            namespace_oid_t ns_oid, const std::string &name);
 
+  /**
+   * GetClassOidKind, read from pg_class instead of the cache
+   */
+  std::pair<uint32_t, postgres::ClassKind> ScanClassOidKind(common::ManagedPointer<transaction::TransactionContext> txn,
+                                                            namespace_oid_t ns_oid, const std::string &name);
+
   /**
    * Helper function to query an object pointer form pg_class
    * @param txn transaction to query
@@ -654,6 +678,12 @@ class DatabaseCatalog {
   std::pair<void *, postgres::ClassKind> GetClassPtrKind(common::ManagedPointer<transaction::TransactionContext> txn,
                                                          uint32_t oid);
 
+  /**
+   * GetClassPtrKind, read from pg_class instead of the cache
+   */
+  std::pair<void *, postgres::ClassKind> ScanClassPtrKind(common::ManagedPointer<transaction::TransactionContext> txn,
+                                                          uint32_t oid);
+
   /**
    * Helper function to query a schema pointer form pg_class
    * @param txn transaction to query
@@ -664,6 +694,24 @@ class DatabaseCatalog {
   std::pair<void *, postgres::ClassKind> GetClassSchemaPtrKind(
       common::ManagedPointer<transaction::TransactionContext> txn, uint32_t oid);
 
+  /**
+   * GetClassSchemaPtrKind, read from pg_class instead of the cache
+   */
+  std::pair<void *, postgres::ClassKind> ScanClassSchemaPtrKind(
+      common::ManagedPointer<transaction::TransactionContext> txn, uint32_t oid);
+
+  /**
+   * GetNamespaceOid, read from pg_namespace instead of the cache
+   */
+  namespace_oid_t ScanNamespaceOid(common::ManagedPointer<transaction::TransactionContext> txn,
+                                   const std::string &name);
+
+  /**
+   * GetIndexOids, read from pg_index instead of the cache
+   */
+  std::vector<index_oid_t> ScanIndexOids(common::ManagedPointer<transaction::TransactionContext> txn,
+                                         table_oid_t table);
+
   /**
    * Sets a table's schema in pg_class
    * @warning Should only be used by recovery
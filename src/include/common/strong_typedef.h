@@ -349,6 +349,16 @@ struct atomic<terrier::common::StrongTypeAlias<Tag, IntType>> {
     return t(result);
   }
 
+  /**
+   * Atomically adds arg to the underlying value. The operation is read-modify-write operation.
+   * @param arg the value to add.
+   * @param order memory order constraints to enforce.
+   * @return The value of the atomic variable before the call.
+   */
+  t fetch_add(IntType arg, memory_order order = memory_order_seq_cst) volatile noexcept {  // NOLINT match underlying API
+    return t(underlying_.fetch_add(arg, order));
+  }
+
  private:
   atomic<IntType> underlying_;
 };
@@ -32,6 +32,17 @@ namespace terrier::execution::ast {
   F(FilterLe, filterLe)                                                 \
   F(FilterLt, filterLt)                                                 \
   F(FilterNe, filterNe)                                                 \
+  F(FilterLike, filterLike)                                             \
+  F(FilterNotLike, filterNotLike)                                       \
+                                                                        \
+  /* Vectorized Arithmetic */                                           \
+  F(PCIComputeAdd, pciComputeAdd)                                       \
+  F(PCIComputeSub, pciComputeSub)                                       \
+  F(PCIComputeMul, pciComputeMul)                                       \
+  F(PCIComputeAddVal, pciComputeAddVal)                                 \
+  F(PCIComputeSubVal, pciComputeSubVal)                                 \
+  F(PCIComputeMulVal, pciComputeMulVal)                                 \
+  F(PCIComputeValSub, pciComputeValSub)                                 \
                                                                         \
   /* Thread State Container */                                          \
   F(ExecutionContextGetMemoryPool, execCtxGetMem)                       \
@@ -82,6 +93,7 @@ namespace terrier::execution::ast {
   F(PCIGetDateNull, pciGetDateNull)                                     \
   F(PCIGetTimestampNull, pciGetTimestampNull)                           \
   F(PCIGetVarlenNull, pciGetVarlenNull)                                 \
+  F(PCIGetComputed, pciGetComputed)                                     \
                                                                         \
   /* Hashing */                                                         \
   F(Hash, hash)                                                         \
@@ -129,6 +141,7 @@ namespace terrier::execution::ast {
                                                                         \
   /* Sorting */                                                         \
   F(SorterInit, sorterInit)                                             \
+  F(SorterKey, sorterKey)                                               \
   F(SorterInsert, sorterInsert)                                         \
   F(SorterInsertTopK, sorterInsertTopK)                                 \
   F(SorterInsertTopKFinish, sorterInsertTopKFinish)                     \
@@ -167,8 +180,13 @@ namespace terrier::execution::ast {
   /* Index */                                                           \
   F(IndexIteratorInit, indexIteratorInit)                               \
   F(IndexIteratorInitBind, indexIteratorInitBind)                       \
+  F(IndexIteratorInitCovering, indexIteratorInitCovering)               \
   F(IndexIteratorScanKey, indexIteratorScanKey)                         \
+  F(IndexIteratorAddKey, indexIteratorAddKey)                           \
+  F(IndexIteratorScanKeys, indexIteratorScanKeys)                       \
+  F(IndexIteratorScanNextKey, indexIteratorScanNextKey)                 \
   F(IndexIteratorScanAscending, indexIteratorScanAscending)             \
+  F(IndexIteratorStreamAscending, indexIteratorStreamAscending)         \
   F(IndexIteratorScanDescending, indexIteratorScanDescending)           \
   F(IndexIteratorScanLimitDescending, indexIteratorScanLimitDescending) \
   F(IndexIteratorAdvance, indexIteratorAdvance)                         \
@@ -249,7 +267,8 @@ namespace terrier::execution::ast {
                                                                         \
   /* String functions */                                                \
   F(Lower, lower)                                                       \
-  F(Position, position)
+  F(Position, position)                                                 \
+  F(Like, like)
 
 /**
  * Enum of builtins
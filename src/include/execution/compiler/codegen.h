@@ -337,6 +337,11 @@ class CodeGen {
    */
   ast::Expr *StringToSql(std::string_view str);
 
+  /**
+   * @return The raw string literal representing str
+   */
+  ast::Expr *StringLiteral(std::string_view str);
+
   /**
    * @return The integer literal representing num
    */
@@ -459,6 +464,43 @@ class CodeGen {
   ast::Expr *PCIFilter(ast::Identifier pci, terrier::parser::ExpressionType comp_type, uint32_t col_idx,
                        terrier::type::TypeId col_type, ast::Expr *filter_val);
 
+  /**
+   * Call pciComputeOp(pci, out_idx, col_idx_1, type_1, col_idx_2, type_2)
+   * @param pci The identifier of the projected columns iterator
+   * @param op_type The arithmetic operation being performed.
+   * @param out_idx Index of the computed column.
+   * @param col_idx_1 Index of the left operand column.
+   * @param type_1 The type of the left operand column.
+   * @param col_idx_2 Index of the right operand column.
+   * @param type_2 The type of the right operand column.
+   * @return The expression corresponding to the builtin call.
+   */
+  ast::Expr *PCICompute(ast::Identifier pci, terrier::parser::ExpressionType op_type, uint32_t out_idx,
+                        uint32_t col_idx_1, terrier::type::TypeId type_1, uint32_t col_idx_2,
+                        terrier::type::TypeId type_2);
+
+  /**
+   * Call pciComputeOpVal(pci, out_idx, col_idx, type, val), or pciComputeValSub if the value is subtracted from
+   * @param pci The identifier of the projected columns iterator
+   * @param op_type The arithmetic operation being performed.
+   * @param out_idx Index of the computed column.
+   * @param col_idx Index of the operand column.
+   * @param type The type of the operand column.
+   * @param val The constant value.
+   * @param val_on_left Whether the constant value is the left operand.
+   * @return The expression corresponding to the builtin call.
+   */
+  ast::Expr *PCIComputeVal(ast::Identifier pci, terrier::parser::ExpressionType op_type, uint32_t out_idx,
+                           uint32_t col_idx, terrier::type::TypeId type, int64_t val, bool val_on_left);
+
+  /**
+   * Call pciGetComputed(pci, idx)
+   * @param pci The identifier of the projected columns iterator
+   * @param idx Index of the computed column being accessed.
+   * @return The expression corresponding to the builtin call.
+   */
+  ast::Expr *PCIGetComputed(ast::Identifier pci, uint32_t idx);
+
   /**
    * Call execCtxGetMem(execCtx)
    * @return The expression corresponding to the builtin call.
@@ -479,19 +521,23 @@ class CodeGen {
    * @param table_oid The oid of the index's table.
    * @param index_oid The oid the index.
    * @param col_oids The identifier of the array of column oids to read.
+   * @param covering Whether the iterator reads index keys instead of table rows (indexIteratorInitCovering).
    * @return The expression corresponding to the builtin call.
    */
   ast::Expr *IndexIteratorInit(ast::Identifier iter, uint32_t num_attrs, uint32_t table_oid, uint32_t index_oid,
-                               ast::Identifier col_oids);
+                               ast::Identifier col_oids, bool covering = false);
 
   /**
    * Call IndexIteratorScanType(&iter[, limit])
    * @param iter The identifier of the index iterator.
    * @param scan_type The type of scan to perform.
    * @param limit The limit of the scan in case of limited scans.
+   * @param stream Whether an ascending scan may read the index lazily instead of collecting every match up front.
+   * This is only safe when the consumer of the scan does not modify the index.
    * @return The expression corresponding to the builtin call.
    */
-  ast::Expr *IndexIteratorScan(ast::Identifier iter, planner::IndexScanType scan_type, uint32_t limit);
+  ast::Expr *IndexIteratorScan(ast::Identifier iter, planner::IndexScanType scan_type, uint32_t limit,
+                               bool stream = false);
 
   /**
    * Call PrGet(pr, attr_idx)
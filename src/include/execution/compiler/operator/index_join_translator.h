@@ -38,6 +38,11 @@ class IndexJoinTranslator : public OperatorTranslator {
   void Abort(FunctionBuilder *builder) override;
   void Consume(FunctionBuilder *builder) override;
 
+  // Look up the keys of a whole outer vector at once
+  bool ConsumesVectors() override { return true; }
+  void ConsumeVectorTuple(FunctionBuilder *builder) override;
+  void FinishVector(FunctionBuilder *builder) override;
+
   ast::Expr *GetOutput(uint32_t attr_idx) override;
   ast::Expr *GetChildOutput(uint32_t child_idx, uint32_t attr_idx, terrier::type::TypeId type) override;
   ast::Expr *GetTableColumn(const catalog::col_oid_t &col_oid) override;
@@ -73,6 +78,8 @@ class IndexJoinTranslator : public OperatorTranslator {
   storage::ProjectionMap table_pm_;
   const catalog::IndexSchema &index_schema_;
   const std::unordered_map<catalog::indexkeycol_oid_t, uint16_t> &index_pm_;
+  // Whether the child hands over vectors, so the keys were already looked up in FinishVector
+  bool batched_lookup_{false};
   // Structs and local variables
   ast::Identifier index_iter_;
   ast::Identifier col_oids_;
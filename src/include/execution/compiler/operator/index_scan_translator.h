@@ -59,6 +59,10 @@ class IndexScanTranslator : public OperatorTranslator {
   const planner::AbstractPlanNode *Op() override { return op_; }
 
  private:
+  // Whether an ascending scan may read the index lazily
+  bool CanStream() const;
+  // Whether the output is read from the index keys instead of the table
+  bool IsCovering() const;
   // Declare the index iterator
   void DeclareIterator(FunctionBuilder *builder);
   // Set the column oids to scan
@@ -86,6 +90,8 @@ class IndexScanTranslator : public OperatorTranslator {
   storage::ProjectionMap table_pm_;
   const catalog::IndexSchema &index_schema_;
   const std::unordered_map<catalog::indexkeycol_oid_t, uint16_t> &index_pm_;
+  // Offset in the index key of each table column, for covering scans
+  std::unordered_map<catalog::col_oid_t, uint16_t> key_pm_;
   // Structs and local variables
   ast::Identifier index_iter_;
   ast::Identifier col_oids_;
@@ -102,6 +102,43 @@ class OperatorTranslator : public ExpressionEvaluator {
    */
   virtual bool IsParallelizable() { return false; }
 
+  /**
+   * Whether this operator wants to see each vector of its input as a whole, before its tuples are consumed one at a
+   * time. A child that produces vectors then calls ConsumeVectorTuple() on every tuple of a vector, then
+   * FinishVector(), and only then Consume() on every tuple of the vector again. Other children ignore this.
+   * @return Whether this operator consumes vectors
+   */
+  virtual bool ConsumesVectors() { return false; }
+
+  /**
+   * Generate code for one tuple of a vector, in the first pass over it. See ConsumesVectors().
+   * @param builder builder of the pipeline function
+   */
+  virtual void ConsumeVectorTuple(FunctionBuilder *builder) {}
+
+  /**
+   * Generate code to run once a whole vector went through ConsumeVectorTuple(). See ConsumesVectors().
+   * @param builder builder of the pipeline function
+   */
+  virtual void FinishVector(FunctionBuilder *builder) {}
+
+  /**
+   * Generate code to run on each vector of the input as a whole, once it is filtered and before any of its tuples are
+   * consumed. Children that produce vectors call this on their parent; other children ignore it.
+   * @param builder builder of the pipeline function
+   * @param pci identifier of the projected columns iterator over the vector
+   */
+  virtual void StartVector(FunctionBuilder *builder, ast::Identifier pci) {}
+
+  /**
+   * Whether an output of this operator is a column of the vectors it produces, which vectorized expressions can use.
+   * @param attr_idx index into the output schema
+   * @param[out] col_idx index of the column in the projected columns iterator
+   * @param[out] type type of the column
+   * @return whether the output is a column of the vectors
+   */
+  virtual bool GetVectorColumn(uint32_t attr_idx, uint32_t *col_idx, terrier::type::TypeId *type) { return false; }
+
   /**
    * Return a table column value.
    * @param col_oid oid of the column
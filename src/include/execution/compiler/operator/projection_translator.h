@@ -1,5 +1,6 @@
 #pragma once
 
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include "execution/compiler/operator/operator_translator.h"
@@ -10,7 +11,8 @@ namespace terrier::execution::compiler {
 
 /**
  * Projection Translator
- * The translator only implements GetOutput and GetChildOutput.
+ * The translator mostly implements GetOutput and GetChildOutput. When the child produces vectors, integer arithmetic
+ * over the child's columns is computed for a whole vector at a time instead of for each tuple.
  */
 class ProjectionTranslator : public OperatorTranslator {
  public:
@@ -20,7 +22,7 @@ class ProjectionTranslator : public OperatorTranslator {
    * @param codegen The code generator
    */
   ProjectionTranslator(const terrier::planner::ProjectionPlanNode *op, CodeGen *codegen)
-      : OperatorTranslator(codegen, brain::ExecutionOperatingUnitType::PROJECTION), op_(op) {}
+      : OperatorTranslator(codegen, brain::ExecutionOperatingUnitType::PROJECTION), op_(op), pci_(nullptr) {}
 
   // Pass through
   void Produce(FunctionBuilder *builder) override { child_translator_->Produce(builder); }
@@ -46,11 +48,13 @@ class ProjectionTranslator : public OperatorTranslator {
   // Does nothing
   void InitializeTeardown(util::RegionVector<ast::Stmt *> *teardown_stmts) override {}
 
-  ast::Expr *GetOutput(uint32_t attr_idx) override {
-    auto output_expr = op_->GetOutputSchema()->GetColumn(attr_idx).GetExpr();
-    auto translator = TranslatorFactory::CreateExpressionTranslator(output_expr.Get(), codegen_);
-    return translator->DeriveExpr(this);
-  }
+  // Compute the vectorizable outputs over the whole vector
+  void StartVector(FunctionBuilder *builder, ast::Identifier pci) override;
+
+  // Computed outputs, and child columns passed through, are columns of the vector
+  bool GetVectorColumn(uint32_t attr_idx, uint32_t *col_idx, terrier::type::TypeId *type) override;
+
+  ast::Expr *GetOutput(uint32_t attr_idx) override;
 
   ast::Expr *GetChildOutput(uint32_t child_idx, uint32_t attr_idx, terrier::type::TypeId type) override {
     return child_translator_->GetOutput(attr_idx);
@@ -67,7 +71,27 @@ class ProjectionTranslator : public OperatorTranslator {
   const planner::AbstractPlanNode *Op() override { return op_; }
 
  private:
+  // Whether an expression is integer arithmetic (+, - or *) over integer columns of the child's vectors and integer
+  // constants, that is not only over constants.
+  bool IsVectorArithmetic(const terrier::parser::AbstractExpression *expr);
+
+  // Whether an expression can be an operand of vectorized arithmetic.
+  bool IsVectorOperand(const terrier::parser::AbstractExpression *expr);
+
+  // Generate the computation of vectorized arithmetic into a new computed column, and return its index.
+  uint32_t GenVectorArithmetic(FunctionBuilder *builder, const terrier::parser::AbstractExpression *expr);
+
+  // Get the column of an operand of vectorized arithmetic, generating its computation if needed.
+  void GenVectorOperand(FunctionBuilder *builder, const terrier::parser::AbstractExpression *expr, uint32_t *col_idx,
+                        terrier::type::TypeId *type);
+
   const planner::ProjectionPlanNode *op_;
+  // The PCI over the current vector of the child, if any.
+  ast::Identifier pci_;
+  // Index of the next computed column of the PCI.
+  uint32_t next_computed_col_{0};
+  // Outputs computed over the whole vector, with the index of their computed column.
+  std::unordered_map<uint32_t, uint32_t> computed_outputs_;
 };
 
 }  // namespace terrier::execution::compiler
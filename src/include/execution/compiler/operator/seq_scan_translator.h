@@ -68,6 +68,9 @@ class SeqScanTranslator : public OperatorTranslator {
   // Used by column value expression to get a column.
   ast::Expr *GetTableColumn(const catalog::col_oid_t &col_oid) override;
 
+  // Column value expressions are columns of the PCI.
+  bool GetVectorColumn(uint32_t attr_idx, uint32_t *col_idx, terrier::type::TypeId *type) override;
+
   // Return the current slot.
   ast::Expr *GetSlot() override { return codegen_->PointerTo(slot_); }
 
@@ -94,6 +97,12 @@ class SeqScanTranslator : public OperatorTranslator {
   // if (cond) {...}
   void GenScanCondition(FunctionBuilder *builder);
 
+  // Start the loop over the tuples of the PCI that satisfy the predicate. Return whether an if statement was opened.
+  bool GenTupleLoop(FunctionBuilder *builder);
+
+  // @pciReset(pci)
+  void GenPCIReset(FunctionBuilder *builder);
+
   // @tableIterClose(&tvi)
   void GenTVIClose(FunctionBuilder *builder);
 
@@ -0,0 +1,328 @@
+#pragma once
+
+#include <vector>
+#include "execution/compiler/operator/operator_translator.h"
+#include "planner/plannodes/set_op_plan_node.h"
+
+namespace terrier::execution::compiler {
+
+// Forward declare
+class SetOpRightTranslator;
+class SetOpTopTranslator;
+class UnionAllRightTranslator;
+
+/**
+ * Set Operation Left Translator
+ * Set operations but UNION ALL are hash based. Every distinct row of either child gets an entry in an aggregation hash
+ * table, which counts how many times the row occurs on each side. The left side builds the hash table in its own
+ * pipeline.
+ */
+class SetOpLeftTranslator : public OperatorTranslator {
+ public:
+  /**
+   * Constructor
+   * @param op plan node to translate
+   * @param codegen code generator
+   */
+  SetOpLeftTranslator(const terrier::planner::SetOpPlanNode *op, CodeGen *codegen);
+
+  // Declare the hash table
+  void InitializeStateFields(util::RegionVector<ast::FieldDecl *> *state_fields) override;
+
+  // Declare the values and entry structs
+  void InitializeStructs(util::RegionVector<ast::Decl *> *decls) override;
+
+  // Create the key check function
+  void InitializeHelperFunctions(util::RegionVector<ast::Decl *> *decls) override;
+
+  // Initialize the hash table
+  void InitializeSetup(util::RegionVector<ast::Stmt *> *setup_stmts) override;
+
+  // Free the hash table
+  void InitializeTeardown(util::RegionVector<ast::Stmt *> *teardown_stmts) override;
+
+  void Produce(FunctionBuilder *builder) override;
+  void Abort(FunctionBuilder *builder) override;
+  void Consume(FunctionBuilder *builder) override;
+
+  // Should not be called.
+  ast::Expr *GetOutput(uint32_t attr_idx) override { UNREACHABLE("The left side of a set operation has no output"); }
+
+  // Should not be called.
+  ast::Expr *GetChildOutput(uint32_t child_idx, uint32_t attr_idx, terrier::type::TypeId type) override {
+    UNREACHABLE("This translator does not call DeriveExpr");
+  }
+
+  const planner::AbstractPlanNode *Op() override { return op_; }
+
+ private:
+  // Make the other sides friend classes.
+  friend class SetOpRightTranslator;
+  friend class SetOpTopTranslator;
+
+  /**
+   * Generate the lookup of the current row of the child, and the insertion of a new entry if it is missing.
+   * Afterwards, the entry is either nil or has the row as key, with zero counts if it was just inserted.
+   * @param builder current function builder
+   * @param child translator producing the row
+   * @param insert whether to insert an entry for missing rows
+   */
+  void GenLookup(FunctionBuilder *builder, OperatorTranslator *child, bool insert);
+
+  /**
+   * Generate entry.count = entry.count + 1
+   * @param builder current function builder
+   * @param count the count to increment
+   */
+  void GenIncrement(FunctionBuilder *builder, ast::Identifier count);
+
+  const planner::SetOpPlanNode *op_;
+
+  // Structs, functions and local variables needed.
+  ast::Identifier ht_;
+  ast::Identifier entry_struct_;
+  ast::Identifier values_struct_;
+  ast::Identifier key_check_;
+  ast::Identifier entry_;
+  ast::Identifier values_;
+  ast::Identifier hash_val_;
+  ast::Identifier left_count_;
+  ast::Identifier right_count_;
+  // One key per column of the children.
+  std::vector<ast::Identifier> keys_;
+};
+
+/**
+ * Set Operation Right Translator
+ * The right side counts its rows in the hash table of the left side, in its own pipeline. Only UNION adds rows that the
+ * left side does not have.
+ */
+class SetOpRightTranslator : public OperatorTranslator {
+ public:
+  /**
+   * Constructor
+   * @param op plan node to translate
+   * @param codegen code generator
+   * @param left the left translator
+   */
+  SetOpRightTranslator(const terrier::planner::SetOpPlanNode *op, CodeGen *codegen, OperatorTranslator *left)
+      : OperatorTranslator(codegen, brain::ExecutionOperatingUnitType::AGGREGATE_BUILD),
+        op_(op),
+        left_(dynamic_cast<SetOpLeftTranslator *>(left)) {}
+
+  // Does nothing
+  void InitializeStateFields(util::RegionVector<ast::FieldDecl *> *state_fields) override {}
+
+  // Does nothing
+  void InitializeStructs(util::RegionVector<ast::Decl *> *decls) override {}
+
+  // Does nothing
+  void InitializeHelperFunctions(util::RegionVector<ast::Decl *> *decls) override {}
+
+  // Does nothing
+  void InitializeSetup(util::RegionVector<ast::Stmt *> *setup_stmts) override {}
+
+  // Does nothing
+  void InitializeTeardown(util::RegionVector<ast::Stmt *> *teardown_stmts) override {}
+
+  void Produce(FunctionBuilder *builder) override { child_translator_->Produce(builder); }
+  void Abort(FunctionBuilder *builder) override { child_translator_->Abort(builder); }
+  void Consume(FunctionBuilder *builder) override;
+
+  // Should not be called.
+  ast::Expr *GetOutput(uint32_t attr_idx) override { UNREACHABLE("The right side of a set operation has no output"); }
+
+  // Should not be called.
+  ast::Expr *GetChildOutput(uint32_t child_idx, uint32_t attr_idx, terrier::type::TypeId type) override {
+    UNREACHABLE("This translator does not call DeriveExpr");
+  }
+
+  const planner::AbstractPlanNode *Op() override { return op_; }
+
+ private:
+  const planner::SetOpPlanNode *op_;
+  SetOpLeftTranslator *left_;
+};
+
+/**
+ * Set Operation Top Translator
+ * Iterates through the hash table once both sides are counted, and outputs each row as many times as the set
+ * operation keeps it.
+ */
+class SetOpTopTranslator : public OperatorTranslator {
+ public:
+  /**
+   * Constructor
+   * @param op plan node to translate
+   * @param codegen code generator
+   * @param left the left translator
+   */
+  SetOpTopTranslator(const terrier::planner::SetOpPlanNode *op, CodeGen *codegen, OperatorTranslator *left)
+      : OperatorTranslator(codegen, brain::ExecutionOperatingUnitType::AGGREGATE_ITERATE),
+        op_(op),
+        left_(dynamic_cast<SetOpLeftTranslator *>(left)),
+        iterator_(codegen->NewIdentifier("set_op_iter")),
+        copy_idx_(codegen->NewIdentifier("set_op_copy")) {}
+
+  // Does nothing
+  void InitializeStateFields(util::RegionVector<ast::FieldDecl *> *state_fields) override {}
+
+  // Does nothing
+  void InitializeStructs(util::RegionVector<ast::Decl *> *decls) override {}
+
+  // Does nothing
+  void InitializeHelperFunctions(util::RegionVector<ast::Decl *> *decls) override {}
+
+  // Does nothing
+  void InitializeSetup(util::RegionVector<ast::Stmt *> *setup_stmts) override {}
+
+  // Does nothing
+  void InitializeTeardown(util::RegionVector<ast::Stmt *> *teardown_stmts) override {}
+
+  void Produce(FunctionBuilder *builder) override;
+  void Abort(FunctionBuilder *builder) override;
+  void Consume(FunctionBuilder *builder) override;
+
+  ast::Expr *GetOutput(uint32_t attr_idx) override;
+
+  // Both children refer to the keys of the current entry
+  ast::Expr *GetChildOutput(uint32_t child_idx, uint32_t attr_idx, terrier::type::TypeId type) override;
+
+  const planner::AbstractPlanNode *Op() override { return op_; }
+
+ private:
+  // for (@aggHTIterInit(&iter, &state.ht); @aggHTIterHasNext(&iter); @aggHTIterNext(&iter)) {...}
+  void GenHTLoop(FunctionBuilder *builder);
+
+  // Declare var entry = @ptrCast(*SetOpEntry, @aggHTIterGetRow(&iter))
+  void DeclareEntry(FunctionBuilder *builder);
+
+  // Generate an if statement or a loop that outputs the entry as many times as the set operation keeps it.
+  // Return true iff a block was started.
+  bool GenCopies(FunctionBuilder *builder);
+
+  // Call @aggHTIterClose(&iter)
+  void CloseIterator(FunctionBuilder *builder);
+
+  const planner::SetOpPlanNode *op_;
+  // Owner of the hash table
+  SetOpLeftTranslator *left_;
+
+  // Local variables needed.
+  ast::Identifier iterator_;
+  ast::Identifier copy_idx_;
+};
+
+/**
+ * UNION ALL Left Translator
+ * UNION ALL needs no hash table, since it keeps every row of both sides. Both sides belong to the pipeline of the
+ * parent, one after the other: the rows of the left side are passed to the parent first, then the right side is
+ * produced, just like the inner side of a nested loop join.
+ */
+class UnionAllLeftTranslator : public OperatorTranslator {
+ public:
+  /**
+   * Constructor
+   * @param op plan node to translate
+   * @param codegen code generator
+   */
+  UnionAllLeftTranslator(const terrier::planner::SetOpPlanNode *op, CodeGen *codegen)
+      : OperatorTranslator(codegen, brain::ExecutionOperatingUnitType::INVALID), op_(op) {}
+
+  // Does nothing
+  void InitializeStateFields(util::RegionVector<ast::FieldDecl *> *state_fields) override {}
+
+  // Does nothing
+  void InitializeStructs(util::RegionVector<ast::Decl *> *decls) override {}
+
+  // Does nothing
+  void InitializeHelperFunctions(util::RegionVector<ast::Decl *> *decls) override {}
+
+  // Does nothing
+  void InitializeSetup(util::RegionVector<ast::Stmt *> *setup_stmts) override {}
+
+  // Does nothing
+  void InitializeTeardown(util::RegionVector<ast::Stmt *> *teardown_stmts) override {}
+
+  // Produce the left side, then let the right side produce its rows after it
+  void Produce(FunctionBuilder *builder) override;
+  void Abort(FunctionBuilder *builder) override { child_translator_->Abort(builder); }
+
+  // Pass the row of the left side to the parent of the set operation
+  void Consume(FunctionBuilder *builder) override;
+
+  // Should not be called.
+  ast::Expr *GetOutput(uint32_t attr_idx) override { UNREACHABLE("The left side of a UNION ALL has no output"); }
+
+  // Should not be called.
+  ast::Expr *GetChildOutput(uint32_t child_idx, uint32_t attr_idx, terrier::type::TypeId type) override {
+    UNREACHABLE("This translator does not call DeriveExpr");
+  }
+
+  const planner::AbstractPlanNode *Op() override { return op_; }
+
+ private:
+  friend class UnionAllRightTranslator;
+
+  const planner::SetOpPlanNode *op_;
+  // Set by the right side when it is created
+  UnionAllRightTranslator *right_{nullptr};
+};
+
+/**
+ * UNION ALL Right Translator
+ * Passes the rows of both sides to the parent, taking the output columns from whichever side is being consumed.
+ */
+class UnionAllRightTranslator : public OperatorTranslator {
+ public:
+  /**
+   * Constructor
+   * @param op plan node to translate
+   * @param codegen code generator
+   * @param left the left translator
+   */
+  UnionAllRightTranslator(const terrier::planner::SetOpPlanNode *op, CodeGen *codegen, OperatorTranslator *left)
+      : OperatorTranslator(codegen, brain::ExecutionOperatingUnitType::INVALID),
+        op_(op),
+        left_(dynamic_cast<UnionAllLeftTranslator *>(left)) {
+    left_->right_ = this;
+  }
+
+  // Does nothing
+  void InitializeStateFields(util::RegionVector<ast::FieldDecl *> *state_fields) override {}
+
+  // Does nothing
+  void InitializeStructs(util::RegionVector<ast::Decl *> *decls) override {}
+
+  // Does nothing
+  void InitializeHelperFunctions(util::RegionVector<ast::Decl *> *decls) override {}
+
+  // Does nothing
+  void InitializeSetup(util::RegionVector<ast::Stmt *> *setup_stmts) override {}
+
+  // Does nothing
+  void InitializeTeardown(util::RegionVector<ast::Stmt *> *teardown_stmts) override {}
+
+  // Pass through
+  void Produce(FunctionBuilder *builder) override { child_translator_->Produce(builder); }
+  void Abort(FunctionBuilder *builder) override { child_translator_->Abort(builder); }
+
+  // Pass through
+  void Consume(FunctionBuilder *builder) override { parent_translator_->Consume(builder); }
+
+  ast::Expr *GetOutput(uint32_t attr_idx) override;
+
+  // Both children refer to the side being consumed
+  ast::Expr *GetChildOutput(uint32_t child_idx, uint32_t attr_idx, terrier::type::TypeId type) override;
+
+  const planner::AbstractPlanNode *Op() override { return op_; }
+
+ private:
+  friend class UnionAllLeftTranslator;
+
+  const planner::SetOpPlanNode *op_;
+  UnionAllLeftTranslator *left_;
+  // Whether the parent is consuming a row of the left side
+  bool consuming_left_{false};
+};
+}  // namespace terrier::execution::compiler
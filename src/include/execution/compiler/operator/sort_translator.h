@@ -60,12 +60,16 @@ class SortBottomTranslator : public OperatorTranslator {
 
   // Return the member of the object at the given index
   ast::Expr *GetAttribute(ast::Identifier object, uint32_t attr_idx);
+  // Return the normalized key word of the object at the given index
+  ast::Expr *GetKeyWord(ast::Identifier object, uint32_t word_idx);
   // Insert into sorter
   void GenSorterInsert(FunctionBuilder *builder);
   // Gen top k finish
   void GenFinishTopK(FunctionBuilder *builder);
   // Fill the sorter row
   void FillSorterRow(FunctionBuilder *builder);
+  // Fill the normalized key at the start of the sorter row
+  void FillSorterKey(FunctionBuilder *builder);
   // Call Sort()
   void GenSorterSort(FunctionBuilder *builder);
   // Generate the comparisons in the comparison function
@@ -85,8 +89,14 @@ class SortBottomTranslator : public OperatorTranslator {
   enum class CurrentRow { Child, Lhs, Rhs };
   CurrentRow current_row_{CurrentRow::Child};
 
+  // The number of leading sort keys that make up the normalized key of each
+  // sorter row. The normalized key lets the sorter radix sort, and only call
+  // the comparison function on ties.
+  uint32_t num_key_words_{0};
+
   // Structs, Functions, and local variables needed.
   static constexpr const char *SORTER_ATTR_PREFIX = "sorter_attr";
+  static constexpr const char *SORTER_KEY_PREFIX = "sorter_key";
   ast::Identifier sorter_;
   ast::Identifier sorter_row_;
   ast::Identifier sorter_struct_;
@@ -72,10 +72,11 @@ class EXPORT ExecutionContext {
    * @param callback callback function for outputting
    * @param schema the schema of the output
    * @param accessor the catalog accessor of this query
+   * @param sort_memory_budget bytes of tuples each sorter buffers before spilling to disk, 0 for no limit
    */
   ExecutionContext(catalog::db_oid_t db_oid, common::ManagedPointer<transaction::TransactionContext> txn,
                    const OutputCallback &callback, const planner::OutputSchema *schema,
-                   const common::ManagedPointer<catalog::CatalogAccessor> accessor)
+                   const common::ManagedPointer<catalog::CatalogAccessor> accessor, uint64_t sort_memory_budget = 0)
       : db_oid_(db_oid),
         txn_(txn),
         mem_tracker_(std::make_unique<sql::MemoryTracker>()),
@@ -84,7 +85,9 @@ class EXPORT ExecutionContext {
                                   : std::make_unique<OutputBuffer>(mem_pool_.get(), schema->GetColumns().size(),
                                                                    ComputeTupleSize(schema), callback)),
         string_allocator_(common::ManagedPointer<sql::MemoryTracker>(mem_tracker_)),
-        accessor_(accessor) {}
+        accessor_(accessor) {
+    if (sort_memory_budget > 0) mem_tracker_->SetMemoryLimit(sort_memory_budget);
+  }
 
   /**
    * @return the transaction used by this query
@@ -1,9 +1,10 @@
 #pragma once
 
-#pragma once
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <sstream>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -33,9 +34,28 @@ using OutputCallback = std::function<void(byte *, uint32_t, uint32_t)>;
 class EXPORT OutputBuffer {
  public:
   /**
-   * Batch size
+   * Smallest number of tuples in a batch
+   */
+  static constexpr uint32_t MIN_BATCH_SIZE = 32;
+
+  /**
+   * Largest number of tuples in a batch
    */
-  static constexpr uint32_t BATCH_SIZE = 32;
+  static constexpr uint32_t MAX_BATCH_SIZE = 2048;
+
+  /**
+   * Number of bytes of tuples to buffer before invoking the callback. Narrow tuples get larger batches so that the
+   * per-batch overhead of the callback (e.g., the network writer) is amortized over more rows.
+   */
+  static constexpr uint32_t BATCH_BYTES = 64 * 1024;
+
+  /**
+   * @param tuple_size size of output tuples
+   * @return number of tuples to buffer per batch for tuples of the given size
+   */
+  static uint32_t BatchSize(const uint32_t tuple_size) {
+    return std::clamp(BATCH_BYTES / std::max(tuple_size, 1u), MIN_BATCH_SIZE, MAX_BATCH_SIZE);
+  }
 
   /**
    * Constructor
@@ -48,15 +68,16 @@ class EXPORT OutputBuffer {
       : memory_pool_(memory_pool),
         num_tuples_(0),
         tuple_size_(tuple_size),
+        batch_size_(BatchSize(tuple_size)),
         tuples_(
-            reinterpret_cast<byte *>(memory_pool->AllocateAligned(BATCH_SIZE * tuple_size, alignof(uint64_t), true))),
+            reinterpret_cast<byte *>(memory_pool->AllocateAligned(batch_size_ * tuple_size, alignof(uint64_t), true))),
         callback_(std::move(callback)) {}
 
   /**
    * @return an output slot to be written to.
    */
   byte *AllocOutputSlot() {
-    if (num_tuples_ == BATCH_SIZE) {
+    if (num_tuples_ == batch_size_) {
       callback_(tuples_, num_tuples_, tuple_size_);
       num_tuples_ = 0;
     }
@@ -79,6 +100,7 @@ class EXPORT OutputBuffer {
   sql::MemoryPool *memory_pool_;
   uint32_t num_tuples_;
   uint32_t tuple_size_;
+  uint32_t batch_size_;
   byte *tuples_;
   OutputCallback callback_;
 };
@@ -143,6 +165,64 @@ class OutputWriter {
   const std::vector<network::FieldFormat> &field_formats_;
 };
 
+/**
+ * Output handler for COPY ... TO that formats results as CSV. The CSV text of a batch is either appended to a file or
+ * sent to the client as a single CopyData message.
+ */
+class CSVOutputWriter {
+ public:
+  /**
+   * Writes CSV to a file
+   * @param schema final schema to output for this query
+   * @param file stream of the file to write to
+   * @param delimiter field delimiter character
+   * @param quote quote character
+   * @param escape escape character for quotes within quoted fields
+   */
+  CSVOutputWriter(const common::ManagedPointer<planner::OutputSchema> schema, std::ostream *const file,
+                  const char delimiter, const char quote, const char escape)
+      : schema_(schema), file_(file), out_(nullptr), delimiter_(delimiter), quote_(quote), escape_(escape) {}
+
+  /**
+   * Writes CSV to the client, for COPY ... TO STDOUT
+   * @param schema final schema to output for this query
+   * @param out packet writer to use
+   * @param delimiter field delimiter character
+   * @param quote quote character
+   * @param escape escape character for quotes within quoted fields
+   */
+  CSVOutputWriter(const common::ManagedPointer<planner::OutputSchema> schema,
+                  const common::ManagedPointer<network::PostgresPacketWriter> out, const char delimiter,
+                  const char quote, const char escape)
+      : schema_(schema), file_(nullptr), out_(out), delimiter_(delimiter), quote_(quote), escape_(escape) {}
+
+  /**
+   * Callback that writes a batch of tuples as CSV.
+   * @param tuples batch of tuples
+   * @param num_tuples number of tuples
+   * @param tuple_size size of tuples
+   */
+  void operator()(byte *tuples, uint32_t num_tuples, uint32_t tuple_size);
+
+  /**
+   * @return number of rows written
+   */
+  uint64_t NumRows() const { return num_rows_; }
+
+ private:
+  void AppendField(const char *data, size_t len);
+
+  uint64_t num_rows_ = 0;
+  const common::ManagedPointer<planner::OutputSchema> schema_;
+  std::ostream *const file_;
+  const common::ManagedPointer<network::PostgresPacketWriter> out_;
+  const char delimiter_;
+  const char quote_;
+  const char escape_;
+  // Reused across batches to avoid reallocating it
+  std::string buffer_;
+};
+
 /**
  * A consumer that doesn't do anything with the result tuples.
  */
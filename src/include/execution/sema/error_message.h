@@ -79,6 +79,7 @@ namespace sema {
     "type '%0' in position %1",                                                                                       \
     (ast::Type *, uint32_t))                                                                                          \
   F(BadHashArg, "cannot hash type '%0'", (ast::Type *))                                                               \
+  F(BadSorterKeyArg, "cannot build a sort key from type '%0'", (ast::Type *))                                         \
   F(MissingArrayLength, "missing array length (either compile-time number or '*')", ())                               \
   F(NotASQLAggregate, "'%0' is not a SQL aggregator type", (ast::Type *))                                             \
   F(BadParallelScanFunction,                                                                                          \
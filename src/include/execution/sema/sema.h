@@ -120,7 +120,8 @@ class Sema : public ast::AstVisitor<Sema> {
   void CheckBuiltinSqlNullCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinSqlConversionCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinDateFunctionCall(ast::CallExpr *call, ast::Builtin builtin);
-  void CheckBuiltinFilterCall(ast::CallExpr *call);
+  void CheckBuiltinFilterCall(ast::CallExpr *call, ast::Builtin builtin);
+  void CheckBuiltinComputeCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinAggHashTableCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinAggHashTableIterCall(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinAggPartIterCall(ast::CallExpr *call, ast::Builtin builtin);
@@ -134,6 +135,7 @@ class Sema : public ast::AstVisitor<Sema> {
   void CheckBuiltinJoinHashTableBuild(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinJoinHashTableFree(ast::CallExpr *call);
   void CheckBuiltinSorterInit(ast::CallExpr *call);
+  void CheckBuiltinSorterKey(ast::CallExpr *call);
   void CheckBuiltinSorterInsert(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinSorterSort(ast::CallExpr *call, ast::Builtin builtin);
   void CheckBuiltinSorterFree(ast::CallExpr *call);
@@ -43,6 +43,18 @@ class EXPORT AggregationHashTable {
    */
   static constexpr uint32_t K_DEFAULT_HLL_PRECISION = 10;
 
+  /**
+   * Minimum fraction of its input a partitioned pre-aggregation must fold into existing groups. Below it, the input is
+   * passed through to the overflow partitions without being pre-aggregated.
+   */
+  static constexpr const float K_MIN_PRE_AGGREGATION_REDUCTION = 0.2f;
+
+  /**
+   * Amount of input passed through to the overflow partitions before pre-aggregation is tried again, in multiples of
+   * the flush threshold
+   */
+  static constexpr const uint32_t K_PASS_THROUGH_INTERVALS = 8;
+
   // -------------------------------------------------------
   // Callback functions to customize aggregations
   // -------------------------------------------------------
@@ -105,6 +117,11 @@ class EXPORT AggregationHashTable {
      * Number of flushes
      */
     uint64_t num_flushes_ = 0;
+
+    /**
+     * Number of input tuples passed through to the overflow partitions without pre-aggregation
+     */
+    uint64_t num_pass_through_ = 0;
   };
 
   // -------------------------------------------------------
@@ -167,15 +184,24 @@ class EXPORT AggregationHashTable {
 
   /**
    * Process an entire vector of input.
+   *
+   * A partitioned table is a thread-local pre-aggregation whose partial
+   * aggregates end up in the overflow partitions. It keeps track of how much
+   * its input is reduced. When nearly every input tuple creates a new group,
+   * pre-aggregating is wasted work, so for a while the input tuples are turned
+   * into single-tuple partial aggregates and written straight to the overflow
+   * partitions instead.
+   *
    * @param iters The input vectors
    * @param hash_fn Function to compute a hash of an input element
    * @param key_eq_fn Function to determine key equality of an input element and
    *                  an existing aggregate
    * @param init_agg_fn Function to initialize a new aggregate
    * @param advance_agg_fn Function to advance an existing aggregate
+   * @param partitioned Whether this is a partitioned table
    */
   void ProcessBatch(ProjectedColumnsIterator *iters[], HashFn hash_fn, KeyEqFn key_eq_fn, InitAggFn init_agg_fn,
-                    AdvanceAggFn advance_agg_fn);
+                    AdvanceAggFn advance_agg_fn, bool partitioned);
 
   /**
    * Transfer all entries and overflow partitions stored in each thread-local
@@ -246,12 +272,25 @@ class EXPORT AggregationHashTable {
   // Allocate all overflow partition information if unallocated
   void AllocateOverflowPartitions();
 
+  // Link an entry into its overflow partition
+  void AddToOverflowPartition(HashTableEntry *entry);
+
+  // Called from ProcessBatch() on a partitioned table to account for a batch
+  // of input that created the given number of new groups, and to decide
+  // whether to pass through the next batches.
+  void MonitorPreAggregation(uint64_t num_input, uint64_t num_new_groups);
+
+  // Called from ProcessBatch() to write every element of the input vector to
+  // the overflow partitions as its own partial aggregate.
+  template <bool PCIIsFiltered>
+  void PassThroughBatch(ProjectedColumnsIterator *iters[], uint32_t num_elems, HashFn hash_fn, InitAggFn init_agg_fn);
+
   // Compute the hash value and perform the table lookup for all elements in the
   // input vector projections.
   template <bool PCIIsFiltered>
   void ProcessBatchImpl(ProjectedColumnsIterator *iters[], uint32_t num_elems, hash_t hashes[],
                         HashTableEntry *entries[], HashFn hash_fn, KeyEqFn key_eq_fn, InitAggFn init_agg_fn,
-                        AdvanceAggFn advance_agg_fn);
+                        AdvanceAggFn advance_agg_fn, bool partitioned);
 
   // Called from ProcessBatch() to lookup a batch of entries. When the function
   // returns, the hashes vector will contain the hash values of all elements in
@@ -284,7 +323,7 @@ class EXPORT AggregationHashTable {
   // Called from ProcessBatch() to create missing groups
   template <bool PCIIsFiltered>
   void CreateMissingGroups(ProjectedColumnsIterator *iters[], uint32_t num_elems, const hash_t hashes[],
-                           HashTableEntry *entries[], KeyEqFn key_eq_fn, InitAggFn init_agg_fn);
+                           HashTableEntry *entries[], KeyEqFn key_eq_fn, InitAggFn init_agg_fn, bool partitioned);
 
   // Called from ProcessBatch() to update only the valid entries in the input
   // vector
@@ -337,6 +376,21 @@ class EXPORT AggregationHashTable {
   // The number of bits to shift the hash value to determine its overflow
   // partition.
   uint64_t partition_shift_bits_;
+  // The number of leading entries that were moved to the overflow partitions.
+  // All later entries are in the hash table.
+  uint64_t num_flushed_entries_;
+
+  // -------------------------------------------------------
+  // Adaptive pre-aggregation
+  // -------------------------------------------------------
+
+  // The number of input tuples and of groups they created since the reduction
+  // of the input was last checked.
+  uint64_t pre_agg_num_input_;
+  uint64_t pre_agg_num_groups_;
+  // The number of input tuples still to pass through to the overflow
+  // partitions before pre-aggregating again.
+  uint64_t pass_through_remaining_;
 
   // Runtime stats.
   Stats stats_;
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "catalog/catalog_defs.h"
+#include "common/managed_pointer.h"
+#include "common/spin_latch.h"
+#include "storage/projected_row.h"
+#include "storage/storage_defs.h"
+#include "type/type_id.h"
+
+namespace terrier::catalog {
+class CatalogAccessor;
+}  // namespace terrier::catalog
+
+namespace terrier::storage {
+class SqlTable;
+}  // namespace terrier::storage
+
+namespace terrier::transaction {
+class TransactionContext;
+}  // namespace terrier::transaction
+
+namespace terrier::execution::sql {
+
+/**
+ * Bulk loads a CSV file into a table for COPY ... FROM. The file is split into chunks on row boundaries that are
+ * parsed in parallel. Each parsing task buffers its rows and inserts them into the table in batches. Index entries are
+ * built in a single pass once all of the table data has been loaded, instead of row by row.
+ *
+ * CSV fields follow Postgres' CSV format: fields map to the table's columns in order, an unquoted empty field is
+ * NULL, and a quoted field may contain delimiters, newlines and escaped quotes.
+ */
+class CSVLoader {
+ public:
+  /**
+   * Smallest number of bytes of the file handed to a single parsing task
+   */
+  static constexpr uint64_t MIN_CHUNK_SIZE = 1 << 20;
+
+  /**
+   * Number of parsed rows a parsing task buffers before inserting them into the table
+   */
+  static constexpr uint32_t INSERT_BATCH_SIZE = 1024;
+
+  /**
+   * Creates a loader for the given table.
+   * @param txn transaction to load the data in
+   * @param accessor catalog accessor for the table's database
+   * @param db_oid database of the table
+   * @param table_oid table to load the data into
+   * @param delimiter field delimiter character
+   * @param quote quote character
+   * @param escape escape character for quotes within quoted fields
+   */
+  CSVLoader(common::ManagedPointer<transaction::TransactionContext> txn,
+            common::ManagedPointer<catalog::CatalogAccessor> accessor, catalog::db_oid_t db_oid,
+            catalog::table_oid_t table_oid, char delimiter, char quote, char escape);
+
+  /**
+   * Load the contents of a CSV file into the table, along with all of its indexes.
+   * @param file_path path of the file to load
+   * @return number of rows loaded
+   * @throw ExecutionException if the file cannot be read or violates a unique index, ConversionException if the file
+   * contains malformed data. In both cases the transaction must abort.
+   */
+  uint64_t Load(const std::string &file_path);
+
+  /**
+   * Load CSV data that is already in memory, e.g., sent by the client for COPY ... FROM STDIN, into the table, along
+   * with all of its indexes.
+   * @param data CSV data
+   * @param size number of bytes of data
+   * @return number of rows loaded
+   * @throw ExecutionException if the data violates a unique index, ConversionException if the data is malformed. In
+   * both cases the transaction must abort.
+   */
+  uint64_t Load(const char *data, uint64_t size);
+
+ private:
+  // A range of the file that starts and ends on row boundaries
+  struct Chunk {
+    const char *begin_;
+    const char *end_;
+  };
+
+  std::vector<Chunk> SplitIntoChunks(const char *data, uint64_t size) const;
+
+  void LoadChunk(const Chunk &chunk);
+
+  const char *ParseRow(const char *pos, const char *end, storage::ProjectedRow *row, std::string *scratch) const;
+
+  void WriteColumn(storage::ProjectedRow *row, uint32_t col_idx, const char *data, size_t len, bool is_null) const;
+
+  void InsertBatch(const byte *rows, uint32_t num_rows);
+
+  void FreeVarlens(byte *rows, uint32_t num_rows) const;
+
+  void BuildIndexes();
+
+  static std::vector<catalog::col_oid_t> TableColumnOids(common::ManagedPointer<catalog::CatalogAccessor> accessor,
+                                                         catalog::table_oid_t table_oid);
+
+  const common::ManagedPointer<transaction::TransactionContext> txn_;
+  const common::ManagedPointer<catalog::CatalogAccessor> accessor_;
+  const catalog::db_oid_t db_oid_;
+  const catalog::table_oid_t table_oid_;
+  const char delimiter_;
+  const char quote_;
+  const char escape_;
+  const common::ManagedPointer<storage::SqlTable> table_;
+
+  // Table columns in CSV order, i.e., schema order
+  const std::vector<catalog::col_oid_t> col_oids_;
+  std::vector<type::TypeId> col_types_;
+  std::vector<bool> col_nullable_;
+  std::vector<uint16_t> col_offsets_;
+  const storage::ProjectedRowInitializer row_initializer_;
+  // Distance between two rows in a parsing task's buffer, keeping each row 8-byte aligned
+  const uint32_t row_stride_;
+
+  // The transaction's undo and redo buffers are not thread-safe, so inserts from different tasks are serialized
+  common::SpinLatch insert_latch_;
+  std::vector<storage::TupleSlot> slots_;
+};
+
+}  // namespace terrier::execution::sql
@@ -10,6 +10,8 @@ class ExecutionContext;
 
 namespace terrier::execution::sql {
 
+class LikePattern;
+
 /**
  * Utility class to handle SQL string manipulations.
  */
@@ -128,6 +130,16 @@ class EXPORT StringFunctions {
    */
   static void Position(exec::ExecutionContext *ctx, Integer *pos, const StringVal &search_str,
                        const StringVal &search_sub_str);
+
+  /**
+   * Check whether the given string matches the given SQL LIKE pattern, using the default escape character
+   */
+  static void Like(exec::ExecutionContext *ctx, BoolVal *result, const StringVal &str, const StringVal &pattern);
+
+  /**
+   * Check whether the given string matches the given compiled SQL LIKE pattern
+   */
+  static void Like(BoolVal *result, const StringVal &str, const LikePattern &pattern);
 };
 
 }  // namespace terrier::execution::sql
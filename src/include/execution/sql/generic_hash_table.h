@@ -68,6 +68,16 @@ class GenericHashTable {
   template <bool Concurrent>
   void InsertTagged(HashTableEntry *new_entry, hash_t hash);
 
+  /**
+   * Insert a run of entries into the hash table, ignoring tagging. All entries
+   * must hash into a range of buckets that no other thread inserts into at the
+   * same time, so that disjoint ranges can be filled in parallel without
+   * atomic read-modify-writes.
+   * @param entries The entries to insert
+   * @param num_entries The number of entries to insert
+   */
+  void InsertRun(HashTableEntry *const entries[], uint64_t num_entries);
+
   /**
    * Explicitly set the size of the hash table to support at least @em new_size
    * elements with good performance.
@@ -116,7 +126,7 @@ class GenericHashTable {
   /**
    * Return the number of elements stored in this hash table
    */
-  uint64_t NumElements() const { return num_elems_; }
+  uint64_t NumElements() const { return num_elems_.load(std::memory_order_relaxed); }
 
   /**
    * Return the maximum number of elements this hash table can store at its
@@ -158,6 +168,17 @@ class GenericHashTable {
     return reinterpret_cast<HashTableEntry *>(new_tagged_ptr);
   }
 
+  // Add to the number of elements. Concurrent inserts need an atomic add, but
+  // a serial insert can get away with a plain read and write.
+  template <bool Concurrent>
+  void IncrementNumElements(const uint64_t num_new_elems) {
+    if constexpr (Concurrent) {
+      num_elems_.fetch_add(num_new_elems, std::memory_order_relaxed);
+    } else {  // NOLINT
+      num_elems_.store(num_elems_.load(std::memory_order_relaxed) + num_new_elems, std::memory_order_relaxed);
+    }
+  }
+
   static uint64_t TagHash(const hash_t hash) {
     // We use the given hash value to obtain a bit position in the tag to set.
     // Thus, we need to extract a sample/signature from the hash value in the
@@ -179,7 +200,7 @@ class GenericHashTable {
   uint64_t capacity_{0};
 
   // The current number of elements stored in the table
-  uint64_t num_elems_{0};
+  std::atomic<uint64_t> num_elems_{0};
 
   // The current load-factor
   float load_factor_;
@@ -226,7 +247,7 @@ inline void GenericHashTable::Insert(HashTableEntry *new_entry, hash_t hash) {
     loc.store(new_entry, std::memory_order_relaxed);
   }
 
-  num_elems_++;
+  IncrementNumElements<Concurrent>(1);
 }
 
 template <bool Concurrent>
@@ -251,7 +272,25 @@ inline void GenericHashTable::InsertTagged(HashTableEntry *new_entry, hash_t has
     loc.store(UpdateTag(old_entry, new_entry), std::memory_order_relaxed);
   }
 
-  num_elems_++;
+  IncrementNumElements<Concurrent>(1);
+}
+
+inline void GenericHashTable::InsertRun(HashTableEntry *const entries[], const uint64_t num_entries) {
+  for (uint64_t idx = 0, prefetch_idx = common::Constants::K_PREFETCH_DISTANCE; idx < num_entries;
+       idx++, prefetch_idx++) {
+    // The entries are scattered in memory, so fetch them ahead of linking them
+    if (LIKELY(prefetch_idx < num_entries)) {
+      util::Prefetch<false, Locality::Low>(entries[prefetch_idx]);
+    }
+
+    HashTableEntry *const entry = entries[idx];
+    std::atomic<HashTableEntry *> &loc = entries_[entry->hash_ & mask_];
+    entry->next_ = loc.load(std::memory_order_relaxed);
+    loc.store(entry, std::memory_order_relaxed);
+  }
+
+  // Runs are inserted concurrently, but into disjoint buckets
+  IncrementNumElements<true>(num_entries);
 }
 
 template <typename F>
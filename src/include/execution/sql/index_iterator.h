@@ -1,18 +1,43 @@
 #pragma once
 
+#include <array>
 #include <memory>
+#include <utility>
 #include <vector>
 #include "catalog/catalog_defs.h"
+#include "common/constants.h"
 #include "execution/exec/execution_context.h"
 #include "execution/sql/projected_columns_iterator.h"
+#include "storage/index/index_scan_cursor.h"
 #include "storage/storage_defs.h"
 
 namespace terrier::execution::sql {
 /**
  * Allows iteration for indices from TPL.
+ *
+ * Tuples are fetched from the table a batch at a time: the slots of up to BATCH_SIZE index entries are selected
+ * together, with the table memory of upcoming tuples prefetched, into an array of projected rows that Advance() then
+ * walks. Ascending scans started with StreamAscending() also pull the index entries themselves a batch at a time, so
+ * they use bounded memory and stop reading the index as soon as the consumer stops advancing.
+ *
+ * An iterator initialized with InitCovering() never reads the table. Its rows are index keys instead, for scans that
+ * only need key columns.
+ *
+ * Exact lookups can also be batched: keys collected with AddKey() are looked up together by ScanKeys(), which lets the
+ * index share work across them, and their results are then iterated key by key with ScanNextKey().
  */
 class EXPORT IndexIterator {
  public:
+  /**
+   * Maximum number of tuples fetched from the table at once
+   */
+  static constexpr uint32_t BATCH_SIZE = 128;
+
+  /**
+   * Maximum number of keys looked up by a single ScanKeys() call
+   */
+  static constexpr uint32_t KEY_BATCH_SIZE = common::Constants::K_DEFAULT_VECTOR_SIZE;
+
   /**
    * Constructor
    * @param exec_ctx execution containing of this query
@@ -30,6 +55,13 @@ class EXPORT IndexIterator {
    */
   void Init();
 
+  /**
+   * Initialize the projected rows for a covering scan. TablePR() then returns the key of the current entry, laid out
+   * like PR(), and the table is not read at all. The index must support key retrieval, and only ScanKey and
+   * StreamAscending can be used.
+   */
+  void InitCovering();
+
   /**
    * Frees allocated resources.
    */
@@ -40,6 +72,22 @@ class EXPORT IndexIterator {
    */
   void ScanKey();
 
+  /**
+   * Add the key currently in PR() to the keys looked up by the next call to ScanKeys()
+   */
+  void AddKey();
+
+  /**
+   * Look up all the keys added since the last call at once, using the index's batched ScanKeys
+   */
+  void ScanKeys();
+
+  /**
+   * Start iterating over the entries of the next key looked up by the last call to ScanKeys(), in the order the keys
+   * were added
+   */
+  void ScanNextKey();
+
   /**
    * Perform an ascending scan
    * @param scan_type Type of Scan
@@ -47,6 +95,15 @@ class EXPORT IndexIterator {
    */
   void ScanAscending(storage::index::ScanType scan_type, uint32_t limit);
 
+  /**
+   * Perform an ascending scan that reads the index incrementally, as the iterator is advanced. Unlike ScanAscending,
+   * entries inserted into the scanned range while iterating may be visited, so this must not be used when the consumer
+   * modifies the index.
+   * @param scan_type Type of Scan
+   * @param limit number of tuples to limit
+   */
+  void StreamAscending(storage::index::ScanType scan_type, uint32_t limit);
+
   /**
    * Perfrom a descending scan
    */
@@ -79,31 +136,64 @@ class EXPORT IndexIterator {
   storage::ProjectedRow *HiPR() { return hi_index_pr_; }
 
   /**
-   * Perform a select.
-   * @return The resulting projected row.
+   * @return The table row of the current tuple, or its index key for a covering scan.
    */
-  storage::ProjectedRow *TablePR();
+  storage::ProjectedRow *TablePR() { return table_prs_[curr_row_ - 1]; }
 
   /**
    * @return The current tuple slot of the iterator.
    */
-  storage::TupleSlot CurrentSlot() { return tuples_[curr_index_ - 1]; }
+  storage::TupleSlot CurrentSlot() { return row_slots_[curr_row_ - 1]; }
 
  private:
+  // Allocate the rows of a batch, and the index PRs
+  void InitBuffers(const storage::ProjectedRowInitializer &row_initializer);
+
+  // Reset the iterator for a new scan
+  void ResetScan();
+
+  // Fetch the table rows of the next batch of index entries. Return false if there are no more.
+  bool FetchBatch();
+
+  // Fetch the keys of the next batch of index entries for a covering scan. Return false if there are no more.
+  bool FetchKeyBatch();
+
   exec::ExecutionContext *exec_ctx_;
   uint32_t num_attrs_;
   std::vector<catalog::col_oid_t> col_oids_;
   common::ManagedPointer<storage::index::Index> index_;
   common::ManagedPointer<storage::SqlTable> table_;
 
-  uint32_t curr_index_ = 0;
   void *index_buffer_;
   void *hi_index_buffer_;
   void *table_buffer_;
+  uint32_t table_buffer_size_;
+  bool covering_ = false;
   storage::ProjectedRow *index_pr_;
   storage::ProjectedRow *hi_index_pr_;
-  storage::ProjectedRow *table_pr_;
+  // One table row (or index key, for covering scans) per tuple in a batch
+  std::array<storage::ProjectedRow *, BATCH_SIZE> table_prs_;
+  std::array<storage::TupleSlot, BATCH_SIZE> row_slots_;
+  // Number of visible rows in the current batch, and one past the position of the current row
+  uint32_t num_rows_ = 0;
+  uint32_t curr_row_ = 0;
+
+  // Either all the index entries of the scan, or (for streaming scans) the most recent batch of them
   std::vector<storage::TupleSlot> tuples_{};
+  // Position of the next entry of tuples_ to fetch
+  uint32_t next_tuple_ = 0;
+  // Source of more entries once tuples_ is used up, for streaming scans
+  std::unique_ptr<storage::index::IndexScanCursor> cursor_;
+
+  // Keys added for the next batched lookup. Their buffer is only allocated once a key is added.
+  void *keys_buffer_ = nullptr;
+  uint32_t keys_buffer_size_ = 0;
+  std::vector<storage::ProjectedRow *> keys_{};
+  uint32_t num_keys_ = 0;
+  // Entries found by the last batched lookup, the range of them belonging to each key, and the next key to scan
+  std::vector<storage::TupleSlot> key_values_{};
+  std::vector<std::pair<uint32_t, uint32_t>> key_ranges_{};
+  uint32_t next_key_ = 0;
 };
 
 }  // namespace terrier::execution::sql
@@ -36,6 +36,11 @@ class EXPORT JoinHashTable {
    */
   static constexpr uint32_t K_DEFAULT_HLL_PRECISION = 10;
 
+  /**
+   * Maximum number of partitions of a radix-partitioned build
+   */
+  static constexpr uint32_t K_MAX_RADIX_PARTITIONS = 1024;
+
   /**
    * Construct a join hash table. All memory allocations are sourced from the
    * injected @em memory, and thus, are ephemeral.
@@ -68,6 +73,11 @@ class EXPORT JoinHashTable {
   /**
    * Fully construct the join hash table. Nothing is done if the join hash table
    * has already been built. After building, the table becomes read-only.
+   *
+   * A generic join index that does not fit in cache is built with radix
+   * partitioning: the build tuples are first partitioned by the bucket range
+   * they hash into, and then each partition is inserted in parallel while its
+   * slice of the directory stays in cache.
    */
   void Build();
 
@@ -91,7 +101,9 @@ class EXPORT JoinHashTable {
 
   /**
    * Merge all thread-local hash tables stored in the state contained into this
-   * table. Perform the merge in parallel.
+   * table. Perform the merge in parallel. Like @em Build(), a join index that
+   * does not fit in cache is built from radix partitions of the thread-local
+   * tuples.
    * @param thread_state_container The container for all thread-local tables
    * @param jht_offset The offset in the state where the hash table is
    */
@@ -153,6 +165,28 @@ class EXPORT JoinHashTable {
   template <bool Prefetch>
   void BuildGenericHashTableInternal() noexcept;
 
+  // A range [begin_, end_) of the buffered tuples of a join hash table
+  struct EntryRange {
+    JoinHashTable *table_;
+    uint64_t begin_;
+    uint64_t end_;
+  };
+
+  // The number of radix partitions to build the generic hash table with, once
+  // it has been sized. Each partition covers a slice of the directory that
+  // fits in the L2 cache.
+  uint32_t NumRadixPartitions() const;
+
+  // Dispatched from BuildGenericHashTable() and MergeParallel() to radix
+  // partition the entries in the given ranges, one worker per range, and to
+  // insert each partition into the generic hash table in parallel
+  void BuildGenericHashTablePartitioned(const std::vector<EntryRange> &ranges, uint32_t num_partitions);
+
+  // Called from BuildGenericHashTablePartitioned() to scatter one range of
+  // entries into the partitions, starting at the given offset of each
+  void ScatterToPartitions(const EntryRange &range, uint32_t num_partitions, uint64_t radix_shift,
+                           uint64_t partition_offsets[], HashTableEntry *partitioned[]);
+
   // Dispatched from BuildConciseHashTable() to construct the concise hash table
   // and to reorder buffered build tuples in place according to the CHT
   template <bool PrefetchCHT, bool PrefetchEntries>
@@ -185,6 +219,10 @@ class EXPORT JoinHashTable {
   template <bool Prefetch, bool Concurrent>
   void MergeIncomplete(JoinHashTable *source);
 
+  // Merge all source hash tables (which aren't built yet) into this one by
+  // radix partitioning their entries
+  void MergePartitioned(const std::vector<JoinHashTable *> &sources, uint32_t num_partitions);
+
  private:
   // The vector where we store the build-side input
   util::ChunkedVector<MemoryPoolAllocator<byte>> entries_;
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include "common/macros.h"
+#include "execution/util/execution_common.h"
+#include "execution/util/string_search.h"
+#include "storage/storage_defs.h"
+
+namespace terrier::execution::sql {
+
+/**
+ * A compiled SQL LIKE pattern. '%' matches any sequence of characters, '_' matches any single character, and the
+ * escape character makes the following character match literally.
+ *
+ * Most patterns in practice are of the forms 'abc', 'abc%', '%abc' or '%abc%'. These are recognized when the pattern
+ * is compiled and matched with a single comparison or substring search, instead of the general backtracking matcher.
+ */
+class EXPORT LikePattern {
+ public:
+  /**
+   * The default escape character, as in Postgres
+   */
+  static constexpr char DEFAULT_ESCAPE = '\\';
+
+  /**
+   * The shape of a pattern, which determines how it is matched
+   */
+  enum class Kind : uint8_t {
+    /** No wildcards; the string must equal the literal */
+    EXACT,
+    /** 'literal%': the string must start with the literal */
+    PREFIX,
+    /** '%literal': the string must end with the literal */
+    SUFFIX,
+    /** '%literal%': the string must contain the literal */
+    CONTAINS,
+    /** Anything else, matched with the general matcher */
+    GENERIC
+  };
+
+  /**
+   * Compile a LIKE pattern
+   * @param pattern The pattern
+   * @param escape The escape character
+   */
+  explicit LikePattern(std::string_view pattern, char escape = DEFAULT_ESCAPE);
+
+  /**
+   * @return The shape of this pattern
+   */
+  Kind GetKind() const { return kind_; }
+
+  /**
+   * @return The pattern, as it was compiled
+   */
+  const std::string &Pattern() const { return pattern_; }
+
+  /**
+   * @return The escape character
+   */
+  char Escape() const { return escape_; }
+
+  /**
+   * @return For all kinds but GENERIC, the unescaped literal part of the pattern
+   */
+  const std::string &Literal() const { return literal_; }
+
+  /**
+   * Match a string against this pattern
+   * @param str The string
+   * @param len The length of the string
+   * @return True if the string matches the pattern; false otherwise
+   */
+  bool Matches(const char *str, std::size_t len) const {
+    switch (kind_) {
+      case Kind::EXACT:
+        return len == literal_.size() && std::memcmp(str, literal_.data(), len) == 0;
+      case Kind::PREFIX:
+        return len >= literal_.size() && std::memcmp(str, literal_.data(), literal_.size()) == 0;
+      case Kind::SUFFIX:
+        return len >= literal_.size() &&
+               std::memcmp(str + len - literal_.size(), literal_.data(), literal_.size()) == 0;
+      case Kind::CONTAINS:
+        return util::StringSearch::Find(str, len, literal_.data(), literal_.size()) != nullptr;
+      default:
+        return GenericMatch(str, len, pattern_.data(), pattern_.size(), escape_);
+    }
+  }
+
+  /**
+   * Match a varlen against this pattern. Strings with a mismatching prefix are rejected using the prefix bytes stored
+   * in the entry itself, without dereferencing the content of out-of-line strings.
+   * @param varlen The varlen entry
+   * @return True if the string matches the pattern; false otherwise
+   */
+  bool Matches(const storage::VarlenEntry &varlen) const {
+    if (kind_ == Kind::EXACT || kind_ == Kind::PREFIX) {
+      const auto check_len = std::min<std::size_t>(
+          {literal_.size(), varlen.Size(), static_cast<std::size_t>(storage::VarlenEntry::PrefixSize())});
+      if (std::memcmp(varlen.Prefix(), literal_.data(), check_len) != 0) return false;
+    }
+    return Matches(reinterpret_cast<const char *>(varlen.Content()), varlen.Size());
+  }
+
+  /**
+   * Match a string against a LIKE pattern without compiling it first
+   * @param str The string
+   * @param str_len The length of the string
+   * @param pattern The pattern
+   * @param pattern_len The length of the pattern
+   * @param escape The escape character
+   * @return True if the string matches the pattern; false otherwise
+   */
+  static bool GenericMatch(const char *str, std::size_t str_len, const char *pattern, std::size_t pattern_len,
+                           char escape = DEFAULT_ESCAPE);
+
+ private:
+  std::string pattern_;
+  char escape_;
+  Kind kind_;
+  std::string literal_;
+};
+
+}  // namespace terrier::execution::sql
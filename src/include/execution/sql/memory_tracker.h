@@ -2,6 +2,9 @@
 
 #include <tbb/enumerable_thread_specific.h>
 
+#include <atomic>
+#include <limits>
+
 namespace terrier::execution::sql {
 
 /**
@@ -19,25 +22,39 @@ class MemoryTracker {
   /**
    * @returns number of allocated bytes
    */
-  size_t GetAllocatedSize() { return allocated_bytes_; }
+  size_t GetAllocatedSize() { return allocated_bytes_.load(std::memory_order_relaxed); }
 
   /**
    * Increments number of allocated bytes
    * @param size number to increment by
    */
-  void Increment(size_t size) { allocated_bytes_ += size; }
+  void Increment(size_t size) { allocated_bytes_.fetch_add(size, std::memory_order_relaxed); }
 
   /**
    * Decrements number of allocated bytes
    * @param size number to decrement by
    */
-  void Decrement(size_t size) { allocated_bytes_ -= size; }
+  void Decrement(size_t size) { allocated_bytes_.fetch_sub(size, std::memory_order_relaxed); }
+
+  /**
+   * Set the memory budget of operators that can spill to disk. A sorter spills once the tuples it buffers take up
+   * this many bytes. There is no budget by default.
+   * @param limit number of bytes
+   */
+  void SetMemoryLimit(size_t limit) { memory_limit_ = limit; }
+
+  /**
+   * @returns the memory budget in bytes
+   */
+  size_t GetMemoryLimit() const { return memory_limit_; }
 
  private:
   struct Stats {};
   tbb::enumerable_thread_specific<Stats> stats_;
   // number of bytes allocated
-  size_t allocated_bytes_;
+  std::atomic<size_t> allocated_bytes_{0};
+  // the memory budget
+  size_t memory_limit_{std::numeric_limits<size_t>::max()};
 };
 
 }  // namespace terrier::execution::sql
@@ -1,10 +1,14 @@
 #pragma once
 
 #include <limits>
+#include <memory>
 #include <type_traits>
+#include <vector>
 #include "storage/projected_columns.h"
 
+#include "common/constants.h"
 #include "common/macros.h"
+#include "execution/sql/like_pattern.h"
 #include "execution/util/bit_util.h"
 #include "execution/util/execution_common.h"
 #include "type/type_id.h"
@@ -22,6 +26,13 @@ class EXPORT ProjectedColumnsIterator {
   static constexpr const uint32_t K_INVALID_POS = std::numeric_limits<uint32_t>::max();
 
  public:
+  /**
+   * Index of the first computed column. Computed columns hold the BIGINT results of vectorized arithmetic over the
+   * selected tuples. They follow the columns of the projection in the same index space, so that they can be operands
+   * of further arithmetic.
+   */
+  static constexpr const uint32_t COMPUTED_COL_START = common::Constants::MAX_COL;
+
   /**
    * Create an empty iterator over an empty projection
    */
@@ -70,6 +81,14 @@ class EXPORT ProjectedColumnsIterator {
   template <typename T, bool nullable>
   const T *Get(uint32_t col_idx, bool *null) const;
 
+  /**
+   * Get a pointer to the value in the computed column at index @em col_idx
+   * @param col_idx The index of the computed column to read from
+   * @param[out] null Whether the value is null
+   * @return The value at the current iterator position in the computed column
+   */
+  const int64_t *GetComputed(uint32_t col_idx, bool *null) const;
+
   /**
    * Set the current iterator position
    * @tparam IsFiltered Is this iterator filtered?
@@ -213,12 +232,82 @@ class EXPORT ProjectedColumnsIterator {
   template <template <typename> typename Op>
   uint32_t FilterColByCol(uint32_t col_idx_1, type::TypeId type_1, uint32_t col_idx_2, type::TypeId type_2);
 
+  /**
+   * Filter the string column at index @em col_idx by the given constant string @em val. NULL strings never pass.
+   * @tparam Op The filtering operator, applied to the column value and @em val in lexicographical byte order.
+   * @param col_idx The index of the column in the projection to filter.
+   * @param val The value to filter on.
+   * @return The number of selected elements.
+   */
+  template <template <typename> typename Op>
+  uint32_t FilterColByString(uint32_t col_idx, const storage::VarlenEntry &val);
+
+  /**
+   * Filter the string column at index @em col_idx by a LIKE (or NOT LIKE) pattern. NULL strings never pass.
+   * @param col_idx The index of the column in the projection to filter.
+   * @param pattern The compiled LIKE pattern.
+   * @param negated True for NOT LIKE; false for LIKE.
+   * @return The number of selected elements.
+   */
+  uint32_t FilterColByLike(uint32_t col_idx, const LikePattern &pattern, bool negated);
+
+  /**
+   * Compute the column at index @em out_idx as the results of an arithmetic operation between the columns at index
+   * @em col_idx_1 and @em col_idx_2, for every selected tuple. A result is NULL if either operand is. Results that
+   * overflow wrap around, like those of ArithmeticFunctions.
+   * @tparam Op The arithmetic operation.
+   * @param out_idx The index of the computed column to write.
+   * @param col_idx_1 The index of the left operand column, in the projection or computed.
+   * @param type_1 The type of the left operand column. Computed columns are BIGINT.
+   * @param col_idx_2 The index of the right operand column, in the projection or computed.
+   * @param type_2 The type of the right operand column. Computed columns are BIGINT.
+   * @param[out] overflow Whether the operation overflowed for any of the non-NULL results.
+   */
+  template <template <typename> typename Op>
+  void ComputeColByCol(uint32_t out_idx, uint32_t col_idx_1, type::TypeId type_1, uint32_t col_idx_2,
+                       type::TypeId type_2, bool *overflow);
+
+  /**
+   * Compute the column at index @em out_idx as the results of an arithmetic operation between the column at index
+   * @em col_idx and the constant value @em val, for every selected tuple. A result is NULL if the column value is.
+   * Results that overflow wrap around, like those of ArithmeticFunctions.
+   * @tparam Op The arithmetic operation.
+   * @param out_idx The index of the computed column to write.
+   * @param col_idx The index of the operand column, in the projection or computed.
+   * @param type The type of the operand column. Computed columns are BIGINT.
+   * @param val The constant value.
+   * @param val_on_left Whether the constant value is the left operand of the operation.
+   * @param[out] overflow Whether the operation overflowed for any of the non-NULL results.
+   */
+  template <template <typename> typename Op>
+  void ComputeColByVal(uint32_t out_idx, uint32_t col_idx, type::TypeId type, int64_t val, bool val_on_left,
+                       bool *overflow);
+
   /**
    * Return the number of selected tuples after any filters have been applied
    */
   uint32_t NumSelected() const { return num_selected_; }
 
  private:
+  // The values of a computed column, and whether each is NULL, by position in the projection
+  struct ComputedColumn {
+    alignas(common::Constants::CACHELINE_SIZE) int64_t values_[common::Constants::K_DEFAULT_VECTOR_SIZE];
+    bool nulls_[common::Constants::K_DEFAULT_VECTOR_SIZE];
+  };
+
+  // Get the computed column at the given index to write into, allocating it on first use
+  ComputedColumn *GetComputedColumnForWrite(uint32_t out_idx);
+
+  // Call the function with the typed values of an integer column, in the projection or computed
+  template <typename F>
+  void DispatchIntegerColumn(uint32_t col_idx, type::TypeId type, const F &fn) const;
+
+  // Is the value of a column, in the projection or computed, NULL at the given position?
+  bool IsNullAt(uint32_t col_idx, uint32_t idx) const;
+
+  // The value of an integer column, in the projection or computed, at the given position
+  int64_t IntegerAt(uint32_t col_idx, type::TypeId type, uint32_t idx) const;
+
   // Filter a column by a constant value
   template <typename T, template <typename> typename Op>
   uint32_t FilterColByValImpl(uint32_t col_idx, T val);
@@ -227,6 +316,10 @@ class EXPORT ProjectedColumnsIterator {
   template <typename T, template <typename> typename Op>
   uint32_t FilterColByColImpl(uint32_t col_idx_1, uint32_t col_idx_2);
 
+  // Filter a varlen column by an arbitrary predicate over its non-NULL values
+  template <typename P>
+  uint32_t FilterVarlenColImpl(uint32_t col_idx, const P &predicate);
+
  private:
   // The selection vector used to filter the ProjectedColumns
   alignas(common::Constants::CACHELINE_SIZE) uint32_t selection_vector_[common::Constants::K_DEFAULT_VECTOR_SIZE];
@@ -245,6 +338,9 @@ class EXPORT ProjectedColumnsIterator {
 
   // The next slot in the selection vector to write into
   uint32_t selection_vector_write_idx_{0};
+
+  // The computed columns, by index after COMPUTED_COL_START. Their values are only valid for the selected tuples.
+  std::vector<std::unique_ptr<ComputedColumn>> computed_columns_;
 };
 
 // ---------------------------------------------------------
@@ -267,6 +363,14 @@ inline const T *ProjectedColumnsIterator::Get(uint32_t col_idx, bool *null) cons
   return &col_data[curr_idx_];
 }
 
+inline const int64_t *ProjectedColumnsIterator::GetComputed(uint32_t col_idx, bool *null) const {
+  TERRIER_ASSERT(col_idx >= COMPUTED_COL_START && col_idx - COMPUTED_COL_START < computed_columns_.size(),
+                 "Computed column was never computed");
+  const auto &computed = *computed_columns_[col_idx - COMPUTED_COL_START];
+  *null = computed.nulls_[curr_idx_];
+  return &computed.values_[curr_idx_];
+}
+
 template <bool Filtered>
 inline void ProjectedColumnsIterator::SetPosition(uint32_t idx) {
   TERRIER_ASSERT(idx < NumSelected(), "Out of bounds access");
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstdio>
+#include <vector>
+
+#include "common/macros.h"
+#include "common/managed_pointer.h"
+#include "common/strong_typedef.h"
+#include "execution/sql/memory_tracker.h"
+
+namespace terrier::execution::sql {
+
+/**
+ * A sorted run of fixed-size tuples that a sorter spilled to a temporary file after going over its memory budget.
+ * Tuples are written out byte for byte, so anything they point to must outlive the run. A run is written once, front
+ * to back, and then read by any number of threads at once. The write buffer is charged to a memory tracker until
+ * the run is finished.
+ */
+class SortRun {
+ public:
+  /**
+   * The number of bytes written to or read from a run file at a time
+   */
+  static constexpr uint64_t K_IO_SIZE = 1 << 20;
+
+  /**
+   * Create an empty run in a new temporary file, which is deleted along with the run.
+   * @param tuple_size The size of the tuples in bytes
+   * @param tracker The tracker to charge the write buffer to, or nullptr
+   * @throw ExecutionException if the file can't be created
+   */
+  SortRun(uint32_t tuple_size, common::ManagedPointer<MemoryTracker> tracker);
+
+  /**
+   * Destructor
+   */
+  ~SortRun();
+
+  /**
+   * This class cannot be copied or moved
+   */
+  DISALLOW_COPY_AND_MOVE(SortRun);
+
+  /**
+   * Append a tuple to the end of the run. The tuple may only be read back after @em FinishWriting().
+   * @param tuple The tuple to append
+   * @throw ExecutionException if the file can't be written to
+   */
+  void Append(const byte *tuple) {
+    if (write_buffer_.size() + tuple_size_ > write_buffer_.capacity()) {
+      FlushWriteBuffer();
+    }
+    write_buffer_.insert(write_buffer_.end(), tuple, tuple + tuple_size_);
+    num_tuples_++;
+  }
+
+  /**
+   * Write out all appended tuples, after which the run is read-only.
+   * @throw ExecutionException if the file can't be written to
+   */
+  void FinishWriting();
+
+  /**
+   * Read tuples [begin, begin + num_tuples) of the run into the given buffer.
+   * @param begin The index of the first tuple to read
+   * @param num_tuples The number of tuples to read
+   * @param[out] tuples Where to write the tuples to, with room for @em num_tuples tuples
+   * @throw ExecutionException if the file can't be read from
+   */
+  void Read(uint64_t begin, uint64_t num_tuples, byte *tuples) const;
+
+  /**
+   * @return The number of tuples in the run
+   */
+  uint64_t NumTuples() const { return num_tuples_; }
+
+  /**
+   * @return The size of the tuples in bytes
+   */
+  uint32_t TupleSize() const { return tuple_size_; }
+
+ private:
+  void FlushWriteBuffer();
+
+  // Give the memory of the write buffer back
+  void ReleaseWriteBuffer();
+
+  // The size of the tuples
+  const uint32_t tuple_size_;
+  // The number of tuples in the run
+  uint64_t num_tuples_;
+  // The temporary file
+  std::FILE *file_;
+  // Appended tuples not yet written to the file
+  std::vector<byte> write_buffer_;
+  // The tracker the write buffer is charged to
+  common::ManagedPointer<MemoryTracker> tracker_;
+};
+
+/**
+ * Reads a range of tuples of a sort run from front to back, a block at a time. The read buffer is charged to a memory
+ * tracker for the lifetime of the reader.
+ */
+class SortRunReader {
+ public:
+  /**
+   * Create a reader over tuples [begin, end) of the given run.
+   * @param run The run to read
+   * @param begin The index of the first tuple to read
+   * @param end One past the index of the last tuple to read
+   * @param tracker The tracker to charge the read buffer to, or nullptr
+   * @param buffer_size The size of the read buffer in bytes. It always holds at least one tuple.
+   */
+  SortRunReader(const SortRun *run, uint64_t begin, uint64_t end, common::ManagedPointer<MemoryTracker> tracker,
+                uint64_t buffer_size = SortRun::K_IO_SIZE);
+
+  /**
+   * Destructor
+   */
+  ~SortRunReader();
+
+  /**
+   * This class cannot be copied or moved
+   */
+  DISALLOW_COPY_AND_MOVE(SortRunReader);
+
+  /**
+   * @return True if the reader is positioned on a tuple; false if it's past the end of its range
+   */
+  bool HasNext() const { return pos_ < end_; }
+
+  /**
+   * @return The current tuple. It stays valid until the reader moves on.
+   */
+  const byte *Current() const { return &buffer_[(pos_ - buffer_begin_) * run_->TupleSize()]; }
+
+  /**
+   * Move to the next tuple.
+   * @throw ExecutionException if the run can't be read from
+   */
+  void Next() {
+    if (++pos_ < end_ && pos_ == buffer_begin_ + buffer_tuples_) {
+      Fill();
+    }
+  }
+
+ private:
+  void Fill();
+
+  // The run being read
+  const SortRun *run_;
+  // The current and last positions of the reader
+  uint64_t pos_, end_;
+  // The tuples of the run that have been read, starting at buffer_begin_
+  std::vector<byte> buffer_;
+  uint64_t buffer_begin_;
+  uint64_t buffer_tuples_;
+  // The tracker the buffer is charged to
+  common::ManagedPointer<MemoryTracker> tracker_;
+};
+
+}  // namespace terrier::execution::sql
@@ -1,10 +1,17 @@
 #pragma once
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
 #include <vector>
 
 #include "common/macros.h"
 #include "execution/sql/memory_pool.h"
+#include "execution/sql/sort_run.h"
+#include "execution/sql/value.h"
 #include "execution/util/chunked_vector.h"
+#include "portable_endian/portable_endian.h"
 
 namespace terrier::execution::sql {
 
@@ -12,6 +19,20 @@ class ThreadStateContainer;
 
 /**
  * Sorters
+ *
+ * Tuples may begin with a normalized key: a few 64-bit words, built with the
+ * NormalizeKey() functions, which order tuples by comparing them as unsigned
+ * integers one word after another. A tuple with a smaller key must never be
+ * ordered after one with a larger key by the comparison function. Sorters with
+ * a normalized key radix sort on it, and only call the comparison function to
+ * break ties.
+ *
+ * Once the tuples buffered by a sorter take up the memory limit of its pool's
+ * tracker, they are sorted and spilled to disk as a run, and sorting merges the
+ * runs. Each sorter has the whole budget to itself, and never spills runs
+ * smaller than K_MIN_RUN_SIZE bytes. Runs are merged at most
+ * K_MAX_MERGE_FAN_IN at a time, in as many passes as it takes, and the I/O
+ * buffers of runs count towards the tracker. Top-K sorts never spill.
  */
 class EXPORT Sorter {
  public:
@@ -20,14 +41,32 @@ class EXPORT Sorter {
    */
   using ComparisonFunction = int32_t (*)(const void *lhs, const void *rhs);
 
+  /**
+   * The maximum number of words in a normalized key
+   */
+  static constexpr uint32_t K_MAX_KEY_WORDS = 4;
+
+  /**
+   * The smallest number of bytes of tuples spilled to disk as a run
+   */
+  static constexpr uint64_t K_MIN_RUN_SIZE = 64 * 1024;
+
+  /**
+   * The largest number of runs merged at once. It bounds the files open in and
+   * the read buffers of each merge.
+   */
+  static constexpr uint32_t K_MAX_MERGE_FAN_IN = 64;
+
   /**
    * Construct a sorter using @em memory as the memory allocator, storing tuples
    * @em tuple_size size in bytes, and using the comparison function @em cmp_fn.
    * @param memory The memory pool to allocate memory from
    * @param cmp_fn The sorting comparison function
    * @param tuple_size The sizes_ of the input tuples in bytes
+   * @param num_key_words The number of normalized key words at the start of
+   *                      each tuple
    */
-  Sorter(MemoryPool *memory, ComparisonFunction cmp_fn, uint32_t tuple_size);
+  Sorter(MemoryPool *memory, ComparisonFunction cmp_fn, uint32_t tuple_size, uint32_t num_key_words = 0);
 
   /**
    * Destructor
@@ -41,7 +80,8 @@ class EXPORT Sorter {
 
   /**
    * Allocate space for an entry in this sorter, returning a pointer with
-   * at least \a tuple_size contiguous bytes
+   * at least \a tuple_size contiguous bytes. The tuples inserted before may be
+   * spilled to disk if they take up the memory budget.
    */
   byte *AllocInputTuple();
 
@@ -94,14 +134,153 @@ class EXPORT Sorter {
   /**
    * Return the number of tuples currently in this sorter
    */
-  uint64_t NumTuples() const { return tuples_.size(); }
+  uint64_t NumTuples() const { return num_spilled_tuples_ + tuples_.size(); }
+
+  /**
+   * Return the number of sorted runs spilled to disk
+   */
+  uint64_t NumRuns() const { return runs_.size(); }
 
   /**
    * Has this sorter's contents been sorted?
    */
   bool IsSorted() const { return sorted_; }
 
+  /**
+   * Return the number of normalized key words at the start of each tuple
+   */
+  uint32_t NumKeyWords() const { return num_key_words_; }
+
+  /**
+   * Normalize a boolean sort key. NULLs sort last in ascending order.
+   * @param val The value of the key
+   * @param descending Whether the key sorts in descending order
+   * @return The normalized key word
+   */
+  static uint64_t NormalizeKey(const BoolVal &val, bool descending) {
+    return NormalizeKeyWord(val.is_null_, val.val_ ? 1 : 0, descending);
+  }
+
+  /**
+   * Normalize an integer sort key. NULLs sort last in ascending order. NULL
+   * shares its key with the largest 64-bit integer, so no key words may follow
+   * this one unless the integer is narrower.
+   * @param val The value of the key
+   * @param descending Whether the key sorts in descending order
+   * @return The normalized key word
+   */
+  static uint64_t NormalizeKey(const Integer &val, bool descending) {
+    // Flipping the sign bit orders negative numbers before positive ones
+    return NormalizeKeyWord(val.is_null_, static_cast<uint64_t>(val.val_) ^ K_SIGN_BIT, descending);
+  }
+
+  /**
+   * Normalize a floating point sort key. NULLs sort last in ascending order.
+   * NULL shares its key with a NaN, so no key words may follow this one.
+   * @param val The value of the key
+   * @param descending Whether the key sorts in descending order
+   * @return The normalized key word
+   */
+  static uint64_t NormalizeKey(const Real &val, bool descending) {
+    // Positive numbers order like their bits once the sign bit is set. Negative
+    // numbers order backwards, so all of their bits are flipped.
+    uint64_t bits;
+    std::memcpy(&bits, &val.val_, sizeof(bits));
+    return NormalizeKeyWord(val.is_null_, (bits & K_SIGN_BIT) != 0 ? ~bits : bits | K_SIGN_BIT, descending);
+  }
+
+  /**
+   * Normalize a date sort key. NULLs sort last in ascending order.
+   * @param val The value of the key
+   * @param descending Whether the key sorts in descending order
+   * @return The normalized key word
+   */
+  static uint64_t NormalizeKey(const DateVal &val, bool descending) {
+    return NormalizeKeyWord(val.is_null_, val.is_null_ ? 0 : val.val_.ToNative(), descending);
+  }
+
+  /**
+   * Normalize a timestamp sort key. NULLs sort last in ascending order. NULL
+   * shares its key with the largest timestamp, so no key words may follow this
+   * one.
+   * @param val The value of the key
+   * @param descending Whether the key sorts in descending order
+   * @return The normalized key word
+   */
+  static uint64_t NormalizeKey(const TimestampVal &val, bool descending) {
+    return NormalizeKeyWord(val.is_null_, val.is_null_ ? 0 : val.val_.ToNative(), descending);
+  }
+
+  /**
+   * Normalize a string sort key. Only the first eight bytes of the string make
+   * it into the key, so equal keys don't imply equal strings, and no key words
+   * may follow this one. NULLs sort last in ascending order.
+   * @param val The value of the key
+   * @param descending Whether the key sorts in descending order
+   * @return The normalized key word
+   */
+  static uint64_t NormalizeKey(const StringVal &val, bool descending) {
+    // Shorter strings are padded with zeros, which keeps them ordered before
+    // the longer strings they prefix
+    uint64_t prefix = 0;
+    if (!val.is_null_) {
+      std::memcpy(&prefix, val.Content(), std::min(val.len_, uint32_t(sizeof(prefix))));
+    }
+    return NormalizeKeyWord(val.is_null_, be64toh(prefix), descending);
+  }
+
  private:
+  static constexpr uint64_t K_SIGN_BIT = uint64_t(1) << 63;
+
+  // Finish a normalized key word. NULL gets the largest word, which values
+  // that use all 64 bits of the word can have as well.
+  static uint64_t NormalizeKeyWord(const bool is_null, const uint64_t word, const bool descending) {
+    const uint64_t normalized = is_null ? std::numeric_limits<uint64_t>::max() : word;
+    return descending ? ~normalized : normalized;
+  }
+
+  // Compare two tuples by their normalized keys, and then by the comparison
+  // function
+  int32_t Compare(const byte *lhs, const byte *rhs) const {
+    const auto *lhs_key = reinterpret_cast<const uint64_t *>(lhs);
+    const auto *rhs_key = reinterpret_cast<const uint64_t *>(rhs);
+    for (uint32_t i = 0; i < num_key_words_; i++) {
+      if (lhs_key[i] != rhs_key[i]) {
+        return lhs_key[i] < rhs_key[i] ? -1 : 1;
+      }
+    }
+    return cmp_fn_(lhs, rhs);
+  }
+
+  // Sort the tuples of a sorter with a normalized key
+  void SortByNormalizedKey();
+
+  // Sort the tuples buffered in memory
+  void SortInMemory();
+
+  // Allocate a tuple without ever spilling
+  byte *AllocInputTupleInMemory() {
+    byte *ret = tuple_storage_.Append();
+    tuples_.push_back(ret);
+    return ret;
+  }
+
+  // Sort the tuples buffered in memory and spill them to disk as a new run
+  void SpillRun();
+
+  // Merge at most K_MAX_MERGE_FAN_IN runs into one
+  std::unique_ptr<SortRun> MergeRuns(std::vector<std::unique_ptr<SortRun>> runs) const;
+
+  // Merge the given runs in passes until at most K_MAX_MERGE_FAN_IN are left
+  void ReduceRuns(std::vector<std::unique_ptr<SortRun>> *runs) const;
+
+  // Merge at most K_MAX_MERGE_FAN_IN runs into one run per range of the
+  // output, in parallel
+  void MergeRunsParallel(std::vector<std::unique_ptr<SortRun>> runs);
+
+  // Merges sorted runs, used to iterate over spilled sorters
+  class RunMerger;
+
   // Build a max heap from the tuples currently stored in the sorter instance
   void BuildHeap();
 
@@ -112,6 +291,10 @@ class EXPORT Sorter {
  private:
   friend class SorterIterator;
 
+  // The memory pool and the size of tuples
+  MemoryPool *memory_;
+  uint32_t tuple_size_;
+
   // Vector of entries
   util::ChunkedVector<MemoryPoolAllocator<byte>> tuple_storage_;
 
@@ -121,11 +304,28 @@ class EXPORT Sorter {
   // The comparison function
   ComparisonFunction cmp_fn_;
 
+  // The number of normalized key words at the start of each tuple
+  uint32_t num_key_words_;
+
   // Vector of pointers to each entry. This is the vector that's sorted.
   MemPoolVector<const byte *> tuples_;
 
   // Flag indicating if the contents of the sorter have been sorted
   bool sorted_;
+
+  // The number of tuples buffered in memory before they're spilled to disk
+  uint64_t max_buffered_tuples_;
+
+  // Sorted runs spilled to disk, and the number of tuples in them
+  std::vector<std::unique_ptr<SortRun>> runs_;
+  // The number of times the tuples of each run have been merged, which never
+  // increases along the runs
+  std::vector<uint32_t> run_levels_;
+  uint64_t num_spilled_tuples_;
+
+  // Whether the runs hold consecutive ranges of the sorted output and can be
+  // read one after another instead of being merged
+  bool runs_partitioned_;
 };
 
 /**
@@ -142,20 +342,35 @@ class EXPORT SorterIterator {
    * Constructor
    * @param sorter sorter to iterate over
    */
-  explicit SorterIterator(Sorter *sorter) noexcept : iter_(sorter->tuples_.begin()), end_(sorter->tuples_.end()) {}
+  explicit SorterIterator(Sorter *sorter);
+
+  /**
+   * Destructor
+   */
+  ~SorterIterator();
+
+  /**
+   * This class cannot be copied or moved
+   */
+  DISALLOW_COPY_AND_MOVE(SorterIterator);
 
   /**
    * Dereference operator
-   * @return A pointer to the current iteration row
+   * @return A pointer to the current iteration row. Rows of a spilled sorter
+   *         are only valid until the iterator is advanced.
    */
-  const byte *operator*() const noexcept { return *iter_; }
+  const byte *operator*() const noexcept { return merger_ == nullptr ? *iter_ : merged_row_; }
 
   /**
    * Pre-increment the iterator
    * @return A reference to this iterator after it's been advanced one row
    */
-  SorterIterator &operator++() noexcept {
-    ++iter_;
+  SorterIterator &operator++() {
+    if (merger_ == nullptr) {
+      ++iter_;
+    } else {
+      NextMerged();
+    }
     return *this;
   }
 
@@ -163,7 +378,7 @@ class EXPORT SorterIterator {
    * Does this iterate have more data
    * @return True if the iterator has more data; false otherwise
    */
-  bool HasNext() const { return iter_ != end_; }
+  bool HasNext() const { return merger_ == nullptr ? iter_ != end_ : merged_row_ != nullptr; }
 
   /**
    * Advance the iterator
@@ -175,7 +390,7 @@ class EXPORT SorterIterator {
    * iterator is valid.
    */
   const byte *GetRow() const {
-    TERRIER_ASSERT(iter_ != end_, "Invalid iterator");
+    TERRIER_ASSERT(HasNext(), "Invalid iterator");
     return this->operator*();
   }
 
@@ -189,10 +404,16 @@ class EXPORT SorterIterator {
   }
 
  private:
+  // Advance the merge of a spilled sorter's runs
+  void NextMerged();
+
   // The current iterator position
   IteratorType iter_;
   // The ending iterator position
   const IteratorType end_;
+  // The merge of a spilled sorter's runs, and its current row
+  std::unique_ptr<Sorter::RunMerger> merger_;
+  const byte *merged_row_;
 };
 
 }  // namespace terrier::execution::sql
@@ -2,6 +2,7 @@
 
 #include <limits>
 
+#include "common/strong_typedef.h"
 #include "execution/util/execution_common.h"
 
 namespace terrier::execution::util {
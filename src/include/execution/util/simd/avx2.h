@@ -2,6 +2,9 @@
 
 #include <immintrin.h>
 
+#include <functional>
+#include <type_traits>
+
 #include "common/macros.h"
 #include "execution/util/execution_common.h"
 #include "execution/util/simd/types.h"
@@ -960,4 +963,54 @@ static inline uint32_t FilterVectorByVector(const T *RESTRICT in_1, const T *RES
   return out_pos;
 }
 
+// ---------------------------------------------------------
+// Arithmetic
+// ---------------------------------------------------------
+
+/**
+ * Whether arithmetic over an input array of T runs in SIMD vectors of 64-bit integers. Lanes don't detect overflows, so
+ * only 32-bit inputs do, whose widened results can't overflow. AVX2 has no 64-bit multiplication, so only additions and
+ * subtractions do.
+ */
+template <typename T, template <typename> typename Op>
+constexpr bool IsVectorArithmetic() {
+  const bool supported_type = std::is_same_v<T, int32_t>;
+  const bool supported_op = std::is_same_v<Op<void>, std::plus<void>> || std::is_same_v<Op<void>, std::minus<void>>;
+  return supported_type && supported_op;
+}
+
+template <typename T, template <typename> typename Op>
+static inline void ArithmeticVectorByVal(const T *RESTRICT in, const uint32_t in_count, const int64_t val,
+                                         const bool val_on_left, int64_t *RESTRICT out, uint32_t *RESTRICT in_pos) {
+  const Op<void> op{};
+
+  const Vec4 xval(val);
+
+  Vec4 in_vec;
+  if (val_on_left) {
+    for (*in_pos = 0; *in_pos + Vec4::Size() < in_count; *in_pos += Vec4::Size()) {
+      in_vec.Load(in + *in_pos);
+      op(xval, in_vec).Store(out + *in_pos);
+    }
+  } else {
+    for (*in_pos = 0; *in_pos + Vec4::Size() < in_count; *in_pos += Vec4::Size()) {
+      in_vec.Load(in + *in_pos);
+      op(in_vec, xval).Store(out + *in_pos);
+    }
+  }
+}
+
+template <typename T, template <typename> typename Op>
+static inline void ArithmeticVectorByVector(const T *RESTRICT in_1, const T *RESTRICT in_2, const uint32_t in_count,
+                                            int64_t *RESTRICT out, uint32_t *RESTRICT in_pos) {
+  const Op<void> op{};
+
+  Vec4 in_1_vec, in_2_vec;
+  for (*in_pos = 0; *in_pos + Vec4::Size() < in_count; *in_pos += Vec4::Size()) {
+    in_1_vec.Load(in_1 + *in_pos);
+    in_2_vec.Load(in_2 + *in_pos);
+    op(in_1_vec, in_2_vec).Store(out + *in_pos);
+  }
+}
+
 }  // namespace terrier::execution::util::simd
@@ -0,0 +1,68 @@
+#pragma once
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include <cstring>
+
+#include "common/macros.h"
+#include "execution/util/execution_common.h"
+
+namespace terrier::execution::util {
+
+/**
+ * Utility class for substring search over raw byte strings.
+ */
+class StringSearch {
+ public:
+  /**
+   * Force only static functions.
+   */
+  StringSearch() = delete;
+
+  /**
+   * Find the first occurrence of @em needle in @em haystack.
+   * @param haystack The string to search in.
+   * @param haystack_len The length of the string to search in.
+   * @param needle The string to search for.
+   * @param needle_len The length of the string to search for.
+   * @return A pointer to the first occurrence of the needle in the haystack, or nullptr if it does not occur.
+   */
+  static const char *Find(const char *haystack, const std::size_t haystack_len, const char *needle,
+                          const std::size_t needle_len) {
+    if (needle_len == 0) return haystack;
+    if (needle_len > haystack_len) return nullptr;
+    if (needle_len == 1) return reinterpret_cast<const char *>(std::memchr(haystack, needle[0], haystack_len));
+
+    // Candidate positions are those where both the first and the last character of the needle match. Only those are
+    // verified with a full comparison.
+    const std::size_t last_start = haystack_len - needle_len;
+    std::size_t pos = 0;
+#if defined(__AVX2__)
+    const __m256i first = _mm256_set1_epi8(needle[0]);
+    const __m256i last = _mm256_set1_epi8(needle[needle_len - 1]);
+    for (; pos + 32 <= last_start + 1; pos += 32) {
+      const __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(haystack + pos));
+      const __m256i block_last =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(haystack + pos + needle_len - 1));
+      auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+          _mm256_and_si256(_mm256_cmpeq_epi8(first, block_first), _mm256_cmpeq_epi8(last, block_last))));
+      while (mask != 0) {
+        const auto bit = static_cast<std::size_t>(__builtin_ctz(mask));
+        if (std::memcmp(haystack + pos + bit + 1, needle + 1, needle_len - 2) == 0) return haystack + pos + bit;
+        mask &= mask - 1;
+      }
+    }
+#endif
+    for (; pos <= last_start; pos++) {
+      if (haystack[pos] == needle[0] && haystack[pos + needle_len - 1] == needle[needle_len - 1] &&
+          std::memcmp(haystack + pos + 1, needle + 1, needle_len - 2) == 0) {
+        return haystack + pos;
+      }
+    }
+    return nullptr;
+  }
+};
+
+}  // namespace terrier::execution::util
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <functional>
+#include <limits>
+#include <type_traits>
 
+#include "execution/util/arithmetic_overflow.h"
 #include "execution/util/execution_common.h"
 #include "execution/util/simd.h"
 
@@ -104,6 +107,111 @@ class VectorUtil {
     return out_pos;
   }
 
+  /**
+   * Apply the arithmetic operation @em Op to two 64-bit integers and store the result in @em res. Return true if the
+   * operation overflowed, in which case the result wraps around.
+   * @tparam Op The arithmetic operation, one of std::plus, std::minus or std::multiplies.
+   * @param a The left operand.
+   * @param b The right operand.
+   * @param[out] res Where the result of the operation is written to.
+   * @return True if the operation overflowed; false otherwise.
+   */
+  template <template <typename> typename Op>
+  static bool CheckedArithmetic(const int64_t a, const int64_t b, int64_t *res) {
+    if constexpr (std::is_same_v<Op<void>, std::plus<void>>) {
+      return ArithmeticOverflow::Add(a, b, res);
+    } else if constexpr (std::is_same_v<Op<void>, std::minus<void>>) {
+      return ArithmeticOverflow::Sub(a, b, res);
+    } else {
+      static_assert(std::is_same_v<Op<void>, std::multiplies<void>>, "Unsupported arithmetic operation");
+      return ArithmeticOverflow::Mul(a, b, res);
+    }
+  }
+
+  /**
+   * Apply an arithmetic operation to every element of an input vector and a constant value, both widened to 64-bit
+   * integers, and store each result at the index of its element in the output vector. If a selection vector is
+   * provided, only vector elements from the selection vector will be computed.
+   * @tparam T The data type of the elements stored in the input vector.
+   * @tparam Op The arithmetic operation.
+   * @param in The input vector.
+   * @param in_count The number of elements in the input (or selection) vector.
+   * @param val The constant value.
+   * @param val_on_left Whether the constant value is the left operand of the operation.
+   * @param[out] out The vector storing the results. Results that overflowed wrap around.
+   * @param sel The selection vector used to read input values.
+   * @return True if any of the operations overflowed; false otherwise.
+   */
+  template <typename T, template <typename> typename Op>
+  static bool ArithmeticVectorByVal(const T *RESTRICT in, const uint32_t in_count, const int64_t val,
+                                    const bool val_on_left, int64_t *RESTRICT out, const uint32_t *RESTRICT sel) {
+    uint32_t in_pos = 0;
+#if defined(__AVX2__) || defined(__AVX512F__)
+    if constexpr (simd::IsVectorArithmetic<T, Op>()) {
+      // The constant has to fit in 32 bits as well for the results not to overflow
+      const bool val_fits = val >= std::numeric_limits<int32_t>::min() && val <= std::numeric_limits<int32_t>::max();
+      if (sel == nullptr && val_fits) {
+        simd::ArithmeticVectorByVal<T, Op>(in, in_count, val, val_on_left, out, &in_pos);
+      }
+    }
+#endif
+
+    bool overflow = false;
+    if (sel == nullptr) {
+      for (; in_pos < in_count; in_pos++) {
+        const auto elem = static_cast<int64_t>(in[in_pos]);
+        overflow |= val_on_left ? CheckedArithmetic<Op>(val, elem, &out[in_pos])
+                                : CheckedArithmetic<Op>(elem, val, &out[in_pos]);
+      }
+    } else {
+      for (; in_pos < in_count; in_pos++) {
+        const auto elem = static_cast<int64_t>(in[sel[in_pos]]);
+        overflow |= val_on_left ? CheckedArithmetic<Op>(val, elem, &out[sel[in_pos]])
+                                : CheckedArithmetic<Op>(elem, val, &out[sel[in_pos]]);
+      }
+    }
+    return overflow;
+  }
+
+  /**
+   * Apply an arithmetic operation to the elements of two input vectors, widened to 64-bit integers, and store each
+   * result at the index of its elements in the output vector. If a selection vector is provided, only the vector
+   * elements whose indexes are in the selection vector will be computed.
+   * @tparam T1 The data type of the elements stored in the first input vector.
+   * @tparam T2 The data type of the elements stored in the second input vector.
+   * @tparam Op The arithmetic operation.
+   * @param in_1 The first input vector, the left operand.
+   * @param in_2 The second input vector, the right operand.
+   * @param in_count The number of elements in the input (or selection) vector.
+   * @param[out] out The vector storing the results. Results that overflowed wrap around.
+   * @param sel The selection vector storing indexes of elements to process.
+   * @return True if any of the operations overflowed; false otherwise.
+   */
+  template <typename T1, typename T2, template <typename> typename Op>
+  static bool ArithmeticVectorByVector(const T1 *RESTRICT in_1, const T2 *RESTRICT in_2, const uint32_t in_count,
+                                       int64_t *RESTRICT out, const uint32_t *RESTRICT sel) {
+    uint32_t in_pos = 0;
+#if defined(__AVX2__) || defined(__AVX512F__)
+    if constexpr (std::is_same_v<T1, T2> && simd::IsVectorArithmetic<T1, Op>()) {
+      if (sel == nullptr) simd::ArithmeticVectorByVector<T1, Op>(in_1, in_2, in_count, out, &in_pos);
+    }
+#endif
+
+    bool overflow = false;
+    if (sel == nullptr) {
+      for (; in_pos < in_count; in_pos++) {
+        overflow |=
+            CheckedArithmetic<Op>(static_cast<int64_t>(in_1[in_pos]), static_cast<int64_t>(in_2[in_pos]), &out[in_pos]);
+      }
+    } else {
+      for (; in_pos < in_count; in_pos++) {
+        const uint32_t idx = sel[in_pos];
+        overflow |= CheckedArithmetic<Op>(static_cast<int64_t>(in_1[idx]), static_cast<int64_t>(in_2[idx]), &out[idx]);
+      }
+    }
+    return overflow;
+  }
+
   /**
    * Gather potentially non-contiguous indexes from an input vector and store
    * them into an output vector. Only elements whose indexes are stored in the
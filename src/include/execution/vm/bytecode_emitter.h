@@ -347,6 +347,54 @@ class BytecodeEmitter {
   void EmitPCIVectorFilter(Bytecode bytecode, LocalVar selected, LocalVar pci, uint32_t col_idx, int8_t type,
                            int64_t val);
 
+  /**
+   * Emit a vectorized filter of a string column against a string literal
+   */
+  void EmitPCIStringFilter(Bytecode bytecode, LocalVar selected, LocalVar pci, uint32_t col_idx, uint64_t length,
+                           uintptr_t data);
+
+  /**
+   * Filter a string column in the iterator by a LIKE pattern
+   * @param bytecode filter bytecode to emit
+   * @param selected where to store the number of selected tuples
+   * @param pci PCI to filter
+   * @param col_idx index of the column
+   * @param pattern address of the compiled pattern, which outlives the bytecode
+   */
+  void EmitPCILikeFilter(Bytecode bytecode, LocalVar selected, LocalVar pci, uint32_t col_idx, uintptr_t pattern);
+
+  /**
+   * Match a string against a constant LIKE pattern
+   * @param result where to store the result
+   * @param str string to match
+   * @param pattern address of the compiled pattern, which outlives the bytecode
+   */
+  void EmitLikeConstant(LocalVar result, LocalVar str, uintptr_t pattern);
+
+  /**
+   * Compute a column in the iterator from two of its columns
+   * @param bytecode compute bytecode to emit
+   * @param pci PCI to compute in
+   * @param out_idx index of the computed column
+   * @param col_idx_1 index of the left operand column
+   * @param type_1 type of the left operand column
+   * @param col_idx_2 index of the right operand column
+   * @param type_2 type of the right operand column
+   */
+  void EmitPCICompute(Bytecode bytecode, LocalVar pci, uint32_t out_idx, uint32_t col_idx_1, int8_t type_1,
+                      uint32_t col_idx_2, int8_t type_2);
+
+  /**
+   * Compute a column in the iterator from one of its columns and a constant value
+   * @param bytecode compute bytecode to emit
+   * @param pci PCI to compute in
+   * @param out_idx index of the computed column
+   * @param col_idx index of the operand column
+   * @param type type of the operand column
+   * @param val constant value
+   */
+  void EmitPCIComputeVal(Bytecode bytecode, LocalVar pci, uint32_t out_idx, uint32_t col_idx, int8_t type, int64_t val);
+
   /**
    * Insert a filter flavor into the filter manager builder
    */
@@ -361,7 +409,7 @@ class BytecodeEmitter {
    * Process a batch of input into the aggregation hash table
    */
   void EmitAggHashTableProcessBatch(LocalVar agg_ht, LocalVar iters, FunctionId hash_fn, FunctionId key_eq_fn,
-                                    FunctionId init_agg_fn, FunctionId merge_agg_fn);
+                                    FunctionId init_agg_fn, FunctionId merge_agg_fn, LocalVar partitioned);
 
   /**
    * Emit move partition code
@@ -383,7 +431,8 @@ class BytecodeEmitter {
   /**
    * Initialize a sorter instance
    */
-  void EmitSorterInit(Bytecode bytecode, LocalVar sorter, LocalVar region, FunctionId cmp_fn, LocalVar tuple_size);
+  void EmitSorterInit(Bytecode bytecode, LocalVar sorter, LocalVar region, FunctionId cmp_fn, LocalVar tuple_size,
+                      LocalVar num_key_words);
 
   // --------------------------------------------
   // Output calls
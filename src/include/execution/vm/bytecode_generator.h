@@ -10,6 +10,7 @@
 #include "execution/ast/ast_visitor.h"
 #include "execution/ast/builtins.h"
 #include "execution/exec/execution_context.h"
+#include "execution/sql/like_pattern.h"
 #include "execution/vm/bytecode_emitter.h"
 
 namespace terrier::execution::vm {
@@ -73,6 +74,7 @@ class BytecodeGenerator : public ast::AstVisitor<BytecodeGenerator> {
   void VisitBuiltinHashCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinFilterManagerCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinFilterCall(ast::CallExpr *call, ast::Builtin builtin);
+  void VisitBuiltinComputeCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinAggHashTableCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinAggHashTableIterCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinAggPartIterCall(ast::CallExpr *call, ast::Builtin builtin);
@@ -155,6 +157,9 @@ class BytecodeGenerator : public ast::AstVisitor<BytecodeGenerator> {
   // Lookup a function's ID by its name
   FunctionId LookupFuncIdByName(const std::string &name) const;
 
+  // Compile a constant LIKE pattern, which lives as long as the module
+  const sql::LikePattern *CompileLikePattern(std::string_view pattern);
+
   // -------------------------------------------------------
   // Accessors
   // -------------------------------------------------------
@@ -175,6 +180,9 @@ class BytecodeGenerator : public ast::AstVisitor<BytecodeGenerator> {
   // Cache of function names to IDs for faster lookup
   std::unordered_map<std::string, FunctionId> func_map_;
 
+  // Constant LIKE patterns of the module, compiled once
+  std::vector<std::unique_ptr<sql::LikePattern>> like_patterns_;
+
   // Emitter to write bytecode ops
   BytecodeEmitter emitter_;
 
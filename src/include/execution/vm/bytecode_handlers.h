@@ -539,6 +539,18 @@ VM_OP_HOT void OpPCIGetVarlenNull(terrier::execution::sql::StringVal *out,
   }
 }
 
+VM_OP_HOT void OpPCIGetComputed(terrier::execution::sql::Integer *out,
+                                terrier::execution::sql::ProjectedColumnsIterator *iter, uint16_t col_idx) {
+  // Read
+  bool null = false;
+  auto *ptr = iter->GetComputed(col_idx, &null);
+  TERRIER_ASSERT(ptr != nullptr, "Null pointer when trying to read computed integer");
+
+  // Set
+  out->is_null_ = null;
+  out->val_ = *ptr;
+}
+
 VM_OP void OpPCIFilterEqual(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t col_idx,
                             int8_t type, int64_t val);
 
@@ -557,6 +569,51 @@ VM_OP void OpPCIFilterLessThanEqual(uint64_t *size, terrier::execution::sql::Pro
 VM_OP void OpPCIFilterNotEqual(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter,
                                uint32_t col_idx, int8_t type, int64_t val);
 
+VM_OP void OpPCIFilterStringEqual(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter,
+                                  uint32_t col_idx, uint64_t length, uintptr_t data);
+
+VM_OP void OpPCIFilterStringGreaterThan(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter,
+                                        uint32_t col_idx, uint64_t length, uintptr_t data);
+
+VM_OP void OpPCIFilterStringGreaterThanEqual(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter,
+                                             uint32_t col_idx, uint64_t length, uintptr_t data);
+
+VM_OP void OpPCIFilterStringLessThan(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter,
+                                     uint32_t col_idx, uint64_t length, uintptr_t data);
+
+VM_OP void OpPCIFilterStringLessThanEqual(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter,
+                                          uint32_t col_idx, uint64_t length, uintptr_t data);
+
+VM_OP void OpPCIFilterStringNotEqual(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter,
+                                     uint32_t col_idx, uint64_t length, uintptr_t data);
+
+VM_OP void OpPCIFilterLike(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t col_idx,
+                           uintptr_t pattern);
+
+VM_OP void OpPCIFilterNotLike(uint64_t *size, terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t col_idx,
+                              uintptr_t pattern);
+
+VM_OP void OpPCIComputeAdd(terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t out_idx,
+                           uint32_t col_idx_1, int8_t type_1, uint32_t col_idx_2, int8_t type_2);
+
+VM_OP void OpPCIComputeSub(terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t out_idx,
+                           uint32_t col_idx_1, int8_t type_1, uint32_t col_idx_2, int8_t type_2);
+
+VM_OP void OpPCIComputeMul(terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t out_idx,
+                           uint32_t col_idx_1, int8_t type_1, uint32_t col_idx_2, int8_t type_2);
+
+VM_OP void OpPCIComputeAddVal(terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t out_idx,
+                              uint32_t col_idx, int8_t type, int64_t val);
+
+VM_OP void OpPCIComputeSubVal(terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t out_idx,
+                              uint32_t col_idx, int8_t type, int64_t val);
+
+VM_OP void OpPCIComputeMulVal(terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t out_idx,
+                              uint32_t col_idx, int8_t type, int64_t val);
+
+VM_OP void OpPCIComputeValSub(terrier::execution::sql::ProjectedColumnsIterator *iter, uint32_t out_idx,
+                              uint32_t col_idx, int8_t type, int64_t val);
+
 // ---------------------------------------------------------
 // Hashing
 // ---------------------------------------------------------
@@ -805,8 +862,8 @@ VM_OP_HOT void OpAggregationHashTableProcessBatch(
     const terrier::execution::sql::AggregationHashTable::HashFn hash_fn,
     const terrier::execution::sql::AggregationHashTable::KeyEqFn key_eq_fn,
     const terrier::execution::sql::AggregationHashTable::InitAggFn init_agg_fn,
-    const terrier::execution::sql::AggregationHashTable::AdvanceAggFn merge_agg_fn) {
-  agg_hash_table->ProcessBatch(iters, hash_fn, key_eq_fn, init_agg_fn, merge_agg_fn);
+    const terrier::execution::sql::AggregationHashTable::AdvanceAggFn merge_agg_fn, const bool partitioned) {
+  agg_hash_table->ProcessBatch(iters, hash_fn, key_eq_fn, init_agg_fn, merge_agg_fn, partitioned);
 }
 
 VM_OP_HOT void OpAggregationHashTableTransferPartitions(
@@ -1167,7 +1224,20 @@ VM_OP void OpJoinHashTableFree(terrier::execution::sql::JoinHashTable *join_hash
 // ---------------------------------------------------------
 
 VM_OP void OpSorterInit(terrier::execution::sql::Sorter *sorter, terrier::execution::sql::MemoryPool *memory,
-                        terrier::execution::sql::Sorter::ComparisonFunction cmp_fn, uint32_t tuple_size);
+                        terrier::execution::sql::Sorter::ComparisonFunction cmp_fn, uint32_t tuple_size,
+                        uint32_t num_key_words);
+
+#define GEN_SORTER_KEY(Name, SqlType)                                                                               \
+  VM_OP_HOT void OpSorterKey##Name(uint64_t *key, const terrier::execution::sql::SqlType *input, bool descending) { \
+    *key = terrier::execution::sql::Sorter::NormalizeKey(*input, descending);                                       \
+  }
+GEN_SORTER_KEY(Bool, BoolVal)
+GEN_SORTER_KEY(Int, Integer)
+GEN_SORTER_KEY(Real, Real)
+GEN_SORTER_KEY(Date, DateVal)
+GEN_SORTER_KEY(Timestamp, TimestampVal)
+GEN_SORTER_KEY(String, StringVal)
+#undef GEN_SORTER_KEY
 
 VM_OP_HOT void OpSorterAllocTuple(terrier::byte **result, terrier::execution::sql::Sorter *sorter) {
   *result = sorter->AllocInputTuple();
@@ -1371,6 +1441,18 @@ VM_OP_WARM void OpPosition(terrier::execution::exec::ExecutionContext *ctx, terr
   terrier::execution::sql::StringFunctions::Position(ctx, result, *search_str, *search_sub_str);
 }
 
+VM_OP_WARM void OpLike(terrier::execution::exec::ExecutionContext *ctx, terrier::execution::sql::BoolVal *result,
+                       const terrier::execution::sql::StringVal *str,
+                       const terrier::execution::sql::StringVal *pattern) {
+  terrier::execution::sql::StringFunctions::Like(ctx, result, *str, *pattern);
+}
+
+VM_OP_WARM void OpLikeConstant(terrier::execution::sql::BoolVal *result, const terrier::execution::sql::StringVal *str,
+                               uintptr_t pattern) {
+  const auto &like_pattern = *reinterpret_cast<const terrier::execution::sql::LikePattern *>(pattern);
+  terrier::execution::sql::StringFunctions::Like(result, *str, like_pattern);
+}
+
 VM_OP_WARM void OpLPad(terrier::execution::exec::ExecutionContext *ctx, terrier::execution::sql::StringVal *result,
                        const terrier::execution::sql::StringVal *str, const terrier::execution::sql::Integer *len,
                        const terrier::execution::sql::StringVal *pad) {
@@ -1442,13 +1524,26 @@ VM_OP void OpIndexIteratorFree(terrier::execution::sql::IndexIterator *iter);
 
 VM_OP void OpIndexIteratorPerformInit(terrier::execution::sql::IndexIterator *iter);
 
+VM_OP void OpIndexIteratorPerformInitCovering(terrier::execution::sql::IndexIterator *iter);
+
 VM_OP_WARM void OpIndexIteratorScanKey(terrier::execution::sql::IndexIterator *iter) { iter->ScanKey(); }
 
+VM_OP_HOT void OpIndexIteratorAddKey(terrier::execution::sql::IndexIterator *iter) { iter->AddKey(); }
+
+VM_OP_WARM void OpIndexIteratorScanKeys(terrier::execution::sql::IndexIterator *iter) { iter->ScanKeys(); }
+
+VM_OP_HOT void OpIndexIteratorScanNextKey(terrier::execution::sql::IndexIterator *iter) { iter->ScanNextKey(); }
+
 VM_OP_WARM void OpIndexIteratorScanAscending(terrier::execution::sql::IndexIterator *iter,
                                              terrier::storage::index::ScanType scan_type, uint32_t limit) {
   iter->ScanAscending(scan_type, limit);
 }
 
+VM_OP_WARM void OpIndexIteratorStreamAscending(terrier::execution::sql::IndexIterator *iter,
+                                               terrier::storage::index::ScanType scan_type, uint32_t limit) {
+  iter->StreamAscending(scan_type, limit);
+}
+
 VM_OP_WARM void OpIndexIteratorScanDescending(terrier::execution::sql::IndexIterator *iter) { iter->ScanDescending(); }
 
 VM_OP_WARM void OpIndexIteratorScanLimitDescending(terrier::execution::sql::IndexIterator *iter, uint32_t limit) {
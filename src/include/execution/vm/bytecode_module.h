@@ -1,9 +1,11 @@
 #pragma once
 
 #include <iosfwd>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "execution/sql/like_pattern.h"
 #include "execution/vm/bytecode_function_info.h"
 #include "execution/vm/bytecode_iterator.h"
 #include "execution/vm/vm.h"
@@ -21,8 +23,10 @@ class BytecodeModule {
    * @param name The name of the module
    * @param code The bytecode that makes up the module
    * @param functions The functions within the module
+   * @param like_patterns The constant LIKE patterns that the bytecode refers to by address
    */
-  BytecodeModule(std::string name, std::vector<uint8_t> &&code, std::vector<FunctionInfo> &&functions);
+  BytecodeModule(std::string name, std::vector<uint8_t> &&code, std::vector<FunctionInfo> &&functions,
+                 std::vector<std::unique_ptr<sql::LikePattern>> &&like_patterns = {});
 
   /**
    * This class cannot be copied or moved
@@ -90,6 +94,7 @@ class BytecodeModule {
 
  private:
   friend class VM;
+  friend class LLVMEngine;
 
   const uint8_t *GetBytecodeForFunction(const FunctionInfo &func) const {
     // NOLINTNEXTLINE
@@ -102,6 +107,8 @@ class BytecodeModule {
   const std::string name_;
   const std::vector<uint8_t> code_;
   const std::vector<FunctionInfo> functions_;
+  // Compiled when the bytecode was generated, so that queries don't compile them again for every row or vector
+  const std::vector<std::unique_ptr<sql::LikePattern>> like_patterns_;
 };
 
 }  // namespace terrier::execution::vm
@@ -153,6 +153,7 @@ namespace terrier::execution::vm {
   F(PCIGetDateValNull, OperandType::Local, OperandType::Local, OperandType::UImm2)                                    \
   F(PCIGetTimestampValNull, OperandType::Local, OperandType::Local, OperandType::UImm2)                               \
   F(PCIGetVarlenNull, OperandType::Local, OperandType::Local, OperandType::UImm2)                                     \
+  F(PCIGetComputed, OperandType::Local, OperandType::Local, OperandType::UImm2)                                       \
   F(PCIFilterEqual, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Imm1, OperandType::Imm8) \
   F(PCIFilterGreaterThan, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Imm1,              \
     OperandType::Imm8)                                                                                                \
@@ -163,6 +164,34 @@ namespace terrier::execution::vm {
   F(PCIFilterLessThanEqual, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Imm1,            \
     OperandType::Imm8)                                                                                                \
   F(PCIFilterNotEqual, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Imm1,                 \
+    OperandType::Imm8)                                                                                                \
+  F(PCIFilterStringEqual, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Imm8,              \
+    OperandType::Imm8)                                                                                                \
+  F(PCIFilterStringGreaterThan, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Imm8,        \
+    OperandType::Imm8)                                                                                                \
+  F(PCIFilterStringGreaterThanEqual, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Imm8,   \
+    OperandType::Imm8)                                                                                                \
+  F(PCIFilterStringLessThan, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Imm8,           \
+    OperandType::Imm8)                                                                                                \
+  F(PCIFilterStringLessThanEqual, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Imm8,      \
+    OperandType::Imm8)                                                                                                \
+  F(PCIFilterStringNotEqual, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Imm8,           \
+    OperandType::Imm8)                                                                                                \
+  F(PCIFilterLike, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Imm8)                     \
+  F(PCIFilterNotLike, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Imm8)                  \
+  F(PCIComputeAdd, OperandType::Local, OperandType::UImm4, OperandType::UImm4, OperandType::Imm1, OperandType::UImm4, \
+    OperandType::Imm1)                                                                                                \
+  F(PCIComputeSub, OperandType::Local, OperandType::UImm4, OperandType::UImm4, OperandType::Imm1, OperandType::UImm4, \
+    OperandType::Imm1)                                                                                                \
+  F(PCIComputeMul, OperandType::Local, OperandType::UImm4, OperandType::UImm4, OperandType::Imm1, OperandType::UImm4, \
+    OperandType::Imm1)                                                                                                \
+  F(PCIComputeAddVal, OperandType::Local, OperandType::UImm4, OperandType::UImm4, OperandType::Imm1,                  \
+    OperandType::Imm8)                                                                                                \
+  F(PCIComputeSubVal, OperandType::Local, OperandType::UImm4, OperandType::UImm4, OperandType::Imm1,                  \
+    OperandType::Imm8)                                                                                                \
+  F(PCIComputeMulVal, OperandType::Local, OperandType::UImm4, OperandType::UImm4, OperandType::Imm1,                  \
+    OperandType::Imm8)                                                                                                \
+  F(PCIComputeValSub, OperandType::Local, OperandType::UImm4, OperandType::UImm4, OperandType::Imm1,                  \
     OperandType::Imm8)                                                                                                \
                                                                                                                       \
   /* Filter Manager */                                                                                                \
@@ -255,7 +284,7 @@ namespace terrier::execution::vm {
   F(AggregationHashTableLookup, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::FunctionId,  \
     OperandType::Local)                                                                                               \
   F(AggregationHashTableProcessBatch, OperandType::Local, OperandType::Local, OperandType::FunctionId,                \
-    OperandType::FunctionId, OperandType::FunctionId, OperandType::FunctionId)                                        \
+    OperandType::FunctionId, OperandType::FunctionId, OperandType::FunctionId, OperandType::Local)                    \
   F(AggregationHashTableTransferPartitions, OperandType::Local, OperandType::Local, OperandType::Local,               \
     OperandType::FunctionId)                                                                                          \
   F(AggregationHashTableParallelPartitionedScan, OperandType::Local, OperandType::Local, OperandType::Local,          \
@@ -340,7 +369,14 @@ namespace terrier::execution::vm {
   F(JoinHashTableFree, OperandType::Local)                                                                            \
                                                                                                                       \
   /* Sorting */                                                                                                       \
-  F(SorterInit, OperandType::Local, OperandType::Local, OperandType::FunctionId, OperandType::Local)                  \
+  F(SorterInit, OperandType::Local, OperandType::Local, OperandType::FunctionId, OperandType::Local,                  \
+    OperandType::Local)                                                                                               \
+  F(SorterKeyBool, OperandType::Local, OperandType::Local, OperandType::Local)                                        \
+  F(SorterKeyInt, OperandType::Local, OperandType::Local, OperandType::Local)                                         \
+  F(SorterKeyReal, OperandType::Local, OperandType::Local, OperandType::Local)                                        \
+  F(SorterKeyDate, OperandType::Local, OperandType::Local, OperandType::Local)                                        \
+  F(SorterKeyTimestamp, OperandType::Local, OperandType::Local, OperandType::Local)                                   \
+  F(SorterKeyString, OperandType::Local, OperandType::Local, OperandType::Local)                                      \
   F(SorterAllocTuple, OperandType::Local, OperandType::Local)                                                         \
   F(SorterAllocTupleTopK, OperandType::Local, OperandType::Local, OperandType::Local)                                 \
   F(SorterAllocTupleTopKFinish, OperandType::Local, OperandType::Local)                                               \
@@ -362,8 +398,13 @@ namespace terrier::execution::vm {
   F(IndexIteratorInit, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::UImm4,                \
     OperandType::UImm4, OperandType::Local, OperandType::UImm4)                                                       \
   F(IndexIteratorPerformInit, OperandType::Local)                                                                     \
+  F(IndexIteratorPerformInitCovering, OperandType::Local)                                                             \
   F(IndexIteratorScanKey, OperandType::Local)                                                                         \
+  F(IndexIteratorAddKey, OperandType::Local)                                                                          \
+  F(IndexIteratorScanKeys, OperandType::Local)                                                                        \
+  F(IndexIteratorScanNextKey, OperandType::Local)                                                                     \
   F(IndexIteratorScanAscending, OperandType::Local, OperandType::Local, OperandType::Local)                           \
+  F(IndexIteratorStreamAscending, OperandType::Local, OperandType::Local, OperandType::Local)                         \
   F(IndexIteratorScanDescending, OperandType::Local)                                                                  \
   F(IndexIteratorScanLimitDescending, OperandType::Local, OperandType::Local)                                         \
   F(IndexIteratorFree, OperandType::Local)                                                                            \
@@ -476,6 +517,8 @@ namespace terrier::execution::vm {
   F(Trim, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local)                             \
   F(Upper, OperandType::Local, OperandType::Local, OperandType::Local)                                                \
   F(Position, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local)                         \
+  F(Like, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local)                             \
+  F(LikeConstant, OperandType::Local, OperandType::Local, OperandType::Imm8)                                          \
                                                                                                                       \
   /* String functions */                                                                                              \
   F(GetParamBool, OperandType::Local, OperandType::Local, OperandType::Local)                                         \
@@ -3,6 +3,8 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 
 #include "llvm/Support/MemoryBuffer.h"
 
@@ -19,6 +21,7 @@ namespace terrier::execution::vm {
 class BytecodeModule;
 class FunctionInfo;
 class LocalVar;
+class ObjectCache;
 
 /**
  * The interface to LLVM to JIT compile TPL bytecode
@@ -58,6 +61,18 @@ class LLVMEngine {
    */
   static std::unique_ptr<CompiledModule> Compile(const BytecodeModule &module, const CompilerOptions &options);
 
+  /**
+   * Set the cache that compiled modules are looked up in before compiling them, and added to afterwards. The cache
+   * must outlive all compilations.
+   * @param object_cache the cache to use, or nullptr to always compile
+   */
+  static void SetObjectCache(ObjectCache *object_cache) { object_cache_ = object_cache; }
+
+  /**
+   * @return the cache of compiled modules, or nullptr if there is none
+   */
+  static ObjectCache *GetObjectCache() { return object_cache_; }
+
   // -------------------------------------------------------
   // Compiler Options
   // -------------------------------------------------------
@@ -123,10 +138,78 @@ class LLVMEngine {
      */
     std::string GetBytecodeHandlersBcPath() const { return "./bytecode_handlers_ir.bc"; }
 
+    /**
+     * Set the optimization level, like the -O flag of a compiler. Level 0 compiles much faster than the others, but
+     * the code runs slower. Level 3 spends the most time on optimizing, and is meant for small amounts of hot code.
+     * @param opt_level the optimization level, from 0 to 3
+     * @return the updated object
+     */
+    CompilerOptions &SetOptLevel(uint32_t opt_level) {
+      TERRIER_ASSERT(opt_level <= 3, "Optimization levels go from 0 to 3");
+      opt_level_ = opt_level;
+      return *this;
+    }
+
+    /**
+     * @return the optimization level
+     */
+    uint32_t GetOptLevel() const { return opt_level_; }
+
+    /**
+     * Set functions of the module that are not compiled. Calls to them go through their slots, which must be set.
+     * @param linked_functions names of the functions
+     * @return the updated object
+     */
+    CompilerOptions &SetLinkedFunctions(std::unordered_set<std::string> linked_functions) {
+      linked_functions_ = std::move(linked_functions);
+      return *this;
+    }
+
+    /**
+     * @return the names of the functions of the module that are not compiled
+     */
+    const std::unordered_set<std::string> &GetLinkedFunctions() const { return linked_functions_; }
+
+    /**
+     * Set slots holding the current implementations of functions, which must follow the C ABI. Calls to the functions
+     * load the implementation from the slot every time, so they reach implementations installed after compiling.
+     * @param function_slots the address of a std::atomic<void *> slot for each function, by name
+     * @return the updated object
+     */
+    CompilerOptions &SetFunctionSlots(std::unordered_map<std::string, void *> function_slots) {
+      function_slots_ = std::move(function_slots);
+      return *this;
+    }
+
+    /**
+     * @return the slots calls to functions go through, by function name
+     */
+    const std::unordered_map<std::string, void *> &GetFunctionSlots() const { return function_slots_; }
+
+    /**
+     * Set counters of how hot functions are. The compiled code of each of the functions atomically increments its
+     * counter when it's invoked, and when it iterates a loop.
+     * @param hotness_counters the address of a std::atomic<uint64_t> counter for each function, by name
+     * @return the updated object
+     */
+    CompilerOptions &SetHotnessCounters(std::unordered_map<std::string, void *> hotness_counters) {
+      hotness_counters_ = std::move(hotness_counters);
+      return *this;
+    }
+
+    /**
+     * @return the counters the compiled functions increment, by function name
+     */
+    const std::unordered_map<std::string, void *> &GetHotnessCounters() const { return hotness_counters_; }
+
    private:
     bool debug_{false};
     bool write_obj_file_{false};
+    uint32_t opt_level_{2};
     std::string output_file_name_;
+    std::unordered_set<std::string> linked_functions_;
+    std::unordered_map<std::string, void *> function_slots_;
+    std::unordered_map<std::string, void *> hotness_counters_;
   };
 
   // -------------------------------------------------------
@@ -149,8 +232,11 @@ class LLVMEngine {
     /**
      * Construct a compiled module using the provided shared object file.
      * @param object_code The object file containing code for this module.
+     * @param linked_symbols Addresses of the functions and variables the
+     *                       object file uses but does not define, by name.
      */
-    explicit CompiledModule(std::unique_ptr<llvm::MemoryBuffer> object_code);
+    explicit CompiledModule(std::unique_ptr<llvm::MemoryBuffer> object_code,
+                            const std::unordered_map<std::string, void *> &linked_symbols = {});
 
     /**
      * This class cannot be copied or moved
@@ -165,7 +251,8 @@ class LLVMEngine {
     /**
      * Get a pointer to the JIT-ed function in this module with name @em name.
      * @return A function pointer if a function with the provided name exists.
-     *         If no such function exists, returns null.
+     *         If no such function exists, or it is linked rather than
+     *         compiled, returns null.
      */
     void *GetFunctionPointer(const std::string &name) const;
 
@@ -174,6 +261,11 @@ class LLVMEngine {
      */
     std::size_t GetModuleObjectCodeSizeInBytes() const { return object_code_->getBufferSize(); }
 
+    /**
+     * Return the module's object code.
+     */
+    const llvm::MemoryBuffer &GetModuleObjectCode() const { return *object_code_; }
+
     /**
      * Load the given module @em module into memory. If this module has already
      * been loaded, it will not be reloaded.
@@ -191,6 +283,12 @@ class LLVMEngine {
     std::unique_ptr<TPLMemoryManager> memory_manager_;
     std::unordered_map<std::string, void *> functions_;
   };
+
+ private:
+  // Describe everything the machine code of the module depends on
+  static std::string Fingerprint(const BytecodeModule &module, const CompilerOptions &options);
+
+  static ObjectCache *object_cache_;
 };
 
 }  // namespace terrier::execution::vm
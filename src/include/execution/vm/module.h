@@ -1,9 +1,12 @@
 #pragma once
 
 #include <atomic>
+#include <condition_variable>  // NOLINT
 #include <memory>
+#include <mutex>  // NOLINT
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "llvm/Support/Memory.h"
 
@@ -13,6 +16,7 @@
 
 namespace terrier::execution::vm::test {
 class BytecodeTrampolineTest;
+class ModuleTest;
 }  // namespace terrier::execution::vm::test
 
 namespace terrier::execution::vm {
@@ -25,9 +29,11 @@ enum class ExecutionMode : uint8_t {
   Interpret = 0,
   // Compile and generate all machine code before executing the function
   Compiled = 1,
-  // Execute in interpreted mode, but trigger a compilation asynchronously. As
-  // compiled code becomes available, seamlessly swap it in and execute mixed
-  // interpreter and compiled code.
+  // Execute in interpreted mode, but trigger a fast, unoptimized compilation
+  // asynchronously. As compiled code becomes available, seamlessly swap it in
+  // and execute mixed interpreter and compiled code. Functions that turn out to
+  // be hot, in the interpreter or in the unoptimized code, are recompiled with
+  // full optimizations, and swapped in again.
   Adaptive = 2,
 };
 
@@ -61,6 +67,12 @@ class Module {
    */
   DISALLOW_COPY_AND_MOVE(Module);
 
+  /**
+   * Destroy the module. Waits for the compilations running in the background, and cancels the ones that haven't
+   * started yet.
+   */
+  ~Module();
+
   /**
    * Look up a TPL function in this module by its ID
    * @return A pointer to the function's info if it exists; null otherwise
@@ -110,10 +122,33 @@ class Module {
    */
   const BytecodeModule *GetBytecodeModule() const { return bytecode_module_.get(); }
 
+  /**
+   * Record an invocation of a function by the interpreter. Once a function is hot, and the module runs in adaptive
+   * mode, the function gets compiled with full optimizations in the background.
+   * @param func_id The ID of the function
+   * @param loop_iterations The number of loop iterations the invocation ran
+   */
+  void RecordInvocation(FunctionId func_id, uint64_t loop_iterations) const;
+
+  /**
+   * Return how hot the function is, i.e., the number of times it was invoked
+   * plus the number of loop iterations it ran, in the interpreter or in
+   * baseline machine code.
+   * @param func_id The ID of the function
+   */
+  uint64_t GetHotness(const FunctionId func_id) const { return hotness_[func_id].load(std::memory_order_relaxed); }
+
+  /**
+   * Hotness at which a function is recompiled with full optimizations in
+   * adaptive mode.
+   */
+  static constexpr uint64_t K_HOT_THRESHOLD = 10000;
+
  private:
   friend class VM;
   friend class AsyncCompileTask;
   friend class test::BytecodeTrampolineTest;
+  friend class test::ModuleTest;
 
   // This class encapsulates the ability to asynchronously JIT compile a module.
   class AsyncCompileTask;
@@ -165,10 +200,41 @@ class Module {
   // Compile this module into machine code. This is a blocking call.
   void CompileToMachineCode();
 
-  // Compile this module into machine code. This is a non-blocking call that
+  // Compile this module into unoptimized machine code, followed by optimized
+  // machine code for its hot functions. This is a non-blocking call that
   // triggers a compilation in the background.
   void CompileToMachineCodeAsync();
 
+  // The tiers of implementations of a function, from slowest to fastest
+  enum class Tier : uint8_t { Bytecode, Baseline, Optimized };
+
+  // Compile this module into unoptimized machine code. This is a blocking
+  // call, and only compiles the module once.
+  void CompileBaseline();
+
+  // Compile all hot functions that aren't optimized yet with full
+  // optimizations, until there are none. This is a blocking call.
+  void CompileHotFunctions();
+
+  // Trigger a compilation of the hot functions in the background, unless one
+  // is already running
+  void CompileHotFunctionsAsync() const;
+
+  // Trigger a compilation of the hot functions in the background if there are
+  // hot functions that aren't optimized yet, and none is already running
+  void CheckHotFunctions() const;
+
+  // Enqueue a background compilation, which the module waits for when it's
+  // destroyed
+  void EnqueueCompileTask(bool only_hot_functions);
+
+  // Called by a background compilation when it's done with the module
+  void FinishCompileTask();
+
+  // Swap in the functions of the compiled module, unless they already have a
+  // better implementation
+  void InstallFunctions(const LLVMEngine::CompiledModule &compiled_module, Tier tier);
+
  private:
   // The module containing all TBC (i.e., bytecode) for the TPL program.
   std::unique_ptr<BytecodeModule> bytecode_module_;
@@ -176,13 +242,40 @@ class Module {
   std::unique_ptr<LLVMEngine::CompiledModule> jit_module_;
   // Function pointers for all functions defined in the TPL program. Pointers
   // may point into bytecode stub functions (i.e., interpreted implementations),
-  // or into compiled machine-code implementations.
+  // or into compiled machine-code implementations. Adaptively compiled code
+  // calls functions through these slots.
   std::unique_ptr<std::atomic<void *>[]> functions_;
   // Trampolines for all bytecode functions.
   std::unique_ptr<Trampoline[]> bytecode_trampolines_;
   // Compilation flag used to ensure compilation occurs only once, even under
   // concurrent invocations.
   std::once_flag compiled_flag_;
+
+  // The tier of the implementation of each function in functions_. Only
+  // modified together with functions_ while holding install_mutex_.
+  std::unique_ptr<std::atomic<Tier>[]> tiers_;
+  std::mutex install_mutex_;
+  // How hot each function is in the interpreter and in baseline machine code.
+  std::unique_ptr<std::atomic<uint64_t>[]> hotness_;
+  // The unoptimized machine code, compiled once in adaptive mode.
+  std::unique_ptr<LLVMEngine::CompiledModule> baseline_module_;
+  std::once_flag baseline_flag_;
+  // Whether the baseline compilation finished, after which hot functions are
+  // recompiled.
+  std::atomic<bool> baseline_ready_{false};
+  // Whether a compilation of the hot functions is running.
+  mutable std::atomic<bool> compiling_hot_functions_{false};
+  // The machine code of the hot functions. Code that has been swapped out may
+  // still run, so it lives as long as the module.
+  std::vector<std::unique_ptr<LLVMEngine::CompiledModule>> hot_modules_;
+  // The number of background compilations that were enqueued and haven't
+  // finished yet.
+  std::mutex compile_tasks_mutex_;
+  std::condition_variable compile_tasks_cv_;
+  uint32_t num_compile_tasks_{0};
+  // Set once the module is being destroyed, after which background
+  // compilations stop as soon as possible.
+  std::atomic<bool> shutting_down_{false};
 };
 
 // ---------------------------------------------------------
@@ -224,7 +317,28 @@ inline bool Module::GetFunction(const std::string &name, const ExecutionMode exe
   switch (exec_mode) {
     case ExecutionMode::Adaptive: {
       CompileToMachineCodeAsync();
-      TERRIER_FALLTHROUGH;
+      std::function<Ret(ArgTypes...)> interpreted;
+      GetFunction(name, ExecutionMode::Interpret, &interpreted);
+      *func = [this, func_info, interpreted](ArgTypes... args) -> Ret {
+        // Run machine code as soon as there is some. Baseline code counts how
+        // hot its functions get, but leaves recompiling them to us.
+        void *raw_func = functions_[func_info->Id()].load(std::memory_order_acquire);
+        if (raw_func != GetBytecodeImpl(func_info->Id())) {
+          auto *jit_f = reinterpret_cast<Ret (*)(ArgTypes...)>(raw_func);
+          // NOLINTNEXTLINE: bugprone-suspicious-semicolon: seems like a false positive because of constexpr
+          if constexpr (std::is_void_v<Ret>) {
+            jit_f(args...);
+            CheckHotFunctions();
+            return;
+          } else {  // NOLINT
+            Ret rv = jit_f(args...);
+            CheckHotFunctions();
+            return rv;
+          }
+        }
+        return interpreted(args...);
+      };
+      break;
     }
     case ExecutionMode::Interpret: {
       *func = [this, func_info](ArgTypes... args) -> Ret {
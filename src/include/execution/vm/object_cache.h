@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <unordered_map>
+
+#include "llvm/Support/MemoryBuffer.h"
+
+#include "common/macros.h"
+#include "execution/util/execution_common.h"
+#include "execution/util/hash.h"
+
+namespace terrier::execution::vm {
+
+/**
+ * A content-addressed cache of JIT-compiled object code in a local directory, which outlives the process. Each entry
+ * is keyed by a fingerprint: a full description of everything the machine code depends on. Files are named after a
+ * hash of the fingerprint, and store the fingerprint itself so that hash collisions are detected rather than running
+ * the wrong code. Hits are memory-mapped back in. When the cache grows beyond its capacity, the least recently used
+ * entries are removed. Recency survives restarts through the modification times of the files.
+ *
+ * Several processes may share a directory. Entries are written to a temporary file and renamed into place, so readers
+ * never see partial entries, but each process only accounts for the entries it knew about.
+ */
+class ObjectCache {
+ public:
+  /**
+   * Open the cache in the given directory, creating the directory if needed and picking up the entries already there.
+   * @param directory directory holding the entries
+   * @param capacity maximum total size of the entries in bytes
+   */
+  ObjectCache(std::string directory, uint64_t capacity);
+
+  /**
+   * This class cannot be copied or moved
+   */
+  DISALLOW_COPY_AND_MOVE(ObjectCache);
+
+  /**
+   * Look up the object code compiled for the given fingerprint.
+   * @param fingerprint the fingerprint of the code
+   * @return the object code, or nullptr if it is not cached
+   */
+  std::unique_ptr<llvm::MemoryBuffer> Lookup(const std::string &fingerprint);
+
+  /**
+   * Cache the object code compiled for the given fingerprint, replacing any previous entry with the same hash.
+   * @param fingerprint the fingerprint of the code
+   * @param object_code the object code
+   * @return whether the object code was written to the cache
+   */
+  bool Insert(const std::string &fingerprint, const llvm::MemoryBuffer &object_code);
+
+  /**
+   * @return total size of the entries in bytes
+   */
+  uint64_t Size() const {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return size_;
+  }
+
+  /**
+   * @return the number of entries
+   */
+  uint64_t NumEntries() const {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return entries_.size();
+  }
+
+  /**
+   * @return the directory holding the entries
+   */
+  const std::string &Directory() const { return directory_; }
+
+ private:
+  struct Entry {
+    uint64_t size_;
+    std::list<hash_t>::iterator lru_pos_;
+  };
+
+  // Path of the entry with the given hash
+  std::string PathFor(hash_t hash) const;
+
+  // Record an entry as the most recently used. Must hold the mutex.
+  void Touch(hash_t hash, uint64_t size);
+
+  // Forget an entry, and remove its file. Must hold the mutex.
+  void Erase(hash_t hash);
+
+  const std::string directory_;
+  const uint64_t capacity_;
+
+  mutable std::mutex mutex_;
+  // Entries by hash of their fingerprint
+  std::unordered_map<hash_t, Entry> entries_;
+  // Hashes, most recently used first
+  std::list<hash_t> lru_;
+  uint64_t size_{0};
+};
+
+}  // namespace terrier::execution::vm
@@ -40,6 +40,9 @@ class VM {
  private:
   // The module
   const Module *module_;
+  // The number of loop iterations, i.e., backward jumps, of the function
+  // currently running
+  uint64_t loop_iterations_{0};
 };
 
 }  // namespace terrier::execution::vm
@@ -11,6 +11,7 @@
 #include "common/stat_registry.h"
 #include "common/worker_pool.h"
 #include "execution/execution_util.h"
+#include "execution/vm/object_cache.h"
 #include "metrics/metrics_thread.h"
 #include "network/terrier_server.h"
 #include "optimizer/statistics/stats_storage.h"
@@ -230,19 +231,37 @@ class DBMain {
      * @param traffic_cop argument to the ConnectionHandleFactor
      * @param port argument to TerrierServer
      * @param connection_thread_count argument to TerrierServer
+     * @param query_worker_count number of threads to execute queries on, 0 to execute them on the connection threads
+     * @param socket_buffer_capacity argument to the ConnectionHandleFactory
      */
     NetworkLayer(const common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry,
                  const common::ManagedPointer<trafficcop::TrafficCop> traffic_cop, const uint16_t port,
-                 const uint16_t connection_thread_count) {
-      connection_handle_factory_ = std::make_unique<network::ConnectionHandleFactory>(traffic_cop);
+                 const uint16_t connection_thread_count, const uint16_t query_worker_count,
+                 const uint32_t socket_buffer_capacity) {
+      if (query_worker_count > 0) {
+        query_workers_ = std::make_unique<common::WorkerPool>(query_worker_count, common::TaskQueue());
+        query_workers_->Startup();
+      }
+      connection_handle_factory_ =
+          std::make_unique<network::ConnectionHandleFactory>(traffic_cop, socket_buffer_capacity);
       command_factory_ = std::make_unique<network::PostgresCommandFactory>();
-      provider_ =
-          std::make_unique<network::PostgresProtocolInterpreter::Provider>(common::ManagedPointer(command_factory_));
+      provider_ = std::make_unique<network::PostgresProtocolInterpreter::Provider>(
+          common::ManagedPointer(command_factory_), common::ManagedPointer(query_workers_));
       server_ = std::make_unique<network::TerrierServer>(common::ManagedPointer(provider_),
                                                          common::ManagedPointer(connection_handle_factory_),
                                                          thread_registry, port, connection_thread_count);
     }
 
+    /**
+     * Drains the query workers before anything their queries use is destroyed
+     */
+    ~NetworkLayer() {
+      if (query_workers_ != DISABLED) {
+        query_workers_->WaitUntilAllFinished();
+        query_workers_->Shutdown();
+      }
+    }
+
     /**
      * @return ManagedPointer to the component
      */
@@ -250,6 +269,7 @@ class DBMain {
 
    private:
     // Order matters here for destruction order
+    std::unique_ptr<common::WorkerPool> query_workers_;
     std::unique_ptr<network::ConnectionHandleFactory> connection_handle_factory_;
     std::unique_ptr<network::PostgresCommandFactory> command_factory_;
     std::unique_ptr<network::ProtocolInterpreter::Provider> provider_;
@@ -257,13 +277,37 @@ class DBMain {
   };
 
   /**
-   * Currently doesn't hold any objects. The constructor and destructor are just used to orchestrate the setup and
-   * teardown for TPL.
+   * The constructor and destructor are used to orchestrate the setup and teardown for TPL. Optionally holds the cache
+   * of compiled machine code that outlives the process.
    */
   class ExecutionLayer {
    public:
-    ExecutionLayer() { execution::ExecutionUtil::InitTPL(); }
-    ~ExecutionLayer() { execution::ExecutionUtil::ShutdownTPL(); }
+    /**
+     * @param jit_cache_directory directory of the cache of compiled machine code, empty to not cache it
+     * @param jit_cache_size maximum size of the cache of compiled machine code in bytes
+     */
+    explicit ExecutionLayer(const std::string &jit_cache_directory = "", const uint64_t jit_cache_size = 0) {
+      execution::ExecutionUtil::InitTPL();
+      if (!jit_cache_directory.empty()) {
+        object_cache_ = std::make_unique<execution::vm::ObjectCache>(jit_cache_directory, jit_cache_size);
+        execution::vm::LLVMEngine::SetObjectCache(object_cache_.get());
+      }
+    }
+
+    ~ExecutionLayer() {
+      execution::vm::LLVMEngine::SetObjectCache(nullptr);
+      execution::ExecutionUtil::ShutdownTPL();
+    }
+
+    /**
+     * @return ManagedPointer to the cache of compiled machine code, can be nullptr if disabled
+     */
+    common::ManagedPointer<execution::vm::ObjectCache> GetObjectCache() const {
+      return common::ManagedPointer(object_cache_);
+    }
+
+   private:
+    std::unique_ptr<execution::vm::ObjectCache> object_cache_;
   };
 
   /**
@@ -341,7 +385,7 @@ class DBMain {
 
       std::unique_ptr<ExecutionLayer> execution_layer = DISABLED;
       if (use_execution_) {
-        execution_layer = std::make_unique<ExecutionLayer>();
+        execution_layer = std::make_unique<ExecutionLayer>(jit_cache_directory_, jit_cache_size_);
       }
 
       std::unique_ptr<trafficcop::TrafficCop> traffic_cop = DISABLED;
@@ -352,7 +396,8 @@ class DBMain {
         TERRIER_ASSERT(use_execution_ && execution_layer != DISABLED, "TrafficCopLayer needs ExecutionLayer.");
         traffic_cop = std::make_unique<trafficcop::TrafficCop>(
             txn_layer->GetTransactionManager(), catalog_layer->GetCatalog(), DISABLED,
-            common::ManagedPointer(stats_storage), optimizer_timeout_, use_query_cache_);
+            common::ManagedPointer(stats_storage), optimizer_timeout_, optimizer_thread_count_, use_query_cache_,
+            result_cache_size_, sort_memory_budget_, server_side_copy_);
       }
 
       std::unique_ptr<NetworkLayer> network_layer = DISABLED;
@@ -360,7 +405,8 @@ class DBMain {
         TERRIER_ASSERT(use_traffic_cop_ && traffic_cop != DISABLED, "NetworkLayer needs TrafficCopLayer.");
         network_layer =
             std::make_unique<NetworkLayer>(common::ManagedPointer(thread_registry), common::ManagedPointer(traffic_cop),
-                                           network_port_, connection_thread_count_);
+                                           network_port_, connection_thread_count_, query_worker_count_,
+                                           socket_buffer_capacity_);
       }
 
       db_main->settings_manager_ = std::move(settings_manager);
@@ -543,6 +589,24 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value NetworkLayer argument
+     * @return self reference for chaining
+     */
+    Builder &SetQueryWorkerCount(const uint16_t value) {
+      query_worker_count_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value NetworkLayer argument
+     * @return self reference for chaining
+     */
+    Builder &SetSocketBufferCapacity(const uint32_t value) {
+      socket_buffer_capacity_ = value;
+      return *this;
+    }
+
     /**
      * @param value RecordBufferSegmentPool argument
      * @return self reference for chaining
@@ -588,6 +652,15 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value TrafficCop argument
+     * @return self reference for chaining
+     */
+    Builder &SetOptimizerThreadCount(const uint32_t value) {
+      optimizer_thread_count_ = value;
+      return *this;
+    }
+
     /**
      * @param value use component
      * @return self reference for chaining
@@ -597,6 +670,51 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value TrafficCop argument
+     * @return self reference for chaining
+     */
+    Builder &SetResultCacheSize(const uint64_t value) {
+      result_cache_size_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value TrafficCop argument
+     * @return self reference for chaining
+     */
+    Builder &SetSortMemoryBudget(const uint64_t value) {
+      sort_memory_budget_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value TrafficCop argument
+     * @return self reference for chaining
+     */
+    Builder &SetServerSideCopy(const bool value) {
+      server_side_copy_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value ExecutionLayer argument
+     * @return self reference for chaining
+     */
+    Builder &SetJitCacheDirectory(const std::string &value) {
+      jit_cache_directory_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value ExecutionLayer argument
+     * @return self reference for chaining
+     */
+    Builder &SetJitCacheSize(const uint64_t value) {
+      jit_cache_size_ = value;
+      return *this;
+    }
+
     /**
      * @param value use component
      * @return self reference for chaining
@@ -634,11 +752,19 @@ class DBMain {
     bool use_gc_thread_ = false;
     bool use_stats_storage_ = false;
     bool use_execution_ = false;
+    std::string jit_cache_directory_;
+    uint64_t jit_cache_size_ = static_cast<uint64_t>(1) << 28;
     bool use_traffic_cop_ = false;
     uint64_t optimizer_timeout_ = 5000;
+    uint32_t optimizer_thread_count_ = 4;
     bool use_query_cache_ = true;
+    uint64_t result_cache_size_ = 0;
+    uint64_t sort_memory_budget_ = 0;
+    bool server_side_copy_ = false;
     uint16_t network_port_ = 15721;
     uint16_t connection_thread_count_ = 4;
+    uint16_t query_worker_count_ = 4;
+    uint32_t socket_buffer_capacity_ = SOCKET_BUFFER_CAPACITY;
     bool use_network_ = false;
 
     /**
@@ -670,8 +796,18 @@ class DBMain {
       network_port_ = static_cast<uint16_t>(settings_manager->GetInt(settings::Param::port));
       connection_thread_count_ =
           static_cast<uint16_t>(settings_manager->GetInt(settings::Param::connection_thread_count));
+      query_worker_count_ = static_cast<uint16_t>(settings_manager->GetInt(settings::Param::query_worker_count));
+      socket_buffer_capacity_ =
+          static_cast<uint32_t>(settings_manager->GetInt(settings::Param::socket_buffer_capacity));
       optimizer_timeout_ = static_cast<uint64_t>(settings_manager->GetInt(settings::Param::task_execution_timeout));
+      optimizer_thread_count_ =
+          static_cast<uint32_t>(settings_manager->GetInt(settings::Param::optimizer_thread_count));
       use_query_cache_ = settings_manager->GetBool(settings::Param::use_query_cache);
+      result_cache_size_ = static_cast<uint64_t>(settings_manager->GetInt64(settings::Param::result_cache_size));
+      sort_memory_budget_ = static_cast<uint64_t>(settings_manager->GetInt64(settings::Param::sort_memory_budget));
+      server_side_copy_ = settings_manager->GetBool(settings::Param::server_side_copy);
+      jit_cache_directory_ = settings_manager->GetString(settings::Param::jit_cache_directory);
+      jit_cache_size_ = static_cast<uint64_t>(settings_manager->GetInt64(settings::Param::jit_cache_size));
 
       return settings_manager;
     }
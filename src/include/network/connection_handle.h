@@ -47,11 +47,12 @@ class ConnectionHandle {
    * @param handler The handler responsible for this handle
    * @param tcop The pointer to the traffic cop
    * @param interpreter protocol interpreter to use for this connection handle
+   * @param buffer_capacity capacity of the socket read and write buffers
    */
   ConnectionHandle(int sock_fd, common::ManagedPointer<ConnectionHandlerTask> handler,
                    common::ManagedPointer<trafficcop::TrafficCop> tcop,
-                   std::unique_ptr<ProtocolInterpreter> interpreter)
-      : io_wrapper_(std::make_unique<NetworkIoWrapper>(sock_fd)),
+                   std::unique_ptr<ProtocolInterpreter> interpreter, size_t buffer_capacity = SOCKET_BUFFER_CAPACITY)
+      : io_wrapper_(std::make_unique<NetworkIoWrapper>(sock_fd, buffer_capacity)),
         conn_handler_(handler),
         traffic_cop_(tcop),
         protocol_interpreter_(std::move(interpreter)) {
@@ -108,7 +109,12 @@ class ConnectionHandle {
    * @return The transition to trigger in the state machine after
    */
   Transition TryWrite() {
-    if (io_wrapper_->ShouldFlush()) return io_wrapper_->FlushAllWrites();
+    // If the client pipelined more messages that are already complete in the ReadBuffer, process those before
+    // honoring a forced flush so that all of their responses go out together. A full buffer is flushed regardless.
+    const auto out = io_wrapper_->GetWriteQueue();
+    if (out->HasFullBuffer() ||
+        (out->ShouldFlush() && !protocol_interpreter_->HasCompletePacket(io_wrapper_->GetReadBuffer())))
+      return io_wrapper_->FlushAllWrites();
 
     return Transition::PROCEED;
   }
@@ -28,8 +28,11 @@ class ConnectionHandleFactory {
   /**
    * Builds a new connection handle factory.
    * @param tcop The pointer to the traffic cop
+   * @param buffer_capacity capacity of the socket read and write buffers of every connection
    */
-  explicit ConnectionHandleFactory(common::ManagedPointer<trafficcop::TrafficCop> tcop) : traffic_cop_(tcop) {}
+  explicit ConnectionHandleFactory(common::ManagedPointer<trafficcop::TrafficCop> tcop,
+                                   size_t buffer_capacity = SOCKET_BUFFER_CAPACITY)
+      : traffic_cop_(tcop), buffer_capacity_(buffer_capacity) {}
 
   /**
    * @brief Creates or re-purpose a NetworkIoWrapper object for new use.
@@ -51,5 +54,6 @@ class ConnectionHandleFactory {
   common::SpinLatch reusable_handles_latch_;
   std::unordered_map<int, ConnectionHandle> reusable_handles_;
   common::ManagedPointer<trafficcop::TrafficCop> traffic_cop_;
+  const size_t buffer_capacity_;
 };
 }  // namespace terrier::network
@@ -24,6 +24,8 @@ class ConnectionHandleFactory;
  * A client connection, once taken by the dispatch, is sent to a handler.
  * Then all related client events are registered in the handler task.
  * All client interaction happens on the same ConnectionHandlerTask thread for the entire lifetime of the connection.
+ * Query execution may be handed off to a pool of query workers, in which case the connection stops listening for
+ * client events until the worker wakes it back up on this thread.
  */
 class ConnectionHandlerTask : public common::NotifiableTask {
  public:
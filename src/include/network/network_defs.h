@@ -35,6 +35,9 @@ STRONG_TYPEDEF(connection_id_t, uint16_t);
 // Limit on the length of a packet
 #define PACKET_LEN_LIMIT 2500000
 
+// Limit on the length of the data of a COPY ... FROM STDIN, which is buffered until the client sent all of it
+#define COPY_IN_LEN_LIMIT (100 * PACKET_LEN_LIMIT)
+
 // For all of the enums defined in this header, we will
 // use this value to indicate that it is an invalid value
 // I don't think it matters whether this is 0 or -1
@@ -44,6 +47,8 @@ constexpr int INVALID_TYPE_ID = 0;
 // Wire protocol typedefs
 //===--------------------------------------------------------------------===//
 #define SOCKET_BUFFER_CAPACITY 8192
+// Maximum number of WriteBuffers handed to a single writev call when flushing a WriteQueue
+#define MAX_WRITEV_BUFFERS 64
 
 /* byte type */
 using uchar = unsigned char;
@@ -84,6 +89,11 @@ enum class NetworkMessageType : unsigned char {
   PG_PARAMETER_DESCRIPTION = 't',
   PG_ROW_DESCRIPTION = 'T',
   PG_DATA_ROW = 'D',
+  PG_COPY_IN_RESPONSE = 'G',
+  PG_COPY_OUT_RESPONSE = 'H',
+  PG_COPY_DATA = 'd',
+  PG_COPY_DONE = 'c',
+  PG_COPY_FAIL = 'f',
   // Errors  // TODO(Matt): These should be their own enums. They're field types for ErrorResponse and NoticeResponse,
   // not message types
   PG_HUMAN_READABLE_ERROR = 'M',
@@ -1,7 +1,10 @@
 #pragma once
 #include <arpa/inet.h>
+#include <sys/uio.h>
 
 #include <algorithm>
+#include <array>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <vector>
@@ -207,6 +210,11 @@ class ReadBufferView {
     return result;
   }
 
+  /**
+   * @return number of bytes that have not been read yet
+   */
+  size_t BytesLeft() const { return size_ - offset_; }
+
  private:
   size_t offset_ = 0, size_;
   ByteBuf::const_iterator begin_;
@@ -282,6 +290,18 @@ class ReadBuffer : public Buffer {
     return result;
   }
 
+  /**
+   * Reads a 32-bit integer in network byte order at the given offset past the cursor without consuming anything.
+   * It is up to the caller to ensure that there are enough bytes available in the read buffer.
+   * @param offset number of bytes past the cursor to read at
+   * @return value of the integer switched from network byte order
+   */
+  uint32_t PeekUint32(const size_t offset) {
+    uint32_t val;
+    std::memcpy(&val, &buf_[offset_ + offset], sizeof(val));
+    return be32toh(val);
+  }
+
   /**
    * Reads a generic value from the ReadBuffer
    * @tparam T The type to read
@@ -308,6 +328,11 @@ class ReadBuffer : public Buffer {
  */
 class WriteBuffer : public Buffer {
  public:
+  /**
+   * Instantiates a new buffer and reserve capacity many bytes.
+   */
+  explicit WriteBuffer(size_t capacity = SOCKET_BUFFER_CAPACITY) : Buffer(capacity) {}
+
   /**
    * Write as many bytes as possible using Posix write to fd
    * @param fd File descriptor to write out to
@@ -332,6 +357,22 @@ class WriteBuffer : public Buffer {
    */
   bool HasSpaceFor(size_t bytes) { return RemainingCapacity() >= bytes; }
 
+  /**
+   * @return iovec describing the bytes that have not been written out yet
+   */
+  iovec UnwrittenBytes() { return {&buf_[offset_], size_ - offset_}; }
+
+  /**
+   * Mark up to the given number of unwritten bytes as written out
+   * @param bytes number of bytes written out
+   * @return number of bytes of this buffer that were marked, at most bytes
+   */
+  size_t MarkWritten(size_t bytes) {
+    const size_t marked = std::min(bytes, size_ - offset_);
+    offset_ += marked;
+    return marked;
+  }
+
   /**
    * Append the desired range into current buffer.
    * @param src beginning of range
@@ -379,8 +420,9 @@ class WriteQueue {
  public:
   /**
    * Instantiates a new WriteQueue. By default this holds one buffer.
+   * @param buffer_capacity capacity of each WriteBuffer in the queue
    */
-  WriteQueue() { Reset(); }
+  explicit WriteQueue(size_t buffer_capacity = SOCKET_BUFFER_CAPACITY) : buffer_capacity_(buffer_capacity) { Reset(); }
 
   /**
    * Reset the write queue to its default state.
@@ -390,7 +432,7 @@ class WriteQueue {
     offset_ = 0;
     flush_ = false;
     if (buffers_[0] == nullptr)
-      buffers_[0] = std::make_unique<WriteBuffer>();
+      buffers_[0] = std::make_unique<WriteBuffer>(buffer_capacity_);
     else
       buffers_[0]->Reset();
   }
@@ -421,7 +463,49 @@ class WriteQueue {
    * a small response)
    * @return whether we should flush this write queue
    */
-  bool ShouldFlush() { return flush_ || buffers_.size() > 1; }
+  bool ShouldFlush() { return flush_ || HasFullBuffer(); }
+
+  /**
+   * Whether this WriteQueue has filled up its first buffer. Unlike a forced flush, this cannot be postponed to
+   * coalesce more responses without growing the queue further.
+   * @return whether the first buffer of this write queue is full
+   */
+  bool HasFullBuffer() { return buffers_.size() > 1; }
+
+  /**
+   * Write as many queued bytes as possible to fd, gathering up to MAX_WRITEV_BUFFERS buffers into a single Posix
+   * writev call. The head of the queue is advanced past every buffer that has been written out completely.
+   * @param fd File descriptor to write out to
+   * @return return value of Posix writev, or 0 if there was nothing left to write
+   */
+  ssize_t WriteOutTo(int fd) {
+    SkipWrittenBuffers();
+    if (offset_ == buffers_.size()) return 0;
+
+    std::array<iovec, MAX_WRITEV_BUFFERS> iov;
+    int iov_count = 0;
+    for (size_t i = offset_; i < buffers_.size() && iov_count < MAX_WRITEV_BUFFERS; i++)
+      iov[iov_count++] = buffers_[i]->UnwrittenBytes();
+
+    const ssize_t bytes_written = writev(fd, iov.data(), iov_count);
+    if (bytes_written > 0) {
+      auto remaining = static_cast<size_t>(bytes_written);
+      for (size_t i = offset_; remaining > 0; i++) remaining -= buffers_[i]->MarkWritten(remaining);
+      SkipWrittenBuffers();
+    }
+    return bytes_written;
+  }
+
+  /**
+   * Append all queued bytes that have not been written out yet to a string, e.g. to replay them later
+   * @param bytes string to append to
+   */
+  void CopyUnwrittenBytes(std::string *const bytes) {
+    for (size_t i = offset_; i < buffers_.size(); i++) {
+      const iovec unwritten = buffers_[i]->UnwrittenBytes();
+      bytes->append(reinterpret_cast<const char *>(unwritten.iov_base), unwritten.iov_len);
+    }
+  }
 
   /**
    * Write len many bytes starting from src into the write queue, allocating
@@ -439,7 +523,7 @@ class WriteQueue {
       // Only write partially if we are allowed to
       size_t written = breakup ? tail.RemainingCapacity() : 0;
       tail.AppendRaw(src, written);
-      buffers_.push_back(std::make_unique<WriteBuffer>());
+      buffers_.push_back(std::make_unique<WriteBuffer>(buffer_capacity_));
       BufferWriteRaw(reinterpret_cast<const uchar *>(src) + written, len - written);
     }
   }
@@ -460,6 +544,12 @@ class WriteQueue {
 
  private:
   friend class PacketWriter;
+
+  void SkipWrittenBuffers() {
+    while (offset_ < buffers_.size() && !buffers_[offset_]->HasMore()) offset_++;
+  }
+
+  const size_t buffer_capacity_;
   std::vector<std::unique_ptr<WriteBuffer>> buffers_;
   size_t offset_ = 0;
   bool flush_ = false;
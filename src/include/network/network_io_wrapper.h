@@ -31,9 +31,12 @@ class NetworkIoWrapper {
   /**
    * @brief Constructor for a PosixSocketIoWrapper
    * @param sock_fd The fd this IoWrapper communicates on
+   * @param buffer_capacity capacity of the read buffer and of each write buffer
    */
-  explicit NetworkIoWrapper(const int sock_fd)
-      : sock_fd_(sock_fd), in_(std::make_unique<ReadBuffer>()), out_(std::make_unique<WriteQueue>()) {
+  explicit NetworkIoWrapper(const int sock_fd, const size_t buffer_capacity = SOCKET_BUFFER_CAPACITY)
+      : sock_fd_(sock_fd),
+        in_(std::make_unique<ReadBuffer>(buffer_capacity)),
+        out_(std::make_unique<WriteQueue>(buffer_capacity)) {
     RestartState();
   }
 
@@ -55,7 +58,7 @@ class NetworkIoWrapper {
   Transition FlushWriteBuffer(common::ManagedPointer<WriteBuffer> wbuf);
 
   /**
-   * @brief Flushes all writes to this IOWrapper
+   * @brief Flushes all writes to this IOWrapper, gathering the queued buffers into as few writev calls as possible
    * @return The next transition for this client's state machine
    */
   Transition FlushAllWrites();
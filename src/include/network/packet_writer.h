@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -72,6 +73,16 @@ class PacketWriter {
     return *this;
   }
 
+  /**
+   * Write out whole packets that were serialized before, e.g. by a writer on another WriteQueue. There must be no
+   * packet active in the writer.
+   * @param packets serialized packets, each with its type and length
+   */
+  void WritePackets(const std::string_view packets) {
+    TERRIER_ASSERT(IsPacketEmpty(), "packet length is not null");
+    queue_->BufferWriteRaw(packets.data(), packets.size());
+  }
+
   /**
    * Append raw bytes from specified memory location into the write queue.
    * There must be a packet active in the writer.
@@ -1,4 +1,6 @@
 #pragma once
+#include <string>
+
 #include "network/network_command.h"
 
 #define DEFINE_POSTGRES_COMMAND(name, flush)                                                           \
@@ -50,6 +52,40 @@ DEFINE_POSTGRES_COMMAND(ExecuteCommand, false);
 DEFINE_POSTGRES_COMMAND(SyncCommand, true);
 DEFINE_POSTGRES_COMMAND(CloseCommand, true);
 DEFINE_POSTGRES_COMMAND(TerminateCommand, true);
+DEFINE_POSTGRES_COMMAND(CopyDataCommand, false);
+DEFINE_POSTGRES_COMMAND(CopyDoneCommand, true);
+DEFINE_POSTGRES_COMMAND(CopyFailCommand, true);
 DEFINE_POSTGRES_COMMAND(EmptyCommand, true);  // (Matt): This seems to be only for testing? Not a big fan of that.
 
+/**
+ * Fails the COPY ... FROM STDIN that the client is sending data for, and finishes the simple query that started it
+ * @param interpreter The protocol interpreter in the CopyIn sub-protocol
+ * @param out The Writer on which to construct output packets for the client
+ * @param t_cop The traffic cop pointer
+ * @param connection The ConnectionContext which contains connection information
+ * @param message The error to report to the client
+ * @return The next transition for the client's state machine
+ */
+Transition FailCopyIn(common::ManagedPointer<ProtocolInterpreter> interpreter,
+                      common::ManagedPointer<PostgresPacketWriter> out,
+                      common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                      common::ManagedPointer<ConnectionContext> connection, const std::string &message);
+
+/**
+ * Fails a command that threw while executing, and reports the error to the client like the command reports its own
+ * errors, so that the client can carry on with its next query
+ * @param interpreter The protocol interpreter that executed the command
+ * @param out The Writer on which to construct output packets for the client
+ * @param t_cop The traffic cop pointer
+ * @param connection The ConnectionContext which contains connection information
+ * @param msg_type The type of the message the command was built from
+ * @param message The error to report to the client
+ * @return The next transition for the client's state machine
+ */
+Transition FailCommand(common::ManagedPointer<ProtocolInterpreter> interpreter,
+                       common::ManagedPointer<PostgresPacketWriter> out,
+                       common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                       common::ManagedPointer<ConnectionContext> connection, NetworkMessageType msg_type,
+                       const std::string &message);
+
 }  // namespace terrier::network
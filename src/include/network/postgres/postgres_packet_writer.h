@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdio>
 #include <memory>
 #include <string>
 #include <utility>
@@ -176,6 +177,44 @@ class PostgresPacketWriter : public PacketWriter {
     EndPacket();
   }
 
+  /**
+   * Tells the client that COPY ... FROM STDIN is ready to receive its data as CopyData messages, all in text format
+   * @param num_cols number of columns in the copied rows
+   */
+  void WriteCopyInResponse(const uint16_t num_cols) {
+    BeginPacket(NetworkMessageType::PG_COPY_IN_RESPONSE)
+        .AppendValue<int8_t>(0)
+        .AppendValue<int16_t>(static_cast<int16_t>(num_cols));
+    for (uint16_t i = 0; i < num_cols; i++) AppendValue<int16_t>(0);
+    EndPacket();
+  }
+
+  /**
+   * Tells the client that COPY ... TO STDOUT is about to send its data as CopyData messages, all in text format
+   * @param num_cols number of columns in the copied rows
+   */
+  void WriteCopyOutResponse(const uint16_t num_cols) {
+    BeginPacket(NetworkMessageType::PG_COPY_OUT_RESPONSE)
+        .AppendValue<int8_t>(0)
+        .AppendValue<int16_t>(static_cast<int16_t>(num_cols));
+    for (uint16_t i = 0; i < num_cols; i++) AppendValue<int16_t>(0);
+    EndPacket();
+  }
+
+  /**
+   * Writes a chunk of COPY data. Postgres allows a message to hold any number of whole or partial rows.
+   * @param data data to send
+   * @param len number of bytes of data
+   */
+  void WriteCopyData(const char *const data, const size_t len) {
+    BeginPacket(NetworkMessageType::PG_COPY_DATA).AppendRaw(data, len).EndPacket();
+  }
+
+  /**
+   * Tells the client that all COPY data has been sent
+   */
+  void WriteCopyDone() { BeginPacket(NetworkMessageType::PG_COPY_DONE).EndPacket(); }
+
   /**
    * Tells the client that the query command is complete.
    * @param tag records the which kind of query it is. (INSERT? DELETE? SELECT?) and the number of rows.
@@ -239,6 +278,9 @@ class PostgresPacketWriter : public PacketWriter {
       case QueryType::QUERY_SET:
         WriteCommandComplete("SET");
         break;
+      case QueryType::QUERY_COPY:
+        WriteCommandComplete("COPY " + std::to_string(num_rows));
+        break;
       default:
         WriteCommandComplete("This QueryType needs a completion message!");
         break;
@@ -379,6 +421,48 @@ class PostgresPacketWriter : public PacketWriter {
     EndPacket();
   }
 
+  /**
+   * Write a batch of data rows from the execution engine back to the client. The column offsets, types and formats are
+   * resolved once for the whole batch rather than once per row.
+   * @param tuples pointer to the start of the first row
+   * @param num_tuples number of rows in the batch
+   * @param tuple_size size of each row in bytes
+   * @param columns OutputSchema describing the tuples
+   * @param field_formats vector formats for the attributes to write
+   */
+  void WriteDataRows(const byte *const tuples, const uint32_t num_tuples, const uint32_t tuple_size,
+                     const std::vector<planner::OutputSchema::Column> &columns,
+                     const std::vector<FieldFormat> &field_formats) {
+    const auto num_cols = static_cast<int16_t>(columns.size());
+    std::vector<uint32_t> offsets;
+    std::vector<type::TypeId> types;
+    std::vector<bool> text;
+    offsets.reserve(columns.size());
+    types.reserve(columns.size());
+    text.reserve(columns.size());
+    uint32_t curr_offset = 0;
+    for (uint32_t i = 0; i < columns.size(); i++) {
+      offsets.push_back(curr_offset);
+      types.push_back(columns[i].GetType());
+      text.push_back(field_formats[i < field_formats.size() ? i : 0] == FieldFormat::text);
+      curr_offset += execution::sql::ValUtil::GetSqlSize(types.back());
+    }
+
+    for (uint32_t row = 0; row < num_tuples; row++) {
+      const byte *const tuple = tuples + row * tuple_size;
+      BeginPacket(NetworkMessageType::PG_DATA_ROW).AppendValue<int16_t>(num_cols);
+      for (uint32_t i = 0; i < columns.size(); i++) {
+        const auto *const val = reinterpret_cast<const execution::sql::Val *const>(tuple + offsets[i]);
+        if (text[i]) {
+          WriteTextAttribute(val, types[i]);
+        } else {
+          WriteBinaryAttribute(val, types[i]);
+        }
+      }
+      EndPacket();
+    }
+  }
+
  private:
   template <class native_type, class val_type>
   void WriteBinaryVal(const execution::sql::Val *const val, const type::TypeId type) {
@@ -450,70 +534,133 @@ class PostgresPacketWriter : public PacketWriter {
     return execution::sql::ValUtil::GetSqlSize(type);
   }
 
+  /**
+   * Maximum number of characters needed to format a 64-bit integer in base 10, including the sign
+   */
+  static constexpr uint32_t MAX_INTEGER_TEXT_LENGTH = 20;
+
+  /**
+   * Format an integer in base 10 into the tail of the given buffer without going through a std::string
+   * @param val value to format
+   * @param buf_end one past the end of a buffer with at least MAX_INTEGER_TEXT_LENGTH characters
+   * @return pointer to the first character of the formatted value, which ends at buf_end
+   */
+  static char *FormatInteger(const int64_t val, char *const buf_end) {
+    char *pos = buf_end;
+    // Work on the magnitude as an unsigned value so that INT64_MIN does not overflow
+    uint64_t magnitude = val < 0 ? ~static_cast<uint64_t>(val) + 1 : static_cast<uint64_t>(val);
+    do {
+      *--pos = static_cast<char>('0' + magnitude % 10);
+      magnitude /= 10;
+    } while (magnitude != 0);
+    if (val < 0) *--pos = '-';
+    return pos;
+  }
+
   /**
    * Write a data row in Postgres' text format coming from an OutputBuffer in the execution engine. Simple Query
-   * messages always reply with text format data.
-   * @param tuple pointer to the start of the row
-   * @param columns OutputSchema describing the tuple
+   * messages always reply with text format data. Fixed-width values are formatted into a stack buffer and copied
+   * straight into the WriteQueue, so no intermediate std::string is built for them.
+   * @param val value to write
+   * @param type SQL type of the value
+   * @return size of the value in the execution engine's tuple
    */
   uint32_t WriteTextAttribute(const execution::sql::Val *const val, const type::TypeId type) {
     if (val->is_null_) {
       // write a -1 for the length of the column value and continue to the next value
       AppendValue<int32_t>(static_cast<int32_t>(-1));
-    } else {
-      // Convert the field to text format
-      std::string string_value;
-      switch (type) {
-        case type::TypeId::TINYINT:
-        case type::TypeId::SMALLINT:
-        case type::TypeId::BIGINT:
-        case type::TypeId::INTEGER: {
-          auto *int_val = reinterpret_cast<const execution::sql::Integer *const>(val);
-          string_value = std::to_string(int_val->val_);
-          break;
-        }
-        case type::TypeId::BOOLEAN: {
-          auto *bool_val = reinterpret_cast<const execution::sql::BoolVal *const>(val);
-          string_value = (static_cast<bool>(bool_val->val_) ? POSTGRES_BOOLEAN_STR_TRUE : POSTGRES_BOOLEAN_STR_FALSE);
-          break;
-        }
-        case type::TypeId::DECIMAL: {
-          auto *real_val = reinterpret_cast<const execution::sql::Real *const>(val);
-          string_value = std::to_string(real_val->val_);
-          break;
-        }
-        case type::TypeId::DATE: {
-          auto *date_val = reinterpret_cast<const execution::sql::DateVal *const>(val);
-          string_value = date_val->val_.ToString();
-          break;
-        }
-        case type::TypeId::TIMESTAMP: {
-          auto *ts_val = reinterpret_cast<const execution::sql::TimestampVal *const>(val);
-          string_value = ts_val->val_.ToString();
-          break;
+      return execution::sql::ValUtil::GetSqlSize(type);
+    }
+
+    // Convert the field to text format
+    switch (type) {
+      case type::TypeId::TINYINT:
+      case type::TypeId::SMALLINT:
+      case type::TypeId::BIGINT:
+      case type::TypeId::INTEGER: {
+        auto *int_val = reinterpret_cast<const execution::sql::Integer *const>(val);
+        char buf[MAX_INTEGER_TEXT_LENGTH];
+        const char *const begin = FormatInteger(int_val->val_, buf + sizeof(buf));
+        WriteTextValue(begin, static_cast<uint32_t>(buf + sizeof(buf) - begin));
+        break;
+      }
+      case type::TypeId::BOOLEAN: {
+        auto *bool_val = reinterpret_cast<const execution::sql::BoolVal *const>(val);
+        WriteTextValue(static_cast<bool>(bool_val->val_) ? POSTGRES_BOOLEAN_STR_TRUE : POSTGRES_BOOLEAN_STR_FALSE, 1);
+        break;
+      }
+      case type::TypeId::DECIMAL: {
+        auto *real_val = reinterpret_cast<const execution::sql::Real *const>(val);
+        // Same format as std::to_string, which only overflows this buffer for magnitudes beyond 1e56
+        char buf[64];
+        const int len = std::snprintf(buf, sizeof(buf), "%f", real_val->val_);
+        if (len > 0 && static_cast<size_t>(len) < sizeof(buf)) {
+          WriteTextValue(buf, static_cast<uint32_t>(len));
+        } else {
+          WriteTextValue(std::to_string(real_val->val_));
         }
-        case type::TypeId::VARCHAR:
-        case type::TypeId::VARBINARY: {
-          // Don't allocate an actual string for a VARCHAR, just wrap a std::string_view, write the value directly, and
-          // continue
-          auto *string_val = reinterpret_cast<const execution::sql::StringVal *const>(val);
-          AppendValue<int32_t>(static_cast<int32_t>(string_val->len_))
-              .AppendRaw(string_val->Content(), string_val->len_);
-          return execution::sql::ValUtil::GetSqlSize(type);
+        break;
+      }
+      case type::TypeId::DATE: {
+        auto *date_val = reinterpret_cast<const execution::sql::DateVal *const>(val);
+        const auto ymd = util::TimeConvertor::YMDFromDate(type::date_t{date_val->val_.ToNative()});
+        const auto year = static_cast<int32_t>(ymd.year());
+        if (ymd.ok() && year >= 0 && year <= 9999) {
+          // YYYY-MM-DD, matching Date::ToString
+          const auto month = static_cast<uint32_t>(ymd.month());
+          const auto day = static_cast<uint32_t>(ymd.day());
+          char buf[10] = {static_cast<char>('0' + year / 1000),
+                          static_cast<char>('0' + year / 100 % 10),
+                          static_cast<char>('0' + year / 10 % 10),
+                          static_cast<char>('0' + year % 10),
+                          '-',
+                          static_cast<char>('0' + month / 10),
+                          static_cast<char>('0' + month % 10),
+                          '-',
+                          static_cast<char>('0' + day / 10),
+                          static_cast<char>('0' + day % 10)};
+          WriteTextValue(buf, sizeof(buf));
+        } else {
+          WriteTextValue(date_val->val_.ToString());
         }
-        default:
-          UNREACHABLE(
-              "Unsupported type for text serialization. This is either a new type, or an oversight when reading JDBC "
-              "source code.");
+        break;
       }
-
-      // write the size, write the attribute
-      AppendValue<int32_t>(static_cast<int32_t>(string_value.length())).AppendString(string_value, false);
+      case type::TypeId::TIMESTAMP: {
+        auto *ts_val = reinterpret_cast<const execution::sql::TimestampVal *const>(val);
+        WriteTextValue(ts_val->val_.ToString());
+        break;
+      }
+      case type::TypeId::VARCHAR:
+      case type::TypeId::VARBINARY: {
+        // Don't allocate an actual string for a VARCHAR, just write the value directly
+        auto *string_val = reinterpret_cast<const execution::sql::StringVal *const>(val);
+        WriteTextValue(string_val->Content(), string_val->len_);
+        break;
+      }
+      default:
+        UNREACHABLE(
+            "Unsupported type for text serialization. This is either a new type, or an oversight when reading JDBC "
+            "source code.");
     }
 
     // Advance in the buffer based on the execution engine's type size
     return execution::sql::ValUtil::GetSqlSize(type);
   }
+
+  /**
+   * Write the size of a text value followed by the value itself
+   * @param str start of the text
+   * @param len length of the text in bytes
+   */
+  void WriteTextValue(const char *const str, const uint32_t len) {
+    AppendValue<int32_t>(static_cast<int32_t>(len)).AppendRaw(str, len);
+  }
+
+  /**
+   * Write the size of a text value followed by the value itself
+   * @param str the text
+   */
+  void WriteTextValue(const std::string &str) { WriteTextValue(str.data(), static_cast<uint32_t>(str.size())); }
 };
 
 }  // namespace terrier::network
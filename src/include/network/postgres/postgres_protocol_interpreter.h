@@ -5,6 +5,7 @@
 #include <unordered_map>
 #include <utility>
 
+#include "common/worker_pool.h"
 #include "loggers/network_logger.h"
 #include "network/connection_context.h"
 #include "network/connection_handle.h"
@@ -20,6 +21,8 @@ namespace terrier::network {
 constexpr uint32_t INITIAL_BACKOFF_TIME = 2;
 constexpr uint32_t BACKOFF_FACTOR = 2;
 constexpr uint32_t MAX_BACKOFF_TIME = 20;
+// Number of parameterized simple queries cached per connection before the cache starts over
+constexpr uint32_t SIMPLE_QUERY_CACHE_CAPACITY = 1024;
 
 /**
  * Interprets the network protocol for postgres clients. Any state/logic that is Postgres protocol-specific should live
@@ -35,27 +38,33 @@ class PostgresProtocolInterpreter : public ProtocolInterpreter {
     /**
      * Constructs a new provider
      * @param command_factory The command factory to use for the constructed protocol interpreters
+     * @param query_workers The worker pool that the constructed protocol interpreters hand queries off to, or
+     * DISABLED(nullptr) to execute queries on the connection handler thread
      */
-    explicit Provider(common::ManagedPointer<PostgresCommandFactory> command_factory)
-        : command_factory_(command_factory) {}
+    explicit Provider(common::ManagedPointer<PostgresCommandFactory> command_factory,
+                      common::ManagedPointer<common::WorkerPool> query_workers = DISABLED)
+        : command_factory_(command_factory), query_workers_(query_workers) {}
 
     /**
      * @return an instance of the protocol interpreter
      */
     std::unique_ptr<ProtocolInterpreter> Get() override {
-      return std::make_unique<PostgresProtocolInterpreter>(command_factory_);
+      return std::make_unique<PostgresProtocolInterpreter>(command_factory_, query_workers_);
     }
 
    private:
     common::ManagedPointer<PostgresCommandFactory> command_factory_;
+    common::ManagedPointer<common::WorkerPool> query_workers_;
   };
 
   /**
    * Creates the interpreter for Postgres
    * @param command_factory to convert packet into commands
+   * @param query_workers worker pool to execute queries on, or DISABLED(nullptr) to execute them on the calling thread
    */
-  explicit PostgresProtocolInterpreter(common::ManagedPointer<PostgresCommandFactory> command_factory)
-      : command_factory_(command_factory) {}
+  explicit PostgresProtocolInterpreter(common::ManagedPointer<PostgresCommandFactory> command_factory,
+                                       common::ManagedPointer<common::WorkerPool> query_workers = DISABLED)
+      : command_factory_(command_factory), query_workers_(query_workers) {}
 
   /**
    * @see ProtocolIntepreter::Process
@@ -80,14 +89,18 @@ class PostgresProtocolInterpreter : public ProtocolInterpreter {
                 common::ManagedPointer<trafficcop::TrafficCop> t_cop,
                 common::ManagedPointer<ConnectionContext> context) override;
 
-  // TODO(Tianyu): Fill in the following documentation at some point
   /**
-   * (Matt): I think this was used in Peloton for asynchronous execution, after a callback wakeup the ConnectionHandle
-   * would call to the protocol interpreter to get the state of the asynchronous query after the output was already
-   * complete.
-   * @param out
+   * Called once a query worker has finished executing a command that Process handed off to it and the ConnectionHandle
+   * has been woken up. The worker already wrote the command's output to the WriteQueue, so this only releases the
+   * command and hands its transition back to the state machine.
+   * @param out WriteQueue the command's output was written to
+   * @return the transition returned by the command's execution
    */
-  void GetResult(const common::ManagedPointer<WriteQueue> out) override {}
+  Transition GetResult(const common::ManagedPointer<WriteQueue> out) override {
+    TERRIER_ASSERT(async_command_ != nullptr, "No command was executing on a query worker.");
+    async_command_.reset();
+    return async_result_;
+  }
 
   /**
    * Used to clear the waiting for sync, explicit txn block, and portals. Call whenever a transaction is ended.
@@ -147,6 +160,45 @@ class PostgresProtocolInterpreter : public ProtocolInterpreter {
     waiting_for_sync_ = false;
   }
 
+  /**
+   * Enters the CopyIn sub-protocol, in which the client sends the data of COPY ... FROM STDIN until CopyDone or
+   * CopyFail. Any other message fails the COPY.
+   * @param statement COPY statement to load the data with
+   * @param owned_statement statement to take ownership of if it isn't cached, nullptr otherwise
+   */
+  void BeginCopyIn(const common::ManagedPointer<network::Statement> statement,
+                   std::unique_ptr<network::Statement> &&owned_statement) {
+    TERRIER_ASSERT(!CopyingIn(), "Already copying in. That seems wrong.");
+    copy_in_statement_ = statement;
+    copy_in_owned_statement_ = std::move(owned_statement);
+  }
+
+  /**
+   * @return true if the client is sending the data of COPY ... FROM STDIN
+   */
+  bool CopyingIn() const { return copy_in_statement_ != nullptr; }
+
+  /**
+   * @return COPY statement that the client is sending data for
+   */
+  common::ManagedPointer<network::Statement> CopyInStatement() const { return copy_in_statement_; }
+
+  /**
+   * @return data that the client sent so far, to append the next CopyData message to
+   */
+  std::string *CopyInData() { return &copy_in_data_; }
+
+  /**
+   * Leaves the CopyIn sub-protocol and releases the statement and its data
+   */
+  void EndCopyIn() {
+    TERRIER_ASSERT(CopyingIn(), "Not copying in. That seems wrong.");
+    copy_in_statement_ = nullptr;
+    copy_in_owned_statement_.reset();
+    copy_in_data_.clear();
+    copy_in_data_.shrink_to_fit();
+  }
+
   /**
    * @param name statement to look up
    * @return managed pointer to statement if it exists, nullptr otherwise
@@ -175,6 +227,39 @@ class PostgresProtocolInterpreter : public ProtocolInterpreter {
     return nullptr;
   }
 
+  /**
+   * Caches the statement of a parameterized simple query. An entry without a statement marks a query that can't be run
+   * parameterized, so it isn't parsed in vain again.
+   * @param key parameterized query text and the types of its parameters
+   * @param statement statement to take ownership of, or nullptr if the query can't be run parameterized
+   */
+  void AddSimpleQueryToCache(const std::string &key, std::unique_ptr<network::Statement> &&statement) {
+    // Queries whose constants can't be parameterized could fill the cache without bound
+    if (simple_query_cache_.size() >= SIMPLE_QUERY_CACHE_CAPACITY) simple_query_cache_.clear();
+    simple_query_cache_[key] = std::move(statement);
+  }
+
+  /**
+   * @param key parameterized query text and the types of its parameters
+   * @return true if the query is cached, even if without a statement
+   */
+  bool SimpleQueryCached(const std::string &key) const { return simple_query_cache_.count(key) != 0; }
+
+  /**
+   * @param key parameterized query text and the types of its parameters
+   * @return Statement if it exists in the cache, otherwise nullptr
+   */
+  common::ManagedPointer<network::Statement> LookupSimpleQueryInCache(const std::string &key) const {
+    const auto it = simple_query_cache_.find(key);
+    if (it != simple_query_cache_.end()) return common::ManagedPointer(it->second);
+    return nullptr;
+  }
+
+  /**
+   * @param key parameterized query text and the types of its parameters
+   */
+  void RemoveSimpleQueryFromCache(const std::string &key) { simple_query_cache_.erase(key); }
+
   /**
    * @param name key
    * @param statement statement to take ownership of
@@ -239,16 +324,43 @@ class PostgresProtocolInterpreter : public ProtocolInterpreter {
   bool explicit_txn_block_ = false;
 
   common::ManagedPointer<PostgresCommandFactory> command_factory_;
+  common::ManagedPointer<common::WorkerPool> query_workers_;
+  // command currently executing on a query worker, and the transition it returned once it is done
+  std::unique_ptr<PostgresNetworkCommand> async_command_;
+  Transition async_result_ = Transition::PROCEED;
 
   // fingerprint to statement
   std::unordered_map<std::string, std::unique_ptr<network::Statement>> statement_cache_;
 
+  // parameterized simple query to statement
+  std::unordered_map<std::string, std::unique_ptr<network::Statement>> simple_query_cache_;
+
   // name to statement
   std::unordered_map<std::string, common::ManagedPointer<network::Statement>> statements_;
 
   // name to portal
   std::unordered_map<std::string, std::unique_ptr<network::Portal>> portals_;
 
+  // COPY ... FROM STDIN that the client is sending data for, and the data received so far
+  common::ManagedPointer<network::Statement> copy_in_statement_ = nullptr;
+  std::unique_ptr<network::Statement> copy_in_owned_statement_;
+  std::string copy_in_data_;
+
+  /**
+   * Executes the current command on a query worker instead of the connection handler thread. The connection stops
+   * receiving network events until the worker is done and wakes it back up through the ConnectionContext's callback.
+   * @param command command to execute, ownership is kept until GetResult
+   * @param msg_type type of the message the command was built from
+   * @param out buffer to send results back out on
+   * @param t_cop non-owning pointer to the traffic cop to pass down to the command layer
+   * @param context connection-specific (not protocol) state
+   * @return NEED_RESULT
+   */
+  Transition ExecOnQueryWorker(std::unique_ptr<PostgresNetworkCommand> command, NetworkMessageType msg_type,
+                               common::ManagedPointer<WriteQueue> out,
+                               common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                               common::ManagedPointer<ConnectionContext> context);
+
   /**
    * close all Portals constructed from a Statement. We don't care about return value since it's not an error to call
    * Close on non-existent statement
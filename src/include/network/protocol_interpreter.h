@@ -57,10 +57,27 @@ class ProtocolInterpreter {
                         common::ManagedPointer<ConnectionContext> context) = 0;
 
   /**
-   * Sends a result
+   * Sends a result. Called when the connection is woken back up after Process returned NEED_RESULT.
    * @param out The WriteQueue to communicate with the client through
+   * @return The next transition for the client's associated state machine
+   */
+  virtual Transition GetResult(common::ManagedPointer<WriteQueue> out) = 0;
+
+  /**
+   * Checks whether the ReadBuffer already holds another complete packet, i.e., the client has pipelined more messages
+   * that can be processed without reading from the socket again. Nothing is consumed from the buffer.
+   * @param in The ReadBuffer to check
+   * @return whether a complete packet is available in the ReadBuffer
    */
-  virtual void GetResult(common::ManagedPointer<WriteQueue> out) = 0;
+  bool HasCompletePacket(const common::ManagedPointer<ReadBuffer> in) {
+    // A packet that is already being assembled was not complete the last time it was looked at
+    if (curr_input_packet_.header_parsed_) return false;
+    const size_t header_size = GetPacketHeaderSize();
+    if (!in->HasMore(header_size)) return false;
+    // The length field is the last part of the header, and counts itself but not the message type
+    const uint32_t len = in->PeekUint32(header_size - sizeof(uint32_t));
+    return in->HasMore(header_size - sizeof(uint32_t) + len);
+  }
 
   /**
    * Default destructor for ProtocolInterpreter
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -126,6 +127,33 @@ class IndexUtil {
     return CheckPredicates(index_schema, lookup, mapped_set, predicates, scan_type, bounds);
   }
 
+  /**
+   * Checks whether an index covers a set of table columns, i.e. whether all of them are key columns of the index.
+   * A scan that needs only these columns can then read them from the index keys instead of fetching the tuples.
+   *
+   * @param accessor CatalogAccessor
+   * @param tbl_oid OID of the table that the index is built on
+   * @param idx_oid OID of the index
+   * @param col_oids columns needed by the scan
+   * @returns TRUE if every column is a key column of the index
+   */
+  static bool CoversColumns(catalog::CatalogAccessor *accessor, catalog::table_oid_t tbl_oid,
+                            catalog::index_oid_t idx_oid, const std::vector<catalog::col_oid_t> &col_oids) {
+    auto &index_schema = accessor->GetIndexSchema(idx_oid);
+    if (!SatisfiesBaseColumnRequirement(index_schema)) {
+      return false;
+    }
+
+    std::vector<catalog::col_oid_t> mapped_cols;
+    std::unordered_map<catalog::col_oid_t, catalog::indexkeycol_oid_t> lookup;
+    if (!ConvertIndexKeyOidToColOid(accessor, tbl_oid, index_schema, &lookup, &mapped_cols)) {
+      return false;
+    }
+
+    return std::all_of(col_oids.begin(), col_oids.end(),
+                       [&](const catalog::col_oid_t col_oid) { return lookup.count(col_oid) != 0; });
+  }
+
  private:
   /**
    * Check whether predicate can take part in index computation
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace terrier::optimizer {
+
+/**
+ * Finds a cheap order to join a set of relations, given the estimated cardinality of each relation and the
+ * selectivities of the predicates between them. A join tree costs the sum of the cardinalities of its joins (C_out),
+ * and trees may be bushy.
+ *
+ * Join graphs of up to MAX_DP_RELATIONS relations are enumerated exhaustively with DPccp, which only ever joins two
+ * connected subgraphs of the join graph and so never considers cross products. A predicate over more than two relations
+ * connects all of them. Larger join graphs, and join graphs that need a cross product, fall back to greedy operator
+ * ordering (GOO), which keeps joining the two trees with the smallest result, preferring trees joined by a predicate.
+ */
+class JoinOrderEnumerator {
+ public:
+  /**
+   * Set of relations, one bit per relation
+   */
+  using RelationSet = uint64_t;
+
+  /**
+   * Largest join graph enumerated exhaustively. DPccp is cheap on chains and stars of this size, and still takes no
+   * more than a few million steps for a clique.
+   */
+  static constexpr uint32_t MAX_DP_RELATIONS = 14;
+
+  /**
+   * Largest join graph that can be enumerated at all
+   */
+  static constexpr uint32_t MAX_RELATIONS = 64;
+
+  /**
+   * Cheapest join tree found for a set of relations
+   */
+  struct JoinTree {
+    /**
+     * Estimated number of rows produced by the tree
+     */
+    double cardinality_;
+    /**
+     * Cost of the tree
+     */
+    double cost_;
+    /**
+     * Relations joined on the left side, or 0 if the tree is a single relation
+     */
+    RelationSet left_;
+    /**
+     * Relations joined on the right side, or 0 if the tree is a single relation
+     */
+    RelationSet right_;
+  };
+
+  /**
+   * @param cardinalities estimated number of rows of each relation
+   */
+  explicit JoinOrderEnumerator(std::vector<double> cardinalities);
+
+  /**
+   * Adds a predicate to the join graph
+   * @param relations relations the predicate refers to
+   * @param selectivity estimated fraction of rows that satisfy the predicate
+   */
+  void AddPredicate(RelationSet relations, double selectivity);
+
+  /**
+   * Enumerates the join trees of all relations, with DPccp or GOO
+   * @return true if the join trees were enumerated exhaustively
+   */
+  bool Enumerate();
+
+  /**
+   * @return whether any relation can be reached from any other through predicates
+   */
+  bool IsConnected() const;
+
+  /**
+   * @return set of all relations
+   */
+  RelationSet AllRelations() const {
+    return cardinalities_.size() == MAX_RELATIONS ? ~RelationSet{0} : (RelationSet{1} << cardinalities_.size()) - 1;
+  }
+
+  /**
+   * @param relations set of relations that is a subtree of the best join tree, or all relations
+   * @return cheapest join tree of the relations
+   */
+  const JoinTree &GetJoinTree(RelationSet relations) const;
+
+ private:
+  void EnumerateDP();
+  void EnumerateCsgRec(RelationSet csg, RelationSet excluded);
+  void EmitCsg(RelationSet csg);
+  void EnumerateCmpRec(RelationSet csg, RelationSet cmp, RelationSet excluded);
+  void EmitCsgCmp(RelationSet csg, RelationSet cmp);
+
+  void EnumerateGreedy();
+
+  RelationSet Neighborhood(RelationSet relations) const;
+  double Cardinality(RelationSet relations) const;
+
+  std::vector<double> cardinalities_;
+  // Relations that share a predicate with each relation
+  std::vector<RelationSet> neighbors_;
+  // Relations and selectivity of each predicate
+  std::vector<std::pair<RelationSet, double>> predicates_;
+  // Best join tree of each set of relations. DP fills in every connected set of relations, indexed by the set.
+  std::vector<JoinTree> dp_table_;
+  // Join trees built by GOO
+  std::unordered_map<RelationSet, JoinTree> greedy_trees_;
+};
+
+}  // namespace terrier::optimizer
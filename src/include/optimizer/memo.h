@@ -4,6 +4,7 @@
 #include <unordered_set>
 #include <vector>
 
+#include "common/spin_latch.h"
 #include "optimizer/group.h"
 #include "optimizer/group_expression.h"
 #include "optimizer/operator_node.h"
@@ -38,6 +39,9 @@ struct GExprPtrEq {
 /**
  * Memo class provides for tracking Groups and GroupExpressions and provides the
  * mechanisms by which we can do duplicate group detection.
+ *
+ * Tasks optimizing disjoint groups may insert and look up expressions and groups
+ * concurrently. The groups themselves are not latched.
  */
 class Memo {
  public:
@@ -94,6 +98,7 @@ class Memo {
    * @returns Group with specified ID
    */
   Group *GetGroupByID(group_id_t id) const {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
     auto idx = !id;
     TERRIER_ASSERT(idx >= 0 && static_cast<size_t>(idx) < groups_.size(), "group_id out of bounds");
     return groups_[idx];
@@ -106,6 +111,7 @@ class Memo {
    * @param group_id GroupID of Group to erase
    */
   void EraseExpression(group_id_t group_id) {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
     auto idx = !group_id;
     TERRIER_ASSERT(idx >= 0 && static_cast<size_t>(idx) < groups_.size(), "group_id out of bounds");
 
@@ -116,7 +122,7 @@ class Memo {
 
  private:
   /**
-   * Creates a new group
+   * Creates a new group, with the latch held
    * @param gexpr GroupExpression to collect metadata from
    * @returns GroupID of the new group
    */
@@ -132,6 +138,11 @@ class Memo {
    * Vector of groups tracked
    */
   std::vector<Group *> groups_;
+
+  /**
+   * Latch protecting the tracked GroupExpressions and the vector of groups
+   */
+  mutable common::SpinLatch latch_;
 };
 
 }  // namespace terrier::optimizer
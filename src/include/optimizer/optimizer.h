@@ -1,9 +1,12 @@
 #pragma once
 
+#include <chrono>  // NOLINT
 #include <memory>
 #include <utility>
 #include <vector>
 
+#include "common/managed_pointer.h"
+#include "common/worker_pool.h"
 #include "optimizer/abstract_optimizer.h"
 #include "optimizer/cost_model/abstract_cost_model.h"
 #include "optimizer/optimizer_context.h"
@@ -41,11 +44,14 @@ class Optimizer : public AbstractOptimizer {
    * Constructor for Optimizer with a cost_model
    * @param model Cost Model to use for the optimizer
    * @param task_execution_timeout time in ms to spend on a task
+   * @param workers threads that optimize independent inputs in parallel, nullptr to optimize on the calling thread only
    */
-  explicit Optimizer(std::unique_ptr<AbstractCostModel> model, const uint64_t task_execution_timeout)
+  explicit Optimizer(std::unique_ptr<AbstractCostModel> model, const uint64_t task_execution_timeout,
+                     const common::ManagedPointer<common::WorkerPool> workers = DISABLED)
       : cost_model_(std::move(model)),
         context_(std::make_unique<OptimizerContext>(common::ManagedPointer(cost_model_))),
-        task_execution_timeout_(task_execution_timeout) {}
+        task_execution_timeout_(task_execution_timeout),
+        workers_(workers) {}
 
   /**
    * Build the plan tree for query execution
@@ -95,15 +101,26 @@ class Optimizer : public AbstractOptimizer {
    * do not go beyond the time limit (unless if one plan has not been
    * generated yet)
    *
-   * @param task_stack Optimizer's Task Stack to execute through
+   * @param task_stack Optimizer's task pool to execute through
    * @param root_group_id Root Group ID to check whether there is a plan or not
    * @param root_context OptimizerContext to use that maintains required properties
    */
-  void ExecuteTaskStack(OptimizerTaskStack *task_stack, group_id_t root_group_id, OptimizationContext *root_context);
+  void ExecuteTaskStack(OptimizerTaskPool *task_stack, group_id_t root_group_id, OptimizationContext *root_context);
+
+  /**
+   * Whether the tasks of the current task stack ran out of time, once the root group has at least one plan. Forked
+   * stacks check it too, from other threads.
+   * @param root_group_id Root Group ID to check whether there is a plan or not
+   * @param root_context OptimizerContext to use that maintains required properties
+   */
+  bool TaskExecutionTimedOut(group_id_t root_group_id, OptimizationContext *root_context) const;
 
   std::unique_ptr<AbstractCostModel> cost_model_;
   std::unique_ptr<OptimizerContext> context_;
   const uint64_t task_execution_timeout_;
+  const common::ManagedPointer<common::WorkerPool> workers_;
+  // When the task stack that is executing started
+  std::chrono::steady_clock::time_point task_stack_start_;
 };
 
 }  // namespace optimizer
@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "common/settings.h"
+#include "common/spin_latch.h"
 #include "optimizer/cost_model/abstract_cost_model.h"
 #include "optimizer/group_expression.h"
 #include "optimizer/memo.h"
@@ -79,7 +80,10 @@ class OptimizerContext {
    * Adds a OptimizationContext to the tracking list
    * @param ctx OptimizationContext to add to tracking
    */
-  void AddOptimizationContext(OptimizationContext *ctx) { track_list_.push_back(ctx); }
+  void AddOptimizationContext(OptimizationContext *ctx) {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    track_list_.push_back(ctx);
+  }
 
   /**
    * Pushes a task to the task pool managed
@@ -93,6 +97,17 @@ class OptimizerContext {
    */
   AbstractCostModel *GetCostModel() { return cost_model_.Get(); }
 
+  /**
+   * Costs a GroupExpression with the cost model. Cost models keep the expression
+   * being costed in their members, so tasks on different threads take turns.
+   * @param gexpr GroupExpression to cost
+   * @returns cost of the GroupExpression
+   */
+  double CalculateCost(GroupExpression *gexpr) {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    return cost_model_->CalculateCost(txn_, &memo_, gexpr);
+  }
+
   /**
    * Gets the transaction
    * @returns transaction
@@ -127,6 +142,12 @@ class OptimizerContext {
     this->task_pool_ = task_pool;
   }
 
+  /**
+   * Gets the task pool
+   * @returns OptimizerTaskPool
+   */
+  OptimizerTaskPool *GetTaskPool() { return task_pool_; }
+
   /**
    * Converts an OperatorNode into a GroupExpression.
    * The GroupExpression is internal tracking that is focused on the concept
@@ -223,6 +244,8 @@ class OptimizerContext {
   StatsStorage *stats_storage_;
   transaction::TransactionContext *txn_;
   std::vector<OptimizationContext *> track_list_;
+  // Protects the tracking list and the cost model from tasks on different threads
+  common::SpinLatch latch_;
 };
 
 }  // namespace optimizer
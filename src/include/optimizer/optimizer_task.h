@@ -23,6 +23,7 @@ class RuleSet;
 class Group;
 class GroupExpression;
 class OptimizerContext;
+class JoinOrderEnumerator;
 enum class RuleSetName : uint32_t;
 
 /**
@@ -39,7 +40,8 @@ enum class OptimizerTaskType {
   REWRITE_EXPR,
   APPLY_REWIRE_RULE,
   TOP_DOWN_REWRITE,
-  BOTTOM_UP_REWRITE
+  BOTTOM_UP_REWRITE,
+  REORDER_JOINS
 };
 
 /**
@@ -284,7 +286,8 @@ class OptimizeExpressionCostWithEnforcedProperty : public OptimizerTask {
         group_expr_(task->group_expr_),
         cur_total_cost_(task->cur_total_cost_),
         cur_child_idx_(task->cur_child_idx_),
-        cur_prop_pair_idx_(task->cur_prop_pair_idx_) {}
+        cur_prop_pair_idx_(task->cur_prop_pair_idx_),
+        forked_prop_pair_idx_(task->forked_prop_pair_idx_) {}
 
   /**
    * Function to execute the task
@@ -304,6 +307,13 @@ class OptimizeExpressionCostWithEnforcedProperty : public OptimizerTask {
   }
 
  private:
+  /**
+   * Optimizes the child groups that are joins and share no groups with each other on the
+   * threads of the task pool, so that costing them afterwards finds their best expressions
+   * @param input_props properties required from the child groups
+   */
+  void OptimizeInputsInParallel(const std::vector<PropertySet *> &input_props);
+
   /**
    * Vector of pairs of GroupExpression's output properties and input properties for children
    */
@@ -333,6 +343,11 @@ class OptimizeExpressionCostWithEnforcedProperty : public OptimizerTask {
    * Current stage of enumeration through output_input_properties_
    */
   int cur_prop_pair_idx_ = 0;
+
+  /**
+   * Index of the last pair in output_input_properties_ whose inputs were optimized in parallel
+   */
+  int forked_prop_pair_idx_ = -1;
 };
 
 /**
@@ -457,5 +472,60 @@ class BottomUpRewrite : public OptimizerTask {
   bool has_optimized_child_;
 };
 
+/**
+ * ReorderJoins replaces every tree of inner joins below a group with the join order chosen by a JoinOrderEnumerator,
+ * based on the cardinalities of the joined relations. Each join of the new tree gets both orders of its inputs, and the
+ * join transformation rules are marked as explored on them, so Cascades only picks the physical joins for that order
+ * instead of enumerating join orders itself. The task expects every group below to still hold a single logical
+ * expression with derived stats, i.e. it runs after the rewrite passes and before exploration.
+ */
+class ReorderJoins : public OptimizerTask {
+ public:
+  /**
+   * Constructor for ReorderJoins task
+   * @param group_id Group to reorder the joins below
+   * @param context Current optimize context
+   */
+  ReorderJoins(group_id_t group_id, OptimizationContext *context)
+      : OptimizerTask(context, OptimizerTaskType::REORDER_JOINS), group_id_(group_id) {}
+
+  /**
+   * Function to execute the task
+   */
+  void Execute() override;
+
+ private:
+  /**
+   * Collects the relations and predicates of the inner joins rooted at a group
+   * @param group_id group of an inner join
+   * @param relations groups joined by the inner joins, in order
+   * @param predicates predicates of the inner joins
+   */
+  void CollectJoins(group_id_t group_id, std::vector<group_id_t> *relations,
+                    std::vector<AnnotatedExpression> *predicates) const;
+
+  /**
+   * Records the enumerated join tree of a set of relations into the memo
+   * @param enumerator enumerator that chose the join tree
+   * @param relation_set relations of the join tree
+   * @param relations groups of the relations
+   * @param predicates predicates of the joins
+   * @param predicate_relations relations each predicate refers to
+   * @param applied whether each predicate is already applied by a join lower in the tree
+   * @param target_group group whose expression is replaced by the join tree, or UNDEFINED_GROUP
+   * @return group of the join tree
+   */
+  group_id_t RecordJoinTree(const JoinOrderEnumerator &enumerator, uint64_t relation_set,
+                            const std::vector<group_id_t> &relations,
+                            const std::vector<AnnotatedExpression> &predicates,
+                            const std::vector<uint64_t> &predicate_relations, std::vector<bool> *applied,
+                            group_id_t target_group);
+
+  /**
+   * Group to reorder the joins below
+   */
+  group_id_t group_id_;
+};
+
 }  // namespace optimizer
 }  // namespace terrier
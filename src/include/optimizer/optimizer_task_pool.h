@@ -1,7 +1,14 @@
 #pragma once
 
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <stack>
+#include <utility>
+#include <vector>
+
+#include "common/managed_pointer.h"
+#include "common/worker_pool.h"
 #include "optimizer/optimizer_task.h"
 
 namespace terrier::optimizer {
@@ -28,6 +35,18 @@ class OptimizerTaskPool {
    */
   virtual bool Empty() = 0;
 
+  /**
+   * Executes tasks that are independent of each other, each along with all of the tasks that it pushes, and returns
+   * once all of them are done. The tasks pushed by one of them run in the same order as if it was the only task.
+   * @param tasks tasks to execute, whose ownership is transferred to the pool
+   */
+  virtual void ExecuteIndependentTasks(std::vector<OptimizerTask *> tasks) = 0;
+
+  /**
+   * @return number of threads that may execute the tasks of the pool at once
+   */
+  virtual uint32_t NumThreads() const { return 1; }
+
   /**
    * Trivial destructor
    */
@@ -76,6 +95,19 @@ class OptimizerTaskStack : public OptimizerTaskPool {
    */
   bool Empty() override { return task_stack_.empty(); }
 
+  /**
+   * Executes the tasks one after the other on top of the stack
+   * @param tasks tasks to execute, whose ownership is transferred to the stack
+   */
+  void ExecuteIndependentTasks(std::vector<OptimizerTask *> tasks) override {
+    const auto depth = task_stack_.size();
+    for (auto it = tasks.rbegin(); it != tasks.rend(); ++it) Push(*it);
+    while (task_stack_.size() > depth) {
+      std::unique_ptr<OptimizerTask> task(Pop());
+      task->Execute();
+    }
+  }
+
  private:
   /**
    * Stack for tracking tasks
@@ -83,4 +115,68 @@ class OptimizerTaskStack : public OptimizerTaskPool {
   std::stack<OptimizerTask *> task_stack_;
 };
 
+/**
+ * Task pool that executes independent tasks on several threads. Every thread executes the tasks on its own stack, so
+ * the tasks pushed by a task still run in stack order, but ExecuteIndependentTasks hands its tasks to helpers with
+ * their own stacks while the calling thread takes its share of them too. Helpers run on worker threads that all
+ * optimizations share, and never outnumber them. A forking thread never waits for a helper that hasn't started, but
+ * executes the tasks itself, so forks nest freely and the optimizations of concurrent queries don't block each other.
+ *
+ * The pool only schedules the tasks: forked tasks must not touch the same groups.
+ */
+class ParallelOptimizerTaskPool : public OptimizerTaskPool {
+ public:
+  /**
+   * @param workers threads shared by all optimizations, that execute forked tasks besides the thread driving the
+   *                optimization. The pool must be started, and outlive the forks.
+   */
+  explicit ParallelOptimizerTaskPool(const common::ManagedPointer<common::WorkerPool> workers)
+      : workers_(workers), num_helpers_(std::make_shared<std::atomic<uint32_t>>(0)) {}
+
+  /**
+   * @returns next OptimizerTask to execute on the calling thread
+   */
+  OptimizerTask *Pop() override { return CurrentStack()->Pop(); }
+
+  /**
+   * @param task OptimizerTask to execute after the task running on the calling thread
+   */
+  void Push(OptimizerTask *task) override { CurrentStack()->Push(task); }
+
+  /**
+   * @returns whether the calling thread has no tasks left to execute
+   */
+  bool Empty() override { return CurrentStack()->Empty(); }
+
+  /**
+   * Executes the tasks on as many threads as the pool can spare
+   * @param tasks tasks to execute, whose ownership is transferred to the pool
+   */
+  void ExecuteIndependentTasks(std::vector<OptimizerTask *> tasks) override;
+
+  /**
+   * @return number of threads that may execute the tasks of the pool at once
+   */
+  uint32_t NumThreads() const override { return workers_->NumWorkers() + 1; }
+
+  /**
+   * Set the check that stops the tasks on forked stacks, which the loop of the thread driving the optimization doesn't
+   * see until the fork is done
+   * @param timed_out returns whether the optimization ran out of time, and is called before every forked task
+   */
+  void SetTimeoutCheck(std::function<bool()> timed_out) { timed_out_ = std::move(timed_out); }
+
+ private:
+  OptimizerTaskStack *CurrentStack();
+  void ExecuteForkedTask(OptimizerTask *task);
+
+  const common::ManagedPointer<common::WorkerPool> workers_;
+  // Helpers submitted to the workers and not finished yet. Helpers that start after their fork is done only touch
+  // this counter and the state of the fork, so they share ownership of both.
+  const std::shared_ptr<std::atomic<uint32_t>> num_helpers_;
+  std::function<bool()> timed_out_;
+  // Tasks of the thread driving the optimization, outside of any fork
+  OptimizerTaskStack root_stack_;
+};
+
 }  // namespace terrier::optimizer
@@ -102,6 +102,15 @@ class IndexScanPlanNode : public AbstractScanPlanNode {
       return *this;
     }
 
+    /**
+     * @param covering_scan whether all the columns to scan are key columns of the index
+     * @return builder object
+     */
+    Builder &SetCoveringScan(bool covering_scan) {
+      covering_scan_ = covering_scan;
+      return *this;
+    }
+
     /**
      * Build the Index scan plan node
      * @return plan node
@@ -110,7 +119,7 @@ class IndexScanPlanNode : public AbstractScanPlanNode {
       return std::unique_ptr<IndexScanPlanNode>(new IndexScanPlanNode(
           std::move(children_), std::move(output_schema_), scan_predicate_, std::move(column_oids_), is_for_update_,
           database_oid_, namespace_oid_, index_oid_, table_oid_, scan_type_, std::move(lo_index_cols_),
-          std::move(hi_index_cols_), scan_limit_));
+          std::move(hi_index_cols_), scan_limit_, covering_scan_));
     }
 
    private:
@@ -121,6 +130,7 @@ class IndexScanPlanNode : public AbstractScanPlanNode {
     std::unordered_map<catalog::indexkeycol_oid_t, IndexExpression> lo_index_cols_{};
     std::unordered_map<catalog::indexkeycol_oid_t, IndexExpression> hi_index_cols_{};
     uint32_t scan_limit_{0};
+    bool covering_scan_{false};
   };
 
  private:
@@ -137,6 +147,7 @@ class IndexScanPlanNode : public AbstractScanPlanNode {
    * @param lo_index_cols lower bound of the scan (or exact key when scan type = Exact).
    * @param hi_index_cols upper bound of the scan
    * @param scan_limit limit of the scan if any
+   * @param covering_scan whether all the columns to scan are key columns of the index
    */
   IndexScanPlanNode(std::vector<std::unique_ptr<AbstractPlanNode>> &&children,
                     std::unique_ptr<OutputSchema> output_schema,
@@ -146,7 +157,7 @@ class IndexScanPlanNode : public AbstractScanPlanNode {
                     catalog::table_oid_t table_oid, IndexScanType scan_type,
                     std::unordered_map<catalog::indexkeycol_oid_t, IndexExpression> &&lo_index_cols,
                     std::unordered_map<catalog::indexkeycol_oid_t, IndexExpression> &&hi_index_cols,
-                    uint32_t scan_limit)
+                    uint32_t scan_limit, bool covering_scan)
       : AbstractScanPlanNode(std::move(children), std::move(output_schema), predicate, is_for_update, database_oid,
                              namespace_oid),
         scan_type_(scan_type),
@@ -155,7 +166,8 @@ class IndexScanPlanNode : public AbstractScanPlanNode {
         column_oids_(column_oids),
         lo_index_cols_(std::move(lo_index_cols)),
         hi_index_cols_(std::move(hi_index_cols)),
-        scan_limit_(scan_limit) {}
+        scan_limit_(scan_limit),
+        covering_scan_(covering_scan) {}
 
  public:
   /**
@@ -211,6 +223,12 @@ class IndexScanPlanNode : public AbstractScanPlanNode {
    */
   uint32_t ScanLimit() const { return scan_limit_; }
 
+  /**
+   * @return whether all the columns to scan are key columns of the index, so they can be read from the index keys
+   * without fetching the tuples from the table
+   */
+  bool IsCoveringScan() const { return covering_scan_; }
+
   /**
    * @return the type of this plan node
    */
@@ -235,6 +253,7 @@ class IndexScanPlanNode : public AbstractScanPlanNode {
   std::unordered_map<catalog::indexkeycol_oid_t, IndexExpression> lo_index_cols_{};
   std::unordered_map<catalog::indexkeycol_oid_t, IndexExpression> hi_index_cols_{};
   uint32_t scan_limit_;
+  bool covering_scan_;
 };
 
 DEFINE_JSON_DECLARATIONS(IndexScanPlanNode)
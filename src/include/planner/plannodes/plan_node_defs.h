@@ -95,7 +95,15 @@ enum class LogicalJoinType {
 // Set Operation Types
 //===--------------------------------------------------------------------===//
 
-enum class SetOpType { INVALID = INVALID_TYPE_ID, INTERSECT = 1, INTERSECT_ALL = 2, EXCEPT = 3, EXCEPT_ALL = 4 };
+enum class SetOpType {
+  INVALID = INVALID_TYPE_ID,
+  INTERSECT = 1,
+  INTERSECT_ALL = 2,
+  EXCEPT = 3,
+  EXCEPT_ALL = 4,
+  UNION = 5,
+  UNION_ALL = 6
+};
 
 //===--------------------------------------------------------------------===//
 // External File defaults
@@ -12,10 +12,9 @@ namespace terrier::planner {
 
 /**
  * Plan node for set operation:
- * INTERSECT/INTERSECT ALL/EXPECT/EXCEPT ALL
+ * INTERSECT/INTERSECT ALL/EXCEPT/EXCEPT ALL/UNION/UNION ALL
  *
- * @warning UNION (ALL) is handled differently.
- * IMPORTANT: Both children must have the same physical schema.
+ * IMPORTANT: Both children must have the same physical schema. The output schema refers to the columns of child 0.
  */
 class SetOpPlanNode : public AbstractPlanNode {
  public:
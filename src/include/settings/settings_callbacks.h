@@ -107,5 +107,15 @@ class Callbacks {
    */
   static void MetricsPipeline(void *old_value, void *new_value, DBMain *db_main,
                               common::ManagedPointer<common::ActionContext> action_context);
+
+  /**
+   * Change the number of bytes each sorter of later queries buffers before spilling to disk
+   * @param old_value old settings value
+   * @param new_value new settings value
+   * @param db_main pointer to db_main
+   * @param action_context pointer to the action context for this settings change
+   */
+  static void SortMemoryBudget(void *old_value, void *new_value, DBMain *db_main,
+                               common::ManagedPointer<common::ActionContext> action_context);
 };
 }  // namespace terrier::settings
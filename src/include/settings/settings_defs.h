@@ -22,6 +22,28 @@ SETTING_int(
     terrier::settings::Callbacks::NoOp
 )
 
+// Size of each per-connection socket read and write buffer
+SETTING_int(
+    socket_buffer_capacity,
+    "Capacity in bytes of each per-connection socket read and write buffer (default: 8192)",
+    8192,
+    1024,
+    1048576,
+    false,
+    terrier::settings::Callbacks::NoOp
+)
+
+// Query worker threads that connection handler threads hand query execution off to
+SETTING_int(
+    query_worker_count,
+    "Number of query worker threads that execute queries for the connection handler threads. 0 executes queries on the connection handler threads (default: 4)",
+    4,
+    0,
+    256,
+    false,
+    terrier::settings::Callbacks::NoOp
+)
+
 // RecordBufferSegmentPool size limit
 SETTING_int(
     record_buffer_segment_size,
@@ -125,6 +147,17 @@ SETTING_int(task_execution_timeout,
             "assuming one plan has been found (default 5000)",
             5000, 1000, 60000, false, terrier::settings::Callbacks::NoOp)
 
+// Optimizer worker threads, shared by all queries
+SETTING_int(
+    optimizer_thread_count,
+    "Number of threads that optimize independent inputs of joins in parallel, shared by all queries. 0 optimizes each query on a single thread (default: 4)",
+    4,
+    0,
+    256,
+    false,
+    terrier::settings::Callbacks::NoOp
+)
+
 // Parallel Execution
 SETTING_bool(
     parallel_execution,
@@ -176,3 +209,49 @@ SETTING_bool(
     false,
     terrier::settings::Callbacks::NoOp
 )
+
+SETTING_int64(
+    result_cache_size,
+    "Bytes of result rows of read-only SELECTs cached for reuse until a table they read changes, 0 to disable (default: 0)",
+    0,
+    0,
+    (1L << 32) /* 4GB */,
+    false,
+    terrier::settings::Callbacks::NoOp
+)
+
+SETTING_bool(
+    server_side_copy,
+    "Allow COPY to read and write files on the server, which any client can then reach (default: false)",
+    false,
+    false,
+    terrier::settings::Callbacks::NoOp
+)
+
+SETTING_string(
+    jit_cache_directory,
+    "Directory keeping the machine code of compiled queries across restarts, empty to disable (default: empty)",
+    "",
+    false,
+    terrier::settings::Callbacks::NoOp
+)
+
+SETTING_int64(
+    sort_memory_budget,
+    "Bytes of tuples each sorter buffers before spilling sorted runs to disk, 0 for no limit (default: 0)",
+    0,
+    0,
+    (1L << 40) /* 1TB */,
+    true,
+    terrier::settings::Callbacks::SortMemoryBudget
+)
+
+SETTING_int64(
+    jit_cache_size,
+    "Bytes of machine code kept in the JIT cache directory (default: 256MB)",
+    (1L << 28) /* 256MB */,
+    (1L << 20) /* 1MB */,
+    (1L << 40) /* 1TB */,
+    false,
+    terrier::settings::Callbacks::NoOp
+)
@@ -1,4 +1,5 @@
 #pragma once
+#include <atomic>
 #include <list>
 #include <unordered_map>
 #include <vector>
@@ -26,6 +27,8 @@ template <typename KeyType>
 class BwTreeIndex;
 template <typename KeyType>
 class HashIndex;
+template <typename KeyType>
+class ArtIndex;
 }  // namespace index
 
 // clang-format off
@@ -138,6 +141,22 @@ class DataTable {
   bool Select(common::ManagedPointer<transaction::TransactionContext> txn, TupleSlot slot,
               ProjectedRow *out_buffer) const;
 
+  /**
+   * Materializes the tuples at the given slots, as visible to the transaction given. This is equivalent to calling
+   * Select on each slot, but prefetches the tuples a few slots ahead of the one being read, which hides most of the
+   * cache misses of reading randomly placed tuples (e.g. slots coming out of an index). Slots that are not visible
+   * are skipped, so the materialized tuples are packed at the front of the output.
+   *
+   * @param txn the calling transaction
+   * @param slots the tuple slots to read
+   * @param num_slots number of slots to read
+   * @param out_buffers one output buffer per slot. All of them should contain the same projection list information.
+   * @param[out] out_slots the slots of the materialized tuples, in the same order as the output buffers
+   * @return the number of tuples that were visible and materialized
+   */
+  uint32_t SelectBatch(common::ManagedPointer<transaction::TransactionContext> txn, const TupleSlot *slots,
+                       uint32_t num_slots, ProjectedRow *const *out_buffers, TupleSlot *out_slots) const;
+
   // TODO(Tianyu): Should this be updated in place or return a new iterator? Does the caller ever want to
   // save a point of scan and come back to it later?
   // Alternatively, we can provide an easy wrapper that takes in a const SlotIterator & and returns a SlotIterator,
@@ -174,6 +193,17 @@ class DataTable {
    */
   SlotIterator end() const;  // NOLINT for STL name compability
 
+  /**
+   * Lets different threads scan different blocks of the table, e.g. with Select on every slot of a block, without
+   * contending on the latch that SlotIterator takes on every step. Like end(), this only covers the blocks that exist
+   * at the time of the call, which holds every tuple visible to the calling transaction.
+   * @return the blocks of the table, in table order. Each has GetBlockLayout().NumSlots() slots.
+   */
+  std::vector<RawBlock *> GetBlocks() const {
+    common::SpinLatch::ScopedSpinLatch guard(&blocks_latch_);
+    return {blocks_.begin(), blocks_.end()};
+  }
+
   /**
    * Update the tuple according to the redo buffer given, and update the version chain to link to an
    * undo record that is allocated in the txn. The undo record is populated with a before-image of the tuple in the
@@ -220,6 +250,14 @@ class DataTable {
    */
   const BlockLayout &GetBlockLayout() const { return accessor_.GetBlockLayout(); }
 
+  /**
+   * A transaction that started after this timestamp sees every committed change to the table, so results read from
+   * the table stay valid for as long as it does not change.
+   * @return commit timestamp of the last transaction that committed a change to the table, or INITIAL_TXN_TIMESTAMP
+   * if none has
+   */
+  transaction::timestamp_t LastModified() const { return last_modified_.load(); }
+
  private:
   // The ArrowSerializer needs access to its blocks.
   friend class ArrowSerializer;
@@ -233,6 +271,8 @@ class DataTable {
   friend class index::BwTreeIndex;
   template <typename KeyType>
   friend class index::HashIndex;
+  template <typename KeyType>
+  friend class index::ArtIndex;
   // The block compactor elides transactional protection in the gather/compression phase and
   // needs raw access to the underlying table.
   friend class BlockCompactor;
@@ -259,6 +299,21 @@ class DataTable {
   // This function uses header_latch_ to ensure correctness
   void CheckMoveHead(std::list<RawBlock *>::iterator block);
   mutable DataTableCounter data_table_counter_;
+  // Set by the TransactionManager while it commits changes to the table
+  std::atomic<transaction::timestamp_t> last_modified_{transaction::INITIAL_TXN_TIMESTAMP};
+
+  // Groups of transactions can commit concurrently, so a later commit may get here first and must not be overwritten
+  void UpdateLastModified(const transaction::timestamp_t commit_time) {
+    transaction::timestamp_t last_modified = last_modified_.load();
+    while (last_modified < commit_time && !last_modified_.compare_exchange_weak(last_modified, commit_time)) {
+    }
+  }
+
+  // How many slots ahead of the one being read SelectBatch prefetches
+  static constexpr uint32_t SELECT_BATCH_PREFETCH_DISTANCE = 8;
+
+  // Prefetch the version pointer and the projected attributes of the given tuple
+  void PrefetchTuple(TupleSlot slot, const ProjectedRow &projection) const;
 
   // A templatized version for select, so that we can use the same code for both row and column access.
   // the method is explicitly instantiated for ProjectedRow and ProjectedColumns::RowView
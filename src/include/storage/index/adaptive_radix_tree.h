@@ -0,0 +1,836 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "common/constants.h"
+#include "common/macros.h"
+#include "common/spin_latch.h"
+#include "storage/storage_defs.h"
+
+namespace terrier::storage::index {
+
+/**
+ * Adaptive radix tree (Leis et al., ICDE 2013) over fixed-size keys whose bytes compare like the keys themselves,
+ * mapping every key to one or more TupleSlots.
+ *
+ * Inner nodes hold 4, 16, 48 or 256 children and are replaced by the next larger kind when they fill up, so a node is
+ * sized to its fan-out and a lookup touches one small node per key byte. Every inner node stores the complete prefix
+ * shared by its subtree (keys are at most 32 bytes), so lookups never go back to a leaf to check skipped bytes. A
+ * subtree holding a single key is just a leaf hanging off its parent (lazy expansion).
+ *
+ * Concurrency uses optimistic lock coupling (Leis et al., DaMoN 2016). Each inner node has a version word. Readers
+ * never write to the tree: they validate the versions of the nodes they read and restart when one changed. Writers
+ * lock only the one or two nodes they modify. Leaves are immutable and replaced as a whole on every change. Nodes and
+ * leaves that are replaced or removed are only freed once no operation that could still read them is running, see
+ * PerformGarbageCollection. Nodes are never shrunk, but an inner node left without keys is removed.
+ *
+ * @tparam KeyType fixed-size key type exposing its bytes through KeyData(), e.g. CompactIntsKey
+ */
+template <typename KeyType>
+class AdaptiveRadixTree {
+ public:
+  AdaptiveRadixTree() : root_(new Node256()) {}
+
+  ~AdaptiveRadixTree() {
+    FreeTree(root_);
+    for (auto &garbage : garbage_) {
+      for (auto *const node : garbage) FreeNode(node);
+    }
+  }
+
+  DISALLOW_COPY_AND_MOVE(AdaptiveRadixTree)
+
+  /**
+   * Add a value to a key.
+   * @param key the key
+   * @param value the value to add
+   * @param predicate evaluated on the existing values of the key, with the key latched. The value is only added if it
+   * returns false for all of them.
+   * @param[out] predicate_satisfied set to true if the predicate returned true for an existing value
+   * @return true if the value was added, false if the key already had this value or the predicate was satisfied
+   */
+  bool ConditionalInsert(const KeyType &key, const TupleSlot value, const std::function<bool(TupleSlot)> &predicate,
+                         bool *const predicate_satisfied) {
+    EpochGuard guard(this);
+    bool restart;
+    bool result;
+    do {
+      restart = false;
+      result = TryInsert(key, value, predicate, predicate_satisfied, &restart);
+    } while (restart);
+    return result;
+  }
+
+  /**
+   * Add a value to a key.
+   * @param key the key
+   * @param value the value to add
+   * @return true if the value was added, false if the key already had this value
+   */
+  bool Insert(const KeyType &key, const TupleSlot value) {
+    bool predicate_satisfied = false;
+    return ConditionalInsert(
+        key, value, [](TupleSlot) { return false; }, &predicate_satisfied);
+  }
+
+  /**
+   * Remove a value from a key.
+   * @param key the key
+   * @param value the value to remove
+   * @return true if the value was removed, false if the key did not have this value
+   */
+  bool Delete(const KeyType &key, const TupleSlot value) {
+    EpochGuard guard(this);
+    bool restart;
+    bool result;
+    do {
+      restart = false;
+      result = TryDelete(key, value, &restart);
+    } while (restart);
+    return result;
+  }
+
+  /**
+   * Find the values of a key.
+   * @param key the key
+   * @param[out] values the values of the key are appended to this
+   */
+  void GetValue(const KeyType &key, std::vector<TupleSlot> *const values) const {
+    EpochGuard guard(this);
+    const Leaf *leaf;
+    bool restart;
+    do {
+      restart = false;
+      leaf = TryLookup(key, &restart);
+    } while (restart);
+    if (leaf != nullptr) values->insert(values->end(), leaf->Values(), leaf->Values() + leaf->num_values_);
+  }
+
+  /**
+   * Visit the keys of the tree in order, starting at a bound.
+   * @tparam Visitor callable as visitor(const KeyType &key, const TupleSlot *values, uint32_t num_values)
+   * @param bound the key to start at, nullptr to start at the smallest (largest, if descending) key
+   * @param inclusive whether a key equal to the bound is visited
+   * @param ascending whether keys are visited in ascending or descending order
+   * @param max_keys the maximum number of keys to visit
+   * @param visitor called once per key, in order
+   * @return the number of keys visited. Fewer than max_keys means there are no more keys past the bound.
+   */
+  template <typename Visitor>
+  uint32_t Scan(const KeyType *const bound, const bool inclusive, const bool ascending, const uint32_t max_keys,
+                Visitor &&visitor) const {
+    EpochGuard guard(this);
+    std::vector<const Leaf *> leaves;
+    leaves.reserve(max_keys);
+    // A restart resumes after the last key found, so keys are neither skipped nor repeated
+    const byte *current_bound = bound == nullptr ? nullptr : bound->KeyData();
+    bool current_inclusive = inclusive;
+    while (!Collect(root_, 0, current_bound, current_bound != nullptr, current_inclusive, ascending, max_keys,
+                    &leaves)) {
+      if (!leaves.empty()) {
+        current_bound = leaves.back()->key_.KeyData();
+        current_inclusive = false;
+      }
+    }
+    for (const auto *const leaf : leaves) visitor(leaf->key_, leaf->Values(), leaf->num_values_);
+    return static_cast<uint32_t>(leaves.size());
+  }
+
+  /**
+   * Free the nodes and leaves that were removed from the tree, once no operation that could still read them is
+   * running. Removed memory is freed by the second call after its removal at the earliest, so this should be called
+   * periodically.
+   */
+  void PerformGarbageCollection() {
+    common::SpinLatch::ScopedSpinLatch guard(&garbage_latch_);
+    const uint64_t epoch = epoch_.load();
+    const uint64_t previous = (epoch - 1) % 2;
+    // Memory removed in the previous epoch can be freed once the operations that started in it are done. Operations
+    // that started since cannot reach it anymore.
+    for (const auto &stripe : active_[previous]) {
+      if (stripe.count_.load() != 0) return;
+    }
+    for (auto *const node : garbage_[previous]) FreeNode(node);
+    garbage_[previous].clear();
+    epoch_.store(epoch + 1);
+  }
+
+ private:
+  static constexpr uint32_t KEY_SIZE = sizeof(KeyType);
+  static_assert(KEY_SIZE <= 32, "Keys are stored with their full prefix in the node headers.");
+
+  enum class NodeType : uint8_t { NODE4, NODE16, NODE48, NODE256 };
+
+  // Version word bits
+  static constexpr uint64_t OBSOLETE_BIT = 0b01;
+  static constexpr uint64_t LOCKED_BIT = 0b10;
+
+  struct Node {
+    explicit Node(const NodeType type) : type_(type) {}
+    std::atomic<uint64_t> version_{0};
+    const NodeType type_;
+    uint8_t prefix_len_ = 0;
+    uint16_t count_ = 0;
+    byte prefix_[KEY_SIZE];
+  };
+
+  struct Node4 : Node {
+    Node4() : Node(NodeType::NODE4) {}
+    uint8_t keys_[4];
+    std::atomic<Node *> children_[4]{};
+  };
+
+  struct Node16 : Node {
+    Node16() : Node(NodeType::NODE16) {}
+    uint8_t keys_[16];
+    std::atomic<Node *> children_[16]{};
+  };
+
+  struct Node48 : Node {
+    static constexpr uint8_t EMPTY = 48;
+    Node48() : Node(NodeType::NODE48) { std::memset(child_index_, EMPTY, sizeof(child_index_)); }
+    uint8_t child_index_[256];
+    std::atomic<Node *> children_[48]{};
+  };
+
+  struct Node256 : Node {
+    Node256() : Node(NodeType::NODE256) {}
+    std::atomic<Node *> children_[256]{};
+  };
+
+  /**
+   * A key with all of its values, stored right after the leaf. Child pointers to leaves are tagged in their low bit.
+   */
+  struct alignas(alignof(TupleSlot)) Leaf {
+    KeyType key_;
+    uint32_t num_values_;
+    const TupleSlot *Values() const { return reinterpret_cast<const TupleSlot *>(this + 1); }
+    TupleSlot *Values() { return reinterpret_cast<TupleSlot *>(this + 1); }
+  };
+
+  /**
+   * Registers an operation in the current epoch for its duration. The active operations of each epoch are counted in
+   * several cache line sized stripes, so that threads don't contend on a single counter.
+   */
+  class EpochGuard {
+   public:
+    explicit EpochGuard(const AdaptiveRadixTree *const tree) : tree_(tree) {
+      static thread_local const uint32_t stripe =
+          static_cast<uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id()) % NUM_STRIPES);
+      stripe_ = stripe;
+      while (true) {
+        epoch_ = tree_->epoch_.load();
+        tree_->active_[epoch_ % 2][stripe_].count_.fetch_add(1);
+        if (tree_->epoch_.load() == epoch_) return;
+        tree_->active_[epoch_ % 2][stripe_].count_.fetch_sub(1);
+      }
+    }
+    ~EpochGuard() { tree_->active_[epoch_ % 2][stripe_].count_.fetch_sub(1); }
+    DISALLOW_COPY_AND_MOVE(EpochGuard)
+
+   private:
+    const AdaptiveRadixTree *const tree_;
+    uint64_t epoch_;
+    uint32_t stripe_;
+  };
+
+  static constexpr uint32_t NUM_STRIPES = 16;
+
+  struct alignas(common::Constants::CACHELINE_SIZE) ActiveCount {
+    std::atomic<uint64_t> count_{0};
+  };
+
+  Node *const root_;
+  std::atomic<uint64_t> epoch_{1};
+  mutable std::array<std::array<ActiveCount, NUM_STRIPES>, 2> active_;
+  common::SpinLatch garbage_latch_;
+  std::array<std::vector<Node *>, 2> garbage_;
+
+  static bool IsLeaf(const Node *const node) { return (reinterpret_cast<uintptr_t>(node) & 1) != 0; }
+  static Leaf *AsLeaf(Node *const node) { return reinterpret_cast<Leaf *>(reinterpret_cast<uintptr_t>(node) & ~1ULL); }
+  static Node *Tag(Leaf *const leaf) { return reinterpret_cast<Node *>(reinterpret_cast<uintptr_t>(leaf) | 1); }
+
+  /**
+   * @return a leaf with the values of the given leaf (if any) and the given value, except for the value to skip (if
+   * any), tagged as a child pointer
+   */
+  static Node *NewLeaf(const KeyType &key, const Leaf *const copy_from, const TupleSlot *const add,
+                       const TupleSlot *const skip) {
+    const uint32_t num_copied = copy_from == nullptr ? 0 : copy_from->num_values_;
+    const uint32_t num_values = num_copied + (add != nullptr ? 1 : 0) - (skip != nullptr ? 1 : 0);
+    auto *const leaf = new (::operator new(sizeof(Leaf) + num_values * sizeof(TupleSlot))) Leaf{key, num_values};
+    TupleSlot *out = leaf->Values();
+    for (uint32_t i = 0; i < num_copied; i++) {
+      if (skip == nullptr || copy_from->Values()[i] != *skip) *out++ = copy_from->Values()[i];
+    }
+    if (add != nullptr) *out = *add;
+    return Tag(leaf);
+  }
+
+  static void FreeNode(Node *const node) {
+    if (IsLeaf(node)) {
+      ::operator delete(AsLeaf(node));
+      return;
+    }
+    switch (node->type_) {
+      case NodeType::NODE4:
+        delete static_cast<Node4 *>(node);
+        break;
+      case NodeType::NODE16:
+        delete static_cast<Node16 *>(node);
+        break;
+      case NodeType::NODE48:
+        delete static_cast<Node48 *>(node);
+        break;
+      case NodeType::NODE256:
+        delete static_cast<Node256 *>(node);
+        break;
+    }
+  }
+
+  static void FreeTree(Node *const node) {
+    if (!IsLeaf(node)) {
+      std::array<uint8_t, 256> bytes;
+      std::array<Node *, 256> children;
+      const uint32_t num_children = GetChildren(node, 0, 255, &bytes, &children);
+      for (uint32_t i = 0; i < num_children; i++) FreeTree(children[i]);
+    }
+    FreeNode(node);
+  }
+
+  void Retire(Node *const node) {
+    common::SpinLatch::ScopedSpinLatch guard(&garbage_latch_);
+    garbage_[epoch_.load() % 2].emplace_back(node);
+  }
+
+  /*
+   * Optimistic lock coupling. A reader takes the version of a node before reading it and checks that it did not change
+   * afterwards. A writer upgrades the version it read to a lock, which fails if the node changed in between.
+   */
+
+  static bool Restart(bool *const restart) {
+    *restart = true;
+    return false;
+  }
+
+  static bool ReadLock(const Node *const node, uint64_t *const version) {
+    *version = node->version_.load();
+    return (*version & (OBSOLETE_BIT | LOCKED_BIT)) == 0;
+  }
+
+  static bool Validate(const Node *const node, const uint64_t version) { return node->version_.load() == version; }
+
+  static bool UpgradeToWriteLock(Node *const node, uint64_t version) {
+    return node->version_.compare_exchange_strong(version, version + LOCKED_BIT);
+  }
+
+  // Adding LOCKED_BIT again clears it and carries into the version counter
+  static void WriteUnlock(Node *const node) { node->version_.fetch_add(LOCKED_BIT); }
+
+  static void WriteUnlockObsolete(Node *const node) { node->version_.fetch_add(LOCKED_BIT | OBSOLETE_BIT); }
+
+  /*
+   * Node accessors. Readers call FindChild and GetChildren without holding a lock, so they only ever read within the
+   * bounds of the node, whatever the state of a concurrent write.
+   */
+
+  static Node *FindChild(const Node *const node, const uint8_t key_byte) {
+    switch (node->type_) {
+      case NodeType::NODE4: {
+        const auto *const n = static_cast<const Node4 *>(node);
+        const uint32_t count = std::min<uint32_t>(n->count_, 4);
+        for (uint32_t i = 0; i < count; i++) {
+          if (n->keys_[i] == key_byte) return n->children_[i].load(std::memory_order_relaxed);
+        }
+        return nullptr;
+      }
+      case NodeType::NODE16: {
+        const auto *const n = static_cast<const Node16 *>(node);
+        const uint32_t count = std::min<uint32_t>(n->count_, 16);
+        for (uint32_t i = 0; i < count; i++) {
+          if (n->keys_[i] == key_byte) return n->children_[i].load(std::memory_order_relaxed);
+        }
+        return nullptr;
+      }
+      case NodeType::NODE48: {
+        const auto *const n = static_cast<const Node48 *>(node);
+        const uint8_t index = n->child_index_[key_byte];
+        return index < Node48::EMPTY ? n->children_[index].load(std::memory_order_relaxed) : nullptr;
+      }
+      case NodeType::NODE256:
+        return static_cast<const Node256 *>(node)->children_[key_byte].load(std::memory_order_relaxed);
+    }
+    TERRIER_ASSERT(false, "Invalid node type.");
+    return nullptr;
+  }
+
+  /**
+   * Copy out the children of a node whose key bytes are in [low, high], in ascending order of key byte.
+   * @return the number of children copied
+   */
+  static uint32_t GetChildren(const Node *const node, const uint8_t low, const uint8_t high,
+                              std::array<uint8_t, 256> *const bytes, std::array<Node *, 256> *const children) {
+    uint32_t num_children = 0;
+    const auto add = [&](const uint8_t key_byte, Node *const child) {
+      if (child != nullptr && key_byte >= low && key_byte <= high) {
+        (*bytes)[num_children] = key_byte;
+        (*children)[num_children++] = child;
+      }
+    };
+    switch (node->type_) {
+      case NodeType::NODE4: {
+        const auto *const n = static_cast<const Node4 *>(node);
+        const uint32_t count = std::min<uint32_t>(n->count_, 4);
+        for (uint32_t i = 0; i < count; i++) add(n->keys_[i], n->children_[i].load(std::memory_order_relaxed));
+        break;
+      }
+      case NodeType::NODE16: {
+        const auto *const n = static_cast<const Node16 *>(node);
+        const uint32_t count = std::min<uint32_t>(n->count_, 16);
+        for (uint32_t i = 0; i < count; i++) add(n->keys_[i], n->children_[i].load(std::memory_order_relaxed));
+        break;
+      }
+      case NodeType::NODE48: {
+        const auto *const n = static_cast<const Node48 *>(node);
+        for (uint32_t b = low; b <= high; b++) {
+          const uint8_t index = n->child_index_[b];
+          if (index < Node48::EMPTY) add(static_cast<uint8_t>(b), n->children_[index].load(std::memory_order_relaxed));
+        }
+        break;
+      }
+      case NodeType::NODE256: {
+        const auto *const n = static_cast<const Node256 *>(node);
+        for (uint32_t b = low; b <= high; b++) {
+          add(static_cast<uint8_t>(b), n->children_[b].load(std::memory_order_relaxed));
+        }
+        break;
+      }
+    }
+    return num_children;
+  }
+
+  static bool IsFull(const Node *const node) {
+    switch (node->type_) {
+      case NodeType::NODE4:
+        return node->count_ == 4;
+      case NodeType::NODE16:
+        return node->count_ == 16;
+      case NodeType::NODE48:
+        return node->count_ == 48;
+      case NodeType::NODE256:
+        return false;
+    }
+    TERRIER_ASSERT(false, "Invalid node type.");
+    return false;
+  }
+
+  // Keys of Node4 and Node16 are kept sorted, so that their children can be visited in order
+  template <typename SortedNode>
+  static void AddSortedChild(SortedNode *const node, const uint8_t key_byte, Node *const child) {
+    uint32_t pos = 0;
+    while (pos < node->count_ && node->keys_[pos] < key_byte) pos++;
+    for (uint32_t i = node->count_; i > pos; i--) {
+      node->keys_[i] = node->keys_[i - 1];
+      node->children_[i].store(node->children_[i - 1].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    node->keys_[pos] = key_byte;
+    node->children_[pos].store(child, std::memory_order_relaxed);
+    node->count_++;
+  }
+
+  template <typename SortedNode>
+  static void RemoveSortedChild(SortedNode *const node, const uint8_t key_byte) {
+    uint32_t pos = 0;
+    while (node->keys_[pos] != key_byte) pos++;
+    for (uint32_t i = pos; i + 1 < node->count_; i++) {
+      node->keys_[i] = node->keys_[i + 1];
+      node->children_[i].store(node->children_[i + 1].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    node->count_--;
+  }
+
+  // The following modify a node, which must be write locked or not yet reachable
+
+  static void AddChild(Node *const node, const uint8_t key_byte, Node *const child) {
+    TERRIER_ASSERT(!IsFull(node), "Node must have room for the child.");
+    switch (node->type_) {
+      case NodeType::NODE4:
+        AddSortedChild(static_cast<Node4 *>(node), key_byte, child);
+        break;
+      case NodeType::NODE16:
+        AddSortedChild(static_cast<Node16 *>(node), key_byte, child);
+        break;
+      case NodeType::NODE48: {
+        auto *const n = static_cast<Node48 *>(node);
+        // Slots of removed children are reused
+        uint8_t slot = 0;
+        while (n->children_[slot].load(std::memory_order_relaxed) != nullptr) slot++;
+        n->children_[slot].store(child, std::memory_order_relaxed);
+        n->child_index_[key_byte] = slot;
+        n->count_++;
+        break;
+      }
+      case NodeType::NODE256: {
+        auto *const n = static_cast<Node256 *>(node);
+        n->children_[key_byte].store(child, std::memory_order_relaxed);
+        n->count_++;
+        break;
+      }
+    }
+  }
+
+  static void ChangeChild(Node *const node, const uint8_t key_byte, Node *const child) {
+    switch (node->type_) {
+      case NodeType::NODE4: {
+        auto *const n = static_cast<Node4 *>(node);
+        for (uint32_t i = 0; i < n->count_; i++) {
+          if (n->keys_[i] == key_byte) n->children_[i].store(child, std::memory_order_relaxed);
+        }
+        break;
+      }
+      case NodeType::NODE16: {
+        auto *const n = static_cast<Node16 *>(node);
+        for (uint32_t i = 0; i < n->count_; i++) {
+          if (n->keys_[i] == key_byte) n->children_[i].store(child, std::memory_order_relaxed);
+        }
+        break;
+      }
+      case NodeType::NODE48: {
+        auto *const n = static_cast<Node48 *>(node);
+        n->children_[n->child_index_[key_byte]].store(child, std::memory_order_relaxed);
+        break;
+      }
+      case NodeType::NODE256:
+        static_cast<Node256 *>(node)->children_[key_byte].store(child, std::memory_order_relaxed);
+        break;
+    }
+  }
+
+  static void RemoveChild(Node *const node, const uint8_t key_byte) {
+    switch (node->type_) {
+      case NodeType::NODE4:
+        RemoveSortedChild(static_cast<Node4 *>(node), key_byte);
+        break;
+      case NodeType::NODE16:
+        RemoveSortedChild(static_cast<Node16 *>(node), key_byte);
+        break;
+      case NodeType::NODE48: {
+        auto *const n = static_cast<Node48 *>(node);
+        n->children_[n->child_index_[key_byte]].store(nullptr, std::memory_order_relaxed);
+        n->child_index_[key_byte] = Node48::EMPTY;
+        n->count_--;
+        break;
+      }
+      case NodeType::NODE256:
+        static_cast<Node256 *>(node)->children_[key_byte].store(nullptr, std::memory_order_relaxed);
+        node->count_--;
+        break;
+    }
+  }
+
+  /**
+   * @return a copy of a full node, of the next larger node type
+   */
+  static Node *Grow(const Node *const node) {
+    Node *bigger;
+    switch (node->type_) {
+      case NodeType::NODE4:
+        bigger = new Node16();
+        break;
+      case NodeType::NODE16:
+        bigger = new Node48();
+        break;
+      case NodeType::NODE48:
+        bigger = new Node256();
+        break;
+      default:
+        TERRIER_ASSERT(false, "Node256 never grows.");
+        return nullptr;
+    }
+    bigger->prefix_len_ = node->prefix_len_;
+    std::memcpy(bigger->prefix_, node->prefix_, node->prefix_len_);
+    std::array<uint8_t, 256> bytes;
+    std::array<Node *, 256> children;
+    const uint32_t num_children = GetChildren(node, 0, 255, &bytes, &children);
+    for (uint32_t i = 0; i < num_children; i++) AddChild(bigger, bytes[i], children[i]);
+    return bigger;
+  }
+
+  /**
+   * @return the length of the longest common prefix of the node's prefix and the key from the given depth
+   */
+  static uint32_t PrefixMatch(const Node *const node, const byte *const key, const uint32_t depth) {
+    // Bounded by the key, in case the prefix length was read from a node in the middle of a write
+    const uint32_t prefix_len = std::min<uint32_t>(node->prefix_len_, KEY_SIZE - depth);
+    uint32_t match = 0;
+    while (match < prefix_len && node->prefix_[match] == key[depth + match]) match++;
+    return match;
+  }
+
+  bool TryInsert(const KeyType &key, const TupleSlot value, const std::function<bool(TupleSlot)> &predicate,
+                 bool *const predicate_satisfied, bool *const restart) {
+    const byte *const key_bytes = key.KeyData();
+    Node *parent = nullptr;
+    uint64_t parent_version = 0;
+    uint8_t parent_byte = 0;
+    Node *node = root_;
+    uint64_t version;
+    if (!ReadLock(node, &version)) return Restart(restart);
+    uint32_t depth = 0;
+
+    while (true) {
+      const uint32_t match = PrefixMatch(node, key_bytes, depth);
+      if (match < node->prefix_len_) {
+        // The key leaves the node's prefix: a new node takes over the common part of the prefix, with the key and the
+        // node below it. The root has no prefix, so there is a parent.
+        if (!UpgradeToWriteLock(parent, parent_version)) return Restart(restart);
+        if (!UpgradeToWriteLock(node, version)) {
+          WriteUnlock(parent);
+          return Restart(restart);
+        }
+        auto *const new_node = new Node4();
+        new_node->prefix_len_ = static_cast<uint8_t>(match);
+        std::memcpy(new_node->prefix_, node->prefix_, match);
+        AddChild(new_node, static_cast<uint8_t>(node->prefix_[match]), node);
+        AddChild(new_node, static_cast<uint8_t>(key_bytes[depth + match]), NewLeaf(key, nullptr, &value, nullptr));
+        node->prefix_len_ = static_cast<uint8_t>(node->prefix_len_ - (match + 1));
+        std::memmove(node->prefix_, node->prefix_ + match + 1, node->prefix_len_);
+        ChangeChild(parent, parent_byte, new_node);
+        WriteUnlock(node);
+        WriteUnlock(parent);
+        return true;
+      }
+
+      depth += node->prefix_len_;
+      if (depth >= KEY_SIZE) return Restart(restart);
+      const auto key_byte = static_cast<uint8_t>(key_bytes[depth]);
+      Node *const next = FindChild(node, key_byte);
+      if (!Validate(node, version)) return Restart(restart);
+
+      if (next == nullptr) {
+        if (!IsFull(node)) {
+          if (!UpgradeToWriteLock(node, version)) return Restart(restart);
+          AddChild(node, key_byte, NewLeaf(key, nullptr, &value, nullptr));
+          WriteUnlock(node);
+          return true;
+        }
+        // Replace the node with a larger copy. The root never fills up, so there is a parent.
+        if (!UpgradeToWriteLock(parent, parent_version)) return Restart(restart);
+        if (!UpgradeToWriteLock(node, version)) {
+          WriteUnlock(parent);
+          return Restart(restart);
+        }
+        Node *const bigger = Grow(node);
+        AddChild(bigger, key_byte, NewLeaf(key, nullptr, &value, nullptr));
+        ChangeChild(parent, parent_byte, bigger);
+        WriteUnlockObsolete(node);
+        WriteUnlock(parent);
+        Retire(node);
+        return true;
+      }
+
+      if (IsLeaf(next)) {
+        if (!UpgradeToWriteLock(node, version)) return Restart(restart);
+        const Leaf *const leaf = AsLeaf(next);
+        const byte *const leaf_key = leaf->key_.KeyData();
+        if (std::memcmp(leaf_key, key_bytes, KEY_SIZE) == 0) {
+          const TupleSlot *const values = leaf->Values();
+          const TupleSlot *const values_end = values + leaf->num_values_;
+          if (std::find(values, values_end, value) != values_end) {
+            WriteUnlock(node);
+            return false;
+          }
+          if (std::any_of(values, values_end, predicate)) {
+            *predicate_satisfied = true;
+            WriteUnlock(node);
+            return false;
+          }
+          ChangeChild(node, key_byte, NewLeaf(key, leaf, &value, nullptr));
+          WriteUnlock(node);
+          Retire(next);
+          return true;
+        }
+        // Another key: both keys move into a new node holding the rest of their common prefix
+        uint32_t common = 0;
+        while (leaf_key[depth + 1 + common] == key_bytes[depth + 1 + common]) common++;
+        TERRIER_ASSERT(depth + 1 + common < KEY_SIZE, "Different keys must differ in some byte.");
+        auto *const new_node = new Node4();
+        new_node->prefix_len_ = static_cast<uint8_t>(common);
+        std::memcpy(new_node->prefix_, key_bytes + depth + 1, common);
+        AddChild(new_node, static_cast<uint8_t>(leaf_key[depth + 1 + common]), next);
+        AddChild(new_node, static_cast<uint8_t>(key_bytes[depth + 1 + common]),
+                 NewLeaf(key, nullptr, &value, nullptr));
+        ChangeChild(node, key_byte, new_node);
+        WriteUnlock(node);
+        return true;
+      }
+
+      if (parent != nullptr && !Validate(parent, parent_version)) return Restart(restart);
+      depth++;
+      parent = node;
+      parent_version = version;
+      parent_byte = key_byte;
+      node = next;
+      if (!ReadLock(node, &version)) return Restart(restart);
+    }
+  }
+
+  bool TryDelete(const KeyType &key, const TupleSlot value, bool *const restart) {
+    const byte *const key_bytes = key.KeyData();
+    Node *parent = nullptr;
+    uint64_t parent_version = 0;
+    uint8_t parent_byte = 0;
+    Node *node = root_;
+    uint64_t version;
+    if (!ReadLock(node, &version)) return Restart(restart);
+    uint32_t depth = 0;
+
+    while (true) {
+      if (PrefixMatch(node, key_bytes, depth) < node->prefix_len_) {
+        if (!Validate(node, version)) return Restart(restart);
+        return false;
+      }
+      depth += node->prefix_len_;
+      if (depth >= KEY_SIZE) return Restart(restart);
+      const auto key_byte = static_cast<uint8_t>(key_bytes[depth]);
+      Node *const next = FindChild(node, key_byte);
+      if (!Validate(node, version)) return Restart(restart);
+      if (next == nullptr) return false;
+
+      if (IsLeaf(next)) {
+        const Leaf *const leaf = AsLeaf(next);
+        if (std::memcmp(leaf->key_.KeyData(), key_bytes, KEY_SIZE) != 0) return false;
+        const TupleSlot *const values_end = leaf->Values() + leaf->num_values_;
+        if (std::find(leaf->Values(), values_end, value) == values_end) return false;
+
+        if (leaf->num_values_ > 1) {
+          if (!UpgradeToWriteLock(node, version)) return Restart(restart);
+          ChangeChild(node, key_byte, NewLeaf(key, leaf, nullptr, &value));
+          WriteUnlock(node);
+        } else if (node->count_ == 1 && parent != nullptr) {
+          // The node would be left without keys, so it is removed instead
+          if (!UpgradeToWriteLock(parent, parent_version)) return Restart(restart);
+          if (!UpgradeToWriteLock(node, version)) {
+            WriteUnlock(parent);
+            return Restart(restart);
+          }
+          RemoveChild(parent, parent_byte);
+          WriteUnlockObsolete(node);
+          WriteUnlock(parent);
+          Retire(node);
+        } else {
+          if (!UpgradeToWriteLock(node, version)) return Restart(restart);
+          RemoveChild(node, key_byte);
+          WriteUnlock(node);
+        }
+        Retire(next);
+        return true;
+      }
+
+      if (parent != nullptr && !Validate(parent, parent_version)) return Restart(restart);
+      depth++;
+      parent = node;
+      parent_version = version;
+      parent_byte = key_byte;
+      node = next;
+      if (!ReadLock(node, &version)) return Restart(restart);
+    }
+  }
+
+  const Leaf *TryLookup(const KeyType &key, bool *const restart) const {
+    const byte *const key_bytes = key.KeyData();
+    const Node *node = root_;
+    uint64_t version;
+    uint32_t depth = 0;
+    *restart = true;
+    if (!ReadLock(node, &version)) return nullptr;
+
+    while (true) {
+      if (PrefixMatch(node, key_bytes, depth) < node->prefix_len_) {
+        *restart = !Validate(node, version);
+        return nullptr;
+      }
+      depth += node->prefix_len_;
+      if (depth >= KEY_SIZE) return nullptr;
+      Node *const next = FindChild(node, static_cast<uint8_t>(key_bytes[depth]));
+      if (!Validate(node, version)) return nullptr;
+      if (IsLeaf(next)) {
+        // Leaves never change, so there is nothing left to validate
+        *restart = false;
+        const Leaf *const leaf = AsLeaf(next);
+        return std::memcmp(leaf->key_.KeyData(), key_bytes, KEY_SIZE) == 0 ? leaf : nullptr;
+      }
+      if (next == nullptr) {
+        *restart = false;
+        return nullptr;
+      }
+      depth++;
+      node = next;
+      if (!ReadLock(node, &version)) return nullptr;
+    }
+  }
+
+  /**
+   * Append the leaves of a subtree past a bound, in scan order, until there are max_leaves of them.
+   * @param node root of the subtree
+   * @param depth depth of the node
+   * @param bound the bound
+   * @param bounded whether the bound falls within this subtree. Otherwise, the whole subtree is past it.
+   * @param inclusive whether a key equal to the bound is past it
+   * @param ascending scan order
+   * @param max_leaves number of leaves to stop at
+   * @param[out] leaves list to append to
+   * @return false if the scan has to restart, because a node changed while it was read
+   */
+  static bool Collect(const Node *const node, uint32_t depth, const byte *const bound, bool bounded,
+                      const bool inclusive, const bool ascending, const uint32_t max_leaves,
+                      std::vector<const Leaf *> *const leaves) {
+    uint64_t version;
+    if (!ReadLock(node, &version)) return false;
+    const uint32_t prefix_len = std::min<uint32_t>(node->prefix_len_, KEY_SIZE - depth);
+    if (bounded) {
+      const int cmp = std::memcmp(node->prefix_, bound + depth, prefix_len);
+      if (!Validate(node, version)) return false;
+      // A subtree before the bound has nothing to visit, and all of a subtree after it is visited
+      if (ascending ? cmp < 0 : cmp > 0) return true;
+      bounded = cmp == 0;
+    }
+    depth += prefix_len;
+    if (depth >= KEY_SIZE) return false;
+
+    const auto edge = static_cast<uint8_t>(bounded ? static_cast<uint8_t>(bound[depth]) : (ascending ? 0 : 255));
+    std::array<uint8_t, 256> bytes;
+    std::array<Node *, 256> children;
+    const uint32_t num_children =
+        ascending ? GetChildren(node, edge, 255, &bytes, &children) : GetChildren(node, 0, edge, &bytes, &children);
+    if (!Validate(node, version)) return false;
+
+    for (uint32_t i = 0; i < num_children; i++) {
+      const uint32_t pos = ascending ? i : num_children - 1 - i;
+      const bool child_bounded = bounded && bytes[pos] == edge;
+      Node *const child = children[pos];
+      if (IsLeaf(child)) {
+        const Leaf *const leaf = AsLeaf(child);
+        if (child_bounded) {
+          const int cmp = std::memcmp(leaf->key_.KeyData(), bound, KEY_SIZE);
+          if ((ascending ? cmp < 0 : cmp > 0) || (cmp == 0 && !inclusive)) continue;
+        }
+        leaves->emplace_back(leaf);
+      } else if (!Collect(child, depth + 1, bound, child_bounded, inclusive, ascending, max_leaves, leaves)) {
+        return false;
+      }
+      if (leaves->size() >= max_leaves) return true;
+    }
+    return true;
+  }
+};
+
+}  // namespace terrier::storage::index
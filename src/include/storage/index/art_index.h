@@ -0,0 +1,326 @@
+#pragma once
+
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "storage/index/adaptive_radix_tree.h"
+#include "storage/index/index.h"
+#include "storage/index/index_defs.h"
+#include "transaction/deferred_action_manager.h"
+#include "transaction/transaction_context.h"
+
+namespace terrier::storage::index {
+template <uint8_t KeySize>
+class CompactIntsKey;
+
+template <typename KeyType>
+class ArtIndex;
+
+/**
+ * Streaming ascending scan over an ArtIndex. The tree is read a batch of keys at a time, so nothing is pinned between
+ * calls.
+ * @tparam KeyType the type of keys stored in the tree
+ */
+template <typename KeyType>
+class ArtAscendingScanCursor final : public IndexScanCursor {
+ public:
+  /**
+   * @param index the index being scanned
+   * @param txn the calling transaction
+   * @param low_key_exists whether the range has a lower bound
+   * @param low_key the lower bound of the range, if any
+   * @param high_key_exists whether the range has an upper bound
+   * @param high_key the upper bound of the range, if any
+   * @param num_attrs number of attributes of the keys to compare against the upper bound
+   * @param limit maximum number of results to return, 0 for no limit
+   */
+  ArtAscendingScanCursor(const ArtIndex<KeyType> *const index, const transaction::TransactionContext &txn,
+                         const bool low_key_exists, const KeyType &low_key, const bool high_key_exists,
+                         const KeyType &high_key, const uint32_t num_attrs, const uint32_t limit)
+      : index_(index),
+        txn_(txn),
+        next_key_exists_(low_key_exists),
+        next_key_(low_key),
+        high_key_exists_(high_key_exists),
+        high_key_(high_key),
+        num_attrs_(num_attrs),
+        limit_(limit) {}
+
+  uint32_t Next(std::vector<TupleSlot> *const value_list, const uint32_t max_values) final {
+    return NextWithKeys(value_list, nullptr, max_values);
+  }
+
+  uint32_t NextWithKeys(std::vector<TupleSlot> *const value_list, ProjectedRow *const *const keys,
+                        const uint32_t max_values) final {
+    uint32_t num_values = 0;
+    // Limit of 0 indicates "no limit"
+    while (num_values < max_values && (limit_ == 0 || num_returned_ < limit_)) {
+      if (next_entry_ == entries_.size() && !FetchEntries()) break;
+      const auto &entry = entries_[next_entry_];
+      if (high_key_exists_ && !entry.first.PartialLessThan(high_key_, &index_->metadata_, num_attrs_)) {
+        entries_.clear();
+        next_entry_ = 0;
+        exhausted_ = true;
+        break;
+      }
+      next_entry_++;
+      // Perform visibility check on result
+      if (ArtIndex<KeyType>::IsVisible(txn_, entry.second)) {
+        if (keys != nullptr) entry.first.ToProjectedRow(keys[num_values], index_->metadata_);
+        value_list->emplace_back(entry.second);
+        num_values++;
+        num_returned_++;
+      }
+    }
+    return num_values;
+  }
+
+ private:
+  // Number of keys read from the tree at a time
+  static constexpr uint32_t KEYS_PER_FETCH = 64;
+
+  /**
+   * Read the entries of the next batch of keys from the tree.
+   * @return false if there are no more entries
+   */
+  bool FetchEntries() {
+    entries_.clear();
+    next_entry_ = 0;
+    if (exhausted_) return false;
+    const uint32_t num_keys = index_->art_->Scan(
+        next_key_exists_ ? &next_key_ : nullptr, !next_key_fetched_, true, KEYS_PER_FETCH,
+        [this](const KeyType &key, const TupleSlot *const values, const uint32_t num_values) {
+          for (uint32_t i = 0; i < num_values; i++) entries_.emplace_back(key, values[i]);
+          next_key_ = key;
+        });
+    // The next batch starts right after the last key of this one
+    next_key_exists_ = next_key_exists_ || num_keys > 0;
+    next_key_fetched_ = next_key_fetched_ || num_keys > 0;
+    exhausted_ = num_keys < KEYS_PER_FETCH;
+    return !entries_.empty();
+  }
+
+  const ArtIndex<KeyType> *const index_;
+  const transaction::TransactionContext &txn_;
+  bool next_key_exists_;
+  bool next_key_fetched_ = false;
+  KeyType next_key_;
+  const bool high_key_exists_;
+  const KeyType high_key_;
+  const uint32_t num_attrs_;
+  const uint32_t limit_;
+  uint32_t num_returned_ = 0;
+  std::vector<std::pair<KeyType, TupleSlot>> entries_;
+  std::size_t next_entry_ = 0;
+  bool exhausted_ = false;
+};
+
+/**
+ * Wrapper around an adaptive radix tree. The MVCC logic is the same as our reference index (BwTreeIndex). The tree
+ * compares keys by their bytes, so it only holds CompactIntsKeys, whose byte order is their integer order.
+ * @tparam KeyType the type of keys stored in the tree
+ */
+template <typename KeyType>
+class ArtIndex final : public Index {
+  friend class IndexBuilder;
+  friend class ArtAscendingScanCursor<KeyType>;
+
+ private:
+  // Number of keys read from the tree at a time by descending scans
+  static constexpr uint32_t KEYS_PER_FETCH = 64;
+
+  explicit ArtIndex(IndexMetadata metadata)
+      : Index(std::move(metadata)), art_{new AdaptiveRadixTree<KeyType>()} {}
+
+  const std::unique_ptr<AdaptiveRadixTree<KeyType>> art_;
+
+  void ScanDescendingUntil(const transaction::TransactionContext &txn, const ProjectedRow &low_key,
+                           const ProjectedRow &high_key, std::vector<TupleSlot> *const value_list,
+                           const uint32_t limit) const {
+    // Build search keys
+    KeyType index_low_key, index_high_key;
+    index_low_key.SetFromProjectedRow(low_key, metadata_, metadata_.GetSchema().GetColumns().size());
+    index_high_key.SetFromProjectedRow(high_key, metadata_, metadata_.GetSchema().GetColumns().size());
+
+    // Perform lookups in the tree, a batch of keys at a time. Limit of 0 indicates "no limit".
+    KeyType next_key = index_high_key;
+    bool inclusive = true;
+    bool done = false;
+    while (!done) {
+      const uint32_t num_keys = art_->Scan(
+          &next_key, inclusive, false, KEYS_PER_FETCH,
+          [&](const KeyType &key, const TupleSlot *const values, const uint32_t num_values) {
+            next_key = key;
+            if (done || std::memcmp(key.KeyData(), index_low_key.KeyData(), sizeof(KeyType)) < 0) {
+              done = true;
+              return;
+            }
+            for (uint32_t i = 0; i < num_values; i++) {
+              if (limit != 0 && value_list->size() == limit) {
+                done = true;
+                return;
+              }
+              // Perform visibility check on result
+              if (IsVisible(txn, values[i])) value_list->emplace_back(values[i]);
+            }
+          });
+      done = done || num_keys < KEYS_PER_FETCH;
+      inclusive = false;
+    }
+  }
+
+ public:
+  IndexType Type() const final { return IndexType::ART; }
+
+  void PerformGarbageCollection() final { art_->PerformGarbageCollection(); }
+
+  bool SupportsKeyRetrieval() const final { return KeyType::SupportsToProjectedRow(metadata_); }
+
+  bool Insert(const common::ManagedPointer<transaction::TransactionContext> txn, const ProjectedRow &tuple,
+              const TupleSlot location) final {
+    TERRIER_ASSERT(!(metadata_.GetSchema().Unique()),
+                   "This Insert is designed for secondary indexes with no uniqueness constraints.");
+    KeyType index_key;
+    index_key.SetFromProjectedRow(tuple, metadata_, metadata_.GetSchema().GetColumns().size());
+    const bool result = art_->Insert(index_key, location);
+
+    TERRIER_ASSERT(
+        result,
+        "non-unique index shouldn't fail to insert. If it did, something went wrong deep inside the tree itself.");
+    // Register an abort action with the txn context in case of rollback
+    txn->RegisterAbortAction([=]() {
+      const bool UNUSED_ATTRIBUTE result = art_->Delete(index_key, location);
+      TERRIER_ASSERT(result, "Delete on the index failed.");
+    });
+    return result;
+  }
+
+  bool InsertUnique(const common::ManagedPointer<transaction::TransactionContext> txn, const ProjectedRow &tuple,
+                    const TupleSlot location) final {
+    TERRIER_ASSERT(metadata_.GetSchema().Unique(), "This Insert is designed for indexes with uniqueness constraints.");
+    KeyType index_key;
+    index_key.SetFromProjectedRow(tuple, metadata_, metadata_.GetSchema().GetColumns().size());
+    bool predicate_satisfied = false;
+
+    // The predicate checks if any matching keys have write-write conflicts or are still visible to the calling txn.
+    auto predicate = [txn](const TupleSlot slot) -> bool {
+      const auto *const data_table = slot.GetBlock()->data_table_;
+      const auto has_conflict = data_table->HasConflict(*txn, slot);
+      const auto is_visible = data_table->IsVisible(*txn, slot);
+      return has_conflict || is_visible;
+    };
+
+    const bool result = art_->ConditionalInsert(index_key, location, predicate, &predicate_satisfied);
+
+    TERRIER_ASSERT(predicate_satisfied != result, "If predicate is not satisfied then insertion should succeed.");
+
+    if (result) {
+      // Register an abort action with the txn context in case of rollback
+      txn->RegisterAbortAction([=]() {
+        const bool UNUSED_ATTRIBUTE result = art_->Delete(index_key, location);
+        TERRIER_ASSERT(result, "Delete on the index failed.");
+      });
+    } else {
+      // Presumably you've already made modifications to a DataTable (the source of the TupleSlot argument to this
+      // function) however, the index found a constraint violation and cannot allow that operation to succeed. For MVCC
+      // correctness, this txn must now abort for the GC to clean up the version chain in the DataTable correctly.
+      txn->SetMustAbort();
+    }
+
+    return result;
+  }
+
+  void Delete(const common::ManagedPointer<transaction::TransactionContext> txn, const ProjectedRow &tuple,
+              const TupleSlot location) final {
+    KeyType index_key;
+    index_key.SetFromProjectedRow(tuple, metadata_, metadata_.GetSchema().GetColumns().size());
+
+    TERRIER_ASSERT(!(location.GetBlock()->data_table_->HasConflict(*txn, location)) &&
+                       !(location.GetBlock()->data_table_->IsVisible(*txn, location)),
+                   "Called index delete on a TupleSlot that has a conflict with this txn or is still visible.");
+
+    // Register a deferred action for the GC with txn manager. See base function comment.
+    txn->RegisterCommitAction([=](transaction::DeferredActionManager *deferred_action_manager) {
+      deferred_action_manager->RegisterDeferredAction([=]() {
+        const bool UNUSED_ATTRIBUTE result = art_->Delete(index_key, location);
+        TERRIER_ASSERT(result, "Deferred delete on the index failed.");
+      });
+    });
+  }
+
+  void ScanKey(const transaction::TransactionContext &txn, const ProjectedRow &key,
+               std::vector<TupleSlot> *value_list) final {
+    TERRIER_ASSERT(value_list->empty(), "Result set should begin empty.");
+
+    std::vector<TupleSlot> results;
+
+    // Build search key
+    KeyType index_key;
+    index_key.SetFromProjectedRow(key, metadata_, metadata_.GetSchema().GetColumns().size());
+
+    // Perform lookup in the tree
+    art_->GetValue(index_key, &results);
+
+    // Avoid resizing our value_list, even if it means over-provisioning
+    value_list->reserve(results.size());
+
+    // Perform visibility check on result
+    for (const auto &result : results) {
+      if (IsVisible(txn, result)) value_list->emplace_back(result);
+    }
+
+    TERRIER_ASSERT(!(metadata_.GetSchema().Unique()) || (metadata_.GetSchema().Unique() && value_list->size() <= 1),
+                   "Invalid number of results for unique index.");
+  }
+
+  void ScanAscending(const transaction::TransactionContext &txn, ScanType scan_type, uint32_t num_attrs,
+                     ProjectedRow *low_key, ProjectedRow *high_key, uint32_t limit,
+                     std::vector<TupleSlot> *value_list) final {
+    TERRIER_ASSERT(value_list->empty(), "Result set should begin empty.");
+    auto cursor = BeginScanAscending(txn, scan_type, num_attrs, low_key, high_key, limit);
+    cursor->Next(value_list, std::numeric_limits<uint32_t>::max());
+  }
+
+  std::unique_ptr<IndexScanCursor> BeginScanAscending(const transaction::TransactionContext &txn,
+                                                      ScanType scan_type, uint32_t num_attrs, ProjectedRow *low_key,
+                                                      ProjectedRow *high_key, uint32_t limit) final {
+    TERRIER_ASSERT(scan_type == ScanType::Closed || scan_type == ScanType::OpenLow || scan_type == ScanType::OpenHigh ||
+                       scan_type == ScanType::OpenBoth,
+                   "Invalid scan_type passed into ArtIndex::Scan");
+
+    bool low_key_exists = (scan_type == ScanType::Closed || scan_type == ScanType::OpenHigh);
+    bool high_key_exists = (scan_type == ScanType::Closed || scan_type == ScanType::OpenLow);
+
+    // Build search keys. Attributes past num_attrs are zeroed, which is the smallest value in the tree's byte order.
+    KeyType index_low_key, index_high_key;
+    if (low_key_exists) index_low_key.SetFromProjectedRow(*low_key, metadata_, num_attrs);
+    if (high_key_exists) index_high_key.SetFromProjectedRow(*high_key, metadata_, num_attrs);
+
+    return std::make_unique<ArtAscendingScanCursor<KeyType>>(this, txn, low_key_exists, index_low_key,
+                                                             high_key_exists, index_high_key, num_attrs, limit);
+  }
+
+  void ScanDescending(const transaction::TransactionContext &txn, const ProjectedRow &low_key,
+                      const ProjectedRow &high_key, std::vector<TupleSlot> *value_list) final {
+    TERRIER_ASSERT(value_list->empty(), "Result set should begin empty.");
+    ScanDescendingUntil(txn, low_key, high_key, value_list, 0);
+  }
+
+  void ScanLimitDescending(const transaction::TransactionContext &txn, const ProjectedRow &low_key,
+                           const ProjectedRow &high_key, std::vector<TupleSlot> *value_list,
+                           const uint32_t limit) final {
+    TERRIER_ASSERT(value_list->empty(), "Result set should begin empty.");
+    TERRIER_ASSERT(limit > 0, "Limit must be greater than 0.");
+    ScanDescendingUntil(txn, low_key, high_key, value_list, limit);
+  }
+};
+
+extern template class ArtIndex<CompactIntsKey<8>>;
+extern template class ArtIndex<CompactIntsKey<16>>;
+extern template class ArtIndex<CompactIntsKey<24>>;
+extern template class ArtIndex<CompactIntsKey<32>>;
+
+}  // namespace terrier::storage::index
@@ -1,12 +1,17 @@
 #pragma once
 
+#include <algorithm>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <utility>
 #include <vector>
 
+#include <tbb/parallel_sort.h>
+
 #include "bwtree/bwtree.h"
 #include "storage/index/index.h"
+#include "storage/index/index_bulk_loader.h"
 #include "storage/index/index_defs.h"
 #include "transaction/deferred_action_manager.h"
 #include "transaction/transaction_context.h"
@@ -18,6 +23,119 @@ class CompactIntsKey;
 template <uint16_t KeySize>
 class GenericKey;
 
+template <typename KeyType>
+class BwTreeIndex;
+
+/**
+ * Streaming ascending scan over a BwTreeIndex. The BwTree iterator buffers a copy of the current leaf page, so it can
+ * be held between calls without pinning an epoch.
+ * @tparam KeyType the type of keys stored in the BwTree
+ */
+template <typename KeyType>
+class BwTreeAscendingScanCursor final : public IndexScanCursor {
+ public:
+  /**
+   * @param index the index being scanned
+   * @param txn the calling transaction
+   * @param scan_itr iterator positioned at the first entry of the range
+   * @param high_key_exists whether the range has an upper bound
+   * @param high_key the upper bound of the range, if any
+   * @param num_attrs number of attributes of the keys to compare against the upper bound
+   * @param limit maximum number of results to return, 0 for no limit
+   */
+  BwTreeAscendingScanCursor(const BwTreeIndex<KeyType> *const index, const transaction::TransactionContext &txn,
+                            typename third_party::bwtree::BwTree<KeyType, TupleSlot>::ForwardIterator &&scan_itr,
+                            const bool high_key_exists, const KeyType &high_key, const uint32_t num_attrs,
+                            const uint32_t limit)
+      : index_(index),
+        txn_(txn),
+        scan_itr_(std::move(scan_itr)),
+        high_key_exists_(high_key_exists),
+        high_key_(high_key),
+        num_attrs_(num_attrs),
+        limit_(limit) {}
+
+  uint32_t Next(std::vector<TupleSlot> *const value_list, const uint32_t max_values) final {
+    return NextWithKeys(value_list, nullptr, max_values);
+  }
+
+  uint32_t NextWithKeys(std::vector<TupleSlot> *const value_list, ProjectedRow *const *const keys,
+                        const uint32_t max_values) final {
+    uint32_t num_values = 0;
+    // Limit of 0 indicates "no limit"
+    while (num_values < max_values && (limit_ == 0 || num_returned_ < limit_) && !scan_itr_.IsEnd() &&
+           (!high_key_exists_ || scan_itr_->first.PartialLessThan(high_key_, &index_->metadata_, num_attrs_))) {
+      // Perform visibility check on result
+      if (BwTreeIndex<KeyType>::IsVisible(txn_, scan_itr_->second)) {
+        if (keys != nullptr) scan_itr_->first.ToProjectedRow(keys[num_values], index_->metadata_);
+        value_list->emplace_back(scan_itr_->second);
+        num_values++;
+        num_returned_++;
+      }
+      scan_itr_++;
+    }
+    return num_values;
+  }
+
+ private:
+  const BwTreeIndex<KeyType> *const index_;
+  const transaction::TransactionContext &txn_;
+  typename third_party::bwtree::BwTree<KeyType, TupleSlot>::ForwardIterator scan_itr_;
+  const bool high_key_exists_;
+  const KeyType high_key_;
+  const uint32_t num_attrs_;
+  const uint32_t limit_;
+  uint32_t num_returned_ = 0;
+};
+
+/**
+ * Bulk loader of a BwTreeIndex. The entries of all workers are sorted by key in parallel, and the tree is then built
+ * bottom-up from the sorted entries.
+ * @tparam KeyType the type of keys stored in the BwTree
+ */
+template <typename KeyType>
+class BwTreeBulkLoader final : public BufferedIndexBulkLoader<KeyType> {
+ public:
+  /**
+   * @param metadata metadata of the index being loaded
+   * @param bwtree the empty BwTree of the index
+   * @param num_workers number of workers adding entries
+   */
+  BwTreeBulkLoader(const IndexMetadata &metadata, third_party::bwtree::BwTree<KeyType, TupleSlot> *const bwtree,
+                   const uint32_t num_workers)
+      : BufferedIndexBulkLoader<KeyType>(metadata, num_workers), bwtree_(bwtree) {}
+
+  bool Finish() final {
+    // Gather the entries of all workers, freeing each worker's buffer as soon as it is copied
+    std::vector<std::pair<KeyType, TupleSlot>> entries;
+    entries.reserve(this->NumEntries());
+    for (auto &buffer : this->buffers_) {
+      entries.insert(entries.end(), buffer.begin(), buffer.end());
+      std::vector<std::pair<KeyType, TupleSlot>>().swap(buffer);
+    }
+
+    tbb::parallel_sort(entries.begin(), entries.end(),
+                       [this](const std::pair<KeyType, TupleSlot> &lhs, const std::pair<KeyType, TupleSlot> &rhs) {
+                         return bwtree_->KeyCmpLess(lhs.first, rhs.first);
+                       });
+
+    if (this->metadata_.GetSchema().Unique()) {
+      const auto duplicate = std::adjacent_find(
+          entries.begin(), entries.end(),
+          [this](const std::pair<KeyType, TupleSlot> &lhs, const std::pair<KeyType, TupleSlot> &rhs) {
+            return bwtree_->KeyCmpEqual(lhs.first, rhs.first);
+          });
+      if (duplicate != entries.end()) return false;
+    }
+
+    bwtree_->BulkLoad(entries.data(), entries.size());
+    return true;
+  }
+
+ private:
+  third_party::bwtree::BwTree<KeyType, TupleSlot> *const bwtree_;
+};
+
 /**
  * Wrapper around Ziqi's OpenBwTree.
  * @tparam KeyType the type of keys stored in the BwTree
@@ -25,6 +143,7 @@ class GenericKey;
 template <typename KeyType>
 class BwTreeIndex final : public Index {
   friend class IndexBuilder;
+  friend class BwTreeAscendingScanCursor<KeyType>;
 
  private:
   explicit BwTreeIndex(IndexMetadata metadata)
@@ -32,11 +151,38 @@ class BwTreeIndex final : public Index {
 
   const std::unique_ptr<third_party::bwtree::BwTree<KeyType, TupleSlot>> bwtree_;
 
+  BwTreeAscendingScanCursor<KeyType> MakeAscendingScanCursor(const transaction::TransactionContext &txn,
+                                                             const ScanType scan_type, const uint32_t num_attrs,
+                                                             ProjectedRow *const low_key, ProjectedRow *const high_key,
+                                                             const uint32_t limit) const {
+    TERRIER_ASSERT(scan_type == ScanType::Closed || scan_type == ScanType::OpenLow || scan_type == ScanType::OpenHigh ||
+                       scan_type == ScanType::OpenBoth,
+                   "Invalid scan_type passed into BwTreeIndex::Scan");
+
+    bool low_key_exists = (scan_type == ScanType::Closed || scan_type == ScanType::OpenHigh);
+    bool high_key_exists = (scan_type == ScanType::Closed || scan_type == ScanType::OpenLow);
+
+    // Build search keys
+    KeyType index_low_key, index_high_key;
+    if (low_key_exists) index_low_key.SetFromProjectedRow(*low_key, metadata_, num_attrs);
+    if (high_key_exists) index_high_key.SetFromProjectedRow(*high_key, metadata_, num_attrs);
+
+    // Perform lookup in BwTree
+    auto scan_itr = low_key_exists ? bwtree_->Begin(index_low_key) : bwtree_->Begin();
+    return {this, txn, std::move(scan_itr), high_key_exists, index_high_key, num_attrs, limit};
+  }
+
  public:
   IndexType Type() const final { return IndexType::BWTREE; }
 
   void PerformGarbageCollection() final { bwtree_->PerformGarbageCollection(); };
 
+  bool SupportsKeyRetrieval() const final { return KeyType::SupportsToProjectedRow(metadata_); }
+
+  std::unique_ptr<IndexBulkLoader> BeginBulkLoad(const uint32_t num_workers) final {
+    return std::make_unique<BwTreeBulkLoader<KeyType>>(metadata_, bwtree_.get(), num_workers);
+  }
+
   bool Insert(const common::ManagedPointer<transaction::TransactionContext> txn, const ProjectedRow &tuple,
               const TupleSlot location) final {
     TERRIER_ASSERT(!(metadata_.GetSchema().Unique()),
@@ -134,32 +280,73 @@ class BwTreeIndex final : public Index {
                    "Invalid number of results for unique index.");
   }
 
-  void ScanAscending(const transaction::TransactionContext &txn, ScanType scan_type, uint32_t num_attrs,
-                     ProjectedRow *low_key, ProjectedRow *high_key, uint32_t limit,
-                     std::vector<TupleSlot> *value_list) final {
-    TERRIER_ASSERT(value_list->empty(), "Result set should begin empty.");
-    TERRIER_ASSERT(scan_type == ScanType::Closed || scan_type == ScanType::OpenLow || scan_type == ScanType::OpenHigh ||
-                       scan_type == ScanType::OpenBoth,
-                   "Invalid scan_type passed into BwTreeIndex::Scan");
-
-    bool low_key_exists = (scan_type == ScanType::Closed || scan_type == ScanType::OpenHigh);
-    bool high_key_exists = (scan_type == ScanType::Closed || scan_type == ScanType::OpenLow);
+  void ScanKeys(const transaction::TransactionContext &txn, const ProjectedRow *const *const keys,
+                const uint32_t num_keys, std::vector<TupleSlot> *const value_list,
+                std::vector<std::pair<uint32_t, uint32_t>> *const ranges) final {
+    TERRIER_ASSERT(value_list->empty() && ranges->empty(), "Result sets should begin empty.");
+    if (num_keys == 0) return;
 
     // Build search keys
-    KeyType index_low_key, index_high_key;
-    if (low_key_exists) index_low_key.SetFromProjectedRow(*low_key, metadata_, num_attrs);
-    if (high_key_exists) index_high_key.SetFromProjectedRow(*high_key, metadata_, num_attrs);
+    const auto num_attrs = metadata_.GetSchema().GetColumns().size();
+    std::vector<KeyType> index_keys(num_keys);
+    std::vector<uint32_t> order(num_keys);
+    for (uint32_t i = 0; i < num_keys; i++) {
+      index_keys[i].SetFromProjectedRow(*keys[i], metadata_, num_attrs);
+      order[i] = i;
+    }
 
-    // Perform lookup in BwTree
-    auto scan_itr = low_key_exists ? bwtree_->Begin(index_low_key) : bwtree_->Begin();
+    // Probing in key order walks the tree from left to right, so each traversal finds most of its path in cache from
+    // the previous one, and duplicate keys sit next to each other and are looked up only once
+    std::sort(order.begin(), order.end(), [&](const uint32_t lhs, const uint32_t rhs) {
+      return bwtree_->KeyCmpLess(index_keys[lhs], index_keys[rhs]);
+    });
+    std::vector<const KeyType *> unique_keys;
+    std::vector<uint32_t> key_to_unique(num_keys);
+    for (const auto key_idx : order) {
+      if (unique_keys.empty() || !bwtree_->KeyCmpEqual(*unique_keys.back(), index_keys[key_idx])) {
+        unique_keys.emplace_back(&index_keys[key_idx]);
+      }
+      key_to_unique[key_idx] = static_cast<uint32_t>(unique_keys.size() - 1);
+    }
 
-    // Limit of 0 indicates "no limit"
-    while ((limit == 0 || value_list->size() < limit) && !scan_itr.IsEnd() &&
-           (!high_key_exists || scan_itr->first.PartialLessThan(index_high_key, &metadata_, num_attrs))) {
-      // Perform visibility check on result
-      if (IsVisible(txn, scan_itr->second)) value_list->emplace_back(scan_itr->second);
-      scan_itr++;
+    // Perform lookups in BwTree
+    std::vector<TupleSlot> results;
+    std::vector<size_t> ends(unique_keys.size());
+    bwtree_->GetValueBatch(unique_keys.data(), unique_keys.size(), results, ends.data());
+
+    // Avoid resizing our value_list, even if it means over-provisioning
+    value_list->reserve(results.size());
+
+    // Perform visibility check on results, one key at a time
+    std::vector<std::pair<uint32_t, uint32_t>> unique_ranges(unique_keys.size());
+    size_t result_idx = 0;
+    for (size_t i = 0; i < unique_keys.size(); i++) {
+      const auto begin = static_cast<uint32_t>(value_list->size());
+      for (; result_idx < ends[i]; result_idx++) {
+        if (IsVisible(txn, results[result_idx])) value_list->emplace_back(results[result_idx]);
+      }
+      unique_ranges[i] = {begin, static_cast<uint32_t>(value_list->size())};
+      TERRIER_ASSERT(!(metadata_.GetSchema().Unique()) || unique_ranges[i].second - unique_ranges[i].first <= 1,
+                     "Invalid number of results for unique index.");
     }
+
+    ranges->reserve(num_keys);
+    for (uint32_t i = 0; i < num_keys; i++) ranges->emplace_back(unique_ranges[key_to_unique[i]]);
+  }
+
+  void ScanAscending(const transaction::TransactionContext &txn, ScanType scan_type, uint32_t num_attrs,
+                     ProjectedRow *low_key, ProjectedRow *high_key, uint32_t limit,
+                     std::vector<TupleSlot> *value_list) final {
+    TERRIER_ASSERT(value_list->empty(), "Result set should begin empty.");
+    auto cursor = MakeAscendingScanCursor(txn, scan_type, num_attrs, low_key, high_key, limit);
+    cursor.Next(value_list, std::numeric_limits<uint32_t>::max());
+  }
+
+  std::unique_ptr<IndexScanCursor> BeginScanAscending(const transaction::TransactionContext &txn,
+                                                      ScanType scan_type, uint32_t num_attrs, ProjectedRow *low_key,
+                                                      ProjectedRow *high_key, uint32_t limit) final {
+    return std::make_unique<BwTreeAscendingScanCursor<KeyType>>(
+        MakeAscendingScanCursor(txn, scan_type, num_attrs, low_key, high_key, limit));
   }
 
   void ScanDescending(const transaction::TransactionContext &txn, const ProjectedRow &low_key,
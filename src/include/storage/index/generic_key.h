@@ -96,6 +96,27 @@ class GenericKey {
     return pr;
   }
 
+  /**
+   * Write the attributes of this key back into a ProjectedRow. This is the inverse of SetFromProjectedRow, and only
+   * possible when the key holds a plain copy of the ProjectedRow (see SupportsToProjectedRow).
+   * @param[out] to ProjectedRow to write into, initialized from the index's ProjectedRowInitializer
+   * @param metadata index information
+   */
+  void ToProjectedRow(storage::ProjectedRow *const to, const IndexMetadata &metadata) const {
+    TERRIER_ASSERT(SupportsToProjectedRow(metadata), "Keys with inlined varlens cannot be written back.");
+    const auto *const pr = GetProjectedRow();
+    TERRIER_ASSERT(pr->Size() == to->Size(), "ProjectedRows must have the same layout.");
+    // We recast to as a workaround for -Wclass-memaccess
+    std::memcpy(static_cast<void *>(to), pr, pr->Size());
+  }
+
+  /**
+   * @param metadata index information
+   * @return whether ToProjectedRow can recover the keys of the index. Varlens too long to fit in a VarlenEntry are
+   * copied into the key, so a recovered VarlenEntry would have to point into the key itself.
+   */
+  static bool SupportsToProjectedRow(const IndexMetadata &metadata) { return !metadata.MustInlineVarlen(); }
+
   /**
    * @return metadata of the index for this key, exposed for hasher and comparators
    */
@@ -1,20 +1,22 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
 #include <memory>
-#include <unordered_set>
 #include <utility>
-#include <variant>  // NOLINT (Matt): lint thinks this C++17 header is a C header because it only knows C++11
 #include <vector>
 
+#include <tbb/parallel_for.h>
+
 #include "libcuckoo/cuckoohash_map.hh"
+#include "storage/index/hash_index_values.h"
 #include "storage/index/index.h"
+#include "storage/index/index_bulk_loader.h"
 #include "storage/index/index_defs.h"
 #include "transaction/deferred_action_manager.h"
 #include "transaction/transaction_context.h"
 #include "transaction/transaction_manager.h"
-#include "xxHash/xxh3.h"
 
 namespace terrier::storage::index {
 
@@ -27,31 +29,70 @@ class GenericKey;
 // might be something that is a per-index hint based on the table size (cardinality?), rather than a global setting
 constexpr uint16_t INITIAL_CUCKOOHASH_MAP_SIZE = 256;
 
+template <typename KeyType>
+class HashIndex;
+
 /**
- * Wrapper around libcuckoo's hash map. The MVCC is logic is similar to our reference index (BwTreeIndex). Much of the
- * logic here is related to the cuckoohash_map not being a multimap. We get around this by making the value type a
- * std::variant that can either be a TupleSlot if there's only a single value for a given key, or a std::unordered_set
- * of TupleSlots if a single key needs to map to multiple TupleSlots.
+ * Bulk loader of a HashIndex. The hash map is sized for all the entries up front, so it never grows while they are
+ * inserted, and the entries of different workers are then inserted in parallel.
  * @tparam KeyType the type of keys stored in the map
  */
 template <typename KeyType>
-class HashIndex final : public Index {
-  friend class IndexBuilder;
+class HashIndexBulkLoader final : public BufferedIndexBulkLoader<KeyType> {
+ public:
+  /**
+   * @param index the empty index being loaded
+   * @param num_workers number of workers adding entries
+   */
+  HashIndexBulkLoader(HashIndex<KeyType> *const index, const uint32_t num_workers)
+      : BufferedIndexBulkLoader<KeyType>(index->metadata_, num_workers), index_(index) {}
+
+  bool Finish() final {
+    index_->hash_map_->reserve(this->NumEntries());
+    const bool unique = this->metadata_.GetSchema().Unique();
+    std::atomic<bool> duplicate = false;
+    tbb::parallel_for(std::size_t(0), this->buffers_.size(), [&](const std::size_t worker) {
+      for (const auto &entry : this->buffers_[worker]) {
+        const auto location = entry.second;
+        if (unique) {
+          if (!index_->hash_map_->insert(entry.first, location)) duplicate = true;
+          continue;
+        }
+        // Same as a non-unique Insert, without the abort action
+        index_->hash_map_->uprase_fn(
+            entry.first,
+            [location](HashIndexValues &values) -> bool {
+              values.Add(location);
+              return false;
+            },
+            location);
+      }
+      std::vector<std::pair<KeyType, TupleSlot>>().swap(this->buffers_[worker]);
+    });
+    return !duplicate;
+  }
 
  private:
-  struct TupleSlotHash {
-    std::size_t operator()(const TupleSlot &slot) const {
-      return XXH3_64bits(reinterpret_cast<const void *>(&slot), sizeof(TupleSlot));
-    }
-  };
+  HashIndex<KeyType> *const index_;
+};
 
-  using ValueMap = std::unordered_set<TupleSlot, TupleSlotHash>;
-  using ValueType = std::variant<TupleSlot, ValueMap>;
+/**
+ * Wrapper around libcuckoo's hash map. The MVCC is logic is similar to our reference index (BwTreeIndex). The
+ * cuckoohash_map is not a multimap, so each key maps to all of its TupleSlots at once, stored contiguously by
+ * HashIndexValues.
+ * @tparam KeyType the type of keys stored in the map
+ */
+template <typename KeyType>
+class HashIndex final : public Index {
+  friend class IndexBuilder;
+  friend class HashIndexBulkLoader<KeyType>;
 
+ private:
   explicit HashIndex(IndexMetadata metadata)
-      : Index(std::move(metadata)), hash_map_{new cuckoohash_map<KeyType, ValueType>(INITIAL_CUCKOOHASH_MAP_SIZE)} {}
+      : Index(std::move(metadata)),
+        hash_map_{new cuckoohash_map<KeyType, HashIndexValues>(INITIAL_CUCKOOHASH_MAP_SIZE)} {}
 
-  const std::unique_ptr<cuckoohash_map<KeyType, ValueType>> hash_map_;
+  const std::unique_ptr<cuckoohash_map<KeyType, HashIndexValues>> hash_map_;
 
   /**
    * The lambda below is used for aborted inserts as well as committed deletes to perform the erase logic. Macros are
@@ -60,27 +101,11 @@ class HashIndex final : public Index {
 #define ERASE_KEY_ACTION                                                                                               \
   [=]() {                                                                                                              \
     /* See the underlying container's API for more details, but the lambda below is invoked when the key is found. */  \
-    auto key_found_fn = [location](ValueType &value) -> bool {                                                         \
-      if (std::holds_alternative<TupleSlot>(value)) {                                                                  \
-        /* It's just a TupleSlot, functor should return true for cuckoohash_map's uprase_fn to erase key/value pair */ \
-        return true;                                                                                                   \
-      }                                                                                                                \
-      auto &value_map = std::get<ValueMap>(value);                                                                     \
-      if (value_map.size() == 2) {                                                                                     \
-        /* functor should replace the ValueMap with a TupleSlot for the other location */                              \
-        for (const auto i : value_map) {                                                                               \
-          if (i != location) {                                                                                         \
-            value = i; /* Assigning TupleSlot type will change the std::variant to TupleSlot and free the ValueMap */  \
-            TERRIER_ASSERT(std::holds_alternative<TupleSlot>(value), "value should now be a TupleSlot.");              \
-            return false; /* Return false so cuckoohash_map's uprase_fn doesn't erase key/value pair */                \
-          }                                                                                                            \
-        }                                                                                                              \
-      }                                                                                                                \
-      /* ValueMap contains more than 2 elements, erase location from the ValueMap */                                   \
-      const auto UNUSED_ATTRIBUTE erase_result = value_map.erase(location);                                            \
-      TERRIER_ASSERT(erase_result == 1, "Erasing from the ValueMap should not fail.");                                 \
-      TERRIER_ASSERT(value_map.size() > 1, "ValueMap should not have fewer than 2 elements.");                         \
-      return false; /* Return false so cuckoohash_map's uprase_fn doesn't erase key/value pair */                      \
+    auto key_found_fn = [location](HashIndexValues &values) -> bool {                                                  \
+      const bool UNUSED_ATTRIBUTE remove_result = values.Remove(location);                                             \
+      TERRIER_ASSERT(remove_result, "Removing from the HashIndexValues should not fail.");                             \
+      /* Return true so cuckoohash_map's uprase_fn erases the key/value pair once the last value is gone */            \
+      return values.Size() == 0;                                                                                       \
     };                                                                                                                 \
     const bool UNUSED_ATTRIBUTE uprase_result = hash_map_->uprase_fn(index_key, key_found_fn);                         \
     TERRIER_ASSERT(!uprase_result, "This operation should NOT insert a new key into the cuckoohash_map.");             \
@@ -89,6 +114,10 @@ class HashIndex final : public Index {
  public:
   IndexType Type() const final { return IndexType::HASHMAP; }
 
+  std::unique_ptr<IndexBulkLoader> BeginBulkLoad(const uint32_t num_workers) final {
+    return std::make_unique<HashIndexBulkLoader<KeyType>>(this, num_workers);
+  }
+
   bool Insert(const common::ManagedPointer<transaction::TransactionContext> txn, const ProjectedRow &tuple,
               const TupleSlot location) final {
     TERRIER_ASSERT(!(metadata_.GetSchema().Unique()),
@@ -106,22 +135,14 @@ class HashIndex final : public Index {
      * insert_result captured by reference so it can be updated in outer scope. true if insert succeeded
      *
      * Args:
-     * value the current value for this key value (found by underlying containiner on lookup, then passed to
+     * values the current values for this key (found by underlying containiner on lookup, then passed to
      * key_found_fn)
      *
      * return true if cuckoohash_map's uprase_fn should delete the key/value pair. For inserts we always return false.
      */
-    auto key_found_fn = [location, &insert_result](ValueType &value) -> bool {
-      if (std::holds_alternative<TupleSlot>(value)) {
-        // replace the TupleSlot with a ValueMap containing both the old and new inserted value
-        const auto existing_location = std::get<TupleSlot>(value);
-        value = ValueMap({{location}, {existing_location}}, 2);
-        insert_result = true;
-      } else {
-        // insert the location to the cuckoohash_map
-        auto &value_map = std::get<ValueMap>(value);
-        insert_result = value_map.emplace(location).second;
-      }
+    auto key_found_fn = [location, &insert_result](HashIndexValues &values) -> bool {
+      values.Add(location);
+      insert_result = true;
       return false;
     };
 
@@ -165,32 +186,16 @@ class HashIndex final : public Index {
      * predicate std::function to evaluate for key uniqueness
      *
      * Args:
-     * value the current value for this key value (found by underlying containiner on lookup, then passed to
+     * values the current values for this key (found by underlying containiner on lookup, then passed to
      * key_found_fn)
      *
      * return true if cuckoohash_map's uprase_fn should delete the key/value pair. For inserts we always return false.
      */
-    auto key_found_fn = [location, &insert_result, &predicate_satisfied, predicate](ValueType &value) -> bool {
-      if (std::holds_alternative<TupleSlot>(value)) {
-        const auto existing_location = std::get<TupleSlot>(value);
-        predicate_satisfied = predicate(existing_location);
-        if (!predicate_satisfied) {
-          // replace the TupleSlot with a ValueMap containing both the old and new inserted value
-          value = ValueMap({{location}, {existing_location}}, 2);
-          insert_result = true;
-        }
-      } else {
-        auto &value_map = std::get<ValueMap>(value);
-
-        predicate_satisfied = std::any_of(value_map.cbegin(), value_map.cend(), predicate);
-
-        if (!predicate_satisfied) {
-          // insert the location to the cuckoohash_map
-          insert_result = value_map.emplace(location).second;
-          TERRIER_ASSERT(insert_result,
-                         " index shouldn't fail to insert after predicate check. If it did, something went wrong deep "
-                         "inside the hash map itself.");
-        }
+    auto key_found_fn = [location, &insert_result, &predicate_satisfied, predicate](HashIndexValues &values) -> bool {
+      predicate_satisfied = std::any_of(values.begin(), values.end(), predicate);
+      if (!predicate_satisfied) {
+        values.Add(location);
+        insert_result = true;
       }
       return false;
     };
@@ -247,19 +252,12 @@ class HashIndex final : public Index {
      * txn reference to the calling txn in order to do visibility checks
      *
      * Args:
-     * value the current value for this key value (found by underlying containiner on lookup, then passed to
+     * values the current values for this key (found by underlying containiner on lookup, then passed to
      * key_found_fn)
      */
-    auto key_found_fn = [value_list, &txn](const ValueType &value) -> void {
-      if (std::holds_alternative<TupleSlot>(value)) {
-        const auto existing_location = std::get<TupleSlot>(value);
-        if (IsVisible(txn, existing_location)) value_list->emplace_back(existing_location);
-      } else {
-        const auto &value_map = std::get<ValueMap>(value);
-
-        for (const auto i : value_map) {
-          if (IsVisible(txn, i)) value_list->emplace_back(i);
-        }
+    auto key_found_fn = [value_list, &txn](const HashIndexValues &values) -> void {
+      for (const auto location : values) {
+        if (IsVisible(txn, location)) value_list->emplace_back(location);
       }
     };
 
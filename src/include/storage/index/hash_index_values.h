@@ -0,0 +1,142 @@
+#pragma once
+
+#include <algorithm>
+#include <utility>
+
+#include "common/macros.h"
+#include "storage/storage_defs.h"
+
+namespace terrier::storage::index {
+
+/**
+ * The values of a single key in a HashIndex, in no particular order. Most keys have very few values, which are stored
+ * inline without any allocation. Larger lists move to an array on the heap that doubles when full and halves when it
+ * gets mostly empty. Either way the values of a key are contiguous, so a lookup reads them in one sweep instead of
+ * chasing the nodes of a set.
+ */
+class HashIndexValues {
+ public:
+  /**
+   * Number of values stored inline, which keeps the whole list at half a cache line
+   */
+  static constexpr uint32_t INLINE_CAPACITY = 3;
+
+  /**
+   * Creates an empty list of values.
+   */
+  HashIndexValues() : size_(0), capacity_(INLINE_CAPACITY) {}
+
+  /**
+   * @param value the first value of the key
+   */
+  explicit HashIndexValues(const TupleSlot value) : size_(1), capacity_(INLINE_CAPACITY) { inline_[0] = value; }
+
+  /**
+   * @param other values to copy
+   */
+  HashIndexValues(const HashIndexValues &other) : size_(other.size_), capacity_(other.capacity_) {
+    if (other.IsOnHeap()) {
+      heap_ = new TupleSlot[capacity_];
+      std::copy(other.begin(), other.end(), heap_);
+    } else {
+      std::copy(other.begin(), other.end(), inline_);
+    }
+  }
+
+  /**
+   * @param other values to take over, left empty
+   */
+  HashIndexValues(HashIndexValues &&other) noexcept : size_(other.size_), capacity_(other.capacity_) {
+    std::copy(std::begin(other.inline_), std::end(other.inline_), inline_);
+    other.size_ = 0;
+    other.capacity_ = INLINE_CAPACITY;
+  }
+
+  /**
+   * @param other values to copy or take over
+   * @return self-reference
+   */
+  HashIndexValues &operator=(HashIndexValues other) noexcept {
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(inline_, other.inline_);
+    return *this;
+  }
+
+  ~HashIndexValues() {
+    if (IsOnHeap()) delete[] heap_;
+  }
+
+  /**
+   * @return number of values
+   */
+  uint32_t Size() const { return size_; }
+
+  /**
+   * @return first value
+   */
+  const TupleSlot *begin() const { return Data(); }
+
+  /**
+   * @return one past the last value
+   */
+  const TupleSlot *end() const { return Data() + size_; }
+
+  /**
+   * Adds a value, which must not be in the list yet.
+   * @param value value to add
+   */
+  void Add(const TupleSlot value) {
+    TERRIER_ASSERT(std::find(begin(), end(), value) == end(), "Value should not be in the list yet.");
+    if (size_ == capacity_) Resize(capacity_ * 2);
+    Data()[size_++] = value;
+  }
+
+  /**
+   * Removes a value. The last value takes its place, so removing never shifts the list.
+   * @param value value to remove
+   * @return true if the value was found
+   */
+  bool Remove(const TupleSlot value) {
+    TupleSlot *const data = Data();
+    // Search from the back because the values of aborted inserts are the most common to be removed, and the newest
+    for (uint32_t i = size_; i-- > 0;) {
+      if (data[i] != value) continue;
+      data[i] = data[--size_];
+      if (IsOnHeap() && size_ * 4 <= capacity_) Resize(capacity_ / 2);
+      return true;
+    }
+    return false;
+  }
+
+ private:
+  bool IsOnHeap() const { return capacity_ > INLINE_CAPACITY; }
+
+  TupleSlot *Data() { return IsOnHeap() ? heap_ : inline_; }
+  const TupleSlot *Data() const { return IsOnHeap() ? heap_ : inline_; }
+
+  void Resize(const uint32_t new_capacity) {
+    TERRIER_ASSERT(new_capacity >= size_, "Values would not fit.");
+    TupleSlot *const old_heap = IsOnHeap() ? heap_ : nullptr;
+    if (new_capacity <= INLINE_CAPACITY) {
+      // Only shrinking from the heap ends here. Copying inline overwrites heap_, so the old array was saved above.
+      std::copy(old_heap, old_heap + size_, inline_);
+      capacity_ = INLINE_CAPACITY;
+    } else {
+      auto *const new_heap = new TupleSlot[new_capacity];
+      std::copy(begin(), end(), new_heap);
+      heap_ = new_heap;
+      capacity_ = new_capacity;
+    }
+    delete[] old_heap;
+  }
+
+  uint32_t size_;
+  uint32_t capacity_;
+  union {
+    TupleSlot inline_[INLINE_CAPACITY];
+    TupleSlot *heap_;
+  };
+};
+
+}  // namespace terrier::storage::index
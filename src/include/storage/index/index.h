@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -7,8 +8,10 @@
 #include "catalog/catalog_defs.h"
 #include "common/performance_counter.h"
 #include "storage/data_table.h"
+#include "storage/index/index_bulk_loader.h"
 #include "storage/index/index_defs.h"
 #include "storage/index/index_metadata.h"
+#include "storage/index/index_scan_cursor.h"
 #include "storage/storage_defs.h"
 #include "transaction/transaction_context.h"
 
@@ -112,6 +115,31 @@ class Index {
   virtual void ScanKey(const transaction::TransactionContext &txn, const ProjectedRow &key,
                        std::vector<TupleSlot> *value_list) = 0;
 
+  /**
+   * Finds all the values associated with each of a batch of keys. Indexes can share work across the lookups of a
+   * batch, so this should be preferred over calling ScanKey once per key. Indexes without a batched lookup fall back to
+   * exactly that.
+   * @param txn txn context for the calling txn, used for visibility checks
+   * @param keys the keys to look for
+   * @param num_keys the number of keys
+   * @param[out] value_list the values associated with the keys, grouped by key
+   * @param[out] ranges for the i-th key, the [begin, end) range of value_list holding its values. Equal keys may share
+   * a range.
+   */
+  virtual void ScanKeys(const transaction::TransactionContext &txn, const ProjectedRow *const *keys, uint32_t num_keys,
+                        std::vector<TupleSlot> *value_list, std::vector<std::pair<uint32_t, uint32_t>> *ranges) {
+    TERRIER_ASSERT(value_list->empty() && ranges->empty(), "Result sets should begin empty.");
+    ranges->reserve(num_keys);
+    std::vector<TupleSlot> key_values;
+    for (uint32_t i = 0; i < num_keys; i++) {
+      key_values.clear();
+      ScanKey(txn, *keys[i], &key_values);
+      const auto begin = static_cast<uint32_t>(value_list->size());
+      value_list->insert(value_list->end(), key_values.begin(), key_values.end());
+      ranges->emplace_back(begin, static_cast<uint32_t>(value_list->size()));
+    }
+  }
+
   /**
    * Finds all the values between the given keys in our index, sorted in ascending order.
    * @param txn txn context for the calling txn, used for visibility checks
@@ -128,6 +156,40 @@ class Index {
     TERRIER_ASSERT(false, "You called a method on an index type that hasn't implemented it.");
   }
 
+  /**
+   * Begins a scan over the values between the given keys in our index, in ascending order. The values are produced
+   * incrementally by the returned cursor instead of being collected up front. Indexes without a streaming scan fall
+   * back to collecting the results of ScanAscending.
+   * @param txn txn context for the calling txn, used for visibility checks
+   * @param scan_type Scan Type
+   * @param num_attrs Number of attributes to compare
+   * @param low_key the key to start at. It is not referenced after this call returns.
+   * @param high_key the key to end at. It is not referenced after this call returns.
+   * @param limit if any
+   * @return cursor over the values associated with the keys
+   */
+  virtual std::unique_ptr<IndexScanCursor> BeginScanAscending(const transaction::TransactionContext &txn,
+                                                              ScanType scan_type, uint32_t num_attrs,
+                                                              ProjectedRow *low_key, ProjectedRow *high_key,
+                                                              uint32_t limit) {
+    std::vector<TupleSlot> values;
+    ScanAscending(txn, scan_type, num_attrs, low_key, high_key, limit, &values);
+    return std::make_unique<MaterializedIndexScanCursor>(std::move(values));
+  }
+
+  /**
+   * @return whether scan cursors of this index can hand out the key of each result (IndexScanCursor::NextWithKeys), so
+   * that a scan reading only key columns never has to read the table
+   */
+  virtual bool SupportsKeyRetrieval() const { return false; }
+
+  /**
+   * Begins building this index from many entries at once. See IndexBulkLoader for when this can be used.
+   * @param num_workers number of workers that add entries concurrently
+   * @return the loader, or nullptr if this index type has no bulk load and entries must be inserted one at a time
+   */
+  virtual std::unique_ptr<IndexBulkLoader> BeginBulkLoad(uint32_t num_workers) { return nullptr; }
+
   /**
    * Finds all the values between the given keys in our index, sorted in descending order.
    * @param txn txn context for the calling txn, used for visibility checks
@@ -4,6 +4,8 @@
 #include <vector>
 #include "catalog/catalog_defs.h"
 #include "catalog/index_schema.h"
+#include "common/managed_pointer.h"
+#include "storage/index/art_index.h"
 #include "storage/index/bwtree_index.h"
 #include "storage/index/compact_ints_key.h"
 #include "storage/index/generic_key.h"
@@ -13,6 +15,11 @@
 #include "storage/index/index_defs.h"
 #include "storage/index/index_metadata.h"
 #include "storage/projected_row.h"
+#include "transaction/transaction_context.h"
+
+namespace terrier::storage {
+class SqlTable;
+}  // namespace terrier::storage
 
 namespace terrier::storage::index {
 
@@ -53,6 +60,11 @@ class IndexBuilder {
         if (simple_key && metadata.KeySize() <= HASHKEY_MAX_SIZE) return BuildHashIntsKey(std::move(metadata));
         return BuildHashGenericKey(std::move(metadata));
       }
+      case IndexType::ART: {
+        // The radix tree orders keys by their bytes, which only matches the key order for CompactIntsKey
+        if (simple_key && metadata.KeySize() <= COMPACTINTSKEY_MAX_SIZE) return BuildArtIntsKey(std::move(metadata));
+        return BuildBwTreeGenericKey(std::move(metadata));
+      }
       default:
         return nullptr;
     }
@@ -67,6 +79,18 @@ class IndexBuilder {
     return *this;
   }
 
+  /**
+   * Populate a newly built index with the tuples of its table that are visible to the calling txn. The table is scanned
+   * by several threads, each over its own range of blocks, and the index is bulk loaded from the extracted keys when it
+   * supports it. Only index keys that are plain columns of the table are supported.
+   * @param txn the txn creating the index
+   * @param table the table the index is on
+   * @param index the index built from the current key schema, empty and not visible to any other txn
+   * @return false if the index is unique and the table holds duplicate keys, true otherwise
+   */
+  bool BulkInsert(common::ManagedPointer<transaction::TransactionContext> txn, common::ManagedPointer<SqlTable> table,
+                  Index *index) const;
+
  private:
   Index *BuildBwTreeIntsKey(IndexMetadata metadata) const {
     metadata.SetKeyKind(IndexKeyKind::COMPACTINTSKEY);
@@ -86,6 +110,24 @@ class IndexBuilder {
     return index;
   }
 
+  Index *BuildArtIntsKey(IndexMetadata metadata) const {
+    metadata.SetKeyKind(IndexKeyKind::COMPACTINTSKEY);
+    const auto key_size = metadata.KeySize();
+    TERRIER_ASSERT(key_size <= COMPACTINTSKEY_MAX_SIZE, "Key size exceeds maximum for this key type.");
+    Index *index = nullptr;
+    if (key_size <= 8) {
+      index = new ArtIndex<CompactIntsKey<8>>(std::move(metadata));
+    } else if (key_size <= 16) {
+      index = new ArtIndex<CompactIntsKey<16>>(std::move(metadata));
+    } else if (key_size <= 24) {
+      index = new ArtIndex<CompactIntsKey<24>>(std::move(metadata));
+    } else if (key_size <= 32) {
+      index = new ArtIndex<CompactIntsKey<32>>(std::move(metadata));
+    }
+    TERRIER_ASSERT(index != nullptr, "Failed to create an IntsKey index.");
+    return index;
+  }
+
   Index *BuildBwTreeGenericKey(IndexMetadata metadata) const {
     metadata.SetKeyKind(IndexKeyKind::GENERICKEY);
     const auto pr_size = metadata.GetInlinedPRInitializer().ProjectedRowSize();
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "common/macros.h"
+#include "storage/index/index_metadata.h"
+#include "storage/projected_row.h"
+#include "storage/storage_defs.h"
+
+namespace terrier::storage::index {
+
+/**
+ * Builds an index from many entries at once, which is much faster than inserting them one at a time. Entries are added
+ * by any number of workers in parallel, and the index is then built in one go by Finish().
+ *
+ * A bulk load is only valid on an index that is empty and not visible to any transaction but the one creating it. No
+ * abort actions are registered for the loaded entries: if the creating transaction aborts, the whole index is dropped.
+ */
+class IndexBulkLoader {
+ public:
+  virtual ~IndexBulkLoader() = default;
+
+  /**
+   * Add an entry. Different workers can add entries concurrently, but each worker must only be used by one thread at a
+   * time.
+   * @param worker id of the worker adding the entry, less than the number of workers the load was started with
+   * @param key the key of the entry, laid out like the index's ProjectedRows
+   * @param location the value of the entry
+   */
+  virtual void Add(uint32_t worker, const ProjectedRow &key, TupleSlot location) = 0;
+
+  /**
+   * Build the index from all the entries added so far. No entry can be added after this.
+   * @return false if the index is unique and two entries have the same key, in which case the contents of the index are
+   * unspecified and it should be dropped
+   */
+  virtual bool Finish() = 0;
+};
+
+/**
+ * Bulk loader that converts the entries of each worker to index keys and buffers them until Finish().
+ * @tparam KeyType the type of keys stored in the index
+ */
+template <typename KeyType>
+class BufferedIndexBulkLoader : public IndexBulkLoader {
+ public:
+  /**
+   * @param metadata metadata of the index being loaded, which must outlive the loader
+   * @param num_workers number of workers adding entries
+   */
+  BufferedIndexBulkLoader(const IndexMetadata &metadata, const uint32_t num_workers)
+      : metadata_(metadata), buffers_(num_workers) {}
+
+  void Add(const uint32_t worker, const ProjectedRow &key, const TupleSlot location) final {
+    TERRIER_ASSERT(worker < buffers_.size(), "Invalid worker id.");
+    auto &entry = buffers_[worker].emplace_back();
+    entry.first.SetFromProjectedRow(key, metadata_, metadata_.GetSchema().GetColumns().size());
+    entry.second = location;
+  }
+
+ protected:
+  /**
+   * @return total number of entries added by all workers
+   */
+  std::size_t NumEntries() const {
+    std::size_t num_entries = 0;
+    for (const auto &buffer : buffers_) num_entries += buffer.size();
+    return num_entries;
+  }
+
+  /**
+   * Metadata of the index being loaded
+   */
+  const IndexMetadata &metadata_;
+
+  /**
+   * The entries added by each worker, in the order they were added
+   */
+  std::vector<std::vector<std::pair<KeyType, TupleSlot>>> buffers_;
+};
+
+}  // namespace terrier::storage::index
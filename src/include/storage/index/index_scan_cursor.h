@@ -0,0 +1,69 @@
+#pragma once
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "common/macros.h"
+#include "storage/projected_row.h"
+#include "storage/storage_defs.h"
+
+namespace terrier::storage::index {
+
+/**
+ * A cursor over the results of an index scan. Unlike the Scan* methods of Index, which collect every result before
+ * returning, a cursor hands out the results a batch at a time, so memory use stays bounded and the caller can stop
+ * early (e.g. on a LIMIT) without the rest of the range ever being visited.
+ *
+ * A cursor holds no latches between calls, but it must not outlive the index or the transaction it was created for.
+ */
+class IndexScanCursor {
+ public:
+  virtual ~IndexScanCursor() = default;
+
+  /**
+   * Append the next batch of results, in scan order, to the given list.
+   * @param[out] value_list the list to append to
+   * @param max_values the maximum number of values to append
+   * @return the number of values appended. A return of 0 means the scan is exhausted.
+   */
+  virtual uint32_t Next(std::vector<TupleSlot> *value_list, uint32_t max_values) = 0;
+
+  /**
+   * Append the next batch of results, in scan order, to the given list, and write the key of each result into the
+   * matching output row. Only supported on cursors of indexes for which Index::SupportsKeyRetrieval is true.
+   * @param[out] value_list the list to append to
+   * @param[out] keys one row per value, laid out like the index's ProjectedRows. The i-th value appended by this call
+   * gets its key written to keys[i].
+   * @param max_values the maximum number of values to append
+   * @return the number of values appended. A return of 0 means the scan is exhausted.
+   */
+  virtual uint32_t NextWithKeys(std::vector<TupleSlot> *value_list, ProjectedRow *const *keys, uint32_t max_values) {
+    TERRIER_ASSERT(false, "You called a method on an index type that hasn't implemented it.");
+    return 0;
+  }
+};
+
+/**
+ * Cursor over results that were already collected in full, for indexes that have no streaming scan.
+ */
+class MaterializedIndexScanCursor final : public IndexScanCursor {
+ public:
+  /**
+   * @param values the results of the scan, in scan order
+   */
+  explicit MaterializedIndexScanCursor(std::vector<TupleSlot> values) : values_(std::move(values)) {}
+
+  uint32_t Next(std::vector<TupleSlot> *const value_list, const uint32_t max_values) final {
+    const auto num_values = static_cast<uint32_t>(std::min<std::size_t>(max_values, values_.size() - next_));
+    value_list->insert(value_list->end(), values_.begin() + next_, values_.begin() + next_ + num_values);
+    next_ += num_values;
+    return num_values;
+  }
+
+ private:
+  std::vector<TupleSlot> values_;
+  std::size_t next_ = 0;
+};
+
+}  // namespace terrier::storage::index
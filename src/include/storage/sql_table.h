@@ -67,6 +67,23 @@ class SqlTable {
     return table_.data_table_->Select(txn, slot, out_buffer);
   }
 
+  /**
+   * Materializes the tuples at the given slots, as visible at the timestamp of the calling txn, prefetching ahead of
+   * the tuple being read. Slots that are not visible are skipped. @see DataTable::SelectBatch
+   *
+   * @param txn the calling transaction
+   * @param slots the tuple slots to read
+   * @param num_slots number of slots to read
+   * @param out_buffers one output buffer per slot, all with the same projection list information. @see ProjectedRow.
+   * @param[out] out_slots the slots of the materialized tuples, in the same order as the output buffers
+   * @return the number of tuples that were visible and materialized
+   */
+  uint32_t SelectBatch(const common::ManagedPointer<transaction::TransactionContext> txn, const TupleSlot *const slots,
+                       const uint32_t num_slots, ProjectedRow *const *const out_buffers,
+                       TupleSlot *const out_slots) const {
+    return table_.data_table_->SelectBatch(txn, slots, num_slots, out_buffers, out_slots);
+  }
+
   /**
    * Update the tuple according to the redo buffer given. StageWrite must have been called as well in order for the
    * operation to be logged.
@@ -161,6 +178,22 @@ class SqlTable {
    */
   DataTable::SlotIterator end() const { return table_.data_table_->end(); }  // NOLINT for STL name compability
 
+  /**
+   * @return the blocks of the underlying DataTable, so that different threads can scan different blocks
+   */
+  std::vector<RawBlock *> GetBlocks() const { return table_.data_table_->GetBlocks(); }
+
+  /**
+   * @return commit timestamp of the last transaction that committed a change to the table
+   * @see DataTable::LastModified
+   */
+  transaction::timestamp_t LastModified() const { return table_.data_table_->LastModified(); }
+
+  /**
+   * @return the number of tuple slots in each block of the table
+   */
+  uint32_t NumSlotsPerBlock() const { return table_.layout_.NumSlots(); }
+
   /**
    * Generates an ProjectedColumnsInitializer for the execution layer to use. This performs the translation from col_oid
    * to col_id for the Initializer's constructor so that the execution layer doesn't need to know anything about col_id.
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog_defs.h"
+#include "common/macros.h"
+#include "common/spin_latch.h"
+#include "network/network_defs.h"
+#include "transaction/transaction_defs.h"
+#include "type/transient_value.h"
+
+namespace terrier::planner {
+class AbstractPlanNode;
+}
+
+namespace terrier::trafficcop {
+
+/**
+ * Caches the serialized result rows of read-only SELECTs, shared by all connections. Each result is tagged with the
+ * commit timestamp of the last change to every table it read (@see storage::DataTable::LastModified). A transaction
+ * can reuse a result as long as none of those tables changed since, and it started after the last change to each of
+ * them, so that the result is exactly what it would have read itself.
+ *
+ * Results are evicted least recently used first once they take up more than the capacity of the cache.
+ */
+class ResultCache {
+ public:
+  /**
+   * Default number of bytes of result rows kept in the cache
+   */
+  static constexpr uint64_t DEFAULT_CAPACITY = 64 * 1024 * 1024;
+
+  /**
+   * Largest result, in bytes of result rows, that is worth caching
+   */
+  static constexpr uint64_t MAX_RESULT_SIZE = 1024 * 1024;
+
+  /**
+   * Tables, each with the commit timestamp of its last change or INVALID_TXN_TIMESTAMP if it is gone
+   */
+  using TableVersions = std::vector<std::pair<catalog::table_oid_t, transaction::timestamp_t>>;
+
+  /**
+   * Cached result of a query
+   */
+  struct Result {
+    /**
+     * DataRow messages of the result, ready to send
+     */
+    std::string rows_;
+    /**
+     * Number of rows in the result
+     */
+    uint32_t num_rows_;
+    /**
+     * Tables the query read, as of the result
+     */
+    TableVersions table_versions_;
+  };
+
+  /**
+   * @param capacity number of bytes of result rows to keep in the cache
+   */
+  explicit ResultCache(const uint64_t capacity = DEFAULT_CAPACITY) : capacity_(capacity) {}
+
+  DISALLOW_COPY_AND_MOVE(ResultCache);
+
+  /**
+   * Collects the tables a plan reads
+   * @param plan physical plan of a SELECT
+   * @param[out] tables tables read by the plan
+   * @return false if the results of the plan depend on more than the contents of the tables, e.g. because it reads a
+   * file or locks rows, so they can't be cached
+   */
+  static bool GetTablesRead(const planner::AbstractPlanNode &plan, std::vector<catalog::table_oid_t> *tables);
+
+  /**
+   * Makes the key of a query's results. The tables are part of the key because the same text can refer to different
+   * tables depending on the connection, e.g. temporary tables.
+   * @param db_oid database of the query
+   * @param query_text text of the query's statement
+   * @param tables tables read by the query's plan
+   * @param params parameters of the query
+   * @param result_formats formats of the result columns
+   * @param[out] key key of the results
+   * @return false if a parameter has a type that can't be part of a key
+   */
+  static bool MakeKey(catalog::db_oid_t db_oid, const std::string &query_text,
+                      const std::vector<catalog::table_oid_t> &tables, const std::vector<type::TransientValue> &params,
+                      const std::vector<network::FieldFormat> &result_formats, std::string *key);
+
+  /**
+   * Looks up the results of a query as a transaction would read them
+   * @param key key of the results
+   * @param start_time start timestamp of the transaction reading the results, which must not have written anything
+   * @param table_versions tables read by the query, in the order of the key, as of after the transaction started
+   * @return cached results, or nullptr if there are none or they are out of date
+   */
+  std::shared_ptr<const Result> Lookup(const std::string &key, transaction::timestamp_t start_time,
+                                       const TableVersions &table_versions);
+
+  /**
+   * Caches the results of a query, if the transaction that produced them saw the last change to every table read
+   * @param key key of the results
+   * @param start_time start timestamp of the transaction that produced the results, which must not have written
+   * anything
+   * @param result results to cache, with the versions of the tables read as of after the query ran
+   * @return true if the results were cached
+   */
+  bool Insert(const std::string &key, transaction::timestamp_t start_time, Result result);
+
+  /**
+   * @return number of cached results
+   */
+  size_t Size() const {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    return results_.size();
+  }
+
+ private:
+  // Results by key, along with their position in the LRU list
+  using ResultMap =
+      std::unordered_map<std::string, std::pair<std::shared_ptr<const Result>, std::list<std::string>::iterator>>;
+
+  // Removes a result, with the latch held
+  void Erase(ResultMap::iterator it);
+
+  const uint64_t capacity_;
+  mutable common::SpinLatch latch_;
+  ResultMap results_;
+  // Keys from most to least recently used
+  std::list<std::string> lru_;
+  uint64_t size_ = 0;
+};
+
+}  // namespace terrier::trafficcop
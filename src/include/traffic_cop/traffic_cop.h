@@ -1,4 +1,5 @@
 #pragma once
+#include <atomic>
 #include <memory>
 #include <string>
 #include <utility>
@@ -6,11 +7,13 @@
 
 #include "catalog/catalog.h"
 #include "common/managed_pointer.h"
+#include "common/worker_pool.h"
 #include "network/network_defs.h"
 #include "parser/create_statement.h"
 #include "parser/drop_statement.h"
 #include "parser/transaction_statement.h"
 #include "storage/recovery/replication_log_provider.h"
+#include "traffic_cop/result_cache.h"
 #include "traffic_cop/traffic_cop_defs.h"
 
 namespace terrier::network {
@@ -44,19 +47,32 @@ class TrafficCop {
    * @param replication_log_provider if given, the tcop will forward replication logs to this provider
    * @param stats_storage for optimizer calls
    * @param optimizer_timeout for optimizer calls
+   * @param optimizer_thread_count number of threads shared by all optimizer calls, 0 to optimize on the calling thread
    * @param use_query_cache whether to cache physical plans and generated code for Extended Query protocol
+   * @param result_cache_size bytes of result rows of read-only SELECTs to cache, 0 to not cache results
+   * @param sort_memory_budget bytes of tuples each sorter buffers before spilling to disk, 0 for no limit
+   * @param server_side_copy whether COPY may read and write files on the server rather than only STDIN and STDOUT
    */
   TrafficCop(common::ManagedPointer<transaction::TransactionManager> txn_manager,
              common::ManagedPointer<catalog::Catalog> catalog,
              common::ManagedPointer<storage::ReplicationLogProvider> replication_log_provider,
              common::ManagedPointer<optimizer::StatsStorage> stats_storage, uint64_t optimizer_timeout,
-             bool use_query_cache)
+             uint32_t optimizer_thread_count, bool use_query_cache, uint64_t result_cache_size,
+             uint64_t sort_memory_budget, bool server_side_copy)
       : txn_manager_(txn_manager),
         catalog_(catalog),
         replication_log_provider_(replication_log_provider),
         stats_storage_(stats_storage),
         optimizer_timeout_(optimizer_timeout),
-        use_query_cache_(use_query_cache) {}
+        use_query_cache_(use_query_cache),
+        result_cache_(result_cache_size > 0 ? std::make_unique<ResultCache>(result_cache_size) : nullptr),
+        sort_memory_budget_(sort_memory_budget),
+        server_side_copy_(server_side_copy) {
+    if (optimizer_thread_count > 0) {
+      optimizer_workers_ = std::make_unique<common::WorkerPool>(optimizer_thread_count, common::TaskQueue());
+      optimizer_workers_->Startup();
+    }
+  }
 
   virtual ~TrafficCop() = default;
 
@@ -172,7 +188,7 @@ class TrafficCop {
                                        common::ManagedPointer<network::Portal> portal) const;
   /**
    * Contains the logic to reason about DML execution. Responsible for outputting results because we don't want to
-   * (can't) stick it in TrafficCopResult.
+   * (can't) stick it in TrafficCopResult. Read-only SELECTs are answered from the result cache if enabled.
    * @param connection_ctx context to be used to access the internal txn
    * @param out packet writer to return results
    * @param portal to be executed, may contain parameters
@@ -182,25 +198,71 @@ class TrafficCop {
                                       common::ManagedPointer<network::PostgresPacketWriter> out,
                                       common::ManagedPointer<network::Portal> portal) const;
 
+  /**
+   * Contains the logic to reason about COPY execution. COPY ... FROM bulk loads a CSV file into a table. COPY ... TO
+   * runs the statement's query and writes its results as CSV, either to a file or to the client as CopyData messages.
+   * COPY ... FROM STDIN only asks the client for its data, which is loaded by ExecuteCopyFromStdin once it arrived.
+   * Files are only copied to or from if server_side_copy is enabled.
+   * @param connection_ctx context to be used to access the internal txn
+   * @param out packet writer for COPY ... TO STDOUT and COPY ... FROM STDIN
+   * @param statement bound COPY statement
+   * @return result of the operation, with the number of rows copied if successful, or QUEUING if the client was asked
+   * for the data of COPY ... FROM STDIN
+   */
+  TrafficCopResult ExecuteCopyStatement(common::ManagedPointer<network::ConnectionContext> connection_ctx,
+                                        common::ManagedPointer<network::PostgresPacketWriter> out,
+                                        common::ManagedPointer<network::Statement> statement) const;
+
+  /**
+   * Bulk loads the CSV data that the client sent for COPY ... FROM STDIN into the table
+   * @param connection_ctx context to be used to access the internal txn
+   * @param statement bound COPY statement that ExecuteCopyStatement returned QUEUING for
+   * @param data contents of all of the client's CopyData messages
+   * @return result of the operation, with the number of rows copied if successful
+   */
+  TrafficCopResult ExecuteCopyFromStdin(common::ManagedPointer<network::ConnectionContext> connection_ctx,
+                                        common::ManagedPointer<network::Statement> statement,
+                                        const std::string &data) const;
+
   /**
    * Adjust the TrafficCop's optimizer timeout value (for use by SettingsManager)
    * @param optimizer_timeout time in ms to spend on a task @see optimizer::Optimizer constructor
    */
   void SetOptimizerTimeout(const uint64_t optimizer_timeout) { optimizer_timeout_ = optimizer_timeout; }
 
+  /**
+   * Adjust the memory budget of the sorters of queries started from now on (for use by SettingsManager)
+   * @param sort_memory_budget bytes of tuples each sorter buffers before spilling to disk, 0 for no limit
+   */
+  void SetSortMemoryBudget(const uint64_t sort_memory_budget) {
+    sort_memory_budget_.store(sort_memory_budget, std::memory_order_relaxed);
+  }
+
   /**
    * @return true if query caching enabled, false otherwise
    */
   bool UseQueryCache() const { return use_query_cache_; }
 
  private:
+  // Runs the portal's executable query, writing its results to out
+  TrafficCopResult ExecuteQuery(common::ManagedPointer<network::ConnectionContext> connection_ctx,
+                                common::ManagedPointer<network::PostgresPacketWriter> out,
+                                common::ManagedPointer<network::Portal> portal) const;
+
   common::ManagedPointer<transaction::TransactionManager> txn_manager_;
   common::ManagedPointer<catalog::Catalog> catalog_;
   // Hands logs off to replication component. TCop should forward these logs through this provider.
   common::ManagedPointer<storage::ReplicationLogProvider> replication_log_provider_;
   common::ManagedPointer<optimizer::StatsStorage> stats_storage_;
   uint64_t optimizer_timeout_;
+  // Threads that optimize independent parts of queries in parallel, shared by all connections, nullptr if disabled
+  std::unique_ptr<common::WorkerPool> optimizer_workers_;
   bool use_query_cache_;
+  // Results of read-only SELECTs shared by all connections, nullptr if disabled
+  std::unique_ptr<ResultCache> result_cache_;
+  // Handed to the execution context of every query, changed by the settings manager while queries run
+  std::atomic<uint64_t> sort_memory_budget_;
+  bool server_side_copy_;
 };
 
 }  // namespace terrier::trafficcop
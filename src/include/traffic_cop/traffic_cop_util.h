@@ -2,15 +2,21 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "catalog/catalog_defs.h"
 #include "common/managed_pointer.h"
 #include "network/network_defs.h"
+#include "type/transient_value.h"
 
 namespace terrier::catalog {
 class CatalogAccessor;
 }
 
+namespace terrier::common {
+class WorkerPool;
+}
+
 namespace terrier::parser {
 class ParseResult;
 class SQLStatement;
@@ -46,13 +52,36 @@ class TrafficCopUtil {
    * @param stats_storage used by optimizer
    * @param cost_model used by optimizer
    * @param optimizer_timeout used by optimizer
+   * @param optimizer_workers threads the optimizer shares with other queries, nullptr to optimize on this thread only
    * @return physical plan that can be executed
    */
   static std::unique_ptr<planner::AbstractPlanNode> Optimize(
       common::ManagedPointer<transaction::TransactionContext> txn,
       common::ManagedPointer<catalog::CatalogAccessor> accessor, common::ManagedPointer<parser::ParseResult> query,
       catalog::db_oid_t db_oid, common::ManagedPointer<optimizer::StatsStorage> stats_storage,
-      std::unique_ptr<optimizer::AbstractCostModel> cost_model, uint64_t optimizer_timeout);
+      std::unique_ptr<optimizer::AbstractCostModel> cost_model, uint64_t optimizer_timeout,
+      common::ManagedPointer<common::WorkerPool> optimizer_workers = nullptr);
+
+  /**
+   * Optimize one statement of a ParseResult, e.g., the query nested in a COPY statement
+   * @param txn used by optimizer
+   * @param accessor used by optimizer
+   * @param query bound ParseResult that owns the statement's expressions
+   * @param statement bound statement to optimize
+   * @param db_oid database oid
+   * @param stats_storage used by optimizer
+   * @param cost_model used by optimizer
+   * @param optimizer_timeout used by optimizer
+   * @param optimizer_workers threads the optimizer shares with other queries, nullptr to optimize on this thread only
+   * @return physical plan that can be executed
+   */
+  static std::unique_ptr<planner::AbstractPlanNode> Optimize(
+      common::ManagedPointer<transaction::TransactionContext> txn,
+      common::ManagedPointer<catalog::CatalogAccessor> accessor, common::ManagedPointer<parser::ParseResult> query,
+      common::ManagedPointer<parser::SQLStatement> statement, catalog::db_oid_t db_oid,
+      common::ManagedPointer<optimizer::StatsStorage> stats_storage,
+      std::unique_ptr<optimizer::AbstractCostModel> cost_model, uint64_t optimizer_timeout,
+      common::ManagedPointer<common::WorkerPool> optimizer_workers = nullptr);
 
   /**
    * Converts parser statement types (which rely on multiple enums) to a single QueryType enum from the network layer
@@ -60,6 +89,20 @@ class TrafficCopUtil {
    * @return
    */
   static network::QueryType QueryTypeForStatement(common::ManagedPointer<parser::SQLStatement> statement);
+
+  /**
+   * Replaces the constants of a query string with parameters ($1, $2, ...) without parsing it, so queries that differ
+   * only in their constants map to the same text. Only numbers and strings in positions where a parameter means the
+   * same thing to the parser are replaced: operands of a comparison and the elements of VALUES and IN lists. All other
+   * constants (LIMIT counts, ORDER BY positions, typed strings such as DATE '...', ...) stay in the text. Whitespace
+   * outside of quotes is collapsed and comments are dropped.
+   * @param query query string to parameterize
+   * @param[out] parameterized_query query string with constants replaced by parameters
+   * @param[out] params values of the replaced constants, typed the way the parser would type them
+   * @return false if the query uses syntax that this lexer doesn't understand, in which case it should be parsed as is
+   */
+  static bool ParameterizeQuery(const std::string &query, std::string *parameterized_query,
+                                std::vector<type::TransientValue> *params);
 };
 
 }  // namespace terrier::trafficcop
@@ -29,6 +29,17 @@ class TimestampManager {
    */
   timestamp_t CheckOutTimestamp() { return time_++; }
 
+  /**
+   * Checks out a contiguous batch of timestamps with a single atomic operation. The caller owns every timestamp in
+   * [return value, return value + count).
+   * @param count number of timestamps to check out, must be greater than zero
+   * @return first timestamp of the batch
+   */
+  timestamp_t CheckOutTimestamps(const uint64_t count) {
+    TERRIER_ASSERT(count > 0, "cannot check out an empty batch of timestamps");
+    return time_.fetch_add(count);
+  }
+
   /**
    * @return current time without advancing the tick
    */
@@ -95,7 +106,6 @@ class TimestampManager {
    */
   void RemoveTransactions(const std::vector<timestamp_t> &timestamps);
 
-  // TODO(Tianyu): Timestamp generation needs to be more efficient (batches)
   // TODO(Tianyu): We don't handle timestamp wrap-arounds. I doubt this would be an issue any time soon.
   std::atomic<timestamp_t> time_{INITIAL_TXN_TIMESTAMP};
   // We cache the oldest txn start time
@@ -2,6 +2,7 @@
 #include <queue>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "common/gate.h"
 #include "common/spin_latch.h"
@@ -87,8 +88,17 @@ class TransactionManager {
   TransactionQueue completed_txns_;
   const common::ManagedPointer<storage::LogManager> log_manager_;
 
+  // Updating transactions that are waiting for a commit timestamp. Whichever committer claims commit_leader_ drains
+  // the queue and commits everyone in it as one group, so the gate and the global timestamp counter are only touched
+  // once per group instead of once per transaction.
+  common::SpinLatch pending_commits_latch_;
+  std::vector<TransactionContext *> pending_commits_;
+  std::atomic<bool> commit_leader_{false};
+
   timestamp_t UpdatingCommitCriticalSection(TransactionContext *txn);
 
+  void CommitGroup(const std::vector<TransactionContext *> &group);
+
   void LogCommit(TransactionContext *txn, timestamp_t commit_time, transaction::callback_fn commit_callback,
                  void *commit_callback_arg, timestamp_t oldest_active_txn);
 
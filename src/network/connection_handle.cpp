@@ -162,9 +162,8 @@ END_DEF
 
 Transition ConnectionHandle::GetResult() {
   EventUtil::EventAdd(network_event_, nullptr);
-  protocol_interpreter_->GetResult(io_wrapper_->GetWriteQueue());
   NETWORK_LOG_TRACE("GetResult");
-  return Transition::PROCEED;
+  return protocol_interpreter_->GetResult(io_wrapper_->GetWriteQueue());
 }
 
 Transition ConnectionHandle::TryCloseConnection() {
@@ -29,9 +29,10 @@ Transition ITPProtocolInterpreter::Process(common::ManagedPointer<ReadBuffer> in
   return ret;
 }
 
-void ITPProtocolInterpreter::GetResult(const common::ManagedPointer<WriteQueue> out) {
+Transition ITPProtocolInterpreter::GetResult(const common::ManagedPointer<WriteQueue> out) {
   ITPPacketWriter writer(out);
   writer.WriteCommandComplete();
+  return Transition::PROCEED;
 }
 
 size_t ITPProtocolInterpreter::GetPacketHeaderSize() { return 1 + sizeof(uint32_t); }
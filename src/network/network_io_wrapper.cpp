@@ -10,10 +10,22 @@
 
 namespace terrier::network {
 Transition NetworkIoWrapper::FlushAllWrites() {
-  for (auto flush_head = out_->FlushHead(); flush_head != nullptr; out_->MarkHeadFlushed()) {
-    const auto result = FlushWriteBuffer(flush_head);
-    if (result != Transition::PROCEED) return result;
-    flush_head = out_->FlushHead();
+  while (out_->FlushHead() != nullptr) {
+    auto bytes_written = out_->WriteOutTo(sock_fd_);
+    if (bytes_written < 0) {
+      switch (errno) {
+        case EINTR:
+          continue;
+        case EAGAIN:
+          return Transition::NEED_WRITE;
+        case EPIPE:
+          NETWORK_LOG_TRACE("Client closed during write");
+          return Transition::TERMINATE;
+        default:
+          NETWORK_LOG_ERROR("Error writing: %s", strerror(errno));
+          throw NETWORK_PROCESS_EXCEPTION("Fatal error during write");
+      }
+    }
   }
   out_->Reset();
   return Transition::PROCEED;
@@ -21,6 +21,12 @@ std::unique_ptr<PostgresNetworkCommand> PostgresCommandFactory::PacketToCommand(
       return MAKE_POSTGRES_COMMAND(CloseCommand);
     case NetworkMessageType::PG_TERMINATE_COMMAND:
       return MAKE_POSTGRES_COMMAND(TerminateCommand);
+    case NetworkMessageType::PG_COPY_DATA:
+      return MAKE_POSTGRES_COMMAND(CopyDataCommand);
+    case NetworkMessageType::PG_COPY_DONE:
+      return MAKE_POSTGRES_COMMAND(CopyDoneCommand);
+    case NetworkMessageType::PG_COPY_FAIL:
+      return MAKE_POSTGRES_COMMAND(CopyFailCommand);
     default:
       throw NETWORK_PROCESS_EXCEPTION("Unexpected Packet Type: ");
   }
@@ -2,7 +2,9 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <variant>
+#include <vector>
 
 #include "network/postgres/postgres_packet_util.h"
 #include "network/postgres/postgres_protocol_interpreter.h"
@@ -18,6 +20,29 @@ static Transition FinishSimpleQueryCommand(const common::ManagedPointer<Postgres
   return Transition::PROCEED;
 }
 
+/**
+ * Ends the statement of a simple query. A single statement transaction is ended along with it.
+ * @param interpreter interpreter that tracks the transaction block
+ * @param out packet writer to send ReadyForQuery with
+ * @param t_cop traffic cop to end the transaction with
+ * @param connection connection context
+ * @return next transition for the state machine
+ */
+static Transition FinishSimpleQueryStatement(const common::ManagedPointer<PostgresProtocolInterpreter> interpreter,
+                                             const common::ManagedPointer<PostgresPacketWriter> out,
+                                             const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                                             const common::ManagedPointer<ConnectionContext> connection) {
+  if (!interpreter->ExplicitTransactionBlock()) {
+    // Single statement transaction should be ended before returning
+    // decide whether the txn should be committed or aborted based on the MustAbort flag, and then end the txn
+    t_cop->EndTransaction(connection, connection->Transaction()->MustAbort() ? network::QueryType::QUERY_ROLLBACK
+                                                                             : network::QueryType::QUERY_COMMIT);
+    interpreter->ResetTransactionState();
+  }
+
+  return FinishSimpleQueryCommand(out, connection);
+}
+
 static void ExecutePortal(const common::ManagedPointer<network::ConnectionContext> connection_ctx,
                           const common::ManagedPointer<Portal> portal,
                           const common::ManagedPointer<network::PostgresPacketWriter> out,
@@ -62,6 +87,53 @@ static void ExecutePortal(const common::ManagedPointer<network::ConnectionContex
   }
 }
 
+/**
+ * Finds the cached statement of a simple query by its parameterized text. On a miss, the parameterized text is parsed
+ * into a new cache entry.
+ * @param interpreter interpreter that holds the cache
+ * @param t_cop traffic cop to parse with
+ * @param connection connection context
+ * @param query_text query text from the wire
+ * @param[out] cache_key key of the query in the cache
+ * @param[out] params values of the query's constants, to bind to the statement
+ * @return cached statement, or nullptr if the query has to be parsed as is
+ */
+static common::ManagedPointer<Statement> LookupSimpleQuery(
+    const common::ManagedPointer<PostgresProtocolInterpreter> interpreter,
+    const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+    const common::ManagedPointer<ConnectionContext> connection, const std::string &query_text,
+    std::string *const cache_key, std::vector<type::TransientValue> *const params) {
+  std::string parameterized_query;
+  if (!trafficcop::TrafficCopUtil::ParameterizeQuery(query_text, &parameterized_query, params)) return nullptr;
+
+  // The text alone doesn't tell "= 1" from "= '1'", so the key leads with the types of the parameters
+  std::vector<type::TypeId> param_types;
+  param_types.reserve(params->size());
+  *cache_key = std::to_string(params->size()) + ':';
+  for (const auto &param : *params) {
+    param_types.emplace_back(param.Type());
+    cache_key->push_back(static_cast<char>(param.Type()));
+  }
+  cache_key->append(parameterized_query);
+
+  if (interpreter->SimpleQueryCached(*cache_key)) return interpreter->LookupSimpleQueryInCache(*cache_key);
+
+  auto parse_result = t_cop->ParseQuery(parameterized_query, connection);
+  auto statement =
+      std::make_unique<Statement>(std::move(parameterized_query), std::move(parse_result), std::move(param_types));
+  // Only DML is cached. A parameter can also break a query that parses fine with its constants, which the parser then
+  // reports for the original query.
+  if (!statement->Valid() || statement->Empty() || statement->GetQueryType() < QueryType::QUERY_SELECT ||
+      statement->GetQueryType() > QueryType::QUERY_DELETE) {
+    interpreter->AddSimpleQueryToCache(*cache_key, nullptr);
+    return nullptr;
+  }
+
+  const auto cached_statement = common::ManagedPointer(statement);
+  interpreter->AddSimpleQueryToCache(*cache_key, std::move(statement));
+  return cached_statement;
+}
+
 Transition SimpleQueryCommand::Exec(const common::ManagedPointer<ProtocolInterpreter> interpreter,
                                     const common::ManagedPointer<PostgresPacketWriter> out,
                                     const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
@@ -73,9 +145,22 @@ Transition SimpleQueryCommand::Exec(const common::ManagedPointer<ProtocolInterpr
 
   auto query_text = in_.ReadString();
 
-  auto parse_result = t_cop->ParseQuery(query_text, connection);
-
-  const auto statement = std::make_unique<network::Statement>(std::move(query_text), std::move(parse_result));
+  // Queries that differ only in their constants share a cached statement with parameters in place of the constants, so
+  // they skip parsing, optimization and codegen. Binding the cached statement again types the new constants.
+  std::string cache_key;
+  std::vector<type::TransientValue> params;
+  common::ManagedPointer<network::Statement> statement = nullptr;
+  if (t_cop->UseQueryCache()) {
+    statement = LookupSimpleQuery(postgres_interpreter, t_cop, connection, query_text, &cache_key, &params);
+  }
+  const bool cached = statement != nullptr;
+  std::unique_ptr<network::Statement> uncached_statement;
+  if (!cached) {
+    params.clear();
+    auto parse_result = t_cop->ParseQuery(query_text, connection);
+    uncached_statement = std::make_unique<network::Statement>(std::move(query_text), std::move(parse_result));
+    statement = common::ManagedPointer(uncached_statement);
+  }
 
   // Parsing a SimpleQuery clears the unnamed statement and portal
   postgres_interpreter->CloseStatement("");
@@ -128,20 +213,39 @@ Transition SimpleQueryCommand::Exec(const common::ManagedPointer<ProtocolInterpr
   }
 
   // This logic relies on ordering of values in the enum's definition and is documented there as well.
-  if (query_type >= network::QueryType::QUERY_RENAME) {
+  if (query_type >= network::QueryType::QUERY_RENAME && query_type != network::QueryType::QUERY_COPY) {
     // We don't yet support query types with values greater than this
     out->WriteNoticeResponse("NOTICE:  we don't yet support that query type.");
     out->WriteCommandComplete(query_type, 0);
   } else {
     // Try to bind the parsed statement
-    const auto bind_result = t_cop->BindQuery(connection, common::ManagedPointer(statement), nullptr);
-    if (bind_result.type_ == trafficcop::ResultType::COMPLETE) {
+    const auto bind_result =
+        t_cop->BindQuery(connection, statement, cached ? common::ManagedPointer(&params) : nullptr);
+    if (bind_result.type_ == trafficcop::ResultType::COMPLETE && query_type == network::QueryType::QUERY_COPY) {
+      // COPY plans and executes its own query, if it has one
+      const auto copy_result = t_cop->ExecuteCopyStatement(connection, out, statement);
+      if (copy_result.type_ == trafficcop::ResultType::QUEUING) {
+        // COPY ... FROM STDIN finishes the query once the client sent all of its data
+        postgres_interpreter->BeginCopyIn(statement, std::move(uncached_statement));
+        return Transition::PROCEED;
+      }
+      if (copy_result.type_ == trafficcop::ResultType::COMPLETE) {
+        TERRIER_ASSERT(std::holds_alternative<uint32_t>(copy_result.extra_), "We're expecting a row count here.");
+        out->WriteCommandComplete(query_type, std::get<uint32_t>(copy_result.extra_));
+      } else {
+        TERRIER_ASSERT(std::holds_alternative<std::string>(copy_result.extra_), "We're expecting a message here.");
+        connection->Transaction()->SetMustAbort();
+        out->WriteErrorResponse(std::get<std::string>(copy_result.extra_));
+      }
+    } else if (bind_result.type_ == trafficcop::ResultType::COMPLETE) {
       // Binding succeeded, optimize to generate a physical plan and then execute
-      auto physical_plan = t_cop->OptimizeBoundQuery(connection, statement->ParseResult());
-
-      statement->SetPhysicalPlan(std::move(physical_plan));
+      if (statement->PhysicalPlan() == nullptr) {
+        auto physical_plan = t_cop->OptimizeBoundQuery(connection, statement->ParseResult());
+        statement->SetPhysicalPlan(std::move(physical_plan));
+      }
 
-      const auto portal = std::make_unique<Portal>(common::ManagedPointer(statement));
+      const auto portal =
+          std::make_unique<Portal>(statement, std::move(params), std::vector<FieldFormat>{FieldFormat::text});
 
       if (query_type == network::QueryType::QUERY_SELECT) {
         out->WriteRowDescription(portal->PhysicalPlan()->GetOutputSchema()->GetColumns(), portal->ResultFormats());
@@ -160,18 +264,12 @@ Transition SimpleQueryCommand::Exec(const common::ManagedPointer<ProtocolInterpr
       // failing to bind fails a transaction in postgres
       connection->Transaction()->SetMustAbort();
       out->WriteErrorResponse(std::get<std::string>(bind_result.extra_));
+      // The catalog may have changed under the cached statement, start over with it next time
+      if (cached) postgres_interpreter->RemoveSimpleQueryFromCache(cache_key);
     }
   }
 
-  if (!postgres_interpreter->ExplicitTransactionBlock()) {
-    // Single statement transaction should be ended before returning
-    // decide whether the txn should be committed or aborted based on the MustAbort flag, and then end the txn
-    t_cop->EndTransaction(connection, connection->Transaction()->MustAbort() ? network::QueryType::QUERY_ROLLBACK
-                                                                             : network::QueryType::QUERY_COMMIT);
-    postgres_interpreter->ResetTransactionState();
-  }
-
-  return FinishSimpleQueryCommand(out, connection);
+  return FinishSimpleQueryStatement(postgres_interpreter, out, t_cop, connection);
 }
 
 Transition ParseCommand::Exec(const common::ManagedPointer<ProtocolInterpreter> interpreter,
@@ -502,6 +600,91 @@ Transition TerminateCommand::Exec(const common::ManagedPointer<ProtocolInterpret
   return Transition::TERMINATE;
 }
 
+Transition CopyDataCommand::Exec(const common::ManagedPointer<ProtocolInterpreter> interpreter,
+                                 const common::ManagedPointer<PostgresPacketWriter> out,
+                                 const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                                 const common::ManagedPointer<ConnectionContext> connection) {
+  const auto postgres_interpreter = interpreter.CastManagedPointerTo<network::PostgresProtocolInterpreter>();
+  TERRIER_ASSERT(postgres_interpreter->CopyingIn(),
+                 "We shouldn't be receiving CopyData outside of COPY FROM STDIN. This should have been caught at the "
+                 "protocol interpreter Process() level.");
+  // A message may hold any number of whole or partial rows, so they can only be parsed once all of them arrived
+  if (postgres_interpreter->CopyInData()->size() + in_.BytesLeft() > COPY_IN_LEN_LIMIT) {
+    return FailCopyIn(interpreter, out, t_cop, connection,
+                      "ERROR:  COPY from stdin is longer than the limit of " + std::to_string(COPY_IN_LEN_LIMIT) +
+                          " bytes");
+  }
+  postgres_interpreter->CopyInData()->append(in_.ReadString(in_.BytesLeft()));
+  return Transition::PROCEED;
+}
+
+Transition CopyDoneCommand::Exec(const common::ManagedPointer<ProtocolInterpreter> interpreter,
+                                 const common::ManagedPointer<PostgresPacketWriter> out,
+                                 const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                                 const common::ManagedPointer<ConnectionContext> connection) {
+  const auto postgres_interpreter = interpreter.CastManagedPointerTo<network::PostgresProtocolInterpreter>();
+  TERRIER_ASSERT(postgres_interpreter->CopyingIn(),
+                 "We shouldn't be receiving CopyDone outside of COPY FROM STDIN. This should have been caught at the "
+                 "protocol interpreter Process() level.");
+
+  const auto result = t_cop->ExecuteCopyFromStdin(connection, postgres_interpreter->CopyInStatement(),
+                                                  *postgres_interpreter->CopyInData());
+  postgres_interpreter->EndCopyIn();
+  if (result.type_ == trafficcop::ResultType::COMPLETE) {
+    TERRIER_ASSERT(std::holds_alternative<uint32_t>(result.extra_), "We're expecting a row count here.");
+    out->WriteCommandComplete(network::QueryType::QUERY_COPY, std::get<uint32_t>(result.extra_));
+  } else {
+    TERRIER_ASSERT(std::holds_alternative<std::string>(result.extra_), "We're expecting a message here.");
+    connection->Transaction()->SetMustAbort();
+    out->WriteErrorResponse(std::get<std::string>(result.extra_));
+  }
+
+  return FinishSimpleQueryStatement(postgres_interpreter, out, t_cop, connection);
+}
+
+Transition CopyFailCommand::Exec(const common::ManagedPointer<ProtocolInterpreter> interpreter,
+                                 const common::ManagedPointer<PostgresPacketWriter> out,
+                                 const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                                 const common::ManagedPointer<ConnectionContext> connection) {
+  const auto postgres_interpreter = interpreter.CastManagedPointerTo<network::PostgresProtocolInterpreter>();
+  TERRIER_ASSERT(postgres_interpreter->CopyingIn(),
+                 "We shouldn't be receiving CopyFail outside of COPY FROM STDIN. This should have been caught at the "
+                 "protocol interpreter Process() level.");
+
+  // The client gave up on sending its data, which fails the COPY like any other error
+  return FailCopyIn(interpreter, out, t_cop, connection, "ERROR:  COPY from stdin failed: " + in_.ReadString());
+}
+
+Transition FailCopyIn(const common::ManagedPointer<ProtocolInterpreter> interpreter,
+                      const common::ManagedPointer<PostgresPacketWriter> out,
+                      const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                      const common::ManagedPointer<ConnectionContext> connection, const std::string &message) {
+  const auto postgres_interpreter = interpreter.CastManagedPointerTo<network::PostgresProtocolInterpreter>();
+  postgres_interpreter->EndCopyIn();
+  connection->Transaction()->SetMustAbort();
+  out->WriteErrorResponse(message);
+  return FinishSimpleQueryStatement(postgres_interpreter, out, t_cop, connection);
+}
+
+Transition FailCommand(const common::ManagedPointer<ProtocolInterpreter> interpreter,
+                       const common::ManagedPointer<PostgresPacketWriter> out,
+                       const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                       const common::ManagedPointer<ConnectionContext> connection, const NetworkMessageType msg_type,
+                       const std::string &message) {
+  const auto postgres_interpreter = interpreter.CastManagedPointerTo<network::PostgresProtocolInterpreter>();
+  if (postgres_interpreter->CopyingIn()) return FailCopyIn(interpreter, out, t_cop, connection, message);
+
+  if (connection->Transaction() != nullptr) connection->Transaction()->SetMustAbort();
+  out->WriteErrorResponse(message);
+  if (msg_type == NetworkMessageType::PG_EXECUTE_COMMAND) {
+    // Like any other error in the Extended Query protocol, the client gets ReadyForQuery once it sends Sync
+    if (!postgres_interpreter->WaitingForSync()) postgres_interpreter->SetWaitingForSync();
+    return Transition::PROCEED;
+  }
+  if (connection->Transaction() == nullptr) return FinishSimpleQueryCommand(out, connection);
+  return FinishSimpleQueryStatement(postgres_interpreter, out, t_cop, connection);
+}
+
 // (Matt): this seems to only exist for testing
 Transition EmptyCommand::Exec(common::ManagedPointer<ProtocolInterpreter> interpreter,
                               common::ManagedPointer<PostgresPacketWriter> out,
@@ -30,23 +30,95 @@ Transition PostgresProtocolInterpreter::Process(common::ManagedPointer<ReadBuffe
     curr_input_packet_.Clear();
     return ProcessStartup(in, out, t_cop, context);
   }
+  const auto msg_type = curr_input_packet_.msg_type_;
+  if (CopyingIn() != (msg_type == NetworkMessageType::PG_COPY_DATA || msg_type == NetworkMessageType::PG_COPY_DONE ||
+                      msg_type == NetworkMessageType::PG_COPY_FAIL)) {
+    // No command reads the packet's contents, so skip past them
+    curr_input_packet_.buf_->Skip(curr_input_packet_.len_);
+    curr_input_packet_.Clear();
+    // Like Postgres, ignore the rest of the data of a COPY ... FROM STDIN that already failed
+    if (!CopyingIn()) return Transition::PROCEED;
+
+    // Like Postgres, fail a COPY ... FROM STDIN that the client interrupts with any other message. The message itself
+    // is discarded, but Terminate still closes the connection.
+    out->ForceFlush();
+    PostgresPacketWriter writer(out);
+    const Transition ret =
+        FailCopyIn(common::ManagedPointer<ProtocolInterpreter>(this), common::ManagedPointer(&writer), t_cop, context,
+                   std::string("ERROR:  unexpected message type '") + static_cast<char>(msg_type) +
+                       "' during COPY from stdin");
+    return msg_type == NetworkMessageType::PG_TERMINATE_COMMAND ? Transition::TERMINATE : ret;
+  }
+
   auto command = command_factory_->PacketToCommand(common::ManagedPointer<InputPacket>(&curr_input_packet_));
   PostgresPacketWriter writer(out);
   if (command->FlushOnComplete()) out->ForceFlush();
 
-  if (WaitingForSync() && curr_input_packet_.msg_type_ != NetworkMessageType::PG_SYNC_COMMAND) {
+  if (WaitingForSync() && msg_type != NetworkMessageType::PG_SYNC_COMMAND) {
     // When an error is detected while processing any Extended Query message, the backend issues ErrorResponse, then
     // reads and discards messages until a Sync is reached
     curr_input_packet_.Clear();
     return Transition::PROCEED;
   }
 
+  // Only commands that run queries through the traffic cop are worth handing off, everything else is cheap enough to
+  // finish on this thread
+  if (query_workers_ != DISABLED &&
+      (msg_type == NetworkMessageType::PG_SIMPLE_QUERY_COMMAND || msg_type == NetworkMessageType::PG_EXECUTE_COMMAND ||
+       msg_type == NetworkMessageType::PG_COPY_DONE)) {
+    return ExecOnQueryWorker(std::move(command), msg_type, out, t_cop, context);
+  }
+
   const Transition ret = command->Exec(common::ManagedPointer<ProtocolInterpreter>(this),
                                        common::ManagedPointer<PostgresPacketWriter>(&writer), t_cop, context);
+  // CopyData doesn't get a reply unless it failed the COPY
+  if (msg_type == NetworkMessageType::PG_COPY_DATA && !CopyingIn()) out->ForceFlush();
   curr_input_packet_.Clear();
   return ret;
 }
 
+Transition PostgresProtocolInterpreter::ExecOnQueryWorker(std::unique_ptr<PostgresNetworkCommand> command,
+                                                          const NetworkMessageType msg_type,
+                                                          const common::ManagedPointer<WriteQueue> out,
+                                                          const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                                                          const common::ManagedPointer<ConnectionContext> context) {
+  TERRIER_ASSERT(async_command_ == nullptr, "Only one command per connection can be executing at a time.");
+  TERRIER_ASSERT(context->Callback() != nullptr, "Need a callback to wake the connection back up.");
+  async_command_ = std::move(command);
+  // The ConnectionHandle does not touch the ReadBuffer, WriteQueue or this interpreter until the callback fires, so
+  // the worker has exclusive access to them for the duration of the task. Nothing may escape the task, or the
+  // connection would never be woken back up.
+  query_workers_->SubmitTask([this, msg_type, out, t_cop, context] {
+    PostgresPacketWriter writer(out);
+    const auto fail = [&](const std::string &message) {
+      try {
+        async_result_ = FailCommand(common::ManagedPointer<ProtocolInterpreter>(this),
+                                    common::ManagedPointer<PostgresPacketWriter>(&writer), t_cop, context, msg_type,
+                                    "ERROR:  " + message);
+      } catch (...) {
+        NETWORK_LOG_ERROR("Encountered an exception when failing a query, closing the connection");
+        async_result_ = Transition::TERMINATE;
+      }
+    };
+    try {
+      async_result_ = async_command_->Exec(common::ManagedPointer<ProtocolInterpreter>(this),
+                                           common::ManagedPointer<PostgresPacketWriter>(&writer), t_cop, context);
+    } catch (NetworkProcessException &e) {
+      NETWORK_LOG_ERROR("{0}\n", e.what());
+      async_result_ = Transition::TERMINATE;
+    } catch (std::exception &e) {
+      NETWORK_LOG_ERROR("Encountered exception {0} when executing a query", e.what());
+      fail(e.what());
+    } catch (...) {
+      NETWORK_LOG_ERROR("Encountered an unknown exception when executing a query");
+      fail("unknown error while executing the query");
+    }
+    curr_input_packet_.Clear();
+    context->Callback()(context->CallbackArg());
+  });
+  return Transition::NEED_RESULT;
+}
+
 Transition PostgresProtocolInterpreter::ProcessStartup(const common::ManagedPointer<ReadBuffer> in,
                                                        const common::ManagedPointer<WriteQueue> out,
                                                        const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
@@ -0,0 +1,208 @@
+#include "optimizer/join_order_enumerator.h"
+
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "common/macros.h"
+
+namespace terrier::optimizer {
+
+// Set of relations whose index is at most the given one
+static JoinOrderEnumerator::RelationSet UpTo(const uint32_t index) {
+  return index + 1 == JoinOrderEnumerator::MAX_RELATIONS ? ~JoinOrderEnumerator::RelationSet{0}
+                                                          : (JoinOrderEnumerator::RelationSet{1} << (index + 1)) - 1;
+}
+
+// Non-empty subsets of a set in increasing order, starting from 0 and ending with 0 after the whole set
+static JoinOrderEnumerator::RelationSet NextSubset(const JoinOrderEnumerator::RelationSet subset,
+                                                  const JoinOrderEnumerator::RelationSet set) {
+  return (subset - set) & set;
+}
+
+static uint32_t LowestRelation(const JoinOrderEnumerator::RelationSet relations) {
+  return static_cast<uint32_t>(__builtin_ctzll(relations));
+}
+
+static uint32_t HighestRelation(const JoinOrderEnumerator::RelationSet relations) {
+  return static_cast<uint32_t>(63 - __builtin_clzll(relations));
+}
+
+JoinOrderEnumerator::JoinOrderEnumerator(std::vector<double> cardinalities)
+    : cardinalities_(std::move(cardinalities)), neighbors_(cardinalities_.size(), 0) {
+  TERRIER_ASSERT(!cardinalities_.empty() && cardinalities_.size() <= MAX_RELATIONS, "Unsupported number of relations.");
+}
+
+void JoinOrderEnumerator::AddPredicate(const RelationSet relations, const double selectivity) {
+  TERRIER_ASSERT((relations & ~AllRelations()) == 0, "Predicate refers to unknown relations.");
+  predicates_.emplace_back(relations, selectivity);
+  // A predicate over more than two relations makes each of them a neighbor of the others
+  if (__builtin_popcountll(relations) < 2) return;
+  for (RelationSet rest = relations; rest != 0; rest &= rest - 1) {
+    const uint32_t relation = LowestRelation(rest);
+    neighbors_[relation] |= relations & ~(RelationSet{1} << relation);
+  }
+}
+
+bool JoinOrderEnumerator::Enumerate() {
+  dp_table_.clear();
+  greedy_trees_.clear();
+  if (cardinalities_.size() <= MAX_DP_RELATIONS && IsConnected()) {
+    EnumerateDP();
+    return true;
+  }
+  EnumerateGreedy();
+  return false;
+}
+
+bool JoinOrderEnumerator::IsConnected() const {
+  RelationSet reached = 1;
+  RelationSet frontier = 1;
+  while (frontier != 0) {
+    frontier = Neighborhood(reached) & ~reached;
+    reached |= frontier;
+  }
+  return reached == AllRelations();
+}
+
+const JoinOrderEnumerator::JoinTree &JoinOrderEnumerator::GetJoinTree(const RelationSet relations) const {
+  if (!dp_table_.empty()) {
+    TERRIER_ASSERT(relations < dp_table_.size() && dp_table_[relations].cost_ < std::numeric_limits<double>::infinity(),
+                   "No join tree was enumerated for these relations.");
+    return dp_table_[relations];
+  }
+  TERRIER_ASSERT(greedy_trees_.count(relations) != 0, "No join tree was enumerated for these relations.");
+  return greedy_trees_.at(relations);
+}
+
+JoinOrderEnumerator::RelationSet JoinOrderEnumerator::Neighborhood(const RelationSet relations) const {
+  RelationSet neighborhood = 0;
+  for (RelationSet rest = relations; rest != 0; rest &= rest - 1) neighborhood |= neighbors_[LowestRelation(rest)];
+  return neighborhood & ~relations;
+}
+
+double JoinOrderEnumerator::Cardinality(const RelationSet relations) const {
+  double cardinality = 1.0;
+  for (RelationSet rest = relations; rest != 0; rest &= rest - 1) cardinality *= cardinalities_[LowestRelation(rest)];
+  for (const auto &predicate : predicates_) {
+    if (predicate.first != 0 && (predicate.first & ~relations) == 0) cardinality *= predicate.second;
+  }
+  return cardinality;
+}
+
+//===--------------------------------------------------------------------===//
+// DPccp
+//
+// Moerkotte and Neumann, "Analysis of Two Existing and One New Dynamic Programming Algorithm for the Generation of
+// Optimal Bushy Join Trees without Cross Products", VLDB 2006. Every pair of a connected subgraph (csg) and a connected
+// complement (cmp) that is joined by an edge is emitted exactly once, and only after both sides have been emitted
+// themselves.
+//===--------------------------------------------------------------------===//
+
+void JoinOrderEnumerator::EnumerateDP() {
+  const auto num_relations = static_cast<uint32_t>(cardinalities_.size());
+  dp_table_.assign(RelationSet{1} << num_relations,
+                   {std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(), 0, 0});
+  for (uint32_t i = 0; i < num_relations; i++) {
+    const RelationSet relation = RelationSet{1} << i;
+    dp_table_[relation] = {Cardinality(relation), 0, 0, 0};
+  }
+
+  for (uint32_t i = num_relations; i-- > 0;) {
+    const RelationSet relation = RelationSet{1} << i;
+    EmitCsg(relation);
+    EnumerateCsgRec(relation, UpTo(i));
+  }
+}
+
+void JoinOrderEnumerator::EnumerateCsgRec(const RelationSet csg, const RelationSet excluded) {
+  const RelationSet neighborhood = Neighborhood(csg) & ~excluded;
+  if (neighborhood == 0) return;
+  for (RelationSet subset = NextSubset(0, neighborhood); subset != 0; subset = NextSubset(subset, neighborhood)) {
+    EmitCsg(csg | subset);
+  }
+  for (RelationSet subset = NextSubset(0, neighborhood); subset != 0; subset = NextSubset(subset, neighborhood)) {
+    EnumerateCsgRec(csg | subset, excluded | neighborhood);
+  }
+}
+
+void JoinOrderEnumerator::EmitCsg(const RelationSet csg) {
+  const RelationSet excluded = csg | UpTo(LowestRelation(csg));
+  const RelationSet neighborhood = Neighborhood(csg) & ~excluded;
+  for (RelationSet rest = neighborhood; rest != 0;) {
+    const uint32_t i = HighestRelation(rest);
+    const RelationSet relation = RelationSet{1} << i;
+    rest &= ~relation;
+    EmitCsgCmp(csg, relation);
+    EnumerateCmpRec(csg, relation, excluded | (UpTo(i) & neighborhood));
+  }
+}
+
+void JoinOrderEnumerator::EnumerateCmpRec(const RelationSet csg, const RelationSet cmp, const RelationSet excluded) {
+  const RelationSet neighborhood = Neighborhood(cmp) & ~excluded;
+  if (neighborhood == 0) return;
+  for (RelationSet subset = NextSubset(0, neighborhood); subset != 0; subset = NextSubset(subset, neighborhood)) {
+    EmitCsgCmp(csg, cmp | subset);
+  }
+  for (RelationSet subset = NextSubset(0, neighborhood); subset != 0; subset = NextSubset(subset, neighborhood)) {
+    EnumerateCmpRec(csg, cmp | subset, excluded | neighborhood);
+  }
+}
+
+void JoinOrderEnumerator::EmitCsgCmp(const RelationSet csg, const RelationSet cmp) {
+  const JoinTree &left = dp_table_[csg];
+  const JoinTree &right = dp_table_[cmp];
+  TERRIER_ASSERT(left.cost_ != std::numeric_limits<double>::infinity() &&
+                     right.cost_ != std::numeric_limits<double>::infinity(),
+                 "Both sides of a join should have been enumerated before the join.");
+  JoinTree &tree = dp_table_[csg | cmp];
+  // The cardinality of a set of relations is the same for all of its join trees, so compute it on the first one
+  if (tree.left_ == 0) tree.cardinality_ = Cardinality(csg | cmp);
+  const double cost = tree.cardinality_ + left.cost_ + right.cost_;
+  if (cost < tree.cost_) tree = {tree.cardinality_, cost, csg, cmp};
+}
+
+//===--------------------------------------------------------------------===//
+// GOO
+//
+// Fegaras, "A New Heuristic for Optimizing Large Queries", DEXA 1998
+//===--------------------------------------------------------------------===//
+
+void JoinOrderEnumerator::EnumerateGreedy() {
+  std::vector<RelationSet> forest;
+  forest.reserve(cardinalities_.size());
+  for (uint32_t i = 0; i < cardinalities_.size(); i++) {
+    const RelationSet relation = RelationSet{1} << i;
+    forest.emplace_back(relation);
+    greedy_trees_[relation] = {Cardinality(relation), 0, 0, 0};
+  }
+
+  while (forest.size() > 1) {
+    size_t best_left = 0;
+    size_t best_right = 1;
+    bool best_connected = false;
+    double best_cardinality = std::numeric_limits<double>::infinity();
+    for (size_t left = 0; left < forest.size(); left++) {
+      for (size_t right = left + 1; right < forest.size(); right++) {
+        const bool connected = (Neighborhood(forest[left]) & forest[right]) != 0;
+        const double cardinality = Cardinality(forest[left] | forest[right]);
+        // Cross products only when there is nothing else left to join
+        if ((connected && !best_connected) || (connected == best_connected && cardinality < best_cardinality)) {
+          best_left = left;
+          best_right = right;
+          best_connected = connected;
+          best_cardinality = cardinality;
+        }
+      }
+    }
+
+    const RelationSet left = forest[best_left];
+    const RelationSet right = forest[best_right];
+    const double cost = best_cardinality + greedy_trees_[left].cost_ + greedy_trees_[right].cost_;
+    greedy_trees_[left | right] = {best_cardinality, cost, left, right};
+    forest[best_left] = left | right;
+    forest.erase(forest.begin() + best_right);
+  }
+}
+
+}  // namespace terrier::optimizer
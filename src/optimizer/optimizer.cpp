@@ -1,11 +1,11 @@
 #include "optimizer/optimizer.h"
 
+#include <chrono>  // NOLINT
 #include <memory>
 #include <utility>
 #include <vector>
 
 #include "common/exception.h"
-#include "common/scoped_timer.h"
 #include "optimizer/binding.h"
 #include "optimizer/input_column_deriver.h"
 #include "optimizer/operator_visitor.h"
@@ -118,7 +118,16 @@ std::unique_ptr<planner::AbstractPlanNode> Optimizer::ChooseBestPlan(
 
 void Optimizer::OptimizeLoop(group_id_t root_group_id, PropertySet *required_props) {
   auto root_context = new OptimizationContext(context_.get(), required_props->Copy());
-  auto task_stack = new OptimizerTaskStack();
+  // Independent inputs of an expression are optimized on the shared workers, if there are any
+  OptimizerTaskPool *task_stack;
+  if (workers_ != DISABLED && workers_->NumWorkers() > 0) {
+    auto *parallel_pool = new ParallelOptimizerTaskPool(workers_);
+    parallel_pool->SetTimeoutCheck(
+        [this, root_group_id, root_context] { return TaskExecutionTimedOut(root_group_id, root_context); });
+    task_stack = parallel_pool;
+  } else {
+    task_stack = new OptimizerTaskStack();
+  }
   context_->SetTaskPool(task_stack);
   context_->AddOptimizationContext(root_context);
 
@@ -131,35 +140,39 @@ void Optimizer::OptimizeLoop(group_id_t root_group_id, PropertySet *required_pro
   Memo &memo = context_->GetMemo();
   task_stack->Push(new OptimizeGroup(memo.GetGroupByID(root_group_id), root_context));
 
+  // Reorder the joins by the cardinalities of the stats derived below, before any exploration
+  task_stack->Push(new ReorderJoins(root_group_id, root_context));
+
   // Derive stats for the only one logical expression before optimizing
   task_stack->Push(new DeriveStats(memo.GetGroupByID(root_group_id)->GetLogicalExpression(), ExprSet{}, root_context));
   ExecuteTaskStack(task_stack, root_group_id, root_context);
 }
 
-void Optimizer::ExecuteTaskStack(OptimizerTaskStack *task_stack, group_id_t root_group_id,
+void Optimizer::ExecuteTaskStack(OptimizerTaskPool *task_stack, group_id_t root_group_id,
                                  OptimizationContext *root_context) {
-  auto root_group = context_->GetMemo().GetGroupByID(root_group_id);
-  const auto &required_props = root_context->GetRequiredProperties();
-
-  uint64_t elapsed_time = 0;
+  task_stack_start_ = std::chrono::steady_clock::now();
 
   // Iterate through the task stack
   while (!task_stack->Empty()) {
     // Check to see if we have at least one plan, and if we have exceeded our
     // timeout limit
-    if (elapsed_time >= task_execution_timeout_ && root_group->HasExpressions(required_props)) {
+    if (TaskExecutionTimedOut(root_group_id, root_context)) {
       throw OPTIMIZER_EXCEPTION("Optimizer task execution timed out");
     }
 
-    uint64_t task_runtime = 0;
     auto task = task_stack->Pop();
-    {
-      common::ScopedTimer<std::chrono::milliseconds> timer(&task_runtime);
-      task->Execute();
-    }
+    task->Execute();
     delete task;
-    elapsed_time += task_runtime;
   }
 }
 
+bool Optimizer::TaskExecutionTimedOut(group_id_t root_group_id, OptimizationContext *root_context) const {
+  const auto elapsed_time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() -
+                                                                                  task_stack_start_);
+  if (static_cast<uint64_t>(elapsed_time.count()) < task_execution_timeout_) return false;
+  // Forks never touch the root group, which is waiting for them
+  auto root_group = context_->GetMemo().GetGroupByID(root_group_id);
+  return root_group->HasExpressions(root_context->GetRequiredProperties());
+}
+
 }  // namespace terrier::optimizer
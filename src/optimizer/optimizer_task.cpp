@@ -1,13 +1,18 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "loggers/optimizer_logger.h"
 #include "optimizer/binding.h"
 #include "optimizer/child_property_deriver.h"
+#include "optimizer/join_order_enumerator.h"
+#include "optimizer/logical_operators.h"
 #include "optimizer/optimizer_context.h"
 #include "optimizer/optimizer_task.h"
+#include "optimizer/optimizer_task_pool.h"
 #include "optimizer/property_enforcer.h"
 #include "optimizer/statistics/child_stats_deriver.h"
 #include "optimizer/statistics/stats_calculator.h"
@@ -238,6 +243,17 @@ void DeriveStats::Execute() {
 //===--------------------------------------------------------------------===//
 // OptimizeExpressionCostWithEnforcedProperty
 //===--------------------------------------------------------------------===//
+// Adds a group and all the groups below it to the set
+static void CollectGroups(const Memo &memo, const group_id_t group_id, std::unordered_set<group_id_t> *const groups) {
+  if (!groups->insert(group_id).second) return;
+  auto group = memo.GetGroupByID(group_id);
+  for (const auto *exprs : {&group->GetLogicalExpressions(), &group->GetPhysicalExpressions()}) {
+    for (const auto expr : *exprs) {
+      for (const auto child_group_id : expr->GetChildGroupIDs()) CollectGroups(memo, child_group_id, groups);
+    }
+  }
+}
+
 void OptimizeExpressionCostWithEnforcedProperty::Execute() {
   // Init logic: only run once per task
   OPTIMIZER_LOG_TRACE("OptimizeExpressionCostWithEnforcedProperty::Execute() ");
@@ -275,8 +291,13 @@ void OptimizeExpressionCostWithEnforcedProperty::Execute() {
       // Compute the cost of the root operator
       // 1. Collect stats needed and cache them in the group
       // 2. Calculate cost based on children's stats
-      cur_total_cost_ += context_->GetOptimizerContext()->GetCostModel()->CalculateCost(
-          context_->GetOptimizerContext()->GetTxn(), &context_->GetOptimizerContext()->GetMemo(), group_expr_);
+      cur_total_cost_ += context_->GetOptimizerContext()->CalculateCost(group_expr_);
+
+      // Optimize the inputs that are joins themselves on other threads before costing them one by one
+      if (forked_prop_pair_idx_ != cur_prop_pair_idx_) {
+        forked_prop_pair_idx_ = cur_prop_pair_idx_;
+        OptimizeInputsInParallel(input_props);
+      }
     }
 
     for (; cur_child_idx_ < static_cast<int>(group_expr_->GetChildrenGroupsSize()); cur_child_idx_++) {
@@ -347,9 +368,7 @@ void OptimizeExpressionCostWithEnforcedProperty::Execute() {
           // Cost the enforced expression
           auto extended_prop_set = output_prop->Copy();
           extended_prop_set->AddProperty(prop->Copy());
-          cur_total_cost_ += context_->GetOptimizerContext()->GetCostModel()->CalculateCost(
-              context_->GetOptimizerContext()->GetTxn(), &context_->GetOptimizerContext()->GetMemo(),
-              memo_enforced_expr);
+          cur_total_cost_ += context_->GetOptimizerContext()->CalculateCost(memo_enforced_expr);
 
           // Update hash tables for group and group expression
           memo_enforced_expr->SetLocalHashTable(extended_prop_set, {pre_output_prop_set}, cur_total_cost_);
@@ -377,6 +396,41 @@ void OptimizeExpressionCostWithEnforcedProperty::Execute() {
   }
 }
 
+void OptimizeExpressionCostWithEnforcedProperty::OptimizeInputsInParallel(
+    const std::vector<PropertySet *> &input_props) {
+  auto optimizer_context = context_->GetOptimizerContext();
+  if (optimizer_context->GetTaskPool()->NumThreads() < 2) return;
+
+  // Base tables are quick to optimize on this thread. Inputs that share groups with an earlier one are optimized one by
+  // one later, because tasks on different threads must not touch the same groups.
+  std::vector<size_t> parallel_inputs;
+  std::unordered_set<group_id_t> groups;
+  for (size_t child_idx = 0; child_idx < group_expr_->GetChildrenGroupsSize(); child_idx++) {
+    auto child_group_id = group_expr_->GetChildGroupId(static_cast<int>(child_idx));
+    auto child_group = GetMemo().GetGroupByID(child_group_id);
+    if (child_group->GetTableAliases().size() < 2 || child_group->GetBestExpression(input_props[child_idx]) != nullptr)
+      continue;
+    std::unordered_set<group_id_t> child_groups;
+    CollectGroups(GetMemo(), child_group_id, &child_groups);
+    if (std::any_of(child_groups.begin(), child_groups.end(), [&](auto id) { return groups.count(id) != 0; })) continue;
+    groups.insert(child_groups.begin(), child_groups.end());
+    parallel_inputs.emplace_back(child_idx);
+  }
+  if (parallel_inputs.size() < 2) return;
+
+  // Each input only knows the cost left for all of them, so the bound is looser than when costing them one by one
+  std::vector<OptimizerTask *> tasks;
+  for (const auto child_idx : parallel_inputs) {
+    auto child_group = GetMemo().GetGroupByID(group_expr_->GetChildGroupId(static_cast<int>(child_idx)));
+    auto cost_high = context_->GetCostUpperBound() - cur_total_cost_;
+    auto ctx = new OptimizationContext(optimizer_context, input_props[child_idx]->Copy(), cost_high);
+    optimizer_context->AddOptimizationContext(ctx);
+    tasks.emplace_back(new OptimizeGroup(child_group, ctx));
+  }
+  OPTIMIZER_LOG_TRACE("Optimizing {0} inputs of group {1} in parallel", tasks.size(), group_expr_->GetGroupID());
+  optimizer_context->GetTaskPool()->ExecuteIndependentTasks(std::move(tasks));
+}
+
 void TopDownRewrite::Execute() {
   std::vector<RuleWithPromise> valid_rules;
 
@@ -473,4 +527,148 @@ void BottomUpRewrite::Execute() {
   }
 }
 
+//===--------------------------------------------------------------------===//
+// ReorderJoins
+//===--------------------------------------------------------------------===//
+
+// Selectivity assumed for join predicates other than equalities between the columns of two relations
+static constexpr double DEFAULT_JOIN_PREDICATE_SELECTIVITY = 0.1;
+
+// An equality between the columns of two relations is assumed to match each row of the smaller relation once, the same
+// as StatsCalculator assumes for a join
+static double JoinPredicateSelectivity(const AnnotatedExpression &predicate, const uint64_t relations,
+                                       const std::vector<double> &cardinalities) {
+  const auto expr = predicate.GetExpr();
+  if (__builtin_popcountll(relations) == 2 && expr->GetExpressionType() == parser::ExpressionType::COMPARE_EQUAL &&
+      expr->GetChild(0)->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE &&
+      expr->GetChild(1)->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE) {
+    const double left_rows = cardinalities[__builtin_ctzll(relations)];
+    const double right_rows = cardinalities[63 - __builtin_clzll(relations)];
+    return 1.0 / std::max(left_rows, right_rows);
+  }
+  return DEFAULT_JOIN_PREDICATE_SELECTIVITY;
+}
+
+static std::unique_ptr<OperatorNode> MakeInnerJoin(const group_id_t left, const group_id_t right,
+                                                   std::vector<AnnotatedExpression> predicates) {
+  std::vector<std::unique_ptr<OperatorNode>> children;
+  children.emplace_back(
+      std::make_unique<OperatorNode>(LeafOperator::Make(left), std::vector<std::unique_ptr<OperatorNode>>{}));
+  children.emplace_back(
+      std::make_unique<OperatorNode>(LeafOperator::Make(right), std::vector<std::unique_ptr<OperatorNode>>{}));
+  return std::make_unique<OperatorNode>(LogicalInnerJoin::Make(std::move(predicates)), std::move(children));
+}
+
+void ReorderJoins::Execute() {
+  OPTIMIZER_LOG_TRACE("ReorderJoins::Execute() group {0}", group_id_);
+  auto gexpr = GetMemo().GetGroupByID(group_id_)->GetLogicalExpression();
+  if (gexpr->Op().GetType() != OpType::LOGICALINNERJOIN) {
+    for (const auto child_group_id : gexpr->GetChildGroupIDs()) PushTask(new ReorderJoins(child_group_id, context_));
+    return;
+  }
+
+  std::vector<group_id_t> relations;
+  std::vector<AnnotatedExpression> predicates;
+  CollectJoins(group_id_, &relations, &predicates);
+
+  // Joins below the relations, e.g. in derived tables, are reordered on their own
+  for (const auto relation : relations) PushTask(new ReorderJoins(relation, context_));
+  if (relations.size() > JoinOrderEnumerator::MAX_RELATIONS) return;
+
+  std::vector<double> cardinalities;
+  cardinalities.reserve(relations.size());
+  for (const auto relation : relations) {
+    // Relations without stats, or estimated to be empty, still need to be told apart by the predicates joining them
+    cardinalities.emplace_back(std::max(GetMemo().GetGroupByID(relation)->GetNumRows(), 1));
+  }
+
+  JoinOrderEnumerator enumerator(cardinalities);
+  std::vector<uint64_t> predicate_relations;
+  predicate_relations.reserve(predicates.size());
+  for (const auto &predicate : predicates) {
+    uint64_t predicate_relation_set = 0;
+    for (const auto &alias : predicate.GetTableAliasSet()) {
+      uint32_t i = 0;
+      while (i < relations.size() && GetMemo().GetGroupByID(relations[i])->GetTableAliases().count(alias) == 0) i++;
+      // The predicate refers to an outer query, so leave these joins to the join rules
+      if (i == relations.size()) return;
+      predicate_relation_set |= uint64_t{1} << i;
+    }
+    predicate_relations.emplace_back(predicate_relation_set);
+    enumerator.AddPredicate(predicate_relation_set,
+                            JoinPredicateSelectivity(predicate, predicate_relation_set, cardinalities));
+  }
+
+  UNUSED_ATTRIBUTE const bool exhaustive = enumerator.Enumerate();
+  OPTIMIZER_LOG_DEBUG("Reordering {0} joined relations {1}", relations.size(),
+                      exhaustive ? "exhaustively" : "greedily");
+
+  std::vector<bool> applied(predicates.size(), false);
+  RecordJoinTree(enumerator, enumerator.AllRelations(), relations, predicates, predicate_relations, &applied,
+                 group_id_);
+
+  // The joins were just recorded, so they and their new groups still need stats
+  PushTask(new DeriveStats(GetMemo().GetGroupByID(group_id_)->GetLogicalExpressions()[0], ExprSet{}, context_));
+}
+
+void ReorderJoins::CollectJoins(const group_id_t group_id, std::vector<group_id_t> *const relations,
+                                std::vector<AnnotatedExpression> *const predicates) const {
+  auto gexpr = GetMemo().GetGroupByID(group_id)->GetLogicalExpression();
+  if (gexpr->Op().GetType() != OpType::LOGICALINNERJOIN) {
+    relations->emplace_back(group_id);
+    return;
+  }
+
+  const auto &join_predicates = gexpr->Op().As<LogicalInnerJoin>()->GetJoinPredicates();
+  predicates->insert(predicates->end(), join_predicates.begin(), join_predicates.end());
+  for (const auto child_group_id : gexpr->GetChildGroupIDs()) CollectJoins(child_group_id, relations, predicates);
+}
+
+group_id_t ReorderJoins::RecordJoinTree(const JoinOrderEnumerator &enumerator, const uint64_t relation_set,
+                                        const std::vector<group_id_t> &relations,
+                                        const std::vector<AnnotatedExpression> &predicates,
+                                        const std::vector<uint64_t> &predicate_relations,
+                                        std::vector<bool> *const applied, const group_id_t target_group) {
+  if ((relation_set & (relation_set - 1)) == 0) return relations[__builtin_ctzll(relation_set)];
+
+  const auto &tree = enumerator.GetJoinTree(relation_set);
+  const auto left = RecordJoinTree(enumerator, tree.left_, relations, predicates, predicate_relations, applied,
+                                   UNDEFINED_GROUP);
+  const auto right = RecordJoinTree(enumerator, tree.right_, relations, predicates, predicate_relations, applied,
+                                    UNDEFINED_GROUP);
+
+  // Each predicate is applied by the lowest join of all of its relations
+  std::vector<AnnotatedExpression> join_predicates;
+  for (size_t i = 0; i < predicates.size(); i++) {
+    if ((*applied)[i] || (predicate_relations[i] & ~relation_set) != 0) continue;
+    join_predicates.emplace_back(predicates[i]);
+    (*applied)[i] = true;
+  }
+
+  auto optimizer_context = context_->GetOptimizerContext();
+  GroupExpression *gexpr = nullptr;
+  const auto join = MakeInnerJoin(left, right, join_predicates);
+  if (target_group == UNDEFINED_GROUP) {
+    optimizer_context->RecordOperatorNodeIntoGroup(common::ManagedPointer(join), &gexpr);
+  } else {
+    optimizer_context->ReplaceRewriteExpression(common::ManagedPointer(join), target_group);
+    gexpr = GetMemo().GetGroupByID(target_group)->GetLogicalExpression();
+  }
+
+  // The commuted join lets the cost model pick the sides of the physical join
+  GroupExpression *commuted_gexpr = nullptr;
+  const auto commuted_join = MakeInnerJoin(right, left, std::move(join_predicates));
+  optimizer_context->RecordOperatorNodeIntoGroup(common::ManagedPointer(commuted_join), &commuted_gexpr,
+                                                 gexpr->GetGroupID());
+
+  // The join rules would only enumerate join orders all over again
+  for (auto *rule : GetRuleSet().GetRulesByName(RuleSetName::LOGICAL_TRANSFORMATION)) {
+    if (rule->GetType() == RuleType::INNER_JOIN_COMMUTE || rule->GetType() == RuleType::INNER_JOIN_ASSOCIATE) {
+      gexpr->SetRuleExplored(rule);
+      commuted_gexpr->SetRuleExplored(rule);
+    }
+  }
+  return gexpr->GetGroupID();
+}
+
 }  // namespace terrier::optimizer
@@ -0,0 +1,112 @@
+#include "optimizer/optimizer_task_pool.h"
+
+#include <condition_variable>  // NOLINT
+#include <exception>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "common/exception.h"
+
+namespace terrier::optimizer {
+
+// Pool and stack of the forked task that this thread is executing, if any
+static thread_local ParallelOptimizerTaskPool *forked_pool = nullptr;
+static thread_local OptimizerTaskStack *forked_stack = nullptr;
+
+namespace {
+
+// Tasks of one call to ExecuteIndependentTasks, shared by the forking thread and its helpers
+struct Fork {
+  explicit Fork(std::vector<OptimizerTask *> forked_tasks)
+      : tasks(std::move(forked_tasks)), errors(tasks.size()), next_task(0) {}
+
+  std::vector<OptimizerTask *> tasks;
+  std::vector<std::exception_ptr> errors;
+  std::atomic<size_t> next_task;
+  // Helpers executing tasks of the fork. Helpers count themselves before they claim a task, so the forking thread
+  // only waits for those that claimed one.
+  std::mutex mutex;
+  std::condition_variable helpers_done;
+  uint32_t num_running_helpers = 0;
+};
+
+}  // namespace
+
+OptimizerTaskStack *ParallelOptimizerTaskPool::CurrentStack() {
+  return forked_pool == this ? forked_stack : &root_stack_;
+}
+
+void ParallelOptimizerTaskPool::ExecuteIndependentTasks(std::vector<OptimizerTask *> tasks) {
+  auto fork = std::make_shared<Fork>(std::move(tasks));
+  const auto execute_tasks = [this](Fork *const fork) {
+    for (size_t i = fork->next_task++; i < fork->tasks.size(); i = fork->next_task++) {
+      try {
+        ExecuteForkedTask(fork->tasks[i]);
+      } catch (...) {
+        fork->errors[i] = std::current_exception();
+      }
+    }
+  };
+
+  // Claim helpers for all the tasks but the one this thread takes, as long as the workers have threads to spare
+  const uint32_t num_workers = workers_->NumWorkers();
+  for (size_t i = 1; i < fork->tasks.size(); i++) {
+    uint32_t num_helpers = num_helpers_->load();
+    while (num_helpers < num_workers && !num_helpers_->compare_exchange_weak(num_helpers, num_helpers + 1)) {
+    }
+    if (num_helpers >= num_workers) break;
+    workers_->SubmitTask([fork, execute_tasks, num_helpers = num_helpers_] {
+      {
+        std::lock_guard<std::mutex> guard(fork->mutex);
+        fork->num_running_helpers++;
+      }
+      execute_tasks(fork.get());
+      {
+        std::lock_guard<std::mutex> guard(fork->mutex);
+        fork->num_running_helpers--;
+        fork->helpers_done.notify_all();
+      }
+      (*num_helpers)--;
+    });
+  }
+
+  execute_tasks(fork.get());
+  {
+    std::unique_lock<std::mutex> lock(fork->mutex);
+    fork->helpers_done.wait(lock, [&] { return fork->num_running_helpers == 0; });
+  }
+  for (const auto &error : fork->errors) {
+    if (error != nullptr) std::rethrow_exception(error);
+  }
+}
+
+void ParallelOptimizerTaskPool::ExecuteForkedTask(OptimizerTask *const task) {
+  OptimizerTaskStack stack;
+  stack.Push(task);
+
+  // This thread may have forked the task from another forked task, whose stack it gets back afterwards
+  auto *const outer_pool = forked_pool;
+  auto *const outer_stack = forked_stack;
+  forked_pool = this;
+  forked_stack = &stack;
+  try {
+    while (!stack.Empty()) {
+      // The remaining tasks are deleted with the stack
+      if (timed_out_ && timed_out_()) {
+        throw OPTIMIZER_EXCEPTION("Optimizer task execution timed out");
+      }
+      std::unique_ptr<OptimizerTask> next(stack.Pop());
+      next->Execute();
+    }
+  } catch (...) {
+    forked_pool = outer_pool;
+    forked_stack = outer_stack;
+    throw;
+  }
+  forked_pool = outer_pool;
+  forked_stack = outer_stack;
+}
+
+}  // namespace terrier::optimizer
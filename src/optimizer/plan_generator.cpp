@@ -9,6 +9,7 @@
 
 #include "catalog/catalog_accessor.h"
 #include "common/exception.h"
+#include "optimizer/index_util.h"
 #include "optimizer/operator_node.h"
 #include "optimizer/properties.h"
 #include "optimizer/property_set.h"
@@ -216,6 +217,14 @@ void PlanGenerator::Visit(const IndexScan *op) {
   // An IndexScan (for now at least) will output all columns of its table
   std::vector<catalog::col_oid_t> column_ids = GenerateColumnsForScan(predicate);
 
+  // When the index has every column the scan needs, read them from the index keys and skip fetching the tuples.
+  // Updates and deletes need the tuples, and descending scans cannot hand out their keys.
+  auto type = op->GetIndexScanType();
+  bool covering_scan = !op->GetIsForUpdate() && type != planner::IndexScanType::Descending &&
+                       type != planner::IndexScanType::DescendingLimit &&
+                       accessor_->GetIndex(op->GetIndexOID())->SupportsKeyRetrieval() &&
+                       IndexUtil::CoversColumns(accessor_, tbl_oid, op->GetIndexOID(), column_ids);
+
   auto builder = planner::IndexScanPlanNode::Builder();
   builder.SetOutputSchema(std::move(output_schema));
   builder.SetScanPredicate(common::ManagedPointer(predicate));
@@ -225,8 +234,7 @@ void PlanGenerator::Visit(const IndexScan *op) {
   builder.SetIndexOid(op->GetIndexOID());
   builder.SetTableOid(tbl_oid);
   builder.SetColumnOids(std::move(column_ids));
-
-  auto type = op->GetIndexScanType();
+  builder.SetCoveringScan(covering_scan);
   builder.SetScanType(type);
   for (auto bound : op->GetBounds()) {
     if (type == planner::IndexScanType::Exact) {
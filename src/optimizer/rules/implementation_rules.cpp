@@ -694,6 +694,9 @@ void LogicalCreateIndexToPhysicalCreateIndex::Transform(common::ManagedPointer<O
     case parser::IndexType::HASH:
       idx_type = storage::index::IndexType::HASHMAP;
       break;
+    case parser::IndexType::ART:
+      idx_type = storage::index::IndexType::ART;
+      break;
     default:
       TERRIER_ASSERT(false, "Unsupported index type encountered");
       break;
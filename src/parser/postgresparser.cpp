@@ -1080,10 +1080,25 @@ std::unique_ptr<CopyStatement> PostgresParser::CopyTransform(ParseResult *parse_
   static constexpr char k_quote_tok[] = "quote";
   static constexpr char k_escape_tok[] = "escape";
 
+  // Data is always read and written in the order of all of the table's columns
+  if (root->attlist_ != nullptr) {
+    throw PARSER_EXCEPTION("CopyTransform: column list unsupported");
+  }
+
   std::unique_ptr<TableRef> table;
   std::unique_ptr<SelectStatement> select_stmt;
   if (root->relation_ != nullptr) {
     table = RangeVarTransform(parse_result, root->relation_);
+    if (!root->is_from_) {
+      // Copying a table out is the same as copying out SELECT * FROM table
+      std::vector<common::ManagedPointer<AbstractExpression>> select_list;
+      auto star = std::make_unique<StarExpression>();
+      select_list.emplace_back(common::ManagedPointer<AbstractExpression>(star.get()));
+      parse_result->AddExpression(std::move(star));
+      select_stmt = std::make_unique<SelectStatement>(std::move(select_list), false,
+                                                      RangeVarTransform(parse_result, root->relation_), nullptr,
+                                                      nullptr, nullptr, nullptr);
+    }
   } else {
     select_stmt = SelectTransform(parse_result, reinterpret_cast<SelectStmt *>(root->query_));
   }
@@ -1099,6 +1114,14 @@ std::unique_ptr<CopyStatement> PostgresParser::CopyTransform(ParseResult *parse_
     for (ListCell *cell = root->options_->head; cell != nullptr; cell = cell->next) {
       auto def_elem = reinterpret_cast<DefElem *>(cell->data.ptr_value);
 
+      // Options such as HEADER or NULL would change how the data is read, so they can't just be ignored
+      if (strncmp(def_elem->defname_, k_format_tok, sizeof(k_format_tok)) != 0 &&
+          strncmp(def_elem->defname_, k_delimiter_tok, sizeof(k_delimiter_tok)) != 0 &&
+          strncmp(def_elem->defname_, k_quote_tok, sizeof(k_quote_tok)) != 0 &&
+          strncmp(def_elem->defname_, k_escape_tok, sizeof(k_escape_tok)) != 0) {
+        throw PARSER_EXCEPTION(("CopyTransform: option " + std::string(def_elem->defname_) + " unsupported").c_str());
+      }
+
       if (strncmp(def_elem->defname_, k_format_tok, sizeof(k_format_tok)) == 0) {
         auto format_cstr = reinterpret_cast<value *>(def_elem->arg_)->val_.str_;
         // lowercase
@@ -1340,6 +1363,8 @@ std::unique_ptr<SQLStatement> PostgresParser::CreateIndexTransform(ParseResult *
     index_type = IndexType::BWTREE;
   } else if (strcmp(access_method, "hash") == 0) {
     index_type = IndexType::HASH;
+  } else if (strcmp(access_method, "art") == 0) {
+    index_type = IndexType::ART;
   } else {
     PARSER_LOG_DEBUG("CreateIndexTransform: IndexType {} not supported", access_method);
     throw NOT_IMPLEMENTED_EXCEPTION("CreateIndexTransform error");
@@ -14,6 +14,9 @@ common::hash_t IndexScanPlanNode::Hash() const {
 
   hash = common::HashUtil::CombineHashInRange(hash, column_oids_.begin(), column_oids_.end());
 
+  // Covering Scan
+  hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(covering_scan_));
+
   return hash;
 }
 
@@ -24,6 +27,9 @@ bool IndexScanPlanNode::operator==(const AbstractPlanNode &rhs) const {
 
   if (column_oids_ != other.column_oids_) return false;
 
+  // Covering Scan
+  if (covering_scan_ != other.covering_scan_) return false;
+
   // Index Oid
   return (index_oid_ == other.index_oid_);
 }
@@ -32,6 +38,7 @@ nlohmann::json IndexScanPlanNode::ToJson() const {
   nlohmann::json j = AbstractScanPlanNode::ToJson();
   j["index_oid"] = index_oid_;
   j["column_oids"] = column_oids_;
+  j["covering_scan"] = covering_scan_;
   return j;
 }
 
@@ -41,6 +48,7 @@ std::vector<std::unique_ptr<parser::AbstractExpression>> IndexScanPlanNode::From
   exprs.insert(exprs.end(), std::make_move_iterator(e1.begin()), std::make_move_iterator(e1.end()));
   index_oid_ = j.at("index_oid").get<catalog::index_oid_t>();
   column_oids_ = j.at("column_oids").get<std::vector<catalog::col_oid_t>>();
+  covering_scan_ = j.at("covering_scan").get<bool>();
   return exprs;
 }
 
@@ -93,4 +93,12 @@ void Callbacks::MetricsPipeline(void *const old_value, void *const new_value, DB
   action_context->SetState(common::ActionState::SUCCESS);
 }
 
+void Callbacks::SortMemoryBudget(void *const old_value, void *const new_value, DBMain *const db_main,
+                                 common::ManagedPointer<common::ActionContext> action_context) {
+  action_context->SetState(common::ActionState::IN_PROGRESS);
+  int64_t new_budget = *static_cast<int64_t *>(new_value);
+  if (db_main->GetTrafficCop() != DISABLED) db_main->GetTrafficCop()->SetSortMemoryBudget(new_budget);
+  action_context->SetState(common::ActionState::SUCCESS);
+}
+
 }  // namespace terrier::settings
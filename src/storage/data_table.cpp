@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <list>
 
 #include "common/allocator.h"
@@ -40,6 +41,37 @@ bool DataTable::Select(const common::ManagedPointer<transaction::TransactionCont
   return SelectIntoBuffer(txn, slot, out_buffer);
 }
 
+uint32_t DataTable::SelectBatch(const common::ManagedPointer<transaction::TransactionContext> txn,
+                                const TupleSlot *const slots, const uint32_t num_slots,
+                                ProjectedRow *const *const out_buffers, TupleSlot *const out_slots) const {
+  if (num_slots == 0) return 0;
+  data_table_counter_.IncrementNumSelect(num_slots);
+  const ProjectedRow &projection = *out_buffers[0];
+  for (uint32_t i = 0; i < std::min(num_slots, SELECT_BATCH_PREFETCH_DISTANCE); i++) {
+    PrefetchTuple(slots[i], projection);
+  }
+
+  uint32_t filled = 0;
+  for (uint32_t i = 0; i < num_slots; i++) {
+    if (i + SELECT_BATCH_PREFETCH_DISTANCE < num_slots) {
+      PrefetchTuple(slots[i + SELECT_BATCH_PREFETCH_DISTANCE], projection);
+    }
+    // Only fill the buffers with valid, visible tuples
+    if (SelectIntoBuffer(txn, slots[i], out_buffers[filled])) {
+      out_slots[filled] = slots[i];
+      filled++;
+    }
+  }
+  return filled;
+}
+
+void DataTable::PrefetchTuple(const TupleSlot slot, const ProjectedRow &projection) const {
+  __builtin_prefetch(accessor_.AccessWithoutNullCheck(slot, VERSION_POINTER_COLUMN_ID));
+  for (uint16_t i = 0; i < projection.NumColumns(); i++) {
+    __builtin_prefetch(accessor_.AccessWithoutNullCheck(slot, projection.ColumnIds()[i]));
+  }
+}
+
 void DataTable::Scan(const common::ManagedPointer<transaction::TransactionContext> txn, SlotIterator *const start_pos,
                      ProjectedColumns *const out_buffer) const {
   // TODO(Tianyu): So far this is not that much better than tuple-at-a-time access,
@@ -396,6 +428,10 @@ bool DataTable::HasConflict(const transaction::TransactionContext &txn, const Tu
 }
 
 bool DataTable::IsVisible(const transaction::TransactionContext &txn, const TupleSlot slot) const {
+  // Frozen blocks have no version chains: every allocated tuple in them is visible to every transaction. A writer has
+  // to thaw the block before installing a version, so the tuple stays visible to us even if that happens right now.
+  if (slot.GetBlock()->controller_.GetBlockState()->load() == BlockState::FROZEN) return Visible(slot, accessor_);
+
   UndoRecord *version_ptr;
   bool visible;
   do {
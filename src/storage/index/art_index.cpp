@@ -0,0 +1,11 @@
+#include "storage/index/art_index.h"
+#include "storage/index/compact_ints_key.h"
+
+namespace terrier::storage::index {
+
+template class ArtIndex<CompactIntsKey<8>>;
+template class ArtIndex<CompactIntsKey<16>>;
+template class ArtIndex<CompactIntsKey<24>>;
+template class ArtIndex<CompactIntsKey<32>>;
+
+}  // namespace terrier::storage::index
@@ -0,0 +1,84 @@
+#include "storage/index/index_builder.h"
+
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "common/allocator.h"
+#include "storage/sql_table.h"
+
+namespace terrier::storage::index {
+
+bool IndexBuilder::BulkInsert(const common::ManagedPointer<transaction::TransactionContext> txn,
+                              const common::ManagedPointer<SqlTable> table, Index *const index) const {
+  const auto &indexed_oids = key_schema_.GetIndexedColOids();
+  TERRIER_ASSERT(key_schema_.GetColumns().size() == indexed_oids.size(),
+                 "Only support index keys that are a single column oid");
+
+  // A column can be part of a key several times, but only has to be read once
+  std::vector<catalog::col_oid_t> table_oids(indexed_oids);
+  std::sort(table_oids.begin(), table_oids.end());
+  table_oids.erase(std::unique(table_oids.begin(), table_oids.end()), table_oids.end());
+  const auto table_pri = table->InitializerForProjectedRow(table_oids);
+  const auto table_pr_map = table->ProjectionMapForOids(table_oids);
+  const auto &index_pri = index->GetProjectedRowInitializer();
+  const auto &key_oid_to_offset = index->GetKeyOidToOffsetMap();
+
+  const auto blocks = table->GetBlocks();
+  const uint32_t num_slots = table->NumSlotsPerBlock();
+  const auto num_workers = static_cast<uint32_t>(
+      std::max(std::size_t(1), std::min<std::size_t>(std::thread::hardware_concurrency(), blocks.size())));
+  const std::unique_ptr<IndexBulkLoader> loader = index->BeginBulkLoad(num_workers);
+  // Without a bulk load, tuples are inserted one at a time, which is only safe from a single thread
+  const uint32_t num_ranges = loader != nullptr ? num_workers : 1;
+  const bool unique = key_schema_.Unique();
+  std::atomic<bool> duplicate = false;
+
+  tbb::parallel_for(uint32_t(0), num_ranges, [&](const uint32_t worker) {
+    auto *const table_buffer = common::AllocationUtil::AllocateAligned(table_pri.ProjectedRowSize());
+    auto *const index_buffer = common::AllocationUtil::AllocateAligned(index_pri.ProjectedRowSize());
+    auto *const table_pr = table_pri.InitializeRow(table_buffer);
+    auto *const index_pr = index_pri.InitializeRow(index_buffer);
+
+    const std::size_t begin = blocks.size() * worker / num_ranges;
+    const std::size_t end = blocks.size() * (worker + 1) / num_ranges;
+    for (std::size_t block = begin; block < end; block++) {
+      for (uint32_t offset = 0; offset < num_slots; offset++) {
+        const TupleSlot slot(blocks[block], offset);
+        if (!table->Select(txn, slot, table_pr)) continue;
+
+        // Copy in each value from the table PR into the index PR
+        for (uint32_t col_idx = 0; col_idx < indexed_oids.size(); col_idx++) {
+          const auto &col = key_schema_.GetColumn(col_idx);
+          const uint16_t key_offset = key_oid_to_offset.at(col.Oid());
+          const uint16_t table_offset = table_pr_map.at(indexed_oids[col_idx]);
+          if (table_pr->IsNull(table_offset)) {
+            index_pr->SetNull(key_offset);
+          } else {
+            std::memcpy(index_pr->AccessForceNotNull(key_offset), table_pr->AccessWithNullCheck(table_offset),
+                        AttrSizeBytes(col.AttrSize()));
+          }
+        }
+
+        if (loader != nullptr) {
+          loader->Add(worker, *index_pr, slot);
+        } else if (!(unique ? index->InsertUnique(txn, *index_pr, slot) : index->Insert(txn, *index_pr, slot))) {
+          duplicate = true;
+        }
+      }
+    }
+
+    delete[] table_buffer;
+    delete[] index_buffer;
+  });
+
+  if (loader != nullptr) return loader->Finish();
+  return !unique || !duplicate;
+}
+
+}  // namespace terrier::storage::index
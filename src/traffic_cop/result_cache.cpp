@@ -0,0 +1,173 @@
+#include "traffic_cop/result_cache.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "planner/plannodes/abstract_plan_node.h"
+#include "planner/plannodes/abstract_scan_plan_node.h"
+#include "planner/plannodes/index_join_plan_node.h"
+#include "planner/plannodes/index_scan_plan_node.h"
+#include "planner/plannodes/seq_scan_plan_node.h"
+#include "type/transient_value_peeker.h"
+
+namespace terrier::trafficcop {
+
+template <typename T>
+static void AppendBytes(std::string *const key, const T &value) {
+  key->append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+static bool CollectTablesRead(const planner::AbstractPlanNode &plan, std::vector<catalog::table_oid_t> *const tables) {
+  switch (plan.GetPlanNodeType()) {
+    case planner::PlanNodeType::SEQSCAN: {
+      const auto &scan = dynamic_cast<const planner::SeqScanPlanNode &>(plan);
+      if (scan.IsForUpdate()) return false;
+      tables->emplace_back(scan.GetTableOid());
+      break;
+    }
+    case planner::PlanNodeType::INDEXSCAN: {
+      const auto &scan = dynamic_cast<const planner::IndexScanPlanNode &>(plan);
+      if (scan.IsForUpdate()) return false;
+      tables->emplace_back(scan.GetTableOid());
+      break;
+    }
+    case planner::PlanNodeType::INDEXNLJOIN:
+      tables->emplace_back(dynamic_cast<const planner::IndexJoinPlanNode &>(plan).GetTableOid());
+      break;
+    case planner::PlanNodeType::NESTLOOP:
+    case planner::PlanNodeType::HASHJOIN:
+    case planner::PlanNodeType::AGGREGATE:
+    case planner::PlanNodeType::ORDERBY:
+    case planner::PlanNodeType::PROJECTION:
+    case planner::PlanNodeType::LIMIT:
+    case planner::PlanNodeType::DISTINCT:
+    case planner::PlanNodeType::HASH:
+    case planner::PlanNodeType::SETOP:
+    case planner::PlanNodeType::RESULT:
+      break;
+    default:
+      // Files, mutators and DDL are not a function of the tables alone
+      return false;
+  }
+  for (const auto child : plan.GetChildren()) {
+    if (!CollectTablesRead(*child, tables)) return false;
+  }
+  return true;
+}
+
+bool ResultCache::GetTablesRead(const planner::AbstractPlanNode &plan,
+                                std::vector<catalog::table_oid_t> *const tables) {
+  tables->clear();
+  if (!CollectTablesRead(plan, tables)) return false;
+  std::sort(tables->begin(), tables->end());
+  tables->erase(std::unique(tables->begin(), tables->end()), tables->end());
+  return true;
+}
+
+bool ResultCache::MakeKey(const catalog::db_oid_t db_oid, const std::string &query_text,
+                          const std::vector<catalog::table_oid_t> &tables,
+                          const std::vector<type::TransientValue> &params,
+                          const std::vector<network::FieldFormat> &result_formats, std::string *const key) {
+  // Every part is either fixed size or prefixed with its size, so that different queries never share a key
+  key->clear();
+  AppendBytes(key, db_oid);
+  AppendBytes(key, query_text.size());
+  key->append(query_text);
+  AppendBytes(key, tables.size());
+  for (const auto table : tables) AppendBytes(key, table);
+
+  AppendBytes(key, params.size());
+  for (const auto &param : params) {
+    AppendBytes(key, param.Type());
+    AppendBytes(key, param.Null());
+    if (param.Null()) continue;
+    switch (param.Type()) {
+      case type::TypeId::BOOLEAN:
+        AppendBytes(key, type::TransientValuePeeker::PeekBoolean(param));
+        break;
+      case type::TypeId::TINYINT:
+        AppendBytes(key, type::TransientValuePeeker::PeekTinyInt(param));
+        break;
+      case type::TypeId::SMALLINT:
+        AppendBytes(key, type::TransientValuePeeker::PeekSmallInt(param));
+        break;
+      case type::TypeId::INTEGER:
+        AppendBytes(key, type::TransientValuePeeker::PeekInteger(param));
+        break;
+      case type::TypeId::BIGINT:
+        AppendBytes(key, type::TransientValuePeeker::PeekBigInt(param));
+        break;
+      case type::TypeId::DECIMAL:
+        AppendBytes(key, type::TransientValuePeeker::PeekDecimal(param));
+        break;
+      case type::TypeId::TIMESTAMP:
+        AppendBytes(key, type::TransientValuePeeker::PeekTimestamp(param));
+        break;
+      case type::TypeId::DATE:
+        AppendBytes(key, type::TransientValuePeeker::PeekDate(param));
+        break;
+      case type::TypeId::VARCHAR: {
+        const auto varchar = type::TransientValuePeeker::PeekVarChar(param);
+        AppendBytes(key, varchar.size());
+        key->append(varchar);
+        break;
+      }
+      default:
+        return false;
+    }
+  }
+
+  AppendBytes(key, result_formats.size());
+  for (const auto format : result_formats) AppendBytes(key, format);
+  return true;
+}
+
+std::shared_ptr<const ResultCache::Result> ResultCache::Lookup(const std::string &key,
+                                                               const transaction::timestamp_t start_time,
+                                                               const TableVersions &table_versions) {
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  const auto it = results_.find(key);
+  if (it == results_.end()) return nullptr;
+  const auto result = it->second.first;
+  if (result->table_versions_ != table_versions) {
+    // A table changed since, so nobody can use the result anymore
+    Erase(it);
+    return nullptr;
+  }
+  for (const auto &table_version : table_versions) {
+    // The transaction started before the last change to the table committed, so it doesn't see the change. Newer
+    // transactions can still use the result.
+    if (table_version.second >= start_time) return nullptr;
+  }
+  lru_.splice(lru_.begin(), lru_, it->second.second);
+  return result;
+}
+
+bool ResultCache::Insert(const std::string &key, const transaction::timestamp_t start_time, Result result) {
+  // Results of a transaction that doesn't see the last change to a table are only right for older transactions
+  for (const auto &table_version : result.table_versions_) {
+    if (table_version.second == transaction::INVALID_TXN_TIMESTAMP || table_version.second >= start_time) return false;
+  }
+  if (result.rows_.size() > MAX_RESULT_SIZE || result.rows_.size() > capacity_) return false;
+
+  auto shared_result = std::make_shared<const Result>(std::move(result));
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  const auto it = results_.find(key);
+  if (it != results_.end()) Erase(it);
+  lru_.emplace_front(key);
+  results_.emplace(key, std::make_pair(shared_result, lru_.begin()));
+  size_ += shared_result->rows_.size();
+  while (size_ > capacity_) Erase(results_.find(lru_.back()));
+  return true;
+}
+
+void ResultCache::Erase(const ResultMap::iterator it) {
+  size_ -= it->second.first->rows_.size();
+  lru_.erase(it->second.second);
+  results_.erase(it);
+}
+
+}  // namespace terrier::trafficcop
@@ -1,8 +1,11 @@
 #include "traffic_cop/traffic_cop.h"
 
+#include <fstream>
+#include <functional>
 #include <future>  // NOLINT
 #include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -13,6 +16,7 @@
 #include "execution/exec/execution_context.h"
 #include "execution/exec/output.h"
 #include "execution/executable_query.h"
+#include "execution/sql/csv_loader.h"
 #include "execution/sql/ddl_executors.h"
 #include "execution/vm/module.h"
 #include "network/connection_context.h"
@@ -28,8 +32,10 @@
 #include "optimizer/property_set.h"
 #include "optimizer/query_to_operator_transformer.h"
 #include "optimizer/statistics/stats_storage.h"
+#include "parser/copy_statement.h"
 #include "parser/postgresparser.h"
 #include "planner/plannodes/abstract_plan_node.h"
+#include "traffic_cop/result_cache.h"
 #include "traffic_cop/traffic_cop_defs.h"
 #include "traffic_cop/traffic_cop_util.h"
 #include "transaction/transaction_manager.h"
@@ -41,6 +47,17 @@ static void CommitCallback(void *const callback_arg) {
   promise->set_value(true);
 }
 
+// Looks up the table of a COPY the way the binder resolved it, in its namespace if it names one
+static catalog::table_oid_t CopyTableOid(const common::ManagedPointer<catalog::CatalogAccessor> accessor,
+                                         const common::ManagedPointer<parser::TableRef> table) {
+  const auto table_oid =
+      table->GetNamespaceName().empty()
+          ? accessor->GetTableOid(table->GetTableName())
+          : accessor->GetTableOid(accessor->GetNamespaceOid(table->GetNamespaceName()), table->GetTableName());
+  TERRIER_ASSERT(table_oid != catalog::INVALID_TABLE_OID, "The binder should have checked that the table exists.");
+  return table_oid;
+}
+
 void TrafficCop::BeginTransaction(const common::ManagedPointer<network::ConnectionContext> connection_ctx) const {
   TERRIER_ASSERT(connection_ctx->TransactionState() == network::NetworkTransactionStateType::IDLE,
                  "Invalid ConnectionContext state, already in a transaction.");
@@ -130,7 +147,8 @@ std::unique_ptr<planner::AbstractPlanNode> TrafficCop::OptimizeBoundQuery(
 
   return TrafficCopUtil::Optimize(connection_ctx->Transaction(), connection_ctx->Accessor(), query,
                                   connection_ctx->GetDatabaseOid(), stats_storage_,
-                                  std::make_unique<optimizer::TrivialCostModel>(), optimizer_timeout_);
+                                  std::make_unique<optimizer::TrivialCostModel>(), optimizer_timeout_,
+                                  common::ManagedPointer(optimizer_workers_));
 }
 
 TrafficCopResult TrafficCop::ExecuteCreateStatement(
@@ -289,7 +307,7 @@ TrafficCopResult TrafficCop::CodegenPhysicalPlan(
   // away
   auto exec_ctx = std::make_unique<execution::exec::ExecutionContext>(
       connection_ctx->GetDatabaseOid(), connection_ctx->Transaction(), writer, physical_plan->GetOutputSchema().Get(),
-      connection_ctx->Accessor());
+      connection_ctx->Accessor(), sort_memory_budget_.load(std::memory_order_relaxed));
 
   auto exec_query = std::make_unique<execution::ExecutableQuery>(common::ManagedPointer(physical_plan),
                                                                  common::ManagedPointer(exec_ctx));
@@ -306,15 +324,64 @@ TrafficCopResult TrafficCop::RunExecutableQuery(const common::ManagedPointer<net
   TERRIER_ASSERT(connection_ctx->TransactionState() == network::NetworkTransactionStateType::BLOCK,
                  "Not in a valid txn. This should have been caught before calling this function.");
   const auto query_type = portal->GetStatement()->GetQueryType();
-  const auto physical_plan = portal->PhysicalPlan();
   TERRIER_ASSERT(query_type == network::QueryType::QUERY_SELECT || query_type == network::QueryType::QUERY_INSERT ||
                      query_type == network::QueryType::QUERY_UPDATE || query_type == network::QueryType::QUERY_DELETE,
                  "CodegenAndRunPhysicalPlan called with invalid QueryType.");
+
+  // Only a transaction that hasn't written anything reads exactly the committed state of the tables
+  const auto txn = connection_ctx->Transaction();
+  std::vector<catalog::table_oid_t> tables;
+  std::string key;
+  if (result_cache_ == nullptr || query_type != network::QueryType::QUERY_SELECT || !txn->IsReadOnly() ||
+      !ResultCache::GetTablesRead(*portal->PhysicalPlan(), &tables) ||
+      !ResultCache::MakeKey(connection_ctx->GetDatabaseOid(), portal->GetStatement()->GetQueryText(), tables,
+                            *portal->Parameters(), portal->ResultFormats(), &key)) {
+    return ExecuteQuery(connection_ctx, out, portal);
+  }
+
+  const auto accessor = connection_ctx->Accessor();
+  const auto table_versions = [&] {
+    ResultCache::TableVersions versions;
+    versions.reserve(tables.size());
+    for (const auto table_oid : tables) {
+      const auto table = accessor->GetTable(table_oid);
+      versions.emplace_back(table_oid, table == nullptr ? transaction::INVALID_TXN_TIMESTAMP : table->LastModified());
+    }
+    return versions;
+  };
+
+  const auto cached = result_cache_->Lookup(key, txn->StartTime(), table_versions());
+  if (cached != nullptr) {
+    out->WritePackets(cached->rows_);
+    return {ResultType::COMPLETE, cached->num_rows_};
+  }
+
+  // Run the query against a queue of its own to keep a copy of its results
+  network::WriteQueue result_queue;
+  network::PostgresPacketWriter result_writer{common::ManagedPointer(&result_queue)};
+  const auto result = ExecuteQuery(connection_ctx, common::ManagedPointer(&result_writer), portal);
+  ResultCache::Result rows;
+  result_queue.CopyUnwrittenBytes(&rows.rows_);
+  out->WritePackets(rows.rows_);
+  if (result.type_ == ResultType::COMPLETE) {
+    rows.num_rows_ = std::get<uint32_t>(result.extra_);
+    // The versions are read after the query ran, so that a change the query might have missed is never hidden
+    rows.table_versions_ = table_versions();
+    result_cache_->Insert(key, txn->StartTime(), std::move(rows));
+  }
+  return result;
+}
+
+TrafficCopResult TrafficCop::ExecuteQuery(const common::ManagedPointer<network::ConnectionContext> connection_ctx,
+                                          const common::ManagedPointer<network::PostgresPacketWriter> out,
+                                          const common::ManagedPointer<network::Portal> portal) const {
+  const auto query_type = portal->GetStatement()->GetQueryType();
+  const auto physical_plan = portal->PhysicalPlan();
   execution::exec::OutputWriter writer(physical_plan->GetOutputSchema(), out, portal->ResultFormats());
 
   auto exec_ctx = std::make_unique<execution::exec::ExecutionContext>(
       connection_ctx->GetDatabaseOid(), connection_ctx->Transaction(), writer, physical_plan->GetOutputSchema().Get(),
-      connection_ctx->Accessor());
+      connection_ctx->Accessor(), sort_memory_budget_.load(std::memory_order_relaxed));
 
   exec_ctx->SetParams(portal->Parameters());
 
@@ -339,6 +406,112 @@ TrafficCopResult TrafficCop::RunExecutableQuery(const common::ManagedPointer<net
   return {ResultType::ERROR, "Query failed."};
 }
 
+TrafficCopResult TrafficCop::ExecuteCopyStatement(
+    const common::ManagedPointer<network::ConnectionContext> connection_ctx,
+    const common::ManagedPointer<network::PostgresPacketWriter> out,
+    const common::ManagedPointer<network::Statement> statement) const {
+  TERRIER_ASSERT(connection_ctx->TransactionState() == network::NetworkTransactionStateType::BLOCK,
+                 "Not in a valid txn. This should have been caught before calling this function.");
+  TERRIER_ASSERT(statement->GetQueryType() == network::QueryType::QUERY_COPY,
+                 "ExecuteCopyStatement called with invalid QueryType.");
+  const auto copy_stmt = statement->RootStatement().CastManagedPointerTo<parser::CopyStatement>();
+  if (copy_stmt->GetExternalFileFormat() != parser::ExternalFileFormat::CSV) {
+    return {ResultType::ERROR, "ERROR:  COPY only supports the CSV format"};
+  }
+  const auto &file_path = copy_stmt->GetFilePath();
+  if (!file_path.empty() && !server_side_copy_) {
+    // Postgres only lets superusers do this, but there are no roles yet to tell them apart
+    return {ResultType::ERROR, "ERROR:  COPY to or from a file is disabled, use STDIN or STDOUT instead"};
+  }
+
+  try {
+    if (copy_stmt->IsFrom()) {
+      const auto accessor = connection_ctx->Accessor();
+      const auto table_oid = CopyTableOid(accessor, copy_stmt->GetCopyTable());
+      if (file_path.empty()) {
+        // The client sends the data in CopyData messages, which the protocol interpreter collects until CopyDone
+        out->WriteCopyInResponse(static_cast<uint16_t>(accessor->GetSchema(table_oid).GetColumns().size()));
+        return {ResultType::QUEUING, 0u};
+      }
+      execution::sql::CSVLoader loader(connection_ctx->Transaction(), accessor, connection_ctx->GetDatabaseOid(),
+                                       table_oid, copy_stmt->GetDelimiter(), copy_stmt->GetQuoteChar(),
+                                       copy_stmt->GetEscapeChar());
+      return {ResultType::COMPLETE, static_cast<uint32_t>(loader.Load(file_path))};
+    }
+
+    // COPY ... TO runs its query like any other SELECT, with the CSV writer as the output callback
+    const auto physical_plan = TrafficCopUtil::Optimize(
+        connection_ctx->Transaction(), connection_ctx->Accessor(), statement->ParseResult(),
+        copy_stmt->GetSelectStatement().CastManagedPointerTo<parser::SQLStatement>(), connection_ctx->GetDatabaseOid(),
+        stats_storage_, std::make_unique<optimizer::TrivialCostModel>(), optimizer_timeout_,
+        common::ManagedPointer(optimizer_workers_));
+    const auto schema = physical_plan->GetOutputSchema();
+
+    std::ofstream file;
+    std::unique_ptr<execution::exec::CSVOutputWriter> writer;
+    if (file_path.empty()) {
+      out->WriteCopyOutResponse(static_cast<uint16_t>(schema->GetColumns().size()));
+      writer = std::make_unique<execution::exec::CSVOutputWriter>(
+          schema, out, copy_stmt->GetDelimiter(), copy_stmt->GetQuoteChar(), copy_stmt->GetEscapeChar());
+    } else {
+      file.open(file_path, std::ios::out | std::ios::trunc | std::ios::binary);
+      if (!file.is_open()) throw EXECUTION_EXCEPTION("could not open file for COPY");
+      writer = std::make_unique<execution::exec::CSVOutputWriter>(
+          schema, &file, copy_stmt->GetDelimiter(), copy_stmt->GetQuoteChar(), copy_stmt->GetEscapeChar());
+    }
+
+    // The execution context copies its callback, so hand it a reference to keep the row count in our writer
+    auto exec_ctx = std::make_unique<execution::exec::ExecutionContext>(
+        connection_ctx->GetDatabaseOid(), connection_ctx->Transaction(), std::ref(*writer), schema.Get(),
+        connection_ctx->Accessor(), sort_memory_budget_.load(std::memory_order_relaxed));
+    execution::ExecutableQuery exec_query{common::ManagedPointer(physical_plan), common::ManagedPointer(exec_ctx)};
+    exec_query.Run(common::ManagedPointer(exec_ctx), execution::vm::ExecutionMode::Interpret);
+
+    if (file_path.empty()) {
+      out->WriteCopyDone();
+    } else {
+      file.close();
+      if (file.fail()) throw EXECUTION_EXCEPTION("could not write file for COPY");
+    }
+    return {ResultType::COMPLETE, static_cast<uint32_t>(writer->NumRows())};
+  } catch (const Exception &e) {
+    connection_ctx->Transaction()->SetMustAbort();
+    return {ResultType::ERROR, std::string("ERROR:  ") + e.what()};
+  }
+}
+
+TrafficCopResult TrafficCop::ExecuteCopyFromStdin(
+    const common::ManagedPointer<network::ConnectionContext> connection_ctx,
+    const common::ManagedPointer<network::Statement> statement, const std::string &data) const {
+  TERRIER_ASSERT(connection_ctx->TransactionState() == network::NetworkTransactionStateType::BLOCK,
+                 "Not in a valid txn. This should have been caught before calling this function.");
+  const auto copy_stmt = statement->RootStatement().CastManagedPointerTo<parser::CopyStatement>();
+  TERRIER_ASSERT(copy_stmt->IsFrom() && copy_stmt->GetFilePath().empty(),
+                 "ExecuteCopyFromStdin called with a statement that doesn't copy from STDIN.");
+
+  // Clients may still end the data with the end-of-copy marker of the old protocol, which isn't a row
+  auto size = data.size();
+  for (const std::string_view marker : {"\\.\n", "\\.\r\n", "\\."}) {
+    if (size >= marker.size() && data.compare(size - marker.size(), marker.size(), marker) == 0 &&
+        (size == marker.size() || data[size - marker.size() - 1] == '\n')) {
+      size -= marker.size();
+      break;
+    }
+  }
+
+  try {
+    const auto accessor = connection_ctx->Accessor();
+    const auto table_oid = CopyTableOid(accessor, copy_stmt->GetCopyTable());
+    execution::sql::CSVLoader loader(connection_ctx->Transaction(), accessor, connection_ctx->GetDatabaseOid(),
+                                     table_oid, copy_stmt->GetDelimiter(), copy_stmt->GetQuoteChar(),
+                                     copy_stmt->GetEscapeChar());
+    return {ResultType::COMPLETE, static_cast<uint32_t>(loader.Load(data.data(), size))};
+  } catch (const Exception &e) {
+    connection_ctx->Transaction()->SetMustAbort();
+    return {ResultType::ERROR, std::string("ERROR:  ") + e.what()};
+  }
+}
+
 std::pair<catalog::db_oid_t, catalog::namespace_oid_t> TrafficCop::CreateTempNamespace(
     const network::connection_id_t connection_id, const std::string &database_name) {
   auto *const txn = txn_manager_->BeginTransaction();
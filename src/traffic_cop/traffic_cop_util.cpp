@@ -1,5 +1,14 @@
 #include "traffic_cop/traffic_cop_util.h"
 
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "catalog/catalog_accessor.h"
 #include "optimizer/abstract_optimizer.h"
 #include "optimizer/cost_model/trivial_cost_model.h"
@@ -11,6 +20,7 @@
 #include "optimizer/statistics/stats_storage.h"
 #include "parser/parser_defs.h"
 #include "parser/postgresparser.h"
+#include "type/transient_value_factory.h"
 
 namespace terrier::trafficcop {
 
@@ -19,22 +29,35 @@ std::unique_ptr<planner::AbstractPlanNode> TrafficCopUtil::Optimize(
     const common::ManagedPointer<catalog::CatalogAccessor> accessor,
     const common::ManagedPointer<parser::ParseResult> query, const catalog::db_oid_t db_oid,
     common::ManagedPointer<optimizer::StatsStorage> stats_storage,
-    std::unique_ptr<optimizer::AbstractCostModel> cost_model, const uint64_t optimizer_timeout) {
+    std::unique_ptr<optimizer::AbstractCostModel> cost_model, const uint64_t optimizer_timeout,
+    const common::ManagedPointer<common::WorkerPool> optimizer_workers) {
+  return Optimize(txn, accessor, query, query->GetStatement(0), db_oid, stats_storage, std::move(cost_model),
+                  optimizer_timeout, optimizer_workers);
+}
+
+std::unique_ptr<planner::AbstractPlanNode> TrafficCopUtil::Optimize(
+    const common::ManagedPointer<transaction::TransactionContext> txn,
+    const common::ManagedPointer<catalog::CatalogAccessor> accessor,
+    const common::ManagedPointer<parser::ParseResult> query,
+    const common::ManagedPointer<parser::SQLStatement> statement, const catalog::db_oid_t db_oid,
+    common::ManagedPointer<optimizer::StatsStorage> stats_storage,
+    std::unique_ptr<optimizer::AbstractCostModel> cost_model, const uint64_t optimizer_timeout,
+    const common::ManagedPointer<common::WorkerPool> optimizer_workers) {
   // Optimizer transforms annotated ParseResult to logical expressions (ephemeral Optimizer structure)
   optimizer::QueryToOperatorTransformer transformer(accessor, db_oid);
-  auto logical_exprs = transformer.ConvertToOpExpression(query->GetStatement(0), query);
+  auto logical_exprs = transformer.ConvertToOpExpression(statement, query);
 
   // TODO(Matt): is the cost model to use going to become an arg to this function eventually?
-  optimizer::Optimizer optimizer(std::move(cost_model), optimizer_timeout);
+  optimizer::Optimizer optimizer(std::move(cost_model), optimizer_timeout, optimizer_workers);
   optimizer::PropertySet property_set;
   std::vector<common::ManagedPointer<parser::AbstractExpression>> output;
 
   // Build the QueryInfo object. For SELECTs this may require a bunch of other stuff from the original statement.
   // If any more logic like this is needed in the future, we should break this into its own function somewhere since
   // this is Optimizer-specific stuff.
-  const auto type = query->GetStatement(0)->GetType();
+  const auto type = statement->GetType();
   if (type == parser::StatementType::SELECT) {
-    const auto sel_stmt = query->GetStatement(0).CastManagedPointerTo<parser::SelectStatement>();
+    const auto sel_stmt = statement.CastManagedPointerTo<parser::SelectStatement>();
 
     // Output
     output = sel_stmt->GetSelectColumns();  // TODO(Matt): this is making a local copy. Revisit the life cycle and
@@ -150,4 +173,230 @@ network::QueryType TrafficCopUtil::QueryTypeForStatement(const common::ManagedPo
   }
 }
 
+static bool IsIdentifierStart(const char c) {
+  const auto uc = static_cast<unsigned char>(c);
+  return std::isalpha(uc) != 0 || c == '_' || uc >= 0x80;
+}
+
+static bool IsIdentifierChar(const char c) {
+  return IsIdentifierStart(c) || std::isdigit(static_cast<unsigned char>(c)) != 0 || c == '$';
+}
+
+static bool IsOperatorChar(const char c) { return c != '\0' && std::strchr("+-*/<>=~!@#%^&|`?", c) != nullptr; }
+
+static bool IsCommentStart(const std::string &query, const size_t i) {
+  if (i + 1 >= query.size()) return false;
+  return (query[i] == '-' && query[i + 1] == '-') || (query[i] == '/' && query[i + 1] == '*');
+}
+
+// Position one past the closing quote of the quoted string or identifier starting at start, or npos if it's unclosed
+static size_t EndOfQuoted(const std::string &query, const size_t start) {
+  const char quote = query[start];
+  size_t i = start + 1;
+  while (true) {
+    i = query.find(quote, i);
+    if (i == std::string::npos) return i;
+    // A doubled quote is an escaped quote
+    if (i + 1 < query.size() && query[i + 1] == quote) {
+      i += 2;
+      continue;
+    }
+    return i + 1;
+  }
+}
+
+// Whether the token after a constant ending at end leaves the constant a whole operand, e.g. "= 1 AND" but not
+// "= 1 + 2" or "= '1'::INT"
+static bool EndsOperand(const std::string &query, const size_t end) {
+  const size_t next = query.find_first_not_of(" \t\n\r\f\v", end);
+  if (next == std::string::npos) return true;
+  const char c = query[next];
+  return c == ',' || c == ')' || c == ';' || IsIdentifierStart(c) || (c == '-' && IsCommentStart(query, next));
+}
+
+bool TrafficCopUtil::ParameterizeQuery(const std::string &query, std::string *const parameterized_query,
+                                       std::vector<type::TransientValue> *const params) {
+  parameterized_query->clear();
+  parameterized_query->reserve(query.size());
+  params->clear();
+
+  // For each open parenthesis, whether it holds a list of values (VALUES (...) or IN (...)) whose elements can be
+  // parameters. Any keyword or identifier directly inside the list, e.g. a subquery, makes it an ordinary expression.
+  std::vector<bool> value_lists;
+  // Depth of parentheses of the VALUES clause that is being lexed, or -1 if there is none
+  int64_t values_depth = -1;
+  // Previous token, lowercased if it's a keyword or identifier
+  std::string prev_token;
+  bool pending_space = false;
+
+  const auto emit = [&](const std::string &token) {
+    if (pending_space && !parameterized_query->empty()) parameterized_query->push_back(' ');
+    pending_space = false;
+    parameterized_query->append(token);
+    prev_token = token;
+  };
+  const auto is_parameter_position = [&] {
+    if (prev_token == "=" || prev_token == "<>" || prev_token == "!=" || prev_token == "<" || prev_token == "<=" ||
+        prev_token == ">" || prev_token == ">=")
+      return true;
+    return (prev_token == "(" || prev_token == ",") && !value_lists.empty() && value_lists.back();
+  };
+  const auto emit_parameter = [&](type::TransientValue &&value) {
+    params->emplace_back(std::move(value));
+    emit("$" + std::to_string(params->size()));
+  };
+
+  const size_t size = query.size();
+  size_t i = 0;
+  while (i < size) {
+    const char c = query[i];
+
+    if (std::isspace(static_cast<unsigned char>(c)) != 0) {
+      pending_space = true;
+      i++;
+      continue;
+    }
+
+    if (c == '-' && IsCommentStart(query, i)) {
+      i = std::min(query.find('\n', i), size);
+      pending_space = true;
+      continue;
+    }
+
+    // Block comments nest in postgres, parameters and dollar-quoted strings have no place here: leave all to the parser
+    if ((c == '/' && IsCommentStart(query, i)) || c == '$') return false;
+
+    if (c == '"') {
+      const size_t end = EndOfQuoted(query, i);
+      if (end == std::string::npos) return false;
+      emit(query.substr(i, end - i));
+      i = end;
+      continue;
+    }
+
+    if (c == '\'') {
+      const size_t end = EndOfQuoted(query, i);
+      if (end == std::string::npos) return false;
+      // Strings separated by a newline are concatenated
+      const size_t next = query.find_first_not_of(" \t\n\r\f\v", end);
+      if (next != std::string::npos && query[next] == '\'') return false;
+
+      if (is_parameter_position() && EndsOperand(query, end)) {
+        std::string value;
+        value.reserve(end - i - 2);
+        for (size_t j = i + 1; j < end - 1; j++) {
+          value.push_back(query[j]);
+          if (query[j] == '\'') j++;
+        }
+        emit_parameter(type::TransientValueFactory::GetVarChar(value));
+      } else {
+        emit(query.substr(i, end - i));
+      }
+      i = end;
+      continue;
+    }
+
+    if (std::isdigit(static_cast<unsigned char>(c)) != 0) {
+      size_t end = i;
+      while (end < size && std::isdigit(static_cast<unsigned char>(query[end])) != 0) end++;
+      const bool is_decimal = end < size && query[end] == '.';
+      if (is_decimal) {
+        end++;
+        while (end < size && std::isdigit(static_cast<unsigned char>(query[end])) != 0) end++;
+      }
+      const std::string number = query.substr(i, end - i);
+      i = end;
+
+      // Exponents ("1e5") and anything else glued to the number are left to the parser
+      const bool is_plain = end == size || (!IsIdentifierChar(query[end]) && query[end] != '.');
+      if (!is_plain || !is_parameter_position() || !EndsOperand(query, end)) {
+        emit(number);
+        continue;
+      }
+
+      // Type the value the way PostgresParser::ValueTransform does
+      if (is_decimal) {
+        emit_parameter(type::TransientValueFactory::GetDecimal(std::stod(number)));
+        continue;
+      }
+      int64_t value;
+      try {
+        value = std::stoll(number);
+      } catch (const std::out_of_range &) {
+        emit(number);
+        continue;
+      }
+      if (value <= std::numeric_limits<int32_t>::max()) {
+        emit_parameter(type::TransientValueFactory::GetInteger(static_cast<int32_t>(value)));
+      } else {
+        emit_parameter(type::TransientValueFactory::GetBigInt(value));
+      }
+      continue;
+    }
+
+    if (IsIdentifierStart(c)) {
+      size_t end = i;
+      while (end < size && IsIdentifierChar(query[end])) end++;
+      // Prefixed strings: E'...', B'...', X'...', N'...'
+      if (end < size && query[end] == '\'') return false;
+      std::string word = query.substr(i, end - i);
+      for (auto &ch : word) ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+      i = end;
+
+      const auto depth = static_cast<int64_t>(value_lists.size());
+      if (word == "values") {
+        values_depth = depth;
+      } else if (depth == values_depth) {
+        values_depth = -1;
+      }
+      if (!value_lists.empty()) value_lists.back() = false;
+      // Unquoted identifiers and keywords are case-insensitive
+      emit(word);
+      continue;
+    }
+
+    if (c == '(') {
+      const auto depth = static_cast<int64_t>(value_lists.size());
+      value_lists.push_back(prev_token == "in" ||
+                            ((prev_token == "values" || prev_token == ",") && depth == values_depth));
+      emit("(");
+      i++;
+      continue;
+    }
+
+    if (c == ')') {
+      if (value_lists.empty()) return false;
+      value_lists.pop_back();
+      if (values_depth > static_cast<int64_t>(value_lists.size())) values_depth = -1;
+      emit(")");
+      i++;
+      continue;
+    }
+
+    if (c == ':' && i + 1 < size && query[i + 1] == ':') {
+      emit("::");
+      i += 2;
+      continue;
+    }
+
+    if (c == ',' || c == ';' || c == '.' || c == ':' || c == '[' || c == ']') {
+      emit(std::string(1, c));
+      i++;
+      continue;
+    }
+
+    if (IsOperatorChar(c)) {
+      size_t end = i;
+      while (end < size && IsOperatorChar(query[end]) && !IsCommentStart(query, end)) end++;
+      emit(query.substr(i, end - i));
+      i = end;
+      continue;
+    }
+
+    // Anything else is beyond this lexer
+    return false;
+  }
+  return true;
+}
+
 }  // namespace terrier::trafficcop
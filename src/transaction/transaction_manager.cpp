@@ -1,7 +1,9 @@
 #include "transaction/transaction_manager.h"
 
+#include <immintrin.h>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "common/scoped_timer.h"
 #include "common/thread_context.h"
@@ -52,7 +54,7 @@ void TransactionManager::LogCommit(TransactionContext *const txn, const timestam
   txn->redo_buffer_.Finalize(true);
 }
 
-timestamp_t TransactionManager::UpdatingCommitCriticalSection(TransactionContext *const txn) {
+void TransactionManager::CommitGroup(const std::vector<TransactionContext *> &group) {
   // WARNING: This operation has to happen appear atomic to new transactions:
   // transaction 1        transaction 2
   //   begin
@@ -68,11 +70,49 @@ timestamp_t TransactionManager::UpdatingCommitCriticalSection(TransactionContext
   //  the correct version the second time, violating snapshot isolation.
   //  Make sure you solve this problem before you remove this gate for whatever reason.
   common::Gate::ScopedLock gate(&txn_gate_);
-  const timestamp_t commit_time = timestamp_manager_->CheckOutTimestamp();
+  timestamp_t commit_time = timestamp_manager_->CheckOutTimestamps(group.size());
+
+  for (TransactionContext *const member : group) {
+    // flip all timestamps to be committed, and date the tables changed before any new transaction can see the changes
+    storage::DataTable *last_table = nullptr;
+    for (auto &it : member->undo_buffer_) {
+      it.Timestamp().store(commit_time);
+      if (it.Table() != last_table && it.Table() != nullptr) {
+        last_table = it.Table();
+        last_table->UpdateLastModified(commit_time);
+      }
+    }
+    // Publishing the finish time is what releases a waiting member, so it must come after its undo records are flipped
+    member->finish_time_.store(commit_time);
+    commit_time++;
+  }
+}
 
-  // flip all timestamps to be committed
-  for (auto &it : txn->undo_buffer_) it.Timestamp().store(commit_time);
-  return commit_time;
+timestamp_t TransactionManager::UpdatingCommitCriticalSection(TransactionContext *const txn) {
+  const timestamp_t txn_id = txn->FinishTime();
+  {
+    common::SpinLatch::ScopedSpinLatch guard(&pending_commits_latch_);
+    pending_commits_.push_back(txn);
+  }
+
+  std::vector<TransactionContext *> group;
+  // Until someone hands us a commit timestamp, either wait for the current leader or become the leader ourselves. A
+  // leader keeps draining the queue until it has committed its own txn, and then steps down. Uncontended commits form
+  // a group of one, which is equivalent to committing without the pipeline.
+  while (txn->FinishTime() == txn_id) {
+    if (commit_leader_.load() || commit_leader_.exchange(true)) {
+      _mm_pause();
+      continue;
+    }
+    {
+      common::SpinLatch::ScopedSpinLatch guard(&pending_commits_latch_);
+      group.swap(pending_commits_);
+    }
+    if (!group.empty()) CommitGroup(group);
+    group.clear();
+    commit_leader_.store(false);
+  }
+  return txn->FinishTime();
 }
 
 timestamp_t TransactionManager::Commit(TransactionContext *const txn, transaction::callback_fn callback,
@@ -90,7 +130,8 @@ timestamp_t TransactionManager::Commit(TransactionContext *const txn, transactio
                  "stack trace for when this flag is getting tripped.");
   result = txn->IsReadOnly() ? timestamp_manager_->CheckOutTimestamp() : UpdatingCommitCriticalSection(txn);
 
-  txn->finish_time_.store(result);
+  // Updating txns have their finish time published by the commit group that committed them
+  if (txn->IsReadOnly()) txn->finish_time_.store(result);
 
   while (!txn->commit_actions_.empty()) {
     TERRIER_ASSERT(deferred_action_manager_ != DISABLED, "No deferred action manager exists to process actions");
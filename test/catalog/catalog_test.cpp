@@ -853,4 +853,46 @@ TEST_F(CatalogTests, DDLLockTest) {
   txn_manager_->Commit(txn5, transaction::TransactionUtil::EmptyCallback, nullptr);  // txn5 releases the lock
 }
 
+/*
+ * Check that cached lookups follow the snapshot of each txn across DDL changes
+ */
+// NOLINTNEXTLINE
+TEST_F(CatalogTests, CachedLookupTest) {
+  // txn0 caches the miss of a namespace that doesn't exist yet
+  auto *txn0 = txn_manager_->BeginTransaction();
+  auto accessor0 = catalog_->GetAccessor(common::ManagedPointer(txn0), db_);
+  EXPECT_EQ(accessor0->GetNamespaceOid("cached_ns"), catalog::INVALID_NAMESPACE_OID);
+
+  // txn1 sees its own change, and txn0 doesn't see it in progress
+  auto *txn1 = txn_manager_->BeginTransaction();
+  auto accessor1 = catalog_->GetAccessor(common::ManagedPointer(txn1), db_);
+  const auto ns_oid = accessor1->CreateNamespace("cached_ns");
+  EXPECT_NE(ns_oid, catalog::INVALID_NAMESPACE_OID);
+  EXPECT_EQ(accessor1->GetNamespaceOid("cached_ns"), ns_oid);
+  EXPECT_EQ(accessor0->GetNamespaceOid("cached_ns"), catalog::INVALID_NAMESPACE_OID);
+  txn_manager_->Commit(txn1, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  // txn0 still doesn't see the committed change, and newer txns don't get the miss txn0 cached
+  EXPECT_EQ(accessor0->GetNamespaceOid("cached_ns"), catalog::INVALID_NAMESPACE_OID);
+  auto *txn2 = txn_manager_->BeginTransaction();
+  auto accessor2 = catalog_->GetAccessor(common::ManagedPointer(txn2), db_);
+  EXPECT_EQ(accessor2->GetNamespaceOid("cached_ns"), ns_oid);
+  EXPECT_EQ(accessor2->GetNamespaceOid("cached_ns"), ns_oid);
+
+  // Dropping the namespace retires the cached hit in the same way
+  auto *txn3 = txn_manager_->BeginTransaction();
+  auto accessor3 = catalog_->GetAccessor(common::ManagedPointer(txn3), db_);
+  EXPECT_TRUE(accessor3->DropNamespace(ns_oid));
+  txn_manager_->Commit(txn3, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  EXPECT_EQ(accessor2->GetNamespaceOid("cached_ns"), ns_oid);
+  auto *txn4 = txn_manager_->BeginTransaction();
+  auto accessor4 = catalog_->GetAccessor(common::ManagedPointer(txn4), db_);
+  EXPECT_EQ(accessor4->GetNamespaceOid("cached_ns"), catalog::INVALID_NAMESPACE_OID);
+
+  txn_manager_->Commit(txn0, transaction::TransactionUtil::EmptyCallback, nullptr);
+  txn_manager_->Commit(txn2, transaction::TransactionUtil::EmptyCallback, nullptr);
+  txn_manager_->Commit(txn4, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
 }  // namespace terrier
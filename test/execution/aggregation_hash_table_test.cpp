@@ -288,7 +288,7 @@ TEST_F(AggregationHashTableTest, BatchProcessTest) {
     // Process
     ProjectedColumnsIterator pci(projected_columns);
     ProjectedColumnsIterator *iters[] = {&pci};
-    AggTable()->ProcessBatch(iters, hash_fn, key_eq, init_agg, advance_agg);
+    AggTable()->ProcessBatch(iters, hash_fn, key_eq, init_agg, advance_agg, false);
   }
   FreeProjectedColumns();
 }
@@ -465,4 +465,116 @@ TEST_F(AggregationHashTableTest, ParallelAggregationTest) {
   EXPECT_EQ(num_aggs, qstate.row_count_.load(std::memory_order_seq_cst));
 }
 
+// NOLINTNEXTLINE
+TEST_F(AggregationHashTableTest, AdaptivePreAggregationTest) {
+  const auto hash_fn = [](void *x) {
+    auto iters = reinterpret_cast<ProjectedColumnsIterator **>(x);
+    auto key = iters[0]->Get<uint32_t, false>(0, nullptr);
+    return util::Hasher::Hash(reinterpret_cast<const uint8_t *>(key), sizeof(uint32_t));
+  };
+
+  const auto key_eq = [](const void *agg, const void *x) {
+    auto agg_tuple = reinterpret_cast<const AggTuple *>(agg);
+    auto iters = reinterpret_cast<const ProjectedColumnsIterator *const *>(x);
+    auto pci_key = iters[0]->Get<uint32_t, false>(0, nullptr);
+    return agg_tuple->key_ == *pci_key;
+  };
+
+  const auto init_agg = [](void *agg, void *x) {
+    auto iters = reinterpret_cast<ProjectedColumnsIterator **>(x);
+    auto key = iters[0]->Get<uint32_t, false>(0, nullptr);
+    auto val = iters[0]->Get<uint32_t, false>(1, nullptr);
+    new (agg) AggTuple(InputTuple(*key, *val));
+  };
+
+  const auto advance_agg = [](void *agg, void *x) {
+    auto agg_tuple = reinterpret_cast<AggTuple *>(agg);
+    auto iters = reinterpret_cast<ProjectedColumnsIterator **>(x);
+    auto key = iters[0]->Get<uint32_t, false>(0, nullptr);
+    auto val = iters[0]->Get<uint32_t, false>(1, nullptr);
+    agg_tuple->Advance(InputTuple(*key, *val));
+  };
+
+  auto init_ht = [](void *ctx, void *aht) {
+    auto exec_ctx = reinterpret_cast<exec::ExecutionContext *>(ctx);
+    new (aht) AggregationHashTable(exec_ctx->GetMemoryPool(), sizeof(AggTuple));
+  };
+
+  auto destroy_ht = [](void *ctx, void *aht) {
+    reinterpret_cast<AggregationHashTable *>(aht)->~AggregationHashTable();
+  };
+
+  auto merge = [](void *ctx, AggregationHashTable *table, AggregationOverflowPartitionIterator *iter) {
+    for (; iter->HasNext(); iter->Next()) {
+      auto *partial_agg = iter->GetPayloadAs<AggTuple>();
+      auto *existing = reinterpret_cast<AggTuple *>(table->Lookup(iter->GetHash(), AggAggKeyEq, partial_agg));
+      if (existing != nullptr) {
+        existing->Merge(*partial_agg);
+      } else {
+        auto *new_agg = table->Insert(iter->GetHash());
+        new (new_agg) AggTuple(*partial_agg);
+      }
+    }
+  };
+
+  struct QS {
+    std::atomic<uint64_t> num_groups_;
+    std::atomic<uint64_t> count_;
+  };
+
+  auto scan = [](void *query_state, void *thread_state, const AggregationHashTable *agg_table) {
+    auto *qs = reinterpret_cast<QS *>(query_state);
+    uint64_t count = 0;
+    for (AggregationHashTableIterator iter(*agg_table); iter.HasNext(); iter.Next()) {
+      count += reinterpret_cast<const AggTuple *>(iter.GetCurrentAggregateRow())->count1_;
+    }
+    qs->num_groups_ += agg_table->NumElements();
+    qs->count_ += count;
+  };
+
+  auto *projected_columns = MakeProjectedColumns();
+  alignas(common::Constants::CACHELINE_SIZE) uint32_t keys[common::Constants::K_DEFAULT_VECTOR_SIZE];
+  alignas(common::Constants::CACHELINE_SIZE) uint32_t vals[common::Constants::K_DEFAULT_VECTOR_SIZE];
+  const uint32_t num_batches = 200;
+
+  // With a few groups, pre-aggregation folds nearly all input. With unique keys it reduces nothing, and input should be
+  // passed through.
+  for (const uint32_t num_groups : {16u, num_batches * common::Constants::K_DEFAULT_VECTOR_SIZE}) {
+    ThreadStateContainer container(exec_ctx_->GetMemoryPool());
+    container.Reset(sizeof(AggregationHashTable), init_ht, destroy_ht, exec_ctx_.get());
+    auto *thread_table = container.AccessThreadStateOfCurrentThreadAs<AggregationHashTable>();
+
+    for (uint32_t batch = 0; batch < num_batches; batch++) {
+      for (uint32_t idx = 0; idx < common::Constants::K_DEFAULT_VECTOR_SIZE; idx++) {
+        keys[idx] = (batch * common::Constants::K_DEFAULT_VECTOR_SIZE + idx) % num_groups;
+        vals[idx] = 1;
+      }
+      std::memcpy(projected_columns->ColumnStart(0), keys, sizeof(keys));
+      std::memcpy(projected_columns->ColumnStart(1), vals, sizeof(vals));
+
+      ProjectedColumnsIterator pci(projected_columns);
+      ProjectedColumnsIterator *iters[] = {&pci};
+      thread_table->ProcessBatch(iters, hash_fn, key_eq, init_agg, advance_agg, true);
+    }
+
+    if (num_groups == 16) {
+      EXPECT_EQ(0, thread_table->GetStats()->num_pass_through_);
+    } else {
+      EXPECT_LT(0, thread_table->GetStats()->num_pass_through_);
+    }
+
+    // Whichever way the input reached the partitions, the final aggregates must be the same
+    AggregationHashTable main_table(exec_ctx_->GetMemoryPool(), sizeof(AggTuple));
+    main_table.TransferMemoryAndPartitions(&container, 0, merge);
+    container.Clear();
+
+    QS qstate{{0}, {0}};
+    main_table.ExecuteParallelPartitionedScan(&qstate, &container, scan);
+    EXPECT_EQ(num_groups, qstate.num_groups_.load());
+    EXPECT_EQ(num_batches * common::Constants::K_DEFAULT_VECTOR_SIZE, qstate.count_.load());
+  }
+
+  FreeProjectedColumns();
+}
+
 }  // namespace terrier::execution::sql::test
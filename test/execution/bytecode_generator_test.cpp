@@ -320,4 +320,36 @@ TEST_F(BytecodeGeneratorTest, FunctionTest) {
   EXPECT_EQ(20, s.b_);
 }
 
+// NOLINTNEXTLINE
+TEST_F(BytecodeGeneratorTest, HotnessTest) {
+  // The interpreter counts invocations and loop iterations of each function
+  auto src = R"(
+    fun inc(x: int32) -> int32 {
+      return x + 1
+    }
+    fun test() -> int32 {
+      var sum : int32 = 0
+      for (var i : int32 = 0; i < 10; i = i + 1) {
+        sum = inc(sum)
+      }
+      return sum
+    })";
+  auto compiler = ModuleCompiler();
+  auto module = compiler.CompileToModule(src);
+  ASSERT_TRUE(module != nullptr);
+
+  std::function<int32_t()> f;
+  EXPECT_TRUE(module->GetFunction("test", ExecutionMode::Interpret, &f)) << "Function 'test' not found in module";
+  const auto test_id = module->GetFuncInfoByName("test")->Id();
+  const auto inc_id = module->GetFuncInfoByName("inc")->Id();
+  EXPECT_EQ(0u, module->GetHotness(test_id));
+
+  EXPECT_EQ(10, f());
+  EXPECT_EQ(10, f());
+  // Two invocations of ten iterations each
+  EXPECT_EQ(22u, module->GetHotness(test_id));
+  // Loop iterations of the caller don't count towards the callee
+  EXPECT_EQ(20u, module->GetHotness(inc_id));
+}
+
 }  // namespace terrier::execution::vm::test
@@ -35,6 +35,7 @@
 #include "planner/plannodes/output_schema.h"
 #include "planner/plannodes/projection_plan_node.h"
 #include "planner/plannodes/seq_scan_plan_node.h"
+#include "planner/plannodes/set_op_plan_node.h"
 #include "planner/plannodes/update_plan_node.h"
 #include "type/transient_value.h"
 #include "type/transient_value_factory.h"
@@ -218,6 +219,79 @@ TEST_F(CompilerTest, SimpleSeqScanWithProjectionTest) {
   EXPECT_TRUE(CheckFeatureVectorEquality(feature_vec, exp_vec));
 }
 
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, SeqScanWithOverflowingProjectionTest) {
+  // SELECT col1, col1 * 2^30 * 2^30 * 8, (col1 * 2^30 * 2^30 * 8) + (col1 * 2^30 * 2^30 * 8) FROM test_1
+  // WHERE col1 < 500;
+  // The projection is computed a vector at a time. Results that overflow wrap around like they do tuple at a time:
+  // col1 * 2^63 is 0 or INT64_MIN, and twice that is always 0.
+  auto accessor = MakeAccessor();
+  auto table_oid = accessor->GetTableOid(NSOid(), "test_1");
+  auto table_schema = accessor->GetSchema(table_oid);
+  ExpressionMaker expr_maker;
+  std::unique_ptr<planner::AbstractPlanNode> seq_scan;
+  OutputSchemaHelper seq_scan_out{0, &expr_maker};
+  {
+    auto cola_oid = table_schema.GetColumn("colA").Oid();
+    auto col1 = expr_maker.CVE(cola_oid, type::TypeId::INTEGER);
+    seq_scan_out.AddOutput("col1", common::ManagedPointer(col1));
+    auto schema = seq_scan_out.MakeSchema();
+    auto predicate = expr_maker.ComparisonLt(col1, expr_maker.Constant(500));
+    planner::SeqScanPlanNode::Builder builder;
+    seq_scan = builder.SetOutputSchema(std::move(schema))
+                   .SetColumnOids({cola_oid})
+                   .SetScanPredicate(predicate)
+                   .SetIsForUpdateFlag(false)
+                   .SetNamespaceOid(NSOid())
+                   .SetTableOid(table_oid)
+                   .Build();
+  }
+  std::unique_ptr<planner::AbstractPlanNode> proj;
+  OutputSchemaHelper proj_out{0, &expr_maker};
+  {
+    auto col1 = seq_scan_out.GetOutput("col1");
+    auto times_2_63 = [&] {
+      const int32_t two_30 = 1 << 30;
+      return expr_maker.OpMul(expr_maker.OpMul(expr_maker.OpMul(col1, expr_maker.Constant(two_30)),
+                                               expr_maker.Constant(two_30)),
+                              expr_maker.Constant(8));
+    };
+    auto col2 = times_2_63();
+    auto col3 = expr_maker.OpSum(times_2_63(), times_2_63());
+    proj_out.AddOutput("col1", common::ManagedPointer(col1));
+    proj_out.AddOutput("col2", common::ManagedPointer(col2));
+    proj_out.AddOutput("col3", common::ManagedPointer(col3));
+    auto schema = proj_out.MakeSchema();
+    planner::ProjectionPlanNode::Builder builder;
+    proj = builder.SetOutputSchema(std::move(schema)).AddChild(std::move(seq_scan)).Build();
+  }
+
+  // Make the output checker
+  uint32_t num_rows = 0;
+  RowChecker row_checker = [&](const std::vector<sql::Val *> &vals) {
+    auto col1 = static_cast<sql::Integer *>(vals[0]);
+    auto col2 = static_cast<sql::Integer *>(vals[1]);
+    auto col3 = static_cast<sql::Integer *>(vals[2]);
+    ASSERT_FALSE(col1->is_null_ || col2->is_null_ || col3->is_null_);
+    EXPECT_EQ(col1->val_ % 2 == 0 ? 0 : std::numeric_limits<int64_t>::min(), col2->val_);
+    EXPECT_EQ(0, col3->val_);
+    num_rows++;
+  };
+  CorrectnessFn correctness_fn = [&]() { EXPECT_EQ(500, num_rows); };
+  GenericChecker checker(row_checker, correctness_fn);
+
+  // Create the execution context
+  OutputStore store{&checker, proj->GetOutputSchema().Get()};
+  exec::OutputPrinter printer(proj->GetOutputSchema().Get());
+  MultiOutputCallback callback{std::vector<exec::OutputCallback>{store, printer}};
+  auto exec_ctx = MakeExecCtx(std::move(callback), proj->GetOutputSchema().Get());
+
+  // Run & Check
+  auto executable = ExecutableQuery(common::ManagedPointer(proj), common::ManagedPointer(exec_ctx));
+  executable.Run(common::ManagedPointer(exec_ctx), MODE);
+  checker.CheckCorrectness();
+}
+
 // NOLINTNEXTLINE
 TEST_F(CompilerTest, SimpleSeqScanWithParamsTest) {
   // SELECT col1, col2, col1 * col2, col1 >= param1*col2 FROM test_1 WHERE col1 < param2 AND col2 >= param3;
@@ -2315,6 +2389,172 @@ TEST_F(CompilerTest, SimpleIndexNestedLoopJoinMultiColumnTest) {
   EXPECT_TRUE(CheckFeatureVectorEquality(feature_vec0, exp_vec0));
 }
 
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, SimpleSetOpTest) {
+  // SELECT colB FROM test_1 WHERE colA < 500 <set op> SELECT colB FROM test_1 WHERE colA < 200
+  // colB has 10 distinct values, which all occur in both sides. Every row of the right side is also a row of the left
+  // side, so the right side never has more copies of a value than the left side.
+  auto accessor = MakeAccessor();
+  auto table_oid = accessor->GetTableOid(NSOid(), "test_1");
+  auto table_schema = accessor->GetSchema(table_oid);
+  const std::vector<std::pair<planner::SetOpType, int64_t>> set_ops = {
+      {planner::SetOpType::INTERSECT, 10}, {planner::SetOpType::INTERSECT_ALL, 200},
+      {planner::SetOpType::EXCEPT, 0},     {planner::SetOpType::EXCEPT_ALL, 300},
+      {planner::SetOpType::UNION, 10},     {planner::SetOpType::UNION_ALL, 700}};
+
+  for (const auto &set_op : set_ops) {
+    ExpressionMaker expr_maker;
+    auto make_seq_scan = [&](OutputSchemaHelper *seq_scan_out, int32_t max_col_a) {
+      // OIDs
+      auto cola_oid = table_schema.GetColumn("colA").Oid();
+      auto colb_oid = table_schema.GetColumn("colB").Oid();
+      // Get Table columns
+      auto col1 = expr_maker.CVE(cola_oid, type::TypeId::INTEGER);
+      auto col2 = expr_maker.CVE(colb_oid, type::TypeId::INTEGER);
+      seq_scan_out->AddOutput("col2", col2);
+      auto schema = seq_scan_out->MakeSchema();
+      // Make predicate
+      auto predicate = expr_maker.ComparisonLt(col1, expr_maker.Constant(max_col_a));
+      // Build
+      planner::SeqScanPlanNode::Builder builder;
+      return builder.SetOutputSchema(std::move(schema))
+          .SetColumnOids({cola_oid, colb_oid})
+          .SetScanPredicate(predicate)
+          .SetIsForUpdateFlag(false)
+          .SetNamespaceOid(NSOid())
+          .SetTableOid(table_oid)
+          .Build();
+    };
+    OutputSchemaHelper seq_scan_out1{0, &expr_maker};
+    OutputSchemaHelper seq_scan_out2{1, &expr_maker};
+    auto seq_scan1 = make_seq_scan(&seq_scan_out1, 500);
+    auto seq_scan2 = make_seq_scan(&seq_scan_out2, 200);
+
+    // Make the set operation
+    std::unique_ptr<planner::AbstractPlanNode> set_op_node;
+    OutputSchemaHelper set_op_out{0, &expr_maker};
+    {
+      set_op_out.AddOutput("col2", seq_scan_out1.GetOutput("col2"));
+      auto schema = set_op_out.MakeSchema();
+      planner::SetOpPlanNode::Builder builder;
+      set_op_node = builder.AddChild(std::move(seq_scan1))
+                        .AddChild(std::move(seq_scan2))
+                        .SetOutputSchema(std::move(schema))
+                        .SetSetOp(set_op.first)
+                        .Build();
+    }
+
+    // Compile and Run
+    NumChecker num_checker(set_op.second);
+    OutputStore store{&num_checker, set_op_node->GetOutputSchema().Get()};
+    exec::OutputPrinter printer(set_op_node->GetOutputSchema().Get());
+    MultiOutputCallback callback{std::vector<exec::OutputCallback>{store, printer}};
+    auto exec_ctx = MakeExecCtx(std::move(callback), set_op_node->GetOutputSchema().Get());
+    auto executable = ExecutableQuery(common::ManagedPointer(set_op_node), common::ManagedPointer(exec_ctx));
+    executable.Run(common::ManagedPointer(exec_ctx), MODE);
+    num_checker.CheckCorrectness();
+
+    // Pipeline Units
+    auto pipeline = executable.GetPipelineOperatingUnits();
+    if (set_op.first == planner::SetOpType::UNION_ALL) {
+      // Both sides are scanned in the output pipeline, without a hash table
+      EXPECT_EQ(pipeline->units_.size(), 1);
+      auto feature_vec0 = pipeline->GetPipelineFeatures(execution::pipeline_id_t(0));
+      auto exp_vec0 = std::vector<brain::ExecutionOperatingUnitType>{
+          brain::ExecutionOperatingUnitType::OP_INTEGER_COMPARE, brain::ExecutionOperatingUnitType::SEQ_SCAN};
+      EXPECT_TRUE(CheckFeatureVectorEquality(feature_vec0, exp_vec0));
+      continue;
+    }
+    EXPECT_EQ(pipeline->units_.size(), 3);
+    auto feature_vec0 = pipeline->GetPipelineFeatures(execution::pipeline_id_t(0));
+    auto feature_vec2 = pipeline->GetPipelineFeatures(execution::pipeline_id_t(2));
+    auto exp_vec0 = std::vector<brain::ExecutionOperatingUnitType>{
+        brain::ExecutionOperatingUnitType::AGGREGATE_BUILD, brain::ExecutionOperatingUnitType::OP_INTEGER_COMPARE,
+        brain::ExecutionOperatingUnitType::SEQ_SCAN};
+    auto exp_vec2 =
+        std::vector<brain::ExecutionOperatingUnitType>{brain::ExecutionOperatingUnitType::AGGREGATE_ITERATE};
+    EXPECT_TRUE(CheckFeatureVectorEquality(feature_vec0, exp_vec0));
+    EXPECT_TRUE(CheckFeatureVectorEquality(feature_vec2, exp_vec2));
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, SetOpNullKeyTest) {
+  // SELECT col2 FROM test_2 <set op> SELECT col2 FROM test_2 WHERE col2 IS NOT NULL
+  // col2 has 10 distinct values and some NULLs. Set operations treat NULLs as equal to each other, and different from
+  // every other value, so the NULLs of the left side only match other NULLs.
+  auto accessor = MakeAccessor();
+  auto table_oid = accessor->GetTableOid(NSOid(), "test_2");
+  auto table_schema = accessor->GetSchema(table_oid);
+  struct Expected {
+    planner::SetOpType set_op_;
+    int64_t num_rows_;
+    int64_t num_nulls_;
+  };
+  const std::vector<Expected> set_ops = {
+      {planner::SetOpType::UNION, 11, 1}, {planner::SetOpType::INTERSECT, 10, 0}, {planner::SetOpType::EXCEPT, 1, 1}};
+
+  for (const auto &expected : set_ops) {
+    ExpressionMaker expr_maker;
+    auto make_seq_scan = [&](OutputSchemaHelper *seq_scan_out, bool skip_nulls) {
+      auto col2_oid = table_schema.GetColumn("col2").Oid();
+      auto col2 = expr_maker.CVE(col2_oid, type::TypeId::INTEGER);
+      seq_scan_out->AddOutput("col2", col2);
+      auto schema = seq_scan_out->MakeSchema();
+      ExpressionMaker::ManagedExpression predicate = nullptr;
+      if (skip_nulls) {
+        predicate = expr_maker.Operator(parser::ExpressionType::OPERATOR_IS_NOT_NULL, type::TypeId::BOOLEAN, col2);
+      }
+      planner::SeqScanPlanNode::Builder builder;
+      return builder.SetOutputSchema(std::move(schema))
+          .SetColumnOids({col2_oid})
+          .SetScanPredicate(predicate)
+          .SetIsForUpdateFlag(false)
+          .SetNamespaceOid(NSOid())
+          .SetTableOid(table_oid)
+          .Build();
+    };
+    OutputSchemaHelper seq_scan_out1{0, &expr_maker};
+    OutputSchemaHelper seq_scan_out2{1, &expr_maker};
+    auto seq_scan1 = make_seq_scan(&seq_scan_out1, false);
+    auto seq_scan2 = make_seq_scan(&seq_scan_out2, true);
+
+    // Make the set operation
+    std::unique_ptr<planner::AbstractPlanNode> set_op_node;
+    OutputSchemaHelper set_op_out{0, &expr_maker};
+    {
+      set_op_out.AddOutput("col2", seq_scan_out1.GetOutput("col2"));
+      auto schema = set_op_out.MakeSchema();
+      planner::SetOpPlanNode::Builder builder;
+      set_op_node = builder.AddChild(std::move(seq_scan1))
+                        .AddChild(std::move(seq_scan2))
+                        .SetOutputSchema(std::move(schema))
+                        .SetSetOp(expected.set_op_)
+                        .Build();
+    }
+
+    // Count the rows, and the NULLs among them
+    int64_t num_rows = 0;
+    int64_t num_nulls = 0;
+    RowChecker row_checker = [&](const std::vector<sql::Val *> &vals) {
+      num_rows++;
+      if (vals[0]->is_null_) num_nulls++;
+    };
+    CorrectnessFn correctness_fn = [&]() {
+      EXPECT_EQ(expected.num_rows_, num_rows);
+      EXPECT_EQ(expected.num_nulls_, num_nulls);
+    };
+    GenericChecker checker(row_checker, correctness_fn);
+    OutputStore store{&checker, set_op_node->GetOutputSchema().Get()};
+    exec::OutputPrinter printer(set_op_node->GetOutputSchema().Get());
+    MultiOutputCallback callback{std::vector<exec::OutputCallback>{store, printer}};
+    auto exec_ctx = MakeExecCtx(std::move(callback), set_op_node->GetOutputSchema().Get());
+    auto executable = ExecutableQuery(common::ManagedPointer(set_op_node), common::ManagedPointer(exec_ctx));
+    executable.Run(common::ManagedPointer(exec_ctx), MODE);
+    checker.CheckCorrectness();
+  }
+}
+
 // NOLINTNEXTLINE
 TEST_F(CompilerTest, SimpleDeleteTest) {
   // DELETE FROM test_1 WHERE colA BETWEEN 495 AND 505
@@ -0,0 +1,190 @@
+#include "execution/sql/csv_loader.h"
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "catalog/catalog_accessor.h"
+#include "catalog/catalog_defs.h"
+#include "common/exception.h"
+#include "execution/sql/ddl_executors.h"
+#include "main/db_main.h"
+#include "planner/plannodes/create_index_plan_node.h"
+#include "planner/plannodes/create_table_plan_node.h"
+#include "storage/index/index.h"
+#include "storage/sql_table.h"
+#include "test_util/catalog_test_util.h"
+#include "test_util/test_harness.h"
+#include "transaction/transaction_manager.h"
+#include "transaction/transaction_util.h"
+
+namespace terrier::execution::sql::test {
+
+class CSVLoaderTests : public TerrierTest {
+ public:
+  void SetUp() override {
+    db_main_ = terrier::DBMain::Builder().SetUseGC(true).SetUseCatalog(true).Build();
+    catalog_ = db_main_->GetCatalogLayer()->GetCatalog();
+    txn_manager_ = db_main_->GetTransactionLayer()->GetTransactionManager();
+    auto *txn = txn_manager_->BeginTransaction();
+    db_ = catalog_->GetDatabaseOid(common::ManagedPointer(txn), catalog::DEFAULT_DATABASE);
+    txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    txn_ = txn_manager_->BeginTransaction();
+    accessor_ = catalog_->GetAccessor(common::ManagedPointer(txn_), db_);
+
+    // CREATE TABLE foo (id INTEGER NOT NULL, name VARCHAR(100)); CREATE UNIQUE INDEX ON foo (id);
+    std::vector<catalog::Schema::Column> cols;
+    cols.emplace_back("id", type::TypeId::INTEGER, false,
+                      parser::ConstantValueExpression(type::TransientValueFactory::GetNull(type::TypeId::INTEGER)));
+    cols.emplace_back("name", type::TypeId::VARCHAR, 100, true,
+                      parser::ConstantValueExpression(type::TransientValueFactory::GetNull(type::TypeId::VARCHAR)));
+    planner::CreateTablePlanNode::Builder table_builder;
+    auto create_table = table_builder.SetNamespaceOid(CatalogTestUtil::TEST_NAMESPACE_OID)
+                            .SetTableSchema(std::make_unique<catalog::Schema>(cols))
+                            .SetTableName("foo")
+                            .SetBlockStore(db_main_->GetStorageLayer()->GetBlockStore())
+                            .Build();
+    EXPECT_TRUE(DDLExecutors::CreateTableExecutor(common::ManagedPointer(create_table),
+                                                  common::ManagedPointer(accessor_), db_));
+    table_oid_ = accessor_->GetTableOid(CatalogTestUtil::TEST_NAMESPACE_OID, "foo");
+
+    const auto id_oid = accessor_->GetSchema(table_oid_).GetColumn("id").Oid();
+    std::vector<catalog::IndexSchema::Column> key_cols;
+    key_cols.emplace_back("", type::TypeId::INTEGER, false, parser::ColumnValueExpression(db_, table_oid_, id_oid));
+    planner::CreateIndexPlanNode::Builder index_builder;
+    auto create_index = index_builder.SetNamespaceOid(CatalogTestUtil::TEST_NAMESPACE_OID)
+                            .SetTableOid(table_oid_)
+                            .SetSchema(std::make_unique<catalog::IndexSchema>(
+                                key_cols, storage::index::IndexType::BWTREE, true, true, false, true))
+                            .SetIndexName("foo_id")
+                            .Build();
+    EXPECT_TRUE(DDLExecutors::CreateIndexExecutor(common::ManagedPointer(create_index),
+                                                  common::ManagedPointer(accessor_)));
+    index_oid_ = accessor_->GetIndexOid(CatalogTestUtil::TEST_NAMESPACE_OID, "foo_id");
+  }
+
+  void TearDown() override {
+    txn_manager_->Abort(txn_);
+    std::remove(FILE_PATH);
+  }
+
+  static void WriteFile(const std::string &contents) {
+    std::ofstream file(FILE_PATH, std::ios::out | std::ios::trunc | std::ios::binary);
+    file << contents;
+  }
+
+  uint64_t Load() {
+    CSVLoader loader{common::ManagedPointer(txn_), common::ManagedPointer(accessor_), db_, table_oid_, ',', '"', '"'};
+    return loader.Load(FILE_PATH);
+  }
+
+  uint64_t Load(const std::string &contents) {
+    CSVLoader loader{common::ManagedPointer(txn_), common::ManagedPointer(accessor_), db_, table_oid_, ',', '"', '"'};
+    return loader.Load(contents.data(), contents.size());
+  }
+
+  // Look up id in the index, and return the row's name column or "NULL"
+  std::string LookUp(const int32_t id) {
+    const auto index = accessor_->GetIndex(index_oid_);
+    auto *const key_buffer =
+        common::AllocationUtil::AllocateAligned(index->GetProjectedRowInitializer().ProjectedRowSize());
+    auto *const key = index->GetProjectedRowInitializer().InitializeRow(key_buffer);
+    *reinterpret_cast<int32_t *>(key->AccessForceNotNull(0)) = id;
+    std::vector<storage::TupleSlot> slots;
+    index->ScanKey(*txn_, *key, &slots);
+    delete[] key_buffer;
+    EXPECT_EQ(slots.size(), 1);
+
+    const auto table = accessor_->GetTable(table_oid_);
+    const auto name_oid = accessor_->GetSchema(table_oid_).GetColumn("name").Oid();
+    const auto initializer = table->InitializerForProjectedRow({name_oid});
+    auto *const row_buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+    auto *const row = initializer.InitializeRow(row_buffer);
+    EXPECT_TRUE(table->Select(common::ManagedPointer(txn_), slots[0], row));
+    const auto *const name = reinterpret_cast<const storage::VarlenEntry *>(row->AccessWithNullCheck(0));
+    std::string result = name == nullptr ? "NULL" : std::string(name->StringView());
+    delete[] row_buffer;
+    return result;
+  }
+
+  static constexpr const char *FILE_PATH = "csv_loader_test.csv";
+
+  std::unique_ptr<DBMain> db_main_;
+  common::ManagedPointer<catalog::Catalog> catalog_;
+  common::ManagedPointer<transaction::TransactionManager> txn_manager_;
+  catalog::db_oid_t db_;
+  catalog::table_oid_t table_oid_;
+  catalog::index_oid_t index_oid_;
+  transaction::TransactionContext *txn_;
+  std::unique_ptr<catalog::CatalogAccessor> accessor_;
+};
+
+// Quoted fields may contain delimiters, newlines and doubled quotes, and an unquoted empty field is NULL
+// NOLINTNEXTLINE
+TEST_F(CSVLoaderTests, LoadQuotedFields) {
+  WriteFile(
+      "1,plain\n"
+      "2,\"with, comma\"\r\n"
+      "3,\"with \"\"quotes\"\"\"\n"
+      "4,\"multi\nline\"\n"
+      "5,\n"
+      "6,\"\"\n"
+      "7,a string that is too long to be stored inline in a varlen entry");
+  EXPECT_EQ(Load(), 7);
+  EXPECT_EQ(LookUp(1), "plain");
+  EXPECT_EQ(LookUp(2), "with, comma");
+  EXPECT_EQ(LookUp(3), "with \"quotes\"");
+  EXPECT_EQ(LookUp(4), "multi\nline");
+  EXPECT_EQ(LookUp(5), "NULL");
+  EXPECT_EQ(LookUp(6), "");
+  EXPECT_EQ(LookUp(7), "a string that is too long to be stored inline in a varlen entry");
+}
+
+// A file large enough to be split across several parsing tasks loads every row exactly once
+// NOLINTNEXTLINE
+TEST_F(CSVLoaderTests, LoadLargeFile) {
+  const int32_t num_rows = 200000;
+  std::string contents;
+  for (int32_t i = 0; i < num_rows; i++) {
+    contents += std::to_string(i) + ",\"row\n" + std::to_string(i) + "\"\n";
+  }
+  WriteFile(contents);
+  EXPECT_GT(contents.size(), 2 * CSVLoader::MIN_CHUNK_SIZE);
+  EXPECT_EQ(Load(), num_rows);
+  for (int32_t i = 0; i < num_rows; i += 9973) EXPECT_EQ(LookUp(i), "row\n" + std::to_string(i));
+}
+
+// Data sent by the client for COPY ... FROM STDIN is loaded from memory the same way, including its indexes
+// NOLINTNEXTLINE
+TEST_F(CSVLoaderTests, LoadFromMemory) {
+  EXPECT_EQ(Load(std::string("1,first\n2,\"second\"\n3,")), 3);
+  EXPECT_EQ(LookUp(1), "first");
+  EXPECT_EQ(LookUp(2), "second");
+  EXPECT_EQ(LookUp(3), "NULL");
+  EXPECT_EQ(Load(std::string()), 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(CSVLoaderTests, MalformedFile) {
+  WriteFile("1,ok\nnot a number,bad\n");
+  EXPECT_THROW(Load(), ConversionException);
+}
+
+// NOLINTNEXTLINE
+TEST_F(CSVLoaderTests, NullInNotNullColumn) {
+  WriteFile(",no id\n");
+  EXPECT_THROW(Load(), ConversionException);
+}
+
+// NOLINTNEXTLINE
+TEST_F(CSVLoaderTests, DuplicateKey) {
+  WriteFile("1,first\n1,second\n");
+  EXPECT_THROW(Load(), ExecutionException);
+}
+
+}  // namespace terrier::execution::sql::test
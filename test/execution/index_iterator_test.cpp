@@ -2,6 +2,7 @@
 
 #include <array>
 #include <memory>
+#include <vector>
 
 #include "catalog/catalog_defs.h"
 #include "execution/sql/table_vector_iterator.h"
@@ -70,6 +71,59 @@ TEST_F(IndexIteratorTest, SimpleIndexIteratorTest) {
   }
 }
 
+// NOLINTNEXTLINE
+TEST_F(IndexIteratorTest, SimpleBatchedKeyScanTest) {
+  //
+  // Look up the keys of each vector of the table in a single batch
+  //
+
+  auto table_oid = exec_ctx_->GetAccessor()->GetTableOid(NSOid(), "test_1");
+  auto index_oid = exec_ctx_->GetAccessor()->GetIndexOid(NSOid(), "index_1");
+  std::array<uint32_t, 1> col_oids{1};
+  TableVectorIterator table_iter(exec_ctx_.get(), !table_oid, col_oids.data(), static_cast<uint32_t>(col_oids.size()));
+  IndexIterator index_iter{
+      exec_ctx_.get(), 1, !table_oid, !index_oid, col_oids.data(), static_cast<uint32_t>(col_oids.size())};
+  table_iter.Init();
+  index_iter.Init();
+  ProjectedColumnsIterator *pci = table_iter.GetProjectedColumnsIterator();
+
+  uint32_t num_tuples = 0, num_vectors = 0, num_found = 0;
+  while (table_iter.Advance()) {
+    num_vectors++;
+    // Add every key of the vector, with a missing key and a duplicate in between
+    std::vector<int32_t> keys;
+    for (; pci->HasNext(); pci->Advance()) {
+      keys.emplace_back(*pci->Get<int32_t, false>(0, nullptr));
+      num_tuples++;
+      if (keys.size() == 2) keys.emplace_back(-1);
+      if (keys.size() == 4) keys.emplace_back(keys[0]);
+    }
+    pci->Reset();
+    for (const auto key : keys) {
+      index_iter.PR()->Set<int32_t, false>(0, key, false);
+      index_iter.AddKey();
+    }
+    index_iter.ScanKeys();
+
+    // The results of each key come back in the order the keys were added
+    for (const auto key : keys) {
+      index_iter.ScanNextKey();
+      if (key == -1) {
+        ASSERT_FALSE(index_iter.Advance());
+        continue;
+      }
+      ASSERT_TRUE(index_iter.Advance());
+      auto *val = index_iter.TablePR()->Get<int32_t, false>(0, nullptr);
+      ASSERT_EQ(key, *val);
+      ASSERT_FALSE(index_iter.Advance());
+      num_found++;
+    }
+  }
+  // Every tuple is found once, plus one duplicate per vector
+  ASSERT_EQ(sql::TEST1_SIZE, num_tuples);
+  ASSERT_EQ(num_tuples + num_vectors, num_found);
+}
+
 // NOLINTNEXTLINE
 TEST_F(IndexIteratorTest, SimpleAscendingScanTest) {
   //
@@ -128,6 +182,92 @@ TEST_F(IndexIteratorTest, SimpleLimitAscendingScanTest) {
   ASSERT_EQ(num_matches, 5);
 }
 
+// NOLINTNEXTLINE
+TEST_F(IndexIteratorTest, SimpleStreamAscendingScanTest) {
+  //
+  // Perform streaming ascending scans, over a range spanning several batches and with a limit
+  //
+
+  auto table_oid = exec_ctx_->GetAccessor()->GetTableOid(NSOid(), "test_1");
+  auto index_oid = exec_ctx_->GetAccessor()->GetIndexOid(NSOid(), "index_1");
+  std::array<uint32_t, 1> col_oids{1};
+  IndexIterator index_iter{
+      exec_ctx_.get(), 1, !table_oid, !index_oid, col_oids.data(), static_cast<uint32_t>(col_oids.size())};
+  index_iter.Init();
+  auto *const lo_pr(index_iter.LoPR());
+  auto *const hi_pr(index_iter.HiPR());
+  lo_pr->Set<int32_t, false>(0, 100, false);
+  hi_pr->Set<int32_t, false>(0, 1099, false);
+  index_iter.StreamAscending(storage::index::ScanType::Closed, 0);
+  int32_t curr_match = 100;
+  uint32_t num_matches = 0;
+  while (index_iter.Advance()) {
+    auto *const table_pr(index_iter.TablePR());
+    auto *val = table_pr->Get<int32_t, false>(0, nullptr);
+    EXPECT_EQ(*val, curr_match);
+    curr_match++;
+    num_matches++;
+  }
+  ASSERT_EQ(num_matches, 1000);
+
+  // The same iterator can be reused for another scan
+  lo_pr->Set<int32_t, false>(0, 495, false);
+  hi_pr->Set<int32_t, false>(0, 505, false);
+  index_iter.StreamAscending(storage::index::ScanType::Closed, 5);
+  curr_match = 495;
+  num_matches = 0;
+  while (index_iter.Advance()) {
+    auto *const table_pr(index_iter.TablePR());
+    auto *val = table_pr->Get<int32_t, false>(0, nullptr);
+    EXPECT_EQ(*val, curr_match);
+    curr_match++;
+    num_matches++;
+  }
+  ASSERT_EQ(num_matches, 5);
+}
+
+// NOLINTNEXTLINE
+TEST_F(IndexIteratorTest, SimpleCoveringScanTest) {
+  //
+  // Read the indexed column from the index keys, without going to the table
+  //
+
+  auto table_oid = exec_ctx_->GetAccessor()->GetTableOid(NSOid(), "test_1");
+  auto index_oid = exec_ctx_->GetAccessor()->GetIndexOid(NSOid(), "index_1");
+  std::array<uint32_t, 1> col_oids{1};
+  IndexIterator index_iter{
+      exec_ctx_.get(), 1, !table_oid, !index_oid, col_oids.data(), static_cast<uint32_t>(col_oids.size())};
+  index_iter.InitCovering();
+  auto *const lo_pr(index_iter.LoPR());
+  auto *const hi_pr(index_iter.HiPR());
+  lo_pr->Set<int32_t, false>(0, 100, false);
+  hi_pr->Set<int32_t, false>(0, 1099, false);
+  index_iter.StreamAscending(storage::index::ScanType::Closed, 0);
+  int32_t curr_match = 100;
+  uint32_t num_matches = 0;
+  while (index_iter.Advance()) {
+    auto *const key_pr(index_iter.TablePR());
+    auto *val = key_pr->Get<int32_t, false>(0, nullptr);
+    EXPECT_EQ(*val, curr_match);
+    curr_match++;
+    num_matches++;
+  }
+  ASSERT_EQ(num_matches, 1000);
+
+  // Exact lookup
+  auto *const pr(index_iter.PR());
+  pr->Set<int32_t, false>(0, 500, false);
+  index_iter.ScanKey();
+  num_matches = 0;
+  while (index_iter.Advance()) {
+    auto *const key_pr(index_iter.TablePR());
+    auto *val = key_pr->Get<int32_t, false>(0, nullptr);
+    EXPECT_EQ(*val, 500);
+    num_matches++;
+  }
+  ASSERT_EQ(num_matches, 1);
+}
+
 // NOLINTNEXTLINE
 TEST_F(IndexIteratorTest, SimpleDescendingScanTest) {
   //
@@ -39,6 +39,32 @@ class JoinHashTableTest : public TplTest {
 
   BloomFilter *BloomFilterFor(JoinHashTable *join_hash_table) { return &join_hash_table->bloom_filter_; }
 
+  // Build the generic table from the given number of radix partitions, regardless of its size, splitting the buffered
+  // tuples into the given number of ranges
+  void BuildPartitioned(JoinHashTable *join_hash_table, uint32_t num_partitions, uint32_t num_ranges) {
+    join_hash_table->generic_hash_table_.SetSize(join_hash_table->NumElements());
+    std::vector<JoinHashTable::EntryRange> ranges;
+    for (uint64_t i = 0; i < num_ranges; i++) {
+      ranges.push_back({join_hash_table, join_hash_table->NumElements() * i / num_ranges,
+                        join_hash_table->NumElements() * (i + 1) / num_ranges});
+    }
+    join_hash_table->BuildGenericHashTablePartitioned(ranges, num_partitions);
+    join_hash_table->built_ = true;
+  }
+
+  // Merge the thread-local tables from the given number of radix partitions, regardless of their size
+  void MergePartitioned(JoinHashTable *join_hash_table, ThreadStateContainer *container, uint32_t num_partitions) {
+    std::vector<JoinHashTable *> tl_join_tables;
+    container->CollectThreadLocalStateElementsAs(&tl_join_tables, 0);
+    uint64_t num_elems = 0;
+    for (auto *jht : tl_join_tables) {
+      num_elems += jht->NumElements();
+    }
+    join_hash_table->generic_hash_table_.SetSize(num_elems);
+    join_hash_table->MergePartitioned(tl_join_tables, num_partitions);
+    join_hash_table->built_ = true;
+  }
+
  private:
   MemoryPool memory_;
 };
@@ -189,6 +215,76 @@ TEST_F(JoinHashTableTest, ParallelBuildTest) {
   main_jht.MergeParallel(&container, 0);
 }
 
+// Count the matches of each of the given keys
+std::vector<uint32_t> CountMatches(JoinHashTable *jht, uint32_t num_tuples) {
+  std::vector<uint32_t> counts(num_tuples, 0);
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    auto hash_val = util::Hasher::Hash(reinterpret_cast<const uint8_t *>(&i), sizeof(i));
+    Tuple probe_tuple = {i, 0, 0, 0};
+    for (auto iter = jht->Lookup<false>(hash_val);
+         iter.HasNext(TupleKeyEq, nullptr, reinterpret_cast<void *>(&probe_tuple));) {
+      EXPECT_EQ(i, reinterpret_cast<const Tuple *>(iter.NextMatch()->payload_)->a_);
+      counts[i]++;
+    }
+  }
+  return counts;
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, PartitionedBuildTest) {
+  const uint32_t num_tuples = 10000;
+  const uint32_t dup_scale_factor = 3;
+
+  // Try fewer and more partitions than the entries of a write-combining line
+  for (const uint32_t num_partitions : {2u, 16u, 64u}) {
+    JoinHashTable join_hash_table(Memory(), sizeof(Tuple), false);
+    PopulateJoinHashTable(&join_hash_table, num_tuples, dup_scale_factor);
+    BuildPartitioned(&join_hash_table, num_partitions, 3);
+
+    EXPECT_EQ(num_tuples * dup_scale_factor, GenericTableFor(&join_hash_table)->NumElements());
+    for (const auto count : CountMatches(&join_hash_table, num_tuples)) {
+      EXPECT_EQ(dup_scale_factor, count);
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, PartitionedMergeTest) {
+  const uint32_t num_tuples = 10000;
+
+  MemoryPool memory(nullptr);
+  ThreadStateContainer container(&memory);
+
+  container.Reset(
+      sizeof(JoinHashTable),
+      [](auto *ctx, auto *s) { new (s) JoinHashTable(reinterpret_cast<MemoryPool *>(ctx), sizeof(Tuple)); },
+      [](auto *ctx, auto *s) { reinterpret_cast<JoinHashTable *>(s)->~JoinHashTable(); }, &memory);
+
+  // Parallel populate hash tables
+  tbb::task_scheduler_init sched;
+  tbb::blocked_range<std::size_t> block_range(0, 4, 1);
+  tbb::parallel_for(block_range, [&](const auto &range) {
+    auto *jht = container.AccessThreadStateOfCurrentThreadAs<JoinHashTable>();
+    PopulateJoinHashTable(jht, num_tuples, 1);
+  });
+
+  // Every thread-local table holds each key once
+  std::vector<JoinHashTable *> tl_join_tables;
+  container.CollectThreadLocalStateElementsAs(&tl_join_tables, 0);
+  uint32_t num_copies = 0;
+  for (auto *jht : tl_join_tables) {
+    num_copies += (jht->NumElements() > 0 ? 1 : 0);
+  }
+
+  JoinHashTable main_jht(&memory, sizeof(Tuple), false);
+  MergePartitioned(&main_jht, &container, 16);
+
+  EXPECT_EQ(num_tuples * num_copies, GenericTableFor(&main_jht)->NumElements());
+  for (const auto count : CountMatches(&main_jht, num_tuples)) {
+    EXPECT_EQ(num_copies, count);
+  }
+}
+
 // NOLINTNEXTLINE
 TEST_F(JoinHashTableTest, DISABLED_PerfTest) {
   const uint32_t num_tuples = 10000000;
@@ -0,0 +1,113 @@
+#include <string>
+#include <vector>
+
+#include "execution/tpl_test.h"
+
+#include "execution/sql/like_pattern.h"
+#include "execution/util/string_search.h"
+#include "storage/storage_defs.h"
+
+namespace terrier::execution::sql::test {
+
+class LikePatternTest : public TplTest {
+ public:
+  static bool Matches(const std::string &str, const std::string &pattern) {
+    const LikePattern compiled(pattern);
+    const bool result = compiled.Matches(str.data(), str.size());
+    // The compiled pattern must always agree with the generic matcher
+    EXPECT_EQ(result, LikePattern::GenericMatch(str.data(), str.size(), pattern.data(), pattern.size()))
+        << "'" << str << "' LIKE '" << pattern << "'";
+    return result;
+  }
+};
+
+// NOLINTNEXTLINE
+TEST_F(LikePatternTest, ClassifyPatterns) {
+  EXPECT_EQ(LikePattern::Kind::EXACT, LikePattern("abc").GetKind());
+  EXPECT_EQ(LikePattern::Kind::PREFIX, LikePattern("abc%").GetKind());
+  EXPECT_EQ(LikePattern::Kind::PREFIX, LikePattern("abc%%").GetKind());
+  EXPECT_EQ(LikePattern::Kind::SUFFIX, LikePattern("%abc").GetKind());
+  EXPECT_EQ(LikePattern::Kind::SUFFIX, LikePattern("%").GetKind());
+  EXPECT_EQ(LikePattern::Kind::CONTAINS, LikePattern("%abc%").GetKind());
+  EXPECT_EQ(LikePattern::Kind::GENERIC, LikePattern("a_c").GetKind());
+  EXPECT_EQ(LikePattern::Kind::GENERIC, LikePattern("a%c").GetKind());
+  EXPECT_EQ(LikePattern::Kind::GENERIC, LikePattern("abc\\").GetKind());
+
+  // Escaped wildcards are part of the literal
+  LikePattern escaped("100\\%%");
+  EXPECT_EQ(LikePattern::Kind::PREFIX, escaped.GetKind());
+  EXPECT_EQ("100%", escaped.Literal());
+
+  LikePattern custom_escape("#_x%", '#');
+  EXPECT_EQ(LikePattern::Kind::PREFIX, custom_escape.GetKind());
+  EXPECT_EQ("_x", custom_escape.Literal());
+}
+
+// NOLINTNEXTLINE
+TEST_F(LikePatternTest, MatchStrings) {
+  EXPECT_TRUE(Matches("abc", "abc"));
+  EXPECT_FALSE(Matches("abcd", "abc"));
+  EXPECT_TRUE(Matches("abcd", "abc%"));
+  EXPECT_FALSE(Matches("ab", "abc%"));
+  EXPECT_TRUE(Matches("xabc", "%abc"));
+  EXPECT_FALSE(Matches("abcx", "%abc"));
+  EXPECT_TRUE(Matches("xxabcxx", "%abc%"));
+  EXPECT_FALSE(Matches("xxabxcxx", "%abc%"));
+  EXPECT_TRUE(Matches("", "%"));
+  EXPECT_TRUE(Matches("", "%%"));
+  EXPECT_FALSE(Matches("", "_"));
+  EXPECT_TRUE(Matches("abc", "a_c"));
+  EXPECT_FALSE(Matches("abbc", "a_c"));
+  EXPECT_TRUE(Matches("abbbc", "a%c"));
+  EXPECT_TRUE(Matches("aXbXbXc", "a%b%c"));
+  EXPECT_FALSE(Matches("aXbXbX", "a%b%c"));
+  EXPECT_TRUE(Matches("mississippi", "%iss%ppi"));
+  EXPECT_TRUE(Matches("mississippi", "m%s_i%i"));
+  EXPECT_TRUE(Matches("a%b", "a\\%b"));
+  EXPECT_FALSE(Matches("axb", "a\\%b"));
+  EXPECT_TRUE(Matches("a_b", "%\\_%"));
+  EXPECT_FALSE(Matches("ab", "%\\_%"));
+}
+
+// NOLINTNEXTLINE
+TEST_F(LikePatternTest, MatchVarlens) {
+  const std::vector<std::string> strings = {"", "ab", "abcdef", "a string that is too long to be stored inline"};
+  const std::vector<std::string> patterns = {"", "ab", "ab%", "abcd%", "abx%", "%ef", "%inline", "%too%", "a%"};
+  for (const auto &str : strings) {
+    const auto *content = reinterpret_cast<const byte *>(str.data());
+    const auto size = static_cast<uint32_t>(str.size());
+    const auto varlen = size <= storage::VarlenEntry::InlineThreshold()
+                            ? storage::VarlenEntry::CreateInline(content, size)
+                            : storage::VarlenEntry::Create(content, size, false);
+    for (const auto &pattern : patterns) {
+      EXPECT_EQ(Matches(str, pattern), LikePattern(pattern).Matches(varlen))
+          << "'" << str << "' LIKE '" << pattern << "'";
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(LikePatternTest, SubstringSearch) {
+  // Long enough to exercise both the vectorized loop and the scalar tail
+  std::string haystack(200, 'a');
+  haystack.replace(150, 4, "abcd");
+  haystack.replace(190, 3, "xyz");
+
+  EXPECT_EQ(haystack.data(), util::StringSearch::Find(haystack.data(), haystack.size(), "", 0));
+  EXPECT_EQ(haystack.data() + 151, util::StringSearch::Find(haystack.data(), haystack.size(), "bcd", 3));
+  EXPECT_EQ(haystack.data() + 190, util::StringSearch::Find(haystack.data(), haystack.size(), "xyz", 3));
+  EXPECT_EQ(haystack.data() + 191, util::StringSearch::Find(haystack.data(), haystack.size(), "y", 1));
+  EXPECT_EQ(haystack.data() + 148, util::StringSearch::Find(haystack.data(), haystack.size(), "aaabc", 5));
+  EXPECT_EQ(nullptr, util::StringSearch::Find(haystack.data(), haystack.size(), "abce", 4));
+  EXPECT_EQ(nullptr, util::StringSearch::Find(haystack.data(), haystack.size(), "xyzb", 4));
+  EXPECT_EQ(nullptr, util::StringSearch::Find("ab", 2, "abc", 3));
+
+  // Every position of a needle is found, including the last possible one
+  for (uint32_t pos = 0; pos + 2 <= haystack.size(); pos += 7) {
+    std::string str(haystack.size(), '.');
+    str.replace(pos, 2, "#!");
+    EXPECT_EQ(str.data() + pos, util::StringSearch::Find(str.data(), str.size(), "#!", 2));
+  }
+}
+
+}  // namespace terrier::execution::sql::test
@@ -0,0 +1,222 @@
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "llvm/Support/FileSystem.h"
+
+#include "execution/tpl_test.h"
+
+#include "execution/vm/llvm_engine.h"
+#include "execution/vm/module.h"
+#include "execution/vm/module_compiler.h"
+
+namespace terrier::execution::vm::test {
+
+//
+// These tests check how adaptive modules move functions from the interpreter
+// to baseline machine code, and from there to optimized machine code.
+//
+
+class ModuleTest : public TplTest {
+ protected:
+  // Tests only get access to the tiers through the fixture
+  using Tier = Module::Tier;
+
+  static void SetUpTestCase() { LLVMEngine::Initialize(); }
+
+  // Machine code is compiled against the bytecode handlers the build generates
+  // next to the binaries
+  static bool CanCompile() {
+    return llvm::sys::fs::exists(LLVMEngine::CompilerOptions().GetBytecodeHandlersBcPath());
+  }
+
+  static Tier GetTier(const Module &module, const std::string &func_name) {
+    return module.tiers_[module.GetFuncInfoByName(func_name)->Id()];
+  }
+
+  static void *GetImpl(const Module &module, const std::string &func_name) {
+    return module.GetRawFunctionImpl(module.GetFuncInfoByName(func_name)->Id());
+  }
+
+  static void *GetBytecodeImpl(const Module &module, const std::string &func_name) {
+    return module.GetBytecodeImpl(module.GetFuncInfoByName(func_name)->Id());
+  }
+
+  static uint64_t GetHotness(const Module &module, const std::string &func_name) {
+    return module.GetHotness(module.GetFuncInfoByName(func_name)->Id());
+  }
+
+  static void CompileBaseline(Module *module) { module->CompileBaseline(); }
+
+  static void WaitForCompilations(Module *module) {
+    std::unique_lock<std::mutex> lock(module->compile_tasks_mutex_);
+    module->compile_tasks_cv_.wait(lock, [module] { return module->num_compile_tasks_ == 0; });
+  }
+
+  // count() calls inc() once per loop iteration, run() calls count() once
+  // without looping, like the main function of a query calls its pipelines,
+  // unused() is never called
+  static constexpr const char *K_SOURCE = R"(
+    fun inc(x: int32) -> int32 { return x + 1 }
+    fun unused() -> int32 { return 0 }
+    fun count(n: int32) -> int32 {
+      var c = 0
+      for (var i = 0; i < n; i = i + 1) {
+        c = inc(c)
+      }
+      return c
+    }
+    fun run(n: int32) -> int32 { return count(n) })";
+};
+
+// NOLINTNEXTLINE
+TEST_F(ModuleTest, BaselineInstallTest) {
+  if (!CanCompile()) return;
+
+  auto compiler = ModuleCompiler();
+  auto module = compiler.CompileToModule(K_SOURCE);
+  ASSERT_FALSE(compiler.HasErrors());
+
+  for (const auto *name : {"inc", "unused", "count"}) {
+    EXPECT_EQ(Tier::Bytecode, GetTier(*module, name));
+    EXPECT_EQ(GetBytecodeImpl(*module, name), GetImpl(*module, name));
+  }
+
+  std::function<int32_t(int32_t)> count;
+  ASSERT_TRUE(module->GetFunction("count", ExecutionMode::Adaptive, &count));
+  CompileBaseline(module.get());
+  WaitForCompilations(module.get());
+
+  // Nothing ran, so nothing is hot enough to be optimized
+  for (const auto *name : {"inc", "unused", "count"}) {
+    EXPECT_EQ(Tier::Baseline, GetTier(*module, name));
+    EXPECT_NE(GetBytecodeImpl(*module, name), GetImpl(*module, name));
+  }
+
+  EXPECT_EQ(10, count(10));
+  EXPECT_LE(11u, GetHotness(*module, "count"));
+  EXPECT_EQ(10u, GetHotness(*module, "inc"));
+  EXPECT_EQ(0u, GetHotness(*module, "unused"));
+}
+
+// NOLINTNEXTLINE
+TEST_F(ModuleTest, HotRecompileTest) {
+  if (!CanCompile()) return;
+
+  auto compiler = ModuleCompiler();
+  auto module = compiler.CompileToModule(K_SOURCE);
+  ASSERT_FALSE(compiler.HasErrors());
+
+  std::function<int32_t(int32_t)> count;
+  ASSERT_TRUE(module->GetFunction("count", ExecutionMode::Adaptive, &count));
+  CompileBaseline(module.get());
+  WaitForCompilations(module.get());
+  void *baseline_count = GetImpl(*module, "count");
+  void *baseline_unused = GetImpl(*module, "unused");
+
+  // The baseline code counts how hot it gets, which makes both count() and
+  // inc() hot after a single call
+  const auto n = static_cast<int32_t>(Module::K_HOT_THRESHOLD);
+  EXPECT_EQ(n, count(n));
+  EXPECT_LE(Module::K_HOT_THRESHOLD, GetHotness(*module, "count"));
+  EXPECT_LE(Module::K_HOT_THRESHOLD, GetHotness(*module, "inc"));
+  WaitForCompilations(module.get());
+
+  EXPECT_EQ(Tier::Optimized, GetTier(*module, "count"));
+  EXPECT_EQ(Tier::Optimized, GetTier(*module, "inc"));
+  EXPECT_NE(baseline_count, GetImpl(*module, "count"));
+  EXPECT_EQ(Tier::Baseline, GetTier(*module, "unused"));
+  EXPECT_EQ(baseline_unused, GetImpl(*module, "unused"));
+
+  // The optimized code computes the same
+  EXPECT_EQ(n, count(n));
+  EXPECT_EQ(0, count(0));
+}
+
+// NOLINTNEXTLINE
+TEST_F(ModuleTest, HotCalleeTest) {
+  if (!CanCompile()) return;
+
+  auto compiler = ModuleCompiler();
+  auto module = compiler.CompileToModule(K_SOURCE);
+  ASSERT_FALSE(compiler.HasErrors());
+
+  std::function<int32_t(int32_t)> run;
+  ASSERT_TRUE(module->GetFunction("run", ExecutionMode::Adaptive, &run));
+  CompileBaseline(module.get());
+  WaitForCompilations(module.get());
+
+  // A single call of the entry function makes its callees hot, but not itself
+  const auto n = static_cast<int32_t>(Module::K_HOT_THRESHOLD);
+  EXPECT_EQ(n, run(n));
+  WaitForCompilations(module.get());
+  EXPECT_EQ(Tier::Baseline, GetTier(*module, "run"));
+  EXPECT_EQ(Tier::Optimized, GetTier(*module, "count"));
+  EXPECT_EQ(Tier::Optimized, GetTier(*module, "inc"));
+
+  // The baseline code of run() calls the optimized code of count(), which
+  // doesn't count its hotness anymore
+  const uint64_t run_hotness = GetHotness(*module, "run");
+  const uint64_t count_hotness = GetHotness(*module, "count");
+  const uint64_t inc_hotness = GetHotness(*module, "inc");
+  EXPECT_EQ(n, run(n));
+  EXPECT_LT(run_hotness, GetHotness(*module, "run"));
+  EXPECT_EQ(count_hotness, GetHotness(*module, "count"));
+  EXPECT_EQ(inc_hotness, GetHotness(*module, "inc"));
+}
+
+// NOLINTNEXTLINE
+TEST_F(ModuleTest, ConcurrentSwapTest) {
+  if (!CanCompile()) return;
+
+  auto compiler = ModuleCompiler();
+  auto module = compiler.CompileToModule(K_SOURCE);
+  ASSERT_FALSE(compiler.HasErrors());
+
+  std::function<int32_t(int32_t)> count;
+  ASSERT_TRUE(module->GetFunction("count", ExecutionMode::Adaptive, &count));
+
+  // Callers keep running while implementations are swapped underneath them,
+  // from the interpreter to baseline code, and then to optimized code
+  constexpr uint32_t num_threads = 4;
+  constexpr uint32_t num_calls = 200;
+  std::atomic<uint32_t> num_wrong{0};
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i < num_threads; i++) {
+    threads.emplace_back([&count, &num_wrong] {
+      for (uint32_t j = 0; j < num_calls; j++) {
+        if (count(1000) != 1000) num_wrong++;
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  WaitForCompilations(module.get());
+
+  EXPECT_EQ(0u, num_wrong);
+  EXPECT_EQ(Tier::Optimized, GetTier(*module, "count"));
+  EXPECT_EQ(Tier::Optimized, GetTier(*module, "inc"));
+  EXPECT_EQ(1000, count(1000));
+}
+
+// NOLINTNEXTLINE
+TEST_F(ModuleTest, DestroyWhileCompilingTest) {
+  if (!CanCompile()) return;
+
+  // Destroying a module waits for, or cancels, its background compilations
+  for (uint32_t i = 0; i < 10; i++) {
+    auto compiler = ModuleCompiler();
+    auto module = compiler.CompileToModule(K_SOURCE);
+    ASSERT_FALSE(compiler.HasErrors());
+
+    std::function<int32_t(int32_t)> count;
+    ASSERT_TRUE(module->GetFunction("count", ExecutionMode::Adaptive, &count));
+    EXPECT_EQ(5, count(5));
+  }
+}
+
+}  // namespace terrier::execution::vm::test
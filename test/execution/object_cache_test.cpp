@@ -0,0 +1,167 @@
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "execution/tpl_test.h"
+
+#include "execution/vm/llvm_engine.h"
+#include "execution/vm/module.h"
+#include "execution/vm/module_compiler.h"
+#include "execution/vm/object_cache.h"
+
+namespace terrier::execution::vm::test {
+
+class ObjectCacheTest : public TplTest {
+ public:
+  void SetUp() override {
+    TplTest::SetUp();
+    ASSERT_FALSE(llvm::sys::fs::createUniqueDirectory("object_cache_test", directory_));
+  }
+
+  void TearDown() override {
+    llvm::sys::fs::remove_directories(directory_);
+    TplTest::TearDown();
+  }
+
+  std::string Directory() const { return directory_.str().str(); }
+
+  // Object code of the given size, with contents depending on the fill character
+  static std::unique_ptr<llvm::MemoryBuffer> MakeObject(char fill, uint32_t size) {
+    return llvm::MemoryBuffer::getMemBufferCopy(std::string(size, fill));
+  }
+
+  // Paths of all the entries in the directory
+  std::vector<std::string> EntryPaths() const {
+    std::vector<std::string> paths;
+    std::error_code error;
+    for (llvm::sys::fs::directory_iterator iter(directory_, error), end; iter != end && !error;
+         iter.increment(error)) {
+      if (llvm::StringRef(iter->path()).endswith(".tpo")) paths.push_back(iter->path());
+    }
+    return paths;
+  }
+
+ private:
+  llvm::SmallString<128> directory_;
+};
+
+// NOLINTNEXTLINE
+TEST_F(ObjectCacheTest, InsertLookupTest) {
+  ObjectCache cache(Directory(), 1 << 20);
+  EXPECT_EQ(nullptr, cache.Lookup("module a"));
+
+  EXPECT_TRUE(cache.Insert("module a", *MakeObject('a', 100)));
+  EXPECT_TRUE(cache.Insert("module b", *MakeObject('b', 200)));
+  EXPECT_EQ(2u, cache.NumEntries());
+  EXPECT_EQ(2u, EntryPaths().size());
+
+  auto object_a = cache.Lookup("module a");
+  ASSERT_NE(nullptr, object_a);
+  EXPECT_EQ(std::string(100, 'a'), object_a->getBuffer().str());
+  auto object_b = cache.Lookup("module b");
+  ASSERT_NE(nullptr, object_b);
+  EXPECT_EQ(std::string(200, 'b'), object_b->getBuffer().str());
+  EXPECT_EQ(nullptr, cache.Lookup("module c"));
+
+  // Replacing an entry doesn't count it twice
+  const auto size = cache.Size();
+  EXPECT_TRUE(cache.Insert("module a", *MakeObject('c', 100)));
+  EXPECT_EQ(size, cache.Size());
+  EXPECT_EQ(std::string(100, 'c'), cache.Lookup("module a")->getBuffer().str());
+}
+
+// NOLINTNEXTLINE
+TEST_F(ObjectCacheTest, RestartTest) {
+  {
+    ObjectCache cache(Directory(), 1 << 20);
+    EXPECT_TRUE(cache.Insert("module a", *MakeObject('a', 100)));
+  }
+
+  // A new cache on the same directory picks up the entries of the old one
+  ObjectCache cache(Directory(), 1 << 20);
+  EXPECT_EQ(1u, cache.NumEntries());
+  auto object_a = cache.Lookup("module a");
+  ASSERT_NE(nullptr, object_a);
+  EXPECT_EQ(std::string(100, 'a'), object_a->getBuffer().str());
+}
+
+// NOLINTNEXTLINE
+TEST_F(ObjectCacheTest, EvictionTest) {
+  // Room for two entries of this size, but not three
+  ObjectCache cache(Directory(), 400);
+  EXPECT_TRUE(cache.Insert("module a", *MakeObject('a', 150)));
+  EXPECT_TRUE(cache.Insert("module b", *MakeObject('b', 150)));
+  EXPECT_NE(nullptr, cache.Lookup("module a"));
+
+  // b is the least recently used, so it makes room for c
+  EXPECT_TRUE(cache.Insert("module c", *MakeObject('c', 150)));
+  EXPECT_EQ(2u, cache.NumEntries());
+  EXPECT_LE(cache.Size(), 400u);
+  EXPECT_NE(nullptr, cache.Lookup("module a"));
+  EXPECT_EQ(nullptr, cache.Lookup("module b"));
+  EXPECT_NE(nullptr, cache.Lookup("module c"));
+  EXPECT_EQ(2u, EntryPaths().size());
+
+  // Entries larger than the whole cache are never cached
+  EXPECT_FALSE(cache.Insert("module d", *MakeObject('d', 500)));
+  EXPECT_EQ(2u, cache.NumEntries());
+}
+
+// NOLINTNEXTLINE
+TEST_F(ObjectCacheTest, CorruptEntryTest) {
+  ObjectCache cache(Directory(), 1 << 20);
+  EXPECT_TRUE(cache.Insert("module a", *MakeObject('a', 100)));
+  auto paths = EntryPaths();
+  ASSERT_EQ(1u, paths.size());
+
+  // Truncate the entry, as if the system crashed while writing it
+  {
+    std::error_code error;
+    llvm::raw_fd_ostream out(paths[0], error);
+    ASSERT_FALSE(error);
+    out << "TPLOBJ";
+  }
+
+  EXPECT_EQ(nullptr, cache.Lookup("module a"));
+  EXPECT_EQ(0u, cache.NumEntries());
+  EXPECT_TRUE(EntryPaths().empty());
+}
+
+// NOLINTNEXTLINE
+TEST_F(ObjectCacheTest, StringLiteralTest) {
+  LLVMEngine::Initialize();
+  if (!llvm::sys::fs::exists(LLVMEngine::CompilerOptions().GetBytecodeHandlersBcPath())) return;
+
+  ObjectCache cache(Directory(), 1 << 20);
+  LLVMEngine::SetObjectCache(&cache);
+
+  // The modules only differ in a string literal, whose address differs between compilations too
+  const auto run = [](const std::string &literal) {
+    auto compiler = ModuleCompiler();
+    auto module = compiler.CompileToModule("fun main() -> bool { var a = @stringToSql(\"" + literal +
+                                           "\")\n var b = @stringToSql(\"StrAing\")\n return @sqlToBool(a == b) }");
+    EXPECT_FALSE(compiler.HasErrors());
+    std::function<bool()> main;
+    EXPECT_TRUE(module->GetFunction("main", ExecutionMode::Compiled, &main));
+    return main();
+  };
+
+  EXPECT_TRUE(run("StrAing"));
+  EXPECT_EQ(1u, cache.NumEntries());
+  EXPECT_FALSE(run("StrBing"));
+  EXPECT_EQ(2u, cache.NumEntries());
+
+  // The cached code of the first module reads the literal of the module that loads it
+  EXPECT_TRUE(run("StrAing"));
+  EXPECT_EQ(2u, cache.NumEntries());
+
+  LLVMEngine::SetObjectCache(nullptr);
+}
+
+}  // namespace terrier::execution::vm::test
@@ -452,4 +452,92 @@ TEST_F(ProjectedColumnsIteratorTest, MultipleVectorizedFilterTest) {
   EXPECT_LE(count, 10u);
 }
 
+// NOLINTNEXTLINE
+TEST_F(ProjectedColumnsIteratorTest, VectorizedArithmeticTest) {
+  //
+  // Compute col_d - col_a and 10 - 3 * col_c over the whole vector, first
+  // without and then with a selection vector. col_d is nullable, so its NULLs
+  // carry over into the difference.
+  //
+
+  const uint32_t diff_idx = ProjectedColumnsIterator::COMPUTED_COL_START;
+  const uint32_t product_idx = diff_idx + 1;
+  const uint32_t result_idx = diff_idx + 2;
+
+  auto compute_and_check = [&, this](ProjectedColumnsIterator *iter, bool filtered) {
+    bool overflow = true;
+    iter->ComputeColByCol<std::minus>(diff_idx, GetColOffset(ColId::col_d), type::TypeId::BIGINT,
+                                      GetColOffset(ColId::col_a), type::TypeId::SMALLINT, &overflow);
+    EXPECT_FALSE(overflow);
+    iter->ComputeColByVal<std::multiplies>(product_idx, GetColOffset(ColId::col_c), type::TypeId::INTEGER, 3, false,
+                                           &overflow);
+    EXPECT_FALSE(overflow);
+    iter->ComputeColByVal<std::minus>(result_idx, product_idx, type::TypeId::BIGINT, 10, true, &overflow);
+    EXPECT_FALSE(overflow);
+
+    uint32_t count = 0;
+    auto check = [&]() {
+      bool null = false;
+      auto col_a = *iter->Get<int16_t, false>(GetColOffset(ColId::col_a), nullptr);
+      auto col_c = *iter->Get<int32_t, false>(GetColOffset(ColId::col_c), nullptr);
+      auto col_d = iter->Get<int64_t, true>(GetColOffset(ColId::col_d), &null);
+      bool diff_null = false;
+      auto diff = iter->GetComputed(diff_idx, &diff_null);
+      EXPECT_EQ(null, diff_null);
+      if (!null) EXPECT_EQ(*col_d - col_a, *diff);
+      bool result_null = true;
+      EXPECT_EQ(10 - 3 * static_cast<int64_t>(col_c), *iter->GetComputed(result_idx, &result_null));
+      EXPECT_FALSE(result_null);
+      count++;
+    };
+    if (filtered) {
+      for (; iter->HasNextFiltered(); iter->AdvanceFiltered()) check();
+      iter->ResetFiltered();
+    } else {
+      for (; iter->HasNext(); iter->Advance()) check();
+      iter->Reset();
+    }
+    return count;
+  };
+
+  ProjectedColumnsIterator iter(GetProjectedColumn());
+  SetSize(common::Constants::K_DEFAULT_VECTOR_SIZE);
+
+  // Without a selection vector, every tuple is computed
+  EXPECT_EQ(common::Constants::K_DEFAULT_VECTOR_SIZE, compute_and_check(&iter, false));
+
+  // With one, only the selected tuples are
+  iter.FilterColByVal<std::less>(GetColOffset(ColId::col_c), type::TypeId::INTEGER,
+                                 ProjectedColumnsIterator::FilterVal{.i_ = 500});
+  const auto num_selected = iter.NumSelected();
+  EXPECT_EQ(num_selected, compute_and_check(&iter, true));
+}
+
+// NOLINTNEXTLINE
+TEST_F(ProjectedColumnsIteratorTest, VectorizedArithmeticOverflowTest) {
+  //
+  // col_d + INT64_MAX overflows for every positive col_d, and wraps around
+  // like the tuple-at-a-time arithmetic does
+  //
+
+  const uint32_t sum_idx = ProjectedColumnsIterator::COMPUTED_COL_START;
+  const int64_t max = std::numeric_limits<int64_t>::max();
+
+  ProjectedColumnsIterator iter(GetProjectedColumn());
+  SetSize(common::Constants::K_DEFAULT_VECTOR_SIZE);
+
+  bool overflow = false;
+  iter.ComputeColByVal<std::plus>(sum_idx, GetColOffset(ColId::col_d), type::TypeId::BIGINT, max, false, &overflow);
+  EXPECT_TRUE(overflow);
+
+  for (; iter.HasNext(); iter.Advance()) {
+    bool null = false;
+    auto col_d = *iter.Get<int64_t, true>(GetColOffset(ColId::col_d), &null);
+    bool sum_null = false;
+    auto sum = *iter.GetComputed(sum_idx, &sum_null);
+    EXPECT_EQ(null, sum_null);
+    if (!null) EXPECT_EQ(static_cast<int64_t>(static_cast<uint64_t>(col_d) + static_cast<uint64_t>(max)), sum);
+  }
+}
+
 }  // namespace terrier::execution::sql::test
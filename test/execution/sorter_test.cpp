@@ -1,5 +1,7 @@
 #include <algorithm>
 #include <chrono>  // NOLINT
+#include <cstdio>
+#include <cstring>
 #include <limits>
 #include <queue>
 #include <random>
@@ -13,6 +15,7 @@
 #include "ips4o/ips4o.hpp"
 
 #include "execution/exec/execution_context.h"
+#include "execution/sql/memory_tracker.h"
 #include "execution/sql/sorter.h"
 #include "execution/sql/thread_state_container.h"
 
@@ -157,6 +160,156 @@ TEST_F(SorterTest, TopKTest) {
   TestAllIntegral(TestTopKRandomTupleSize, num_iters, max_elems, &generator_);
 }
 
+// NOLINTNEXTLINE
+TEST_F(SorterTest, NormalizedKeyTest) {
+  // Normalized keys must order values like the values themselves
+  const auto check_order = [](auto smaller, auto larger) {
+    EXPECT_LT(Sorter::NormalizeKey(smaller, false), Sorter::NormalizeKey(larger, false));
+    EXPECT_GT(Sorter::NormalizeKey(smaller, true), Sorter::NormalizeKey(larger, true));
+  };
+
+  check_order(BoolVal(false), BoolVal(true));
+  check_order(Integer(std::numeric_limits<int64_t>::min()), Integer(-1));
+  check_order(Integer(-1), Integer(0));
+  check_order(Integer(0), Integer(std::numeric_limits<int64_t>::max() - 1));
+  check_order(Real(-1e10), Real(-0.5));
+  check_order(Real(-0.5), Real(0.0));
+  check_order(Real(0.0), Real(0.25));
+  check_order(Real(0.25), Real(1e10));
+  check_order(StringVal("", 0), StringVal("a", 1));
+  check_order(StringVal("a", 1), StringVal("ab", 2));
+  check_order(StringVal("ab", 2), StringVal("b", 1));
+  check_order(StringVal("abcdefg", 7), StringVal("abcdefgh", 8));
+
+  // Only the first eight bytes of a string make it into its key
+  EXPECT_EQ(Sorter::NormalizeKey(StringVal("abcdefgh1", 9), false),
+            Sorter::NormalizeKey(StringVal("abcdefgh2", 9), false));
+
+  // NULLs sort last in ascending order, and first in descending order
+  check_order(Integer(std::numeric_limits<int64_t>::max() - 1), Integer::Null());
+  check_order(Real(1e10), Real::Null());
+  check_order(StringVal("zzz", 3), StringVal::Null());
+}
+
+// A tuple with a two-word normalized key: the integer in ascending order, then
+// the string in descending order
+struct KeyedTuple {
+  uint64_t key_[2];
+  int64_t a_;
+  char b_[16];
+};
+
+// NOLINTNEXTLINE
+TEST_F(SorterTest, NormalizedKeySortTest) {
+  const auto cmp_fn = [](const void *left, const void *right) -> int32_t {
+    const auto *l = reinterpret_cast<const KeyedTuple *>(left);
+    const auto *r = reinterpret_cast<const KeyedTuple *>(right);
+    if (l->a_ != r->a_) {
+      return l->a_ < r->a_ ? -1 : 1;
+    }
+    return -std::strcmp(l->b_, r->b_);
+  };
+
+  // Few distinct integers and strings sharing long prefixes, so that tuples
+  // tie on both the first key word and the string prefix
+  std::uniform_int_distribution<int64_t> rng_a(-50, 50);
+  std::uniform_int_distribution<uint32_t> rng_b(0, 999);
+
+  for (const uint32_t num_tuples : {0u, 1u, 10u, 1000u, 100000u}) {
+    MemoryPool memory(nullptr);
+    Sorter sorter(&memory, cmp_fn, sizeof(KeyedTuple), 2);
+    std::vector<KeyedTuple> reference(num_tuples);
+    for (auto &tuple : reference) {
+      tuple.a_ = rng_a(generator_);
+      std::snprintf(tuple.b_, sizeof(tuple.b_), "prefix__%u", rng_b(generator_));
+      tuple.key_[0] = Sorter::NormalizeKey(Integer(tuple.a_), false);
+      tuple.key_[1] = Sorter::NormalizeKey(StringVal(tuple.b_, std::strlen(tuple.b_)), true);
+      *reinterpret_cast<KeyedTuple *>(sorter.AllocInputTuple()) = tuple;
+    }
+
+    std::sort(reference.begin(), reference.end(),
+              [&](const KeyedTuple &l, const KeyedTuple &r) { return cmp_fn(&l, &r) < 0; });
+    sorter.Sort();
+
+    ASSERT_EQ(num_tuples, sorter.NumTuples());
+    uint32_t idx = 0;
+    for (SorterIterator iter(&sorter); iter.HasNext(); iter.Next(), idx++) {
+      EXPECT_EQ(0, cmp_fn(iter.GetRow(), &reference[idx]));
+    }
+  }
+}
+
+// A tuple with a one-word normalized key: a nullable 64-bit integer, whose
+// largest value shares its word with NULL. The string is the second key.
+struct NullableKeyedTuple {
+  uint64_t key_;
+  bool a_null_;
+  int64_t a_;
+  char b_[16];
+};
+
+// NOLINTNEXTLINE
+TEST_F(SorterTest, NormalizedKeyNullTest) {
+  constexpr int64_t max = std::numeric_limits<int64_t>::max();
+  EXPECT_EQ(Sorter::NormalizeKey(Integer(max), false), Sorter::NormalizeKey(Integer::Null(), false));
+  EXPECT_EQ(Sorter::NormalizeKey(Integer(max), true), Sorter::NormalizeKey(Integer::Null(), true));
+
+  for (const bool descending : {false, true}) {
+    // The comparison function has to tell NULL and the largest integer apart
+    // whenever their words tie, even though the strings differ
+    const auto cmp_asc = [](const void *left, const void *right) -> int32_t {
+      const auto *l = reinterpret_cast<const NullableKeyedTuple *>(left);
+      const auto *r = reinterpret_cast<const NullableKeyedTuple *>(right);
+      if (l->a_null_ != r->a_null_) {
+        return l->a_null_ ? 1 : -1;
+      }
+      if (!l->a_null_ && l->a_ != r->a_) {
+        return l->a_ < r->a_ ? -1 : 1;
+      }
+      return std::strcmp(l->b_, r->b_);
+    };
+    const auto cmp_desc = [](const void *left, const void *right) -> int32_t {
+      const auto *l = reinterpret_cast<const NullableKeyedTuple *>(left);
+      const auto *r = reinterpret_cast<const NullableKeyedTuple *>(right);
+      if (l->a_null_ != r->a_null_) {
+        return l->a_null_ ? -1 : 1;
+      }
+      if (!l->a_null_ && l->a_ != r->a_) {
+        return l->a_ < r->a_ ? 1 : -1;
+      }
+      return std::strcmp(l->b_, r->b_);
+    };
+    const Sorter::ComparisonFunction cmp_fn = descending ? +cmp_desc : +cmp_asc;
+
+    MemoryPool memory(nullptr);
+    Sorter sorter(&memory, cmp_fn, sizeof(NullableKeyedTuple), 1);
+    std::vector<NullableKeyedTuple> reference;
+    for (const char *b : {"d", "a", "c", "b"}) {
+      for (const bool a_null : {true, false}) {
+        NullableKeyedTuple tuple{};
+        tuple.a_null_ = a_null;
+        tuple.a_ = a_null ? 0 : max;
+        std::snprintf(tuple.b_, sizeof(tuple.b_), "%s", b);
+        tuple.key_ = Sorter::NormalizeKey(a_null ? Integer::Null() : Integer(max), descending);
+        *reinterpret_cast<NullableKeyedTuple *>(sorter.AllocInputTuple()) = tuple;
+        reference.push_back(tuple);
+      }
+    }
+
+    std::sort(reference.begin(), reference.end(),
+              [&](const NullableKeyedTuple &l, const NullableKeyedTuple &r) { return cmp_fn(&l, &r) < 0; });
+    sorter.Sort();
+
+    ASSERT_EQ(reference.size(), sorter.NumTuples());
+    uint32_t idx = 0;
+    for (SorterIterator iter(&sorter); iter.HasNext(); iter.Next(), idx++) {
+      const auto *row = reinterpret_cast<const NullableKeyedTuple *>(iter.GetRow());
+      EXPECT_EQ(reference[idx].a_null_, row->a_null_);
+      EXPECT_STREQ(reference[idx].b_, row->b_);
+    }
+  }
+}
+
 template <uint32_t N>
 struct TestTuple {
   uint32_t key_;
@@ -271,4 +424,177 @@ TEST_F(SorterTest, UnbalancedParallelSortTest) {
   std::this_thread::sleep_for(std::chrono::milliseconds(50));
 }
 
+// NOLINTNEXTLINE
+TEST_F(SorterTest, ExternalSortTest) {
+  const auto cmp_fn = [](const void *a, const void *b) -> int32_t {
+    const auto val_a = *reinterpret_cast<const int64_t *>(a);
+    const auto val_b = *reinterpret_cast<const int64_t *>(b);
+    return val_a < val_b ? -1 : (val_a == val_b ? 0 : 1);
+  };
+
+  // A budget far below the input forces the sorter to spill many runs
+  MemoryTracker tracker;
+  tracker.SetMemoryLimit(64 * 1024);
+  MemoryPool memory{common::ManagedPointer<MemoryTracker>(&tracker)};
+
+  const uint32_t num_elems = 100000;
+  std::uniform_int_distribution<int64_t> rng;
+  std::vector<int64_t> reference;
+  reference.reserve(num_elems);
+
+  sql::Sorter sorter(&memory, cmp_fn, sizeof(int64_t));
+  for (uint32_t i = 0; i < num_elems; i++) {
+    reference.push_back(rng(generator_));
+    *reinterpret_cast<int64_t *>(sorter.AllocInputTuple()) = reference.back();
+  }
+  sorter.Sort();
+
+  EXPECT_GT(sorter.NumRuns(), 1u);
+  EXPECT_EQ(num_elems, sorter.NumTuples());
+
+  std::sort(reference.begin(), reference.end());
+  uint32_t i = 0;
+  for (sql::SorterIterator iter(&sorter); iter.HasNext(); iter.Next()) {
+    ASSERT_LT(i, num_elems);
+    EXPECT_EQ(reference[i++], *iter.GetRowAs<int64_t>());
+  }
+  EXPECT_EQ(num_elems, i);
+}
+
+// NOLINTNEXTLINE
+TEST_F(SorterTest, ExternalParallelSortTest) {
+  static const auto cmp_fn = [](const void *left, const void *right) {
+    const auto *l = reinterpret_cast<const TestTuple<2> *>(left);
+    const auto *r = reinterpret_cast<const TestTuple<2> *>(right);
+    return l->Compare(*r);
+  };
+
+  MemoryTracker tracker;
+  tracker.SetMemoryLimit(64 * 1024);
+  MemoryPool memory{common::ManagedPointer<MemoryTracker>(&tracker)};
+
+  {
+    tbb::task_scheduler_init sched;
+
+    ThreadStateContainer container(&memory);
+    container.Reset(
+        sizeof(Sorter),
+        [](void *ctx, void *s) { new (s) Sorter(reinterpret_cast<MemoryPool *>(ctx), cmp_fn, sizeof(TestTuple<2>)); },
+        [](UNUSED_ATTRIBUTE void *ctx, void *s) { reinterpret_cast<Sorter *>(s)->~Sorter(); }, &memory);
+
+    // Spill in every thread-local sorter. Keys repeat across sorters.
+    const std::vector<uint32_t> sorter_sizes = {20000, 30000, 5, 40000};
+    tbb::parallel_for_each(sorter_sizes.begin(), sorter_sizes.end(), [&container](const uint32_t sorter_size) {
+      auto *sorter = container.AccessThreadStateOfCurrentThreadAs<Sorter>();
+      for (uint32_t i = 0; i < sorter_size; i++) {
+        reinterpret_cast<TestTuple<2> *>(sorter->AllocInputTuple())->key_ = (i * 7919) % 10000;
+      }
+    });
+
+    Sorter main(&memory, cmp_fn, sizeof(TestTuple<2>));
+    main.SortParallel(&container, 0);
+
+    EXPECT_TRUE(main.IsSorted());
+    EXPECT_GT(main.NumRuns(), 0u);
+    EXPECT_EQ(90005u, main.NumTuples());
+
+    // Rows read back from runs are only valid until the iterator moves, so remember keys rather than rows
+    uint32_t count = 0, prev_key = 0;
+    for (SorterIterator iter(&main); iter.HasNext(); iter.Next()) {
+      const uint32_t key = iter.GetRowAs<TestTuple<2>>()->key_;
+      EXPECT_LE(prev_key, key);
+      prev_key = key;
+      count++;
+    }
+    EXPECT_EQ(90005u, count);
+  }
+  // HACK: See BalancedParallelSortTest
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+}
+
+// NOLINTNEXTLINE
+TEST_F(SorterTest, SpillThresholdTest) {
+  const auto cmp_fn = [](const void *a, const void *b) -> int32_t {
+    const auto val_a = *reinterpret_cast<const int64_t *>(a);
+    const auto val_b = *reinterpret_cast<const int64_t *>(b);
+    return val_a < val_b ? -1 : (val_a == val_b ? 0 : 1);
+  };
+  const uint64_t bytes_per_tuple = sizeof(int64_t) + sizeof(const byte *);
+
+  // Memory allocated elsewhere in the query doesn't make the sorter spill
+  {
+    MemoryTracker tracker;
+    tracker.SetMemoryLimit(Sorter::K_MIN_RUN_SIZE);
+    tracker.Increment(4 * Sorter::K_MIN_RUN_SIZE);
+    MemoryPool memory{common::ManagedPointer<MemoryTracker>(&tracker)};
+    sql::Sorter sorter(&memory, cmp_fn, sizeof(int64_t));
+    for (uint32_t i = 0; i < Sorter::K_MIN_RUN_SIZE / bytes_per_tuple; i++) {
+      *reinterpret_cast<int64_t *>(sorter.AllocInputTuple()) = i;
+    }
+    EXPECT_EQ(0u, sorter.NumRuns());
+    tracker.Decrement(4 * Sorter::K_MIN_RUN_SIZE);
+  }
+
+  // A tiny budget still spills runs of at least the minimum size
+  {
+    MemoryTracker tracker;
+    tracker.SetMemoryLimit(1);
+    MemoryPool memory{common::ManagedPointer<MemoryTracker>(&tracker)};
+    sql::Sorter sorter(&memory, cmp_fn, sizeof(int64_t));
+    const uint32_t num_elems = 10 * Sorter::K_MIN_RUN_SIZE / bytes_per_tuple;
+    for (uint32_t i = 0; i < num_elems; i++) {
+      *reinterpret_cast<int64_t *>(sorter.AllocInputTuple()) = num_elems - i;
+    }
+    sorter.Sort();
+    EXPECT_EQ(10u, sorter.NumRuns());
+    EXPECT_EQ(num_elems, sorter.NumTuples());
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(SorterTest, ExternalSortMergePassesTest) {
+  const auto cmp_fn = [](const void *a, const void *b) -> int32_t {
+    const auto val_a = *reinterpret_cast<const int64_t *>(a);
+    const auto val_b = *reinterpret_cast<const int64_t *>(b);
+    return val_a < val_b ? -1 : (val_a == val_b ? 0 : 1);
+  };
+
+  // Spill more runs of the minimum size than are merged at once
+  MemoryTracker tracker;
+  tracker.SetMemoryLimit(1);
+  MemoryPool memory{common::ManagedPointer<MemoryTracker>(&tracker)};
+  const uint32_t tuples_per_run = Sorter::K_MIN_RUN_SIZE / (sizeof(int64_t) + sizeof(const byte *));
+  const uint32_t num_runs = Sorter::K_MAX_MERGE_FAN_IN + 6;
+  const uint32_t num_elems = num_runs * tuples_per_run;
+
+  sql::Sorter sorter(&memory, cmp_fn, sizeof(int64_t));
+  std::uniform_int_distribution<int64_t> rng;
+  std::vector<int64_t> reference;
+  reference.reserve(num_elems);
+  for (uint32_t i = 0; i < num_elems; i++) {
+    reference.push_back(rng(generator_));
+    *reinterpret_cast<int64_t *>(sorter.AllocInputTuple()) = reference.back();
+  }
+  sorter.Sort();
+
+  // The first K_MAX_MERGE_FAN_IN runs were merged into one while spilling
+  EXPECT_EQ(7u, sorter.NumRuns());
+  EXPECT_EQ(num_elems, sorter.NumTuples());
+
+  // Read buffers are charged to the tracker while iterating
+  const auto allocated = tracker.GetAllocatedSize();
+  {
+    std::sort(reference.begin(), reference.end());
+    sql::SorterIterator iter(&sorter);
+    EXPECT_EQ(allocated + sorter.NumRuns() * SortRun::K_IO_SIZE, tracker.GetAllocatedSize());
+    uint32_t i = 0;
+    for (; iter.HasNext(); iter.Next()) {
+      ASSERT_LT(i, num_elems);
+      EXPECT_EQ(reference[i++], *iter.GetRowAs<int64_t>());
+    }
+    EXPECT_EQ(num_elems, i);
+  }
+  EXPECT_EQ(allocated, tracker.GetAllocatedSize());
+}
+
 }  // namespace terrier::execution::sql::test
@@ -10,6 +10,7 @@
 
 #include "execution/exec/execution_context.h"
 #include "execution/sql/functions/string_functions.h"
+#include "execution/sql/like_pattern.h"
 #include "execution/sql/value.h"
 #include "execution/util/timer.h"
 
@@ -515,4 +516,61 @@ TEST_F(StringFunctionsTests, Trim) {
   EXPECT_TRUE(StringVal("test") == result);
 }
 
+// NOLINTNEXTLINE
+TEST_F(StringFunctionsTests, Like) {
+  // Nulls
+  {
+    auto result = BoolVal(false);
+    StringFunctions::Like(Ctx(), &result, StringVal::Null(), StringVal("%"));
+    EXPECT_TRUE(result.is_null_);
+
+    result = BoolVal(false);
+    StringFunctions::Like(Ctx(), &result, StringVal("abc"), StringVal::Null());
+    EXPECT_TRUE(result.is_null_);
+  }
+
+  auto check = [&](const char *str, const char *pattern, bool expected) {
+    auto result = BoolVal::Null();
+    StringFunctions::Like(Ctx(), &result, StringVal(str), StringVal(pattern));
+    EXPECT_FALSE(result.is_null_);
+    EXPECT_EQ(expected, result.val_) << "'" << str << "' LIKE '" << pattern << "'";
+  };
+
+  check(test_string_2_, "Drake", true);
+  check(test_string_2_, "drake", false);
+  check(test_string_2_, "Dr%", true);
+  check(test_string_2_, "%ke", true);
+  check(test_string_2_, "%ra%", true);
+  check(test_string_2_, "D_a_e", true);
+  check(test_string_2_, "D_a_", false);
+  check(test_string_1_, "%love%bed%momma%", true);
+  check(test_string_1_, "%momma%bed%", false);
+  check("", "%", true);
+  check("", "_", false);
+  check("100%", "100\\%", true);
+  check("1000", "100\\%", false);
+}
+
+// NOLINTNEXTLINE
+TEST_F(StringFunctionsTests, LikeCompiledPattern) {
+  const LikePattern pattern("%ra%");
+
+  auto null_result = BoolVal(false);
+  StringFunctions::Like(&null_result, StringVal::Null(), pattern);
+  EXPECT_TRUE(null_result.is_null_);
+
+  // The same compiled pattern matches any number of strings
+  auto check = [&](const char *str, bool expected) {
+    auto result = BoolVal::Null();
+    StringFunctions::Like(&result, StringVal(str), pattern);
+    EXPECT_FALSE(result.is_null_);
+    EXPECT_EQ(expected, result.val_) << "'" << str << "' LIKE '%ra%'";
+  };
+
+  check(test_string_2_, true);
+  check(test_string_1_, false);
+  check("ra", true);
+  check("", false);
+}
+
 }  // namespace terrier::execution::sql::test
@@ -0,0 +1,57 @@
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <numeric>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "network/network_io_utils.h"
+#include "test_util/test_harness.h"
+
+namespace terrier::network {
+
+class NetworkIoUtilsTests : public TerrierTest {};
+
+// A WriteQueue spanning many buffers is written out with writev, in order and without losing bytes when the other end
+// only accepts part of the data at a time.
+// NOLINTNEXTLINE
+TEST_F(NetworkIoUtilsTests, WriteQueueGatherWriteTest) {
+  const size_t buffer_capacity = 1024;
+  const size_t num_bytes = 100 * buffer_capacity + 17;
+  std::vector<uint8_t> input(num_bytes);
+  std::iota(input.begin(), input.end(), 0);
+
+  WriteQueue queue(buffer_capacity);
+  // Write in uneven chunks so that values straddle buffer boundaries
+  for (size_t written = 0; written < num_bytes;) {
+    const size_t chunk = std::min<size_t>(333, num_bytes - written);
+    queue.BufferWriteRaw(input.data() + written, chunk);
+    written += chunk;
+  }
+  EXPECT_TRUE(queue.HasFullBuffer());
+  EXPECT_TRUE(queue.ShouldFlush());
+
+  int fds[2];
+  ASSERT_EQ(0, pipe(fds));
+  // A non-blocking pipe returns EAGAIN once it fills up, which forces partial writes
+  for (const int fd : fds) fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+  std::vector<uint8_t> output;
+  while (queue.FlushHead() != nullptr) {
+    const auto bytes_written = queue.WriteOutTo(fds[1]);
+    ASSERT_TRUE(bytes_written >= 0 || errno == EAGAIN);
+    uint8_t chunk[4096];
+    ssize_t bytes_read;
+    while ((bytes_read = read(fds[0], chunk, sizeof(chunk))) > 0)
+      output.insert(output.end(), chunk, chunk + bytes_read);
+  }
+  close(fds[0]);
+  close(fds[1]);
+  EXPECT_EQ(input, output);
+
+  // Once reset, the queue is back to a single, empty buffer
+  queue.Reset();
+  EXPECT_FALSE(queue.ShouldFlush());
+  EXPECT_FALSE(queue.FlushHead()->HasMore());
+}
+
+}  // namespace terrier::network
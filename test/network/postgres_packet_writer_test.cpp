@@ -0,0 +1,107 @@
+#include <unistd.h>
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "execution/sql/value.h"
+#include "gtest/gtest.h"
+#include "network/network_io_utils.h"
+#include "network/postgres/postgres_packet_writer.h"
+#include "planner/plannodes/output_schema.h"
+#include "test_util/test_harness.h"
+
+namespace terrier::network {
+
+class PostgresPacketWriterTests : public TerrierTest {
+ public:
+  /**
+   * Serialize the given rows in text format and return the text of every attribute, in row-major order
+   */
+  static std::vector<std::string> WriteTextRows(const std::vector<byte> &tuples, const uint32_t num_tuples,
+                                                const std::vector<planner::OutputSchema::Column> &columns) {
+    uint32_t tuple_size = 0;
+    for (const auto &col : columns) tuple_size += execution::sql::ValUtil::GetSqlSize(col.GetType());
+
+    WriteQueue queue;
+    {
+      PostgresPacketWriter writer{common::ManagedPointer(&queue)};
+      writer.WriteDataRows(tuples.data(), num_tuples, tuple_size, columns, {FieldFormat::text});
+    }
+
+    // Drain the queue through a pipe to get at the raw bytes
+    int fds[2];
+    EXPECT_EQ(0, pipe(fds));
+    std::vector<uint8_t> bytes;
+    for (auto buffer = queue.FlushHead(); buffer != nullptr; queue.MarkHeadFlushed(), buffer = queue.FlushHead()) {
+      while (buffer->HasMore()) {
+        uint8_t chunk[4096];
+        buffer->WriteOutTo(fds[1]);
+        const auto read_bytes = read(fds[0], chunk, sizeof(chunk));
+        bytes.insert(bytes.end(), chunk, chunk + read_bytes);
+      }
+    }
+    close(fds[0]);
+    close(fds[1]);
+
+    auto read_int = [&](size_t *pos, size_t size) {
+      int64_t val = 0;
+      for (size_t i = 0; i < size; i++) val = (val << 8) | bytes[(*pos)++];
+      return val;
+    };
+    std::vector<std::string> attributes;
+    size_t pos = 0;
+    for (uint32_t row = 0; row < num_tuples; row++) {
+      EXPECT_EQ(static_cast<uint8_t>(NetworkMessageType::PG_DATA_ROW), bytes[pos++]);
+      read_int(&pos, sizeof(int32_t));
+      EXPECT_EQ(columns.size(), read_int(&pos, sizeof(int16_t)));
+      for (uint32_t col = 0; col < columns.size(); col++) {
+        const auto len = static_cast<size_t>(read_int(&pos, sizeof(int32_t)));
+        attributes.emplace_back(reinterpret_cast<const char *>(&bytes[pos]), len);
+        pos += len;
+      }
+    }
+    EXPECT_EQ(bytes.size(), pos);
+    return attributes;
+  }
+};
+
+// Text serialization formats fixed-width values without going through std::string. The output must stay identical
+// to what std::to_string and the runtime types' ToString produce.
+// NOLINTNEXTLINE
+TEST_F(PostgresPacketWriterTests, TextFormatTest) {
+  std::vector<planner::OutputSchema::Column> columns;
+  columns.emplace_back("int_col", type::TypeId::BIGINT, nullptr);
+  columns.emplace_back("decimal_col", type::TypeId::DECIMAL, nullptr);
+  columns.emplace_back("date_col", type::TypeId::DATE, nullptr);
+  const uint32_t tuple_size =
+      sizeof(execution::sql::Integer) + sizeof(execution::sql::Real) + sizeof(execution::sql::DateVal);
+
+  const std::vector<int64_t> ints = {0, 7, -7, 1234567890, std::numeric_limits<int64_t>::max(),
+                                     std::numeric_limits<int64_t>::min()};
+  const std::vector<double> reals = {0.0, -0.5, 3.14159, 123456789.125, -1e30, 1e300};
+  const std::vector<execution::sql::Date> dates = {
+      execution::sql::Date::FromYMD(2020, 1, 1),  execution::sql::Date::FromYMD(1970, 12, 31),
+      execution::sql::Date::FromYMD(1, 2, 3),     execution::sql::Date::FromYMD(9999, 12, 31),
+      execution::sql::Date::FromYMD(1992, 2, 29), execution::sql::Date::FromYMD(2000, 10, 10)};
+
+  std::vector<byte> tuples(ints.size() * tuple_size);
+  for (uint32_t row = 0; row < ints.size(); row++) {
+    byte *pos = tuples.data() + row * tuple_size;
+    new (pos) execution::sql::Integer(ints[row]);
+    pos += sizeof(execution::sql::Integer);
+    new (pos) execution::sql::Real(reals[row]);
+    pos += sizeof(execution::sql::Real);
+    new (pos) execution::sql::DateVal(dates[row]);
+  }
+
+  const auto attributes = WriteTextRows(tuples, static_cast<uint32_t>(ints.size()), columns);
+  ASSERT_EQ(ints.size() * columns.size(), attributes.size());
+  for (uint32_t row = 0; row < ints.size(); row++) {
+    EXPECT_EQ(std::to_string(ints[row]), attributes[row * columns.size()]);
+    EXPECT_EQ(std::to_string(reals[row]), attributes[row * columns.size() + 1]);
+    EXPECT_EQ(dates[row].ToString(), attributes[row * columns.size() + 2]);
+  }
+}
+
+}  // namespace terrier::network
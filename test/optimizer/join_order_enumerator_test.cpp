@@ -0,0 +1,245 @@
+#include "optimizer/join_order_enumerator.h"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "optimizer/logical_operators.h"
+#include "optimizer/optimization_context.h"
+#include "optimizer/optimizer_context.h"
+#include "optimizer/optimizer_task.h"
+#include "optimizer/optimizer_task_pool.h"
+#include "optimizer/property_set.h"
+#include "optimizer/rule.h"
+#include "parser/expression/column_value_expression.h"
+#include "parser/expression/comparison_expression.h"
+#include "test_util/test_harness.h"
+
+namespace terrier::optimizer {
+
+class JoinOrderEnumeratorTests : public TerrierTest {
+ public:
+  using RelationSet = JoinOrderEnumerator::RelationSet;
+
+  // Cheapest cost of joining all relations without cross products, by trying every split of every set of relations
+  static double CheapestCost(const std::vector<double> &cardinalities,
+                             const std::vector<std::pair<RelationSet, double>> &predicates) {
+    const RelationSet all = (RelationSet{1} << cardinalities.size()) - 1;
+    const auto cardinality = [&](const RelationSet relations) {
+      double result = 1.0;
+      for (uint32_t i = 0; i < cardinalities.size(); i++) {
+        if ((relations & (RelationSet{1} << i)) != 0) result *= cardinalities[i];
+      }
+      for (const auto &predicate : predicates) {
+        if ((predicate.first & ~relations) == 0) result *= predicate.second;
+      }
+      return result;
+    };
+    const auto joined = [&](const RelationSet left, const RelationSet right) {
+      return std::any_of(predicates.begin(), predicates.end(), [&](const auto &predicate) {
+        return (predicate.first & left) != 0 && (predicate.first & right) != 0;
+      });
+    };
+
+    std::vector<double> costs(all + 1, std::numeric_limits<double>::infinity());
+    for (RelationSet relations = 1; relations <= all; relations++) {
+      if ((relations & (relations - 1)) == 0) {
+        costs[relations] = 0;
+        continue;
+      }
+      for (RelationSet left = (relations - 1) & relations; left != 0; left = (left - 1) & relations) {
+        const RelationSet right = relations & ~left;
+        if (!joined(left, right)) continue;
+        costs[relations] = std::min(costs[relations], costs[left] + costs[right] + cardinality(relations));
+      }
+    }
+    return costs[all];
+  }
+
+  // Checks that the join tree of a set of relations is made of the join trees of its two sides, down to the relations
+  static void CheckJoinTree(const JoinOrderEnumerator &enumerator, const RelationSet relations) {
+    const auto &tree = enumerator.GetJoinTree(relations);
+    if ((relations & (relations - 1)) == 0) {
+      EXPECT_EQ(tree.left_, 0);
+      EXPECT_EQ(tree.right_, 0);
+      return;
+    }
+    EXPECT_EQ(tree.left_ & tree.right_, 0);
+    EXPECT_EQ(tree.left_ | tree.right_, relations);
+    EXPECT_DOUBLE_EQ(tree.cost_, tree.cardinality_ + enumerator.GetJoinTree(tree.left_).cost_ +
+                                     enumerator.GetJoinTree(tree.right_).cost_);
+    CheckJoinTree(enumerator, tree.left_);
+    CheckJoinTree(enumerator, tree.right_);
+  }
+};
+
+// In a chain a - b - c, joining the small relation a to b first keeps the intermediate result small
+// NOLINTNEXTLINE
+TEST_F(JoinOrderEnumeratorTests, ChainTest) {
+  JoinOrderEnumerator enumerator({10, 1000000, 1000000});
+  enumerator.AddPredicate(0b011, 1.0 / 1000000);
+  enumerator.AddPredicate(0b110, 1.0 / 1000000);
+  EXPECT_TRUE(enumerator.Enumerate());
+  CheckJoinTree(enumerator, enumerator.AllRelations());
+
+  // (a join b) produces 10 rows, then joining c produces 10 more, while (b join c) alone would produce 1000000
+  const auto &tree = enumerator.GetJoinTree(enumerator.AllRelations());
+  EXPECT_TRUE((tree.left_ == 0b011 && tree.right_ == 0b100) || (tree.left_ == 0b100 && tree.right_ == 0b011));
+  EXPECT_DOUBLE_EQ(tree.cardinality_, 10);
+  EXPECT_DOUBLE_EQ(tree.cost_, 20);
+}
+
+// DPccp finds the cheapest join tree of random connected join graphs
+// NOLINTNEXTLINE
+TEST_F(JoinOrderEnumeratorTests, DPccpTest) {
+  std::default_random_engine generator;
+  std::uniform_real_distribution<double> cardinality_distribution(1, 100000);
+  std::uniform_real_distribution<double> selectivity_distribution(0.00001, 1);
+  for (uint32_t num_relations = 2; num_relations <= 10; num_relations++) {
+    for (uint32_t round = 0; round < 10; round++) {
+      std::vector<double> cardinalities;
+      for (uint32_t i = 0; i < num_relations; i++) cardinalities.emplace_back(cardinality_distribution(generator));
+
+      // A random spanning tree keeps the graph connected, then some random edges make cycles
+      std::vector<std::pair<RelationSet, double>> predicates;
+      for (uint32_t i = 1; i < num_relations; i++) {
+        const RelationSet edge = (RelationSet{1} << i) | (RelationSet{1} << (generator() % i));
+        predicates.emplace_back(edge, selectivity_distribution(generator));
+      }
+      for (uint32_t i = 0; i < num_relations / 2; i++) {
+        const RelationSet edge = (RelationSet{1} << (generator() % num_relations)) |
+                                 (RelationSet{1} << (generator() % num_relations));
+        if ((edge & (edge - 1)) != 0) predicates.emplace_back(edge, selectivity_distribution(generator));
+      }
+
+      JoinOrderEnumerator enumerator(cardinalities);
+      for (const auto &predicate : predicates) enumerator.AddPredicate(predicate.first, predicate.second);
+      EXPECT_TRUE(enumerator.Enumerate());
+      CheckJoinTree(enumerator, enumerator.AllRelations());
+      const double expected = CheapestCost(cardinalities, predicates);
+      EXPECT_NEAR(enumerator.GetJoinTree(enumerator.AllRelations()).cost_, expected, expected * 1e-9);
+    }
+  }
+}
+
+// Join graphs that are too large or need a cross product are joined greedily
+// NOLINTNEXTLINE
+TEST_F(JoinOrderEnumeratorTests, GreedyTest) {
+  // Two pairs of relations with no predicate between them
+  JoinOrderEnumerator disconnected({100, 10, 1000, 10000});
+  disconnected.AddPredicate(0b0011, 0.01);
+  disconnected.AddPredicate(0b1100, 0.0001);
+  EXPECT_FALSE(disconnected.IsConnected());
+  EXPECT_FALSE(disconnected.Enumerate());
+  CheckJoinTree(disconnected, disconnected.AllRelations());
+  const auto &cross_product = disconnected.GetJoinTree(disconnected.AllRelations());
+  EXPECT_TRUE((cross_product.left_ == 0b0011 && cross_product.right_ == 0b1100) ||
+              (cross_product.left_ == 0b1100 && cross_product.right_ == 0b0011));
+
+  // A chain longer than DP enumerates
+  const uint32_t num_relations = JoinOrderEnumerator::MAX_DP_RELATIONS + 10;
+  std::vector<double> cardinalities;
+  for (uint32_t i = 0; i < num_relations; i++) cardinalities.emplace_back(1000 * (i + 1));
+  JoinOrderEnumerator chain(cardinalities);
+  for (uint32_t i = 1; i < num_relations; i++) {
+    chain.AddPredicate((RelationSet{1} << i) | (RelationSet{1} << (i - 1)), 1.0 / (1000 * (i + 1)));
+  }
+  EXPECT_TRUE(chain.IsConnected());
+  EXPECT_FALSE(chain.Enumerate());
+  CheckJoinTree(chain, chain.AllRelations());
+}
+
+// ReorderJoins replaces the inner joins in the memo with the cheapest order
+// NOLINTNEXTLINE
+TEST_F(JoinOrderEnumeratorTests, ReorderJoinsTest) {
+  OptimizerContext context(nullptr);
+  context.SetTaskPool(new OptimizerTaskStack());
+  auto &memo = context.GetMemo();
+
+  const auto record = [&](std::unique_ptr<OperatorNode> node) {
+    GroupExpression *gexpr = nullptr;
+    context.RecordOperatorNodeIntoGroup(common::ManagedPointer(node), &gexpr);
+    return gexpr->GetGroupID();
+  };
+  const auto get = [&](const std::string &alias, const uint32_t table_oid, const int num_rows) {
+    const auto group_id = record(std::make_unique<OperatorNode>(
+        LogicalGet::Make(catalog::db_oid_t(1), catalog::namespace_oid_t(2), catalog::table_oid_t(table_oid), {}, alias,
+                         false),
+        std::vector<std::unique_ptr<OperatorNode>>{}));
+    memo.GetGroupByID(group_id)->SetNumRows(num_rows);
+    return group_id;
+  };
+  std::vector<std::unique_ptr<parser::AbstractExpression>> exprs;
+  const auto join = [&](const group_id_t left, const group_id_t right, const std::string &left_alias,
+                        const std::string &right_alias) {
+    std::vector<std::unique_ptr<parser::AbstractExpression>> columns;
+    columns.emplace_back(std::make_unique<parser::ColumnValueExpression>(left_alias, "x"));
+    columns.emplace_back(std::make_unique<parser::ColumnValueExpression>(right_alias, "x"));
+    exprs.emplace_back(
+        std::make_unique<parser::ComparisonExpression>(parser::ExpressionType::COMPARE_EQUAL, std::move(columns)));
+    std::vector<AnnotatedExpression> predicates;
+    predicates.emplace_back(common::ManagedPointer(exprs.back()),
+                            std::unordered_set<std::string>{left_alias, right_alias});
+    std::vector<std::unique_ptr<OperatorNode>> children;
+    children.emplace_back(
+        std::make_unique<OperatorNode>(LeafOperator::Make(left), std::vector<std::unique_ptr<OperatorNode>>{}));
+    children.emplace_back(
+        std::make_unique<OperatorNode>(LeafOperator::Make(right), std::vector<std::unique_ptr<OperatorNode>>{}));
+    return record(std::make_unique<OperatorNode>(LogicalInnerJoin::Make(std::move(predicates)), std::move(children)));
+  };
+
+  // The chain a - b - c - d, written as ((b JOIN c) JOIN d) JOIN a. Joining b and c first builds 1000 rows, while
+  // joining a, b, c and then d only builds 10 and 0.1 rows before the final join.
+  const auto a = get("a", 1, 10);
+  const auto b = get("b", 2, 100000);
+  const auto c = get("c", 3, 1000);
+  const auto d = get("d", 4, 10);
+  const auto root = join(join(join(b, c, "b", "c"), d, "c", "d"), a, "a", "b");
+
+  OptimizationContext optimization_context(&context, new PropertySet());
+  ReorderJoins task(root, &optimization_context);
+  task.Execute();
+  // The tasks pushed for the new groups need stats that this memo doesn't have
+  context.SetTaskPool(nullptr);
+
+  // Walks down the join of the given relations and returns the group of its inputs that joins more than one relation
+  const auto check_join = [&](const group_id_t group_id, const std::unordered_set<std::string> &left_aliases,
+                              const std::unordered_set<std::string> &right_aliases,
+                              const std::unordered_set<std::string> &predicate_aliases) {
+    const auto &gexprs = memo.GetGroupByID(group_id)->GetLogicalExpressions();
+    // The join was recorded in both orders, and the join rules won't enumerate other orders
+    EXPECT_EQ(2, gexprs.size());
+    for (auto *gexpr : gexprs) {
+      EXPECT_EQ(OpType::LOGICALINNERJOIN, gexpr->Op().GetType());
+      for (auto *rule : context.GetRuleSet().GetRulesByName(RuleSetName::LOGICAL_TRANSFORMATION)) {
+        if (rule->GetType() == RuleType::INNER_JOIN_COMMUTE || rule->GetType() == RuleType::INNER_JOIN_ASSOCIATE) {
+          EXPECT_TRUE(gexpr->HasRuleExplored(rule));
+        }
+      }
+    }
+
+    const auto &predicates = gexprs[0]->Op().As<LogicalInnerJoin>()->GetJoinPredicates();
+    EXPECT_EQ(1, predicates.size());
+    if (!predicates.empty()) EXPECT_EQ(predicate_aliases, predicates[0].GetTableAliasSet());
+
+    auto left = gexprs[0]->GetChildGroupId(0);
+    auto right = gexprs[0]->GetChildGroupId(1);
+    if (memo.GetGroupByID(left)->GetTableAliases() != left_aliases) std::swap(left, right);
+    EXPECT_EQ(left_aliases, memo.GetGroupByID(left)->GetTableAliases());
+    EXPECT_EQ(right_aliases, memo.GetGroupByID(right)->GetTableAliases());
+    return left_aliases.size() > 1 ? left : right;
+  };
+
+  // ((a JOIN b) JOIN c) JOIN d
+  const auto abc = check_join(root, {"a", "b", "c"}, {"d"}, {"c", "d"});
+  const auto ab = check_join(abc, {"a", "b"}, {"c"}, {"b", "c"});
+  check_join(ab, {"a"}, {"b"}, {"a", "b"});
+}
+
+}  // namespace terrier::optimizer
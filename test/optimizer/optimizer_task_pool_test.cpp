@@ -0,0 +1,172 @@
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <functional>
+#include <stdexcept>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "common/exception.h"
+#include "common/worker_pool.h"
+#include "optimizer/optimizer_task.h"
+#include "optimizer/optimizer_task_pool.h"
+
+#include "test_util/test_harness.h"
+
+namespace terrier::optimizer {
+
+struct OptimizerTaskPoolTest : public TerrierTest {
+  // Worker threads shared by the pools of a test, besides the thread of the test
+  static constexpr uint32_t NUM_WORKERS = 3;
+
+  void SetUp() override {
+    TerrierTest::SetUp();
+    workers_.Startup();
+  }
+
+  common::ManagedPointer<common::WorkerPool> Workers() { return common::ManagedPointer(&workers_); }
+
+  // Task running an arbitrary function instead of optimizing anything
+  class FunctionTask : public OptimizerTask {
+   public:
+    explicit FunctionTask(std::function<void()> function)
+        : OptimizerTask(nullptr, OptimizerTaskType::OPTIMIZE_GROUP), function_(std::move(function)) {}
+
+    void Execute() override { function_(); }
+
+   private:
+    std::function<void()> function_;
+  };
+
+ private:
+  common::WorkerPool workers_{NUM_WORKERS, {}};
+};
+
+// Forked tasks execute what they push in stack order, and the pool is back to its own stack afterwards
+// NOLINTNEXTLINE
+TEST_F(OptimizerTaskPoolTest, StackOrderTest) {
+  ParallelOptimizerTaskPool pool(Workers());
+  const uint32_t num_tasks = 8;
+  std::vector<std::vector<uint32_t>> orders(num_tasks);
+  std::vector<OptimizerTask *> tasks;
+  for (uint32_t i = 0; i < num_tasks; i++) {
+    tasks.emplace_back(new FunctionTask([&, i] {
+      orders[i].emplace_back(0);
+      pool.Push(new FunctionTask([&, i] {
+        orders[i].emplace_back(2);
+        pool.Push(new FunctionTask([&, i] { orders[i].emplace_back(3); }));
+      }));
+      pool.Push(new FunctionTask([&, i] { orders[i].emplace_back(1); }));
+    }));
+  }
+
+  bool root_task_executed = false;
+  pool.Push(new FunctionTask([&] { root_task_executed = true; }));
+  pool.ExecuteIndependentTasks(std::move(tasks));
+  for (const auto &order : orders) EXPECT_EQ(order, (std::vector<uint32_t>{0, 1, 2, 3}));
+
+  EXPECT_FALSE(pool.Empty());
+  std::unique_ptr<OptimizerTask> root_task(pool.Pop());
+  root_task->Execute();
+  EXPECT_TRUE(root_task_executed);
+  EXPECT_TRUE(pool.Empty());
+}
+
+// Independent tasks run at the same time, and nested forks never use more threads than the pool has
+// NOLINTNEXTLINE
+TEST_F(OptimizerTaskPoolTest, ConcurrencyTest) {
+  ParallelOptimizerTaskPool pool(Workers());
+  const uint32_t num_threads = pool.NumThreads();
+  EXPECT_EQ(num_threads, NUM_WORKERS + 1);
+
+  // Two tasks that each wait for the other to start can only both finish on two threads
+  std::atomic<uint32_t> started = 0;
+  std::atomic<bool> met = true;
+  const auto rendezvous = [&] {
+    started++;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (started < 2 && std::chrono::steady_clock::now() < deadline) std::this_thread::yield();
+    if (started < 2) met = false;
+  };
+  pool.ExecuteIndependentTasks({new FunctionTask(rendezvous), new FunctionTask(rendezvous)});
+  EXPECT_TRUE(met);
+
+  // A binary tree of forks
+  std::atomic<uint32_t> executed = 0;
+  std::atomic<uint32_t> running = 0;
+  std::atomic<uint32_t> max_running = 0;
+  std::function<void(uint32_t)> fork = [&](const uint32_t depth) {
+    executed++;
+    const uint32_t now_running = ++running;
+    uint32_t max = max_running.load();
+    while (now_running > max && !max_running.compare_exchange_weak(max, now_running)) {
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+    running--;
+    if (depth == 0) return;
+    pool.ExecuteIndependentTasks(
+        {new FunctionTask([&, depth] { fork(depth - 1); }), new FunctionTask([&, depth] { fork(depth - 1); })});
+  };
+  const uint32_t depth = 8;
+  pool.ExecuteIndependentTasks({new FunctionTask([&] { fork(depth); })});
+  EXPECT_EQ(executed, (1U << (depth + 1)) - 1);
+  EXPECT_LE(max_running, num_threads);
+}
+
+// An exception thrown by a forked task reaches the forking thread once the other tasks are done
+// NOLINTNEXTLINE
+TEST_F(OptimizerTaskPoolTest, ExceptionTest) {
+  ParallelOptimizerTaskPool pool(Workers());
+  std::atomic<uint32_t> executed = 0;
+  std::vector<OptimizerTask *> tasks;
+  for (uint32_t i = 0; i < 8; i++) {
+    tasks.emplace_back(new FunctionTask([&, i] {
+      if (i == 3) {
+        // Left on the stack of the failed task, and deleted with it
+        pool.Push(new FunctionTask([&] { executed++; }));
+        throw std::runtime_error("task failed");
+      }
+      executed++;
+    }));
+  }
+  EXPECT_THROW(pool.ExecuteIndependentTasks(std::move(tasks)), std::runtime_error);
+  EXPECT_EQ(executed, 7);
+  EXPECT_TRUE(pool.Empty());
+}
+
+// Forked stacks stop at the timeout, and leave their remaining tasks to be deleted
+// NOLINTNEXTLINE
+TEST_F(OptimizerTaskPoolTest, TimeoutTest) {
+  ParallelOptimizerTaskPool pool(Workers());
+  std::atomic<bool> timed_out = false;
+  pool.SetTimeoutCheck([&] { return timed_out.load(); });
+
+  // Every task keeps pushing tasks until the timeout, which the last task before it triggers
+  std::atomic<uint32_t> executed = 0;
+  std::function<void()> push_forever = [&] {
+    if (++executed == 100) timed_out = true;
+    pool.Push(new FunctionTask(push_forever));
+  };
+  EXPECT_THROW(pool.ExecuteIndependentTasks({new FunctionTask(push_forever), new FunctionTask(push_forever)}),
+               OptimizerException);
+  EXPECT_GE(executed, 100);
+  EXPECT_TRUE(pool.Empty());
+}
+
+// A single-threaded stack executes independent tasks one after the other, before the tasks below them
+// NOLINTNEXTLINE
+TEST_F(OptimizerTaskPoolTest, TaskStackTest) {
+  OptimizerTaskStack stack;
+  std::vector<uint32_t> order;
+  stack.Push(new FunctionTask([&] { order.emplace_back(3); }));
+  EXPECT_EQ(stack.NumThreads(), 1);
+  stack.ExecuteIndependentTasks({new FunctionTask([&] {
+                                   order.emplace_back(0);
+                                   stack.Push(new FunctionTask([&] { order.emplace_back(1); }));
+                                 }),
+                                 new FunctionTask([&] { order.emplace_back(2); })});
+  EXPECT_EQ(order, (std::vector<uint32_t>{0, 1, 2}));
+  EXPECT_FALSE(stack.Empty());
+}
+
+}  // namespace terrier::optimizer
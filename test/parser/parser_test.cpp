@@ -74,6 +74,14 @@ TEST_F(ParserTestBase, CopyTest) {
   auto copy_stmt = result->GetStatement(0).CastManagedPointerTo<CopyStatement>();
   EXPECT_EQ(copy_stmt->GetType(), StatementType::COPY);
   EXPECT_EQ(copy_stmt->GetExternalFileFormat(), ExternalFileFormat::BINARY);
+
+  // Column lists and options other than the format and its characters would change what is copied
+  EXPECT_THROW(parser::PostgresParser::BuildParseTree("COPY foo (a, b) FROM STDIN WITH (FORMAT csv);"),
+               ParserException);
+  EXPECT_THROW(parser::PostgresParser::BuildParseTree("COPY foo FROM STDIN WITH (FORMAT csv, HEADER true);"),
+               ParserException);
+  EXPECT_NO_THROW(
+      parser::PostgresParser::BuildParseTree("COPY foo FROM STDIN WITH (FORMAT csv, DELIMITER '|', QUOTE '\"');"));
 }
 
 // NOLINTNEXTLINE
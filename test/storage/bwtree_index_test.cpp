@@ -1,9 +1,11 @@
+#include <algorithm>
 #include <cstring>
 #include <functional>
 #include <limits>
 #include <map>
 #include <memory>
 #include <random>
+#include <utility>
 #include <vector>
 
 #include "main/db_main.h"
@@ -29,10 +31,11 @@ namespace terrier::storage::index {
 class BwTreeIndexTests : public TerrierTest {
  private:
   catalog::Schema table_schema_;
+
+ public:
   catalog::IndexSchema unique_schema_;
   catalog::IndexSchema default_schema_;
 
- public:
   std::default_random_engine generator_;
   const uint32_t num_threads_ = 4;
 
@@ -321,6 +324,124 @@ TEST_F(BwTreeIndexTests, ScanAscending) {
   txn_manager_->Commit(scan_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
 }
 
+/**
+ * Tests that a batched lookup finds the same values as looking up each key on its own, in the order the keys were
+ * passed, including for missing and repeated keys.
+ */
+// NOLINTNEXTLINE
+TEST_F(BwTreeIndexTests, ScanKeys) {
+  // populate index with [0..20] even keys, and a second value for key 10
+  std::multimap<int32_t, storage::TupleSlot> reference;
+  auto *const insert_txn = txn_manager_->BeginTransaction();
+  for (int32_t i : {0, 2, 4, 6, 8, 10, 10, 12, 14, 16, 18, 20}) {
+    auto *const insert_redo =
+        insert_txn->StageWrite(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID, tuple_initializer_);
+    auto *const insert_tuple = insert_redo->Delta();
+    *reinterpret_cast<int32_t *>(insert_tuple->AccessForceNotNull(0)) = i;
+    const auto tuple_slot = sql_table_->Insert(common::ManagedPointer(insert_txn), insert_redo);
+
+    auto *const insert_key = default_index_->GetProjectedRowInitializer().InitializeRow(key_buffer_1_);
+    *reinterpret_cast<int32_t *>(insert_key->AccessForceNotNull(0)) = i;
+
+    EXPECT_TRUE(default_index_->Insert(common::ManagedPointer(insert_txn), *insert_key, tuple_slot));
+    reference.emplace(i, tuple_slot);
+  }
+  txn_manager_->Commit(insert_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  auto *const scan_txn = txn_manager_->BeginTransaction();
+
+  const std::vector<int32_t> keys = {12, 3, 10, 0, 12, 21, 20};
+  const auto key_size = default_index_->GetProjectedRowInitializer().ProjectedRowSize();
+  auto *const keys_buffer = common::AllocationUtil::AllocateAligned(key_size * keys.size());
+  std::vector<const ProjectedRow *> key_prs;
+  for (uint32_t i = 0; i < keys.size(); i++) {
+    auto *const key_pr = default_index_->GetProjectedRowInitializer().InitializeRow(keys_buffer + i * key_size);
+    *reinterpret_cast<int32_t *>(key_pr->AccessForceNotNull(0)) = keys[i];
+    key_prs.emplace_back(key_pr);
+  }
+
+  std::vector<storage::TupleSlot> results;
+  std::vector<std::pair<uint32_t, uint32_t>> ranges;
+  default_index_->ScanKeys(*scan_txn, key_prs.data(), static_cast<uint32_t>(keys.size()), &results, &ranges);
+  ASSERT_EQ(keys.size(), ranges.size());
+  for (uint32_t i = 0; i < keys.size(); i++) {
+    std::vector<storage::TupleSlot> expected;
+    for (auto it = reference.lower_bound(keys[i]); it != reference.upper_bound(keys[i]); ++it) {
+      expected.emplace_back(it->second);
+    }
+    std::vector<storage::TupleSlot> found(results.begin() + ranges[i].first, results.begin() + ranges[i].second);
+    EXPECT_TRUE(std::is_permutation(expected.begin(), expected.end(), found.begin(), found.end()));
+  }
+
+  txn_manager_->Commit(scan_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  delete[] keys_buffer;
+}
+
+/**
+ * Tests that populating an index from a table bulk loads every visible tuple into a tree that scans and takes further
+ * inserts like one built by single inserts, and that a unique index over duplicate keys fails to load.
+ */
+// NOLINTNEXTLINE
+TEST_F(BwTreeIndexTests, BulkLoad) {
+  // populate table with every key in [0, num_keys) twice, with enough tuples for a tree of several levels
+  const int32_t num_keys = 10000;
+  auto *const insert_txn = txn_manager_->BeginTransaction();
+  for (int32_t i = 0; i < 2 * num_keys; i++) {
+    auto *const insert_redo =
+        insert_txn->StageWrite(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID, tuple_initializer_);
+    *reinterpret_cast<int32_t *>(insert_redo->Delta()->AccessForceNotNull(0)) = i % num_keys;
+    sql_table_->Insert(common::ManagedPointer(insert_txn), insert_redo);
+  }
+  txn_manager_->Commit(insert_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  auto *const load_txn = txn_manager_->BeginTransaction();
+  EXPECT_TRUE(IndexBuilder().SetKeySchema(default_schema_).BulkInsert(
+      common::ManagedPointer(load_txn), common::ManagedPointer(sql_table_), default_index_));
+  EXPECT_FALSE(IndexBuilder().SetKeySchema(unique_schema_).BulkInsert(
+      common::ManagedPointer(load_txn), common::ManagedPointer(sql_table_), unique_index_));
+
+  std::vector<storage::TupleSlot> results;
+  auto *const low_key_pr = default_index_->GetProjectedRowInitializer().InitializeRow(key_buffer_1_);
+  auto *const high_key_pr = default_index_->GetProjectedRowInitializer().InitializeRow(key_buffer_2_);
+
+  // every key has both of its tuples
+  for (int32_t i = 0; i < num_keys; i += 97) {
+    *reinterpret_cast<int32_t *>(low_key_pr->AccessForceNotNull(0)) = i;
+    default_index_->ScanKey(*load_txn, *low_key_pr, &results);
+    EXPECT_EQ(results.size(), 2);
+    results.clear();
+  }
+
+  // a full scan sees every tuple, in key order
+  default_index_->ScanAscending(*load_txn, storage::index::ScanType::OpenBoth, 1, low_key_pr, high_key_pr, 0,
+                                &results);
+  ASSERT_EQ(results.size(), 2 * num_keys);
+  auto *const tuple = tuple_initializer_.InitializeRow(key_buffer_2_);
+  int32_t last_key = -1;
+  for (const auto slot : results) {
+    EXPECT_TRUE(sql_table_->Select(common::ManagedPointer(load_txn), slot, tuple));
+    const auto key = *reinterpret_cast<const int32_t *>(tuple->AccessWithNullCheck(0));
+    EXPECT_LE(last_key, key);
+    last_key = key;
+  }
+  results.clear();
+
+  // the loaded tree takes new keys anywhere in its key space
+  for (const int32_t i : {-1, num_keys / 2, num_keys}) {
+    auto *const insert_redo =
+        load_txn->StageWrite(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID, tuple_initializer_);
+    *reinterpret_cast<int32_t *>(insert_redo->Delta()->AccessForceNotNull(0)) = i;
+    const auto tuple_slot = sql_table_->Insert(common::ManagedPointer(load_txn), insert_redo);
+    *reinterpret_cast<int32_t *>(low_key_pr->AccessForceNotNull(0)) = i;
+    EXPECT_TRUE(default_index_->Insert(common::ManagedPointer(load_txn), *low_key_pr, tuple_slot));
+    default_index_->ScanKey(*load_txn, *low_key_pr, &results);
+    EXPECT_EQ(results.size(), i == num_keys / 2 ? 3 : 1);
+    results.clear();
+  }
+
+  txn_manager_->Commit(load_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
 /**
  * Tests basic scan behavior using various windows to scan over (some out of of bounds of keyspace, some matching
  * exactly, etc.)
@@ -1,8 +1,10 @@
+#include <algorithm>
 #include <cstring>
 #include <functional>
 #include <limits>
 #include <memory>
 #include <random>
+#include <set>
 #include <vector>
 
 #include "main/db_main.h"
@@ -10,6 +12,7 @@
 #include "portable_endian/portable_endian.h"
 #include "storage/garbage_collector_thread.h"
 #include "storage/index/compact_ints_key.h"
+#include "storage/index/hash_index_values.h"
 #include "storage/index/index_builder.h"
 #include "storage/projected_row.h"
 #include "storage/sql_table.h"
@@ -1632,4 +1635,96 @@ TEST_F(HashIndexTests, AbortDelete2) {
   txn_manager_->Commit(txn2, transaction::TransactionUtil::EmptyCallback, nullptr);
 }
 
+/**
+ * Checks that the values of one key stay correct as they grow onto the heap and shrink back inline, and when copied.
+ */
+// NOLINTNEXTLINE
+TEST(HashIndexValuesTests, AddRemove) {
+  std::default_random_engine generator;
+  const auto slot = [](const uint32_t offset) { return TupleSlot(nullptr, offset); };
+
+  HashIndexValues values(slot(0));
+  std::set<uint32_t> reference{0};
+  const auto expect_reference = [&](const HashIndexValues &actual) {
+    EXPECT_EQ(actual.Size(), reference.size());
+    std::set<uint32_t> offsets;
+    for (const auto location : actual) offsets.emplace(location.GetOffset());
+    EXPECT_EQ(offsets, reference);
+  };
+
+  for (uint32_t round = 0; round < 3; round++) {
+    // Grow well past the inline capacity
+    for (uint32_t i = 1; i < 1000; i++) {
+      values.Add(slot(i));
+      reference.emplace(i);
+    }
+    expect_reference(values);
+    EXPECT_FALSE(values.Remove(slot(1000)));
+
+    HashIndexValues copy(values);
+    expect_reference(copy);
+
+    // Shrink back down to a single value in random order
+    std::vector<uint32_t> offsets(reference.begin(), reference.end());
+    std::shuffle(offsets.begin(), offsets.end(), generator);
+    for (uint32_t i = 0; i < offsets.size() - 1; i++) {
+      EXPECT_TRUE(values.Remove(slot(offsets[i])));
+      reference.erase(offsets[i]);
+      if (i % 97 == 0) expect_reference(values);
+    }
+    expect_reference(values);
+
+    // The copy is unaffected, and can be moved around like the map moves values when it grows
+    HashIndexValues moved(std::move(copy));
+    EXPECT_EQ(moved.Size(), 1000);
+    copy = moved;
+    EXPECT_EQ(copy.Size(), 1000);
+
+    EXPECT_TRUE(values.Remove(slot(offsets.back())));
+    EXPECT_EQ(values.Size(), 0);
+    values.Add(slot(0));
+    reference = {0};
+  }
+}
+
+/**
+ * Inserts many duplicates of a few keys, some of which are aborted, and checks that each key maps to exactly its
+ * committed values.
+ */
+// NOLINTNEXTLINE
+TEST_F(HashIndexTests, DuplicateKeys) {
+  const uint32_t num_keys = 4;
+  std::vector<std::vector<storage::TupleSlot>> committed(num_keys);
+
+  auto *const commit_txn = txn_manager_->BeginTransaction();
+  auto *const abort_txn = txn_manager_->BeginTransaction();
+  for (uint32_t i = 0; i < 2000; i++) {
+    const auto key = static_cast<int32_t>(i % num_keys);
+    // Every third value belongs to a txn that aborts, so it is erased from the middle of its key's values
+    auto *const txn = i % 3 == 0 ? abort_txn : commit_txn;
+    auto *const insert_redo =
+        txn->StageWrite(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID, tuple_initializer_);
+    *reinterpret_cast<int32_t *>(insert_redo->Delta()->AccessForceNotNull(0)) = key;
+    const auto tuple_slot = sql_table_->Insert(common::ManagedPointer(txn), insert_redo);
+
+    auto *const insert_key = default_index_->GetProjectedRowInitializer().InitializeRow(key_buffer_1_);
+    *reinterpret_cast<int32_t *>(insert_key->AccessForceNotNull(0)) = key;
+    EXPECT_TRUE(default_index_->Insert(common::ManagedPointer(txn), *insert_key, tuple_slot));
+    if (txn == commit_txn) committed[key].emplace_back(tuple_slot);
+  }
+  txn_manager_->Commit(commit_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  txn_manager_->Abort(abort_txn);
+
+  auto *const scan_txn = txn_manager_->BeginTransaction();
+  auto *const scan_key_pr = default_index_->GetProjectedRowInitializer().InitializeRow(key_buffer_1_);
+  std::vector<storage::TupleSlot> results;
+  for (uint32_t key = 0; key < num_keys; key++) {
+    *reinterpret_cast<int32_t *>(scan_key_pr->AccessForceNotNull(0)) = static_cast<int32_t>(key);
+    default_index_->ScanKey(*scan_txn, *scan_key_pr, &results);
+    EXPECT_TRUE(std::is_permutation(results.begin(), results.end(), committed[key].begin(), committed[key].end()));
+    results.clear();
+  }
+  txn_manager_->Commit(scan_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
 }  // namespace terrier::storage::index
@@ -1044,6 +1044,75 @@ void UnorderedNumericComparisons(const type::TypeId type_id, const bool nullable
   delete[] pr_buffer;
 }
 
+template <typename KeyType>
+void KeyToProjectedRow(const bool nullable) {
+  const std::vector<type::TypeId> types = {type::TypeId::SMALLINT, type::TypeId::BIGINT, type::TypeId::TINYINT,
+                                           type::TypeId::INTEGER};
+  std::vector<catalog::IndexSchema::Column> key_cols;
+  for (uint32_t i = 0; i < types.size(); i++) {
+    key_cols.emplace_back("", types[i], nullable,
+                          parser::ConstantValueExpression(type::TransientValueFactory::GetNull(types[i])));
+    StorageTestUtil::ForceOid(&(key_cols.back()), catalog::indexkeycol_oid_t(i));
+  }
+
+  const IndexMetadata metadata(
+      catalog::IndexSchema(key_cols, storage::index::IndexType::BWTREE, false, false, false, true));
+  const auto &initializer = metadata.GetProjectedRowInitializer();
+  const auto &offsets = metadata.GetKeyOidToOffsetMap();
+
+  auto *const from_buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+  auto *const to_buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+  auto *const from = initializer.InitializeRow(from_buffer);
+  auto *const to = initializer.InitializeRow(to_buffer);
+
+  // Negative values and the extremes of each type make sure the sign and byte order are restored
+  *reinterpret_cast<int16_t *>(from->AccessForceNotNull(offsets.at(catalog::indexkeycol_oid_t(0)))) = -12345;
+  *reinterpret_cast<int64_t *>(from->AccessForceNotNull(offsets.at(catalog::indexkeycol_oid_t(1)))) =
+      std::numeric_limits<int64_t>::min();
+  *reinterpret_cast<int8_t *>(from->AccessForceNotNull(offsets.at(catalog::indexkeycol_oid_t(2)))) =
+      std::numeric_limits<int8_t>::max();
+  *reinterpret_cast<int32_t *>(from->AccessForceNotNull(offsets.at(catalog::indexkeycol_oid_t(3)))) = 42;
+
+  KeyType key;
+  key.SetFromProjectedRow(*from, metadata, types.size());
+  ASSERT_TRUE(KeyType::SupportsToProjectedRow(metadata));
+  key.ToProjectedRow(to, metadata);
+  EXPECT_EQ(-12345, *reinterpret_cast<int16_t *>(to->AccessWithNullCheck(offsets.at(catalog::indexkeycol_oid_t(0)))));
+  EXPECT_EQ(std::numeric_limits<int64_t>::min(),
+            *reinterpret_cast<int64_t *>(to->AccessWithNullCheck(offsets.at(catalog::indexkeycol_oid_t(1)))));
+  EXPECT_EQ(std::numeric_limits<int8_t>::max(),
+            *reinterpret_cast<int8_t *>(to->AccessWithNullCheck(offsets.at(catalog::indexkeycol_oid_t(2)))));
+  EXPECT_EQ(42, *reinterpret_cast<int32_t *>(to->AccessWithNullCheck(offsets.at(catalog::indexkeycol_oid_t(3)))));
+
+  if (nullable) {
+    from->SetNull(offsets.at(catalog::indexkeycol_oid_t(1)));
+    key.SetFromProjectedRow(*from, metadata, types.size());
+    key.ToProjectedRow(to, metadata);
+    EXPECT_TRUE(to->IsNull(offsets.at(catalog::indexkeycol_oid_t(1))));
+    EXPECT_EQ(42, *reinterpret_cast<int32_t *>(to->AccessWithNullCheck(offsets.at(catalog::indexkeycol_oid_t(3)))));
+  }
+
+  delete[] from_buffer;
+  delete[] to_buffer;
+}
+
+// Verify that keys can be written back into ProjectedRows, as done by covering index scans
+// NOLINTNEXTLINE
+TEST_F(IndexKeyTests, KeyToProjectedRowTest) {
+  KeyToProjectedRow<CompactIntsKey<16>>(false);
+  KeyToProjectedRow<GenericKey<64>>(false);
+  KeyToProjectedRow<GenericKey<64>>(true);
+
+  // Varlens too long for a VarlenEntry are inlined into GenericKeys, so they cannot be written back
+  std::vector<catalog::IndexSchema::Column> key_cols;
+  key_cols.emplace_back("", type::TypeId::VARCHAR, 20, false,
+                        parser::ConstantValueExpression(type::TransientValueFactory::GetNull(type::TypeId::VARCHAR)));
+  StorageTestUtil::ForceOid(&(key_cols.back()), catalog::indexkeycol_oid_t(0));
+  const IndexMetadata metadata(
+      catalog::IndexSchema(key_cols, storage::index::IndexType::BWTREE, false, false, false, true));
+  EXPECT_FALSE(GenericKey<64>::SupportsToProjectedRow(metadata));
+}
+
 // NOLINTNEXTLINE
 TEST_F(IndexKeyTests, HashKeyNumericComparisons) {
   UnorderedNumericComparisons<HashKey<8>, int8_t>(type::TypeId::TINYINT, false);
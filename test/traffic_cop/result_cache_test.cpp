@@ -0,0 +1,162 @@
+#include "traffic_cop/result_cache.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "parser/expression/constant_value_expression.h"
+#include "parser/expression/star_expression.h"
+#include "planner/plannodes/hash_join_plan_node.h"
+#include "planner/plannodes/seq_scan_plan_node.h"
+#include "test_util/test_harness.h"
+#include "type/transient_value_factory.h"
+
+namespace terrier::trafficcop {
+
+class ResultCacheTests : public TerrierTest {
+ public:
+  static ResultCache::Result MakeResult(std::string rows, ResultCache::TableVersions table_versions) {
+    ResultCache::Result result;
+    result.rows_ = std::move(rows);
+    result.num_rows_ = 1;
+    result.table_versions_ = std::move(table_versions);
+    return result;
+  }
+
+  static std::unique_ptr<planner::SeqScanPlanNode> MakeSeqScan(
+      const catalog::table_oid_t table_oid, const bool for_update,
+      const common::ManagedPointer<parser::AbstractExpression> predicate) {
+    std::vector<planner::OutputSchema::Column> cols;
+    cols.emplace_back("col", type::TypeId::BOOLEAN,
+                      std::make_unique<parser::ConstantValueExpression>(type::TransientValueFactory::GetBoolean(true)));
+    planner::SeqScanPlanNode::Builder builder;
+    return builder.SetOutputSchema(std::make_unique<planner::OutputSchema>(std::move(cols)))
+        .SetTableOid(table_oid)
+        .SetDatabaseOid(catalog::db_oid_t(1))
+        .SetScanPredicate(predicate)
+        .SetIsForUpdateFlag(for_update)
+        .Build();
+  }
+};
+
+// NOLINTNEXTLINE
+TEST_F(ResultCacheTests, TablesReadTest) {
+  parser::StarExpression predicate;
+  const auto predicate_ptr = common::ManagedPointer<parser::AbstractExpression>(&predicate);
+  std::vector<catalog::table_oid_t> tables;
+
+  // Tables are collected from the whole plan, sorted and without duplicates
+  std::vector<planner::OutputSchema::Column> cols;
+  cols.emplace_back("col", type::TypeId::BOOLEAN,
+                    std::make_unique<parser::ConstantValueExpression>(type::TransientValueFactory::GetBoolean(true)));
+  planner::HashJoinPlanNode::Builder join_builder;
+  auto join = join_builder.SetJoinType(planner::LogicalJoinType::INNER)
+                  .SetOutputSchema(std::make_unique<planner::OutputSchema>(std::move(cols)))
+                  .SetJoinPredicate(predicate_ptr)
+                  .AddChild(MakeSeqScan(catalog::table_oid_t(7), false, predicate_ptr))
+                  .AddChild(MakeSeqScan(catalog::table_oid_t(3), false, predicate_ptr))
+                  .Build();
+  EXPECT_TRUE(ResultCache::GetTablesRead(*join, &tables));
+  EXPECT_EQ(tables, std::vector<catalog::table_oid_t>({catalog::table_oid_t(3), catalog::table_oid_t(7)}));
+
+  // Locking rows is not just a read
+  EXPECT_FALSE(ResultCache::GetTablesRead(*MakeSeqScan(catalog::table_oid_t(3), true, predicate_ptr), &tables));
+}
+
+// NOLINTNEXTLINE
+TEST_F(ResultCacheTests, KeyTest) {
+  const std::vector<catalog::table_oid_t> tables = {catalog::table_oid_t(3)};
+  const std::vector<network::FieldFormat> formats = {network::FieldFormat::text};
+  std::vector<type::TransientValue> params;
+  params.emplace_back(type::TransientValueFactory::GetInteger(1));
+  params.emplace_back(type::TransientValueFactory::GetVarChar("a"));
+
+  std::string key;
+  ASSERT_TRUE(ResultCache::MakeKey(catalog::db_oid_t(1), "select * from foo where a = $1 and b = $2", tables, params,
+                                   formats, &key));
+
+  // Any difference in the query makes a different key
+  std::string other_key;
+  ASSERT_TRUE(ResultCache::MakeKey(catalog::db_oid_t(1), "select * from foo where a = $1 and b = $2", tables, params,
+                                   formats, &other_key));
+  EXPECT_EQ(key, other_key);
+  ASSERT_TRUE(ResultCache::MakeKey(catalog::db_oid_t(2), "select * from foo where a = $1 and b = $2", tables, params,
+                                   formats, &other_key));
+  EXPECT_NE(key, other_key);
+  ASSERT_TRUE(ResultCache::MakeKey(catalog::db_oid_t(1), "select * from foo where a = $1 and b = $2",
+                                   {catalog::table_oid_t(4)}, params, formats, &other_key));
+  EXPECT_NE(key, other_key);
+  ASSERT_TRUE(ResultCache::MakeKey(catalog::db_oid_t(1), "select * from foo where a = $1 and b = $2", tables, params,
+                                   {network::FieldFormat::binary}, &other_key));
+  EXPECT_NE(key, other_key);
+
+  std::vector<type::TransientValue> other_params;
+  other_params.emplace_back(type::TransientValueFactory::GetBigInt(1));
+  other_params.emplace_back(type::TransientValueFactory::GetVarChar("a"));
+  ASSERT_TRUE(ResultCache::MakeKey(catalog::db_oid_t(1), "select * from foo where a = $1 and b = $2", tables,
+                                   other_params, formats, &other_key));
+  EXPECT_NE(key, other_key);
+  other_params[0] = type::TransientValueFactory::GetInteger(1);
+  other_params[1] = type::TransientValueFactory::GetNull(type::TypeId::VARCHAR);
+  ASSERT_TRUE(ResultCache::MakeKey(catalog::db_oid_t(1), "select * from foo where a = $1 and b = $2", tables,
+                                   other_params, formats, &other_key));
+  EXPECT_NE(key, other_key);
+}
+
+// NOLINTNEXTLINE
+TEST_F(ResultCacheTests, LookupTest) {
+  ResultCache cache;
+  const ResultCache::TableVersions versions = {{catalog::table_oid_t(3), transaction::timestamp_t(10)},
+                                               {catalog::table_oid_t(4), transaction::timestamp_t(20)}};
+
+  // A transaction that doesn't see the last change to every table can't share its results
+  EXPECT_FALSE(cache.Insert("key", transaction::timestamp_t(20), MakeResult("rows", versions)));
+  EXPECT_TRUE(cache.Insert("key", transaction::timestamp_t(21), MakeResult("rows", versions)));
+  EXPECT_EQ(cache.Size(), 1);
+
+  const auto result = cache.Lookup("key", transaction::timestamp_t(30), versions);
+  ASSERT_NE(result, nullptr);
+  EXPECT_EQ(result->rows_, "rows");
+  EXPECT_EQ(cache.Lookup("other key", transaction::timestamp_t(30), versions), nullptr);
+
+  // Older transactions don't see the results, but newer ones still do
+  EXPECT_EQ(cache.Lookup("key", transaction::timestamp_t(15), versions), nullptr);
+  EXPECT_NE(cache.Lookup("key", transaction::timestamp_t(30), versions), nullptr);
+
+  // A change to any table retires the results
+  ResultCache::TableVersions changed_versions = versions;
+  changed_versions[1].second = transaction::timestamp_t(25);
+  EXPECT_EQ(cache.Lookup("key", transaction::timestamp_t(30), changed_versions), nullptr);
+  EXPECT_EQ(cache.Size(), 0);
+  EXPECT_EQ(cache.Lookup("key", transaction::timestamp_t(30), versions), nullptr);
+}
+
+// NOLINTNEXTLINE
+TEST_F(ResultCacheTests, EvictionTest) {
+  ResultCache cache(10);
+  const ResultCache::TableVersions versions = {{catalog::table_oid_t(3), transaction::timestamp_t(10)}};
+  const transaction::timestamp_t start_time(20);
+
+  // Results larger than the whole cache are never cached
+  EXPECT_FALSE(cache.Insert("a", start_time, MakeResult(std::string(11, 'a'), versions)));
+
+  EXPECT_TRUE(cache.Insert("a", start_time, MakeResult(std::string(4, 'a'), versions)));
+  EXPECT_TRUE(cache.Insert("b", start_time, MakeResult(std::string(4, 'b'), versions)));
+  EXPECT_NE(cache.Lookup("a", start_time, versions), nullptr);
+
+  // b is the least recently used, so it makes room for c
+  EXPECT_TRUE(cache.Insert("c", start_time, MakeResult(std::string(4, 'c'), versions)));
+  EXPECT_EQ(cache.Size(), 2);
+  EXPECT_NE(cache.Lookup("a", start_time, versions), nullptr);
+  EXPECT_EQ(cache.Lookup("b", start_time, versions), nullptr);
+  EXPECT_NE(cache.Lookup("c", start_time, versions), nullptr);
+
+  // Replacing results frees the space of the old ones
+  EXPECT_TRUE(cache.Insert("c", start_time, MakeResult(std::string(6, 'c'), versions)));
+  EXPECT_EQ(cache.Size(), 2);
+  EXPECT_EQ(cache.Lookup("c", start_time, versions)->rows_, std::string(6, 'c'));
+}
+
+}  // namespace terrier::trafficcop
@@ -3,6 +3,7 @@
 #include <memory>
 #include <pqxx/pqxx>  // NOLINT
 #include <string>
+#include <thread>  // NOLINT
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -12,6 +13,7 @@
 #include "main/db_main.h"
 #include "network/connection_handle_factory.h"
 #include "network/terrier_server.h"
+#include "settings/settings_manager.h"
 #include "storage/garbage_collector.h"
 #include "test_util/manual_packet_util.h"
 #include "test_util/test_harness.h"
@@ -149,6 +151,147 @@ TEST_F(TrafficCopTests, BasicTest) {
   }
 }
 
+/**
+ * Queries from more connections than there are connection handler threads are executed on the query workers, so every
+ * connection should get its results back even when several of them share a handler thread
+ */
+// NOLINTNEXTLINE
+TEST_F(TrafficCopTests, ConcurrentConnectionsTest) {
+  const auto num_connections =
+      static_cast<uint32_t>(2 * db_main_->GetSettingsManager()->GetInt(settings::Param::connection_thread_count));
+  try {
+    pqxx::connection connection(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                            port_, catalog::DEFAULT_DATABASE));
+    pqxx::work txn1(connection);
+    txn1.exec("CREATE TABLE TableA (id INT PRIMARY KEY, data TEXT);");
+    txn1.exec("INSERT INTO TableA VALUES (1, 'abc');");
+    txn1.commit();
+    connection.disconnect();
+  } catch (const std::exception &e) {
+    EXPECT_TRUE(false);
+  }
+
+  std::vector<std::thread> clients;
+  for (uint32_t i = 0; i < num_connections; i++) {
+    clients.emplace_back([this] {
+      try {
+        pqxx::connection connection(fmt::format(
+            "host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql", port_, catalog::DEFAULT_DATABASE));
+        for (uint32_t j = 0; j < 10; j++) {
+          pqxx::work txn(connection);
+          pqxx::result r = txn.exec("SELECT * FROM TableA");
+          EXPECT_EQ(r.size(), 1);
+          txn.commit();
+        }
+        connection.disconnect();
+      } catch (const std::exception &e) {
+        EXPECT_TRUE(false);
+      }
+    });
+  }
+  for (auto &client : clients) client.join();
+}
+
+/**
+ * A sort memory budget far below the input makes ORDER BY spill sorted runs to disk and merge them, which should
+ * return the same rows in the same order
+ */
+// NOLINTNEXTLINE
+TEST_F(TrafficCopTests, SpillingSortTest) {
+  auto action_context = std::make_unique<common::ActionContext>(common::action_id_t(1));
+  settings::setter_callback_fn setter_callback = [](common::ManagedPointer<common::ActionContext> action_context) {};
+  db_main_->GetSettingsManager()->SetInt64(settings::Param::sort_memory_budget, 1,
+                                           common::ManagedPointer(action_context), setter_callback);
+  EXPECT_EQ(common::ActionState::SUCCESS, action_context->GetState());
+
+  const uint32_t num_batches = 100, batch_size = 200;
+  try {
+    pqxx::connection connection(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                            port_, catalog::DEFAULT_DATABASE));
+    pqxx::work txn1(connection);
+    txn1.exec("CREATE TABLE TableA (id INT, data INT);");
+    // Insert the ids in an order unrelated to their value
+    for (uint32_t batch = 0; batch < num_batches; batch++) {
+      std::string query = "INSERT INTO TableA VALUES ";
+      for (uint32_t i = 0; i < batch_size; i++) {
+        const uint32_t id = ((batch * batch_size + i) * 7919) % (num_batches * batch_size);
+        query += fmt::format("{}({}, {})", i == 0 ? "" : ", ", id, batch);
+      }
+      txn1.exec(query);
+    }
+    txn1.commit();
+
+    pqxx::work txn2(connection);
+    pqxx::result r = txn2.exec("SELECT id FROM TableA ORDER BY id");
+    ASSERT_EQ(r.size(), num_batches * batch_size);
+    for (uint32_t i = 0; i < r.size(); i++) {
+      EXPECT_EQ(r[i][0].as<uint32_t>(), i);
+    }
+    txn2.commit();
+    connection.disconnect();
+  } catch (const std::exception &e) {
+    EXPECT_TRUE(false) << e.what();
+  }
+}
+
+/**
+ * Simple queries that differ only in their constants share a cached statement, so running one again with other
+ * constants must bind the new ones rather than return the results of the first
+ */
+// NOLINTNEXTLINE
+TEST_F(TrafficCopTests, SimpleQueryCacheTest) {
+  try {
+    pqxx::connection connection(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                            port_, catalog::DEFAULT_DATABASE));
+    pqxx::work txn1(connection);
+    txn1.exec("CREATE TABLE TableA (id INT, data TEXT);");
+    txn1.commit();
+
+    for (const uint32_t id : {1, 2, 3}) {
+      pqxx::work txn2(connection);
+      txn2.exec(fmt::format("INSERT INTO TableA VALUES ({0}, 'data {0}');", id));
+      txn2.commit();
+    }
+
+    for (const uint32_t id : {2, 1, 3, 2}) {
+      pqxx::work txn3(connection);
+      pqxx::result r = txn3.exec(fmt::format("SELECT data FROM TableA WHERE id = {}", id));
+      ASSERT_EQ(r.size(), 1);
+      EXPECT_EQ(r[0][0].as<std::string>(), fmt::format("data {}", id));
+      r = txn3.exec(fmt::format("SELECT id FROM TableA WHERE data = 'data {}'", id));
+      ASSERT_EQ(r.size(), 1);
+      EXPECT_EQ(r[0][0].as<uint32_t>(), id);
+      txn3.commit();
+    }
+    connection.disconnect();
+  } catch (const std::exception &e) {
+    EXPECT_TRUE(false) << e.what();
+  }
+}
+
+/**
+ * COPY must not let clients read or write files on the server unless server_side_copy is enabled
+ */
+// NOLINTNEXTLINE
+TEST_F(TrafficCopTests, ServerSideCopyTest) {
+  try {
+    pqxx::connection connection(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                            port_, catalog::DEFAULT_DATABASE));
+    pqxx::work txn1(connection);
+    txn1.exec("CREATE TABLE TableA (id INT, data INT);");
+    txn1.commit();
+
+    for (const auto *const query :
+         {"COPY TableA TO '/tmp/server_side_copy_test.csv' WITH (FORMAT csv);", "COPY TableA FROM '/etc/hosts';"}) {
+      pqxx::work txn2(connection);
+      EXPECT_THROW(txn2.exec(query), std::exception);
+    }
+    connection.disconnect();
+  } catch (const std::exception &e) {
+    EXPECT_TRUE(false) << e.what();
+  }
+}
+
 /**
  * Test whether a temporary namespace is created for a connection to the database
  */
@@ -0,0 +1,60 @@
+#include "traffic_cop/traffic_cop_util.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test_util/test_harness.h"
+#include "type/transient_value_peeker.h"
+
+namespace terrier::trafficcop {
+
+class TrafficCopUtilTests : public TerrierTest {};
+
+// NOLINTNEXTLINE
+TEST_F(TrafficCopUtilTests, ParameterizeQueryTest) {
+  std::string query;
+  std::vector<type::TransientValue> params;
+
+  // Comparison operands and the elements of VALUES lists become parameters, typed like the parser types constants
+  EXPECT_TRUE(TrafficCopUtil::ParameterizeQuery("INSERT INTO foo VALUES (1, 'it''s', 2.5), (3000000000, 'b', 4.0)",
+                                                &query, &params));
+  EXPECT_EQ(query, "insert into foo values ($1, $2, $3), ($4, $5, $6)");
+  ASSERT_EQ(params.size(), 6);
+  EXPECT_EQ(params[0].Type(), type::TypeId::INTEGER);
+  EXPECT_EQ(type::TransientValuePeeker::PeekInteger(params[0]), 1);
+  EXPECT_EQ(params[1].Type(), type::TypeId::VARCHAR);
+  EXPECT_EQ(type::TransientValuePeeker::PeekVarChar(params[1]), "it's");
+  EXPECT_EQ(params[2].Type(), type::TypeId::DECIMAL);
+  EXPECT_EQ(params[3].Type(), type::TypeId::BIGINT);
+  EXPECT_EQ(type::TransientValuePeeker::PeekBigInt(params[3]), 3000000000);
+
+  // Queries that differ only in constants, letter case, comments and how much whitespace separates tokens map to the
+  // same text. Whitespace is collapsed rather than removed, so whether tokens are separated at all still matters.
+  std::string other_query;
+  EXPECT_TRUE(TrafficCopUtil::ParameterizeQuery("SELECT * FROM foo WHERE a = 1 AND b IN (2, 3)", &query, &params));
+  EXPECT_TRUE(TrafficCopUtil::ParameterizeQuery("select *  from foo -- comment\n where a=4 and b in (5,6)",
+                                                &other_query, &params));
+  EXPECT_EQ(query, "select * from foo where a = $1 and b in ($2, $3)");
+  EXPECT_EQ(other_query, "select * from foo where a=$1 and b in ($2,$3)");
+  EXPECT_EQ(params.size(), 3);
+
+  // Constants that don't mean the same as a parameter stay in the text
+  EXPECT_TRUE(TrafficCopUtil::ParameterizeQuery(
+      "SELECT a, 1 FROM foo WHERE b = '2020-01-01'::DATE AND c = -1 AND d = 1 + 2 ORDER BY 1 LIMIT 10", &query,
+      &params));
+  EXPECT_EQ(query, "select a, 1 from foo where b = '2020-01-01'::date and c = -1 and d = 1 + 2 order by 1 limit 10");
+  EXPECT_TRUE(params.empty());
+  EXPECT_TRUE(TrafficCopUtil::ParameterizeQuery("SELECT \"A b\" FROM foo WHERE a IN (SELECT 1, 2 FROM bar)", &query,
+                                                &params));
+  EXPECT_EQ(query, "select \"A b\" from foo where a in (select 1, 2 from bar)");
+  EXPECT_TRUE(params.empty());
+
+  // Syntax beyond the lexer is left to the parser
+  EXPECT_FALSE(TrafficCopUtil::ParameterizeQuery("SELECT * FROM foo WHERE a = $1", &query, &params));
+  EXPECT_FALSE(TrafficCopUtil::ParameterizeQuery("SELECT E'\\n'", &query, &params));
+  EXPECT_FALSE(TrafficCopUtil::ParameterizeQuery("SELECT 1 /* comment */", &query, &params));
+  EXPECT_FALSE(TrafficCopUtil::ParameterizeQuery("SELECT 'unterminated", &query, &params));
+}
+
+}  // namespace terrier::trafficcop
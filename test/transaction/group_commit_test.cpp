@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "common/worker_pool.h"
+#include "storage/data_table.h"
+#include "test_util/multithread_test_util.h"
+#include "test_util/storage_test_util.h"
+#include "test_util/test_harness.h"
+#include "transaction/deferred_action_manager.h"
+#include "transaction/transaction_context.h"
+#include "transaction/transaction_manager.h"
+#include "transaction/transaction_util.h"
+
+namespace terrier {
+struct GroupCommitTests : public TerrierTest {
+  storage::BlockStore block_store_{1000, 1000};
+  storage::RecordBufferSegmentPool buffer_pool_{10000, 10000};
+  std::default_random_engine generator_;
+  common::WorkerPool thread_pool_{MultiThreadTestUtil::HardwareConcurrency(), {}};
+};
+
+// Many threads commit updating transactions at the same time so that commits get batched into groups. Every commit
+// must still receive a unique timestamp, and every inserted tuple must be visible once its txn has committed.
+// NOLINTNEXTLINE
+TEST_F(GroupCommitTests, ConcurrentCommitsGetUniqueTimestamps) {
+  const uint32_t num_threads = MultiThreadTestUtil::HardwareConcurrency();
+  const uint32_t txns_per_thread = 1000;
+  storage::BlockLayout layout = StorageTestUtil::RandomLayoutNoVarlen(10, &generator_);
+  storage::DataTable table{common::ManagedPointer(&block_store_), layout, storage::layout_version_t(0)};
+  transaction::TimestampManager timestamp_manager;
+  transaction::DeferredActionManager deferred_action_manager{common::ManagedPointer(&timestamp_manager)};
+  transaction::TransactionManager txn_manager{common::ManagedPointer(&timestamp_manager),
+                                              common::ManagedPointer(&deferred_action_manager),
+                                              common::ManagedPointer(&buffer_pool_), false, DISABLED};
+  const storage::ProjectedRowInitializer initializer =
+      storage::ProjectedRowInitializer::Create(layout, StorageTestUtil::ProjectionListAllColumns(layout));
+
+  std::vector<std::vector<transaction::TransactionContext *>> txns(num_threads);
+  std::vector<std::vector<transaction::timestamp_t>> commit_times(num_threads);
+  std::vector<std::vector<storage::TupleSlot>> slots(num_threads);
+  auto workload = [&](uint32_t id) {
+    std::default_random_engine thread_generator(id);
+    auto *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+    for (uint32_t i = 0; i < txns_per_thread; i++) {
+      auto *txn = txn_manager.BeginTransaction();
+      storage::ProjectedRow *redo = initializer.InitializeRow(buffer);
+      StorageTestUtil::PopulateRandomRow(redo, layout, 0.0, &thread_generator);
+      slots[id].push_back(table.Insert(common::ManagedPointer(txn), *redo));
+      commit_times[id].push_back(txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr));
+      txns[id].push_back(txn);
+    }
+    delete[] buffer;
+  };
+  MultiThreadTestUtil::RunThreadsUntilFinish(&thread_pool_, num_threads, workload);
+
+  std::vector<transaction::timestamp_t> all_commit_times;
+  for (uint32_t id = 0; id < num_threads; id++) {
+    for (uint32_t i = 0; i < txns_per_thread; i++) {
+      auto *txn = txns[id][i];
+      EXPECT_TRUE(transaction::TransactionUtil::Committed(commit_times[id][i]));
+      EXPECT_EQ(commit_times[id][i], txn->FinishTime());
+      // Commits issued by the same thread must be ordered
+      if (i > 0) EXPECT_TRUE(transaction::TransactionUtil::NewerThan(commit_times[id][i], commit_times[id][i - 1]));
+      all_commit_times.push_back(commit_times[id][i]);
+    }
+  }
+  std::sort(all_commit_times.begin(), all_commit_times.end());
+  EXPECT_EQ(std::adjacent_find(all_commit_times.begin(), all_commit_times.end()), all_commit_times.end());
+
+  auto *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+  auto *read_txn = txn_manager.BeginTransaction();
+  for (auto &thread_slots : slots) {
+    for (const auto slot : thread_slots) {
+      storage::ProjectedRow *row = initializer.InitializeRow(buffer);
+      EXPECT_TRUE(table.Select(common::ManagedPointer(read_txn), slot, row));
+    }
+  }
+  txn_manager.Commit(read_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  delete read_txn;
+  delete[] buffer;
+
+  for (auto &thread_txns : txns)
+    for (auto *txn : thread_txns) delete txn;
+}
+}  // namespace terrier
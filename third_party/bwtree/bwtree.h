@@ -6805,6 +6805,110 @@ class BwTree : public BwTreeBase {
     epoch_manager.LeaveEpoch(epoch_node_p);
   }
 
+  /*
+   * GetValueBatch() - Look up a batch of keys under a single epoch
+   *
+   * Values of keys[i] are appended to the value list in key order, and
+   * the size of the value list after appending them is written to
+   * ends[i]. Callers should pass the keys sorted, so that consecutive
+   * traversals share the inner nodes on their path
+   */
+  void GetValueBatch(const KeyType *const *keys, size_t num_keys, std::vector<ValueType> &value_list, size_t *ends) {
+    INDEX_LOG_TRACE("GetValueBatch()");
+
+    EpochNode *epoch_node_p = epoch_manager.JoinEpoch();
+
+    for (size_t i = 0; i < num_keys; i++) {
+      // The keys are scattered in memory when passed in sorted order
+      if (i + 1 < num_keys) __builtin_prefetch(keys[i + 1]);
+
+      Context context{*keys[i]};
+      TraverseReadOptimized(&context, &value_list);
+      ends[i] = value_list.size();
+    }
+
+    epoch_manager.LeaveEpoch(epoch_node_p);
+  }
+
+  /*
+   * BulkLoad() - Build the tree bottom-up from sorted key value pairs
+   *
+   * Leaf nodes are filled in order, then each level of inner nodes is
+   * built over the level below until a single node is left, which becomes
+   * the root. This replaces the nodes of an empty tree, so it must only be
+   * called on a tree that no other thread is accessing and that has not
+   * had any key inserted. Items must be sorted by key
+   */
+  void BulkLoad(const KeyValuePair *items, size_t num_items) {
+    INDEX_LOG_TRACE("BulkLoad()");
+
+    if (num_items == 0) return;
+
+    // Leave some room in every node so that the first inserts after
+    // the load do not split all of them
+    const size_t leaf_fill = std::max(2, leaf_node_size_upper_threshold_ * 3 / 4);
+    const size_t inner_fill = std::max(2, inner_node_size_upper_threshold_ * 3 / 4);
+
+    // Split items into leaves. Equal keys are never split across two leaves,
+    // since a search only visits the leaf covering its key
+    std::vector<size_t> leaf_starts;
+    for (size_t start = 0; start < num_items;) {
+      leaf_starts.push_back(start);
+      size_t end = std::min(start + leaf_fill, num_items);
+      while (end < num_items && KeyCmpEqual(items[end - 1].first, items[end].first)) end++;
+      start = end;
+    }
+    leaf_starts.push_back(num_items);
+
+    // The first leaf keeps its NodeID since iterators start from there. The
+    // initial root and leaf are freed; the root ID is reused at the end
+    FreeNodeByNodeID(root_id.load());
+    std::vector<KeyNodeIDPair> level;
+    level.reserve(leaf_starts.size() - 1);
+    for (size_t i = 0; i + 1 < leaf_starts.size(); i++) {
+      level.emplace_back(i == 0 ? KeyType{} : items[leaf_starts[i]].first,
+                         i == 0 ? first_leaf_id : GetNextNodeID());
+    }
+
+    for (size_t i = 0; i < level.size(); i++) {
+      const auto size = static_cast<int>(leaf_starts[i + 1] - leaf_starts[i]);
+      // The left most leaf has -Inf as its low key, and the right most has +Inf as its high key
+      const KeyNodeIDPair low_key =
+          i == 0 ? std::make_pair(KeyType{}, INVALID_NODE_ID) : std::make_pair(level[i].first, ~INVALID_NODE_ID);
+      const KeyNodeIDPair high_key = i + 1 == level.size() ? std::make_pair(KeyType{}, INVALID_NODE_ID) : level[i + 1];
+      auto *leaf_node_p = reinterpret_cast<LeafNode *>(
+          ElasticNode<KeyValuePair>::Get(size, NodeType::LeafType, 0, size, low_key, high_key));
+      leaf_node_p->PushBack(items + leaf_starts[i], items + leaf_starts[i + 1]);
+      InstallNewNode(level[i].second, leaf_node_p);
+    }
+
+    // Build inner levels until one node covers the whole level below
+    while (true) {
+      const size_t num_nodes = (level.size() + inner_fill - 1) / inner_fill;
+      std::vector<KeyNodeIDPair> upper_level;
+      upper_level.reserve(num_nodes);
+      for (size_t i = 0; i < num_nodes; i++) {
+        upper_level.emplace_back(level[i * inner_fill].first, num_nodes == 1 ? root_id.load() : GetNextNodeID());
+      }
+
+      for (size_t i = 0; i < num_nodes; i++) {
+        const size_t start = i * inner_fill;
+        const size_t end = std::min(start + inner_fill, level.size());
+        const auto size = static_cast<int>(end - start);
+        // The low key of an inner node is its first separator
+        const KeyNodeIDPair high_key =
+            i + 1 == num_nodes ? std::make_pair(KeyType{}, INVALID_NODE_ID) : upper_level[i + 1];
+        auto *inner_node_p = reinterpret_cast<InnerNode *>(
+            ElasticNode<KeyNodeIDPair>::Get(size, NodeType::InnerType, 0, size, level[start], high_key));
+        inner_node_p->PushBack(level.data() + start, level.data() + end);
+        InstallNewNode(upper_level[i].second, inner_node_p);
+      }
+
+      if (num_nodes == 1) break;
+      level = std::move(upper_level);
+    }
+  }
+
   /*
    * GetValue() - Return value in a ValueSet object
    *